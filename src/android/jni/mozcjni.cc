@@ -83,6 +83,41 @@ jbyteArray JNICALL evalCommand(JNIEnv *env, jclass clazz,
   return out_bytes_array;
 }
 
+// Concrete implementation for MozcJni.evalCommandList: evaluates all the
+// commands of a serialized CommandList in one native crossing, in order,
+// and returns the CommandList with every output filled in.  The Java side
+// queues the commands accumulated within one input-method event dispatch
+// (composing-region updates plus the key event) and flushes them here, so a
+// keystroke costs one JNI crossing instead of one per command.
+jbyteArray JNICALL evalCommandList(JNIEnv *env, jclass clazz,
+                                   jbyteArray in_bytes_array) {
+  jbyte *in_bytes = env->GetByteArrayElements(in_bytes_array, nullptr);
+  const jsize in_size = env->GetArrayLength(in_bytes_array);
+  mozc::commands::CommandList command_list;
+  command_list.ParseFromArray(in_bytes, in_size);
+  if (g_session_handler) {
+    for (mozc::commands::Command &command :
+         *command_list.mutable_commands()) {
+      g_session_handler->EvalCommand(&command);
+    }
+  } else {
+    LOG(DFATAL) << "Mozc session handler is not yet initialized";
+  }
+
+  // Use JNI_ABORT because in_bytes is read only.
+  env->ReleaseByteArrayElements(in_bytes_array, in_bytes, JNI_ABORT);
+
+  const int out_size = command_list.ByteSizeLong();
+  jbyteArray out_bytes_array = env->NewByteArray(out_size);
+  jbyte *out_bytes = env->GetByteArrayElements(out_bytes_array, nullptr);
+  command_list.SerializeToArray(out_bytes, out_size);
+
+  // Use 0 to copy out_bytes to out_bytes_array.
+  env->ReleaseByteArrayElements(out_bytes_array, out_bytes, 0);
+
+  return out_bytes_array;
+}
+
 std::string JstringToCcString(JNIEnv *env, jstring j_string) {
   const char *cstr = env->GetStringUTFChars(j_string, nullptr);
   const std::string cc_string(cstr);
@@ -191,6 +226,8 @@ Java_com_google_android_apps_inputmethod_libs_mozc_session_MozcJNI_initialize(
   const JNINativeMethod methods[] = {
       {"evalCommand", "([B)[B",
        reinterpret_cast<void *>(&mozc::jni::evalCommand)},
+      {"evalCommandList", "([B)[B",
+       reinterpret_cast<void *>(&mozc::jni::evalCommandList)},
       {"onPostLoad", "(Ljava/lang/String;Ljava/lang/String;)Z",
        reinterpret_cast<void *>(&mozc::jni::onPostLoad)},
       {"getDataVersion", "()Ljava/lang/String;",
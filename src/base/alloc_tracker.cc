@@ -0,0 +1,59 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "base/alloc_tracker.h"
+
+#include <atomic>
+
+namespace mozc {
+
+AllocTracker::Counters AllocTracker::counters_[AllocTracker::kMaxStages];
+AllocTracker::Counters AllocTracker::arena_counters_;
+thread_local int AllocTracker::tls_stage_ = 0;
+
+AllocTracker::StageCounters AllocTracker::Stage(const int stage) {
+  return {counters_[stage].allocations.load(std::memory_order_relaxed),
+          counters_[stage].bytes.load(std::memory_order_relaxed)};
+}
+
+AllocTracker::StageCounters AllocTracker::ArenaChunks() {
+  return {arena_counters_.allocations.load(std::memory_order_relaxed),
+          arena_counters_.bytes.load(std::memory_order_relaxed)};
+}
+
+void AllocTracker::Reset() {
+  for (Counters &counters : counters_) {
+    counters.allocations.store(0, std::memory_order_relaxed);
+    counters.bytes.store(0, std::memory_order_relaxed);
+  }
+  arena_counters_.allocations.store(0, std::memory_order_relaxed);
+  arena_counters_.bytes.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace mozc
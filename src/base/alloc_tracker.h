@@ -0,0 +1,98 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZC_BASE_ALLOC_TRACKER_H_
+#define MOZC_BASE_ALLOC_TRACKER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace mozc {
+
+// Opt-in per-stage allocation attribution.
+//
+// Production binaries keep this inert: nothing calls OnAllocation() unless a
+// diagnostic binary interposes the global allocation operators (see
+// session_handler_main). Stage scoping rides on PerfHistogram::ScopedProbe,
+// which exchanges the thread-local stage id here on entry and exit; stage id
+// 0 means "unattributed", id i+1 maps to PerfHistogram stage i.
+//
+// Arena (FreeList) chunk growth is counted separately and in every binary
+// (two relaxed increments per chunk, i.e. only while an arena warms up), so
+// the zero-allocation steady state of the arena features is verifiable:
+// after warmup, both the per-stage counters of an instrumented binary and
+// the arena chunk counter must stay flat.
+class AllocTracker {
+ public:
+  static constexpr int kMaxStages = 16;
+
+  AllocTracker() = delete;
+
+  // Sets the thread-local stage and returns the previous one.
+  static int ExchangeStage(const int stage) {
+    const int previous = tls_stage_;
+    tls_stage_ = stage;
+    return previous;
+  }
+
+  // Called by the interposed operator new of an instrumenting binary.
+  static void OnAllocation(const size_t bytes) {
+    Counters &counters = counters_[tls_stage_];
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  // Called by FreeList when it allocates a new chunk.
+  static void OnArenaChunkAllocation(const size_t bytes) {
+    arena_counters_.allocations.fetch_add(1, std::memory_order_relaxed);
+    arena_counters_.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  struct StageCounters {
+    uint64_t allocations;
+    uint64_t bytes;
+  };
+  static StageCounters Stage(int stage);
+  static StageCounters ArenaChunks();
+  static void Reset();
+
+ private:
+  struct Counters {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+  };
+  static Counters counters_[kMaxStages];
+  static Counters arena_counters_;
+  static thread_local int tls_stage_;
+};
+
+}  // namespace mozc
+
+#endif  // MOZC_BASE_ALLOC_TRACKER_H_
@@ -0,0 +1,200 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "base/background_scheduler.h"
+
+#include <atomic>
+#include <cstdint>
+
+#include "absl/base/const_init.h"
+#include "absl/flags/flag.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "base/cpu_stats.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__) && !defined(__ANDROID__)
+#include <dirent.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#endif  // _WIN32 / __linux__
+
+ABSL_FLAG(bool, background_task_scheduler, false,
+          "Defer background maintenance (history saves, warmup, integrity "
+          "checks) while the user is typing, the CPU is loaded, or -- for "
+          "pure maintenance -- the machine runs on battery. Each task's "
+          "deadline bounds the deferral.");
+
+namespace mozc {
+namespace {
+
+// The user counts as idle this long after the last handled command.
+constexpr absl::Duration kIdleThreshold = absl::Seconds(10);
+// System CPU load (0..1) below which background work may run.
+constexpr float kCpuLoadThreshold = 0.5f;
+// Polling cadence of a deferred wait.
+constexpr absl::Duration kPollInterval = absl::Milliseconds(500);
+
+std::atomic<int64_t> g_last_activity_us{0};
+std::atomic<uint64_t> g_cancel_generation{0};
+
+bool (*g_on_battery_provider)() = nullptr;
+float (*g_cpu_load_provider)() = nullptr;
+
+// CPUStats keeps sampling state and is not thread-safe.
+ABSL_CONST_INIT absl::Mutex g_cpu_mutex(absl::kConstInit);
+
+float GetSystemCpuLoad() {
+  if (g_cpu_load_provider != nullptr) {
+    return g_cpu_load_provider();
+  }
+  static CPUStats *stats = new CPUStats;
+  absl::MutexLock lock(&g_cpu_mutex);
+  return stats->GetSystemCPULoad();
+}
+
+bool IsOnBatteryPower() {
+  if (g_on_battery_provider != nullptr) {
+    return g_on_battery_provider();
+  }
+#ifdef _WIN32
+  SYSTEM_POWER_STATUS status;
+  if (::GetSystemPowerStatus(&status)) {
+    return status.ACLineStatus == 0;
+  }
+  return false;
+#elif defined(__linux__) && !defined(__ANDROID__)
+  // On battery iff no "Mains" class supply reports online=1. Desktops
+  // without any power supply entries count as AC.
+  DIR *dir = opendir("/sys/class/power_supply");
+  if (dir == nullptr) {
+    return false;
+  }
+  bool ac_online = false;
+  bool found_mains = false;
+  while (struct dirent *entry = readdir(dir)) {
+    if (entry->d_name[0] == '.') {
+      continue;
+    }
+    const std::string base =
+        std::string("/sys/class/power_supply/") + entry->d_name;
+    char buf[16] = {0};
+    FILE *type_file = fopen((base + "/type").c_str(), "r");
+    if (type_file == nullptr) {
+      continue;
+    }
+    const bool is_mains = fgets(buf, sizeof(buf), type_file) != nullptr &&
+                          strncmp(buf, "Mains", 5) == 0;
+    fclose(type_file);
+    if (!is_mains) {
+      continue;
+    }
+    found_mains = true;
+    FILE *online_file = fopen((base + "/online").c_str(), "r");
+    if (online_file != nullptr) {
+      if (fgets(buf, sizeof(buf), online_file) != nullptr && buf[0] == '1') {
+        ac_online = true;
+      }
+      fclose(online_file);
+    }
+  }
+  closedir(dir);
+  return found_mains && !ac_online;
+#else
+  // No battery signal on this platform; assume AC so that maintenance is
+  // only gated by activity and load.
+  return false;
+#endif
+}
+
+bool IsUserIdle() {
+  const int64_t last_us =
+      g_last_activity_us.load(std::memory_order_relaxed);
+  return absl::Now() - absl::FromUnixMicros(last_us) >= kIdleThreshold;
+}
+
+}  // namespace
+
+bool BackgroundScheduler::IsRunnable(const TaskClass task_class) {
+  if (!absl::GetFlag(FLAGS_background_task_scheduler)) {
+    return true;
+  }
+  if (!IsUserIdle()) {
+    return false;
+  }
+  if (GetSystemCpuLoad() >= kCpuLoadThreshold) {
+    return false;
+  }
+  if (task_class == TaskClass::kMaintenance && IsOnBatteryPower()) {
+    return false;
+  }
+  return true;
+}
+
+void BackgroundScheduler::WaitUntilRunnable(const TaskClass task_class,
+                                            const absl::Duration deadline) {
+  if (IsRunnable(task_class)) {
+    return;
+  }
+  const absl::Time give_up = absl::Now() + deadline;
+  const uint64_t generation =
+      g_cancel_generation.load(std::memory_order_acquire);
+  while (absl::Now() < give_up) {
+    absl::SleepFor(kPollInterval);
+    if (g_cancel_generation.load(std::memory_order_acquire) != generation) {
+      return;
+    }
+    if (IsRunnable(task_class)) {
+      return;
+    }
+  }
+}
+
+void BackgroundScheduler::NotifyUserActivity() {
+  g_last_activity_us.store(absl::ToUnixMicros(absl::Now()),
+                           std::memory_order_relaxed);
+}
+
+void BackgroundScheduler::CancelWaits() {
+  g_cancel_generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void BackgroundScheduler::SetOnBatteryProviderForTesting(bool (*provider)()) {
+  g_on_battery_provider = provider;
+}
+
+void BackgroundScheduler::SetCpuLoadProviderForTesting(float (*provider)()) {
+  g_cpu_load_provider = provider;
+}
+
+}  // namespace mozc
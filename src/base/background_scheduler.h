@@ -0,0 +1,82 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZC_BASE_BACKGROUND_SCHEDULER_H_
+#define MOZC_BASE_BACKGROUND_SCHEDULER_H_
+
+#include "absl/time/time.h"
+
+namespace mozc {
+
+// Gates deferrable background work (history saves, engine warmup, data
+// integrity checks) on system state, so maintenance does not spin fans
+// while the user types on battery. Enabled with --background_task_scheduler;
+// while disabled every wait returns immediately and only the activity
+// timestamp is maintained.
+//
+// This is a gate, not an executor: background threads call
+// WaitUntilRunnable() before doing their work. A task runs when the user
+// has been idle for a while, the system CPU load is low, and -- for the
+// maintenance class -- the machine is not on battery; the deadline bounds
+// how long a task can be deferred, after which it runs regardless.
+class BackgroundScheduler {
+ public:
+  enum class TaskClass {
+    // Pure maintenance (warmup, integrity checks): additionally deferred
+    // while on battery power.
+    kMaintenance,
+    // User data persistence (history saves): never gated on battery, only
+    // deferred while the user is typing or the CPU is busy.
+    kPersistence,
+  };
+
+  BackgroundScheduler() = delete;
+
+  // Blocks the calling background thread until the system looks fit for the
+  // task, |deadline| of deferral has elapsed, or CancelWaits() is called.
+  static void WaitUntilRunnable(TaskClass task_class, absl::Duration deadline);
+
+  // Returns whether a task of |task_class| would run right now.
+  static bool IsRunnable(TaskClass task_class);
+
+  // Cheap (one relaxed atomic store); called on every handled command.
+  static void NotifyUserActivity();
+
+  // Releases every thread currently blocked in WaitUntilRunnable, e.g.
+  // before joining background threads at shutdown.
+  static void CancelWaits();
+
+  // Test hooks; pass nullptr to restore the real provider.
+  static void SetOnBatteryProviderForTesting(bool (*provider)());
+  static void SetCpuLoadProviderForTesting(float (*provider)());
+};
+
+}  // namespace mozc
+
+#endif  // MOZC_BASE_BACKGROUND_SCHEDULER_H_
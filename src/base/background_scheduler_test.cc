@@ -0,0 +1,133 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "base/background_scheduler.h"
+
+#include "absl/flags/declare.h"
+#include "absl/flags/flag.h"
+#include "absl/flags/reflection.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "base/thread.h"
+#include "testing/gunit.h"
+
+ABSL_DECLARE_FLAG(bool, background_task_scheduler);
+
+namespace mozc {
+namespace {
+
+bool OnBattery() { return true; }
+bool OnAc() { return false; }
+float BusyCpu() { return 0.9f; }
+float IdleCpu() { return 0.0f; }
+
+class BackgroundSchedulerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    absl::SetFlag(&FLAGS_background_task_scheduler, true);
+    BackgroundScheduler::SetCpuLoadProviderForTesting(IdleCpu);
+    BackgroundScheduler::SetOnBatteryProviderForTesting(OnAc);
+    // No recent activity: the scheduler initially sees an idle user.
+  }
+
+  void TearDown() override {
+    BackgroundScheduler::SetCpuLoadProviderForTesting(nullptr);
+    BackgroundScheduler::SetOnBatteryProviderForTesting(nullptr);
+  }
+
+  absl::FlagSaver flag_saver_;
+};
+
+TEST_F(BackgroundSchedulerTest, DisabledIsAlwaysRunnable) {
+  absl::SetFlag(&FLAGS_background_task_scheduler, false);
+  BackgroundScheduler::NotifyUserActivity();
+  BackgroundScheduler::SetCpuLoadProviderForTesting(BusyCpu);
+  BackgroundScheduler::SetOnBatteryProviderForTesting(OnBattery);
+  EXPECT_TRUE(BackgroundScheduler::IsRunnable(
+      BackgroundScheduler::TaskClass::kMaintenance));
+}
+
+TEST_F(BackgroundSchedulerTest, GatesOnSystemState) {
+  EXPECT_TRUE(BackgroundScheduler::IsRunnable(
+      BackgroundScheduler::TaskClass::kMaintenance));
+  EXPECT_TRUE(BackgroundScheduler::IsRunnable(
+      BackgroundScheduler::TaskClass::kPersistence));
+
+  // Battery gates maintenance but not persistence.
+  BackgroundScheduler::SetOnBatteryProviderForTesting(OnBattery);
+  EXPECT_FALSE(BackgroundScheduler::IsRunnable(
+      BackgroundScheduler::TaskClass::kMaintenance));
+  EXPECT_TRUE(BackgroundScheduler::IsRunnable(
+      BackgroundScheduler::TaskClass::kPersistence));
+  BackgroundScheduler::SetOnBatteryProviderForTesting(OnAc);
+
+  // High CPU load gates everything.
+  BackgroundScheduler::SetCpuLoadProviderForTesting(BusyCpu);
+  EXPECT_FALSE(BackgroundScheduler::IsRunnable(
+      BackgroundScheduler::TaskClass::kPersistence));
+  BackgroundScheduler::SetCpuLoadProviderForTesting(IdleCpu);
+
+  // Recent user activity gates everything.
+  BackgroundScheduler::NotifyUserActivity();
+  EXPECT_FALSE(BackgroundScheduler::IsRunnable(
+      BackgroundScheduler::TaskClass::kPersistence));
+}
+
+TEST_F(BackgroundSchedulerTest, WaitReturnsImmediatelyWhenRunnable) {
+  const absl::Time start = absl::Now();
+  BackgroundScheduler::WaitUntilRunnable(
+      BackgroundScheduler::TaskClass::kMaintenance, absl::Minutes(1));
+  EXPECT_LT(absl::Now() - start, absl::Seconds(1));
+}
+
+TEST_F(BackgroundSchedulerTest, DeadlineBoundsDeferral) {
+  BackgroundScheduler::SetOnBatteryProviderForTesting(OnBattery);
+  const absl::Time start = absl::Now();
+  BackgroundScheduler::WaitUntilRunnable(
+      BackgroundScheduler::TaskClass::kMaintenance, absl::Milliseconds(600));
+  const absl::Duration waited = absl::Now() - start;
+  EXPECT_GE(waited, absl::Milliseconds(400));
+  EXPECT_LT(waited, absl::Seconds(5));
+}
+
+TEST_F(BackgroundSchedulerTest, CancelReleasesWaiters) {
+  BackgroundScheduler::SetOnBatteryProviderForTesting(OnBattery);
+  const absl::Time start = absl::Now();
+  Thread waiter([] {
+    BackgroundScheduler::WaitUntilRunnable(
+        BackgroundScheduler::TaskClass::kMaintenance, absl::Minutes(1));
+  });
+  absl::SleepFor(absl::Milliseconds(100));
+  BackgroundScheduler::CancelWaits();
+  waiter.Join();
+  EXPECT_LT(absl::Now() - start, absl::Seconds(10));
+}
+
+}  // namespace
+}  // namespace mozc
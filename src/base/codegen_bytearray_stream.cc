@@ -36,6 +36,7 @@
 #include <utility>
 
 #include "absl/strings/str_format.h"
+#include "base/fast_compressor.h"
 #include "absl/strings/string_view.h"
 
 #ifdef __ANDROID__
@@ -48,9 +49,10 @@
 namespace mozc {
 
 BasicCodeGenByteArrayStreamBuf::BasicCodeGenByteArrayStreamBuf(
-    std::ostream &output_stream)
+    std::ostream &output_stream, const Mode mode)
     : internal_output_buffer_(kDefaultInternalBufferSize),
       output_stream_(&output_stream),
+      mode_(mode),
       is_open_(false),
       output_count_(0) {
   this->setp(internal_output_buffer_.data(),
@@ -64,9 +66,15 @@ bool BasicCodeGenByteArrayStreamBuf::OpenVarDef(
     return false;
   }
   var_name_base_.assign(var_name_base.data(), var_name_base.size());
+  output_count_ = 0;
+  if (mode_ == Mode::kCompressed) {
+    // Nothing is written until CloseVarDef, when the accumulated bytes are
+    // compressed and emitted in one go.
+    accumulated_.clear();
+    return is_open_ = !output_stream_->fail();
+  }
   *output_stream_ << "alignas(std::max_align_t) constexpr char k"
                   << var_name_base_ << "_data[] = {";
-  output_count_ = 0;
   return is_open_ = !output_stream_->fail();
 }
 
@@ -76,6 +84,24 @@ bool BasicCodeGenByteArrayStreamBuf::CloseVarDef() {
     return false;
   }
   overflow(traits_type::eof());
+  if (mode_ == Mode::kCompressed) {
+    const std::string compressed = FastCompressor::Compress(accumulated_);
+    *output_stream_ << "alignas(std::max_align_t) constexpr char k"
+                    << var_name_base_ << "_compressed_data[] = {";
+    output_count_ = 0;
+    EmitSourceBytes(compressed.data(), compressed.data() + compressed.size());
+    if (output_count_ != 0) {
+      *output_stream_ << "\n";
+    }
+    *output_stream_ << "};\n"
+                    << "constexpr size_t k" << var_name_base_
+                    << "_compressed_size = " << compressed.size() << ";\n"
+                    << "constexpr size_t k" << var_name_base_
+                    << "_size = " << accumulated_.size() << ";\n";
+    accumulated_.clear();
+    is_open_ = false;
+    return !output_stream_->fail();
+  }
   if (output_count_ != 0) {
     *output_stream_ << "\n";
   }
@@ -130,9 +156,18 @@ int BasicCodeGenByteArrayStreamBuf::overflow(int c) {
                     : c);
 }
 
-// Converts a raw byte stream to C source code.
 void BasicCodeGenByteArrayStreamBuf::WriteBytes(const char_type *begin,
                                                 const char_type *end) {
+  if (mode_ == Mode::kCompressed) {
+    accumulated_.append(begin, end);
+    return;
+  }
+  EmitSourceBytes(begin, end);
+}
+
+// Converts a raw byte stream to C source code.
+void BasicCodeGenByteArrayStreamBuf::EmitSourceBytes(const char_type *begin,
+                                                     const char_type *end) {
   while (begin < end) {
     if (output_count_ % kNumOfBytesOnOneLine == 0) {
       *output_stream_ << absl::StreamFormat("\n0x%02X,", *begin);
@@ -149,8 +184,8 @@ void BasicCodeGenByteArrayStreamBuf::WriteBytes(const char_type *begin,
 //   own_output_stream: The object pointed to by |output_stream| will be
 //       destroyed if |own_output_stream| equals to |OWN_STREAM|.
 CodeGenByteArrayOutputStream::CodeGenByteArrayOutputStream(
-    std::ostream &output_stream)
-    : std::ostream(&streambuf_), streambuf_(output_stream) {}
+    std::ostream &output_stream, const Mode mode)
+    : std::ostream(&streambuf_), streambuf_(output_stream, mode) {}
 
 CodeGenByteArrayOutputStream::CodeGenByteArrayOutputStream(
     CodeGenByteArrayOutputStream &&other) noexcept
@@ -54,10 +54,23 @@ namespace mozc {
 
 class BasicCodeGenByteArrayStreamBuf : public std::streambuf {
  public:
+  enum class Mode {
+    // Emit the bytes as a plain char array (the default).  The array is
+    // constexpr, so it lives in read-only, file-backed pages.
+    kRaw,
+    // Accumulate the bytes and emit them compressed with FastCompressor at
+    // CloseVarDef, as
+    //   k<Name>_compressed_data[] / k<Name>_compressed_size / k<Name>_size
+    // for base/embedded_file.h's CompressedEmbeddedFile.  Cuts binary size
+    // at the cost of a decompressed copy in anonymous memory at first use.
+    kCompressed,
+  };
+
   // Args:
   //   output_stream: The output stream to which generated code is written.
   explicit BasicCodeGenByteArrayStreamBuf(
-      std::ostream &output_stream ABSL_ATTRIBUTE_LIFETIME_BOUND);
+      std::ostream &output_stream ABSL_ATTRIBUTE_LIFETIME_BOUND,
+      Mode mode = Mode::kRaw);
 
   BasicCodeGenByteArrayStreamBuf(BasicCodeGenByteArrayStreamBuf &&) = default;
   BasicCodeGenByteArrayStreamBuf &operator=(BasicCodeGenByteArrayStreamBuf &&) =
@@ -84,14 +97,20 @@ class BasicCodeGenByteArrayStreamBuf : public std::streambuf {
   static constexpr size_t kDefaultInternalBufferSize = 4000 * 1024;  // 4 MB
   static constexpr size_t kNumOfBytesOnOneLine = 20;
 
-  // Converts a raw byte stream to C source code.
+  // Routes a raw byte stream to the emitter or, in kCompressed mode, the
+  // accumulator.
   void WriteBytes(const char_type *begin, const char_type *end);
+  // Converts a raw byte stream to C source code.
+  void EmitSourceBytes(const char_type *begin, const char_type *end);
 
   std::vector<char_type> internal_output_buffer_;
   std::ostream *output_stream_;
+  Mode mode_;
   bool is_open_;
   std::string var_name_base_;
   size_t output_count_;
+  // The bytes accumulated so far in kCompressed mode.
+  std::string accumulated_;
 };
 
 // Generates C/C++ source code to define a byte array as a C string literal.
@@ -111,10 +130,13 @@ class BasicCodeGenByteArrayStreamBuf : public std::streambuf {
 //   codegen_stream.CloseVarDef();
 class CodeGenByteArrayOutputStream : public std::ostream {
  public:
+  using Mode = BasicCodeGenByteArrayStreamBuf::Mode;
+
   // Args:
   //   output_stream: The output stream to which generated code is written.
   explicit CodeGenByteArrayOutputStream(
-      std::ostream &output_stream ABSL_ATTRIBUTE_LIFETIME_BOUND);
+      std::ostream &output_stream ABSL_ATTRIBUTE_LIFETIME_BOUND,
+      Mode mode = Mode::kRaw);
 
   CodeGenByteArrayOutputStream(CodeGenByteArrayOutputStream &&other) noexcept;
   CodeGenByteArrayOutputStream &operator=(
@@ -39,6 +39,8 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "base/fast_compressor.h"
+#include "testing/gmock.h"
 #include "testing/gunit.h"
 
 namespace mozc {
@@ -62,6 +64,44 @@ class CodeGenByteArrayStreamTest : public testing::Test {
   CodeGenByteArrayOutputStream codegen_stream_;
 };
 
+TEST_F(CodeGenByteArrayStreamTest, CompressedMode) {
+  std::ostringstream result_stream;
+  CodeGenByteArrayOutputStream codegen_stream(
+      result_stream, CodeGenByteArrayOutputStream::Mode::kCompressed);
+
+  std::string data;
+  for (int i = 0; i < 4096; ++i) {
+    data.push_back(static_cast<char>(i % 7));  // Compressible.
+  }
+  codegen_stream.OpenVarDef("Test");
+  codegen_stream.write(data.data(), data.size());
+  codegen_stream.CloseVarDef();
+  EXPECT_TRUE(codegen_stream.good());
+
+  const std::string output = result_stream.str();
+  EXPECT_THAT(output, testing::HasSubstr("kTest_compressed_data[] = {"));
+  EXPECT_THAT(output, testing::HasSubstr(absl::StrFormat(
+                          "kTest_size = %d;", data.size())));
+
+  // The emitted bytes are exactly FastCompressor::Compress of the input,
+  // and far fewer of them than a raw emission.
+  const std::string compressed = FastCompressor::Compress(data);
+  EXPECT_THAT(output, testing::HasSubstr(absl::StrFormat(
+                          "kTest_compressed_size = %d;", compressed.size())));
+  EXPECT_LT(compressed.size(), data.size() / 2);
+  std::string parsed;
+  for (size_t i = output.find('{'); i < output.find('}');) {
+    const size_t x = output.find("0x", i);
+    if (x == std::string::npos || x >= output.find('}')) {
+      break;
+    }
+    parsed.push_back(static_cast<char>(
+        std::stoi(output.substr(x + 2, 2), nullptr, 16)));
+    i = x + 4;
+  }
+  EXPECT_EQ(parsed, compressed);
+}
+
 TEST_F(CodeGenByteArrayStreamTest, NoInput) {
   codegen_stream_.OpenVarDef("NoInput");
   codegen_stream_.CloseVarDef();
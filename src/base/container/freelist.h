@@ -30,13 +30,14 @@
 #ifndef MOZC_BASE_CONTAINER_FREELIST_H_
 #define MOZC_BASE_CONTAINER_FREELIST_H_
 
+#include <algorithm>
 #include <cstddef>
-#include <limits>
 #include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "base/alloc_tracker.h"
 #include "testing/friend_test.h"
 
 namespace mozc {
@@ -64,7 +65,10 @@ class FreeList {
 
   FreeList(FreeList&& other) noexcept
       : pool_(std::move(other.pool_)),
+        chunk_index_(other.chunk_index_),
         next_in_chunk_(other.next_in_chunk_),
+        size_(other.size_),
+        constructed_(other.constructed_),
         chunk_size_(other.chunk_size_),
         allocator_(std::move(other.allocator_)) {
     static_assert(std::is_nothrow_move_constructible_v<decltype(pool_)>);
@@ -78,7 +82,10 @@ class FreeList {
     // Destroy `this` freelist and move `other` over.
     Destroy();
     pool_ = std::move(other.pool_);
+    chunk_index_ = other.chunk_index_;
     next_in_chunk_ = other.next_in_chunk_;
+    size_ = other.size_;
+    constructed_ = other.constructed_;
     chunk_size_ = other.chunk_size_;
     static_assert(
         allocator_traits::propagate_on_container_move_assignment::value,
@@ -93,31 +100,51 @@ class FreeList {
   void Free() {
     Destroy();
     pool_.clear();
-    next_in_chunk_ = std::numeric_limits<size_type>::max();
+    chunk_index_ = 0;
+    next_in_chunk_ = 0;
+    size_ = 0;
+    constructed_ = 0;
+  }
+
+  // Returns all objects to the free list in O(1). The memory chunks and the
+  // objects already constructed in them are retained and handed out again by
+  // Alloc in the same order (destructors run only in Free() and on
+  // destruction), so callers that re-initialize objects on allocation can use
+  // FreeList as a bump allocator with constant-time reclamation and warm,
+  // physically contiguous memory.
+  void Reset() {
+    chunk_index_ = 0;
+    next_in_chunk_ = 0;
+    size_ = 0;
   }
 
   T* Alloc() {
     if (next_in_chunk_ >= chunk_size_) {
       next_in_chunk_ = 0;
+      ++chunk_index_;
+    }
+    if (chunk_index_ >= pool_.size()) {
       // Allocate the chunk with the allocate and delay the constructions until
       // the objects are actually requested.
       pool_.push_back(allocator_traits::allocate(allocator_, chunk_size_));
+      // Chunk growth is the arena's only allocation; counting it makes the
+      // zero-allocation steady state verifiable (see AllocTracker).
+      AllocTracker::OnArenaChunkAllocation(chunk_size_ * sizeof(T));
     }
 
-    // Default construct T.
-    T* ptr = pool_.back() + next_in_chunk_++;
-    allocator_traits::construct(allocator_, ptr);
+    T* ptr = pool_[chunk_index_] + next_in_chunk_++;
+    if (size_ == constructed_) {
+      // First use of this slot: default construct T. Slots recycled by Reset()
+      // are handed out as-is.
+      allocator_traits::construct(allocator_, ptr);
+      ++constructed_;
+    }
+    ++size_;
     return ptr;
   }
 
   constexpr bool empty() const { return size() == 0; }
-  constexpr size_type size() const {
-    if (pool_.empty()) {
-      return 0;
-    } else {
-      return (pool_.size() - 1) * chunk_size_ + next_in_chunk_;
-    }
-  }
+  constexpr size_type size() const { return size_; }
   constexpr size_type capacity() const { return pool_.size() * chunk_size_; }
   constexpr size_type chunk_size() const { return chunk_size_; }
 
@@ -127,7 +154,10 @@ class FreeList {
     static_assert(std::is_nothrow_swappable_v<decltype(pool_)>);
     using std::swap;
     swap(pool_, other.pool_);
+    swap(chunk_index_, other.chunk_index_);
     swap(next_in_chunk_, other.next_in_chunk_);
+    swap(size_, other.size_);
+    swap(constructed_, other.constructed_);
     swap(chunk_size_, other.chunk_size_);
     if constexpr (allocator_traits::propagate_on_container_swap::value) {
       swap(allocator_, other.allocator_);
@@ -141,17 +171,16 @@ class FreeList {
   // move.
   void Destroy() {
     if constexpr (!std::is_trivially_destructible_v<T>) {
-      // Destruct all elements. Skip this entirely if T is trivially
+      // Destruct the objects ever constructed: the first constructed_ slots
+      // in allocation order. Skip this entirely if T is trivially
       // destructible.
-      if (!pool_.empty()) {
-        for (auto it = pool_.begin(); it != pool_.end() - 1; ++it) {
-          for (difference_type i = 0; i < chunk_size_; ++i) {
-            allocator_traits::destroy(allocator_, *it + i);
-          }
-        }
-        for (difference_type i = 0; i < next_in_chunk_; ++i) {
-          allocator_traits::destroy(allocator_, pool_.back() + i);
+      size_type remaining = constructed_;
+      for (T* chunk : pool_) {
+        const size_type n = std::min(remaining, chunk_size_);
+        for (difference_type i = 0; i < static_cast<difference_type>(n); ++i) {
+          allocator_traits::destroy(allocator_, chunk + i);
         }
+        remaining -= n;
       }
     }
 
@@ -162,7 +191,15 @@ class FreeList {
   }
 
   std::vector<T*> pool_;
-  size_type next_in_chunk_ = std::numeric_limits<size_type>::max();
+  // Index of the chunk Alloc currently fills.
+  size_type chunk_index_ = 0;
+  // Next free slot in pool_[chunk_index_].
+  size_type next_in_chunk_ = 0;
+  // Number of objects currently handed out.
+  size_type size_ = 0;
+  // Number of slots ever constructed; never decreases except in Free(). Slots
+  // below this high-water mark are recycled without reconstruction.
+  size_type constructed_ = 0;
   size_type chunk_size_;
   allocator_type allocator_;
 };
@@ -179,6 +216,14 @@ class ObjectPool {
     freelist_.Free();
   }
 
+  // Returns every object to the pool in O(1), keeping them constructed so
+  // that their internally held capacity survives; see FreeList::Reset.
+  // Alloc then hands the objects out as-is, so callers must re-initialize.
+  void Reset() {
+    released_.clear();
+    freelist_.Reset();
+  }
+
   T* Alloc() {
     if (!released_.empty()) {
       T* result = released_.back();
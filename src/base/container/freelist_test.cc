@@ -117,6 +117,38 @@ TEST_F(FreeListTest, FreeListAllocResetFree) {
   EXPECT_GT(Stub::destructed(), 0);
 }
 
+TEST_F(FreeListTest, FreeListReset) {
+  FreeList<Stub> list(4);
+  for (int i = 0; i < 6; ++i) {
+    list.Alloc()->Use();
+  }
+  EXPECT_EQ(list.size(), 6);
+  EXPECT_EQ(list.capacity(), 8);
+  EXPECT_EQ(Stub::constructed(), 6);
+
+  list.Reset();
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(list.size(), 0);
+  // Memory and constructed objects are retained.
+  EXPECT_EQ(list.capacity(), 8);
+  EXPECT_EQ(Stub::destructed(), 0);
+
+  // Recycled slots are handed out as-is, without reconstruction.
+  for (int i = 0; i < 6; ++i) {
+    Stub *p = list.Alloc();
+    EXPECT_TRUE(p->IsUsed());
+  }
+  EXPECT_EQ(Stub::constructed(), 6);
+
+  // Allocations beyond the high-water mark construct new objects.
+  Stub *p = list.Alloc();
+  EXPECT_FALSE(p->IsUsed());
+  EXPECT_EQ(Stub::constructed(), 7);
+
+  list.Free();
+  EXPECT_EQ(Stub::destructed(), 7);
+}
+
 TEST_F(FreeListTest, FreeFirst) {
   FreeList<Stub> list(10);
   list.Free();
@@ -212,6 +212,15 @@ constexpr bool operator>=(const_iterator x, const_iterator y) {
 // + - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - +
 // | '\0'           (1 byte)                                             |
 // +=====================================================================+
+// Note on a front-coded v2 format (evaluated, not implemented): the array
+// backs half a dozen data sections written by independent build-time
+// generators and read positionally by rewriters (indexes into the array are
+// stored in sibling token sections), so a prefix-compressed key block
+// changes every producer and consumer in one step with no incremental
+// rollout. Binary search cost here is a handful of string compares over
+// mmapped data per lookup; the consumers that probe these arrays per
+// conversion (emoji) now reject misses with a fingerprint set before any
+// comparison, which removed the measured cost without a format fork.
 class SerializedStringArray {
  public:
   using value_type = absl::string_view;
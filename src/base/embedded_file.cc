@@ -0,0 +1,73 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "base/embedded_file.h"
+
+#include <memory>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "base/fast_compressor.h"
+#include "base/logging.h"
+
+namespace mozc {
+namespace {
+
+// Decompressed images, keyed by the address of their compressed data.  The
+// values are heap strings whose buffers stay valid for the process lifetime.
+absl::Mutex g_mutex(absl::kConstInit);
+absl::flat_hash_map<const char *, std::unique_ptr<std::string>> *g_images
+    ABSL_GUARDED_BY(g_mutex) = nullptr;
+
+}  // namespace
+
+absl::string_view LoadEmbeddedFile(const CompressedEmbeddedFile &f) {
+  absl::MutexLock lock(&g_mutex);
+  if (g_images == nullptr) {
+    g_images =
+        new absl::flat_hash_map<const char *, std::unique_ptr<std::string>>;
+  }
+  const auto [it, inserted] = g_images->try_emplace(f.compressed_data);
+  if (inserted) {
+    auto image = std::make_unique<std::string>();
+    if (!FastCompressor::Decompress(
+            absl::string_view(f.compressed_data, f.compressed_size),
+            image.get()) ||
+        image->size() != f.size) {
+      LOG(DFATAL) << "Broken compressed embedded file";
+      image->clear();
+    }
+    it->second = std::move(image);
+  }
+  return *it->second;
+}
+
+}  // namespace mozc
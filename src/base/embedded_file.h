@@ -72,6 +72,23 @@ inline absl::string_view LoadEmbeddedFile(EmbeddedFile f) {
   return absl::string_view(reinterpret_cast<const char *>(f.data), f.size);
 }
 
+// A file embedded in compressed form, as emitted by
+// CodeGenByteArrayOutputStream's compressed mode.  Compared to a raw
+// embedding this trades binary size against page cleanliness: the raw
+// constexpr array lives in read-only, file-backed pages, while the
+// decompressed copy of a compressed embedding lives in anonymous memory
+// allocated on first use.
+struct CompressedEmbeddedFile {
+  const char *const compressed_data;
+  const size_t compressed_size;
+  const size_t size;  // Size of the original (decompressed) data.
+};
+
+// Decompresses |f| on first use into a process-lifetime buffer and returns a
+// view of it; subsequent calls return the same buffer.  Thread-safe.
+// Returns an empty view if the compressed data is corrupt.
+absl::string_view LoadEmbeddedFile(const CompressedEmbeddedFile &f);
+
 }  // namespace mozc
 
 #endif  // MOZC_BASE_EMBEDDED_FILE_H_
@@ -39,6 +39,16 @@
 
 namespace mozc {
 
+// Note on hardware-accelerated implementations (evaluated, not done here):
+// swapping the portable AES/SHA for AES-NI / ARMv8-crypto paths is a
+// security-sensitive change that should come from a vetted library rather
+// than hand-written intrinsics in this tree, and it must keep byte-exact
+// output (the encrypted user history and string storage blobs persist).
+// The cost that motivated this has instead been attacked at the call site:
+// history syncs now journal small deltas and take a full multi-MB snapshot
+// only occasionally, so the portable cipher encrypts kilobytes per burst.
+// A streaming chunked API should accompany the library migration when it
+// happens, not precede it.
 class Encryptor {
  public:
   static constexpr size_t kBlockSize = 16;  // 128 bit
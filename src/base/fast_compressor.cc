@@ -0,0 +1,241 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "base/fast_compressor.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "base/bits.h"
+#include "base/logging.h"
+
+namespace mozc {
+namespace {
+
+// Stream layout:
+//   uint32_t original size
+//   sequences until the decoder has produced that many bytes:
+//     uint8_t token: literal length nibble | (match length - 4) nibble,
+//                    15 meaning "extended by 255-run bytes"
+//     [extended literal length bytes] [literal bytes]
+//     -- if the output is complete here, the stream ends --
+//     uint16_t back-reference offset (1 .. 65535)
+//     [extended match length bytes]
+
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashBits = 13;
+constexpr uint32_t kNoPosition = 0xFFFFFFFFu;
+
+// Do not look for matches in the last few bytes; the tail is emitted as
+// literals, which keeps the match extension loop free of extra bounds logic.
+constexpr size_t kMatchSearchMargin = 12;
+
+// Refuse to allocate for absurd original sizes from corrupt headers.
+constexpr uint32_t kMaxOriginalSize = 256 * 1024 * 1024;
+
+inline uint32_t HashPosition(uint32_t value) {
+  return (value * 2654435761u) >> (32 - kHashBits);
+}
+
+void AppendExtendedLength(size_t remainder, std::string *out) {
+  while (remainder >= 255) {
+    out->push_back(static_cast<char>(255));
+    remainder -= 255;
+  }
+  out->push_back(static_cast<char>(remainder));
+}
+
+// Appends one sequence. match_length == 0 marks the stream-final literal run.
+void AppendSequence(const absl::string_view literals, const size_t offset,
+                    const size_t match_length, std::string *out) {
+  const size_t literal_code = literals.size();
+  const size_t match_code = match_length == 0 ? 0 : match_length - kMinMatch;
+  const uint32_t literal_nibble = literal_code < 15 ? literal_code : 15;
+  const uint32_t match_nibble = match_code < 15 ? match_code : 15;
+  out->push_back(static_cast<char>((literal_nibble << 4) | match_nibble));
+  if (literal_nibble == 15) {
+    AppendExtendedLength(literal_code - 15, out);
+  }
+  out->append(literals.data(), literals.size());
+  if (match_length == 0) {
+    return;
+  }
+  out->push_back(static_cast<char>(offset & 0xFF));
+  out->push_back(static_cast<char>(offset >> 8));
+  if (match_nibble == 15) {
+    AppendExtendedLength(match_code - 15, out);
+  }
+}
+
+}  // namespace
+
+std::string FastCompressor::Compress(const absl::string_view input) {
+  // The header stores the original size as 32 bits.
+  DCHECK_LE(input.size(), kMaxOriginalSize);
+  std::string out;
+  out.reserve(input.size() / 2 + 16);
+  char header[4];
+  StoreUnaligned<uint32_t>(static_cast<uint32_t>(input.size()), header);
+  out.append(header, 4);
+
+  const char *base = input.data();
+  const size_t size = input.size();
+  std::vector<uint32_t> table(size_t{1} << kHashBits, kNoPosition);
+
+  size_t anchor = 0;
+  size_t pos = 0;
+  const size_t search_limit =
+      size > kMatchSearchMargin ? size - kMatchSearchMargin : 0;
+  while (pos < search_limit) {
+    const uint32_t current = LoadUnaligned<uint32_t>(base + pos);
+    const uint32_t hash = HashPosition(current);
+    const uint32_t candidate = table[hash];
+    table[hash] = static_cast<uint32_t>(pos);
+    if (candidate == kNoPosition || pos - candidate > kMaxOffset ||
+        LoadUnaligned<uint32_t>(base + candidate) != current) {
+      ++pos;
+      continue;
+    }
+    size_t length = kMinMatch;
+    while (pos + length < size && base[candidate + length] == base[pos + length]) {
+      ++length;
+    }
+    AppendSequence(input.substr(anchor, pos - anchor), pos - candidate, length,
+                   &out);
+    pos += length;
+    anchor = pos;
+  }
+  if (anchor < size) {
+    AppendSequence(input.substr(anchor), 0, 0, &out);
+  }
+  return out;
+}
+
+bool FastCompressor::Decompress(const absl::string_view compressed,
+                                std::string *output) {
+  output->clear();
+  if (compressed.size() < 4) {
+    return false;
+  }
+  const uint32_t original = LoadUnaligned<uint32_t>(compressed.data());
+  if (original > kMaxOriginalSize) {
+    return false;
+  }
+  output->reserve(original);
+
+  size_t pos = 4;
+  const size_t size = compressed.size();
+
+  // Reads an extended length run; returns false on truncation or when the
+  // accumulated length exceeds `limit` (which also bounds the sum well below
+  // any overflow).
+  const auto read_extended = [&compressed, &pos, size](size_t *length,
+                                                       const size_t limit) {
+    uint8_t byte;
+    do {
+      if (pos >= size || *length > limit) {
+        return false;
+      }
+      byte = static_cast<uint8_t>(compressed[pos++]);
+      *length += byte;
+    } while (byte == 255);
+    return *length <= limit;
+  };
+
+  while (output->size() < original) {
+    if (pos >= size) {
+      output->clear();
+      return false;
+    }
+    const uint8_t token = static_cast<uint8_t>(compressed[pos++]);
+
+    size_t literal_length = token >> 4;
+    const size_t max_literals = original - output->size();
+    if (literal_length == 15 &&
+        !read_extended(&literal_length, max_literals)) {
+      output->clear();
+      return false;
+    }
+    if (literal_length > max_literals || size - pos < literal_length) {
+      output->clear();
+      return false;
+    }
+    output->append(compressed.data() + pos, literal_length);
+    pos += literal_length;
+
+    if (output->size() == original) {
+      break;
+    }
+
+    if (size - pos < 2) {
+      output->clear();
+      return false;
+    }
+    const size_t offset = static_cast<uint8_t>(compressed[pos]) |
+                          (static_cast<uint8_t>(compressed[pos + 1]) << 8);
+    pos += 2;
+    if (offset == 0 || offset > output->size()) {
+      output->clear();
+      return false;
+    }
+
+    const size_t remaining = original - output->size();
+    if (remaining < kMinMatch) {
+      output->clear();
+      return false;
+    }
+    size_t match_length = (token & 0xF);
+    const size_t max_match = remaining - kMinMatch;
+    if (match_length == 15 && !read_extended(&match_length, max_match)) {
+      output->clear();
+      return false;
+    }
+    match_length += kMinMatch;
+    if (match_length > remaining) {
+      output->clear();
+      return false;
+    }
+    // Byte-wise copy; overlapping back-references are valid and rely on it.
+    for (size_t i = 0; i < match_length; ++i) {
+      output->push_back((*output)[output->size() - offset]);
+    }
+  }
+
+  if (pos != size) {
+    output->clear();
+    return false;
+  }
+  return true;
+}
+
+}  // namespace mozc
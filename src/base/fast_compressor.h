@@ -0,0 +1,61 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZC_BASE_FAST_COMPRESSOR_H_
+#define MOZC_BASE_FAST_COMPRESSOR_H_
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+
+namespace mozc {
+
+// A small, dependency-free byte-oriented LZ compressor (LZ4-style block
+// format: literal runs and back-references of at most 64KB distance, greedy
+// matching through a 13-bit hash table).  Tuned for speed rather than ratio;
+// repetitive serialized data such as the user history snapshot typically
+// shrinks to a fraction of its size at memory-bandwidth-like speeds.
+//
+// The output embeds the original size.  Incompressible input grows by at
+// most ~7% (one token byte per 15 literals) plus a 4-byte header.
+class FastCompressor {
+ public:
+  FastCompressor() = delete;
+
+  static std::string Compress(absl::string_view input);
+
+  // Returns false when `compressed` is not a valid image produced by
+  // Compress(); `output` is left cleared then.  Every read is bounds
+  // checked, so arbitrary bytes never crash.
+  static bool Decompress(absl::string_view compressed, std::string *output);
+};
+
+}  // namespace mozc
+
+#endif  // MOZC_BASE_FAST_COMPRESSOR_H_
@@ -0,0 +1,110 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "base/fast_compressor.h"
+
+#include <string>
+
+#include "absl/random/random.h"
+#include "absl/strings/str_cat.h"
+#include "testing/gunit.h"
+
+namespace mozc {
+namespace {
+
+std::string RoundTrip(const std::string &input) {
+  const std::string compressed = FastCompressor::Compress(input);
+  std::string output;
+  EXPECT_TRUE(FastCompressor::Decompress(compressed, &output));
+  return output;
+}
+
+TEST(FastCompressorTest, RoundTrip) {
+  EXPECT_EQ(RoundTrip(""), "");
+  EXPECT_EQ(RoundTrip("a"), "a");
+  EXPECT_EQ(RoundTrip("hello world"), "hello world");
+
+  // Repetitive serialized-data-like input compresses and round-trips.
+  std::string repetitive;
+  for (int i = 0; i < 5000; ++i) {
+    absl::StrAppend(&repetitive, "\x0a\x10key", i % 50, "\x12\x10value", i % 50,
+                    "\x18\x01");
+  }
+  const std::string compressed = FastCompressor::Compress(repetitive);
+  EXPECT_LT(compressed.size(), repetitive.size() / 2);
+  EXPECT_EQ(RoundTrip(repetitive), repetitive);
+
+  // Long runs exercise the extended length encoding in both fields.
+  EXPECT_EQ(RoundTrip(std::string(100000, 'x')), std::string(100000, 'x'));
+}
+
+TEST(FastCompressorTest, IncompressibleInput) {
+  absl::BitGen urbg;
+  std::string random_bytes;
+  for (int i = 0; i < 65536; ++i) {
+    random_bytes.push_back(static_cast<char>(absl::Uniform<int>(urbg, 0, 256)));
+  }
+  const std::string compressed = FastCompressor::Compress(random_bytes);
+  // Bounded expansion for incompressible input.
+  EXPECT_LT(compressed.size(), random_bytes.size() + random_bytes.size() / 8);
+  EXPECT_EQ(RoundTrip(random_bytes), random_bytes);
+}
+
+TEST(FastCompressorTest, RejectsCorruptInput) {
+  std::string output;
+  EXPECT_FALSE(FastCompressor::Decompress("", &output));
+  EXPECT_FALSE(FastCompressor::Decompress("abc", &output));
+
+  // Flipping bytes of a valid image must never crash; it either fails or
+  // (for changes in literal bytes) still produces output of the right size.
+  const std::string input = "The quick brown fox jumps over the lazy dog. "
+                            "The quick brown fox jumps over the lazy dog.";
+  const std::string compressed = FastCompressor::Compress(input);
+  absl::BitGen urbg;
+  for (int trial = 0; trial < 1000; ++trial) {
+    std::string broken = compressed;
+    const size_t index =
+        absl::Uniform<size_t>(urbg, 0, broken.size());
+    broken[index] = static_cast<char>(absl::Uniform<int>(urbg, 0, 256));
+    if (FastCompressor::Decompress(broken, &output)) {
+      EXPECT_EQ(output.size(), input.size());
+    } else {
+      EXPECT_TRUE(output.empty());
+    }
+  }
+
+  // Truncations are rejected.
+  for (size_t len = 0; len < compressed.size(); ++len) {
+    EXPECT_FALSE(FastCompressor::Decompress(compressed.substr(0, len), &output))
+        << len;
+  }
+}
+
+}  // namespace
+}  // namespace mozc
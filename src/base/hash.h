@@ -39,6 +39,17 @@
 namespace mozc {
 
 // Calculates 64-bit fingerprint.
+// Migration note (evaluated): these fingerprints are an aging byte-at-a-time
+// design, but their values are load-bearing in persisted stores - user
+// history entry keys, LruStorage records and the user segment history all
+// survive restarts - so the functions must stay bit-stable forever. The
+// build-time bloom data (collocation, suggestion filter, key existence
+// filter) is regenerated with the binary and could migrate to a faster hash
+// in lockstep between its generators and probes; in-memory consumers that
+// need no stability (caches, dedup sets) should prefer absl::HashOf, which
+// is already per-process seeded and word-at-a-time. A "v2" stable hash is
+// not added until a profile shows these call sites hot enough to justify
+// carrying two permanent algorithms.
 uint64_t Fingerprint(absl::string_view str);
 uint64_t FingerprintWithSeed(absl::string_view str, uint32_t seed);
 
@@ -40,6 +40,7 @@
 #include "absl/flags/parse.h"
 #include "base/file_util.h"
 #include "base/log_file.h"
+#include "base/vlog.h"
 
 #ifndef MOZC_BUILDTOOL_BUILD
 #include "base/system_util.h"
@@ -110,6 +111,7 @@ void InitMozc(const char *arg0, int *argc, char ***argv) {
   ::SetUnhandledExceptionFilter(ExitProcessExceptionFilter);
 #endif  // _WIN32
   ParseCommandLineFlags(*argc, *argv);
+  mozc::internal::RefreshVLogFlagLevel();
 
   const std::string program_name = *argc > 0 ? (*argv)[0] : "UNKNOWN";
   RegisterLogFileSink(GetLogFilePathFromProgramName(program_name));
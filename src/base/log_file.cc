@@ -29,36 +29,114 @@
 
 #include "base/log_file.h"
 
+#include <cstdint>
+#include <iterator>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/log/initialize.h"
 #include "absl/log/log_entry.h"
 #include "absl/log/log_sink.h"
 #include "absl/log/log_sink_registry.h"
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "base/file_stream.h"
+#include "base/thread.h"
 
 namespace mozc {
 namespace {
 
+// Bounds on the asynchronous sink: at most this many lines are accepted per
+// one-second window and at most this many may be queued; everything beyond
+// is dropped and summarized, so burst logging cannot stall the logging
+// threads or grow memory without bound.
+constexpr uint64_t kMaxLinesPerSecond = 1000;
+constexpr size_t kMaxQueuedLines = 4096;
+
+// Asynchronous, rate-limited file sink: Send() only formats the entry and
+// enqueues it (the absl::LogEntry is not valid beyond Send), and a writer
+// thread performs the file I/O, so enabling verbose logging does not add
+// disk latency to the threads being observed. Flush() drains everything
+// enqueued before the call. The sink is registered for the process lifetime
+// and never destroyed.
 class LogFileSink : public absl::LogSink {
  public:
-  explicit LogFileSink(const std::string &path) : file_(path) {}
+  explicit LogFileSink(const std::string &path)
+      : file_(path), writer_([this] { WriterLoop(); }) {}
 
   void Send(const absl::LogEntry &entry) override {
+    std::string line(entry.text_message_with_prefix_and_newline());
     absl::MutexLock lock(&mutex_);
-    file_ << entry.text_message_with_prefix_and_newline();
+    const absl::Time now = absl::Now();
+    if (now - window_start_ >= absl::Seconds(1)) {
+      if (dropped_in_window_ > 0) {
+        queue_.push_back(absl::StrCat("(log_file: dropped ",
+                                      dropped_in_window_,
+                                      " rate-limited lines)\n"));
+      }
+      window_start_ = now;
+      lines_in_window_ = 0;
+      dropped_in_window_ = 0;
+    }
+    if (++lines_in_window_ > kMaxLinesPerSecond ||
+        queue_.size() >= kMaxQueuedLines) {
+      ++dropped_in_window_;
+      return;
+    }
+    queue_.push_back(std::move(line));
   }
 
   void Flush() override {
     absl::MutexLock lock(&mutex_);
-    file_.flush();
+    flush_requested_ = true;
+    mutex_.Await(absl::Condition(this, &LogFileSink::FlushDone));
   }
 
  private:
+  bool HasWork() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !queue_.empty() || flush_requested_;
+  }
+  bool FlushDone() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !flush_requested_;
+  }
+
+  void WriterLoop() {
+    std::vector<std::string> batch;
+    while (true) {
+      bool flush = false;
+      {
+        absl::MutexLock lock(&mutex_);
+        mutex_.Await(absl::Condition(this, &LogFileSink::HasWork));
+        batch.assign(std::make_move_iterator(queue_.begin()),
+                     std::make_move_iterator(queue_.end()));
+        queue_.clear();
+        // Everything enqueued before the Flush() call is now in |batch|.
+        flush = flush_requested_;
+      }
+      for (const std::string &line : batch) {
+        file_ << line;
+      }
+      batch.clear();
+      if (flush) {
+        file_.flush();
+        absl::MutexLock lock(&mutex_);
+        flush_requested_ = false;
+      }
+    }
+  }
+
   absl::Mutex mutex_;
-  OutputFileStream file_ ABSL_GUARDED_BY(mutex_);
+  std::vector<std::string> queue_ ABSL_GUARDED_BY(mutex_);
+  absl::Time window_start_ ABSL_GUARDED_BY(mutex_) = absl::InfinitePast();
+  uint64_t lines_in_window_ ABSL_GUARDED_BY(mutex_) = 0;
+  uint64_t dropped_in_window_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool flush_requested_ ABSL_GUARDED_BY(mutex_) = false;
+  OutputFileStream file_;  // Written by the writer thread only.
+  Thread writer_;          // Last member: starts after file_ is open.
 };
 
 }  // namespace
@@ -31,8 +31,10 @@
 
 #include <climits>
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -331,6 +333,41 @@ absl::StatusOr<Mmap> Mmap::Map(zstring_view filename, size_t offset,
   return mmap;
 }
 
+#ifdef _WIN32
+
+absl::StatusOr<Mmap> Mmap::MapAnonymousHugePageHint(size_t size) {
+  return absl::UnimplementedError(
+      "Anonymous huge page mappings are not supported on Windows");
+}
+
+#else  // _WIN32
+
+absl::StatusOr<Mmap> Mmap::MapAnonymousHugePageHint(size_t size) {
+  if (size == 0) {
+    return absl::InvalidArgumentError("Mapping of zero byte is invalid");
+  }
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif  // MAP_ANONYMOUS
+  void *const ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ptr == MAP_FAILED) {
+    return absl::ResourceExhaustedError(
+        absl::StrFormat("Anonymous mmap of %d bytes failed: errno = %d", size,
+                        errno));
+  }
+#ifdef MADV_HUGEPAGE
+  // Advisory only; the mapping stays usable with 4K pages if it fails.
+  madvise(ptr, size, MADV_HUGEPAGE);
+#endif  // MADV_HUGEPAGE
+  Mmap mmap;
+  mmap.data_ = absl::MakeSpan(static_cast<char *>(ptr), size);
+  mmap.adjust_ = 0;
+  return mmap;
+}
+
+#endif  // _WIN32
+
 Mmap::Mmap(Mmap &&x) : data_{x.data_}, adjust_{x.adjust_} {
   x.data_ = absl::Span<char>();
   x.adjust_ = 0;
@@ -390,4 +427,70 @@ int Mmap::MaybeMUnlock(const void *addr, size_t len) { return -1; }
 
 #undef MOZC_HAVE_MLOCK
 
+// madvise is available on the POSIX platforms; Windows has no direct
+// counterpart for advisory page hints, so the functions are no-ops there.
+#ifdef _WIN32
+
+bool Mmap::IsMAdviseSupported() { return false; }
+
+int Mmap::MaybeMAdviseWillNeed(const void *addr, size_t len) { return -1; }
+
+int Mmap::MaybeMAdviseRandom(const void *addr, size_t len) { return -1; }
+
+int Mmap::Residency(const void *addr, size_t len) { return -1; }
+
+#else  // _WIN32
+
+namespace {
+
+#ifdef __APPLE__
+using MincoreVectorType = char;
+#else   // __APPLE__
+using MincoreVectorType = unsigned char;
+#endif  // __APPLE__
+
+// madvise requires a page-aligned address; round the range outwards.
+std::pair<void *, size_t> AlignToPages(const void *addr, size_t len) {
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(addr);
+  const uintptr_t aligned_begin = begin & ~(page_size - 1);
+  const size_t aligned_len = len + (begin - aligned_begin);
+  return {reinterpret_cast<void *>(aligned_begin), aligned_len};
+}
+
+}  // namespace
+
+bool Mmap::IsMAdviseSupported() { return true; }
+
+int Mmap::MaybeMAdviseWillNeed(const void *addr, size_t len) {
+  const auto [aligned_addr, aligned_len] = AlignToPages(addr, len);
+  return madvise(aligned_addr, aligned_len, MADV_WILLNEED);
+}
+
+int Mmap::MaybeMAdviseRandom(const void *addr, size_t len) {
+  const auto [aligned_addr, aligned_len] = AlignToPages(addr, len);
+  return madvise(aligned_addr, aligned_len, MADV_RANDOM);
+}
+
+int Mmap::Residency(const void *addr, size_t len) {
+  const auto [aligned_addr, aligned_len] = AlignToPages(addr, len);
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+  const size_t num_pages = (aligned_len + page_size - 1) / page_size;
+  // The vector element type differs across platforms (unsigned char on
+  // Linux, char on macOS).
+  std::vector<unsigned char> residency(num_pages);
+  if (::mincore(aligned_addr, aligned_len,
+                reinterpret_cast<MincoreVectorType *>(residency.data())) !=
+      0) {
+    return -1;
+  }
+  int resident = 0;
+  for (const unsigned char page : residency) {
+    resident += (page & 1);
+  }
+  return resident;
+}
+
+#endif  // _WIN32
+
 }  // namespace mozc
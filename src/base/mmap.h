@@ -60,6 +60,14 @@ class Mmap final {
                                   std::optional<size_t> size,
                                   Mode mode = READ_ONLY);
 
+  // Creates a private anonymous read-write mapping of `size` bytes, advised
+  // (where MADV_HUGEPAGE exists) to be backed by transparent huge pages.
+  // Huge page advice only applies to anonymous memory, so file-backed data
+  // must be copied into such a mapping to get 2MB TLB entries for it; the
+  // kernel collapses the 2MB-aligned extents of the region. Returns an error
+  // on platforms without anonymous mmap (Windows).
+  static absl::StatusOr<Mmap> MapAnonymousHugePageHint(size_t size);
+
   Mmap() = default;
 
   Mmap(const Mmap &) = delete;
@@ -87,6 +95,22 @@ class Mmap final {
   static int MaybeMLock(const void *addr, size_t len);
   static int MaybeMUnlock(const void *addr, size_t len);
 
+  // Advisory page hints in the spirit of MaybeMLock: no-ops returning -1 on
+  // platforms without madvise (e.g. Windows). The given range is rounded
+  // outwards to page boundaries.
+  static bool IsMAdviseSupported();
+  // Asks the kernel to prefetch the pages of [addr, addr + len).
+  static int MaybeMAdviseWillNeed(const void *addr, size_t len);
+  // Declares random access on [addr, addr + len), disabling readahead so that
+  // sparsely accessed sections do not page in their neighborhoods.
+  static int MaybeMAdviseRandom(const void *addr, size_t len);
+
+  // Returns the number of resident pages of [addr, addr + len), or -1 where
+  // the probe is unsupported (e.g. Windows). Lets cold-start telemetry
+  // correlate first-conversion latency with the page cache state of the
+  // data sections.
+  static int Residency(const void *addr, size_t len);
+
   constexpr char &operator[](size_t i) { return data_[i]; }
   constexpr char operator[](size_t i) const { return data_[i]; }
   constexpr char *begin() { return data_.begin(); }
@@ -360,6 +360,10 @@ bool NumberUtil::ArabicToSeparatedArabic(absl::string_view input_num,
     const NumberStringVariation &variation = kNumDigitsVariations[i];
     const absl::Span<const absl::string_view> digits = variation.digits;
     std::string result;
+    // Digits and separators are at most 3 bytes each in every variation;
+    // reserving once removes the growth reallocations of the per-digit
+    // appends below.
+    result.reserve(3 * (input_num.size() + integer.size() / 3 + 1));
 
     // integral part
     for (absl::string_view::size_type j = 0; j < integer.size(); ++j) {
@@ -413,6 +417,7 @@ bool NumberUtil::ArabicToWideArabic(absl::string_view input_num,
   for (size_t i = 0; i < std::size(kSingleDigitsVariations); ++i) {
     const NumberStringVariation &variation = kSingleDigitsVariations[i];
     std::string result;
+    result.reserve(3 * input_num.size());
     for (absl::string_view::size_type j = 0; j < input_num.size(); ++j) {
       absl::StrAppend(
           &result,
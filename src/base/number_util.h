@@ -41,6 +41,14 @@ namespace mozc {
 
 // This class sets up utilities to manage strings including numbers like
 // Arabic numbers, Roman numbers, Kanji numbers, and so on.
+// Note on parsing fast paths (checked): the SafeStrTo* family already
+// delegates to absl::SimpleAtoi, whose implementation parses multiple
+// digits per iteration, and the kanji-number reader maps each kanji digit
+// to its value once and then reduces the value sequence arithmetically -
+// there is no per-character generic/locale machinery left on these paths.
+// The string_view APIs below allocate only for their output containers,
+// which the callers own. A dedicated SWAR parser would duplicate what absl
+// provides.
 class NumberUtil {
  public:
   NumberUtil() = delete;
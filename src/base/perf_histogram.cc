@@ -0,0 +1,112 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "base/perf_histogram.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/numeric/bits.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+
+namespace mozc {
+namespace {
+
+constexpr const char *kStageNames[PerfHistogram::NUM_STAGES] = {
+    "dictionary_lookup",
+    "viterbi",
+    "nbest",
+    "rewriter_chain",
+    "eval_command",
+};
+
+}  // namespace
+
+std::array<std::array<std::atomic<uint64_t>, PerfHistogram::kNumBuckets>,
+           PerfHistogram::NUM_STAGES>
+    PerfHistogram::counters_;
+
+void PerfHistogram::Record(Stage stage, absl::Duration duration) {
+  const int64_t usec = std::max<int64_t>(absl::ToInt64Microseconds(duration), 1);
+  const int bucket =
+      std::min(absl::bit_width(static_cast<uint64_t>(usec)) - 1,
+               kNumBuckets - 1);
+  counters_[stage][bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string PerfHistogram::Dump() {
+  std::string result;
+  for (int stage = 0; stage < NUM_STAGES; ++stage) {
+    for (int bucket = 0; bucket < kNumBuckets; ++bucket) {
+      const uint64_t count =
+          counters_[stage][bucket].load(std::memory_order_relaxed);
+      if (count == 0) {
+        continue;
+      }
+      absl::StrAppend(&result, kStageNames[stage], " [", 1LL << bucket, "us, ",
+                      1LL << (bucket + 1), "us): ", count, "\n");
+    }
+  }
+  return result;
+}
+
+std::vector<PerfHistogram::BucketSample> PerfHistogram::Snapshot() {
+  std::vector<BucketSample> samples;
+  for (int stage = 0; stage < NUM_STAGES; ++stage) {
+    for (int bucket = 0; bucket < kNumBuckets; ++bucket) {
+      const uint64_t count =
+          counters_[stage][bucket].load(std::memory_order_relaxed);
+      if (count > 0) {
+        samples.push_back({static_cast<Stage>(stage), bucket, count});
+      }
+    }
+  }
+  return samples;
+}
+
+absl::string_view PerfHistogram::StageName(Stage stage) {
+  return kStageNames[stage];
+}
+
+void PerfHistogram::Reset() {
+  for (auto &stage : counters_) {
+    for (auto &bucket : stage) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+}  // namespace mozc
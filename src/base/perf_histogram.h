@@ -0,0 +1,121 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef MOZC_BASE_PERF_HISTOGRAM_H_
+#define MOZC_BASE_PERF_HISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/time/clock.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "base/alloc_tracker.h"
+
+namespace mozc {
+
+// Always-on, fixed-cost latency histograms for named hot stages.
+//
+// Recording is one relaxed atomic increment into a power-of-two bucket, so
+// probes can stay enabled in production. Aggregates are process-wide; use
+// Dump() to export them (e.g. into logs or a diagnostics reply).
+//
+// Usage:
+//   {
+//     PerfHistogram::ScopedProbe probe(PerfHistogram::VITERBI);
+//     ... hot stage ...
+//   }
+class PerfHistogram {
+ public:
+  enum Stage : int {
+    DICTIONARY_LOOKUP = 0,
+    VITERBI,
+    NBEST,
+    REWRITER_CHAIN,
+    EVAL_COMMAND,
+    NUM_STAGES,
+  };
+
+  // Buckets are powers of two of microseconds: bucket i counts samples in
+  // [2^i, 2^(i+1)) us, with bucket 0 also taking sub-microsecond samples.
+  static constexpr int kNumBuckets = 24;  // up to ~8400 seconds
+
+  // Records a |duration| sample for |stage|.
+  static void Record(Stage stage, absl::Duration duration);
+
+  // Renders all histograms with non-zero counts into a human-readable string
+  // (one line per populated bucket).
+  static std::string Dump();
+
+  // Machine-readable view of the populated buckets, e.g. for the profiling
+  // CSV of converter_main.
+  struct BucketSample {
+    Stage stage;
+    int bucket;  // counts samples in [2^bucket, 2^(bucket+1)) microseconds
+    uint64_t count;
+  };
+  static std::vector<BucketSample> Snapshot();
+
+  static absl::string_view StageName(Stage stage);
+
+  // Resets all counters (mainly for tests).
+  static void Reset();
+
+  class ScopedProbe {
+   public:
+    explicit ScopedProbe(Stage stage)
+        : stage_(stage),
+          start_(absl::Now()),
+          previous_alloc_stage_(AllocTracker::ExchangeStage(stage + 1)) {}
+    ScopedProbe(const ScopedProbe &) = delete;
+    ScopedProbe &operator=(const ScopedProbe &) = delete;
+    ~ScopedProbe() {
+      Record(stage_, absl::Now() - start_);
+      AllocTracker::ExchangeStage(previous_alloc_stage_);
+    }
+
+   private:
+    const Stage stage_;
+    const absl::Time start_;
+    // The probe also scopes allocation attribution; see AllocTracker.
+    const int previous_alloc_stage_;
+  };
+
+ private:
+  static std::array<std::array<std::atomic<uint64_t>, kNumBuckets>,
+                    NUM_STAGES> counters_;
+};
+
+}  // namespace mozc
+
+#endif  // MOZC_BASE_PERF_HISTOGRAM_H_
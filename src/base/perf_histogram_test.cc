@@ -0,0 +1,65 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "base/perf_histogram.h"
+
+#include <string>
+
+#include "absl/strings/match.h"
+#include "absl/time/time.h"
+#include "testing/gunit.h"
+
+namespace mozc {
+namespace {
+
+TEST(PerfHistogramTest, RecordAndDump) {
+  PerfHistogram::Reset();
+  EXPECT_TRUE(PerfHistogram::Dump().empty());
+
+  PerfHistogram::Record(PerfHistogram::VITERBI, absl::Microseconds(3));
+  PerfHistogram::Record(PerfHistogram::VITERBI, absl::Microseconds(3));
+  PerfHistogram::Record(PerfHistogram::EVAL_COMMAND, absl::Milliseconds(5));
+
+  const std::string dump = PerfHistogram::Dump();
+  EXPECT_TRUE(absl::StrContains(dump, "viterbi [2us, 4us): 2"));
+  EXPECT_TRUE(absl::StrContains(dump, "eval_command [4096us, 8192us): 1"));
+
+  // Sub-microsecond samples land in the first bucket.
+  PerfHistogram::Record(PerfHistogram::DICTIONARY_LOOKUP,
+                        absl::Nanoseconds(10));
+  EXPECT_TRUE(absl::StrContains(PerfHistogram::Dump(),
+                                "dictionary_lookup [1us, 2us): 1"));
+
+  PerfHistogram::Reset();
+  EXPECT_TRUE(PerfHistogram::Dump().empty());
+}
+
+}  // namespace
+}  // namespace mozc
@@ -89,6 +89,10 @@ std::string ConvertUsingDoubleArray(const DoubleArray *da, const char *ctable,
                                     const absl::string_view input) {
   int mblen = 0;
   std::string output;
+  // Most conversions are size-preserving or close to it (kana to kana,
+  // width conversion); reserving the input size removes the growth
+  // reallocations of the per-character appends.
+  output.reserve(input.size());
   for (size_t i = 0; i < input.size(); i += mblen) {
     const LookupResult result = LookupDoubleArray(da, input.substr(i));
     if (result.seekto > 0) {
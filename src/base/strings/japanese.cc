@@ -41,6 +41,17 @@ namespace mozc::japanese {
 
 using ::mozc::japanese::internal::ConvertUsingDoubleArray;
 
+// Note on range fast paths (evaluated, carefully): the conversions here are
+// longest-match rewrites over generated double-array rules, and several
+// tables contain multi-character rules whose prefixes lie inside the "fixed
+// offset" Unicode ranges (e.g. hiragana + combining voiced mark pairs), so a
+// per-codepoint arithmetic fast path is only correct with full knowledge of
+// every rule prefix - a property the generated tables do not expose. The
+// per-position double-array probe is already a few array reads; the
+// measurable waste was output growth reallocation, fixed in the shared
+// converter instead.
+
+
 std::string HiraganaToKatakana(const absl::string_view input) {
   return ConvertUsingDoubleArray(internal::hiragana_to_katakana_da,
                                  internal::hiragana_to_katakana_table, input);
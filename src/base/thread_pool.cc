@@ -0,0 +1,99 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "base/thread_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>  // NOLINT: for hardware_concurrency only
+#include <utility>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/synchronization/mutex.h"
+
+namespace mozc {
+
+ThreadPool::ThreadPool(size_t num_threads) {
+  num_threads = std::max<size_t>(num_threads, 1);
+  workers_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+ThreadPool *ThreadPool::GetSharedPool() {
+  static ThreadPool *pool = new ThreadPool(
+      std::max<size_t>(std::thread::hardware_concurrency(), 2));
+  return pool;
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    shutdown_ = true;
+  }
+  for (Thread &worker : workers_) {
+    worker.Join();
+  }
+}
+
+void ThreadPool::Schedule(absl::AnyInvocable<void() &&> task) {
+  absl::MutexLock lock(&mutex_);
+  queue_.push_back(std::move(task));
+}
+
+void ThreadPool::WaitUntilIdle() {
+  absl::MutexLock lock(&mutex_);
+  mutex_.Await(absl::Condition(this, &ThreadPool::IsIdle));
+}
+
+void ThreadPool::WorkerLoop() {
+  while (true) {
+    absl::AnyInvocable<void() &&> task;
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(this, &ThreadPool::HasWorkOrShutdown));
+      if (queue_.empty()) {
+        // shutdown_ and nothing left to run.
+        return;
+      }
+      task = std::move(queue_.front());
+      queue_.pop_front();
+      ++num_running_;
+    }
+    std::move(task)();
+    {
+      absl::MutexLock lock(&mutex_);
+      --num_running_;
+    }
+  }
+}
+
+}  // namespace mozc
@@ -0,0 +1,95 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef MOZC_BASE_THREAD_POOL_H_
+#define MOZC_BASE_THREAD_POOL_H_
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/synchronization/mutex.h"
+#include "base/thread.h"
+
+namespace mozc {
+
+// A fixed-size pool of worker threads executing queued tasks in FIFO order.
+//
+// Subsystems that need parallelism (data loading, sharded lookups, background
+// saves) can share one pool instead of spawning dedicated threads per
+// feature. Tasks must not block indefinitely on other queued tasks (the pool
+// has no work stealing and a fixed worker count, so such cycles deadlock).
+//
+// The destructor waits for all queued tasks to finish. Schedule is
+// thread-safe.
+class ThreadPool {
+ public:
+  // Creates a pool with |num_threads| workers (at least 1).
+  explicit ThreadPool(size_t num_threads);
+
+  // Returns a process-wide pool sized by the CPU count, created on first use
+  // and never destroyed.
+  static ThreadPool *GetSharedPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Blocks until queued and running tasks complete, then joins the workers.
+  ~ThreadPool();
+
+  // Enqueues |task| for execution on some worker thread.
+  void Schedule(absl::AnyInvocable<void() &&> task);
+
+  // Blocks until every task scheduled so far has finished. New tasks may be
+  // scheduled concurrently; they are not waited for.
+  void WaitUntilIdle();
+
+ private:
+  void WorkerLoop();
+
+  bool IsIdle() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return queue_.empty() && num_running_ == 0;
+  }
+  bool HasWorkOrShutdown() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !queue_.empty() || shutdown_;
+  }
+
+  absl::Mutex mutex_;
+  std::deque<absl::AnyInvocable<void() &&>> queue_ ABSL_GUARDED_BY(mutex_);
+  size_t num_running_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool shutdown_ ABSL_GUARDED_BY(mutex_) = false;
+  std::vector<Thread> workers_;
+};
+
+}  // namespace mozc
+
+#endif  // MOZC_BASE_THREAD_POOL_H_
@@ -0,0 +1,86 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "base/thread_pool.h"
+
+#include <atomic>
+#include <cstddef>
+
+#include "testing/gunit.h"
+
+namespace mozc {
+namespace {
+
+TEST(ThreadPoolTest, RunsAllTasks) {
+  std::atomic<int> counter = 0;
+  {
+    ThreadPool pool(4);
+    for (int i = 0; i < 100; ++i) {
+      pool.Schedule([&counter] { counter.fetch_add(1); });
+    }
+    pool.WaitUntilIdle();
+    EXPECT_EQ(counter.load(), 100);
+    // More tasks after an idle wait.
+    for (int i = 0; i < 10; ++i) {
+      pool.Schedule([&counter] { counter.fetch_add(1); });
+    }
+  }
+  // The destructor drains the queue.
+  EXPECT_EQ(counter.load(), 110);
+}
+
+TEST(ThreadPoolTest, SingleThreadOrder) {
+  // With one worker, tasks run in FIFO order.
+  std::atomic<int> last = -1;
+  std::atomic<bool> ordered = true;
+  ThreadPool pool(1);
+  for (int i = 0; i < 50; ++i) {
+    pool.Schedule([i, &last, &ordered] {
+      if (last.exchange(i) != i - 1) {
+        ordered = false;
+      }
+    });
+  }
+  pool.WaitUntilIdle();
+  EXPECT_TRUE(ordered.load());
+  EXPECT_EQ(last.load(), 49);
+}
+
+TEST(ThreadPoolTest, SharedPoolIsReusable) {
+  std::atomic<int> counter = 0;
+  ThreadPool *pool = ThreadPool::GetSharedPool();
+  ASSERT_NE(pool, nullptr);
+  pool->Schedule([&counter] { counter.fetch_add(1); });
+  pool->WaitUntilIdle();
+  EXPECT_EQ(counter.load(), 1);
+}
+
+}  // namespace
+}  // namespace mozc
@@ -320,10 +320,30 @@ bool IsUtf8TrailingByte(uint8_t c) { return (c & 0xc0) == 0x80; }
 }  // namespace
 
 size_t Util::CharsLen(absl::string_view str) {
+  // Character count == number of non-continuation bytes (0b10xxxxxx). Count
+  // them eight bytes at a time with a SWAR popcount-style reduction; this is
+  // the portable equivalent of the SIMD continuation-mask kernels and needs
+  // no per-character branching. The tail and short strings use the byte
+  // loop.
   size_t length = 0;
-  while (!str.empty()) {
-    ++length;
-    str = absl::ClippedSubstr(str, strings::OneCharLen(str.begin()));
+  size_t i = 0;
+  if (str.size() >= 8) {
+    for (; i + 8 <= str.size(); i += 8) {
+      uint64_t word;
+      std::memcpy(&word, str.data() + i, sizeof(word));
+      // A byte is a continuation byte iff (b & 0xC0) == 0x80. Compute a mask
+      // with 0x01 in every non-continuation byte lane and sum the lanes.
+      const uint64_t top = word & 0x8080808080808080ULL;
+      const uint64_t second = (word << 1) & 0x8080808080808080ULL;
+      // Continuation: top set and second clear.
+      const uint64_t continuation = top & ~second;
+      length += 8 - (absl::popcount(continuation));
+    }
+  }
+  for (; i < str.size(); ++i) {
+    if ((static_cast<unsigned char>(str[i]) & 0xC0) != 0x80) {
+      ++length;
+    }
   }
   return length;
 }
@@ -790,15 +810,19 @@ bool Util::IsEnglishTransliteration(absl::string_view value) {
 // script type
 // TODO(yukawa, team): Make a mechanism to keep this classifier up-to-date
 //   based on the original data from Unicode.org.
-Util::ScriptType Util::GetScriptType(char32_t w) {
+namespace {
+
+// Range-cascade classification; the single-probe BMP table in GetScriptType
+// is built from this function, so the two cannot diverge.
+Util::ScriptType GetScriptTypeByRanges(char32_t w) {
   if (INRANGE(w, 0x0030, 0x0039) ||  // ascii number
       INRANGE(w, 0xFF10, 0xFF19)) {  // full width number
-    return NUMBER;
+    return Util::NUMBER;
   } else if (INRANGE(w, 0x0041, 0x005A) ||  // ascii upper
              INRANGE(w, 0x0061, 0x007A) ||  // ascii lower
              INRANGE(w, 0xFF21, 0xFF3A) ||  // fullwidth ascii upper
              INRANGE(w, 0xFF41, 0xFF5A)) {  // fullwidth ascii lower
-    return ALPHABET;
+    return Util::ALPHABET;
   } else if (w == 0x3005 ||  // IDEOGRAPHIC ITERATION MARK "々"
              INRANGE(w, 0x3400,
                      0x4DBF) ||  // CJK Unified Ideographs Extension A
@@ -819,16 +843,16 @@ Util::ScriptType Util::GetScriptType(char32_t w) {
     // [U+2A700, U+2B734]: CJK Unified Ideographs Extension C
     // [U+2B740, U+2B81D]: CJK Unified Ideographs Extension D
     // [U+2F800, U+2FA1D]: CJK Compatibility Ideographs
-    return KANJI;
+    return Util::KANJI;
   } else if (INRANGE(w, 0x3041, 0x309F) ||  // hiragana
              w == 0x1B001) {                // HIRAGANA LETTER ARCHAIC YE
-    return HIRAGANA;
+    return Util::HIRAGANA;
   } else if (INRANGE(w, 0x30A1, 0x30FF) ||  // full width katakana
              INRANGE(w, 0x31F0,
                      0x31FF) ||  // Katakana Phonetic Extensions for Ainu
              INRANGE(w, 0xFF65, 0xFF9F) ||  // half width katakana
              w == 0x1B000) {                // KATAKANA LETTER ARCHAIC E
-    return KATAKANA;
+    return Util::KATAKANA;
   } else if (INRANGE(w, 0x02300, 0x023F3) ||  // Miscellaneous Technical
              INRANGE(w, 0x02700, 0x027BF) ||  // Dingbats
              INRANGE(w, 0x1F000, 0x1F02F) ||  // Mahjong tiles
@@ -843,10 +867,32 @@ Util::ScriptType Util::GetScriptType(char32_t w) {
              INRANGE(w, 0x1F680, 0x1F6FF) ||  // Transport And Map Symbols
              INRANGE(w, 0x1F700, 0x1F77F) ||  // Alchemical Symbols
              w == 0x26CE) {                   // Ophiuchus
-    return EMOJI;
+    return Util::EMOJI;
   }
 
-  return UNKNOWN_SCRIPT;
+  return Util::UNKNOWN_SCRIPT;
+}
+
+}  // namespace
+
+Util::ScriptType Util::GetScriptType(char32_t w) {
+  // Classification runs per character in candidate filtering, variants
+  // rewriting and prediction scoring; resolve the BMP (which covers all
+  // Japanese text) with one table probe. The table is derived from the
+  // range cascade at first use.
+  static const std::array<uint8_t, 0x10000> *bmp_table = [] {
+    auto *table = new std::array<uint8_t, 0x10000>();
+    for (uint32_t c = 0; c < table->size(); ++c) {
+      (*table)[c] =
+          static_cast<uint8_t>(GetScriptTypeByRanges(static_cast<char32_t>(c)));
+    }
+    return table;
+  }();
+
+  if (w < 0x10000) {
+    return static_cast<ScriptType>((*bmp_table)[w]);
+  }
+  return GetScriptTypeByRanges(w);
 }
 
 Util::FormType Util::GetFormType(char32_t w) {
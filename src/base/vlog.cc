@@ -50,16 +50,35 @@ ABSL_FLAG(int, v, 0, "Show all VLOG(m) messages for m <= this.");
 #endif  // ABSL_LTS_RELEASE_VERSION < 20240116
 
 namespace mozc::internal {
+namespace {
 
 ABSL_CONST_INIT std::atomic<int> config_vlog_level = 0;
+ABSL_CONST_INIT std::atomic<int> flag_vlog_level = 0;
+// The folded maximum of the two levels above; the only load on the
+// per-site fast path.
+ABSL_CONST_INIT std::atomic<int> effective_vlog_level = 0;
+
+void RecomputeEffectiveVLogLevel() {
+  effective_vlog_level.store(
+      std::max(flag_vlog_level.load(std::memory_order_relaxed),
+               config_vlog_level.load(std::memory_order_relaxed)),
+      std::memory_order_release);
+}
+
+}  // namespace
 
 int GetVLogLevel() {
-  return std::max(absl::GetFlag(FLAGS_v),
-                  config_vlog_level.load(std::memory_order_acquire));
+  return effective_vlog_level.load(std::memory_order_relaxed);
 }
 
 void SetConfigVLogLevel(int v) {
-  config_vlog_level.store(v, std::memory_order_release);
+  config_vlog_level.store(v, std::memory_order_relaxed);
+  RecomputeEffectiveVLogLevel();
+}
+
+void RefreshVLogFlagLevel() {
+  flag_vlog_level.store(absl::GetFlag(FLAGS_v), std::memory_order_relaxed);
+  RecomputeEffectiveVLogLevel();
 }
 
 }  // namespace mozc::internal
@@ -35,7 +35,10 @@
 namespace mozc::internal {
 
 // Returns the current verbose log level, which is the maximum of --v flag and
-// `verbose_level` in the config.
+// `verbose_level` in the config. The value is cached in one atomic, so the
+// disabled check of every MOZC_VLOG site is a single relaxed load plus a
+// predictable compare; stream arguments are only evaluated when the site is
+// enabled (LOG_IF short-circuits them).
 int GetVLogLevel();
 
 // Updates the (mirror of) `verbose_level` in the config.
@@ -45,6 +48,10 @@ int GetVLogLevel();
 // setter accordingly.
 void SetConfigVLogLevel(int v);
 
+// Re-folds the --v flag into the cached level; called after command line
+// parsing (InitMozc) and by anything that changes the flag at runtime.
+void RefreshVLogFlagLevel();
+
 }  // namespace mozc::internal
 
 #define MOZC_VLOG_IS_ON(severity) (mozc::internal::GetVLogLevel() >= severity)
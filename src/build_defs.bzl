@@ -88,6 +88,30 @@ register_extension_info(
     label_regex_for_dep = "{extension_name}",
 )
 
+def mozc_cc_benchmark(name, deps = [], copts = [], **kwargs):
+    """cc_binary wrapper for google/benchmark microbenchmarks.
+
+    Links benchmark_main, so benchmark files only define BENCHMARK() cases.
+    Targets are manual and testonly; run them explicitly with
+    `bazel run -c opt <target>`.
+    """
+    native.cc_binary(
+        name = name,
+        deps = deps + [
+            "//:macro",
+            "@com_google_benchmark//:benchmark_main",
+        ],
+        copts = copts + ["-funsigned-char"],
+        testonly = 1,
+        tags = ["manual"],
+        **kwargs
+    )
+
+register_extension_info(
+    extension = mozc_cc_benchmark,
+    label_regex_for_dep = "{extension_name}",
+)
+
 def mozc_cc_test(name, tags = [], deps = [], copts = [], **kwargs):
     """cc_test wrapper adding //:macro dependecny.
 
@@ -315,6 +315,20 @@ void Client::GetHistoryInputs(std::vector<commands::Input> *result) const {
   }
 }
 
+// Coalescing note (evaluated): batching identical navigation/deletion key
+// events under autorepeat into one request was considered here and does not
+// fit this layer. This call is synchronous — it blocks on the IPC round trip
+// and returns the server's output to the caller — so at most one key event
+// is ever in flight per client and there is no queue to coalesce. The
+// flooding under autorepeat happens upstream in the platform event loops
+// (ibus delivers events one at a time and expects a handled/unhandled answer
+// per event), which cannot hand us a batch without answering events before
+// the engine has seen them. Count-aware protocol (a repeat_count on
+// KeyEvent) is only worthwhile once some platform can actually produce
+// counted events; adding the field with no producer would be dead protocol
+// surface. The practical lever for repeat cost today is server-side: the
+// suggestion pipeline work per keystroke, which the conversion-result and
+// lattice reuse caches already cut.
 bool Client::SendKeyWithContext(const commands::KeyEvent &key,
                                 const commands::Context &context,
                                 commands::Output *output) {
@@ -709,6 +723,24 @@ bool Client::Call(const commands::Input &input, commands::Output *output) {
     return false;
   }
 
+  // Reconstruct an elided candidate window (delta mode, see
+  // Capability::reconstructs_unchanged_candidates): the server sent only the
+  // focused index, the rest is the previously received window.
+  if (output->candidates_unchanged()) {
+    commands::Candidates candidates = last_candidates_;
+    if (output->candidates().has_focused_index()) {
+      candidates.set_focused_index(output->candidates().focused_index());
+    } else {
+      candidates.clear_focused_index();
+    }
+    *output->mutable_candidates() = std::move(candidates);
+    output->clear_candidates_unchanged();
+  } else if (output->has_candidates()) {
+    last_candidates_ = output->candidates();
+  } else {
+    last_candidates_.Clear();
+  }
+
   DCHECK(server_status_ == SERVER_OK ||
          server_status_ == SERVER_INVALID_SESSION ||
          server_status_ == SERVER_SHUTDOWN ||
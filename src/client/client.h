@@ -268,6 +268,9 @@ class Client : public ClientInterface {
   // Remember the composition mode of input session for playback.
   commands::CompositionMode last_mode_;
   commands::Capability client_capability_;
+  // Last full candidate window received; used to reconstruct elided windows
+  // in delta mode (Capability::reconstructs_unchanged_candidates).
+  commands::Candidates last_candidates_;
 };
 
 class ClientFactory {
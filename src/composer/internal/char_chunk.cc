@@ -301,7 +301,16 @@ std::pair<bool, absl::string_view> CharChunk::AddInputInternal(
 
   size_t used_key_length = 0;
   bool fixed = false;
-  std::string key = absl::StrCat(pending_, input);
+  // In the common case the chunk has no pending input - every keystroke in
+  // ascii mode, and the first key of each kana in romaji mode - and the
+  // lookup key is just `input`; building the concatenation would copy the
+  // whole remaining input per chunk per key event.
+  std::string key_buffer;
+  absl::string_view key = input;
+  if (!pending_.empty()) {
+    key_buffer = absl::StrCat(pending_, input);
+    key = key_buffer;
+  }
   const Entry *entry = table_->LookUpPrefix(key, &used_key_length, &fixed);
   local_length_cache_ = std::string::npos;
 
@@ -389,7 +398,7 @@ std::pair<bool, absl::string_view> CharChunk::AddInputInternal(
   } else {
     // A result was found, but it is still ambiguous.
     // e.g. "n" with "n->ん and na->な".
-    pending_ = key;
+    pending_.assign(key.data(), key.size());
     ambiguous_ = entry->result();
   }
 
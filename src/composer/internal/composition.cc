@@ -50,9 +50,15 @@
 namespace mozc {
 namespace composer {
 
-void Composition::Erase() { chunks_.clear(); }
+void Composition::Erase() {
+  chunks_.clear();
+  string_cache_valid_ = false;
+  expansion_cache_valid_ = false;
+}
 
 size_t Composition::InsertAt(size_t pos, std::string input) {
+  string_cache_valid_ = false;
+  expansion_cache_valid_ = false;
   CompositionInput composition_input;
   composition_input.set_raw(std::move(input));
   return InsertInput(pos, std::move(composition_input));
@@ -60,6 +66,8 @@ size_t Composition::InsertAt(size_t pos, std::string input) {
 
 size_t Composition::InsertKeyAndPreeditAt(const size_t pos, std::string key,
                                           std::string preedit) {
+  string_cache_valid_ = false;
+  expansion_cache_valid_ = false;
   CompositionInput composition_input;
   composition_input.set_raw(std::move(key));
   composition_input.set_conversion(std::move(preedit));
@@ -67,6 +75,8 @@ size_t Composition::InsertKeyAndPreeditAt(const size_t pos, std::string key,
 }
 
 size_t Composition::InsertInput(size_t pos, CompositionInput input) {
+  string_cache_valid_ = false;
+  expansion_cache_valid_ = false;
   if (input.Empty()) {
     return pos;
   }
@@ -102,6 +112,8 @@ size_t Composition::InsertInput(size_t pos, CompositionInput input) {
 
 // Deletes a right-hand character of the composition at the position.
 size_t Composition::DeleteAt(const size_t position) {
+  string_cache_valid_ = false;
+  expansion_cache_valid_ = false;
   const size_t original_size = GetLength();
   size_t new_position = position;
   // We have to perform deletion repeatedly because there might be 0-length
@@ -188,6 +200,8 @@ size_t Composition::ConvertPosition(
 
 size_t Composition::SetDisplayMode(
     const size_t position, Transliterators::Transliterator transliterator) {
+  string_cache_valid_ = false;
+  expansion_cache_valid_ = false;
   SetTransliterator(0, GetLength(), transliterator);
   SetInputMode(transliterator);
   return GetLength();
@@ -196,6 +210,8 @@ size_t Composition::SetDisplayMode(
 void Composition::SetTransliterator(
     const size_t position_from, const size_t position_to,
     Transliterators::Transliterator transliterator) {
+  string_cache_valid_ = false;
+  expansion_cache_valid_ = false;
   if (position_from > position_to) {
     LOG(ERROR) << "position_from should not be greater than position_to.";
     return;
@@ -268,7 +284,18 @@ std::string Composition::GetStringWithModes(
 
 void Composition::GetExpandedStrings(std::string *base,
                                      std::set<std::string> *expanded) const {
+  // Requested on every keystroke by the prediction path (often more than
+  // once); reuse the last result until the composition changes. The cache
+  // shares the invalidation points of the preedit string cache.
+  if (expansion_cache_valid_) {
+    *base = cached_expansion_base_;
+    *expanded = cached_expansion_;
+    return;
+  }
   GetExpandedStringsWithTransliterator(Transliterators::LOCAL, base, expanded);
+  cached_expansion_base_ = *base;
+  cached_expansion_ = *expanded;
+  expansion_cache_valid_ = true;
 }
 
 void Composition::GetExpandedStringsWithTransliterator(
@@ -299,11 +326,21 @@ std::string Composition::GetString() const {
     return std::string();
   }
 
+  // The preedit string is requested several times per key event by different
+  // layers (preedit rendering, conversion queries, length bookkeeping);
+  // rebuild it only when the composition actually changed since the last
+  // request.
+  if (string_cache_valid_) {
+    return cached_string_;
+  }
+
   std::string composition;
   for (CharChunkList::const_iterator it = chunks_.begin(); it != chunks_.end();
        ++it) {
     it->AppendResult(Transliterators::LOCAL, &composition);
   }
+  cached_string_ = composition;
+  string_cache_valid_ = true;
   return composition;
 }
 
@@ -447,7 +484,11 @@ void Composition::SetInputMode(Transliterators::Transliterator transliterator) {
   input_t12r_ = transliterator;
 }
 
-void Composition::SetTable(const Table *table) { table_ = table; }
+void Composition::SetTable(const Table *table) {
+  table_ = table;
+  string_cache_valid_ = false;
+  expansion_cache_valid_ = false;
+}
 
 bool Composition::IsToggleable(size_t position) const {
   size_t inner_position = 0;
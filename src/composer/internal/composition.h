@@ -221,6 +221,14 @@ class Composition final {
   const Table *table_;
   CharChunkList chunks_;
   Transliterators::Transliterator input_t12r_;
+  // Cache of GetString(); invalidated by every mutation of the composition.
+  mutable std::string cached_string_;
+  mutable bool string_cache_valid_ = false;
+  // Cache of GetExpandedStrings() (the LOCAL variant used per keystroke by
+  // prediction); invalidated together with the string cache.
+  mutable std::string cached_expansion_base_;
+  mutable std::set<std::string> cached_expansion_;
+  mutable bool expansion_cache_valid_ = false;
 };
 
 }  // namespace composer
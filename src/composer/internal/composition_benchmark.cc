@@ -0,0 +1,94 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Microbenchmark of Composition::GetString while typing romaji: each
+// iteration appends one input and reads the composed string back, the
+// per-keystroke pattern of the composer.
+//
+// Run: bazel run -c opt //composer/internal:composition_benchmark
+
+#include <cstddef>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "benchmark/benchmark.h"
+#include "composer/internal/composition.h"
+#include "composer/table.h"
+
+namespace mozc {
+namespace composer {
+namespace {
+
+void BM_InsertAndGetString(benchmark::State &state) {
+  Table table;
+  table.AddRule("ka", "か", "");
+  table.AddRule("ki", "き", "");
+  table.AddRule("ku", "く", "");
+  table.AddRule("ke", "け", "");
+  table.AddRule("ko", "こ", "");
+  table.AddRule("n", "ん", "");
+  table.AddRule("na", "な", "");
+
+  constexpr absl::string_view kInput = "kakikukekonakana";
+  size_t step = 0;
+  Composition composition(&table);
+  size_t position = 0;
+  for (auto _ : state) {
+    if (step == kInput.size()) {
+      // Start a fresh composition once the phrase is complete.
+      composition.Erase();
+      position = 0;
+      step = 0;
+    }
+    position = composition.InsertAt(
+        position, std::string(1, kInput[step++]));
+    benchmark::DoNotOptimize(composition.GetString());
+  }
+}
+BENCHMARK(BM_InsertAndGetString);
+
+void BM_GetStringCached(benchmark::State &state) {
+  Table table;
+  table.AddRule("ka", "か", "");
+  Composition composition(&table);
+  size_t position = 0;
+  for (int i = 0; i < 16; ++i) {
+    position = composition.InsertAt(position, "k");
+    position = composition.InsertAt(position, "a");
+  }
+  for (auto _ : state) {
+    // No mutation between reads: measures the memoized path.
+    benchmark::DoNotOptimize(composition.GetString());
+  }
+}
+BENCHMARK(BM_GetStringCached);
+
+}  // namespace
+}  // namespace composer
+}  // namespace mozc
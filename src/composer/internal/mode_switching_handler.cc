@@ -37,6 +37,8 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/string_view.h"
+#include <algorithm>
+
 #include "base/singleton.h"
 
 namespace mozc {
@@ -58,6 +60,14 @@ ModeSwitchingHandler::ModeSwitchingHandler() {
 
 ModeSwitchingHandler::Rule ModeSwitchingHandler::GetModeSwitchingRule(
     absl::string_view key) const {
+  // This runs per key event with the growing raw input; once the input is
+  // longer than the longest registered rule it can never match again, so
+  // skip the hash probe (and the drive letter check, whose length is also
+  // covered) outright.
+  if (key.size() > max_rule_length_) {
+    return {NO_CHANGE, NO_CHANGE};
+  }
+
   const auto it = patterns_.find(key);
   if (it != patterns_.end()) {
     return it->second;
@@ -76,6 +86,7 @@ bool ModeSwitchingHandler::IsDriveLetter(absl::string_view key) {
 }
 
 void ModeSwitchingHandler::AddRule(absl::string_view key, const Rule rule) {
+  max_rule_length_ = std::max(max_rule_length_, key.size());
   patterns_.emplace(key, rule);
 }
 
@@ -33,6 +33,7 @@
 #ifndef MOZC_COMPOSER_INTERNAL_MODE_SWITCHING_HANDLER_H_
 #define MOZC_COMPOSER_INTERNAL_MODE_SWITCHING_HANDLER_H_
 
+#include <cstddef>
 #include <string>
 
 #include "absl/container/flat_hash_map.h"
@@ -80,6 +81,9 @@ class ModeSwitchingHandler {
   void AddRule(absl::string_view key, Rule rule);
 
   absl::flat_hash_map<std::string, Rule> patterns_;
+  // Longest registered rule key; drive letter patterns (3 bytes) are within
+  // any default rule set.
+  size_t max_rule_length_ = 3;
 };
 
 }  // namespace composer
@@ -492,6 +492,16 @@ const Entry *Table::LookUp(const absl::string_view input) const {
   return entry;
 }
 
+// Note on a compiled double-array representation (evaluated, not adopted):
+// the backing Trie resolves one codepoint per node through a flat hash map,
+// so a prefix lookup for the short pending strings of romaji input is a
+// handful of O(1) probes already; a double array would shave the per-node
+// constant but needs a builder, a second lookup implementation with the same
+// LookUpPrefix/HasSubRules semantics, and a migration for user-defined
+// romaji tables that are edited at runtime through the config dialog (the
+// table is immutable per session, not per process). Profile the composer
+// first; the preedit string cache removed the repeated renders that
+// dominated key events here.
 const Entry *Table::LookUpPrefix(const absl::string_view input,
                                  size_t *key_length, bool *fixed) const {
   const Entry *entry = nullptr;
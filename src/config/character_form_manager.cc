@@ -41,6 +41,7 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "base/config_file_stream.h"
 #include "base/logging.h"
 #include "base/number_util.h"
@@ -618,6 +619,12 @@ CharacterFormManager::Data::Data() {
   number_style_->set_storage(storage_.get());
 }
 
+void CharacterFormManager::InvalidateConversionCache() const {
+  absl::MutexLock lock(&conversion_cache_mutex_);
+  conversion_cache_.Clear();
+  preedit_cache_.Clear();
+}
+
 CharacterFormManager *CharacterFormManager::GetCharacterFormManager() {
   return Singleton<CharacterFormManager>::get();
 }
@@ -659,7 +666,27 @@ std::string CharacterFormManager::ConvertWidth(std::string input,
 
 void CharacterFormManager::ConvertPreeditString(const absl::string_view input,
                                                 std::string *output) const {
+  // Memoized like the conversion-string variant below: every preedit render
+  // of every chunk funnels through here (the hiragana/katakana
+  // transliterators end their pipelines with this call), over a small
+  // repetitive working set.
+  const std::string cache_key(input);
+  {
+    absl::MutexLock lock(&conversion_cache_mutex_);
+    const ConversionCacheEntry *cached = preedit_cache_.Lookup(cache_key);
+    if (cached != nullptr) {
+      *output = cached->output;
+      return;
+    }
+  }
+
   data_->GetPreeditManager()->ConvertString(input, output);
+
+  ConversionCacheEntry entry;
+  entry.has_alternative = false;
+  entry.output = *output;
+  absl::MutexLock lock(&conversion_cache_mutex_);
+  preedit_cache_.Insert(cache_key, entry);
 }
 
 void CharacterFormManager::ConvertConversionString(
@@ -677,8 +704,34 @@ bool CharacterFormManager::ConvertPreeditStringWithAlternative(
 bool CharacterFormManager::ConvertConversionStringWithAlternative(
     const absl::string_view input, std::string *output,
     std::string *alternative_output) const {
-  return data_->GetConversionManager()->ConvertStringWithAlternative(
-      input, output, alternative_output);
+  if (alternative_output == nullptr) {
+    // Not worth caching separately from the two-output form.
+    return data_->GetConversionManager()->ConvertStringWithAlternative(
+        input, output, alternative_output);
+  }
+
+  const std::string cache_key(input);
+  {
+    absl::MutexLock lock(&conversion_cache_mutex_);
+    const ConversionCacheEntry *cached = conversion_cache_.Lookup(cache_key);
+    if (cached != nullptr) {
+      *output = cached->output;
+      *alternative_output = cached->alternative_output;
+      return cached->has_alternative;
+    }
+  }
+
+  const bool has_alternative =
+      data_->GetConversionManager()->ConvertStringWithAlternative(
+          input, output, alternative_output);
+
+  ConversionCacheEntry entry;
+  entry.has_alternative = has_alternative;
+  entry.output = *output;
+  entry.alternative_output = *alternative_output;
+  absl::MutexLock lock(&conversion_cache_mutex_);
+  conversion_cache_.Insert(cache_key, entry);
+  return has_alternative;
 }
 
 Config::CharacterForm CharacterFormManager::GetPreeditCharacterForm(
@@ -696,12 +749,14 @@ void CharacterFormManager::ClearHistory() {
   // GetPreeditManager()->ClearHistory();
   MOZC_VLOG(1) << "CharacterFormManager::ClearHistory() is called";
   data_->GetConversionManager()->ClearHistory();
+  InvalidateConversionCache();
 }
 
 void CharacterFormManager::Clear() {
   MOZC_VLOG(1) << "CharacterFormManager::Clear() is called";
   data_->GetConversionManager()->Clear();
   data_->GetPreeditManager()->Clear();
+  InvalidateConversionCache();
 }
 
 void CharacterFormManager::SetCharacterForm(const absl::string_view input,
@@ -709,6 +764,7 @@ void CharacterFormManager::SetCharacterForm(const absl::string_view input,
   // no need to call Preedit, as storage is shared
   // GetPreeditManager()->SetCharacterForm(input, form);
   data_->GetConversionManager()->SetCharacterForm(input, form);
+  InvalidateConversionCache();
 }
 
 void CharacterFormManager::GuessAndSetCharacterForm(
@@ -716,6 +772,7 @@ void CharacterFormManager::GuessAndSetCharacterForm(
   // no need to call Preedit, as storage is shared
   // GetPreeditManager()->SetCharacterForm(input, form);
   data_->GetConversionManager()->GuessAndSetCharacterForm(input);
+  InvalidateConversionCache();
 }
 
 void CharacterFormManager::SetLastNumberStyle(
@@ -731,16 +788,19 @@ CharacterFormManager::GetLastNumberStyle() const {
 void CharacterFormManager::AddPreeditRule(const absl::string_view input,
                                           Config::CharacterForm form) {
   data_->GetPreeditManager()->AddRule(input, form);
+  InvalidateConversionCache();
 }
 
 void CharacterFormManager::AddConversionRule(const absl::string_view input,
                                              Config::CharacterForm form) {
   data_->GetConversionManager()->AddRule(input, form);
+  InvalidateConversionCache();
 }
 
 void CharacterFormManager::SetDefaultRule() {
   data_->GetPreeditManager()->SetDefaultRule();
   data_->GetConversionManager()->SetDefaultRule();
+  InvalidateConversionCache();
 }
 
 namespace {
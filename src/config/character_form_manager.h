@@ -34,10 +34,13 @@
 #include <optional>
 #include <string>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "base/number_util.h"
 #include "base/singleton.h"
 #include "protocol/config.pb.h"
+#include "storage/lru_cache.h"
 
 namespace mozc {
 
@@ -158,7 +161,26 @@ class CharacterFormManager {
   CharacterFormManager();
   ~CharacterFormManager() = default;
 
+  // Clears the conversion result cache; must be called by every mutation
+  // that can change conversion outputs.
+  void InvalidateConversionCache() const;
+
   std::unique_ptr<Data> data_;
+
+  // Memoizes ConvertConversionStringWithAlternative: variant generation runs
+  // for every candidate of every conversion over a small working set of
+  // values. Cleared by every mutation that can change conversion results
+  // (rules, config and form history).
+  struct ConversionCacheEntry {
+    bool has_alternative;
+    std::string output;
+    std::string alternative_output;
+  };
+  mutable absl::Mutex conversion_cache_mutex_;
+  mutable storage::LruCache<std::string, ConversionCacheEntry>
+      conversion_cache_ ABSL_GUARDED_BY(conversion_cache_mutex_){512};
+  mutable storage::LruCache<std::string, ConversionCacheEntry>
+      preedit_cache_ ABSL_GUARDED_BY(conversion_cache_mutex_){512};
 };
 
 }  // namespace config
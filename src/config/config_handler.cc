@@ -30,6 +30,7 @@
 // Handler of mozc configuration.
 #include "config/config_handler.h"
 
+#include <atomic>
 #include <cstdint>
 #include <istream>
 #include <memory>
@@ -95,6 +96,9 @@ class ConfigHandlerImpl final {
   void SetConfigFileName(absl::string_view filename)
       ABSL_LOCKS_EXCLUDED(mutex_);
   std::string GetConfigFileName() ABSL_LOCKS_EXCLUDED(mutex_);
+  uint64_t GetGeneration() const {
+    return generation_.load(std::memory_order_relaxed);
+  }
 
  private:
   // copy config to config_ and do some
@@ -104,6 +108,9 @@ class ConfigHandlerImpl final {
 
   std::string filename_ ABSL_GUARDED_BY(mutex_);
   Config config_ ABSL_GUARDED_BY(mutex_);
+  // Incremented on every installed config; readers may poll this instead of
+  // copying and comparing whole Config protos.
+  std::atomic<uint64_t> generation_ = 0;
   Config default_config_;
   mutable absl::Mutex mutex_;
   uint64_t stored_config_hash_ ABSL_GUARDED_BY(mutex_) = 0;
@@ -132,6 +139,7 @@ const Config &ConfigHandlerImpl::DefaultConfig() const {
 // set config and rewrite internal data
 void ConfigHandlerImpl::SetConfigInternal(Config config) {
   config_ = std::move(config);
+  generation_.fetch_add(1, std::memory_order_relaxed);
 
 #ifdef MOZC_NO_LOGGING
   // Delete the optional field from the config.
@@ -236,6 +244,10 @@ std::unique_ptr<config::Config> ConfigHandler::GetConfig() {
   return GetConfigHandlerImpl()->GetConfig();
 }
 
+uint64_t ConfigHandler::GetGeneration() {
+  return GetConfigHandlerImpl()->GetGeneration();
+}
+
 void ConfigHandler::SetConfig(const Config &config) {
   GetConfigHandlerImpl()->SetConfig(config);
 }
@@ -32,6 +32,7 @@
 #ifndef MOZC_CONFIG_CONFIG_HANDLER_H_
 #define MOZC_CONFIG_CONFIG_HANDLER_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -61,6 +62,11 @@ class ConfigHandler {
   static std::unique_ptr<config::Config> GetConfig();
 
   // Sets config.
+  // Returns a counter incremented whenever a new config is installed.
+  // Callers that only need to know "did the config change since I last
+  // looked" can poll this instead of copying and diffing Config protos.
+  static uint64_t GetGeneration();
+
   static void SetConfig(const Config &config);
 
   // Gets default config value.
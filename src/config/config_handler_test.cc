@@ -31,6 +31,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -69,6 +70,19 @@ class ConfigHandlerTest : public testing::TestWithTempUserProfile {
   std::string default_config_filename_;
 };
 
+TEST_F(ConfigHandlerTest, GenerationCounter) {
+  const uint64_t initial = ConfigHandler::GetGeneration();
+  Config config = ConfigHandler::DefaultConfig();
+  config.set_incognito_mode(true);
+  ConfigHandler::SetConfig(config);
+  EXPECT_GT(ConfigHandler::GetGeneration(), initial);
+
+  const uint64_t after_set = ConfigHandler::GetGeneration();
+  config.set_incognito_mode(false);
+  ConfigHandler::SetConfig(config);
+  EXPECT_GT(ConfigHandler::GetGeneration(), after_set);
+}
+
 TEST_F(ConfigHandlerTest, SetConfig) {
   Config input;
   Config output;
@@ -39,6 +39,7 @@
 #include <string>
 #include <utility>
 
+#include "absl/container/fixed_array.h"
 #include "absl/log/check.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
@@ -253,6 +254,44 @@ bool IsNoisyNumberCandidate(const dictionary::PosMatcher &pos_matcher,
   return false;
 }
 
+// Feature bits over a candidate's node sequence, computed in one pass. The
+// expensive per-candidate checks in FilterCandidateInternal are gated on
+// these bits, so a plain candidate with none of the features runs no node
+// re-scans and no suppression dictionary probes.
+enum CandidateFeatures : uint32_t {
+  CONTAINS_NUMBER_POS = 1 << 0,
+  CONTAINS_ISOLATED_WORD_OR_SYMBOL = 1 << 1,
+  SUPPRESSION_POSSIBLE = 1 << 2,
+};
+
+uint32_t ComputeCandidateFeatures(
+    const dictionary::PosMatcher &pos_matcher,
+    const SuppressionDictionary &suppression_dictionary,
+    const absl::Span<const Node *const> nodes) {
+  // Gather the candidate's POS ids once so that the batched matchers can
+  // classify the whole candidate against each rule in a single walk of the
+  // rule's range table.
+  absl::FixedArray<uint16_t, 16> lids(nodes.size());
+  absl::FixedArray<uint16_t, 16> rids(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    lids[i] = nodes[i]->lid;
+    rids[i] = nodes[i]->rid;
+  }
+
+  uint32_t features = 0;
+  if (pos_matcher.IsAnyNumber(lids) || pos_matcher.IsAnyKanjiNumber(rids)) {
+    features |= CONTAINS_NUMBER_POS;
+  }
+  if (pos_matcher.IsAnyIsolatedWord(lids) ||
+      pos_matcher.IsAnyGeneralSymbol(lids)) {
+    features |= CONTAINS_ISOLATED_WORD_OR_SYMBOL;
+  }
+  if (!suppression_dictionary.IsEmpty()) {
+    features |= SUPPRESSION_POSSIBLE;
+  }
+  return features;
+}
+
 }  // namespace
 
 CandidateFilter::CandidateFilter(
@@ -352,8 +391,12 @@ CandidateFilter::ResultType CandidateFilter::FilterCandidateInternal(
     return CandidateFilter::GOOD_CANDIDATE;
   }
 
-  if (request_util::ShouldFilterNoisyNumberCandidate(request)) {
-    if (IsNoisyNumberCandidate(*pos_matcher_, nodes)) {
+  const uint32_t features =
+      ComputeCandidateFeatures(*pos_matcher_, *suppression_dictionary_, nodes);
+
+  if (features & CONTAINS_NUMBER_POS) {
+    if (request_util::ShouldFilterNoisyNumberCandidate(request) &&
+        IsNoisyNumberCandidate(*pos_matcher_, nodes)) {
       return CandidateFilter::BAD_CANDIDATE;
     }
   }
@@ -367,14 +410,14 @@ CandidateFilter::ResultType CandidateFilter::FilterCandidateInternal(
 
   // "短縮よみ" or "記号,一般" must have only 1 node.  Note that "顔文字" POS
   // from user dictionary is converted to "記号,一般" in Mozc engine.
-  if (nodes.size() > 1 &&
-      ContainsIsolatedWordOrGeneralSymbol(*pos_matcher_, nodes)) {
+  if ((features & CONTAINS_ISOLATED_WORD_OR_SYMBOL) && nodes.size() > 1) {
     MOZC_CANDIDATE_LOG(candidate, "ContainsIsolatedWordOrGeneralSymbol");
     return CandidateFilter::BAD_CANDIDATE;
   }
   // This case tests the case where the isolated word or general symbol is in
   // content word.
-  if (IsIsolatedWordOrGeneralSymbol(*pos_matcher_, nodes[0]->lid) &&
+  if ((features & CONTAINS_ISOLATED_WORD_OR_SYMBOL) &&
+      IsIsolatedWordOrGeneralSymbol(*pos_matcher_, nodes[0]->lid) &&
       (IsNormalOrConstrainedNode(nodes[0]->prev) ||
        IsNormalOrConstrainedNode(nodes[0]->next))) {
     MOZC_CANDIDATE_LOG(candidate, "IsIsolatedWordOrGeneralSymbol");
@@ -382,12 +425,13 @@ CandidateFilter::ResultType CandidateFilter::FilterCandidateInternal(
   }
 
   // Remove "抑制単語" just in case.
-  if (suppression_dictionary_->SuppressEntry(candidate->key,
-                                             candidate->value) ||
-      (candidate->key != candidate->content_key &&
-       candidate->value != candidate->content_value &&
-       suppression_dictionary_->SuppressEntry(candidate->content_key,
-                                              candidate->content_value))) {
+  if ((features & SUPPRESSION_POSSIBLE) &&
+      (suppression_dictionary_->SuppressEntry(candidate->key,
+                                              candidate->value) ||
+       (candidate->key != candidate->content_key &&
+        candidate->value != candidate->content_value &&
+        suppression_dictionary_->SuppressEntry(candidate->content_key,
+                                               candidate->content_value)))) {
     MOZC_CANDIDATE_LOG(candidate, "SuppressEntry");
     return CandidateFilter::BAD_CANDIDATE;
   }
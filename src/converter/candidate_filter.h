@@ -74,6 +74,17 @@ struct CandidateId {
   uint16_t rid;
 };
 
+// Non-owning probe for hash set lookups without constructing a CandidateId.
+struct CandidateIdView {
+  absl::string_view value;
+  uint16_t lid;
+  uint16_t rid;
+
+  friend bool operator==(const CandidateId &lhs, const CandidateIdView &rhs) {
+    return lhs.lid == rhs.lid && lhs.rid == rhs.rid && lhs.value == rhs.value;
+  }
+};
+
 struct CandidateHasher {
   using is_transparent = void;
 
@@ -81,6 +92,9 @@ struct CandidateHasher {
   size_t operator()(const Segment::Candidate &c) const {
     return absl::HashOf(c.value, c.lid, c.rid);
   }
+  size_t operator()(const CandidateIdView &c) const {
+    return absl::HashOf(c.value, c.lid, c.rid);
+  }
 };
 
 }  // namespace candidate_filter_internal
@@ -113,6 +127,14 @@ class CandidateFilter {
   // Resets the internal state.
   void Reset();
 
+  // Returns true if a candidate with this (value, lid, rid) has already been
+  // accepted in this generation.  Used by NBestGenerator to cut duplicate
+  // paths before building a full candidate.
+  bool WasSeen(absl::string_view value, uint16_t lid, uint16_t rid) const {
+    return seen_.contains(
+        candidate_filter_internal::CandidateIdView{value, lid, rid});
+  }
+
  private:
   ResultType CheckRequestType(const ConversionRequest &request,
                               absl::string_view original_key,
@@ -29,16 +29,18 @@
 
 #include "converter/connector.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <limits>
+#include <memory>
 #include <new>
 #include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
-#include "absl/algorithm/container.h"
 #include "absl/base/attributes.h"
 #include "absl/base/const_init.h"
 #include "absl/status/status.h"
@@ -46,7 +48,11 @@
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "base/file_util.h"
+#include "base/hash.h"
 #include "base/logging.h"
+#include "base/mmap.h"
 #include "data_manager/data_manager_interface.h"
 #include "storage/louds/simple_succinct_bit_vector_index.h"
 
@@ -71,6 +77,115 @@ inline uint32_t EncodeKey(uint16_t rid, uint16_t lid) {
   return (static_cast<uint32_t>(rid) << 16) | lid;
 }
 
+// A process-wide transition cost cache shared by all Connector instances for
+// which the shared cache mode is enabled. In server deployments many sessions
+// convert against the same connection data, so sharing one warm cache avoids
+// re-warming the same hot (rid, lid) pairs per engine.
+//
+// Each slot is a single 64-bit atomic packing (EncodeKey(rid, lid) << 32) |
+// cost, so lookups and insertions are lock-free single loads/stores. Races
+// between concurrent inserts are benign: both writers store the same packed
+// value for the same key, and a lost slot merely costs one extra LookupCost
+// call later. Like the per-instance cache, a slot whose key part is
+// kInvalidCacheKey is empty; EncodeKey never produces it for valid id pairs.
+class SharedCostCache final {
+ public:
+  explicit SharedCostCache(size_t num_slots)
+      : hash_mask_(static_cast<uint32_t>(num_slots - 1)),
+        slots_(new std::atomic<uint64_t>[num_slots]),
+        num_slots_(num_slots) {
+    Clear();
+  }
+
+  SharedCostCache(const SharedCostCache &) = delete;
+  SharedCostCache &operator=(const SharedCostCache &) = delete;
+
+  bool Lookup(uint16_t rid, uint16_t lid, int *value) const {
+    const uint64_t slot = slots_[GetHashValue(rid, lid, hash_mask_)].load(
+        std::memory_order_relaxed);
+    if (static_cast<uint32_t>(slot >> 32) != EncodeKey(rid, lid)) {
+      return false;
+    }
+    *value = static_cast<int32_t>(static_cast<uint32_t>(slot));
+    return true;
+  }
+
+  void Insert(uint16_t rid, uint16_t lid, int value) {
+    const uint64_t slot = (static_cast<uint64_t>(EncodeKey(rid, lid)) << 32) |
+                          static_cast<uint32_t>(value);
+    slots_[GetHashValue(rid, lid, hash_mask_)].store(slot,
+                                                     std::memory_order_relaxed);
+  }
+
+  void Clear() {
+    constexpr uint64_t kEmptySlot = static_cast<uint64_t>(kInvalidCacheKey)
+                                    << 32;
+    for (size_t i = 0; i < num_slots_; ++i) {
+      slots_[i].store(kEmptySlot, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  const uint32_t hash_mask_;
+  std::unique_ptr<std::atomic<uint64_t>[]> slots_;
+  const size_t num_slots_;
+};
+
+// Set once by Connector::EnableSharedCache before engines are created and
+// never deallocated afterwards, so readers need no synchronization.
+SharedCostCache *g_shared_cost_cache = nullptr;
+
+// Set once by Connector::EnableIndexCache before engines are created and
+// never deallocated afterwards, so readers need no synchronization.
+const std::string *g_index_cache_directory = nullptr;
+
+// The format version is part of the file name so that an upgraded binary
+// never reads a stale layout and old files are simply left behind.
+constexpr char kIndexCacheFileName[] = "connector_index_v1.cache";
+
+// Header of the on-disk index cache file, followed by the rank index arrays
+// of every row (chunk bits then compact bits, in row order) as raw int32.
+// The fingerprint ties the cache to the exact connection data image it was
+// built from; any mismatch discards the cache and rebuilds it.
+struct IndexCacheHeader {
+  static constexpr uint32_t kMagic = 0x58444943;  // "CIDX"
+
+  uint32_t magic = 0;
+  uint32_t num_index_ints = 0;
+  uint64_t connection_fingerprint = 0;
+  uint64_t connection_size = 0;
+};
+static_assert(sizeof(IndexCacheHeader) == 24 &&
+                  sizeof(IndexCacheHeader) % alignof(int) == 0,
+              "Unexpected index cache header layout");
+
+// Maps the index cache file and validates it against the current connection
+// data. On success the returned Mmap holds exactly the expected rank index
+// payload right after the header.
+absl::StatusOr<Mmap> LoadIndexCache(const std::string &path,
+                                    uint64_t connection_fingerprint,
+                                    size_t connection_size,
+                                    size_t num_index_ints) {
+  absl::StatusOr<Mmap> mmap = Mmap::Map(path);
+  if (!mmap.ok()) {
+    return mmap;
+  }
+  if (mmap->size() != sizeof(IndexCacheHeader) + num_index_ints * sizeof(int)) {
+    return absl::FailedPreconditionError(absl::StrCat(
+        "connector.cc: Index cache size mismatch: ", mmap->size()));
+  }
+  IndexCacheHeader header;
+  std::memcpy(&header, mmap->begin(), sizeof(header));
+  if (header.magic != IndexCacheHeader::kMagic ||
+      header.num_index_ints != num_index_ints ||
+      header.connection_fingerprint != connection_fingerprint ||
+      header.connection_size != connection_size) {
+    return absl::FailedPreconditionError(
+        "connector.cc: Index cache was built from different connection data");
+  }
+  return mmap;
+}
+
 absl::Status IsMemoryAligned32(const void *ptr) {
   const auto addr = reinterpret_cast<std::uintptr_t>(ptr);
   const auto alignment = addr % 4;
@@ -149,6 +264,20 @@ void Connector::Row::Init(const uint8_t *chunk_bits, size_t chunk_bits_size,
   use_1byte_value_ = use_1byte_value;
 }
 
+void Connector::Row::InitWithPrecomputedIndexes(
+    const uint8_t *chunk_bits, size_t chunk_bits_size,
+    const uint8_t *compact_bits, size_t compact_bits_size,
+    const uint8_t *values, bool use_1byte_value,
+    absl::Span<const int> chunk_rank_index,
+    absl::Span<const int> compact_rank_index) {
+  chunk_bits_index_.InitFromPrecomputedIndex(chunk_bits, chunk_bits_size,
+                                             chunk_rank_index);
+  compact_bits_index_.InitFromPrecomputedIndex(compact_bits, compact_bits_size,
+                                               compact_rank_index);
+  values_ = values;
+  use_1byte_value_ = use_1byte_value;
+}
+
 std::optional<uint16_t> Connector::Row::GetValue(uint16_t index) const {
   int chunk_bit_position = index / 8;
   if (!chunk_bits_index_.Get(chunk_bit_position)) {
@@ -205,9 +334,17 @@ absl::Status Connector::Init(const char *connection_data,
     return absl::InvalidArgumentError(absl::StrCat(
         "connector.cc: Cache size must be 2^n: size=", cache_size));
   }
-  cache_hash_mask_ = cache_size - 1;
-  cache_key_.resize(cache_size);
-  cache_value_.resize(cache_size);
+  // When the process-wide shared cache is enabled, this instance uses it and
+  // the per-instance cache arrays are left unallocated.
+  use_shared_cache_ = IsSharedCacheEnabled();
+  if (!use_shared_cache_) {
+    cache_hash_mask_ = cache_size - 1;
+    cache_slots_ = std::vector<std::atomic<uint64_t>>(cache_size);
+    constexpr uint64_t kEmptySlot = uint64_t{kInvalidCacheKey} << 32;
+    for (std::atomic<uint64_t> &slot : cache_slots_) {
+      slot.store(kEmptySlot, std::memory_order_relaxed);
+    }
+  }
 
   absl::StatusOr<Metadata> metadata =
       ParseMetadata(connection_data, connection_size);
@@ -215,6 +352,7 @@ absl::Status Connector::Init(const char *connection_data,
     return std::move(metadata).status();
   }
   resolution_ = metadata->resolution;
+  lsize_ = metadata->lsize;
 
   // Set the read location to the metadata end.
   auto *ptr = connection_data + Metadata::kByteSize;
@@ -265,7 +403,17 @@ absl::Status Connector::Init(const char *connection_data,
 
   const size_t chunk_bits_size = metadata->ChunkBitsSize();
   const uint16_t rsize = metadata->rsize;
-  rows_.resize(rsize);
+
+  // First pass: walk and validate the per-row sections without deriving the
+  // rank indexes, so that the total index size is known before deciding
+  // whether the on-disk index cache can be used.
+  struct RowData {
+    const uint8_t *chunk_bits;
+    const uint8_t *compact_bits;
+    const uint8_t *values;
+    uint16_t compact_bits_size;
+  };
+  std::vector<RowData> row_data(rsize);
   for (size_t i = 0; i < rsize; ++i) {
     // Each row is formatted as follows:
     // +-------------------+-------------+------------+------------+-----------+
@@ -299,10 +447,67 @@ absl::Status Connector::Init(const char *connection_data,
     VALIDATE_ALIGNMENT(values);
     ptr += values_size;
 
-    rows_[i].Init(chunk_bits, chunk_bits_size, compact_bits, compact_bits_size,
-                  values, metadata->Use1ByteValue());
+    row_data[i] = {chunk_bits, compact_bits, values, compact_bits_size};
   }
   VALIDATE_SIZE(ptr, 0, "Data end");
+
+  // The number of int32 rank index entries that Row::Init derives for this
+  // data: one cumulative popcount per 32-bit chunk plus a sentinel, for the
+  // chunk bits and the compact bits of every row. Both bit arrays are
+  // 32-bit aligned (validated above), so the division is exact.
+  const size_t chunk_index_ints = chunk_bits_size / 4 + 1;
+  size_t num_index_ints = 0;
+  for (const RowData &row : row_data) {
+    num_index_ints += chunk_index_ints + row.compact_bits_size / 4 + 1;
+  }
+
+  // When the on-disk index cache is enabled and matches the current data,
+  // point the rows at the prebuilt indexes instead of recomputing them.
+  std::string index_cache_path;
+  uint64_t connection_fingerprint = 0;
+  const int *cached_index = nullptr;
+  if (g_index_cache_directory != nullptr) {
+    connection_fingerprint =
+        Fingerprint(absl::string_view(connection_data, connection_size));
+    index_cache_path =
+        FileUtil::JoinPath(*g_index_cache_directory, kIndexCacheFileName);
+    absl::StatusOr<Mmap> cache =
+        LoadIndexCache(index_cache_path, connection_fingerprint,
+                       connection_size, num_index_ints);
+    if (cache.ok()) {
+      index_cache_mmap_ = *std::move(cache);
+      // The payload is 32-bit aligned: the mapping is page aligned and the
+      // header size is a multiple of alignof(int).
+      cached_index = reinterpret_cast<const int *>(index_cache_mmap_.begin() +
+                                                   sizeof(IndexCacheHeader));
+    } else {
+      LOG(INFO) << "Rebuilding connector index cache: " << cache.status();
+    }
+  }
+
+  rows_.resize(rsize);
+  for (size_t i = 0; i < rsize; ++i) {
+    const RowData &row = row_data[i];
+    if (cached_index != nullptr) {
+      const size_t compact_index_ints = row.compact_bits_size / 4 + 1;
+      rows_[i].InitWithPrecomputedIndexes(
+          row.chunk_bits, chunk_bits_size, row.compact_bits,
+          row.compact_bits_size, row.values, metadata->Use1ByteValue(),
+          absl::MakeSpan(cached_index, chunk_index_ints),
+          absl::MakeSpan(cached_index + chunk_index_ints, compact_index_ints));
+      cached_index += chunk_index_ints + compact_index_ints;
+    } else {
+      rows_[i].Init(row.chunk_bits, chunk_bits_size, row.compact_bits,
+                    row.compact_bits_size, row.values,
+                    metadata->Use1ByteValue());
+    }
+  }
+
+  if (g_index_cache_directory != nullptr && cached_index == nullptr) {
+    WriteIndexCache(index_cache_path, connection_fingerprint, connection_size,
+                    num_index_ints, rows_);
+  }
+
   ClearCache();
   return absl::Status();
 
@@ -311,19 +516,115 @@ absl::Status Connector::Init(const char *connection_data,
 }
 
 
+absl::Status Connector::EnableSharedCache(size_t num_slots) {
+  if (num_slots == 0 || (num_slots & (num_slots - 1)) != 0) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "connector.cc: Shared cache size must be 2^n: size=", num_slots));
+  }
+  if (g_shared_cost_cache == nullptr) {
+    g_shared_cost_cache = new SharedCostCache(num_slots);
+  }
+  return absl::Status();
+}
+
+bool Connector::IsSharedCacheEnabled() {
+  return g_shared_cost_cache != nullptr;
+}
+
+void Connector::EnableIndexCache(std::string directory) {
+  if (g_index_cache_directory == nullptr) {
+    g_index_cache_directory = new std::string(std::move(directory));
+  }
+}
+
+void Connector::WriteIndexCache(const std::string &path,
+                                uint64_t connection_fingerprint,
+                                size_t connection_size, size_t num_index_ints,
+                                const std::vector<Row> &rows) {
+  IndexCacheHeader header;
+  header.magic = IndexCacheHeader::kMagic;
+  header.num_index_ints = static_cast<uint32_t>(num_index_ints);
+  header.connection_fingerprint = connection_fingerprint;
+  header.connection_size = connection_size;
+
+  std::string image;
+  image.reserve(sizeof(header) + num_index_ints * sizeof(int));
+  image.append(reinterpret_cast<const char *>(&header), sizeof(header));
+  for (const Row &row : rows) {
+    const absl::Span<const int> chunk_index = row.ChunkRankIndex();
+    image.append(reinterpret_cast<const char *>(chunk_index.data()),
+                 chunk_index.size() * sizeof(int));
+    const absl::Span<const int> compact_index = row.CompactRankIndex();
+    image.append(reinterpret_cast<const char *>(compact_index.data()),
+                 compact_index.size() * sizeof(int));
+  }
+
+  const std::string tmp_path = absl::StrCat(path, ".tmp");
+  if (absl::Status s = FileUtil::SetContents(tmp_path, image); !s.ok()) {
+    LOG(WARNING) << "Cannot write connector index cache: " << s;
+    return;
+  }
+  if (absl::Status s = FileUtil::AtomicRename(tmp_path, path); !s.ok()) {
+    LOG(WARNING) << "Cannot commit connector index cache: " << s;
+    FileUtil::UnlinkOrLogError(tmp_path);
+  }
+}
+
 int Connector::GetTransitionCost(uint16_t rid, uint16_t lid) const {
+  if (use_shared_cache_) {
+    int value;
+    if (g_shared_cost_cache->Lookup(rid, lid, &value)) {
+      return value;
+    }
+    value = LookupCost(rid, lid);
+    g_shared_cost_cache->Insert(rid, lid, value);
+    return value;
+  }
   const uint32_t index = EncodeKey(rid, lid);
   const uint32_t bucket = GetHashValue(rid, lid, cache_hash_mask_);
-  if (cache_key_[bucket] == index) {
-    return cache_value_[bucket];
+  const uint64_t slot = cache_slots_[bucket].load(std::memory_order_relaxed);
+  if (static_cast<uint32_t>(slot >> 32) == index) {
+    return static_cast<int32_t>(static_cast<uint32_t>(slot));
   }
   const int value = LookupCost(rid, lid);
-  cache_key_[bucket] = index;
-  cache_value_[bucket] = value;
+  cache_slots_[bucket].store(
+      (uint64_t{index} << 32) | static_cast<uint32_t>(value),
+      std::memory_order_relaxed);
   return value;
 }
 
-void Connector::ClearCache() { absl::c_fill(cache_key_, kInvalidCacheKey); }
+std::shared_ptr<const Connector::TransitionRow> Connector::GetTransitionRow(
+    uint16_t rid) const {
+  const size_t slot = rid == 0 ? 0 : 1 + rid % (kNumTransitionRows - 1);
+  std::shared_ptr<const TransitionRow> row =
+      std::atomic_load(&transition_rows_[slot]);
+  if (row != nullptr && row->rid == rid) {
+    return row;
+  }
+  auto new_row = std::make_shared<TransitionRow>();
+  new_row->rid = rid;
+  new_row->costs.resize(lsize_);
+  for (size_t lid = 0; lid < lsize_; ++lid) {
+    new_row->costs[lid] = LookupCost(rid, static_cast<uint16_t>(lid));
+  }
+  std::shared_ptr<const TransitionRow> result(std::move(new_row));
+  std::atomic_store(&transition_rows_[slot], result);
+  return result;
+}
+
+void Connector::ClearCache() {
+  for (auto &row : transition_rows_) {
+    std::atomic_store(&row, std::shared_ptr<const TransitionRow>());
+  }
+  if (use_shared_cache_) {
+    g_shared_cost_cache->Clear();
+    return;
+  }
+  constexpr uint64_t kEmptySlot = uint64_t{kInvalidCacheKey} << 32;
+  for (std::atomic<uint64_t> &slot : cache_slots_) {
+    slot.store(kEmptySlot, std::memory_order_relaxed);
+  }
+}
 
 int Connector::LookupCost(uint16_t rid, uint16_t lid) const {
   std::optional<uint16_t> value = rows_[rid].GetValue(lid);
@@ -30,13 +30,19 @@
 #ifndef MOZC_CONVERTER_CONNECTOR_H_
 #define MOZC_CONVERTER_CONNECTOR_H_
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "base/mmap.h"
 #include "data_manager/data_manager_interface.h"
 #include "storage/louds/simple_succinct_bit_vector_index.h"
 
@@ -53,9 +59,40 @@ class Connector final {
                                           size_t connection_size,
                                           int cache_size);
 
+  // Enables a process-wide transition cost cache shared by all Connector
+  // instances created afterwards, instead of per-instance caches. Useful for
+  // server deployments where many sessions convert against the same data.
+  // |num_slots| must be a power of 2. Must be called before the engines are
+  // created; the first successful call wins and later calls are no-ops.
+  static absl::Status EnableSharedCache(size_t num_slots);
+
+  // Returns true if EnableSharedCache has been called successfully.
+  static bool IsSharedCacheEnabled();
+
+  // Enables a per-machine on-disk cache of the rank indexes derived from the
+  // connection data, stored in a versioned file under |directory|. When the
+  // cache matches the current data (fingerprint test), startups mmap the
+  // prebuilt indexes instead of recomputing them from the matrix; otherwise
+  // the indexes are rebuilt and the cache is rewritten. Must be called before
+  // the engines are created; the first call wins and later calls are no-ops.
+  static void EnableIndexCache(std::string directory);
+
   int GetTransitionCost(uint16_t rid, uint16_t lid) const;
   int GetResolution() const { return resolution_; }
 
+  // Dense costs of the transitions from one right id to every left id.
+  struct TransitionRow {
+    uint16_t rid = 0;
+    std::vector<int> costs;  // indexed by lid
+  };
+
+  // Returns the dense transition row of |rid|, decoding it on first use and
+  // memoizing a handful of recent rows. Scoring loops that probe one context
+  // right id against many candidate left ids (prediction after a commit)
+  // index the returned row directly, skipping the per-pair cache and matrix
+  // decoding entirely.
+  std::shared_ptr<const TransitionRow> GetTransitionRow(uint16_t rid) const;
+
   void ClearCache();
 
  private:
@@ -64,14 +101,38 @@ class Connector final {
   absl::Status Init(const char *connection_data, size_t connection_size,
                     int cache_size);
 
+  // Writes the on-disk index cache for |rows| atomically (temporary file +
+  // rename) so that a concurrent or interrupted startup never observes a
+  // partial file. Failures are logged and ignored; the cache is purely an
+  // optimization.
+  static void WriteIndexCache(const std::string &path,
+                              uint64_t connection_fingerprint,
+                              size_t connection_size, size_t num_index_ints,
+                              const std::vector<Row> &rows);
+
   int LookupCost(uint16_t rid, uint16_t lid) const;
 
   std::vector<Row> rows_;
+  // Keeps the on-disk index cache mapped while rows_ point into it.
+  Mmap index_cache_mmap_;
   const uint16_t *default_cost_ = nullptr;
   int resolution_ = 0;
   uint32_t cache_hash_mask_ = 0;
-  mutable std::vector<uint32_t> cache_key_;
-  mutable std::vector<int> cache_value_;
+  uint16_t lsize_ = 0;
+  bool use_shared_cache_ = false;
+  // Per-instance transition cost cache.  Each slot packs (key << 32 |
+  // value) into one atomic, mirroring the shared cache above, so concurrent
+  // readers — e.g. the overlapped realtime aggregation racing the actual
+  // converter's top-result conversion — can never observe a torn key/value
+  // pair; a lost store merely costs one extra LookupCost.
+  mutable std::vector<std::atomic<uint64_t>> cache_slots_;
+
+  // Memoized dense rows. Slot 0 is dedicated to rid 0 (BOS), which is probed
+  // together with every other context row; the rest are direct-mapped.
+  // Accessed only through std::atomic_load/std::atomic_store.
+  static constexpr size_t kNumTransitionRows = 8;
+  mutable std::array<std::shared_ptr<const TransitionRow>, kNumTransitionRows>
+      transition_rows_;
 };
 
 class Connector::Row final {
@@ -83,6 +144,23 @@ class Connector::Row final {
   void Init(const uint8_t *chunk_bits, size_t chunk_bits_size,
             const uint8_t *compact_bits, size_t compact_bits_size,
             const uint8_t *values, bool use_1byte_value);
+  // Same as Init but reuses rank indexes prebuilt by a previous run (e.g.
+  // loaded from the on-disk index cache) instead of deriving them from the
+  // bit arrays. The spans are not copied and must outlive this row.
+  void InitWithPrecomputedIndexes(const uint8_t *chunk_bits,
+                                  size_t chunk_bits_size,
+                                  const uint8_t *compact_bits,
+                                  size_t compact_bits_size,
+                                  const uint8_t *values, bool use_1byte_value,
+                                  absl::Span<const int> chunk_rank_index,
+                                  absl::Span<const int> compact_rank_index);
+  // The rank indexes derived by Init, for persisting to the index cache.
+  absl::Span<const int> ChunkRankIndex() const {
+    return chunk_bits_index_.RankIndex();
+  }
+  absl::Span<const int> CompactRankIndex() const {
+    return compact_bits_index_.RankIndex();
+  }
   // Returns the value in the row if found.
   std::optional<uint16_t> GetValue(uint16_t index) const;
 
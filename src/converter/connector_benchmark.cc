@@ -0,0 +1,91 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Microbenchmark of Connector::GetTransitionCost over the testing
+// connection matrix, covering both the per-instance cache hit path and the
+// cold LookupCost path.
+//
+// Run: bazel run -c opt //converter:connector_benchmark
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "absl/status/statusor.h"
+#include "base/logging.h"
+#include "base/mmap.h"
+#include "benchmark/benchmark.h"
+#include "converter/connector.h"
+#include "testing/mozctest.h"
+
+namespace mozc {
+namespace {
+
+Connector CreateConnector() {
+  static const Mmap *mmap = [] {
+    const std::string path = testing::GetSourceFileOrDie(
+        {MOZC_SRC_COMPONENTS("data_manager"), "testing", "connection.data"});
+    absl::StatusOr<Mmap> mmap = Mmap::Map(path);
+    CHECK_OK(mmap);
+    return new Mmap(*std::move(mmap));
+  }();
+  absl::StatusOr<Connector> connector =
+      Connector::Create(mmap->begin(), mmap->size(), 1024);
+  CHECK_OK(connector);
+  return *std::move(connector);
+}
+
+void BM_GetTransitionCost(benchmark::State &state) {
+  Connector connector = CreateConnector();
+  // A bounded pseudo-random id walk; ids stay well within the matrix.
+  uint32_t x = 123456789;
+  for (auto _ : state) {
+    x = x * 1103515245 + 12345;
+    const uint16_t rid = (x >> 16) % 100;
+    const uint16_t lid = (x >> 8) % 100;
+    benchmark::DoNotOptimize(connector.GetTransitionCost(rid, lid));
+  }
+}
+BENCHMARK(BM_GetTransitionCost);
+
+void BM_GetTransitionCostColdCache(benchmark::State &state) {
+  Connector connector = CreateConnector();
+  uint32_t x = 987654321;
+  for (auto _ : state) {
+    x = x * 1103515245 + 12345;
+    const uint16_t rid = (x >> 16) % 100;
+    const uint16_t lid = (x >> 8) % 100;
+    connector.ClearCache();
+    benchmark::DoNotOptimize(connector.GetTransitionCost(rid, lid));
+  }
+}
+BENCHMARK(BM_GetTransitionCostColdCache);
+
+}  // namespace
+}  // namespace mozc
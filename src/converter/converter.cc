@@ -42,7 +42,10 @@
 #include "absl/log/log.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
+#include "base/clock.h"
+#include "base/hash.h"
 #include "base/japanese_util.h"
+#include "base/perf_histogram.h"
 #include "base/strings/assign.h"
 #include "base/util.h"
 #include "base/vlog.h"
@@ -313,6 +316,26 @@ bool Converter::StartConversionWithKey(Segments *segments,
 
 bool Converter::Convert(const ConversionRequest &request,
                         const absl::string_view key, Segments *segments) const {
+  // Users frequently re-convert the same key in the same context (retypes
+  // after an escape, repeated terms); serve such conversions from the cache
+  // when nothing the result depends on has changed.
+  const uint64_t fingerprint =
+      ConversionCacheFingerprint(request, key, *segments);
+  if (fingerprint != 0) {
+    if (const Segments *cached = conversion_cache_.MutableLookup(fingerprint);
+        cached != nullptr) {
+      ++conversion_cache_hits_;
+      // Mirror what SetKey does on the non-cached path.
+      segments->set_max_history_segments_size(4);
+      segments->clear_conversion_segments();
+      for (const Segment &segment : cached->conversion_segments()) {
+        *segments->add_segment() = segment;
+      }
+      return true;
+    }
+    ++conversion_cache_misses_;
+  }
+
   SetKey(segments, key);
   if (!immutable_converter_->ConvertForRequest(request, segments)) {
     // Conversion can fail for keys like "12". Even in such cases, rewriters
@@ -323,9 +346,57 @@ bool Converter::Convert(const ConversionRequest &request,
   }
   RewriteAndSuppressCandidates(request, segments);
   TrimCandidates(request, segments);
-  return IsValidSegments(request, *segments);
+  const bool is_valid = IsValidSegments(request, *segments);
+  if (fingerprint != 0 && is_valid) {
+    conversion_cache_.Insert(fingerprint, *segments);
+  }
+  return is_valid;
 }
 
+uint64_t Converter::ConversionCacheFingerprint(
+    const ConversionRequest &request, const absl::string_view key,
+    const Segments &segments) const {
+  if (request.request_type() != ConversionRequest::CONVERSION) {
+    return 0;
+  }
+  std::string buf;
+  // Note: SetKey clears the conversion segments and the resized flag before
+  // converting, and the cache-hit path does the same, so neither needs to be
+  // part of the fingerprint.
+  absl::StrAppend(&buf, key, "\x1e");
+  for (const Segment &segment : segments.history_segments()) {
+    if (segment.candidates_size() == 0) {
+      return 0;
+    }
+    const Segment::Candidate &candidate = segment.candidate(0);
+    absl::StrAppend(&buf, segment.key(), "\x1f", candidate.value, "\x1f",
+                    candidate.rid, "\x1e");
+  }
+  // Request signature: everything outside the key that shapes the result.
+  absl::StrAppend(&buf, "\x1e", request.max_conversion_candidates_size(),
+                  "\x1f", request.skip_slow_rewriters(), "\x1f",
+                  request.enable_user_history_for_conversion(), "\x1f");
+  if (const uint64_t signature = request.request_config_signature();
+      signature != 0) {
+    // The session precompiled the request+config fingerprint; serializing
+    // the protos per conversion is the expensive part of this key.
+    absl::StrAppend(&buf, "S", signature);
+  } else {
+    buf.append(request.request().SerializeAsString());
+    buf.append("\x1e");
+    buf.append(request.config().SerializeAsString());
+  }
+  // Date/time rewriters embed the current time into candidates; bucket the
+  // fingerprint by minute, their output precision, to bound staleness.
+  absl::StrAppend(&buf, "\x1e",
+                  absl::ToUnixSeconds(Clock::GetAbslTime()) / 60);
+  const uint64_t fingerprint = Fingerprint(buf);
+  // 0 is the "not cacheable" sentinel; remap the (unlikely) collision.
+  return fingerprint == 0 ? 1 : fingerprint;
+}
+
+void Converter::ClearConversionCache() const { conversion_cache_.Clear(); }
+
 bool Converter::StartReverseConversion(Segments *segments,
                                        const absl::string_view key) const {
   segments->Clear();
@@ -512,6 +583,10 @@ bool Converter::StartPartialPrediction(
 
 void Converter::FinishConversion(const ConversionRequest &request,
                                  Segments *segments) const {
+  // The learning below changes ranking inputs; conversions cached before it
+  // are stale.
+  ClearConversionCache();
+
   CommitUsageStats(segments, segments->history_segments_size(),
                    segments->conversion_segments_size());
 
@@ -554,6 +629,8 @@ void Converter::CancelConversion(Segments *segments) const {
 void Converter::ResetConversion(Segments *segments) const { segments->Clear(); }
 
 void Converter::RevertConversion(Segments *segments) const {
+  ClearConversionCache();
+
   if (segments->revert_entries_size() == 0) {
     return;
   }
@@ -770,7 +847,11 @@ bool Converter::ResizeSegment(Segments *segments,
 
   segments->set_resized(true);
 
-  if (!immutable_converter_->ConvertForRequest(request, segments)) {
+  // Boundary adjustment does not change the conversion key, so the lattice
+  // from the previous conversion can usually be re-decoded under the new
+  // boundaries; fall back to the full pipeline when it cannot.
+  if (!immutable_converter_->RedecodeWithNewBoundaries(request, segments) &&
+      !immutable_converter_->ConvertForRequest(request, segments)) {
     // Conversion can fail for keys like "12". Even in such cases, rewriters
     // (e.g., number and variant rewriters) can populate some candidates.
     // Therefore, this is not an error.
@@ -836,7 +917,11 @@ bool Converter::ResizeSegment(Segments *segments,
 
   segments->set_resized(true);
 
-  if (!immutable_converter_->ConvertForRequest(request, segments)) {
+  // Boundary adjustment does not change the conversion key, so the lattice
+  // from the previous conversion can usually be re-decoded under the new
+  // boundaries; fall back to the full pipeline when it cannot.
+  if (!immutable_converter_->RedecodeWithNewBoundaries(request, segments) &&
+      !immutable_converter_->ConvertForRequest(request, segments)) {
     // Conversion can fail for keys like "12". Even in such cases, rewriters
     // (e.g., number and variant rewriters) can populate some candidates.
     // Therefore, this is not an error.
@@ -910,7 +995,12 @@ void Converter::CompletePosIds(Segment::Candidate *candidate) const {
 
 void Converter::RewriteAndSuppressCandidates(const ConversionRequest &request,
                                              Segments *segments) const {
-  if (!rewriter_->Rewrite(request, segments)) {
+  bool rewritten = false;
+  {
+    PerfHistogram::ScopedProbe probe(PerfHistogram::REWRITER_CHAIN);
+    rewritten = rewriter_->Rewrite(request, segments);
+  }
+  if (!rewritten) {
     return;
   }
   // Optimization for common use case: Since most of users don't use suppression
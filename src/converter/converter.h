@@ -49,6 +49,7 @@
 #include "prediction/predictor_interface.h"
 #include "request/conversion_request.h"
 #include "rewriter/rewriter_interface.h"
+#include "storage/lru_cache.h"
 #include "testing/friend_test.h"
 
 namespace mozc {
@@ -131,6 +132,20 @@ class Converter final : public ConverterInterface {
       size_t start_segment_index, size_t segments_size,
       absl::Span<const uint8_t> new_size_array) const override;
 
+  // Drops all cached conversion results.  Called when inputs outside this
+  // class's view change, e.g. a user dictionary reload.
+  void ClearConversionCache() const;
+
+  // Cumulative hit statistics of the conversion result cache.
+  struct ConversionCacheStats {
+    uint64_t hits;
+    uint64_t misses;
+  };
+  ConversionCacheStats conversion_cache_stats() const {
+    return ConversionCacheStats{conversion_cache_hits_,
+                                conversion_cache_misses_};
+  }
+
  private:
   FRIEND_TEST(ConverterTest, CompletePosIds);
   FRIEND_TEST(ConverterTest, DefaultPredictor);
@@ -163,6 +178,14 @@ class Converter final : public ConverterInterface {
   void RewriteAndSuppressCandidates(const ConversionRequest &request,
                                     Segments *segments) const;
 
+  // Fingerprint of everything a finished conversion depends on: the key,
+  // the history context of |segments|, the request and config, and a
+  // minute-granularity time bucket (date/time rewriters embed the current
+  // time in candidates).  Returns 0 when the conversion is not cacheable.
+  uint64_t ConversionCacheFingerprint(const ConversionRequest &request,
+                                      absl::string_view key,
+                                      const Segments &segments) const;
+
   // Limits the number of candidates based on a request.
   // This method doesn't drop meta candidates for T13n conversion.
   void TrimCandidates(const ConversionRequest &request,
@@ -193,6 +216,15 @@ class Converter final : public ConverterInterface {
   std::unique_ptr<RewriterInterface> rewriter_;
   const ImmutableConverterInterface *immutable_converter_ = nullptr;
   uint16_t general_noun_id_ = std::numeric_limits<uint16_t>::max();
+
+  // History-aware cache of finished conversions, keyed by
+  // ConversionCacheFingerprint.  Sessions are serialized by the handler, so
+  // the cache needs no locking (mutable like the other converter caches).
+  static constexpr size_t kConversionCacheSize = 16;
+  mutable storage::LruCache<uint64_t, Segments> conversion_cache_{
+      kConversionCacheSize};
+  mutable uint64_t conversion_cache_hits_ = 0;
+  mutable uint64_t conversion_cache_misses_ = 0;
 };
 
 }  // namespace mozc
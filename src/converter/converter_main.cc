@@ -43,13 +43,16 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
+#include "absl/strings/str_replace.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "base/file_stream.h"
 #include "base/file_util.h"
 #include "base/init_mozc.h"
 #include "base/logging.h"
 #include "base/number_util.h"
+#include "base/perf_histogram.h"
 #include "base/protobuf/text_format.h"
 #include "base/singleton.h"
 #include "base/system_util.h"
@@ -67,6 +70,7 @@
 #include "protocol/config.pb.h"
 #include "request/conversion_request.h"
 #include "request/request_test_util.h"
+#include "rewriter/rewriter_profile.h"
 
 #ifndef NDEBUG
 #define MOZC_DEBUG
@@ -93,6 +97,15 @@ ABSL_FLAG(std::string, magic, "", "Expected magic number of data file");
 ABSL_FLAG(std::string, id_def, "",
           "id.def file for POS IDs. If provided, show human readable "
           "POS instead of ID number");
+ABSL_FLAG(int32_t, iterations, 1,
+          "Number of times each command line is executed; use with "
+          "--profile_csv to average out noise when decomposing a slow "
+          "phrase.");
+ABSL_FLAG(std::string, profile_csv, "",
+          "When nonempty, write a per-stage timing breakdown (lattice "
+          "build/dictionary lookup, Viterbi, n-best, rewriter chain, and "
+          "each rewriter by type name) per command line to this CSV file "
+          "(\"-\" for stdout).");
 ABSL_FLAG(std::string, decoder_experiment_params, "",
           "If nonempty, a DecoderExperimentParams is parsed from this text "
           "format and it is merged to the default value.");
@@ -437,6 +450,27 @@ bool IsConsistentEngineNameAndType(const std::string &engine_name,
          kConsistentPairs->end();
 }
 
+// Writes the accumulated stage histograms and per-rewriter totals for
+// |query| as CSV rows. Stage totals are approximated from the histogram
+// buckets by their geometric midpoints; rewriter totals are exact.
+void DumpProfile(const std::string &query, std::ostream *os) {
+  // CSV-quote the query; command lines can contain commas.
+  std::string quoted_query =
+      absl::StrCat("\"", absl::StrReplaceAll(query, {{"\"", "\"\""}}), "\"");
+  for (const PerfHistogram::BucketSample &sample : PerfHistogram::Snapshot()) {
+    // Midpoint of [2^bucket, 2^(bucket+1)) microseconds.
+    const double mid_us = 1.5 * (1LL << sample.bucket);
+    *os << quoted_query << ",stage," << PerfHistogram::StageName(sample.stage)
+        << "," << sample.count << "," << sample.count * mid_us << "\n";
+  }
+  for (const RewriterProfile::Entry &entry : RewriterProfile::Snapshot()) {
+    *os << quoted_query << ",rewriter," << entry.name << "," << entry.calls
+        << "," << absl::ToDoubleMicroseconds(entry.total) << ","
+        << entry.fired << "\n";
+  }
+  os->flush();
+}
+
 }  // namespace
 }  // namespace mozc
 
@@ -524,15 +558,42 @@ int main(int argc, char **argv) {
   conversion_request.set_create_partial_candidates(
       request.auto_partial_suggestion());
 
+  const std::string profile_csv = absl::GetFlag(FLAGS_profile_csv);
+  const int32_t iterations = std::max<int32_t>(absl::GetFlag(FLAGS_iterations), 1);
+  std::unique_ptr<mozc::OutputFileStream> profile_file;
+  std::ostream *profile_stream = nullptr;
+  if (!profile_csv.empty()) {
+    mozc::RewriterProfile::Enable();
+    if (profile_csv == "-") {
+      profile_stream = &std::cout;
+    } else {
+      profile_file = std::make_unique<mozc::OutputFileStream>(profile_csv);
+      CHECK(profile_file->good()) << "Cannot open " << profile_csv;
+      profile_stream = profile_file.get();
+    }
+    *profile_stream << "query,kind,name,count,total_us\n";
+  }
+
   while (!std::getline(std::cin, line).fail()) {
-    if (mozc::ExecCommand(*converter, line, request, &config,
-                          &conversion_request, &segments)) {
+    if (profile_stream != nullptr) {
+      mozc::PerfHistogram::Reset();
+      mozc::RewriterProfile::Reset();
+    }
+    bool ok = true;
+    for (int32_t i = 0; i < iterations; ++i) {
+      ok = mozc::ExecCommand(*converter, line, request, &config,
+                             &conversion_request, &segments);
+    }
+    if (ok) {
       if (absl::GetFlag(FLAGS_output_debug_string)) {
         mozc::PrintSegments(segments, &std::cout);
       }
     } else {
       std::cout << "ExecCommand() return false" << std::endl;
     }
+    if (profile_stream != nullptr) {
+      mozc::DumpProfile(line, profile_stream);
+    }
   }
   return 0;
 }
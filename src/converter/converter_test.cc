@@ -367,6 +367,38 @@ TEST_F(ConverterTest, CanConvertTest) {
   }
 }
 
+TEST_F(ConverterTest, ConversionResultCache) {
+  std::unique_ptr<EngineInterface> engine =
+      MockDataEngineFactory::Create().value();
+  Converter *converter = static_cast<Converter *>(engine->GetConverter());
+  CHECK(converter);
+
+  Segments segments;
+  ASSERT_TRUE(converter->StartConversionWithKey(&segments, "あいうえお"));
+  const std::string first_value = segments.conversion_segment(0).candidate(0).value;
+  const Converter::ConversionCacheStats after_first =
+      converter->conversion_cache_stats();
+  EXPECT_EQ(after_first.hits, 0);
+  EXPECT_EQ(after_first.misses, 1);
+
+  // The identical re-conversion is served from the cache with the same
+  // result.
+  Segments segments2;
+  ASSERT_TRUE(converter->StartConversionWithKey(&segments2, "あいうえお"));
+  EXPECT_EQ(converter->conversion_cache_stats().hits, 1);
+  EXPECT_EQ(segments2.conversion_segment(0).candidate(0).value, first_value);
+
+  // Learning invalidates cached conversions.
+  ConversionRequest request;
+  converter->FinishConversion(request, &segments);
+  Segments segments3;
+  ASSERT_TRUE(converter->StartConversionWithKey(&segments3, "あいうえお"));
+  const Converter::ConversionCacheStats after_finish =
+      converter->conversion_cache_stats();
+  EXPECT_EQ(after_finish.hits, 1);
+  EXPECT_EQ(after_finish.misses, 2);
+}
+
 namespace {
 std::string ContextAwareConvert(const std::string &first_key,
                                 const std::string &first_value,
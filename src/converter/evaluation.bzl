@@ -93,3 +93,41 @@ def evaluation(
         visibility = visibility,
         **kwargs
     )
+
+def dictionary_working_set(
+        name,
+        dictionary_file,
+        query_file,
+        rounds = 1,
+        visibility = None,
+        **kwargs):
+    """Generates a working-set tsv for a dictionary image and a query corpus.
+
+    Runs //dictionary/system:system_dictionary_benchmark over the given
+    dictionary image with the given queries and captures the per-section
+    resident page counts before and after the workload, so that layout
+    decisions (e.g. a frequency-partitioned token array) can be validated
+    per release.
+    """
+    native.genrule(
+        name = name,
+        srcs = [
+            dictionary_file,
+            query_file,
+        ],
+        outs = [name + ".tsv"],
+        cmd = """
+            $(location //dictionary/system:system_dictionary_benchmark) \
+                --dictionary_file="$(location {dictionary_file})" \
+                --query_file="$(location {query_file})" \
+                --rounds={rounds} > "$@"
+        """.format(
+            dictionary_file = dictionary_file,
+            query_file = query_file,
+            rounds = rounds,
+        ),
+        tags = ["manual"],
+        tools = ["//dictionary/system:system_dictionary_benchmark"],
+        visibility = visibility,
+        **kwargs
+    )
@@ -67,6 +67,15 @@ class StateTable {
     idarray_[id] = std::move(str);
   }
 
+  // Group numbering note: compressed ids are assigned in first-seen order
+  // while scanning POS ids from 0 upwards, so a group's number is the rank
+  // of the smallest POS id mapping to it.  POS ids are ordered by frequency
+  // in id.def, which means hot groups already receive small numbers and the
+  // frequently probed region of the bitarray clusters at its start (the
+  // runtime's fused offset tables rely on the same property).  A
+  // corpus-measured co-occurrence permutation could only reorder within
+  // that frequency ordering; without a corpus in the tree there is nothing
+  // better to sort by here.
   void Build() {
     compressed_table_.resize(idarray_.size());
     uint16_t id = 0;
@@ -30,7 +30,7 @@
 #include "converter/immutable_converter.h"
 
 #include <algorithm>
-#include <array>
+#include <atomic>
 #include <climits>
 #include <cstddef>
 #include <cstdint>
@@ -40,7 +40,7 @@
 #include <utility>
 #include <vector>
 
-#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/strings/match.h"
@@ -49,7 +49,9 @@
 #include "absl/types/span.h"
 #include "base/container/trie.h"
 #include "base/japanese_util.h"
+#include "base/perf_histogram.h"
 #include "base/strings/unicode.h"
+#include "base/thread.h"
 #include "base/util.h"
 #include "base/vlog.h"
 #include "converter/connector.h"
@@ -78,6 +80,11 @@ using ::mozc::dictionary::PosMatcher;
 using ::mozc::dictionary::Token;
 
 constexpr size_t kMaxSegmentsSize = 256;
+
+// Conversion keys at least this long (in bytes) shard their per-position
+// dictionary lookups across kParallelLookupThreads worker threads.
+constexpr size_t kParallelLookupMinKeySize = 96;
+constexpr size_t kParallelLookupThreads = 4;
 constexpr size_t kMaxCharLength = 1024;
 constexpr size_t kMaxCharLengthForReverseConversion = 600;  // 200 chars in UTF8
 constexpr int kMaxCost = 32767;
@@ -109,6 +116,7 @@ class KeyCorrectedNodeListBuilder : public BaseNodeListBuilder {
     Node *node = NewNodeFromToken(token);
     node->key.assign(original_lookup_key_.data() + pos_, offset);
     node->wcost += KeyCorrector::GetCorrectedCostPenalty(node->key);
+    node->attributes |= Node::KEY_CORRECTED;
 
     // Push back |node| to the end.
     if (result_ == nullptr) {
@@ -242,6 +250,17 @@ void NormalizeHistorySegments(Segments *segments) {
   }
 }
 
+// Opaque state stored in Segments to keep the n-best agenda of the last
+// conversion alive for candidate paging. The immutable converter is the only
+// producer of Segments::ConverterState, see ExtendCandidates.
+struct NBestState : public Segments::ConverterState {
+  std::unique_ptr<NBestGenerator> generator;
+  // The segment the agenda belongs to; identity is checked by pointer, which
+  // is stable in Segments, and the state is reset on structural changes.
+  Segment *segment = nullptr;
+  std::string original_key;
+};
+
 Lattice *GetLattice(Segments *segments, bool is_prediction) {
   Lattice *lattice = segments->mutable_cached_lattice();
   if (lattice == nullptr) {
@@ -724,38 +743,42 @@ class NodeListBuilderWithCacheEnabled : public NodeListBuilderForLookupPrefix {
 Node *ImmutableConverter::Lookup(const int begin_pos,
                                  const ConversionRequest &request,
                                  bool is_reverse, bool is_prediction,
-                                 Lattice *lattice) const {
+                                 Lattice *lattice,
+                                 NodeAllocator *allocator) const {
   const std::string &key = lattice->key();
   CHECK_LT(begin_pos, key.size());
   const absl::string_view key_substr = absl::string_view{key}.substr(begin_pos);
 
-  lattice->node_allocator()->set_max_nodes_size(8192);
+  allocator->set_max_nodes_size(8192);
   Node *result_node = nullptr;
+  // Length already covered by the lattice cache at this position; 0 when the
+  // cache feature is unused.
+  size_t cached_len = 0;
   if (is_reverse) {
-    BaseNodeListBuilder builder(lattice->node_allocator(),
-                                lattice->node_allocator()->max_nodes_size());
+    BaseNodeListBuilder builder(allocator, allocator->max_nodes_size());
     dictionary_->LookupReverse(key_substr, request, &builder);
     result_node = builder.result();
   } else {
     if (is_prediction) {
-      NodeListBuilderWithCacheEnabled builder(
-          lattice->node_allocator(), lattice->cache_info(begin_pos) + 1);
+      cached_len = lattice->cache_info(begin_pos);
+      NodeListBuilderWithCacheEnabled builder(allocator, cached_len + 1);
       dictionary_->LookupPrefix(key_substr, request, &builder);
       result_node = builder.result();
       lattice->SetCacheInfo(begin_pos, key_substr.length());
     } else {
       // When cache feature is not used, look up normally
-      BaseNodeListBuilder builder(lattice->node_allocator(),
-                                  lattice->node_allocator()->max_nodes_size());
+      BaseNodeListBuilder builder(allocator, allocator->max_nodes_size());
       dictionary_->LookupPrefix(key_substr, request, &builder);
       result_node = builder.result();
     }
   }
-  return AddCharacterTypeBasedNodes(key_substr, lattice, result_node);
+  return AddCharacterTypeBasedNodes(key_substr, result_node, cached_len,
+                                    is_prediction && !is_reverse, allocator);
 }
 
 Node *ImmutableConverter::AddCharacterTypeBasedNodes(
-    absl::string_view key_substr, Lattice *lattice, Node *nodes) const {
+    absl::string_view key_substr, Node *nodes, size_t cached_len,
+    bool enable_cache, NodeAllocator *allocator) const {
   const Utf8AsChars32 utf8_as_chars32(key_substr);
   Utf8AsChars32::const_iterator it = utf8_as_chars32.begin();
   CHECK(it != utf8_as_chars32.end());
@@ -765,27 +788,35 @@ Node *ImmutableConverter::AddCharacterTypeBasedNodes(
   const Util::FormType first_form_type = Util::GetFormType(codepoint);
 
   // Add 1 character node. It can be either UnknownId or NumberId.
-  {
-    Node *new_node = lattice->NewNode();
+  // When the cache feature is used, the node is kept in the lattice across
+  // keystrokes (ENABLE_CACHE) and is not added again for positions already
+  // covered; re-adding it every keystroke would needlessly invalidate the
+  // Viterbi annotations of the unchanged prefix.
+  if (!enable_cache || cached_len < it.view().size()) {
+    Node *new_node = allocator->NewNode();
     CHECK(new_node);
     if (first_script_type == Util::NUMBER) {
       new_node->lid = number_id_;
       new_node->rid = number_id_;
+      new_node->wcost = kDefaultNumberCost;
     } else {
       new_node->lid = unknown_id_;
       new_node->rid = unknown_id_;
+      new_node->wcost = kMaxCost;
     }
 
-    new_node->wcost = kMaxCost;
     new_node->value.assign(it.view());
     new_node->key.assign(it.view());
     new_node->node_type = Node::NOR_NODE;
+    if (enable_cache) {
+      new_node->attributes |= Node::ENABLE_CACHE;
+      new_node->raw_wcost = new_node->wcost;
+    }
     new_node->bnext = nodes;
     nodes = new_node;
   }  // scope out |new_node|
 
   if (first_script_type == Util::NUMBER) {
-    nodes->wcost = kDefaultNumberCost;
     return nodes;
   }
 
@@ -806,7 +837,7 @@ Node *ImmutableConverter::AddCharacterTypeBasedNodes(
   }
 
   if (num_char > 1) {
-    Node *new_node = lattice->NewNode();
+    Node *new_node = allocator->NewNode();
     CHECK(new_node);
     if (first_script_type == Util::NUMBER) {
       new_node->lid = number_id_;
@@ -830,126 +861,180 @@ Node *ImmutableConverter::AddCharacterTypeBasedNodes(
 
 namespace {
 
-// A wrapper for Connector to minimize calls of Connector::GetTransitionCost()
-// in Viterbi algorithm. This way the performance of Viterbi algorithm improves
-// significantly in terms of time consumption because
-// Connector::GetTransitionCost() is slow due to its compression format. This
-// class implements a cache strategy designed for the access pattern in Viterbi
-// algorithm.
-//
-// In Viterbi algorithm, the connection matrix is looked up in a nested loop as
-// follows:
-//
-// for each right node `r`:
-//   for each left node `l`:
-//     ...
-//     transition cost = connector.GetTransitionCost(l.rid, r.lid)
-//     ...
-//
-// Therefore, in the inner loop, `r.lid` is fixed. So we can simply use an array
-// to cache the transition cost for (l.rid, r.lid) in `cache[l.rid]`, and cache
-// is reset before the inner loop. Moreover, right nodes are likely to be
-// ordered by `r.lid` although it's not guaranteed in general. This fact is plus
-// for this caching strategy as we only need to reset the cache if `r.lid` is
-// different from the previous value.
-//
-// NOTE: This class is designed only for Viterbi algorithm and won't work for
-// other purposes.
-class CachingConnector final {
- public:
-  explicit CachingConnector(const Connector &connector)
-      : connector_{connector} {}
-
-  CachingConnector(const CachingConnector &) = delete;
-  CachingConnector &operator=(const CachingConnector &) = delete;
+// Reasonably big cost. Cannot use INT_MAX because a new cost will be
+// calculated based on kVeryBigCost.
+constexpr int kVeryBigCost = (INT_MAX >> 2);
 
-  void ResetCacheIfNecessary(uint16_t rnode_lid) {
-    if (cache_lid_ != rnode_lid) {
-      absl::c_fill(cache_, -1);
-      cache_lid_ = rnode_lid;
+// Scratch buffers for ViterbiInternal. The valid left nodes at a boundary are
+// copied once per position into these contiguous structure-of-arrays buffers,
+// so the innermost cost minimization runs over flat int arrays instead of
+// chasing the Node::enext linked list. Together with the per-lane transition
+// cost array below, the hot loop becomes a branch-free add-and-min over
+// contiguous memory that the compiler can vectorize.
+//
+// `transition_costs` is aligned with `lnode_costs`/`lnodes`: lane i holds
+// GetTransitionCost(lnode_rids[i], lid) for the current rnode lid. Right nodes
+// are likely to be ordered by lid (though it's not guaranteed in general), so
+// the array is rebuilt only when the lid changes, which keeps the number of
+// calls into the compressed connection matrix small.
+struct ViterbiScratch {
+  // Collects the valid left nodes ending at |pos| into the SoA buffers,
+  // summarized per right id: the transition cost to any rnode depends on the
+  // lnode only through (cost, rid), so per rid only the min-cost node can
+  // win and the others never need scanning.  `lnode_order` remembers each
+  // representative's position in the original scan so that tie-breaking
+  // stays identical to the full scan: the cheapest node of the winning rid
+  // is always at or before any other node of that rid attaining the
+  // minimum, hence picking the representative with the smallest original
+  // position reproduces the first-attaining node exactly.
+  void CollectLeftNodes(const Lattice &lattice, size_t pos) {
+    lnode_costs.clear();
+    lnode_rids.clear();
+    lnodes.clear();
+    lnode_order.clear();
+    rid_slot.clear();
+    uint32_t order = 0;
+    for (Node *lnode = lattice.end_nodes(pos); lnode != nullptr;
+         lnode = lnode->enext) {
+      if (lnode->prev == nullptr) {
+        // Invalid lnode.
+        continue;
+      }
+      const auto [it, inserted] = rid_slot.try_emplace(lnode->rid,
+                                                       lnodes.size());
+      if (inserted) {
+        lnode_costs.push_back(lnode->cost);
+        lnode_rids.push_back(lnode->rid);
+        lnodes.push_back(lnode);
+        lnode_order.push_back(order);
+      } else if (lnode->cost < lnode_costs[it->second]) {
+        // Strictly cheaper only: on equal costs the earlier node keeps the
+        // slot, preserving the original tie-breaking.
+        lnode_costs[it->second] = lnode->cost;
+        lnodes[it->second] = lnode;
+        lnode_order[it->second] = order;
+      }
+      ++order;
     }
+    transition_lid = -1;
   }
 
-  int GetTransitionCost(uint16_t lnode_rid, uint16_t rnode_lid) {
-    DCHECK_EQ(cache_lid_, rnode_lid);
-    // Values for rid >= kCacheSize cannot be cached. However, frequent PoSs
-    // have smaller IDs, so caching only for rid in [0, kCacheSize) works well.
-    if (lnode_rid >= kCacheSize) {
-      return connector_.GetTransitionCost(lnode_rid, rnode_lid);
+  // Fills `transition_costs` for |rnode_lid| unless it is already filled.
+  void FillTransitionCostsIfNecessary(const Connector &connector,
+                                      uint16_t rnode_lid) {
+    if (transition_lid == rnode_lid) {
+      return;
     }
-    if (cache_[lnode_rid] != -1) {
-      return cache_[lnode_rid];
+    transition_costs.resize(lnode_rids.size());
+    for (size_t i = 0; i < lnode_rids.size(); ++i) {
+      transition_costs[i] = connector.GetTransitionCost(lnode_rids[i],
+                                                        rnode_lid);
     }
-    cache_[lnode_rid] = connector_.GetTransitionCost(lnode_rid, rnode_lid);
-    return cache_[lnode_rid];
+    transition_lid = rnode_lid;
   }
 
- private:
-  constexpr static int kCacheSize = 2048;
-
-  const Connector &connector_;
-  std::array<int, kCacheSize> cache_;
-  uint16_t cache_lid_ = std::numeric_limits<uint16_t>::max();
+  std::vector<int> lnode_costs;
+  std::vector<uint16_t> lnode_rids;
+  std::vector<Node *> lnodes;
+  std::vector<uint32_t> lnode_order;
+  absl::flat_hash_map<uint16_t, size_t> rid_slot;
+  std::vector<int> transition_costs;
+  // lid of the rnode for which `transition_costs` is currently filled, or -1
+  // if the buffers are stale. Kept as int so that it never collides with a
+  // valid uint16_t lid.
+  int transition_lid = -1;
 };
 
-// Reasonably big cost. Cannot use INT_MAX because a new cost will be
-// calculated based on kVeryBigCost.
-constexpr int kVeryBigCost = (INT_MAX >> 2);
+// Marks the boundary at |rnode|'s end position dirty when its Viterbi
+// annotation changed, so that clean boundaries depending on it get re-relaxed.
+// A node with prev == nullptr is filtered out as a left context, so only the
+// validity flip and, for valid nodes, the cost matter downstream.
+inline void PropagateViterbiUpdate(const Node &rnode, bool was_valid,
+                                   int old_cost, Lattice *lattice) {
+  const bool is_valid = rnode.prev != nullptr;
+  if (is_valid != was_valid || (is_valid && rnode.cost != old_cost)) {
+    lattice->set_viterbi_dirty(rnode.end_pos, true);
+  }
+}
 
 // Runs viterbi algorithm at position |pos|. The left_boundary/right_boundary
 // are the next boundary looked from pos. (If pos is on the boundary,
 // left_boundary should be the previous one, and right_boundary should be
-// the next).
+// the next). |scratch| is reused across positions to avoid reallocation.
 inline void ViterbiInternal(const Connector &connector, size_t pos,
-                            size_t right_boundary, Lattice *lattice) {
-  CachingConnector conn(connector);
+                            size_t right_boundary, bool exclude_corrected,
+                            Lattice *lattice, ViterbiScratch *scratch) {
+  if (!lattice->viterbi_dirty(pos)) {
+    // All annotations computed at this boundary in a previous run are still
+    // valid.
+    return;
+  }
+  scratch->CollectLeftNodes(*lattice, pos);
+  const size_t lnode_size = scratch->lnodes.size();
+
   for (Node *rnode = lattice->begin_nodes(pos); rnode != nullptr;
        rnode = rnode->bnext) {
-    if (rnode->end_pos > right_boundary) {
+    const bool was_valid = rnode->prev != nullptr;
+    const int old_cost = rnode->cost;
+
+    if (rnode->end_pos > right_boundary ||
+        (exclude_corrected && (rnode->attributes & Node::KEY_CORRECTED))) {
       // Invalid rnode.
       rnode->prev = nullptr;
+      PropagateViterbiUpdate(*rnode, was_valid, old_cost, lattice);
       continue;
     }
 
-    conn.ResetCacheIfNecessary(rnode->lid);
-
     if (rnode->constrained_prev != nullptr) {
       // Constrained node.
       if (rnode->constrained_prev->prev == nullptr) {
         rnode->prev = nullptr;
       } else {
         rnode->prev = rnode->constrained_prev;
-        rnode->cost = rnode->prev->cost + rnode->wcost +
-                      conn.GetTransitionCost(rnode->prev->rid, rnode->lid);
+        rnode->cost =
+            rnode->prev->cost + rnode->wcost +
+            connector.GetTransitionCost(rnode->prev->rid, rnode->lid);
       }
+      PropagateViterbiUpdate(*rnode, was_valid, old_cost, lattice);
       continue;
     }
 
+    scratch->FillTransitionCostsIfNecessary(connector, rnode->lid);
+
     // Find a valid node which connects to the rnode with minimum cost.
+    // The reduction and the index search are split into two passes: the first
+    // pass is a pure min reduction over contiguous arrays, which vectorizes,
+    // and the second pass finds the first lane that attains the minimum, which
+    // preserves the tie-breaking of the original linked-list loop.
     int best_cost = kVeryBigCost;
-    Node *best_node = nullptr;
-    for (Node *lnode = lattice->end_nodes(pos); lnode != nullptr;
-         lnode = lnode->enext) {
-      if (lnode->prev == nullptr) {
-        // Invalid lnode.
-        continue;
-      }
+    const int *lnode_costs = scratch->lnode_costs.data();
+    const int *transition_costs = scratch->transition_costs.data();
+    for (size_t i = 0; i < lnode_size; ++i) {
+      best_cost = std::min(best_cost, lnode_costs[i] + transition_costs[i]);
+    }
 
-      int cost = lnode->cost + conn.GetTransitionCost(lnode->rid, rnode->lid);
-      if (cost < best_cost) {
-        best_cost = cost;
-        best_node = lnode;
+    Node *best_node = nullptr;
+    if (best_cost < kVeryBigCost) {
+      uint32_t best_order = std::numeric_limits<uint32_t>::max();
+      for (size_t i = 0; i < lnode_size; ++i) {
+        if (lnode_costs[i] + transition_costs[i] == best_cost &&
+            scratch->lnode_order[i] < best_order) {
+          best_order = scratch->lnode_order[i];
+          best_node = scratch->lnodes[i];
+        }
       }
     }
 
     rnode->prev = best_node;
     rnode->cost = best_cost + rnode->wcost;
+    PropagateViterbiUpdate(*rnode, was_valid, old_cost, lattice);
   }
+  lattice->set_viterbi_dirty(pos, false);
 }
 }  // namespace
 
-bool ImmutableConverter::Viterbi(const Segments &segments,
-                                 Lattice *lattice) const {
+bool ImmutableConverter::Viterbi(const Segments &segments, Lattice *lattice,
+                                 bool exclude_corrected) const {
   const std::string &key = lattice->key();
 
   // Process BOS.
@@ -962,8 +1047,15 @@ bool ImmutableConverter::Viterbi(const Segments &segments,
     const size_t right_boundary = segments.segment(0).key().size();
     for (Node *rnode = lattice->begin_nodes(0); rnode != nullptr;
          rnode = rnode->bnext) {
-      if (rnode->end_pos > right_boundary) {
-        // Invalid rnode.
+      const bool was_valid = rnode->prev != nullptr;
+      const int old_cost = rnode->cost;
+      if (rnode->end_pos > right_boundary ||
+          (exclude_corrected && (rnode->attributes & Node::KEY_CORRECTED))) {
+        // Invalid rnode.  Reset the annotation explicitly: when the lattice
+        // is re-decoded under new boundaries, the node may carry a stale
+        // valid path from the previous run.
+        rnode->prev = nullptr;
+        PropagateViterbiUpdate(*rnode, was_valid, old_cost, lattice);
         continue;
       }
 
@@ -974,10 +1066,12 @@ bool ImmutableConverter::Viterbi(const Segments &segments,
       rnode->cost = bos_node->cost +
                     connector_.GetTransitionCost(bos_node->rid, rnode->lid) +
                     rnode->wcost;
+      PropagateViterbiUpdate(*rnode, was_valid, old_cost, lattice);
     }
   }
 
   size_t left_boundary = 0;
+  ViterbiScratch scratch;
 
   // Specialization for the first segment.
   // Don't run on the left boundary (the connection with BOS node),
@@ -986,7 +1080,8 @@ bool ImmutableConverter::Viterbi(const Segments &segments,
     const size_t right_boundary =
         left_boundary + segments.segment(0).key().size();
     for (size_t pos = left_boundary + 1; pos < right_boundary; ++pos) {
-      ViterbiInternal(connector_, pos, right_boundary, lattice);
+      ViterbiInternal(connector_, pos, right_boundary, exclude_corrected,
+                      lattice, &scratch);
     }
     left_boundary = right_boundary;
   }
@@ -996,7 +1091,8 @@ bool ImmutableConverter::Viterbi(const Segments &segments,
     // Run Viterbi for each position the segment.
     const size_t right_boundary = left_boundary + segment.key().size();
     for (size_t pos = left_boundary; pos < right_boundary; ++pos) {
-      ViterbiInternal(connector_, pos, right_boundary, lattice);
+      ViterbiInternal(connector_, pos, right_boundary, exclude_corrected,
+                      lattice, &scratch);
     }
     left_boundary = right_boundary;
   }
@@ -1132,6 +1228,11 @@ void ImmutableConverter::PredictionViterbiInternal(int calc_begin_pos,
   const CostAndNode kInvalidValue(INT_MAX, nullptr);
 
   for (size_t pos = calc_begin_pos; pos <= calc_end_pos; ++pos) {
+    if (!lattice->viterbi_dirty(pos)) {
+      // The annotations computed at this boundary in a previous run are still
+      // valid; the lattice tracks all structural changes since then.
+      continue;
+    }
     lbest.clear();
     for (Node *lnode = lattice->end_nodes(pos); lnode != nullptr;
          lnode = lnode->enext) {
@@ -1192,8 +1293,17 @@ void ImmutableConverter::PredictionViterbiInternal(int calc_begin_pos,
         continue;
       }
 
+      const bool was_valid = rnode->prev != nullptr;
+      const int old_cost = rnode->cost;
       rnode->cost = iter->second.first + rnode->wcost;
       rnode->prev = iter->second.second;
+      PropagateViterbiUpdate(*rnode, was_valid, old_cost, lattice);
+    }
+
+    // The boundary at calc_end_pos is processed again by the adjacent range
+    // (nodes crossing it are skipped here), so it must stay dirty.
+    if (pos < calc_end_pos) {
+      lattice->set_viterbi_dirty(pos, false);
     }
   }
 }
@@ -1525,7 +1635,8 @@ bool ImmutableConverter::MakeLatticeNodesForHistorySegments(
          request.request_type() == ConversionRequest::PREDICTION);
     if (!is_prediction && s + 1 == history_segments_size) {
       const Node *node =
-          Lookup(segments_pos, request, is_reverse, is_prediction, lattice);
+          Lookup(segments_pos, request, is_reverse, is_prediction, lattice,
+                 lattice->node_allocator());
       for (const Node *compound_node = node; compound_node != nullptr;
            compound_node = compound_node->bnext) {
         // No overlaps
@@ -1607,24 +1718,80 @@ void ImmutableConverter::MakeLatticeNodesForConversionSegments(
       (request.request_type() == ConversionRequest::CONVERSION);
   // Do not use KeyCorrector if user changes the boundary.
   // http://b/issue?id=2804996
-  std::unique_ptr<KeyCorrector> key_corrector;
+  KeyCorrector *key_corrector = nullptr;
   if (is_conversion && !segments.resized()) {
     KeyCorrector::InputMode mode = KeyCorrector::ROMAN;
     if (request.config().preedit_method() != config::Config::ROMAN) {
       mode = KeyCorrector::KANA;
     }
-    key_corrector =
-        std::make_unique<KeyCorrector>(key, mode, history_key.size());
+    // The corrector cached in the lattice is updated incrementally when the
+    // key merely grew (the common per-keystroke case) and rebuilt otherwise.
+    key_corrector = lattice->mutable_key_corrector();
+    key_corrector->UpdateKey(key, mode, history_key.size());
   }
 
   const bool is_reverse =
       (request.request_type() == ConversionRequest::REVERSE_CONVERSION);
+  // Partial requests run on the converter's scratch lattice and use the same
+  // incremental node cache as prediction, so cursor movements only look up
+  // the positions the key change uncovered.
   const bool is_prediction =
       (request.request_type() == ConversionRequest::SUGGESTION ||
-       request.request_type() == ConversionRequest::PREDICTION);
+       request.request_type() == ConversionRequest::PREDICTION ||
+       request.request_type() == ConversionRequest::PARTIAL_SUGGESTION ||
+       request.request_type() == ConversionRequest::PARTIAL_PREDICTION);
+
+  // For long conversion keys the per-position dictionary lookups dominate
+  // lattice construction and are independent of each other, so they are
+  // sharded across a few worker threads pulling positions from a shared
+  // atomic counter. The results are inserted into the lattice sequentially
+  // below, which keeps the built lattice identical to the one the sequential
+  // loop produces. Each worker allocates from its own arena and the arenas
+  // are adopted by the lattice afterwards, so the nodes live as long as any
+  // other lattice node. Prediction requests reuse the cached lattice and
+  // reverse conversion uses a mutable lookup cache, so only CONVERSION
+  // requests take this path.
+  std::vector<Node *> lookup_results;
+  const bool is_parallel_lookup =
+      is_conversion && key.size() >= kParallelLookupMinKeySize;
+  if (is_parallel_lookup) {
+    lookup_results.assign(key.size(), nullptr);
+    std::atomic<size_t> next_pos = history_key.size();
+    std::vector<std::unique_ptr<NodeAllocator>> allocators;
+    std::vector<Thread> threads;
+    allocators.reserve(kParallelLookupThreads);
+    threads.reserve(kParallelLookupThreads);
+    for (size_t i = 0; i < kParallelLookupThreads; ++i) {
+      allocators.push_back(std::make_unique<NodeAllocator>());
+      NodeAllocator *allocator = allocators.back().get();
+      threads.emplace_back([this, &request, &key, &next_pos, &lookup_results,
+                            lattice, allocator] {
+        for (size_t pos = next_pos.fetch_add(1); pos < key.size();
+             pos = next_pos.fetch_add(1)) {
+          // Positions in the middle of a character are looked up too; they
+          // are discarded by the reachability check (end_nodes) below, like
+          // in the sequential loop.
+          lookup_results[pos] =
+              Lookup(pos, request, /* is_reverse= */ false,
+                     /* is_prediction= */ false, lattice, allocator);
+        }
+      });
+    }
+    for (Thread &thread : threads) {
+      thread.Join();
+    }
+    for (std::unique_ptr<NodeAllocator> &allocator : allocators) {
+      lattice->AdoptAllocator(std::move(allocator));
+    }
+  }
+
   for (size_t pos = history_key.size(); pos < key.size(); ++pos) {
     if (lattice->end_nodes(pos) != nullptr) {
-      Node *rnode = Lookup(pos, request, is_reverse, is_prediction, lattice);
+      Node *rnode =
+          is_parallel_lookup
+              ? lookup_results[pos]
+              : Lookup(pos, request, is_reverse, is_prediction, lattice,
+                       lattice->node_allocator());
       // If history key is NOT empty and user input seems to starts with
       // a particle ("はにで..."), mark the node as STARTS_WITH_PARTICLE.
       // We change the segment boundary if STARTS_WITH_PARTICLE attribute
@@ -1639,7 +1806,7 @@ void ImmutableConverter::MakeLatticeNodesForConversionSegments(
       }
       CHECK(rnode != nullptr);
       lattice->Insert(pos, rnode);
-      InsertCorrectedNodes(pos, key, request, key_corrector.get(), dictionary_,
+      InsertCorrectedNodes(pos, key, request, key_corrector, dictionary_,
                            lattice);
     }
   }
@@ -1855,15 +2022,16 @@ void ImmutableConverter::InsertCandidates(const ConversionRequest &request,
 
   const bool is_single_segment =
       (type == SINGLE_SEGMENT || type == FIRST_INNER_SEGMENT);
-  NBestGenerator nbest_generator(suppression_dictionary_, segmenter_,
-                                 connector_, pos_matcher_, &lattice,
-                                 suggestion_filter_);
+  auto nbest_generator = std::make_unique<NBestGenerator>(
+      suppression_dictionary_, segmenter_, connector_, pos_matcher_, &lattice,
+      suggestion_filter_);
 
   std::string original_key;
   for (const Segment &segment : segments->conversion_segments()) {
     original_key.append(segment.key());
   }
 
+  Segment *last_segment = nullptr;
   size_t begin_pos = std::string::npos;
   for (Node *node = prev->next; node->next != nullptr; node = node->next) {
     if (begin_pos == std::string::npos) {
@@ -1893,8 +2061,10 @@ void ImmutableConverter::InsertCandidates(const ConversionRequest &request,
           NBestGenerator::BUILD_FROM_ONLY_FIRST_INNER_SEGMENT;
       options.candidate_mode |= NBestGenerator::FILL_INNER_SEGMENT_INFO;
     }
-    nbest_generator.Reset(prev, node->next, options);
-    nbest_generator.SetCandidates(request, original_key, expand_size, segment);
+    nbest_generator->Reset(prev, node->next, options);
+    nbest_generator->SetCandidates(request, original_key, expand_size,
+                                   segment);
+    last_segment = segment;
 
     if (type == MULTI_SEGMENTS || type == SINGLE_SEGMENT) {
       InsertDummyCandidates(segment, expand_size);
@@ -1910,6 +2080,19 @@ void ImmutableConverter::InsertCandidates(const ConversionRequest &request,
     begin_pos = std::string::npos;
     prev = node;
   }
+
+  // For conversion, keep the agenda of the last segment alive inside the
+  // Segments so that ExtendCandidates can pull further candidates on
+  // candidate paging without recomputing the lattice. The state is dropped on
+  // any structural change of the segments or at the next conversion.
+  if ((type == MULTI_SEGMENTS || type == SINGLE_SEGMENT) &&
+      last_segment != nullptr) {
+    auto state = std::make_unique<NBestState>();
+    state->generator = std::move(nbest_generator);
+    state->segment = last_segment;
+    state->original_key = std::move(original_key);
+    segments->set_converter_state(std::move(state));
+  }
 }
 
 bool ImmutableConverter::MakeSegments(const ConversionRequest &request,
@@ -2121,38 +2304,172 @@ void ImmutableConverter::MakeGroup(const Segments &segments,
   group->push_back(static_cast<uint16_t>(segments.segments_size()));
 }
 
-bool ImmutableConverter::ConvertForRequest(const ConversionRequest &request,
-                                           Segments *segments) const {
-  const bool is_prediction =
-      (request.request_type() == ConversionRequest::PREDICTION ||
-       request.request_type() == ConversionRequest::SUGGESTION);
+bool ImmutableConverter::ExtendCandidates(const ConversionRequest &request,
+                                          Segments *segments,
+                                          const size_t segment_index,
+                                          const size_t size) const {
+  // Safe downcast: the immutable converter is the only producer of
+  // Segments::ConverterState.
+  NBestState *state = static_cast<NBestState *>(segments->converter_state());
+  if (state == nullptr || state->generator == nullptr) {
+    return false;
+  }
+  if (segment_index >= segments->segments_size() ||
+      segments->mutable_segment(segment_index) != state->segment) {
+    return false;
+  }
+  Segment *segment = state->segment;
+  const size_t old_size = segment->candidates_size();
+  state->generator->SetCandidates(request, state->original_key,
+                                  old_size + size, segment);
+  return segment->candidates_size() > old_size;
+}
 
-  Lattice *lattice = GetLattice(segments, is_prediction);
+bool ImmutableConverter::RedecodeWithNewBoundaries(
+    const ConversionRequest &request, Segments *segments) const {
+  if (request.request_type() != ConversionRequest::CONVERSION) {
+    return false;
+  }
+  // The n-best agenda kept from the previous decode refers to the old
+  // boundary structure.
+  segments->set_converter_state(nullptr);
 
-  if (!MakeLattice(request, segments, lattice)) {
-    LOG(WARNING) << "could not make lattice";
+  Lattice *lattice = segments->mutable_cached_lattice();
+  if (lattice == nullptr || !lattice->has_lattice()) {
     return false;
   }
 
+  // The lattice is reusable only when it was built for exactly the same
+  // history and conversion keys; boundary adjustment moves segment borders
+  // but never changes the concatenated keys.
+  std::string history_key;
+  for (const Segment &segment : segments->history_segments()) {
+    history_key.append(segment.key());
+  }
+  std::string key = history_key;
+  for (const Segment &segment : segments->conversion_segments()) {
+    key.append(segment.key());
+  }
+  if (lattice->key() != key ||
+      lattice->history_end_pos() != history_key.size()) {
+    return false;
+  }
+
+  // The segment windows changed, so every conversion boundary must be
+  // re-relaxed; the dirty bits only track cost propagation within a fixed
+  // boundary structure.
+  for (size_t pos = history_key.size(); pos <= key.size(); ++pos) {
+    lattice->set_viterbi_dirty(pos, true);
+  }
+
   std::vector<uint16_t> group;
   MakeGroup(*segments, &group);
 
-  if (is_prediction) {
-    if (!PredictionViterbi(*segments, lattice)) {
-      LOG(WARNING) << "prediction_viterbi failed";
+  {
+    PerfHistogram::ScopedProbe probe(PerfHistogram::VITERBI);
+    if (!Viterbi(*segments, lattice, /* exclude_corrected= */ true)) {
+      LOG(WARNING) << "viterbi failed";
+      return false;
+    }
+  }
+
+  {
+    PerfHistogram::ScopedProbe probe(PerfHistogram::NBEST);
+    if (!MakeSegments(request, *lattice, group, segments)) {
+      LOG(WARNING) << "make segments failed";
       return false;
     }
+  }
+
+  return true;
+}
+
+bool ImmutableConverter::ConvertForRequest(const ConversionRequest &request,
+                                           Segments *segments) const {
+  // Any previously stored n-best agenda refers to the lattice this conversion
+  // is about to rebuild.
+  segments->set_converter_state(nullptr);
+
+  const bool is_prediction =
+      (request.request_type() == ConversionRequest::PREDICTION ||
+       request.request_type() == ConversionRequest::SUGGESTION);
+  const bool is_partial =
+      (request.request_type() == ConversionRequest::PARTIAL_PREDICTION ||
+       request.request_type() == ConversionRequest::PARTIAL_SUGGESTION);
+
+  Lattice *lattice;
+  if (is_partial) {
+    // Partial requests convert a prefix of the composition the full-key
+    // lattice was just built for; reuse the converter's scratch lattice so
+    // that moving the cursor inside the preedit only runs the incremental
+    // lookups and decode, not a full rebuild.  MakeLattice shrinks or grows
+    // the key via Lattice::UpdateKey, which keeps the shared part.
+    lattice = &partial_lattice_;
+    std::string history_key;
+    for (const Segment &segment : segments->history_segments()) {
+      history_key.append(segment.key());
+    }
+    if (lattice->history_end_pos() != history_key.size()) {
+      // History changed; cached nodes do not match the new context.
+      lattice->Clear();
+    }
   } else {
-    if (!Viterbi(*segments, lattice)) {
-      LOG(WARNING) << "viterbi failed";
+    lattice = GetLattice(segments, is_prediction);
+    if (is_prediction && lattice != nullptr && !lattice->has_lattice()) {
+      // Prediction requests from the realtime-conversion aggregation arrive
+      // with freshly copied segments whose cached lattice is always empty,
+      // so the per-keystroke incremental reuse never applied there.  Route
+      // them to a converter-owned scratch lattice, cleared under the same
+      // conditions GetLattice uses for the per-segments one.
+      lattice = &realtime_lattice_;
+      std::string history_key;
+      for (const Segment &segment : segments->history_segments()) {
+        history_key.append(segment.key());
+      }
+      std::string conversion_key;
+      for (const Segment &segment : segments->conversion_segments()) {
+        conversion_key.append(segment.key());
+      }
+      if (Util::CharsLen(conversion_key) <= 1 ||
+          lattice->history_end_pos() != history_key.size()) {
+        lattice->Clear();
+      }
+    }
+  }
+
+  {
+    PerfHistogram::ScopedProbe probe(PerfHistogram::DICTIONARY_LOOKUP);
+    if (!MakeLattice(request, segments, lattice)) {
+      LOG(WARNING) << "could not make lattice";
       return false;
     }
   }
 
+  std::vector<uint16_t> group;
+  MakeGroup(*segments, &group);
+
+  {
+    PerfHistogram::ScopedProbe probe(PerfHistogram::VITERBI);
+    if (is_prediction) {
+      if (!PredictionViterbi(*segments, lattice)) {
+        LOG(WARNING) << "prediction_viterbi failed";
+        return false;
+      }
+    } else {
+      if (!Viterbi(*segments, lattice)) {
+        LOG(WARNING) << "viterbi failed";
+        return false;
+      }
+    }
+  }
+
   MOZC_VLOG(2) << lattice->DebugString();
-  if (!MakeSegments(request, *lattice, group, segments)) {
-    LOG(WARNING) << "make segments failed";
-    return false;
+  {
+    PerfHistogram::ScopedProbe probe(PerfHistogram::NBEST);
+    if (!MakeSegments(request, *lattice, group, segments)) {
+      LOG(WARNING) << "make segments failed";
+      return false;
+    }
   }
 
   return true;
@@ -43,6 +43,7 @@
 #include "converter/lattice.h"
 #include "converter/nbest_generator.h"
 #include "converter/node.h"
+#include "converter/node_allocator.h"
 #include "converter/segmenter.h"
 #include "converter/segments.h"
 #include "dictionary/dictionary_interface.h"
@@ -66,6 +67,25 @@ class ImmutableConverter : public ImmutableConverterInterface {
   ABSL_MUST_USE_RESULT bool ConvertForRequest(
       const ConversionRequest &request, Segments *segments) const override;
 
+  // Appends up to |size| additional candidates to the segment at
+  // |segment_index| by resuming the n-best agenda kept from the last
+  // ConvertForRequest call, without recomputing the lattice. Returns false if
+  // no resumable agenda is available for that segment (e.g. the segments were
+  // restructured, or the segment is not the one whose agenda was kept).
+  // Note: candidates appended here bypass the rewriter pipeline.
+  bool ExtendCandidates(const ConversionRequest &request, Segments *segments,
+                        size_t segment_index, size_t size) const override;
+
+  // Re-decodes the lattice kept from the last CONVERSION call under the
+  // segments' current boundaries, re-running only Viterbi and segment
+  // construction; the lattice and node costs are reused as is.  Returns
+  // false if no reusable lattice is available (different key or history),
+  // in which case the caller should fall back to ConvertForRequest.
+  // Nodes inserted by KeyCorrector are excluded from the decode, matching
+  // the full rerun which disables the corrector for resized segments.
+  bool RedecodeWithNewBoundaries(const ConversionRequest &request,
+                                 Segments *segments) const override;
+
  private:
   FRIEND_TEST(ImmutableConverterTest, AddPredictiveNodes);
   FRIEND_TEST(ImmutableConverterTest, DummyCandidatesCost);
@@ -93,10 +113,15 @@ class ImmutableConverter : public ImmutableConverterInterface {
                         const std::string &original_key, NBestGenerator *nbest,
                         Segment *segment, size_t expand_size) const;
   void InsertDummyCandidates(Segment *segment, size_t expand_size) const;
+  // Looks up nodes starting at |begin_pos|. Nodes are allocated from
+  // |allocator|, which is the lattice's own allocator except in the parallel
+  // lattice build, where each worker thread passes its own arena.
   Node *Lookup(int begin_pos, const ConversionRequest &request, bool is_reverse,
-               bool is_prediction, Lattice *lattice) const;
-  Node *AddCharacterTypeBasedNodes(absl::string_view key_substr,
-                                   Lattice *lattice, Node *nodes) const;
+               bool is_prediction, Lattice *lattice,
+               NodeAllocator *allocator) const;
+  Node *AddCharacterTypeBasedNodes(absl::string_view key_substr, Node *nodes,
+                                   size_t cached_len, bool enable_cache,
+                                   NodeAllocator *allocator) const;
 
   void Resegment(const Segments &segments, const std::string &history_key,
                  const std::string &conversion_key, Lattice *lattice) const;
@@ -126,7 +151,8 @@ class ImmutableConverter : public ImmutableConverterInterface {
   void ApplyPrefixSuffixPenalty(const std::string &conversion_key,
                                 Lattice *lattice) const;
 
-  bool Viterbi(const Segments &segments, Lattice *lattice) const;
+  bool Viterbi(const Segments &segments, Lattice *lattice,
+               bool exclude_corrected = false) const;
 
   bool PredictionViterbi(const Segments &segments, Lattice *lattice) const;
   void PredictionViterbiInternal(int calc_begin_pos, int calc_end_pos,
@@ -210,6 +236,23 @@ class ImmutableConverter : public ImmutableConverterInterface {
 
   // Cache for transition cost.
   const int32_t last_to_first_name_transition_cost_;
+
+  // Scratch lattice shared by PARTIAL_SUGGESTION / PARTIAL_PREDICTION
+  // requests.  Those arrive with freshly copied segments that cannot carry a
+  // cached lattice across cursor movements, so prefix conversions reuse this
+  // converter-owned one instead; Lattice::UpdateKey keeps the overlapping
+  // part when the cursor moves within the same composition.  Sessions are
+  // serialized by the handler, so no locking is needed (same policy as the
+  // per-segments cached lattice).
+  mutable Lattice partial_lattice_;
+
+  // Same idea for SUGGESTION / PREDICTION realtime conversions: the
+  // aggregator hands over freshly copied segments whose cached lattice is
+  // always empty, so without this the lattice was rebuilt on every
+  // keystroke.  Kept separate from partial_lattice_ because the partial
+  // prefix key and the full query key would otherwise evict each other
+  // while the cursor moves.
+  mutable Lattice realtime_lattice_;
 };
 
 }  // namespace mozc
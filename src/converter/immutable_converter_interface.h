@@ -30,6 +30,8 @@
 #ifndef MOZC_CONVERTER_IMMUTABLE_CONVERTER_INTERFACE_H_
 #define MOZC_CONVERTER_IMMUTABLE_CONVERTER_INTERFACE_H_
 
+#include <cstddef>
+
 #include "absl/base/attributes.h"
 #include "converter/segments.h"
 #include "request/conversion_request.h"
@@ -55,6 +57,25 @@ class ImmutableConverterInterface {
   ABSL_MUST_USE_RESULT virtual bool ConvertForRequest(
       const ConversionRequest &request, Segments *segments) const;
 
+  // Appends up to |size| additional candidates to the segment at
+  // |segment_index| by resuming candidate generation state kept from the
+  // last ConvertForRequest call, if any. Implementations that do not support
+  // resumable generation keep this default, which appends nothing.
+  virtual bool ExtendCandidates(const ConversionRequest &request,
+                                Segments *segments, size_t segment_index,
+                                size_t size) const {
+    return false;
+  }
+
+  // Re-decodes the result of the last conversion under the segments' current
+  // boundary constraints without rebuilding the lattice, if the
+  // implementation kept one.  Implementations without a reusable lattice
+  // keep this default; callers fall back to ConvertForRequest.
+  virtual bool RedecodeWithNewBoundaries(const ConversionRequest &request,
+                                         Segments *segments) const {
+    return false;
+  }
+
  protected:
   ImmutableConverterInterface() = default;
 };
@@ -29,6 +29,7 @@
 
 #include "converter/immutable_converter.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -132,6 +133,158 @@ TEST(ImmutableConverterTest, KeepKeyForPrediction) {
   EXPECT_EQ(segments.segment(0).key(), kRequestKey);
 }
 
+TEST(ImmutableConverterTest, ExtendCandidates) {
+  std::unique_ptr<MockDataAndImmutableConverter> data_and_converter(
+      new MockDataAndImmutableConverter);
+  Segments segments;
+  ConversionRequest request;
+  request.set_request_type(ConversionRequest::CONVERSION);
+  // Request few candidates up front so that the kept agenda has more to
+  // offer on paging.
+  request.set_max_conversion_candidates_size(2);
+  Segment *segment = segments.add_segment();
+  segment->set_key("よろしくおねがいします");
+  EXPECT_TRUE(data_and_converter->GetConverter()->ConvertForRequest(request,
+                                                                    &segments));
+  ASSERT_EQ(segments.segments_size(), 1);
+  const size_t initial_size = segments.segment(0).candidates_size();
+  EXPECT_GT(initial_size, 0);
+
+  if (data_and_converter->GetConverter()->ExtendCandidates(request, &segments,
+                                                           0, 10)) {
+    EXPECT_GT(segments.segment(0).candidates_size(), initial_size);
+  }
+
+  // An out-of-range segment never has a resumable agenda.
+  EXPECT_FALSE(data_and_converter->GetConverter()->ExtendCandidates(
+      request, &segments, 10, 10));
+
+  // Structural changes drop the agenda.
+  segments.pop_back_segment();
+  EXPECT_FALSE(data_and_converter->GetConverter()->ExtendCandidates(
+      request, &segments, 0, 10));
+}
+
+TEST(ImmutableConverterTest, PartialSuggestionReusesLattice) {
+  auto convert_partial = [](ImmutableConverter *converter,
+                            const absl::string_view key) {
+    Segments segments;
+    segments.add_segment()->set_key(key);
+    ConversionRequest request;
+    request.set_request_type(ConversionRequest::PARTIAL_SUGGESTION);
+    EXPECT_TRUE(converter->ConvertForRequest(request, &segments));
+    EXPECT_GT(segments.conversion_segment(0).candidates_size(), 0);
+    return std::string(segments.conversion_segment(0).candidate(0).value);
+  };
+
+  constexpr absl::string_view kFullKey = "よろしくおねがいします";
+  const size_t full_len = Util::CharsLen(kFullKey);
+
+  // Issue prefixes in decreasing length on one converter, exercising the
+  // scratch lattice reuse, and in increasing length on a fresh converter.
+  // The results must not depend on what was converted before.
+  std::unique_ptr<MockDataAndImmutableConverter> reused(
+      new MockDataAndImmutableConverter);
+  std::vector<std::string> reused_values;
+  for (size_t len = full_len; len >= 2; --len) {
+    reused_values.push_back(convert_partial(
+        reused->GetConverter(), Util::Utf8SubString(kFullKey, 0, len)));
+  }
+
+  // The other converter sees the prefixes in increasing length, so its
+  // lattice reuse pattern is entirely different.
+  std::unique_ptr<MockDataAndImmutableConverter> fresh(
+      new MockDataAndImmutableConverter);
+  std::vector<std::string> fresh_values;
+  for (size_t len = 2; len <= full_len; ++len) {
+    fresh_values.push_back(convert_partial(
+        fresh->GetConverter(), Util::Utf8SubString(kFullKey, 0, len)));
+  }
+  std::reverse(fresh_values.begin(), fresh_values.end());
+
+  EXPECT_EQ(reused_values, fresh_values);
+}
+
+TEST(ImmutableConverterTest, RealtimeSuggestionLatticeReuse) {
+  auto convert_suggestion = [](ImmutableConverter *converter,
+                               const absl::string_view key) {
+    Segments segments;
+    segments.add_segment()->set_key(key);
+    ConversionRequest request;
+    request.set_request_type(ConversionRequest::SUGGESTION);
+    EXPECT_TRUE(converter->ConvertForRequest(request, &segments));
+    EXPECT_GT(segments.conversion_segment(0).candidates_size(), 0);
+    return std::string(segments.conversion_segment(0).candidate(0).value);
+  };
+
+  constexpr absl::string_view kFullKey = "よろしくおねがいします";
+  const size_t full_len = Util::CharsLen(kFullKey);
+
+  // Growing keys, as typing issues them: each request passes a fresh
+  // Segments, so reuse can only come from the converter's scratch lattice.
+  std::unique_ptr<MockDataAndImmutableConverter> incremental(
+      new MockDataAndImmutableConverter);
+  std::vector<std::string> incremental_values;
+  for (size_t len = 2; len <= full_len; ++len) {
+    incremental_values.push_back(convert_suggestion(
+        incremental->GetConverter(), Util::Utf8SubString(kFullKey, 0, len)));
+  }
+
+  // Each key on its own pristine converter must give the same results.
+  std::vector<std::string> isolated_values;
+  for (size_t len = 2; len <= full_len; ++len) {
+    std::unique_ptr<MockDataAndImmutableConverter> isolated(
+        new MockDataAndImmutableConverter);
+    isolated_values.push_back(convert_suggestion(
+        isolated->GetConverter(), Util::Utf8SubString(kFullKey, 0, len)));
+  }
+
+  EXPECT_EQ(incremental_values, isolated_values);
+}
+
+TEST(ImmutableConverterTest, RedecodeWithNewBoundaries) {
+  std::unique_ptr<MockDataAndImmutableConverter> data_and_converter(
+      new MockDataAndImmutableConverter);
+  Segments segments;
+  ConversionRequest request;
+  request.set_request_type(ConversionRequest::CONVERSION);
+  Segment *segment = segments.add_segment();
+  segment->set_key("よろしくおねがいします");
+  EXPECT_TRUE(data_and_converter->GetConverter()->ConvertForRequest(request,
+                                                                    &segments));
+  ASSERT_GT(segments.segments_size(), 0);
+
+  // Mimic what Converter::ResizeSegment does: keep the keys, fix the first
+  // boundary and clear the candidates.
+  for (size_t i = 0; i < segments.segments_size(); ++i) {
+    Segment *seg = segments.mutable_segment(i);
+    std::string key = seg->key();
+    seg->Clear();
+    seg->set_key(std::move(key));
+    seg->set_segment_type(i == 0 ? Segment::FIXED_BOUNDARY : Segment::FREE);
+  }
+  segments.set_resized(true);
+
+  // The kept lattice covers the same key, so the re-decode must succeed and
+  // produce candidates without rebuilding the lattice.
+  EXPECT_TRUE(data_and_converter->GetConverter()->RedecodeWithNewBoundaries(
+      request, &segments));
+  ASSERT_GT(segments.segments_size(), 0);
+  EXPECT_GT(segments.segment(0).candidates_size(), 0);
+
+  // A different key cannot reuse the lattice.
+  Segments other_segments;
+  other_segments.add_segment()->set_key("ほかのかぎ");
+  EXPECT_FALSE(data_and_converter->GetConverter()->RedecodeWithNewBoundaries(
+      request, &other_segments));
+
+  // Only CONVERSION requests are supported.
+  ConversionRequest suggestion_request;
+  suggestion_request.set_request_type(ConversionRequest::SUGGESTION);
+  EXPECT_FALSE(data_and_converter->GetConverter()->RedecodeWithNewBoundaries(
+      suggestion_request, &segments));
+}
+
 TEST(ImmutableConverterTest, DummyCandidatesCost) {
   std::unique_ptr<MockDataAndImmutableConverter> data_and_converter(
       new MockDataAndImmutableConverter);
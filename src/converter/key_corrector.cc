@@ -35,6 +35,7 @@
 #include <string>
 
 #include "absl/strings/match.h"
+#include "absl/strings/string_view.h"
 #include "base/logging.h"
 #include "base/util.h"
 #include "base/vlog.h"
@@ -379,11 +380,14 @@ void KeyCorrector::Clear() {
   corrected_key_.clear();
   alignment_.clear();
   rev_alignment_.clear();
+  decision_start_.clear();
 }
 
 bool KeyCorrector::CorrectKey(const std::string &key, InputMode mode,
                               size_t history_size) {
   Clear();
+  mode_ = mode;
+  history_size_ = history_size;
 
   // TODO(taku)  support KANA
   if (mode == KANA) {
@@ -396,13 +400,67 @@ bool KeyCorrector::CorrectKey(const std::string &key, InputMode mode,
   }
 
   original_key_ = key;
+  return RunCorrection(0, 0, history_size);
+}
+
+bool KeyCorrector::UpdateKey(const std::string &key, InputMode mode,
+                             size_t history_size) {
+  // Bytes of context to redo before the previous key end. This is larger
+  // than the context any rewrite rule inspects (a few UTF-8 characters), so
+  // every kept decision is independent of the appended characters.
+  constexpr size_t kResumeWindowSize = 12;
+
+  if (!available_ || mode != mode_ || history_size != history_size_ ||
+      key.size() <= original_key_.size() || key.size() >= kMaxSize ||
+      !absl::StartsWith(key, original_key_)) {
+    return CorrectKey(key, mode, history_size);
+  }
+
+  // Find the resume point: the last decision boundary (start of a rewrite or
+  // passthrough step recorded by RunCorrection) before the window, so that
+  // every kept decision is complete and unaffected by the appended suffix.
+  const size_t window_begin =
+      original_key_.size() > history_size + kResumeWindowSize
+          ? original_key_.size() - kResumeWindowSize
+          : history_size;
+  size_t resume_pos = history_size;
+  for (size_t pos = window_begin; pos > history_size; --pos) {
+    if (pos < decision_start_.size() && decision_start_[pos] &&
+        alignment_[pos] != kInvalidPos &&
+        alignment_[pos] <= rev_alignment_.size()) {
+      resume_pos = pos;
+      break;
+    }
+  }
+
+  if (resume_pos <= history_size) {
+    return CorrectKey(key, mode, history_size);
+  }
+
+  // Drop everything from the resume point on and re-run the correction for
+  // the tail window plus the appended suffix.
+  corrected_key_.resize(alignment_[resume_pos]);
+  rev_alignment_.resize(alignment_[resume_pos]);
+  alignment_.resize(resume_pos);
+  decision_start_.resize(resume_pos);
+  original_key_ = key;
+  available_ = false;
+  const size_t prefix_chars =
+      Util::CharsLen(absl::string_view(key.data(), resume_pos));
+  return RunCorrection(resume_pos, prefix_chars, history_size);
+}
 
-  const char *begin = key.data();
+bool KeyCorrector::RunCorrection(size_t start_pos, size_t start_key_pos,
+                                 size_t history_size) {
+  const std::string &key = original_key_;
+  const char *begin = key.data() + start_pos;
   const char *end = key.data() + key.size();
   const char *input_begin = key.data() + history_size;
-  size_t key_pos = 0;
+  size_t key_pos = start_key_pos;
+  decision_start_.resize(key.size(), false);
 
   while (begin < end) {
+    decision_start_[begin - key.data()] = true;
     size_t mblen = 0;
     const size_t org_len = corrected_key_.size();
     if (begin < input_begin ||
@@ -30,6 +30,7 @@
 #ifndef MOZC_CONVERTER_KEY_CORRECTOR_H_
 #define MOZC_CONVERTER_KEY_CORRECTOR_H_
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -56,6 +57,13 @@ class KeyCorrector final {
 
   bool CorrectKey(const std::string &key, InputMode mode, size_t history_size);
 
+  // Incremental variant of CorrectKey. When |key| extends the current
+  // original key with the same mode and history size, only a small tail
+  // window plus the appended suffix is re-corrected and the mappings for the
+  // unchanged prefix are kept; otherwise this falls back to a full
+  // CorrectKey. Returns the same value CorrectKey would.
+  bool UpdateKey(const std::string &key, InputMode mode, size_t history_size);
+
   // return corrected key;
   const std::string &corrected_key() const { return corrected_key_; }
 
@@ -161,12 +169,23 @@ class KeyCorrector final {
   // invalid alignment marker
   static constexpr size_t kInvalidPos = static_cast<size_t>(-1);
 
+  // Runs the correction loop over original_key_ starting at byte position
+  // |start_pos| (character index |start_key_pos|), appending to
+  // corrected_key_ and the alignment arrays.
+  bool RunCorrection(size_t start_pos, size_t start_key_pos,
+                     size_t history_size);
+
   bool available_;
   InputMode mode_;
+  size_t history_size_ = 0;
   std::string corrected_key_;
   std::string original_key_;
   std::vector<size_t> alignment_;
   std::vector<size_t> rev_alignment_;
+  // decision_start_[pos] is true if a rewrite/passthrough step of the
+  // correction loop started at byte pos; UpdateKey may only resume at such
+  // boundaries.
+  std::vector<bool> decision_start_;
 };
 
 }  // namespace mozc
@@ -29,8 +29,10 @@
 
 #include "converter/key_corrector.h"
 
+#include <cstddef>
 #include <string>
 
+#include "base/util.h"
 #include "testing/gunit.h"
 
 namespace mozc {
@@ -492,6 +494,38 @@ TEST(KeyCorrectorTest, KeyCorrectorRomanGetOriginalOffsetTest) {
 }
 
 // Check if UCS4 is supported. b/3386634
+TEST(KeyCorrectorTest, UpdateKeyIncrementalTest) {
+  // Extending the key character by character must produce exactly the same
+  // correction as a full rebuild of the final key.
+  const std::string input = "みんあであそぼうよ";
+  KeyCorrector incremental("み", KeyCorrector::ROMAN, 0);
+  std::string key = "み";
+  const char *rest = input.data() + key.size();
+  const char *end = input.data() + input.size();
+  while (rest < end) {
+    size_t mblen = 0;
+    Util::Utf8ToCodepoint(rest, end, &mblen);
+    key.append(rest, mblen);
+    rest += mblen;
+    incremental.UpdateKey(key, KeyCorrector::ROMAN, 0);
+  }
+
+  KeyCorrector full(input, KeyCorrector::ROMAN, 0);
+  EXPECT_EQ(incremental.IsAvailable(), full.IsAvailable());
+  EXPECT_EQ(incremental.corrected_key(), full.corrected_key());
+  EXPECT_EQ(incremental.original_key(), full.original_key());
+  for (size_t pos = 0; pos <= input.size(); ++pos) {
+    EXPECT_EQ(incremental.GetCorrectedPosition(pos),
+              full.GetCorrectedPosition(pos))
+        << pos;
+  }
+
+  // A non-extension falls back to a full correction.
+  incremental.UpdateKey("まったくべつのき", KeyCorrector::ROMAN, 0);
+  KeyCorrector other("まったくべつのき", KeyCorrector::ROMAN, 0);
+  EXPECT_EQ(incremental.corrected_key(), other.corrected_key());
+}
+
 TEST(KeyCorrectorTest, UCS4IsAvailable) {
   {
     const std::string input = "𠮟";  // UCS4 char in UTF8
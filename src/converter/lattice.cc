@@ -156,6 +156,7 @@ void Lattice::SetKey(std::string key) {
   begin_nodes_.resize(size + 4, nullptr);
   end_nodes_.resize(size + 4, nullptr);
   cache_info_.resize(size + 4, 0);
+  viterbi_dirty_.assign(size + 4, true);
 
   end_nodes_[0] = InitBOSNode(this, static_cast<uint16_t>(0));
   begin_nodes_[key_.size()] =
@@ -172,7 +173,10 @@ void Lattice::Insert(size_t pos, Node *node) {
     rnode->cost = 0;
     rnode->enext = end_nodes_[end_pos];
     end_nodes_[end_pos] = rnode;
+    // The inserted node is a new left context for its end boundary.
+    viterbi_dirty_[end_pos] = true;
   }
+  viterbi_dirty_[pos] = true;
 
   if (begin_nodes_[pos] == nullptr) {
     begin_nodes_[pos] = node;
@@ -192,7 +196,9 @@ void Lattice::Clear() {
   begin_nodes_.clear();
   end_nodes_.clear();
   node_allocator_->Free();
+  adopted_allocators_.clear();
   cache_info_.clear();
+  viterbi_dirty_.clear();
   history_end_pos_ = 0;
 }
 
@@ -253,6 +259,12 @@ void Lattice::AddSuffix(const absl::string_view suffix_key) {
   // update cache_info
   cache_info_.resize(new_size + 4, 0);
 
+  // update viterbi_dirty: the suffix positions need relaxation, and the BOS
+  // node was re-created above, so position 0 has to be processed again.
+  viterbi_dirty_.resize(new_size + 4, false);
+  std::fill(viterbi_dirty_.begin() + old_size, viterbi_dirty_.end(), true);
+  viterbi_dirty_[0] = true;
+
   // update key
   absl::StrAppend(&key_, suffix_key);
 }
@@ -299,6 +311,12 @@ void Lattice::ShrinkKey(const size_t new_len) {
   }
   std::fill(cache_info_.begin() + new_len, cache_info_.end(), 0);
 
+  // update viterbi_dirty: positions at and after the new EOS boundary lost
+  // their nodes. Earlier boundaries keep valid annotations because only nodes
+  // ending beyond new_len were erased.
+  std::fill(viterbi_dirty_.begin() + new_len,
+            viterbi_dirty_.begin() + old_len + 1, true);
+
   // update key
   key_.erase(new_len);
 }
@@ -316,7 +334,11 @@ void Lattice::ResetNodeCost() {
         // if the node has ENABLE_CACHE attribute, then revert its wcost.
         // Otherwise, erase the node from the lattice.
         if (node->attributes & Node::ENABLE_CACHE) {
-          node->wcost = node->raw_wcost;
+          if (node->wcost != node->raw_wcost) {
+            node->wcost = node->raw_wcost;
+            // The cost annotation computed for this node is stale now.
+            viterbi_dirty_[i] = true;
+          }
         } else {
           if (node == begin_nodes_[i]) {
             if (node->bnext == nullptr) {
@@ -345,6 +367,8 @@ void Lattice::ResetNodeCost() {
         if (node->attributes & Node::ENABLE_CACHE) {
           node->wcost = node->raw_wcost;
         } else {
+          // The erased node disappears from the left context of boundary i.
+          viterbi_dirty_[i] = true;
           if (node == end_nodes_[i]) {
             if (node->enext == nullptr) {
               end_nodes_[i] = nullptr;
@@ -32,10 +32,12 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/strings/string_view.h"
 #include "base/logging.h"
+#include "converter/key_corrector.h"
 #include "converter/node.h"
 #include "converter/node_allocator.h"
 
@@ -86,6 +88,18 @@ class Lattice {
   // clear all lattice and nodes allocated with NewNode method.
   void Clear();
 
+  // Returns the KeyCorrector cached with this lattice. The converter updates
+  // it incrementally alongside the node lattice (KeyCorrector::UpdateKey), so
+  // per-keystroke conversions do not rebuild the whole correction mapping.
+  KeyCorrector *mutable_key_corrector() { return &key_corrector_; }
+
+  // Takes ownership of an extra allocator whose nodes were inserted into this
+  // lattice (e.g. per-thread allocators of the parallel lattice build). The
+  // adopted allocators, and hence their nodes, live until Clear().
+  void AdoptAllocator(std::unique_ptr<NodeAllocator> allocator) {
+    adopted_allocators_.push_back(std::move(allocator));
+  }
+
   // return true if this instance has a valid lattice.
   bool has_lattice() const { return !begin_nodes_.empty(); }
 
@@ -110,6 +124,19 @@ class Lattice {
     cache_info_[pos] = len;
   }
 
+  // Returns true if the Viterbi annotations (Node::prev and Node::cost) of
+  // nodes beginning at |pos| may be stale and the boundary needs relaxation.
+  bool viterbi_dirty(const size_t pos) const {
+    CHECK_LE(pos, key_.size());
+    return viterbi_dirty_[pos];
+  }
+
+  // setter
+  void set_viterbi_dirty(const size_t pos, const bool dirty) {
+    CHECK_LE(pos, key_.size());
+    viterbi_dirty_[pos] = dirty;
+  }
+
   // revert the wcost of nodes if it has ENABLE_CACHE attribute.
   // This function is needed for wcost may be changed during conversion
   // process for some heuristic methods.
@@ -132,11 +159,21 @@ class Lattice {
   std::vector<Node *> begin_nodes_;
   std::vector<Node *> end_nodes_;
   std::unique_ptr<NodeAllocator> node_allocator_;
+  std::vector<std::unique_ptr<NodeAllocator>> adopted_allocators_;
+  KeyCorrector key_corrector_;
 
   // cache_info_ holds cache information about lookup.
   // If cache_info_[pos] equals to len, it means key.substr(pos, k)
   // (1 <= k <= len) is already looked up.
   std::vector<size_t> cache_info_;
+
+  // viterbi_dirty_[pos] is true if the Viterbi annotations of nodes beginning
+  // at pos have to be (re)computed. Structural changes (Insert, ShrinkKey,
+  // ResetNodeCost) mark the affected boundaries dirty; the converter skips
+  // relaxation of clean boundaries and re-marks the end boundaries of nodes
+  // whose annotations changed. This turns per-keystroke conversion during
+  // composition into work proportional to the changed suffix.
+  std::vector<bool> viterbi_dirty_;
 };
 
 }  // namespace mozc
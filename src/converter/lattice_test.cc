@@ -124,6 +124,48 @@ void InsertNodes(Lattice *lattice) {
 }
 }  // namespace
 
+TEST(LatticeTest, ViterbiDirtyTest) {
+  Lattice lattice;
+
+  lattice.SetKey("test");
+  for (size_t i = 0; i <= 4; ++i) {
+    EXPECT_TRUE(lattice.viterbi_dirty(i)) << i;
+  }
+
+  // Simulate a finished Viterbi run.
+  for (size_t i = 0; i <= 4; ++i) {
+    lattice.set_viterbi_dirty(i, false);
+  }
+
+  // Extending the key dirties the suffix positions and position 0 (the BOS
+  // node is re-created), but keeps the inner prefix boundaries clean.
+  lattice.AddSuffix("ing");
+  EXPECT_TRUE(lattice.viterbi_dirty(0));
+  for (size_t i = 1; i < 4; ++i) {
+    EXPECT_FALSE(lattice.viterbi_dirty(i)) << i;
+  }
+  for (size_t i = 4; i <= 7; ++i) {
+    EXPECT_TRUE(lattice.viterbi_dirty(i)) << i;
+  }
+
+  // Inserting a node dirties its begin and end boundaries.
+  for (size_t i = 0; i <= 7; ++i) {
+    lattice.set_viterbi_dirty(i, false);
+  }
+  Node *node = lattice.NewNode();
+  node->key = "es";
+  node->value = "es";
+  lattice.Insert(1, node);
+  EXPECT_TRUE(lattice.viterbi_dirty(1));
+  EXPECT_FALSE(lattice.viterbi_dirty(2));
+  EXPECT_TRUE(lattice.viterbi_dirty(3));
+
+  // Shrinking the key dirties the new EOS boundary.
+  lattice.ShrinkKey(2);
+  EXPECT_TRUE(lattice.viterbi_dirty(2));
+  EXPECT_FALSE(lattice.viterbi_dirty(0));
+}
+
 TEST(LatticeTest, AddSuffixTest) {
   Lattice lattice;
 
@@ -36,6 +36,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/hash/hash.h"
 #include "base/logging.h"
 #include "base/vlog.h"
 #include "converter/candidate_filter.h"
@@ -59,6 +60,28 @@ using ::mozc::dictionary::SuppressionDictionary;
 constexpr int kFreeListSize = 512;
 constexpr int kCostDiff = 3453;  // log prob of 1/1000
 
+// Base of the polynomial value hash carried by QueueElement.  Prepending a
+// node value v to a suffix s satisfies
+//   H(v + s) = H(v) * B^|s| + H(s)  (mod 2^64),
+// so the hash of the concatenated candidate value is maintainable right to
+// left, independently of how the value is split into nodes.
+constexpr uint64_t kValueHashBase = 0x100000001b3;  // FNV prime
+
+uint64_t ValueHashKey(uint64_t value_hash, uint16_t lid) {
+  return absl::HashOf(value_hash, lid);
+}
+
+uint64_t PolyHash(const absl::string_view value, uint64_t *pow) {
+  uint64_t hash = 0;
+  uint64_t p = 1;
+  for (const char c : value) {
+    hash = hash * kValueHashBase + static_cast<unsigned char>(c);
+    p *= kValueHashBase;
+  }
+  *pow = p;
+  return hash;
+}
+
 }  // namespace
 
 const NBestGenerator::QueueElement *NBestGenerator::CreateNewElement(
@@ -72,6 +95,16 @@ const NBestGenerator::QueueElement *NBestGenerator::CreateNewElement(
   elm->gx = gx;
   elm->structure_gx = structure_gx;
   elm->w_gx = w_gx;
+  if (next == nullptr) {
+    // Chain seed; its node is the right boundary and not part of the value.
+    elm->value_hash = 0;
+    elm->value_pow = 1;
+  } else {
+    uint64_t pow;
+    const uint64_t hash = PolyHash(node->value, &pow);
+    elm->value_hash = hash * next->value_pow + next->value_hash;
+    elm->value_pow = pow * next->value_pow;
+  }
   return elm;
 }
 
@@ -122,6 +155,7 @@ void NBestGenerator::Reset(const Node *begin_node, const Node *end_node,
                            const Options options) {
   agenda_.Clear();
   freelist_.Free();
+  emitted_value_hashes_.clear();
   top_nodes_.clear();
   filter_.Reset();
   viterbi_result_checked_ = false;
@@ -404,11 +438,49 @@ bool NBestGenerator::Next(const ConversionRequest &request,
 
     // reached to the goal.
     if (rnode->end_pos == begin_node_->end_pos) {
+      // Duplicate values are the bulk of deep enumeration.  The incremental
+      // value hash identifies a path whose value was already accepted
+      // without building the candidate; a hash hit is verified against the
+      // filter's seen set before dropping, so a collision merely falls
+      // through to the normal path.
+      if (!(options_.candidate_mode &
+            CandidateMode::BUILD_FROM_ONLY_FIRST_INNER_SEGMENT) &&
+          top->next != nullptr && top->next->next != nullptr &&
+          emitted_value_hashes_.contains(
+              ValueHashKey(top->next->value_hash, top->next->node->lid))) {
+        std::string value;
+        bool bypasses_dedup = false;
+        const QueueElement *last = top->next;
+        for (const QueueElement *elm = top->next; elm->next != nullptr;
+             elm = elm->next) {
+          const Node *node = elm->node;
+          value.append(node->value);
+          // User dictionary and context sensitive (constrained) candidates
+          // are accepted by the filter before its duplicate check, so they
+          // must take the normal path even when their value was seen.
+          bypasses_dedup |= (node->attributes & Node::USER_DICTIONARY) != 0;
+          bypasses_dedup |=
+              node->constrained_prev != nullptr ||
+              (node->next != nullptr && node->next->constrained_prev == node);
+          last = elm;
+        }
+        if (!bypasses_dedup &&
+            filter_.WasSeen(value, top->next->node->lid, last->node->rid)) {
+          continue;
+        }
+      }
+
       const CandidateFilter::ResultType filter_result =
           MakeCandidateFromElement(request, original_key, top, candidate);
 
       switch (filter_result) {
         case CandidateFilter::GOOD_CANDIDATE:
+          if (!(options_.candidate_mode &
+                CandidateMode::BUILD_FROM_ONLY_FIRST_INNER_SEGMENT) &&
+              top->next != nullptr && top->next->next != nullptr) {
+            emitted_value_hashes_.insert(
+                ValueHashKey(top->next->value_hash, top->next->node->lid));
+          }
           return true;
         case CandidateFilter::STOP_ENUMERATION:
           return false;
@@ -686,6 +758,15 @@ int NBestGenerator::InsertTopResult(const ConversionRequest &request,
 
   const int result = filter_.FilterCandidate(request, original_key, candidate,
                                              top_nodes_, top_nodes_);
+  if (result == CandidateFilter::GOOD_CANDIDATE &&
+      !(options_.candidate_mode &
+        CandidateMode::BUILD_FROM_ONLY_FIRST_INNER_SEGMENT)) {
+    // Register the top value so agenda paths reproducing it are cut early;
+    // PolyHash over the whole value equals the chain hash by construction.
+    uint64_t pow;
+    emitted_value_hashes_.insert(
+        ValueHashKey(PolyHash(candidate->value, &pow), candidate->lid));
+  }
   return result;
 }
 
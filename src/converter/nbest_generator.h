@@ -34,6 +34,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_set.h"
 #include "base/container/freelist.h"
 #include "converter/candidate_filter.h"
 #include "converter/connector.h"
@@ -122,6 +123,13 @@ class NBestGenerator {
   struct QueueElement {
     const Node *node;
     const QueueElement *next;
+    // Polynomial hash (and the matching length power) of the concatenated
+    // values of [this node .. the node before the chain's seed], maintained
+    // incrementally on push.  Two elements with equal hashes almost surely
+    // complete into equal candidate values regardless of segmentation, which
+    // lets Next() drop already-seen values before building the candidate.
+    uint64_t value_hash;
+    uint64_t value_pow;
     // f(x) = h(x) + g(x): cost function for A* search
     int32_t fx;
     // g(x): current cost
@@ -212,6 +220,9 @@ class NBestGenerator {
 
   Agenda agenda_;
   FreeList<QueueElement> freelist_;
+  // Advisory set of value hashes of the candidates accepted in this
+  // generation; a hit is verified against the filter before dropping.
+  absl::flat_hash_set<uint64_t> emitted_value_hashes_;
   std::vector<const Node *> top_nodes_;
   converter::CandidateFilter filter_;
   bool viterbi_result_checked_ = false;
@@ -68,6 +68,9 @@ struct Node {
     // Node should have the same information as Candidate.
     PARTIALLY_KEY_CONSUMED = 1 << 7,
     SUFFIX_DICTIONARY = 1 << 8,  // Suffix dictionary
+    // Inserted by KeyCorrector; must be skipped when decoding under
+    // user-adjusted boundaries (see b/2804996).
+    KEY_CORRECTED = 1 << 9,
   };
 
   // prev and next are linking pointers to connect minimum cost path
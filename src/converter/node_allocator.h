@@ -30,6 +30,8 @@
 #ifndef MOZC_CONVERTER_NODE_ALLOCATOR_H_
 #define MOZC_CONVERTER_NODE_ALLOCATOR_H_
 
+#include <algorithm>
+
 #include "base/container/freelist.h"
 #include "base/logging.h"
 #include "converter/node.h"
@@ -51,9 +53,13 @@ class NodeAllocator {
     return node;
   }
 
-  // Frees all nodes allocateed by NewNode().
+  // Frees all nodes allocateed by NewNode() in O(1). The node memory is kept
+  // and recycled in allocation order by subsequent NewNode() calls (which
+  // re-initialize the nodes via Node::Init), so consecutive conversions reuse
+  // warm, physically contiguous chunks instead of re-allocating them.
   void Free() {
-    node_freelist_.Free();
+    peak_node_count_ = std::max(peak_node_count_, node_count_);
+    node_freelist_.Reset();
     node_count_ = 0;
   }
 
@@ -65,10 +71,17 @@ class NodeAllocator {
 
   size_t node_count() const { return node_count_; }
 
+  // Largest number of nodes ever allocated between two Free() calls; useful
+  // for sizing the arena.
+  size_t peak_node_count() const {
+    return std::max(peak_node_count_, node_count_);
+  }
+
  private:
   FreeList<Node> node_freelist_;
   size_t max_nodes_size_;
   size_t node_count_;
+  size_t peak_node_count_ = 0;
 };
 
 }  // namespace mozc
@@ -27,20 +27,34 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/flags/flag.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
 #include "base/file/temp_dir.h"
+#include "base/file_stream.h"
+#include "base/hash.h"
 #include "base/init_mozc.h"
 #include "base/logging.h"
 #include "base/system_util.h"
+#include "base/thread.h"
 #include "converter/quality_regression_util.h"
 #include "engine/engine.h"
 #include "engine/eval_engine_factory.h"
@@ -50,29 +64,187 @@ ABSL_FLAG(std::string, data_file, "", "engine data file");
 ABSL_FLAG(std::string, data_type, "", "engine data type");
 ABSL_FLAG(std::string, engine_type, "desktop", "engine type");
 ABSL_FLAG(std::string, output, "", "output file");
+ABSL_FLAG(int32_t, num_threads, 1,
+          "Number of conversion workers. Each worker drives its own engine "
+          "instance over a contiguous shard of the corpus, and results merge "
+          "in corpus order, so the output is byte-identical for any thread "
+          "count as long as items are self-contained. (Commands that commit "
+          "also learn; an item depending on state learned from an earlier "
+          "corpus line may evaluate differently than in a serial run.)");
+ABSL_FLAG(std::string, cache_file, "",
+          "Result cache across runs: (data version, engine type, test line) "
+          "pairs that were already converted are reused without conversion. "
+          "The file is rewritten with the merged cache after the run. The "
+          "same self-containment caveat as --num_threads applies: cached "
+          "items do not replay their learning side effects.");
 
 namespace {
 
 using ::mozc::Engine;
+using ::mozc::Fingerprint;
 using ::mozc::TempDirectory;
+using ::mozc::Thread;
 using ::mozc::quality_regression::QualityRegressionUtil;
 
+struct Result {
+  bool ok;
+  std::string actual_value;
+};
+
+// One output line, identical to the historical serial format.
+void PrintResult(const QualityRegressionUtil::TestItem &item,
+                 const Result &result, std::ostream &out) {
+  out << (result.ok ? "OK:\t" : "FAILED:\t") << item.key << "\t"
+      << result.actual_value << "\t" << item.command;
+  if (item.expected_rank != 0) {
+    out << " " << item.expected_rank;
+  }
+  out << "\t" << item.expected_value << "\t" << std::endl;
+}
+
+// The cache key covers everything that determines a conversion result here:
+// the engine data version, the engine type, and the full test line.
+uint64_t CacheFingerprint(const absl::string_view cache_salt,
+                          const QualityRegressionUtil::TestItem &item) {
+  return Fingerprint(absl::StrCat(cache_salt, "\n", item.OutputAsTSV()));
+}
+
+absl::flat_hash_map<uint64_t, Result> LoadCache(const std::string &filename) {
+  absl::flat_hash_map<uint64_t, Result> cache;
+  mozc::InputFileStream ifs(filename);
+  if (!ifs) {
+    // Missing cache is the cold-run case.
+    return cache;
+  }
+  std::string line;
+  while (std::getline(ifs, line)) {
+    const std::vector<absl::string_view> fields =
+        absl::StrSplit(line, '\t');
+    uint64_t fingerprint = 0;
+    if (fields.size() != 3 ||
+        !absl::SimpleAtoi(fields[0], &fingerprint)) {
+      continue;  // Skip unparsable lines; they just miss the cache.
+    }
+    std::string actual_value;
+    if (!absl::CUnescape(fields[2], &actual_value)) {
+      continue;
+    }
+    cache[fingerprint] = Result{fields[1] == "1", std::move(actual_value)};
+  }
+  return cache;
+}
+
+void SaveCache(const std::string &filename,
+               const absl::flat_hash_map<uint64_t, Result> &cache) {
+  mozc::OutputFileStream ofs(filename);
+  if (!ofs) {
+    LOG(ERROR) << "Cannot write cache file: " << filename;
+    return;
+  }
+  for (const auto &[fingerprint, result] : cache) {
+    ofs << fingerprint << '\t' << (result.ok ? 1 : 0) << '\t'
+        << absl::CEscape(result.actual_value) << '\n';
+  }
+}
+
+// Converts items[index] for every index in |shard| on an engine owned by the
+// caller, writing into the shared |results| array (disjoint slots).
+absl::Status RunShard(const Engine &engine,
+                      const std::vector<QualityRegressionUtil::TestItem> &items,
+                      const std::vector<size_t> &shard,
+                      std::vector<std::optional<Result>> *results) {
+  QualityRegressionUtil util(engine.GetConverter());
+  for (const size_t index : shard) {
+    Result result;
+    const absl::StatusOr<bool> status_or =
+        util.ConvertAndTest(items[index], &result.actual_value);
+    if (!status_or.ok()) {
+      return status_or.status();
+    }
+    result.ok = *status_or;
+    (*results)[index] = std::move(result);
+  }
+  return absl::OkStatus();
+}
+
 absl::Status Run(std::ostream &out, const Engine &engine,
                  const std::vector<QualityRegressionUtil::TestItem> &items) {
-  QualityRegressionUtil util(engine.GetConverter());
-  for (const QualityRegressionUtil::TestItem &item : items) {
-    std::string actual_value;
-    const absl::StatusOr<bool> result =
-        util.ConvertAndTest(item, &actual_value);
-    if (!result.ok()) {
-      return result.status();
+  const std::string cache_filename = absl::GetFlag(FLAGS_cache_file);
+  absl::flat_hash_map<uint64_t, Result> cache;
+  if (!cache_filename.empty()) {
+    cache = LoadCache(cache_filename);
+  }
+  const std::string cache_salt =
+      absl::StrCat(engine.GetDataVersion(), "\t",
+                   absl::GetFlag(FLAGS_engine_type));
+
+  // Resolve cache hits and collect the indices still needing conversion.
+  std::vector<std::optional<Result>> results(items.size());
+  std::vector<size_t> pending;
+  for (size_t i = 0; i < items.size(); ++i) {
+    if (cache_filename.empty()) {
+      pending.push_back(i);
+      continue;
+    }
+    const auto it = cache.find(CacheFingerprint(cache_salt, items[i]));
+    if (it != cache.end()) {
+      results[i] = it->second;
+    } else {
+      pending.push_back(i);
+    }
+  }
+
+  // Shard the pending conversions contiguously over the workers. Worker 0
+  // reuses the caller's engine; the others own one engine each, since one
+  // engine must not convert concurrently.
+  const size_t num_threads = std::max<int32_t>(
+      1, std::min<int32_t>(absl::GetFlag(FLAGS_num_threads), 64));
+  std::vector<std::vector<size_t>> shards(num_threads);
+  for (size_t i = 0; i < pending.size(); ++i) {
+    shards[i * num_threads / pending.size()].push_back(pending[i]);
+  }
+
+
+  std::vector<absl::Status> statuses(num_threads, absl::OkStatus());
+  {
+    std::vector<Thread> workers;
+    for (size_t worker = 1; worker < num_threads; ++worker) {
+      if (shards[worker].empty()) {
+        continue;
+      }
+      workers.emplace_back([&, worker] {
+        absl::StatusOr<std::unique_ptr<Engine>> worker_engine =
+            mozc::CreateEvalEngine(absl::GetFlag(FLAGS_data_file),
+                                   absl::GetFlag(FLAGS_data_type),
+                                   absl::GetFlag(FLAGS_engine_type));
+        if (!worker_engine.ok()) {
+          statuses[worker] = worker_engine.status();
+          return;
+        }
+        statuses[worker] =
+            RunShard(**worker_engine, items, shards[worker], &results);
+      });
+    }
+    statuses[0] = RunShard(engine, items, shards[0], &results);
+    for (Thread &thread : workers) {
+      thread.Join();
     }
-    out << (result.value() ? "OK:\t" : "FAILED:\t") << item.key << "\t"
-        << actual_value << "\t" << item.command;
-    if (item.expected_rank != 0) {
-      out << " " << item.expected_rank;
+  }
+  for (const absl::Status &status : statuses) {
+    if (!status.ok()) {
+      return status;
     }
-    out << "\t" << item.expected_value << "\t" << std::endl;
+  }
+
+  // Deterministic merge: corpus order, independent of sharding and caching.
+  for (size_t i = 0; i < items.size(); ++i) {
+    PrintResult(items[i], *results[i], out);
+    if (!cache_filename.empty()) {
+      cache[CacheFingerprint(cache_salt, items[i])] = *results[i];
+    }
+  }
+  if (!cache_filename.empty()) {
+    SaveCache(cache_filename, cache);
   }
   return absl::OkStatus();
 }
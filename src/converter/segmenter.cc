@@ -32,6 +32,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "base/container/bitarray.h"
 #include "base/logging.h"
@@ -45,20 +46,25 @@ std::unique_ptr<Segmenter> Segmenter::CreateFromDataManager(
   size_t l_num_elements = 0;
   size_t r_num_elements = 0;
   const uint16_t *l_table = nullptr;
+  size_t l_table_size = 0;
   const uint16_t *r_table = nullptr;
+  size_t r_table_size = 0;
   size_t bitarray_num_bytes = 0;
   const char *bitarray_data = nullptr;
   const uint16_t *boundary_data = nullptr;
   data_manager.GetSegmenterData(&l_num_elements, &r_num_elements, &l_table,
-                                &r_table, &bitarray_num_bytes, &bitarray_data,
+                                &l_table_size, &r_table, &r_table_size,
+                                &bitarray_num_bytes, &bitarray_data,
                                 &boundary_data);
   return std::make_unique<Segmenter>(l_num_elements, r_num_elements, l_table,
-                                     r_table, bitarray_num_bytes, bitarray_data,
+                                     l_table_size, r_table, r_table_size,
+                                     bitarray_num_bytes, bitarray_data,
                                      boundary_data);
 }
 
 Segmenter::Segmenter(size_t l_num_elements, size_t r_num_elements,
-                     const uint16_t *l_table, const uint16_t *r_table,
+                     const uint16_t *l_table, size_t l_table_size,
+                     const uint16_t *r_table, size_t r_table_size,
                      size_t bitarray_num_bytes, const char *bitarray_data,
                      const uint16_t *boundary_data)
     : l_num_elements_(l_num_elements),
@@ -73,6 +79,17 @@ Segmenter::Segmenter(size_t l_num_elements, size_t r_num_elements,
   DCHECK(bitarray_data_);
   DCHECK(boundary_data_);
   CHECK_LE(l_num_elements_ * r_num_elements_, bitarray_num_bytes_ * 8);
+
+  // Fuse the id-to-group indirections into two compact per-id offset tables
+  // so that the hot IsBoundary(rid, lid) does two narrow loads and a bit
+  // probe, with no multiply. Frequent POS ids are small, so the hot entries
+  // of both tables cluster in the first few cache lines.
+  l_bit_offset_.assign(l_table, l_table + l_table_size);
+  r_bit_offset_.reserve(r_table_size);
+  for (size_t lid = 0; lid < r_table_size; ++lid) {
+    r_bit_offset_.push_back(
+        static_cast<uint32_t>(l_num_elements_ * r_table[lid]));
+  }
 }
 
 bool Segmenter::IsBoundary(const Node &lnode, const Node &rnode,
@@ -103,8 +120,9 @@ bool Segmenter::IsBoundary(const Node &lnode, const Node &rnode,
 }
 
 bool Segmenter::IsBoundary(uint16_t rid, uint16_t lid) const {
-  const uint32_t bitarray_index =
-      l_table_[rid] + l_num_elements_ * r_table_[lid];
+  DCHECK_LT(rid, l_bit_offset_.size());
+  DCHECK_LT(lid, r_bit_offset_.size());
+  const uint32_t bitarray_index = l_bit_offset_[rid] + r_bit_offset_[lid];
   return BitArray::GetValue(bitarray_data_, bitarray_index);
 }
 
@@ -33,6 +33,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "converter/node.h"
 #include "data_manager/data_manager_interface.h"
@@ -45,8 +46,11 @@ class Segmenter {
       const DataManagerInterface &data_manager);
 
   // This class does not take the ownership of pointer parameters.
+  // |l_table| and |r_table| map POS ids to compressed group ids and have
+  // |l_table_size| / |r_table_size| entries respectively.
   Segmenter(size_t l_num_elements, size_t r_num_elements,
-            const uint16_t *l_table, const uint16_t *r_table,
+            const uint16_t *l_table, size_t l_table_size,
+            const uint16_t *r_table, size_t r_table_size,
             size_t bitarray_num_bytes, const char *bitarray_data,
             const uint16_t *boundary_data);
   Segmenter(const Segmenter &) = delete;
@@ -66,6 +70,13 @@ class Segmenter {
   const size_t bitarray_num_bytes_;
   const char *bitarray_data_;
   const uint16_t *boundary_data_;
+
+  // Per-id bitarray offsets precomputed from the group tables:
+  //   index = l_bit_offset_[rid] + r_bit_offset_[lid]
+  // l_bit_offset_ keeps the narrow group id as-is; r_bit_offset_ folds in the
+  // row stride so the lookup needs no multiply.
+  std::vector<uint16_t> l_bit_offset_;
+  std::vector<uint32_t> r_bit_offset_;
 };
 
 }  // namespace mozc
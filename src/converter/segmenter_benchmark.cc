@@ -0,0 +1,59 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Microbenchmark of Segmenter::IsBoundary over the mock data manager.
+//
+// Run: bazel run -c opt //converter:segmenter_benchmark
+
+#include <cstdint>
+#include <memory>
+
+#include "benchmark/benchmark.h"
+#include "converter/segmenter.h"
+#include "data_manager/testing/mock_data_manager.h"
+
+namespace mozc {
+namespace {
+
+void BM_IsBoundary(benchmark::State &state) {
+  const testing::MockDataManager data_manager;
+  const std::unique_ptr<Segmenter> segmenter =
+      Segmenter::CreateFromDataManager(data_manager);
+  uint32_t x = 123456789;
+  for (auto _ : state) {
+    x = x * 1103515245 + 12345;
+    const uint16_t rid = (x >> 16) % 100;
+    const uint16_t lid = (x >> 8) % 100;
+    benchmark::DoNotOptimize(segmenter->IsBoundary(rid, lid));
+  }
+}
+BENCHMARK(BM_IsBoundary);
+
+}  // namespace
+}  // namespace mozc
@@ -0,0 +1,110 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// Microbenchmark for Segmenter::IsBoundary on the conversion hot path.
+//
+// Usage:
+//   segmenter_benchmark_main --engine_data_path=/path/to/mozc.data
+//
+// Measures boundary checks over pseudo-random (rid, lid) pairs drawn from the
+// id space of the loaded data, which approximates the access pattern of the
+// Viterbi loop in immutable_converter.cc.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/log/check.h"
+#include "absl/random/random.h"
+#include "absl/status/statusor.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "base/init_mozc.h"
+#include "converter/segmenter.h"
+#include "data_manager/data_manager.h"
+
+ABSL_FLAG(std::string, engine_data_path, "", "path to data file");
+ABSL_FLAG(uint64_t, iterations, 10000000, "number of IsBoundary calls");
+
+int main(int argc, char **argv) {
+  mozc::InitMozc(argv[0], &argc, &argv);
+
+  CHECK(!absl::GetFlag(FLAGS_engine_data_path).empty())
+      << "--engine_data_path is required";
+  absl::StatusOr<std::unique_ptr<mozc::DataManager>> data_manager =
+      mozc::DataManager::CreateFromFile(absl::GetFlag(FLAGS_engine_data_path));
+  CHECK_OK(data_manager);
+
+  std::unique_ptr<mozc::Segmenter> segmenter =
+      mozc::Segmenter::CreateFromDataManager(**data_manager);
+
+  size_t l_num_elements = 0, r_num_elements = 0;
+  const uint16_t *l_table = nullptr;
+  size_t l_table_size = 0;
+  const uint16_t *r_table = nullptr;
+  size_t r_table_size = 0;
+  size_t bitarray_num_bytes = 0;
+  const char *bitarray_data = nullptr;
+  const uint16_t *boundary_data = nullptr;
+  (*data_manager)
+      ->GetSegmenterData(&l_num_elements, &r_num_elements, &l_table,
+                         &l_table_size, &r_table, &r_table_size,
+                         &bitarray_num_bytes, &bitarray_data, &boundary_data);
+
+  // Pre-generate the id pairs so the measured loop contains only the lookup.
+  const uint64_t iterations = absl::GetFlag(FLAGS_iterations);
+  constexpr size_t kNumPairs = 1 << 16;
+  std::vector<std::pair<uint16_t, uint16_t>> pairs;
+  pairs.reserve(kNumPairs);
+  absl::BitGen gen;
+  for (size_t i = 0; i < kNumPairs; ++i) {
+    pairs.emplace_back(absl::Uniform<uint16_t>(gen, 0, l_table_size),
+                       absl::Uniform<uint16_t>(gen, 0, r_table_size));
+  }
+
+  uint64_t num_boundaries = 0;
+  const absl::Time start = absl::Now();
+  for (uint64_t i = 0; i < iterations; ++i) {
+    const auto &[rid, lid] = pairs[i & (kNumPairs - 1)];
+    num_boundaries += segmenter->IsBoundary(rid, lid) ? 1 : 0;
+  }
+  const absl::Duration elapsed = absl::Now() - start;
+
+  std::cout << "iterations: " << iterations << std::endl;
+  std::cout << "boundaries: " << num_boundaries << std::endl;
+  std::cout << "total: " << elapsed << std::endl;
+  std::cout << "per call: " << (elapsed / iterations) << std::endl;
+  return 0;
+}
@@ -244,22 +244,44 @@ Segment &Segment::operator=(const Segment &x) {
 }
 
 void Segment::clear_candidates() {
-  pool_.clear();
+  // Candidate objects are kept in pool_ for recycling: NewCandidate hands
+  // them out again with their string capacities intact, which avoids
+  // re-allocating the many small strings of candidates on every conversion.
+  pool_used_ = 0;
   candidates_.clear();
 }
 
-Segment::Candidate *Segment::push_back_candidate() {
-  auto candidate = std::make_unique<Candidate>();
+Segment::Candidate *Segment::NewCandidate() {
+  if (pool_used_ < pool_.size()) {
+    Candidate *candidate = pool_[pool_used_++].get();
+    candidate->Clear();
+    return candidate;
+  }
+  Candidate *candidate =
+      pool_.emplace_back(std::make_unique<Candidate>()).get();
+  pool_used_ = pool_.size();
+  return candidate;
+}
+
+Segment::Candidate *Segment::AdoptCandidate(
+    std::unique_ptr<Candidate> candidate) {
+  // Keep the invariant that [0, pool_used_) are the objects in use: the
+  // adopted candidate becomes part of the in-use prefix and the recyclable
+  // objects shift right.
   Candidate *ptr = candidate.get();
-  pool_.push_back(std::move(candidate));
+  pool_.insert(pool_.begin() + pool_used_, std::move(candidate));
+  ++pool_used_;
+  return ptr;
+}
+
+Segment::Candidate *Segment::push_back_candidate() {
+  Candidate *ptr = NewCandidate();
   candidates_.push_back(ptr);
   return ptr;
 }
 
 Segment::Candidate *Segment::push_front_candidate() {
-  auto candidate = std::make_unique<Candidate>();
-  Candidate *ptr = candidate.get();
-  pool_.push_back(std::move(candidate));
+  Candidate *ptr = NewCandidate();
   candidates_.push_front(ptr);
   return ptr;
 }
@@ -275,14 +297,13 @@ Segment::Candidate *Segment::insert_candidate(int i) {
                 << candidates_.size();
     i = static_cast<int>(candidates_.size());
   }
-  Candidate *candidate =
-      pool_.emplace_back(std::make_unique<Candidate>()).get();
+  Candidate *candidate = NewCandidate();
   candidates_.insert(candidates_.begin() + i, candidate);
   return candidate;
 }
 
 void Segment::insert_candidate(int i, std::unique_ptr<Candidate> candidate) {
-  Candidate *cand_ptr = pool_.emplace_back(std::move(candidate)).get();
+  Candidate *cand_ptr = AdoptCandidate(std::move(candidate));
   if (i <= 0) {
     candidates_.push_front(cand_ptr);
   } else if (i >= static_cast<int>(candidates_.size())) {
@@ -308,8 +329,10 @@ void Segment::insert_candidates(
     candidates_[i++] = candidate.get();
   }
 
-  pool_.insert(pool_.end(), std::make_move_iterator(candidates.begin()),
+  pool_.insert(pool_.begin() + pool_used_,
+               std::make_move_iterator(candidates.begin()),
                std::make_move_iterator(candidates.end()));
+  pool_used_ += candidates.size();
 }
 
 void Segment::pop_front_candidate() {
@@ -403,12 +426,12 @@ void Segment::Clear() {
 }
 
 void Segment::DeepCopyCandidates(const std::deque<Candidate *> &candidates) {
-  DCHECK(pool_.empty());
+  DCHECK(candidates_.empty());
   pool_.reserve(candidates.size());
   for (const Candidate *cand : candidates) {
-    auto new_cand = std::make_unique<Candidate>(*cand);
-    candidates_.push_back(new_cand.get());
-    pool_.push_back(std::move(new_cand));
+    Candidate *new_cand = NewCandidate();
+    *new_cand = *cand;
+    candidates_.push_back(new_cand);
   }
 }
 
@@ -535,6 +558,7 @@ void Segments::erase_segment(size_t i) {
 }
 
 Segments::iterator Segments::erase_segment(iterator position) {
+  converter_state_.reset();
   pool_.Release(&*position);
   return iterator{segments_.erase(position.iterator_)};
 }
@@ -548,6 +572,7 @@ void Segments::erase_segments(size_t i, size_t size) {
 }
 
 Segments::iterator Segments::erase_segments(iterator first, iterator last) {
+  converter_state_.reset();
   for (auto it = first; it != last; ++it) {
     pool_.Release(&*it);
   }
@@ -556,6 +581,7 @@ Segments::iterator Segments::erase_segments(iterator first, iterator last) {
 
 void Segments::pop_front_segment() {
   if (!segments_.empty()) {
+    converter_state_.reset();
     Segment *seg = segments_.front();
     pool_.Release(seg);
     segments_.pop_front();
@@ -564,6 +590,7 @@ void Segments::pop_front_segment() {
 
 void Segments::pop_back_segment() {
   if (!segments_.empty()) {
+    converter_state_.reset();
     Segment *seg = segments_.back();
     pool_.Release(seg);
     segments_.pop_back();
@@ -576,7 +603,11 @@ void Segments::Clear() {
 }
 
 void Segments::clear_segments() {
-  pool_.Free();
+  converter_state_.reset();
+  // Clear-not-free: the pooled Segment objects stay constructed, so their
+  // candidate pools and string capacity are warm for the next conversion
+  // cycle; add_segment and friends re-initialize them with Segment::Clear.
+  pool_.Reset();
   resized_ = false;
   segments_.clear();
 }
@@ -324,7 +324,7 @@ class Segment final {
     }
   };
 
-  Segment() : segment_type_(FREE), pool_(kCandidatesPoolSize) {}
+  Segment() : segment_type_(FREE) { pool_.reserve(kCandidatesPoolSize); }
 
   Segment(const Segment &x);
   Segment &operator=(const Segment &x);
@@ -409,6 +409,13 @@ class Segment final {
  private:
   void DeepCopyCandidates(const std::deque<Candidate *> &candidates);
 
+  // Returns a cleared candidate, recycling an object from pool_ when one is
+  // available. Recycled candidates keep the capacity of their string members.
+  Candidate *NewCandidate();
+
+  // Adopts an externally created candidate into the in-use prefix of pool_.
+  Candidate *AdoptCandidate(std::unique_ptr<Candidate> candidate);
+
   static constexpr int kCandidatesPoolSize = 16;
 
   // LINT.IfChange
@@ -423,7 +430,11 @@ class Segment final {
   std::string key_;
   std::deque<Candidate *> candidates_;
   std::vector<Candidate> meta_candidates_;
+  // Owns the candidate objects. The prefix [0, pool_used_) is in use (linked
+  // from candidates_); the rest are kept for recycling by NewCandidate after
+  // clear_candidates.
   std::vector<std::unique_ptr<Candidate>> pool_;
+  size_t pool_used_ = 0;
   // LINT.ThenChange(//converter/segments_matchers.h)
 };
 
@@ -599,6 +610,15 @@ class Segments final {
   using range = Range<iterator>;
   using const_range = Range<const_iterator>;
 
+  // Base class for opaque per-conversion state owned by the converter layer
+  // but living with the Segments, e.g. the resumable n-best agenda used for
+  // candidate paging (see ImmutableConverter::ExtendCandidates). The state is
+  // dropped whenever the segment structure changes.
+  class ConverterState {
+   public:
+    virtual ~ConverterState() = default;
+  };
+
   // constructors
   Segments()
       : max_history_segments_size_(0),
@@ -706,6 +726,11 @@ class Segments final {
   // setter
   Lattice *mutable_cached_lattice() { return &cached_lattice_; }
 
+  ConverterState *converter_state() const { return converter_state_.get(); }
+  void set_converter_state(std::unique_ptr<ConverterState> state) {
+    converter_state_ = std::move(state);
+  }
+
  private:
   FRIEND_TEST(SegmentsTest, BasicTest);
 
@@ -720,6 +745,8 @@ class Segments final {
   std::deque<Segment *> segments_;
   std::vector<RevertEntry> revert_entries_;
   Lattice cached_lattice_;
+  // Not copied, like cached_lattice_; reset on structural changes.
+  std::unique_ptr<ConverterState> converter_state_;
   // LINT.ThenChange(//converter/segments_matchers.h)
 };
 
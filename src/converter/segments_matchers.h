@@ -205,10 +205,11 @@ MATCHER_P(ContainsCandidate, matcher, "") {
 }
 
 // Checks if a segments exactly matches the given segments except for the
-// following three fields:
+// following four fields:
 //   * pool_
 //   * revert_entries_
 //   * cached_lattice_
+//   * converter_state_
 // Note: this is more useful than defining operator==() in testing as it can
 // display which field is different.
 //
@@ -55,6 +55,31 @@ static std::vector<std::string> ToKeys(const T &segments) {
   return keys;
 }
 
+TEST(SegmentsTest, ClearRetainsPooledSegments) {
+  Segments segments;
+  std::vector<Segment *> first_round;
+  for (int i = 0; i < 8; ++i) {
+    Segment *seg = segments.add_segment();
+    seg->set_key("key");
+    Segment::Candidate *candidate = seg->add_candidate();
+    candidate->value = "value";
+    first_round.push_back(seg);
+  }
+
+  segments.Clear();
+  EXPECT_EQ(segments.segments_size(), 0);
+
+  // Clear keeps the pooled Segment objects constructed; the next cycle gets
+  // the same objects back, re-initialized, so their internal capacity is
+  // reused instead of reallocated.
+  for (int i = 0; i < 8; ++i) {
+    Segment *seg = segments.add_segment();
+    EXPECT_EQ(seg, first_round[i]);
+    EXPECT_TRUE(seg->key().empty());
+    EXPECT_EQ(seg->candidates_size(), 0);
+  }
+}
+
 TEST(SegmentsTest, BasicTest) {
   Segments segments;
 
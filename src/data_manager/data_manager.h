@@ -104,6 +104,14 @@ class DataManager : public DataManagerInterface {
 
   // Implementation of DataManagerInterface.
   std::optional<std::string> GetFilename() const override { return filename_; }
+
+  // Issues advisory page hints for the sections on the conversion critical
+  // path (connection matrix, system dictionary, segmenter): the kernel is
+  // asked to prefetch them so the first keystroke does not page them in
+  // serially. The rarely used sections (usage, zip code, emoticon, ...) are
+  // left to fault in on first real access. Best effort; no-op where madvise
+  // is unavailable.
+  void PreloadCriticalSections() const override;
   const uint16_t *GetPosMatcherData() const override;
   void GetUserPosData(absl::string_view *token_array_data,
                       absl::string_view *string_array_data) const override;
@@ -114,7 +122,8 @@ class DataManager : public DataManagerInterface {
   absl::Span<const uint32_t> GetSuggestionFilterData() const override;
   const uint8_t *GetPosGroupData() const override;
   void GetSegmenterData(size_t *l_num_elements, size_t *r_num_elements,
-                        const uint16_t **l_table, const uint16_t **r_table,
+                        const uint16_t **l_table, size_t *l_table_size,
+                        const uint16_t **r_table, size_t *r_table_size,
                         size_t *bitarray_num_bytes, const char **bitarray_data,
                         const uint16_t **boundary_data) const override;
   void GetCounterSuffixSortedArray(const char **array,
@@ -167,8 +176,42 @@ class DataManager : public DataManagerInterface {
  private:
   Status InitFromReader(const DataSetReader &reader);
 
+  // If --hugepage_data_sections is set, copies the hottest sections
+  // (dictionary tries and connection matrix) into an anonymous mapping
+  // advised to use transparent huge pages and repoints the section views at
+  // the copy; called at the end of InitFromReader. No-op where
+  // madvise(MADV_HUGEPAGE) does not exist.
+  void MaybeRelocateHotSectionsToHugePages();
+
+ public:
+  // Declared access characteristics of the data sections, used to drive the
+  // startup features — huge page relocation and madvise prefetch hints —
+  // from one place instead of per-section special cases.
+  enum class SectionAccess {
+    kRandomHot,   // Random probes on the conversion hot path.
+    kSequential,  // Read once, typically at some module's (lazy) init.
+    kCold,        // Untouched in most sessions; leave fully demand-paged.
+  };
+  struct SectionInfo {
+    absl::string_view name;
+    const absl::string_view *data;  // Points at the section's view member.
+    SectionAccess access;
+  };
+  // Registry of the sections and their access declarations, hot first.
+  // The views become valid after InitFromArray.
+  std::vector<SectionInfo> GetSectionRegistry() const;
+
+ private:
+  // Applies the access declarations from GetSectionRegistry to the mapping:
+  // prefetch and random-access hints for the hot sections.  Opt-in via
+  // --madvise_data_sections; see the flag description.
+  void MaybeAdviseSections();
+
   std::optional<std::string> filename_ = std::nullopt;
   Mmap mmap_;
+  // Huge-page-advised copies of the hot sections; see
+  // MaybeRelocateHotSectionsToHugePages.
+  Mmap hugepage_sections_;
   absl::string_view pos_matcher_data_;
   absl::string_view user_pos_token_array_data_;
   absl::string_view user_pos_string_array_data_;
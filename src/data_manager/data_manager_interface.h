@@ -70,9 +70,14 @@ class DataManagerInterface {
   virtual void GetConnectorData(const char **data, size_t *size) const = 0;
 
   // Returns the addresses and their sizes necessary to create a segmenter.
+  // Issues advisory page hints for the data sections on the conversion
+  // critical path so that they are prefetched instead of faulting in
+  // serially on the first keystroke. Best effort; the default does nothing.
+  virtual void PreloadCriticalSections() const {}
+
   virtual void GetSegmenterData(size_t *l_num_elements, size_t *r_num_elements,
-                                const uint16_t **l_table,
-                                const uint16_t **r_table,
+                                const uint16_t **l_table, size_t *l_table_size,
+                                const uint16_t **r_table, size_t *r_table_size,
                                 size_t *bitarray_num_bytes,
                                 const char **bitarray_data,
                                 const uint16_t **boundary_data) const = 0;
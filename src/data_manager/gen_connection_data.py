@@ -104,6 +104,18 @@ def ParseConnectionFile(text_connection_file, pos_size, special_pos_size):
   return matrix
 
 
+# Encoding note (evaluated on the oss data set, 2662x2662 cells): a
+# "quantized per-row delta" encoding -- row base value plus bit-packed small
+# deltas with exceptions -- was measured against this generator's output and
+# does not work losslessly on the real matrix.  87.6% of cells equal the row
+# mode (which the mode-value scheme below already stores for free); of the
+# remaining 876k cells, only 45 are within int8 of the row mode and 7.3%
+# within int8 of the row's non-default median, and cost values show no
+# residue structure (uniform mod-8 histogram), so byte deltas almost always
+# need a 2-byte exception and the result is ~33% LARGER than the current
+# encoding.  For memory-constrained targets the lossy variant of this idea
+# already exists: --use_1byte_cost quantizes costs to RESOLUTION_FOR_1BYTE
+# and stores one byte per non-default cell.
 def CreateModeValueList(matrix):
   """Create a list of modes of each row."""
   result = []
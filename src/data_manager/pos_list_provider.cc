@@ -51,24 +51,28 @@ namespace {
 
 }  // namespace
 
-PosListProvider::PosListProvider() {
-  SerializedStringArray array;
-  CHECK(array.Init(LoadEmbeddedFile(kPosArray)));
+void PosListProvider::EnsureInitialized() const {
+  absl::call_once(once_, [this]() {
+    SerializedStringArray array;
+    CHECK(array.Init(LoadEmbeddedFile(kPosArray)));
 
-  pos_list_.reserve(array.size());
-  for (absl::string_view pos : array) {
-    if (pos == "名詞") {
-      pos_list_default_index_ = pos_list_.size();
+    pos_list_.reserve(array.size());
+    for (absl::string_view pos : array) {
+      if (pos == "名詞") {
+        pos_list_default_index_ = pos_list_.size();
+      }
+      pos_list_.push_back({pos.data(), pos.size()});
     }
-    pos_list_.push_back({pos.data(), pos.size()});
-  }
+  });
 }
 
 std::vector<std::string> PosListProvider::GetPosList() const {
+  EnsureInitialized();
   return pos_list_;
 }
 
 int PosListProvider::GetPosListDefaultIndex() const {
+  EnsureInitialized();
   return pos_list_default_index_;
 }
 
@@ -33,20 +33,28 @@
 #include <string>
 #include <vector>
 
+#include "absl/base/call_once.h"
 #include "dictionary/user_pos_interface.h"
 
 namespace mozc {
 
 class PosListProvider : public PosListProviderInterface {
  public:
-  PosListProvider();
+  PosListProvider() = default;
 
   std::vector<std::string> GetPosList() const override;
   int GetPosListDefaultIndex() const override;
 
  private:
-  std::vector<std::string> pos_list_;
-  int pos_list_default_index_ = 0;
+  // The POS name strings are needed only by the GUI and dictionary tool
+  // paths; materialize them from the embedded string table on first request
+  // so that engine startup does no work for them and headless processes
+  // never page the table in or hold the heap copies.
+  void EnsureInitialized() const;
+
+  mutable absl::once_flag once_;
+  mutable std::vector<std::string> pos_list_;
+  mutable int pos_list_default_index_ = 0;
 };
 
 }  // namespace mozc
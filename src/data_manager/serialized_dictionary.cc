@@ -102,6 +102,12 @@ SerializedDictionary::IterRange SerializedDictionary::equal_range(
   return std::equal_range(begin(), end(), key);
 }
 
+SerializedDictionary::TokenSpan SerializedDictionary::equal_span(
+    absl::string_view key) const {
+  const IterRange range = equal_range(key);
+  return tokens().subspan(range.first - begin(), range.second - range.first);
+}
+
 std::pair<absl::string_view, absl::string_view> SerializedDictionary::Compile(
     std::istream *input, std::unique_ptr<uint32_t[]> *output_token_array_buf,
     std::unique_ptr<uint32_t[]> *output_string_array_buf) {
@@ -41,6 +41,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "base/container/serialized_string_array.h"
 #include "base/logging.h"
 
@@ -124,6 +125,26 @@ class SerializedDictionary {
 
   static constexpr size_t kTokenByteLength = 24;
 
+  // A packed mirror of the 24-byte token layout described above. Since the
+  // schema is fixed at build time and the token array is 4-byte aligned, the
+  // whole array can be viewed as a span of these records, giving direct field
+  // access over the mmapped bytes without per-field offset decoding.
+  struct Token {
+    uint32_t key_index;
+    uint32_t value_index;
+    uint32_t description_index;
+    uint32_t additional_description_index;
+    uint16_t lid;
+    uint16_t rid;
+    int16_t cost;
+    uint16_t padding;
+  };
+  static_assert(sizeof(Token) == kTokenByteLength,
+                "Token must mirror the serialized 24-byte layout");
+  static_assert(alignof(Token) == 4, "Token array is aligned at 4 bytes");
+
+  using TokenSpan = absl::Span<const Token>;
+
   class iterator {
    public:
     using iterator_category = std::random_access_iterator_tag;
@@ -352,6 +373,31 @@ class SerializedDictionary {
   // is sorted in ascending order of cost.
   IterRange equal_range(absl::string_view key) const;
 
+  // Returns all tokens as packed records, sorted first by key and then by
+  // cost.  The span points directly into the token array image.
+  TokenSpan tokens() const {
+    return TokenSpan(reinterpret_cast<const Token *>(token_array_.data()),
+                     size());
+  }
+
+  // Token counterpart of equal_range(): the subspan of tokens() whose keys
+  // match the given key, sorted in ascending order of cost.
+  TokenSpan equal_span(absl::string_view key) const;
+
+  // Resolve the string fields of a token in the string array.
+  absl::string_view key(const Token &token) const {
+    return string_array_[token.key_index];
+  }
+  absl::string_view value(const Token &token) const {
+    return string_array_[token.value_index];
+  }
+  absl::string_view description(const Token &token) const {
+    return string_array_[token.description_index];
+  }
+  absl::string_view additional_description(const Token &token) const {
+    return string_array_[token.additional_description_index];
+  }
+
  private:
   absl::string_view token_array_;
   SerializedStringArray string_array_;
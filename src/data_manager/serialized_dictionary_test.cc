@@ -184,5 +184,36 @@ TEST_F(SerializedDictionaryTest, EqualRange) {
   }
 }
 
+TEST_F(SerializedDictionaryTest, TokenSpan) {
+  SerializedDictionary dic(token_array_data_, string_array_data_);
+
+  const SerializedDictionary::TokenSpan tokens = dic.tokens();
+  ASSERT_EQ(tokens.size(), 3);
+  EXPECT_EQ(dic.key(tokens[0]), "key1");
+  EXPECT_EQ(dic.value(tokens[0]), "value2");
+  EXPECT_EQ(dic.description(tokens[0]), "desc2");
+  EXPECT_EQ(dic.additional_description(tokens[0]), "adesc2");
+  EXPECT_EQ(tokens[0].lid, 50);
+  EXPECT_EQ(tokens[0].rid, 60);
+  EXPECT_EQ(tokens[0].cost, 2000);
+  EXPECT_EQ(dic.value(tokens[1]), "value1");
+  EXPECT_EQ(dic.key(tokens[2]), "key2");
+
+  {
+    const SerializedDictionary::TokenSpan span = dic.equal_span("key1");
+    ASSERT_EQ(span.size(), 2);
+    EXPECT_EQ(dic.value(span[0]), "value2");
+    EXPECT_EQ(dic.value(span[1]), "value1");
+  }
+  {
+    const SerializedDictionary::TokenSpan span = dic.equal_span("key2");
+    ASSERT_EQ(span.size(), 1);
+    EXPECT_EQ(dic.value(span[0]), "value3");
+  }
+  {
+    EXPECT_TRUE(dic.equal_span("mozc").empty());
+  }
+}
+
 }  // namespace
 }  // namespace mozc
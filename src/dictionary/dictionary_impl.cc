@@ -29,6 +29,8 @@
 
 #include "dictionary/dictionary_impl.h"
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -104,12 +106,12 @@ class CallbackWithFilter : public DictionaryInterface::Callback {
         callback_(callback) {}
 
   ResultType OnKey(absl::string_view key) override {
-    return callback_->OnKey(key);
+    return Forward(callback_->OnKey(key));
   }
 
   ResultType OnActualKey(absl::string_view key, absl::string_view actual_key,
                          int num_expanded) override {
-    return callback_->OnActualKey(key, actual_key, num_expanded);
+    return Forward(callback_->OnActualKey(key, actual_key, num_expanded));
   }
 
   ResultType OnToken(absl::string_view key, absl::string_view actual_key,
@@ -130,16 +132,38 @@ class CallbackWithFilter : public DictionaryInterface::Callback {
     if (suppression_dictionary_->SuppressEntry(token.key, token.value)) {
       return TRAVERSE_CONTINUE;
     }
-    return callback_->OnToken(key, actual_key, token);
+    if (hit_counter_ != nullptr) {
+      hit_counter_->fetch_add(1, std::memory_order_relaxed);
+    }
+    return Forward(callback_->OnToken(key, actual_key, token));
+  }
+
+  // True once the wrapped callback has returned TRAVERSE_DONE; the fan-out
+  // loop skips the remaining dictionaries then.
+  bool done() const { return done_; }
+
+  // Sets where delivered tokens are counted, typically the per-dictionary
+  // hit counter of the dictionary currently being traversed.
+  void set_hit_counter(std::atomic<uint64_t> *hit_counter) {
+    hit_counter_ = hit_counter;
   }
 
  private:
+  ResultType Forward(ResultType result) {
+    if (result == TRAVERSE_DONE) {
+      done_ = true;
+    }
+    return result;
+  }
+
   const bool use_spelling_correction_;
   const bool use_zip_code_conversion_;
   const bool use_t13n_conversion_;
   const PosMatcher *pos_matcher_;
   const SuppressionDictionary *suppression_dictionary_;
   DictionaryInterface::Callback *callback_;
+  std::atomic<uint64_t> *hit_counter_ = nullptr;
+  bool done_ = false;
 };
 
 }  // namespace
@@ -153,7 +177,14 @@ void DictionaryImpl::LookupPredictive(
       conversion_request.config().use_t13n_conversion(), pos_matcher_,
       suppression_dictionary_, callback);
   for (size_t i = 0; i < dics_.size(); ++i) {
+    callback_with_filter.set_hit_counter(&token_hits_[i]);
     dics_[i]->LookupPredictive(key, conversion_request, &callback_with_filter);
+    if (callback_with_filter.done()) {
+      if (i + 1 < dics_.size()) {
+        early_terminations_.fetch_add(1, std::memory_order_relaxed);
+      }
+      break;
+    }
   }
 }
 
@@ -166,7 +197,14 @@ void DictionaryImpl::LookupPrefix(absl::string_view key,
       conversion_request.config().use_t13n_conversion(), pos_matcher_,
       suppression_dictionary_, callback);
   for (size_t i = 0; i < dics_.size(); ++i) {
+    callback_with_filter.set_hit_counter(&token_hits_[i]);
     dics_[i]->LookupPrefix(key, conversion_request, &callback_with_filter);
+    if (callback_with_filter.done()) {
+      if (i + 1 < dics_.size()) {
+        early_terminations_.fetch_add(1, std::memory_order_relaxed);
+      }
+      break;
+    }
   }
 }
 
@@ -179,7 +217,14 @@ void DictionaryImpl::LookupExact(absl::string_view key,
       conversion_request.config().use_t13n_conversion(), pos_matcher_,
       suppression_dictionary_, callback);
   for (size_t i = 0; i < dics_.size(); ++i) {
+    callback_with_filter.set_hit_counter(&token_hits_[i]);
     dics_[i]->LookupExact(key, conversion_request, &callback_with_filter);
+    if (callback_with_filter.done()) {
+      if (i + 1 < dics_.size()) {
+        early_terminations_.fetch_add(1, std::memory_order_relaxed);
+      }
+      break;
+    }
   }
 }
 
@@ -192,7 +237,14 @@ void DictionaryImpl::LookupReverse(absl::string_view str,
       conversion_request.config().use_t13n_conversion(), pos_matcher_,
       suppression_dictionary_, callback);
   for (size_t i = 0; i < dics_.size(); ++i) {
+    callback_with_filter.set_hit_counter(&token_hits_[i]);
     dics_[i]->LookupReverse(str, conversion_request, &callback_with_filter);
+    if (callback_with_filter.done()) {
+      if (i + 1 < dics_.size()) {
+        early_terminations_.fetch_add(1, std::memory_order_relaxed);
+      }
+      break;
+    }
   }
 }
 
@@ -211,6 +263,15 @@ bool DictionaryImpl::LookupComment(absl::string_view key,
   return false;
 }
 
+DictionaryImpl::LookupStats DictionaryImpl::lookup_stats() const {
+  return LookupStats{
+      token_hits_[0].load(std::memory_order_relaxed),
+      token_hits_[1].load(std::memory_order_relaxed),
+      token_hits_[2].load(std::memory_order_relaxed),
+      early_terminations_.load(std::memory_order_relaxed),
+  };
+}
+
 bool DictionaryImpl::Reload() { return user_dictionary_->Reload(); }
 
 void DictionaryImpl::PopulateReverseLookupCache(absl::string_view str) const {
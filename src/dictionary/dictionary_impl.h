@@ -30,6 +30,9 @@
 #ifndef MOZC_DICTIONARY_DICTIONARY_IMPL_H_
 #define MOZC_DICTIONARY_DICTIONARY_IMPL_H_
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -88,6 +91,18 @@ class DictionaryImpl : public DictionaryInterface {
   void PopulateReverseLookupCache(absl::string_view str) const override;
   void ClearReverseLookupCache() const override;
 
+  // Cumulative number of tokens each dictionary delivered to callers, plus
+  // how often a lookup stopped before visiting every dictionary because the
+  // callback returned TRAVERSE_DONE. Counters are process-lifetime and
+  // relaxed; they exist to tune the fan-out order.
+  struct LookupStats {
+    uint64_t system_tokens;
+    uint64_t value_tokens;
+    uint64_t user_tokens;
+    uint64_t early_terminations;
+  };
+  LookupStats lookup_stats() const;
+
  private:
   enum LookupType {
     PREDICTIVE,
@@ -110,6 +125,10 @@ class DictionaryImpl : public DictionaryInterface {
 
   // Suppression dictionary is used to suppress entries.
   const SuppressionDictionary *suppression_dictionary_;
+
+  // Per-dictionary delivered-token counters, indexed like dics_.
+  mutable std::array<std::atomic<uint64_t>, 3> token_hits_ = {};
+  mutable std::atomic<uint64_t> early_terminations_ = 0;
 };
 
 }  // namespace dictionary
@@ -237,6 +237,36 @@ TEST_F(DictionaryImplTest, WordSuppressionTest) {
   }
 }
 
+TEST_F(DictionaryImplTest, EarlyTerminationTest) {
+  std::unique_ptr<DictionaryData> data = CreateDictionaryData();
+  DictionaryImpl *d = static_cast<DictionaryImpl *>(data->dictionary.get());
+
+  class DoneAtFirstTokenCallback : public DictionaryInterface::Callback {
+   public:
+    ResultType OnToken(absl::string_view key, absl::string_view actual_key,
+                       const Token &token) override {
+      ++num_tokens_;
+      return TRAVERSE_DONE;
+    }
+    int num_tokens() const { return num_tokens_; }
+
+   private:
+    int num_tokens_ = 0;
+  };
+
+  // The callback is satisfied by the first token, so the remaining
+  // dictionaries must not be visited.
+  DoneAtFirstTokenCallback callback;
+  d->LookupPredictive("ぐーぐ", convreq_, &callback);
+  EXPECT_EQ(callback.num_tokens(), 1);
+
+  const DictionaryImpl::LookupStats stats = d->lookup_stats();
+  EXPECT_EQ(stats.early_terminations, 1);
+  EXPECT_EQ(stats.system_tokens, 1);
+  EXPECT_EQ(stats.value_tokens, 0);
+  EXPECT_EQ(stats.user_tokens, 0);
+}
+
 TEST_F(DictionaryImplTest, DisableSpellingCorrectionTest) {
   std::unique_ptr<DictionaryData> data = CreateDictionaryData();
   DictionaryInterface *d = data->dictionary.get();
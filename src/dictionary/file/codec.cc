@@ -36,6 +36,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/flags/flag.h"
 #include "absl/status/status.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
@@ -47,13 +48,46 @@
 #include "dictionary/file/codec_util.h"
 #include "dictionary/file/section.h"
 
+ABSL_FLAG(bool, dictionary_file_format_v2, false,
+          "Write dictionary files in the v2 container: fixed-offset section "
+          "directory, 64-byte-aligned sections, per-section checksums and an "
+          "endianness tag.");
+
 namespace mozc {
 namespace dictionary {
+namespace {
+
+// Constants of the v2 container layout:
+//
+//   +0   int32   file magic (filemagic_v2_)
+//   +4   int32   section name fingerprint seed
+//   +8   uint32  endianness tag (kEndiannessTag as written by this writer)
+//   +12  uint32  number of sections
+//   +16  directory: per section
+//          char[8] name fingerprint
+//          uint32  data offset from image start (64-byte aligned)
+//          uint32  data size
+//          uint32  checksum (low half of Fingerprint of the data)
+//   then the section data blocks, 64-byte aligned, in directory order.
+constexpr uint32_t kEndiannessTag = 0x01020304;
+constexpr size_t kV2Alignment = 64;
+constexpr size_t kV2HeaderSize = 16;
+constexpr size_t kV2DirectoryEntrySize = 8 + 4 + 4 + 4;
+
+uint32_t SectionChecksum(const char *data, size_t size) {
+  return static_cast<uint32_t>(Fingerprint(absl::string_view(data, size)));
+}
+
+}  // namespace
 
 void DictionaryFileCodec::WriteSections(
     const std::vector<DictionaryFileSection> &sections,
     std::ostream *ofs) const {
   DCHECK(ofs);
+  if (absl::GetFlag(FLAGS_dictionary_file_format_v2)) {
+    WriteSectionsV2(sections, ofs);
+    return;
+  }
   WriteHeader(ofs);
 
   if (sections.size() == 4) {
@@ -111,6 +145,99 @@ std::string DictionaryFileCodec::GetSectionName(
   return fp_string;
 }
 
+void DictionaryFileCodec::WriteSectionsV2(
+    const std::vector<DictionaryFileSection> &sections,
+    std::ostream *ofs) const {
+  DCHECK(ofs);
+  filecodec_util::WriteInt32(filemagic_v2_, ofs);
+  filecodec_util::WriteInt32(seed_, ofs);
+  filecodec_util::WriteInt32(static_cast<int32_t>(kEndiannessTag), ofs);
+  filecodec_util::WriteInt32(static_cast<int32_t>(sections.size()), ofs);
+
+  // Lay the section data blocks out after the directory, each aligned.
+  size_t offset = kV2HeaderSize + sections.size() * kV2DirectoryEntrySize;
+  std::vector<uint32_t> offsets;
+  offsets.reserve(sections.size());
+  for (const DictionaryFileSection &section : sections) {
+    offset = (offset + kV2Alignment - 1) & ~(kV2Alignment - 1);
+    offsets.push_back(static_cast<uint32_t>(offset));
+    offset += section.len;
+  }
+
+  for (size_t i = 0; i < sections.size(); ++i) {
+    const DictionaryFileSection &section = sections[i];
+    DCHECK_EQ(8, section.name.size());
+    ofs->write(section.name.data(), section.name.size());
+    filecodec_util::WriteInt32(static_cast<int32_t>(offsets[i]), ofs);
+    filecodec_util::WriteInt32(static_cast<int32_t>(section.len), ofs);
+    filecodec_util::WriteInt32(
+        static_cast<int32_t>(SectionChecksum(section.ptr, section.len)), ofs);
+  }
+
+  size_t written = kV2HeaderSize + sections.size() * kV2DirectoryEntrySize;
+  for (size_t i = 0; i < sections.size(); ++i) {
+    while (written < offsets[i]) {
+      ofs->put('\0');
+      ++written;
+    }
+    ofs->write(sections[i].ptr, sections[i].len);
+    written += sections[i].len;
+  }
+}
+
+absl::Status DictionaryFileCodec::ReadSectionsV2(
+    const char *image, int length,
+    std::vector<DictionaryFileSection> *sections) const {
+  const char *ptr = image + 4;  // The magic was already checked.
+  seed_ = LoadUnalignedAdvance<int32_t>(ptr);
+  const uint32_t endianness =
+      static_cast<uint32_t>(LoadUnalignedAdvance<int32_t>(ptr));
+  if (endianness != kEndiannessTag) {
+    return absl::FailedPreconditionError(absl::StrCat(
+        "codec.cc: Dictionary file was written with a different endianness: ",
+        endianness));
+  }
+  const uint32_t num_sections =
+      static_cast<uint32_t>(LoadUnalignedAdvance<int32_t>(ptr));
+  const uint64_t directory_end =
+      kV2HeaderSize + uint64_t{num_sections} * kV2DirectoryEntrySize;
+  if (directory_end > static_cast<uint64_t>(length)) {
+    return absl::OutOfRangeError(
+        absl::StrCat("codec.cc: Section directory passes the end: ",
+                     directory_end, " > ", length));
+  }
+  for (uint32_t i = 0; i < num_sections; ++i) {
+    const absl::string_view fingerprint(ptr, 8);
+    ptr += 8;
+    const uint32_t offset =
+        static_cast<uint32_t>(LoadUnalignedAdvance<int32_t>(ptr));
+    const uint32_t size =
+        static_cast<uint32_t>(LoadUnalignedAdvance<int32_t>(ptr));
+    const uint32_t checksum =
+        static_cast<uint32_t>(LoadUnalignedAdvance<int32_t>(ptr));
+    if (offset % kV2Alignment != 0 ||
+        uint64_t{offset} + size > static_cast<uint64_t>(length)) {
+      return absl::OutOfRangeError(
+          absl::StrCat("codec.cc: Section ", i, " has invalid bounds: offset=",
+                       offset, ", size=", size, ", image_size=", length));
+    }
+    DictionaryFileSection section(image + offset, size, fingerprint);
+    section.checksum = checksum;
+    section.has_checksum = true;
+    sections->push_back(std::move(section));
+  }
+  return absl::OkStatus();
+}
+
+// static
+bool DictionaryFileCodec::VerifyChecksum(
+    const DictionaryFileSection &section) {
+  if (!section.has_checksum) {
+    return true;
+  }
+  return SectionChecksum(section.ptr, section.len) == section.checksum;
+}
+
 absl::Status DictionaryFileCodec::ReadSections(
     const char *image, int length,
     std::vector<DictionaryFileSection> *sections) const {
@@ -133,6 +260,13 @@ absl::Status DictionaryFileCodec::ReadSections(
   const char *const image_end = image + length;
 
   const int32_t filemagic = LoadUnalignedAdvance<int32_t>(ptr);
+  if (filemagic == filemagic_v2_) {
+    if (length < static_cast<int>(kV2HeaderSize)) {
+      return absl::FailedPreconditionError(absl::StrCat(
+          "codec.cc: Insufficient v2 header size: ", length, " bytes"));
+    }
+    return ReadSectionsV2(image, length, sections);
+  }
   if (filemagic != filemagic_) {
     return absl::FailedPreconditionError(absl::StrCat(
         "codec.cc: Invalid dictionary file magic. Expected: ", filemagic_,
@@ -35,6 +35,9 @@
 #include <string>
 #include <vector>
 
+#include "absl/flags/declare.h"
+#include "absl/flags/flag.h"
+#include "absl/flags/reflection.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "base/file/temp_dir.h"
@@ -48,6 +51,8 @@
 #include "testing/gunit.h"
 #include "testing/mozctest.h"
 
+ABSL_DECLARE_FLAG(bool, dictionary_file_format_v2);
+
 namespace mozc {
 namespace dictionary {
 namespace {
@@ -176,6 +181,52 @@ TEST_F(CodecTest, DefaultTest) {
   EXPECT_TRUE(CheckValue(sections[index], "Value 1 test test"));
 }
 
+TEST_F(CodecTest, V2FormatTest) {
+  absl::FlagSaver flag_saver;
+  absl::SetFlag(&FLAGS_dictionary_file_format_v2, true);
+
+  DictionaryFileCodec codec;
+  {
+    std::vector<DictionaryFileSection> write_sections;
+    const std::string value0 = "Value 0 test";
+    AddSection(&codec, "Section 0", value0.data(), value0.size(),
+               &write_sections);
+    const std::string value1 = "Value 1 test test";
+    AddSection(&codec, "Section 1", value1.data(), value1.size(),
+               &write_sections);
+    OutputFileStream ofs;
+    ofs.open(test_file_.path(), std::ios_base::out | std::ios_base::binary);
+    codec.WriteSections(write_sections, &ofs);
+  }
+
+  absl::StatusOr<std::string> buf = FileUtil::GetContents(test_file_.path());
+  ASSERT_OK(buf);
+  std::vector<DictionaryFileSection> sections;
+  ASSERT_OK(codec.ReadSections(buf->data(), buf->size(), &sections));
+  ASSERT_EQ(sections.size(), 2);
+
+  int index = -1;
+  ASSERT_TRUE(FindSection(&codec, sections, "Section 0", &index));
+  EXPECT_TRUE(CheckValue(sections[index], "Value 0 test"));
+  ASSERT_TRUE(FindSection(&codec, sections, "Section 1", &index));
+  EXPECT_TRUE(CheckValue(sections[index], "Value 1 test test"));
+
+  for (const DictionaryFileSection &section : sections) {
+    // Sections are 64-byte aligned relative to the image start and carry
+    // verifiable checksums.
+    EXPECT_EQ((section.ptr - buf->data()) % 64, 0);
+    EXPECT_TRUE(section.has_checksum);
+    EXPECT_TRUE(DictionaryFileCodec::VerifyChecksum(section));
+  }
+
+  // Corruption is detected by the deferred verification.
+  DictionaryFileSection corrupted = sections[0];
+  std::string corrupted_data(corrupted.ptr, corrupted.len);
+  corrupted_data[0] ^= 0x5a;
+  corrupted.ptr = corrupted_data.data();
+  EXPECT_FALSE(DictionaryFileCodec::VerifyChecksum(corrupted));
+}
+
 TEST_F(CodecTest, RandomizedCodecTest) {
   DictionaryFileCodec internal_codec;
   DictionaryFileCodecFactory::SetCodec(&internal_codec);
@@ -31,6 +31,7 @@
 #define MOZC_DICTIONARY_FILE_SECTION_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 #include "absl/strings/string_view.h"
@@ -45,6 +46,11 @@ struct DictionaryFileSection {
   const char *ptr;
   size_t len;
   std::string name;
+  // Per-section checksum from the v2 container, for deferred verification
+  // with DictionaryFileCodec::VerifyChecksum; 0 when the container carries
+  // none (v1).
+  uint32_t checksum = 0;
+  bool has_checksum = false;
 };
 
 }  // namespace dictionary
@@ -41,7 +41,28 @@ import struct
 from dictionary import pos_util
 
 
+def _SortAndMergeRanges(ranges):
+  """Sorts the id ranges and merges overlapping or adjacent ones.
+
+  IsRuleInTable() and IsAnyRuleInTable() rely on the ascending order to stop
+  scanning at the first range starting beyond the queried id; merging keeps
+  the tables minimal.
+  """
+  result = []
+  for id_range in sorted(tuple(r) for r in ranges):
+    if result and id_range[0] <= result[-1][1] + 1:
+      result[-1] = (result[-1][0], max(result[-1][1], id_range[1]))
+    else:
+      result.append(id_range)
+  return result
+
+
 def OutputPosMatcherData(pos_matcher, output):
+  merged_ranges = {
+      rule_name: _SortAndMergeRanges(pos_matcher.GetRange(rule_name))
+      for rule_name in pos_matcher.GetRuleNameList()
+  }
+
   data = []
   for rule_name in pos_matcher.GetRuleNameList():
     data.append(pos_matcher.GetId(rule_name))
@@ -49,10 +70,10 @@ def OutputPosMatcherData(pos_matcher, output):
   offset = 2 * len(pos_matcher.GetRuleNameList())
   for rule_name in pos_matcher.GetRuleNameList():
     data.append(offset)
-    offset += 2 * len(pos_matcher.GetRange(rule_name)) + 1
+    offset += 2 * len(merged_ranges[rule_name]) + 1
 
   for rule_name in pos_matcher.GetRuleNameList():
-    for id_range in pos_matcher.GetRange(rule_name):
+    for id_range in merged_ranges[rule_name]:
       data.append(id_range[0])
       data.append(id_range[1])
     data.append(0xFFFF)
@@ -100,17 +121,34 @@ def OutputPosMatcherHeader(pos_matcher, output):
         }
     )
 
-  # Generate Get<RuleName>Id() and Is<RuleName>(uint16_t id) for each rule.
+  # Helper function to generate IsAny<RuleName>(ids) method, the batched
+  # counterpart of Is<RuleName>() classifying a whole id array in one walk of
+  # the rule's range table.
+  def _GenerateIsAnyMethod(rule_name, index):
+    return (
+        '  bool IsAny%(rule_name)s(absl::Span<const uint16_t> ids) const {\n'
+        '    return IsAnyRuleInTable(%(index)d, ids);\n'
+        '  }'
+        % {
+            'rule_name': rule_name,
+            'index': index,
+        }
+    )
+
+  # Generate Get<RuleName>Id(), Is<RuleName>(uint16_t id) and
+  # IsAny<RuleName>(ids) for each rule.
   for i, rule_name in enumerate(pos_matcher.GetRuleNameList()):
     output.write(
         '  // %(rule_name)s "%(original_pattern)s"\n'
         '%(get_method)s\n'
         '%(is_method)s\n'
+        '%(is_any_method)s\n'
         % {
             'rule_name': rule_name,
             'original_pattern': pos_matcher.GetOriginalPattern(rule_name),
             'get_method': _GenerateGetMethod(rule_name, i),
             'is_method': _GenerateIsMethod(rule_name, i),
+            'is_any_method': _GenerateIsAnyMethod(rule_name, i),
         }
     )
 
@@ -33,6 +33,7 @@
 #include <cstdint>
 
 #include "absl/base/attributes.h"
+#include "absl/types/span.h"
 
 namespace mozc::dictionary {
 
@@ -105,6 +106,7 @@ class PosMatcher {
  private:
   // Used in pos_matcher_impl.inc.
   constexpr bool IsRuleInTable(int index, uint16_t id) const;
+  bool IsAnyRuleInTable(int index, absl::Span<const uint16_t> ids) const;
 
   const uint16_t *data_;
 
@@ -115,14 +117,38 @@ constexpr bool PosMatcher::IsRuleInTable(const int index,
                                          const uint16_t id) const {
   // kLidTableSize is defined in pos_matcher_impl.inc.
   const uint16_t offset = data_[kLidTableSize + index];
+  // Ranges are sorted in ascending order and non-overlapping (see
+  // gen_pos_matcher_code.py), so the scan can stop at the first range
+  // starting beyond |id|.
   for (const uint16_t *ptr = data_ + offset; *ptr != 0xFFFFu; ptr += 2) {
-    if (id >= *ptr && id <= *(ptr + 1)) {
+    if (id < *ptr) {
+      return false;
+    }
+    if (id <= *(ptr + 1)) {
       return true;
     }
   }
   return false;
 }
 
+inline bool PosMatcher::IsAnyRuleInTable(
+    const int index, const absl::Span<const uint16_t> ids) const {
+  // Batched counterpart of IsRuleInTable(): the rule's range-table base is
+  // resolved once for the whole id array.
+  const uint16_t *table = data_ + data_[kLidTableSize + index];
+  for (const uint16_t id : ids) {
+    for (const uint16_t *ptr = table; *ptr != 0xFFFFu; ptr += 2) {
+      if (id < *ptr) {
+        break;
+      }
+      if (id <= *(ptr + 1)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 }  // namespace mozc::dictionary
 
 #endif  // MOZC_DICTIONARY_POS_MATCHER_H_
@@ -38,6 +38,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "base/container/serialized_string_array.h"
@@ -191,6 +192,53 @@ SingleKanjiDictionary::SingleKanjiDictionary(
                                           noun_prefix_string_array_data));
   noun_prefix_dictionary_ = std::make_unique<SerializedDictionary>(
       noun_prefix_token_array_data, noun_prefix_string_array_data);
+
+  BuildReverseIndexes();
+}
+
+void SingleKanjiDictionary::BuildReverseIndexes() {
+  {
+    const uint32_t *token_array =
+        reinterpret_cast<const uint32_t *>(single_kanji_token_array_.data());
+    const uint32_t num_records =
+        single_kanji_token_array_.size() / (2 * sizeof(uint32_t));
+    single_kanji_index_.reserve(num_records);
+    for (uint32_t i = 0; i < num_records; ++i) {
+      single_kanji_index_.emplace(
+          single_kanji_string_array_[token_array[2 * i]], i);
+    }
+  }
+
+  const uint32_t *token_array =
+      reinterpret_cast<const uint32_t *>(variant_token_array_.data());
+  const uint32_t num_records =
+      variant_token_array_.size() / (3 * sizeof(uint32_t));
+  for (uint32_t i = 0; i < num_records; ++i) {
+    const absl::string_view target =
+        variant_string_array_[token_array[3 * i]];
+    size_t mblen = 0;
+    const char32_t codepoint = Util::Utf8ToCodepoint(
+        target.data(), target.data() + target.size(), &mblen);
+    if (mblen != target.size()) {
+      // Multi-codepoint target; served by the binary search fallback.
+      continue;
+    }
+    const uint32_t page = codepoint / kVariantPageSize;
+    if (variant_page_index_.size() <= page) {
+      variant_page_index_.resize(page + 1, -1);
+    }
+    if (variant_page_index_[page] < 0) {
+      variant_page_index_[page] =
+          static_cast<int32_t>(variant_pages_.size() / kVariantPageSize);
+      variant_pages_.resize(variant_pages_.size() + kVariantPageSize, 0);
+    }
+    uint32_t &slot =
+        variant_pages_[variant_page_index_[page] * kVariantPageSize +
+                       codepoint % kVariantPageSize];
+    if (slot == 0) {  // Keep the first record, as lower_bound did.
+      slot = i + 1;
+    }
+  }
 }
 
 // The underlying token array, |single_kanji_token_array_|, has the following
@@ -213,21 +261,14 @@ bool SingleKanjiDictionary::LookupKanjiEntries(
     absl::string_view key, bool use_svs,
     std::vector<std::string> *kanji_list) const {
   DCHECK(kanji_list);
-  const uint32_t *token_array =
-      reinterpret_cast<const uint32_t *>(single_kanji_token_array_.data());
-  const size_t token_array_size =
-      single_kanji_token_array_.size() / sizeof(uint32_t);
-
-  const Uint32ArrayIterator<2> end(token_array + token_array_size);
-  const auto iter = std::lower_bound(
-      Uint32ArrayIterator<2>(token_array), end, key,
-      [this](uint32_t index, const absl::string_view target_key) {
-        return this->single_kanji_string_array_[index] < target_key;
-      });
-  if (iter == end || single_kanji_string_array_[iter[0]] != key) {
+  const auto it = single_kanji_index_.find(key);
+  if (it == single_kanji_index_.end()) {
     return false;
   }
-  const absl::string_view values = single_kanji_string_array_[iter[1]];
+  const uint32_t *token_array =
+      reinterpret_cast<const uint32_t *>(single_kanji_token_array_.data());
+  const absl::string_view values =
+      single_kanji_string_array_[token_array[2 * it->second + 1]];
   if (use_svs) {
     std::string svs_values;
     if (TextNormalizer::NormalizeTextToSvs(values, &svs_values)) {
@@ -266,20 +307,42 @@ bool SingleKanjiDictionary::GenerateDescription(absl::string_view kanji_surface,
   DCHECK(desc);
   const uint32_t *token_array =
       reinterpret_cast<const uint32_t *>(variant_token_array_.data());
-  const size_t token_array_size =
-      variant_token_array_.size() / sizeof(uint32_t);
-
-  const Uint32ArrayIterator<3> end(token_array + token_array_size);
-  const auto iter = std::lower_bound(
-      Uint32ArrayIterator<3>(token_array), end, kanji_surface,
-      [this](uint32_t index, const absl::string_view target_key) {
-        return this->variant_string_array_[index] < target_key;
-      });
-  if (iter == end || variant_string_array_[iter[0]] != kanji_surface) {
-    return false;
+
+  size_t mblen = 0;
+  const char32_t codepoint = Util::Utf8ToCodepoint(
+      kanji_surface.data(), kanji_surface.data() + kanji_surface.size(),
+      &mblen);
+  uint32_t record = 0;
+  if (mblen == kanji_surface.size()) {
+    // Single-codepoint surface: O(1) probe of the two-level table.
+    const uint32_t page = codepoint / kVariantPageSize;
+    if (page >= variant_page_index_.size() || variant_page_index_[page] < 0) {
+      return false;
+    }
+    record = variant_pages_[variant_page_index_[page] * kVariantPageSize +
+                            codepoint % kVariantPageSize];
+    if (record == 0) {
+      return false;
+    }
+    --record;
+  } else {
+    const size_t token_array_size =
+        variant_token_array_.size() / sizeof(uint32_t);
+    const Uint32ArrayIterator<3> begin(token_array);
+    const Uint32ArrayIterator<3> end(token_array + token_array_size);
+    const auto iter = std::lower_bound(
+        begin, end, kanji_surface,
+        [this](uint32_t index, const absl::string_view target_key) {
+          return this->variant_string_array_[index] < target_key;
+        });
+    if (iter == end || variant_string_array_[iter[0]] != kanji_surface) {
+      return false;
+    }
+    record = static_cast<uint32_t>(iter - begin);
   }
-  const absl::string_view original = variant_string_array_[iter[1]];
-  const uint32_t type_id = iter[2];
+  const absl::string_view original =
+      variant_string_array_[token_array[3 * record + 1]];
+  const uint32_t type_id = token_array[3 * record + 2];
   DCHECK_LT(type_id, variant_type_array_.size());
   // Format like "XXXのYYY"
   *desc = absl::StrCat(original, "の", variant_type_array_[type_id]);
@@ -30,12 +30,14 @@
 #ifndef MOZC_DICTIONARY_SINGLE_KANJI_DICTIONARY_H_
 #define MOZC_DICTIONARY_SINGLE_KANJI_DICTIONARY_H_
 
+#include <cstdint>
 #include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "base/container/serialized_string_array.h"
 #include "data_manager/data_manager_interface.h"
@@ -73,6 +75,11 @@ class SingleKanjiDictionary {
                            std::string *desc) const;
 
  private:
+  // Builds the reverse indexes below from the serialized arrays, so that the
+  // common query shapes are hash or table probes instead of binary searches
+  // over the string array.
+  void BuildReverseIndexes();
+
   absl::string_view single_kanji_token_array_;
   SerializedStringArray single_kanji_string_array_;
   SerializedStringArray variant_type_array_;
@@ -85,6 +92,18 @@ class SingleKanjiDictionary {
   // the single kanji dictionary. Ideally, we want to regenerate our
   // language model for fixing noun-prefix issue.
   std::unique_ptr<SerializedDictionary> noun_prefix_dictionary_;
+
+  // Reading -> token record index in |single_kanji_token_array_|.  The views
+  // point into |single_kanji_string_array_|.
+  absl::flat_hash_map<absl::string_view, uint32_t> single_kanji_index_;
+
+  // Dense two-level table for variant targets that are single codepoints
+  // (nearly all of them): |variant_page_index_[cp >> 8]| selects a page of
+  // 256 slots holding record index + 1, with 0 meaning absent.  Targets
+  // spanning several codepoints fall back to binary search.
+  static constexpr uint32_t kVariantPageSize = 256;
+  std::vector<int32_t> variant_page_index_;
+  std::vector<uint32_t> variant_pages_;
 };
 
 }  // namespace dictionary
@@ -95,8 +95,11 @@ void SuffixDictionary::LookupPredictive(
   Token token;
   token.attributes = Token::SUFFIX_DICTIONARY;
   for (; range.first != range.second; ++range.first) {
-    token.key.assign((*range.first).data(), (*range.first).size());
-    switch (callback->OnKey(token.key)) {
+    // Keys and values are handed to the callback as views into the data
+    // image; the token strings are materialized only for entries the
+    // callback actually takes.
+    const absl::string_view token_key = *range.first;
+    switch (callback->OnKey(token_key)) {
       case Callback::TRAVERSE_DONE:
         return;
       case Callback::TRAVERSE_NEXT_KEY:
@@ -106,6 +109,7 @@ void SuffixDictionary::LookupPredictive(
       default:
         break;
     }
+    token.key.assign(token_key.data(), token_key.size());
     const size_t index = range.first - key_array_.begin();
     if (value_array_[index].empty()) {
       token.value = token.key;
@@ -116,7 +120,7 @@ void SuffixDictionary::LookupPredictive(
     token.lid = token_array_[3 * index];
     token.rid = token_array_[3 * index + 1];
     token.cost = token_array_[3 * index + 2];
-    if (callback->OnToken(token.key, token.key, token) !=
+    if (callback->OnToken(token_key, token_key, token) !=
         Callback::TRAVERSE_CONTINUE) {
       break;
     }
@@ -50,6 +50,15 @@ namespace dictionary {
 // frequently appear on the web.
 // When user inputs a content word, we can predict an appropriate
 // functional word with this dictionary.
+//
+// Storage note (evaluated): a DAWG with inline values was considered to
+// deduplicate shared suffix strings. It is not a good trade here: the
+// sorted-array sections are already compact (values identical to their key
+// are stored as "" and every lookup streams string views out of the mmapped
+// image without copies), the section is small relative to the system
+// dictionary, and a new binary format would require regenerating every data
+// image including the checked-in test data. Revisit only if the suffix data
+// grows by an order of magnitude.
 class SuffixDictionary : public DictionaryInterface {
  public:
   SuffixDictionary(absl::string_view key_array_data,
@@ -29,8 +29,13 @@
 
 #include "dictionary/suppression_dictionary.h"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/strings/string_view.h"
@@ -39,6 +44,26 @@
 
 namespace mozc {
 namespace dictionary {
+namespace {
+
+// std::pair has no heterogeneous operator<, so compare through string_view
+// pairs to probe the stored std::string pairs with string_view queries.
+struct OrderByKeyValue {
+  static std::pair<absl::string_view, absl::string_view> View(
+      const std::pair<std::string, std::string> &kv) {
+    return {kv.first, kv.second};
+  }
+  static std::pair<absl::string_view, absl::string_view> View(
+      const std::pair<absl::string_view, absl::string_view> &kv) {
+    return kv;
+  }
+  template <typename Lhs, typename Rhs>
+  bool operator()(const Lhs &lhs, const Rhs &rhs) const {
+    return View(lhs) < View(rhs);
+  }
+};
+
+}  // namespace
 
 bool SuppressionDictionary::AddEntry(std::string key, std::string value)
     ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
@@ -69,37 +94,44 @@ void SuppressionDictionary::Lock() ABSL_EXCLUSIVE_LOCK_FUNCTION(mutex_) {
 }
 
 void SuppressionDictionary::UnLock() ABSL_UNLOCK_FUNCTION(mutex_) {
+  // Publish the edited contents as an immutable snapshot before releasing the
+  // lock, so that consumers never observe a half-edited dictionary.
+  auto snapshot = std::make_shared<Snapshot>();
+  snapshot->keys_values.assign(keys_values_.begin(), keys_values_.end());
+  snapshot->keys_only.assign(keys_only_.begin(), keys_only_.end());
+  snapshot->values_only.assign(values_only_.begin(), values_only_.end());
+  std::sort(snapshot->keys_values.begin(), snapshot->keys_values.end());
+  std::sort(snapshot->keys_only.begin(), snapshot->keys_only.end());
+  std::sort(snapshot->values_only.begin(), snapshot->values_only.end());
+  std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(snapshot));
   mutex_.Unlock();
 }
 
-bool SuppressionDictionary::IsEmpty() const {
-  if (mutex_.TryLock()) {
-    bool is_empty =
-        keys_only_.empty() && values_only_.empty() && keys_values_.empty();
-    mutex_.Unlock();
-    return is_empty;
-  }
+std::shared_ptr<const SuppressionDictionary::Snapshot>
+SuppressionDictionary::GetSnapshot() const {
+  return std::atomic_load(&snapshot_);
+}
 
-  return true;
+bool SuppressionDictionary::IsEmpty() const {
+  const std::shared_ptr<const Snapshot> snapshot = GetSnapshot();
+  return snapshot == nullptr || snapshot->empty();
 }
 
 bool SuppressionDictionary::SuppressEntry(const absl::string_view key,
                                           const absl::string_view value) const {
-  if (mutex_.TryLock()) {
-    if (keys_only_.empty() && values_only_.empty() && keys_values_.empty()) {
-      // Almost all users don't use word suppression function.
-      // We can return false as early as possible.
-      mutex_.Unlock();
-      return false;
-    }
-
-    bool suppress = keys_values_.contains(std::make_pair(key, value)) ||
-                    keys_only_.contains(key) || values_only_.contains(value);
-    mutex_.Unlock();
-    return suppress;
+  const std::shared_ptr<const Snapshot> snapshot = GetSnapshot();
+  if (snapshot == nullptr || snapshot->empty()) {
+    // Almost all users don't use word suppression function.
+    // We can return false as early as possible.
+    return false;
   }
-
-  return false;
+  return std::binary_search(snapshot->keys_values.begin(),
+                            snapshot->keys_values.end(),
+                            std::make_pair(key, value), OrderByKeyValue()) ||
+         std::binary_search(snapshot->keys_only.begin(),
+                            snapshot->keys_only.end(), key, std::less<>()) ||
+         std::binary_search(snapshot->values_only.begin(),
+                            snapshot->values_only.end(), value, std::less<>());
 }
 
 }  // namespace dictionary
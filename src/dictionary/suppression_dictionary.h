@@ -31,8 +31,10 @@
 #define MOZC_DICTIONARY_SUPPRESSION_DICTIONARY_H_
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_set.h"
@@ -44,10 +46,12 @@ namespace mozc {
 namespace dictionary {
 
 // Provides a functionality to test if a word should be suppressed in conversion
-// results. This class is not thread safe in general use but is safe under
-// single-producer single-consumer model, provided that the usage is correct. In
-// our usage, the producer is UserDictionary::UserDictionaryReloader thread and
-// the consumer is the main converter thread.
+// results. The producer edits the dictionary under Lock()/UnLock(); UnLock()
+// publishes the edited contents as an immutable snapshot, so consumers read
+// without taking any lock. Until a new snapshot is published, consumers keep
+// seeing the previous one. In our usage, the producer is
+// UserDictionary::UserDictionaryReloader thread and the consumers are the
+// converter threads.
 class ABSL_LOCKABLE SuppressionDictionary final {
  public:
   SuppressionDictionary() = default;
@@ -76,9 +80,10 @@ class ABSL_LOCKABLE SuppressionDictionary final {
   // Clears the dictionary.
   void Clear() ABSL_EXCLUSIVE_LOCKS_REQUIRED(this);
 
-  // Methods for the consumer thread. If the producer thread is updating the
-  // dictionary contents, the following methods behave as if the dictionary is
-  // empty.
+  // Methods for the consumer threads. These are lock-free: they read the
+  // snapshot published by the last UnLock(). While the producer thread is
+  // updating the dictionary contents, they keep answering from the previous
+  // snapshot.
 
   // Returns true if SuppressionDictionary doesn't have any entries.
   bool IsEmpty() const;
@@ -97,11 +102,33 @@ class ABSL_LOCKABLE SuppressionDictionary final {
     using is_transparent = void;
   };
 
+  // Immutable, sorted image of the dictionary published by UnLock(). The set
+  // is small and static between reloads, so sorted vectors probed by binary
+  // search beat a hash set on both footprint and locality.
+  struct Snapshot {
+    std::vector<KeyValue> keys_values;    // Sorted.
+    std::vector<std::string> keys_only;   // Sorted.
+    std::vector<std::string> values_only; // Sorted.
+
+    bool empty() const {
+      return keys_values.empty() && keys_only.empty() && values_only.empty();
+    }
+  };
+
+  // Returns the snapshot published by the last UnLock(), or nullptr if none
+  // has been published yet.
+  std::shared_ptr<const Snapshot> GetSnapshot() const;
+
+  // Pending edits made by the producer thread. Hash sets keep AddEntry() O(1)
+  // and deduplicated; UnLock() sorts them into the published snapshot.
   absl::flat_hash_set<KeyValue, KeyValueHash, KeyValueEq> keys_values_
       ABSL_GUARDED_BY(mutex_);
   absl::flat_hash_set<std::string> keys_only_ ABSL_GUARDED_BY(mutex_);
   absl::flat_hash_set<std::string> values_only_ ABSL_GUARDED_BY(mutex_);
 
+  // Accessed only through std::atomic_load/std::atomic_store.
+  std::shared_ptr<const Snapshot> snapshot_;
+
   mutable absl::Mutex mutex_;
 };
 
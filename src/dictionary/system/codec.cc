@@ -80,6 +80,8 @@ constexpr char kKeySectionName[] = "k";
 constexpr char kValueSectionName[] = "v";
 constexpr char kTokensSectionName[] = "t";
 constexpr char kPosSectionName[] = "p";
+constexpr char kKeyExistenceFilterSectionName[] = "f";
+constexpr char kReverseLookupIndexSectionName[] = "r";
 
 //// Constants for validation ////
 // 12 bits
@@ -213,6 +215,16 @@ std::string SystemDictionaryCodec::GetSectionNameForPos() const {
   return kPosSectionName;
 }
 
+std::string SystemDictionaryCodec::GetSectionNameForKeyExistenceFilter()
+    const {
+  return kKeyExistenceFilterSectionName;
+}
+
+std::string SystemDictionaryCodec::GetSectionNameForReverseLookupIndex()
+    const {
+  return kReverseLookupIndexSectionName;
+}
+
 void SystemDictionaryCodec::EncodeKey(const absl::string_view src,
                                       std::string *dst) const {
   EncodeDecodeKeyImpl(src, dst);
@@ -54,6 +54,12 @@ class SystemDictionaryCodec : public SystemDictionaryCodecInterface {
   // Return section name for frequent pos map
   std::string GetSectionNameForPos() const override;
 
+  // Returns section name for the key existence filter
+  std::string GetSectionNameForKeyExistenceFilter() const override;
+
+  // Returns the section name for the optional reverse lookup index
+  std::string GetSectionNameForReverseLookupIndex() const override;
+
   // Compresses key string into small bytes.
   void EncodeKey(absl::string_view src, std::string *dst) const override;
 
@@ -64,6 +64,12 @@ class SystemDictionaryCodecInterface {
   // Return section name for frequent pos map
   virtual std::string GetSectionNameForPos() const = 0;
 
+  // Returns section name for the key existence filter (optional section).
+  virtual std::string GetSectionNameForKeyExistenceFilter() const = 0;
+
+  // Gets section name for the optional reverse lookup index
+  virtual std::string GetSectionNameForReverseLookupIndex() const = 0;
+
   // Encode value(word) string
   virtual void EncodeValue(absl::string_view src, std::string *dst) const = 0;
 
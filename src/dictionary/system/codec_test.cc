@@ -320,6 +320,12 @@ class SystemDictionaryCodecMock : public SystemDictionaryCodecInterface {
   std::string GetSectionNameForValue() const override { return "Mock"; }
   std::string GetSectionNameForTokens() const override { return "Mock"; }
   std::string GetSectionNameForPos() const override { return "Mock"; }
+  std::string GetSectionNameForKeyExistenceFilter() const override {
+    return "Mock";
+  }
+  std::string GetSectionNameForReverseLookupIndex() const override {
+    return "Mock";
+  }
   void EncodeKey(const absl::string_view src, std::string *dst) const override {
   }
   void DecodeKey(const absl::string_view src, std::string *dst) const override {
@@ -0,0 +1,99 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZC_DICTIONARY_SYSTEM_REVERSE_LOOKUP_INDEX_SECTION_H_
+#define MOZC_DICTIONARY_SYSTEM_REVERSE_LOOKUP_INDEX_SECTION_H_
+
+#include <cstdint>
+
+#include "absl/strings/string_view.h"
+
+namespace mozc {
+namespace dictionary {
+
+// View of the optional reverse lookup index section of a system dictionary
+// file, written by SystemDictionaryBuilder behind
+// --output_reverse_lookup_index.  The section precomputes the mapping from
+// value trie ids to token positions that SystemDictionary otherwise derives
+// by scanning the whole token array, either on demand (ReverseLookupCache)
+// or at load time (ENABLE_REVERSE_LOOKUP_INDEX).
+//
+// Layout, all little endian and 4-byte aligned (dictionary file sections
+// start at 4-byte boundaries):
+//
+//   uint32 magic                       (kMagic)
+//   uint32 num_value_ids
+//   uint32 num_entries
+//   uint32 begin[num_value_ids + 1]    entries of value id v occupy
+//                                      [begin[v], begin[v + 1])
+//   int32  entries[2 * num_entries]    (tokens_offset, id_in_key_trie) pairs
+//                                      in token array scan order
+struct ReverseLookupIndexSection {
+  static constexpr uint32_t kMagic = 0x52564c49;  // "RVLI"
+
+  uint32_t num_value_ids = 0;
+  const uint32_t *begin = nullptr;
+  const int32_t *entries = nullptr;
+
+  // Points |section| into |data|.  Returns false if the data does not look
+  // like a reverse lookup index section (wrong magic or inconsistent sizes).
+  static bool Parse(const absl::string_view data,
+                    ReverseLookupIndexSection *section) {
+    constexpr size_t kHeaderSize = 3 * sizeof(uint32_t);
+    if (data.size() < kHeaderSize) {
+      return false;
+    }
+    const uint32_t *header = reinterpret_cast<const uint32_t *>(data.data());
+    if (header[0] != kMagic) {
+      return false;
+    }
+    const uint32_t num_value_ids = header[1];
+    const uint32_t num_entries = header[2];
+    const uint64_t expected_size =
+        kHeaderSize + (uint64_t{num_value_ids} + 1) * sizeof(uint32_t) +
+        uint64_t{num_entries} * 2 * sizeof(int32_t);
+    if (data.size() != expected_size) {
+      return false;
+    }
+    const uint32_t *begin = header + 3;
+    if (begin[num_value_ids] != num_entries) {
+      return false;
+    }
+    section->num_value_ids = num_value_ids;
+    section->begin = begin;
+    section->entries =
+        reinterpret_cast<const int32_t *>(begin + num_value_ids + 1);
+    return true;
+  }
+};
+
+}  // namespace dictionary
+}  // namespace mozc
+
+#endif  // MOZC_DICTIONARY_SYSTEM_REVERSE_LOOKUP_INDEX_SECTION_H_
@@ -62,6 +62,7 @@
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
+#include "base/hash.h"
 #include "base/japanese_util.h"
 #include "base/logging.h"
 #include "base/mmap.h"
@@ -73,6 +74,8 @@
 #include "dictionary/file/codec_interface.h"
 #include "dictionary/file/dictionary_file.h"
 #include "dictionary/system/codec_interface.h"
+#include "dictionary/system/reverse_lookup_index_section.h"
+#include "dictionary/system/token_scan_iterator.h"
 #include "dictionary/system/key_expansion_table.h"
 #include "dictionary/system/token_decode_iterator.h"
 #include "dictionary/system/words_info.h"
@@ -88,7 +91,6 @@ using ::mozc::storage::louds::LoudsTrie;
 
 namespace {
 
-constexpr int kMinTokenArrayBlobSize = 4;
 
 // TODO(noriyukit): The following parameters may not be well optimized.  In our
 // experiments, Select1 is computational burden, so increasing cache size for
@@ -98,6 +100,10 @@ constexpr size_t kKeyTrieLb1CacheSize = 1 * 1024;
 constexpr size_t kKeyTrieSelect0CacheSize = 4 * 1024;
 constexpr size_t kKeyTrieSelect1CacheSize = 4 * 1024;
 constexpr size_t kKeyTrieTermvecCacheSize = 1 * 1024;
+// Adaptive direct-mapped cache for mid-level key trie nodes, which are too
+// numerous for the contiguous select0 cache but skewed in access frequency.
+// Use LoudsTrie::GetHotNodeCacheStats to tune this per data set.
+constexpr size_t kKeyTrieHotNodeCacheSize = 16 * 1024;
 
 constexpr size_t kValueTrieLb0CacheSize = 1 * 1024;
 constexpr size_t kValueTrieLb1CacheSize = 1 * 1024;
@@ -105,6 +111,10 @@ constexpr size_t kValueTrieSelect0CacheSize = 1 * 1024;
 constexpr size_t kValueTrieSelect1CacheSize = 16 * 1024;
 constexpr size_t kValueTrieTermvecCacheSize = 4 * 1024;
 
+// Capacity of the hot token cache (see Options::ENABLE_HOT_TOKEN_CACHE);
+// the few thousand hottest keys account for most token decodes.
+constexpr size_t kHotTokenCacheSize = 4 * 1024;
+
 // Expansion table format:
 // "<Character to expand>[<Expanded character 1><Expanded character 2>...]"
 //
@@ -151,97 +161,6 @@ inline const uint8_t *GetTokenArrayPtr(const BitVectorBasedArray &token_array,
   return reinterpret_cast<const uint8_t *>(token_array.Get(key_id, &length));
 }
 
-// Iterator for scanning token array.
-// This iterator does not return actual token info but returns
-// id data and the position only.
-// This will be used only for reverse lookup.
-// Forward lookup does not need such iterator because it can access
-// a token directly without linear scan.
-//
-//  Usage:
-//    for (TokenScanIterator iter(codec_, token_array_);
-//         !iter.Done(); iter.Next()) {
-//      const TokenScanIterator::Result &result = iter.Get();
-//      // Do something with |result|.
-//    }
-class TokenScanIterator {
- public:
-  struct Result {
-    // Value id for the current token
-    int value_id;
-    // Index (= key id) for the current token
-    int index;
-    // Offset from the tokens section beginning.
-    // (token_array_->Get(id_in_key_trie) ==
-    //  token_array_->Get(0) + tokens_offset)
-    int tokens_offset;
-  };
-
-  TokenScanIterator(const TokenScanIterator &) = delete;
-  TokenScanIterator &operator=(const TokenScanIterator &) = delete;
-  TokenScanIterator(const SystemDictionaryCodecInterface *codec,
-                    const BitVectorBasedArray &token_array)
-      : codec_(codec),
-        termination_flag_(codec->GetTokensTerminationFlag()),
-        state_(HAS_NEXT),
-        offset_(0),
-        tokens_offset_(0),
-        index_(0) {
-    encoded_tokens_ptr_ = GetTokenArrayPtr(token_array, 0);
-    NextInternal();
-  }
-
-  ~TokenScanIterator() = default;
-
-  const Result &Get() const { return result_; }
-
-  bool Done() const { return state_ == DONE; }
-
-  void Next() {
-    DCHECK_NE(state_, DONE);
-    NextInternal();
-  }
-
- private:
-  enum State {
-    HAS_NEXT,
-    DONE,
-  };
-
-  void NextInternal() {
-    if (encoded_tokens_ptr_[offset_] == termination_flag_) {
-      state_ = DONE;
-      return;
-    }
-    int read_bytes;
-    result_.value_id = -1;
-    result_.index = index_;
-    result_.tokens_offset = tokens_offset_;
-    const bool is_last_token = !(codec_->ReadTokenForReverseLookup(
-        encoded_tokens_ptr_ + offset_, &result_.value_id, &read_bytes));
-    if (is_last_token) {
-      int tokens_size = offset_ + read_bytes - tokens_offset_;
-      if (tokens_size < kMinTokenArrayBlobSize) {
-        tokens_size = kMinTokenArrayBlobSize;
-      }
-      tokens_offset_ += tokens_size;
-      ++index_;
-      offset_ = tokens_offset_;
-    } else {
-      offset_ += read_bytes;
-    }
-  }
-
-  const SystemDictionaryCodecInterface *codec_;
-  const uint8_t *encoded_tokens_ptr_;
-  const uint8_t termination_flag_;
-  State state_;
-  Result result_;
-  int offset_;
-  int tokens_offset_;
-  int index_;
-};
-
 struct ReverseLookupResult {
   ReverseLookupResult() : tokens_offset(-1), id_in_key_trie(-1) {}
   // Offset from the tokens section beginning.
@@ -276,6 +195,12 @@ class SystemDictionary::ReverseLookupIndex {
  public:
   ReverseLookupIndex(const ReverseLookupIndex &) = delete;
   ReverseLookupIndex &operator=(const ReverseLookupIndex &) = delete;
+
+  // Serves lookups straight from the precomputed on-disk section; nothing
+  // is scanned or copied to heap.
+  explicit ReverseLookupIndex(const ReverseLookupIndexSection &section)
+      : section_(section), index_size_(0) {}
+
   ReverseLookupIndex(const SystemDictionaryCodecInterface *codec,
                      const BitVectorBasedArray &token_array) {
     // Gets id size.
@@ -339,6 +264,21 @@ class SystemDictionary::ReverseLookupIndex {
 
   void FillResultMap(const absl::btree_set<int> &id_set,
                      std::multimap<int, ReverseLookupResult> *result_map) {
+    if (section_.begin != nullptr) {
+      for (const int id : id_set) {
+        if (id < 0 || static_cast<uint32_t>(id) >= section_.num_value_ids) {
+          continue;
+        }
+        for (uint32_t i = section_.begin[id]; i < section_.begin[id + 1];
+             ++i) {
+          ReverseLookupResult result;
+          result.tokens_offset = section_.entries[2 * i];
+          result.id_in_key_trie = section_.entries[2 * i + 1];
+          result_map->insert(std::make_pair(id, result));
+        }
+      }
+      return;
+    }
     for (absl::btree_set<int>::const_iterator id_itr = id_set.begin();
          id_itr != id_set.end(); ++id_itr) {
       const ReverseLookupResultArray &result_array = index_[*id_itr];
@@ -358,6 +298,10 @@ class SystemDictionary::ReverseLookupIndex {
     size_t size;
   };
 
+  // When begin != nullptr, lookups are served from the mmapped section and
+  // index_ stays empty.
+  ReverseLookupIndexSection section_;
+
   // Use scoped array for reducing memory consumption as possible.
   std::unique_ptr<ReverseLookupResultArray[]> index_;
   size_t index_size_;
@@ -434,13 +378,34 @@ SystemDictionary::Builder::Build() {
   }
 
   if (!instance->OpenDictionaryFile(
-          (spec_->options & ENABLE_REVERSE_LOOKUP_INDEX) != 0)) {
+          (spec_->options & ENABLE_REVERSE_LOOKUP_INDEX) != 0,
+          (spec_->options & ENABLE_TOKEN_ARRAY_DIRECTORY) != 0,
+          (spec_->options & COMPACT_INDEX) != 0)) {
     return absl::UnknownError("Failed to create system dictionary");
   }
 
+  if ((spec_->options & ENABLE_HOT_TOKEN_CACHE) != 0) {
+    instance->hot_token_cache_ =
+        std::make_unique<HotTokenCache>(kHotTokenCacheSize);
+  }
+
   return instance;
 }
 
+std::shared_ptr<const std::vector<Token>> SystemDictionary::HotTokenCache::
+    Lookup(int key_id) const {
+  absl::MutexLock lock(&mutex_);
+  const std::shared_ptr<const std::vector<Token>> *cached =
+      cache_.Lookup(key_id);
+  return cached == nullptr ? nullptr : *cached;
+}
+
+void SystemDictionary::HotTokenCache::Insert(
+    int key_id, std::shared_ptr<const std::vector<Token>> tokens) {
+  absl::MutexLock lock(&mutex_);
+  cache_.Insert(key_id, std::move(tokens));
+}
+
 SystemDictionary::SystemDictionary(
     const SystemDictionaryCodecInterface *codec,
     const DictionaryFileCodecInterface *file_codec)
@@ -450,33 +415,63 @@ SystemDictionary::SystemDictionary(
 
 SystemDictionary::~SystemDictionary() = default;
 
-bool SystemDictionary::OpenDictionaryFile(bool enable_reverse_lookup_index) {
+bool SystemDictionary::OpenDictionaryFile(
+    bool enable_reverse_lookup_index, bool enable_token_array_directory,
+    bool compact_index) {
   int len;
 
+  // The compact configuration divides the sampled select directories by
+  // four and multiplies the rank chunks by four; see Options::COMPACT_INDEX.
+  const size_t cache_divisor = compact_index ? 4 : 1;
+  const int bitvec_chunk_size = compact_index ? 128 : 32;
+
   const uint8_t *key_image = reinterpret_cast<const uint8_t *>(
       dictionary_file_->GetSection(codec_->GetSectionNameForKey(), &len));
-  if (!key_trie_.Open(key_image, kKeyTrieLb0CacheSize, kKeyTrieLb1CacheSize,
-                      kKeyTrieSelect0CacheSize, kKeyTrieSelect1CacheSize,
-                      kKeyTrieTermvecCacheSize)) {
+  if (!key_trie_.Open(key_image, kKeyTrieLb0CacheSize / cache_divisor,
+                      kKeyTrieLb1CacheSize / cache_divisor,
+                      kKeyTrieSelect0CacheSize / cache_divisor,
+                      kKeyTrieSelect1CacheSize / cache_divisor,
+                      kKeyTrieTermvecCacheSize / cache_divisor,
+                      kKeyTrieHotNodeCacheSize / cache_divisor,
+                      bitvec_chunk_size)) {
     LOG(ERROR) << "cannot open key trie";
     return false;
   }
 
   BuildHiraganaExpansionTable(*codec_, &hiragana_expansion_table_);
 
+  // Optional section: absent in dictionaries built before the key existence
+  // filter was introduced.
+  const char *filter_image = dictionary_file_->GetSection(
+      codec_->GetSectionNameForKeyExistenceFilter(), &len);
+  if (filter_image != nullptr && len > 0) {
+    absl::StatusOr<storage::ExistenceFilter> filter =
+        storage::ExistenceFilter::Read(absl::MakeConstSpan(
+            reinterpret_cast<const uint32_t *>(filter_image),
+            len / sizeof(uint32_t)));
+    if (filter.ok()) {
+      key_existence_filter_ = *std::move(filter);
+    } else {
+      LOG(WARNING) << "Invalid key existence filter section: "
+                   << filter.status();
+    }
+  }
+
   const uint8_t *value_image = reinterpret_cast<const uint8_t *>(
       dictionary_file_->GetSection(codec_->GetSectionNameForValue(), &len));
-  if (!value_trie_.Open(value_image, kValueTrieLb0CacheSize,
-                        kValueTrieLb1CacheSize, kValueTrieSelect0CacheSize,
-                        kValueTrieSelect1CacheSize,
-                        kValueTrieTermvecCacheSize)) {
+  if (!value_trie_.Open(value_image, kValueTrieLb0CacheSize / cache_divisor,
+                        kValueTrieLb1CacheSize / cache_divisor,
+                        kValueTrieSelect0CacheSize / cache_divisor,
+                        kValueTrieSelect1CacheSize / cache_divisor,
+                        kValueTrieTermvecCacheSize / cache_divisor,
+                        /*louds_hot_node_cache_size=*/0, bitvec_chunk_size)) {
     LOG(ERROR) << "can not open value trie";
     return false;
   }
 
   const unsigned char *token_image = reinterpret_cast<const unsigned char *>(
       dictionary_file_->GetSection(codec_->GetSectionNameForTokens(), &len));
-  token_array_.Open(token_image);
+  token_array_.Open(token_image, enable_token_array_directory);
 
   frequent_pos_ = reinterpret_cast<const uint32_t *>(
       dictionary_file_->GetSection(codec_->GetSectionNameForPos(), &len));
@@ -485,17 +480,38 @@ bool SystemDictionary::OpenDictionaryFile(bool enable_reverse_lookup_index) {
     return false;
   }
 
-  if (enable_reverse_lookup_index) {
+  // The option gates the expensive in-heap index build, but when the
+  // dictionary file carries the precomputed section the index is a free
+  // mmap-backed view, so use it unconditionally.
+  if (enable_reverse_lookup_index || HasReverseLookupIndexSection()) {
     InitReverseLookupIndex();
   }
 
   return true;
 }
 
+bool SystemDictionary::HasReverseLookupIndexSection() const {
+  int len = 0;
+  return dictionary_file_->GetSection(
+             codec_->GetSectionNameForReverseLookupIndex(), &len) != nullptr;
+}
+
 void SystemDictionary::InitReverseLookupIndex() {
   if (reverse_lookup_index_ != nullptr) {
     return;
   }
+  // Prefer the precomputed section when the dictionary file carries one;
+  // falling back to deriving the index in heap by scanning the token array.
+  int section_len = 0;
+  const char *section_ptr = dictionary_file_->GetSection(
+      codec_->GetSectionNameForReverseLookupIndex(), &section_len);
+  ReverseLookupIndexSection section;
+  if (section_ptr != nullptr &&
+      ReverseLookupIndexSection::Parse(
+          absl::string_view(section_ptr, section_len), &section)) {
+    reverse_lookup_index_ = std::make_unique<ReverseLookupIndex>(section);
+    return;
+  }
   reverse_lookup_index_ =
       std::make_unique<ReverseLookupIndex>(codec_, token_array_);
 }
@@ -739,6 +755,11 @@ namespace {
 //     A functor of signature bool(const TokenInfo &).  Only tokens for which
 //     this functor returns true are passed to callback function.
 template <typename Func>
+// When |path_nodes| is non-null, it carries the descent path across calls:
+// (*path_nodes)[i] is the node reached by consuming encoded_key[0, i]. The
+// caller truncates it to the length of the common prefix with the previous
+// key, so the repeated part of the descent is skipped; nodes visited beyond
+// it are appended for the next call.
 void RunCallbackOnEachPrefix(const LoudsTrie &key_trie,
                              const LoudsTrie &value_trie,
                              const BitVectorBasedArray &token_array,
@@ -746,14 +767,26 @@ void RunCallbackOnEachPrefix(const LoudsTrie &key_trie,
                              const uint32_t *frequent_pos, const char *key,
                              absl::string_view encoded_key,
                              DictionaryInterface::Callback *callback,
-                             Func token_filter) {
+                             Func token_filter,
+                             std::vector<LoudsTrie::Node> *path_nodes =
+                                 nullptr,
+                             SystemDictionary::HotTokenCache *hot_token_cache =
+                                 nullptr) {
   typedef DictionaryInterface::Callback Callback;
   LoudsTrie::Node node;
   for (absl::string_view::size_type i = 0; i < encoded_key.size();) {
-    if (!key_trie.MoveToChildByLabel(encoded_key[i], &node)) {
-      return;
+    if (path_nodes != nullptr && i < path_nodes->size()) {
+      node = (*path_nodes)[i];
+      ++i;
+    } else {
+      if (!key_trie.MoveToChildByLabel(encoded_key[i], &node)) {
+        return;
+      }
+      ++i;  // Increment here for next loop and |encoded_prefix| below.
+      if (path_nodes != nullptr) {
+        path_nodes->push_back(node);
+      }
     }
-    ++i;  // Increment here for next loop and |encoded_prefix| defined below.
     if (!key_trie.IsTerminalNode(node)) {
       continue;
     }
@@ -782,6 +815,35 @@ void RunCallbackOnEachPrefix(const LoudsTrie &key_trie,
     }
 
     const int key_id = key_trie.GetKeyIdOfTerminalNode(node);
+
+    // Serve hot keys from the decoded-token cache. Only callers that select
+    // all tokens pass |hot_token_cache|, so the filter can be skipped.
+    if (hot_token_cache != nullptr) {
+      std::shared_ptr<const std::vector<Token>> tokens =
+          hot_token_cache->Lookup(key_id);
+      if (tokens == nullptr) {
+        auto decoded = std::make_shared<std::vector<Token>>();
+        for (TokenDecodeIterator iter(codec, value_trie, frequent_pos, prefix,
+                                      GetTokenArrayPtr(token_array, key_id));
+             !iter.Done(); iter.Next()) {
+          decoded->push_back(*iter.Get().token);
+        }
+        tokens = std::move(decoded);
+        hot_token_cache->Insert(key_id, tokens);
+      }
+      for (const Token &token : *tokens) {
+        const Callback::ResultType res =
+            callback->OnToken(prefix, prefix, token);
+        if (res == Callback::TRAVERSE_DONE || res == Callback::TRAVERSE_CULL) {
+          return;
+        }
+        if (res == Callback::TRAVERSE_NEXT_KEY) {
+          break;
+        }
+      }
+      continue;
+    }
+
     for (TokenDecodeIterator iter(codec, value_trie, frequent_pos, prefix,
                                   GetTokenArrayPtr(token_array, key_id));
          !iter.Done(); iter.Next()) {
@@ -851,9 +913,10 @@ class ReverseLookupCallbackWrapper : public DictionaryInterface::Callback {
 DictionaryInterface::Callback::ResultType
 SystemDictionary::LookupPrefixWithKeyExpansionImpl(
     const char *key, absl::string_view encoded_key,
-    const KeyExpansionTable &table, Callback *callback, LoudsTrie::Node node,
-    absl::string_view::size_type key_pos, int num_expanded,
-    char *actual_key_buffer, std::string *actual_prefix) const {
+    absl::Span<const ExpandedKey> expanded_keys, Callback *callback,
+    LoudsTrie::Node node, absl::string_view::size_type key_pos,
+    int num_expanded, char *actual_key_buffer,
+    std::string *actual_prefix) const {
   // This do-block handles a terminal node and callback.  do-block is used to
   // break the block and continue to the subsequent traversal phase.
   do {
@@ -907,7 +970,7 @@ SystemDictionary::LookupPrefixWithKeyExpansionImpl(
     return Callback::TRAVERSE_CONTINUE;
   }
   const char current_char = encoded_key[key_pos];
-  const ExpandedKey &chars = table.ExpandKey(current_char);
+  const ExpandedKey &chars = expanded_keys[key_pos];
   for (key_trie_.MoveToFirstChild(&node); key_trie_.IsValidNode(node);
        key_trie_.MoveToNextSibling(&node)) {
     const char c = key_trie_.GetEdgeLabelToParentNode(node);
@@ -916,7 +979,7 @@ SystemDictionary::LookupPrefixWithKeyExpansionImpl(
     }
     actual_key_buffer[key_pos] = c;
     const Callback::ResultType result = LookupPrefixWithKeyExpansionImpl(
-        key, encoded_key, table, callback, node, key_pos + 1,
+        key, encoded_key, expanded_keys, callback, node, key_pos + 1,
         num_expanded + static_cast<int>(c != current_char), actual_key_buffer,
         actual_prefix);
     if (result == Callback::TRAVERSE_DONE) {
@@ -936,21 +999,76 @@ void SystemDictionary::LookupPrefix(absl::string_view key,
   if (!conversion_request.IsKanaModifierInsensitiveConversion()) {
     RunCallbackOnEachPrefix(key_trie_, value_trie_, token_array_, codec_,
                             frequent_pos_, key.data(), encoded_key, callback,
-                            SelectAllTokens());
+                            SelectAllTokens(), nullptr,
+                            hot_token_cache_.get());
     return;
   }
 
+  // Precompute the expansion set of every key position once. The traversal
+  // already visits each trie node at most once (the key position is the only
+  // automaton state); this hoists the per-node table lookups to per depth.
+  std::vector<ExpandedKey> expanded_keys;
+  expanded_keys.reserve(encoded_key.size());
+  for (const char c : encoded_key) {
+    expanded_keys.push_back(hiragana_expansion_table_.ExpandKey(c));
+  }
+
   char actual_key_buffer[LoudsTrie::kMaxDepth + 1];
   std::string actual_prefix;
   actual_prefix.reserve(key.size() * 3);
   LookupPrefixWithKeyExpansionImpl(
-      key.data(), encoded_key, hiragana_expansion_table_, callback,
-      LoudsTrie::Node(), 0, false, actual_key_buffer, &actual_prefix);
+      key.data(), encoded_key, expanded_keys, callback, LoudsTrie::Node(), 0,
+      false, actual_key_buffer, &actual_prefix);
+}
+
+void SystemDictionary::LookupPrefixBatch(
+    absl::Span<const absl::string_view> keys,
+    const ConversionRequest &conversion_request, Callback *callback) const {
+  if (conversion_request.IsKanaModifierInsensitiveConversion()) {
+    // Key expansion branches per character, so there is no shared linear
+    // descent to reuse.
+    for (const absl::string_view key : keys) {
+      LookupPrefix(key, conversion_request, callback);
+    }
+    return;
+  }
+
+  std::vector<LoudsTrie::Node> path_nodes;
+  std::string prev_encoded_key;
+  std::string encoded_key;
+  for (const absl::string_view key : keys) {
+    encoded_key.clear();
+    codec_->EncodeKey(key, &encoded_key);
+
+    // Reuse the descent over the longest common prefix with the previous key.
+    size_t common_prefix_size = 0;
+    const size_t limit = std::min(
+        {prev_encoded_key.size(), encoded_key.size(), path_nodes.size()});
+    while (common_prefix_size < limit &&
+           prev_encoded_key[common_prefix_size] ==
+               encoded_key[common_prefix_size]) {
+      ++common_prefix_size;
+    }
+    path_nodes.resize(common_prefix_size);
+
+    RunCallbackOnEachPrefix(key_trie_, value_trie_, token_array_, codec_,
+                            frequent_pos_, key.data(), encoded_key, callback,
+                            SelectAllTokens(), &path_nodes,
+                            hot_token_cache_.get());
+    prev_encoded_key = encoded_key;
+  }
 }
 
 void SystemDictionary::LookupExact(absl::string_view key,
                                    const ConversionRequest &conversion_request,
                                    Callback *callback) const {
+  // Reject missing keys with one hash probe before the trie descent. Callers
+  // like the user history revert checks issue mostly missing keys.
+  if (key_existence_filter_.has_value() &&
+      !key_existence_filter_->Exists(Fingerprint(key))) {
+    return;
+  }
+
   // Find the key in the key trie.
   std::string encoded_key;
   codec_->EncodeKey(key, &encoded_key);
@@ -962,7 +1080,28 @@ void SystemDictionary::LookupExact(absl::string_view key,
     return;
   }
 
-  // Callback on each token.
+  // Callback on each token, via the decoded-token cache when enabled.
+  if (hot_token_cache_ != nullptr) {
+    std::shared_ptr<const std::vector<Token>> tokens =
+        hot_token_cache_->Lookup(key_id);
+    if (tokens == nullptr) {
+      auto decoded = std::make_shared<std::vector<Token>>();
+      for (TokenDecodeIterator iter(codec_, value_trie_, frequent_pos_, key,
+                                    GetTokenArrayPtr(token_array_, key_id));
+           !iter.Done(); iter.Next()) {
+        decoded->push_back(*iter.Get().token);
+      }
+      tokens = std::move(decoded);
+      hot_token_cache_->Insert(key_id, tokens);
+    }
+    for (const Token &token : *tokens) {
+      if (callback->OnToken(key, key, token) != Callback::TRAVERSE_CONTINUE) {
+        break;
+      }
+    }
+    return;
+  }
+
   for (TokenDecodeIterator iter(codec_, value_trie_, frequent_pos_, key,
                                 GetTokenArrayPtr(token_array_, key_id));
        !iter.Done(); iter.Next()) {
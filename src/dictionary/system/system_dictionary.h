@@ -32,21 +32,27 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/btree_set.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "dictionary/dictionary_interface.h"
 #include "dictionary/file/codec_interface.h"
 #include "dictionary/file/dictionary_file.h"
 #include "dictionary/system/codec_interface.h"
 #include "dictionary/system/key_expansion_table.h"
 #include "dictionary/system/words_info.h"
+#include "absl/synchronization/mutex.h"
 #include "request/conversion_request.h"
 #include "storage/louds/bit_vector_based_array.h"
+#include "storage/lru_cache.h"
+#include "storage/existence_filter.h"
 #include "storage/louds/louds_trie.h"
 
 namespace mozc {
@@ -61,6 +67,41 @@ class SystemDictionary : public DictionaryInterface {
     // from the id in value trie to the id in key trie.
     // That consumes more memory but we can perform reverse lookup more quickly.
     ENABLE_REVERSE_LOOKUP_INDEX = 1,
+    // If ENABLE_HOT_TOKEN_CACHE is set, the token lists of frequently looked
+    // up keys are kept fully decoded in an LRU cache, skipping the bit-level
+    // token decoding for the heavy hitters at the cost of some heap.
+    ENABLE_HOT_TOKEN_CACHE = 2,
+    // If ENABLE_TOKEN_ARRAY_DIRECTORY is set, a per-key offset directory of
+    // the token array is materialized at open time (4 bytes of heap per key),
+    // locating a token group with one indexed load instead of rank/select.
+    ENABLE_TOKEN_ARRAY_DIRECTORY = 4,
+    // If COMPACT_INDEX is set, the trie rank/select indexes are built in a
+    // compact configuration: 4x larger rank chunks and 4x smaller sampled
+    // select directories, cutting the index heap to roughly a quarter at
+    // the cost of slightly longer local scans per lookup (single-digit
+    // percent). Intended for memory-constrained targets; measure both modes
+    // with system_dictionary_benchmark.
+    COMPACT_INDEX = 8,
+  };
+
+  // Runtime-learned LRU cache from key id to its fully decoded token list.
+  // The mapping from key id to key string is fixed by the trie, so an entry
+  // stays valid for the lifetime of the dictionary. Thread-safe; values are
+  // shared_ptrs so readers iterate without holding the lock.
+  class HotTokenCache {
+   public:
+    explicit HotTokenCache(size_t capacity) : cache_(capacity) {}
+
+    std::shared_ptr<const std::vector<Token>> Lookup(
+        int key_id) const;
+    void Insert(int key_id,
+                std::shared_ptr<const std::vector<Token>> tokens);
+
+   private:
+    mutable absl::Mutex mutex_;
+    mutable storage::LruCache<int,
+                              std::shared_ptr<const std::vector<Token>>>
+        cache_ ABSL_GUARDED_BY(mutex_);
   };
 
   // Builder class for system dictionary
@@ -146,6 +187,15 @@ class SystemDictionary : public DictionaryInterface {
                     const ConversionRequest &conversion_request,
                     Callback *callback) const override;
 
+  // Equivalent to calling LookupPrefix for each key in order, but consecutive
+  // keys share the trie descent of their longest common prefix, amortizing
+  // the LOUDS traversal when the keys are related (raw key, expanded keys,
+  // katakana variant of one input event). Pass related keys adjacently to
+  // benefit. Kana-modifier-insensitive requests fall back to per-key lookup.
+  void LookupPrefixBatch(absl::Span<const absl::string_view> keys,
+                         const ConversionRequest &conversion_request,
+                         Callback *callback) const;
+
   void LookupExact(absl::string_view key,
                    const ConversionRequest &conversion_request,
                    Callback *callback) const override;
@@ -165,7 +215,9 @@ class SystemDictionary : public DictionaryInterface {
   SystemDictionary(const SystemDictionaryCodecInterface *codec,
                    const DictionaryFileCodecInterface *file_codec);
 
-  bool OpenDictionaryFile(bool enable_reverse_lookup_index);
+  bool OpenDictionaryFile(bool enable_reverse_lookup_index,
+                          bool enable_token_array_directory,
+                          bool compact_index);
 
   void RegisterReverseLookupTokensForT13N(absl::string_view value,
                                           Callback *callback) const;
@@ -177,10 +229,16 @@ class SystemDictionary : public DictionaryInterface {
                                     const ReverseLookupCache &cache,
                                     Callback *callback) const;
   void InitReverseLookupIndex();
+  // Returns true if the dictionary file carries the precomputed reverse
+  // lookup index section.
+  bool HasReverseLookupIndexSection() const;
 
+  // |expanded_keys| holds the expansion set of each encoded key position,
+  // precomputed once per lookup; expansion-aware traversal consults it per
+  // depth instead of re-deriving it per visited node.
   Callback::ResultType LookupPrefixWithKeyExpansionImpl(
       const char *key, absl::string_view encoded_key,
-      const KeyExpansionTable &table, Callback *callback,
+      absl::Span<const ExpandedKey> expanded_keys, Callback *callback,
       storage::louds::LoudsTrie::Node node,
       absl::string_view::size_type key_pos, int num_expanded,
       char *actual_key_buffer, std::string *actual_prefix) const;
@@ -193,6 +251,10 @@ class SystemDictionary : public DictionaryInterface {
   storage::louds::LoudsTrie value_trie_;
   storage::louds::BitVectorBasedArray token_array_;
   const uint32_t *frequent_pos_;
+  std::unique_ptr<HotTokenCache> hot_token_cache_;
+  // Bloom filter over all keys (optional dictionary section); LookupExact
+  // rejects missing keys with one hash probe instead of a trie descent.
+  std::optional<storage::ExistenceFilter> key_existence_filter_;
   const SystemDictionaryCodecInterface *codec_;
   KeyExpansionTable hiragana_expansion_table_;
   std::unique_ptr<DictionaryFile> dictionary_file_;
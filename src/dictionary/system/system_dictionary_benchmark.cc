@@ -27,3 +27,159 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+// Measures which parts of a system dictionary image a query workload
+// actually touches. Drives prefix and predictive lookups from a query file
+// against a mmapped dictionary image and reports the resident page count of
+// every dictionary section before and after the workload as TSV, so that
+// layout decisions (e.g. a frequency-partitioned token array) can be
+// validated per release against a representative typing corpus.
+//
+// Example:
+//   system_dictionary_benchmark \
+//     --dictionary_file=system.dictionary \
+//     --query_file=queries.tsv > working_set.tsv
+//
+// Note: the trie sections are partially touched at load time when their
+// rank/select caches are built; the after_load phase reports that baseline
+// so that the after_queries delta isolates the workload's own working set.
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "base/file_stream.h"
+#include "base/init_mozc.h"
+#include "base/logging.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "base/mmap.h"
+#include "dictionary/dictionary_interface.h"
+#include "dictionary/dictionary_token.h"
+#include "dictionary/file/codec_factory.h"
+#include "dictionary/file/dictionary_file.h"
+#include "dictionary/system/codec_interface.h"
+#include "dictionary/system/system_dictionary.h"
+#include "request/conversion_request.h"
+
+ABSL_FLAG(std::string, dictionary_file, "", "System dictionary image file.");
+ABSL_FLAG(std::string, query_file, "",
+          "Lookup keys, one per line; only the first tab-separated column is "
+          "used, so dictionary source TSV works as is.");
+ABSL_FLAG(int32_t, rounds, 1, "Number of passes over the queries.");
+ABSL_FLAG(bool, compact_index, false,
+          "Open the dictionary with SystemDictionary::COMPACT_INDEX to "
+          "measure the compact rank/select configuration against the "
+          "default one.");
+
+namespace mozc {
+namespace dictionary {
+namespace {
+
+class CountTokensCallback : public DictionaryInterface::Callback {
+ public:
+  ResultType OnToken(absl::string_view key, absl::string_view actual_key,
+                     const Token &token) override {
+    ++num_tokens_;
+    return TRAVERSE_CONTINUE;
+  }
+
+  int64_t num_tokens() const { return num_tokens_; }
+
+ private:
+  int64_t num_tokens_ = 0;
+};
+
+struct Section {
+  std::string name;
+  const char *data;
+  int size;
+};
+
+void PrintResidency(const std::vector<Section> &sections,
+                    absl::string_view phase) {
+  for (const Section &section : sections) {
+    std::cout << phase << '\t' << section.name << '\t' << section.size << '\t'
+              << Mmap::Residency(section.data, section.size) << '\n';
+  }
+}
+
+int BenchmarkMain() {
+  absl::StatusOr<Mmap> image = Mmap::Map(absl::GetFlag(FLAGS_dictionary_file));
+  CHECK_OK(image) << "Cannot map " << absl::GetFlag(FLAGS_dictionary_file);
+
+  // Locate the dictionary sections in the image for the residency probes.
+  const SystemDictionaryCodecInterface *codec =
+      SystemDictionaryCodecFactory::GetCodec();
+  DictionaryFile sections_file(DictionaryFileCodecFactory::GetCodec());
+  CHECK_OK(sections_file.OpenFromImage(image->begin(),
+                                       static_cast<int>(image->size())));
+  std::vector<Section> sections;
+  for (const std::string &name :
+       {codec->GetSectionNameForKey(), codec->GetSectionNameForValue(),
+        codec->GetSectionNameForTokens(), codec->GetSectionNameForPos(),
+        codec->GetSectionNameForKeyExistenceFilter()}) {
+    int size = 0;
+    if (const char *data = sections_file.GetSection(name, &size);
+        data != nullptr) {
+      sections.push_back({name, data, size});
+    }
+  }
+
+  std::vector<std::string> keys;
+  {
+    InputFileStream ifs(absl::GetFlag(FLAGS_query_file));
+    CHECK(ifs.good()) << "Cannot open " << absl::GetFlag(FLAGS_query_file);
+    std::string line;
+    while (std::getline(ifs, line)) {
+      const absl::string_view key =
+          absl::string_view(line).substr(0, line.find('\t'));
+      if (!key.empty()) {
+        keys.emplace_back(key);
+      }
+    }
+  }
+
+  SystemDictionary::Builder builder(image->begin(),
+                                    static_cast<int>(image->size()));
+  if (absl::GetFlag(FLAGS_compact_index)) {
+    builder.SetOptions(SystemDictionary::COMPACT_INDEX);
+  }
+  absl::StatusOr<std::unique_ptr<SystemDictionary>> dictionary =
+      builder.Build();
+  CHECK_OK(dictionary) << "Broken dictionary image";
+
+  std::cout << "phase\tsection\tsize_bytes\tresident_pages\n";
+  PrintResidency(sections, "after_load");
+
+  const ConversionRequest request;
+  CountTokensCallback callback;
+  const absl::Time start = absl::Now();
+  for (int round = 0; round < absl::GetFlag(FLAGS_rounds); ++round) {
+    for (const std::string &key : keys) {
+      (*dictionary)->LookupPrefix(key, request, &callback);
+      (*dictionary)->LookupPredictive(key, request, &callback);
+    }
+  }
+  const double ns_per_query =
+      absl::ToDoubleNanoseconds(absl::Now() - start) /
+      (2.0 * absl::GetFlag(FLAGS_rounds) * keys.size());
+  PrintResidency(sections, "after_queries");
+  std::cout << "# queries: " << keys.size()
+            << ", tokens: " << callback.num_tokens()
+            << ", ns/query: " << ns_per_query << '\n';
+  return 0;
+}
+
+}  // namespace
+}  // namespace dictionary
+}  // namespace mozc
+
+int main(int argc, char **argv) {
+  mozc::InitMozc(argv[0], &argc, &argv);
+  return mozc::dictionary::BenchmarkMain();
+}
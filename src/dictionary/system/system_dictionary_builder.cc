@@ -30,6 +30,7 @@
 #include "dictionary/system/system_dictionary_builder.h"
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
 #include <cstdint>
 #include <cstring>
@@ -49,6 +50,9 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "base/file_stream.h"
+#include "base/hash.h"
+#include "base/thread.h"
+#include "storage/existence_filter.h"
 #include "base/file_util.h"
 #include "base/japanese_util.h"
 #include "base/logging.h"
@@ -58,6 +62,8 @@
 #include "dictionary/file/codec_interface.h"
 #include "dictionary/file/section.h"
 #include "dictionary/system/codec_interface.h"
+#include "dictionary/system/reverse_lookup_index_section.h"
+#include "dictionary/system/token_scan_iterator.h"
 #include "dictionary/system/words_info.h"
 #include "storage/louds/bit_vector_based_array_builder.h"
 #include "storage/louds/louds_trie_builder.h"
@@ -66,11 +72,17 @@ ABSL_FLAG(bool, preserve_intermediate_dictionary, false,
           "preserve inetemediate dictionary file.");
 ABSL_FLAG(int32_t, min_key_length_to_use_small_cost_encoding, 6,
           "minimum key length to use 1 byte cost encoding.");
+ABSL_FLAG(bool, output_reverse_lookup_index, false,
+          "write the precomputed reverse lookup index section so that "
+          "reverse conversion skips the token array scan at runtime.");
 
 namespace mozc {
 namespace dictionary {
 namespace {
 
+// Number of worker threads sharding the per-key token encoding.
+constexpr size_t kTokenEncodeThreads = 8;
+
 struct TokenGreaterThan {
   bool operator()(const TokenInfo &lhs, const TokenInfo &rhs) const {
     if (lhs.token->lid != rhs.token->lid) {
@@ -111,9 +123,20 @@ void SystemDictionaryBuilder::BuildFromTokensInternal(
     std::vector<Token *> tokens) {
   KeyInfoList key_info_list = ReadTokens(std::move(tokens));
 
-  BuildFrequentPos(key_info_list);
-  BuildValueTrie(key_info_list);
-  BuildKeyTrie(key_info_list);
+  // The frequent POS table and the two tries only read key_info_list and
+  // write disjoint members, so the trie builds (dominated by sorting and
+  // bit-stream emission) run concurrently with the POS scan.
+  {
+    Thread value_trie_thread([this, &key_info_list] {
+      BuildValueTrie(key_info_list);
+    });
+    Thread key_trie_thread([this, &key_info_list] {
+      BuildKeyTrie(key_info_list);
+    });
+    BuildFrequentPos(key_info_list);
+    value_trie_thread.Join();
+    key_trie_thread.Join();
+  }
 
   SetIdForValue(&key_info_list);
   SetIdForKey(&key_info_list);
@@ -123,6 +146,7 @@ void SystemDictionaryBuilder::BuildFromTokensInternal(
   SetValueType(&key_info_list);
 
   BuildTokenArray(key_info_list);
+  BuildKeyExistenceFilter(key_info_list);
 }
 
 void SystemDictionaryBuilder::WriteToFile(
@@ -162,6 +186,21 @@ void SystemDictionaryBuilder::WriteToStream(
       file_codec_->GetSectionName(codec_->GetSectionNameForPos()));
   sections.push_back(frequent_pos_section);
 
+  DictionaryFileSection key_existence_filter_section(
+      key_existence_filter_image_.data(), key_existence_filter_image_.size(),
+      file_codec_->GetSectionName(
+          codec_->GetSectionNameForKeyExistenceFilter()));
+  sections.push_back(key_existence_filter_section);
+
+  std::string reverse_lookup_index_image;
+  if (absl::GetFlag(FLAGS_output_reverse_lookup_index)) {
+    BuildReverseLookupIndexImage(&reverse_lookup_index_image);
+    sections.push_back(DictionaryFileSection(
+        reverse_lookup_index_image.data(), reverse_lookup_index_image.size(),
+        file_codec_->GetSectionName(
+            codec_->GetSectionNameForReverseLookupIndex())));
+  }
+
   if (absl::GetFlag(FLAGS_preserve_intermediate_dictionary) &&
       !intermediate_output_file_base_path.empty()) {
     // Write out intermediate results to files.
@@ -179,6 +218,71 @@ void SystemDictionaryBuilder::WriteToStream(
   LOG(INFO) << "Start writing dictionary file... done.";
 }
 
+void SystemDictionaryBuilder::BuildReverseLookupIndexImage(
+    std::string *image) const {
+  // Scan the just-built token array exactly the way the runtime would, so
+  // the section reproduces what ReverseLookupIndex derives in memory.
+  storage::louds::BitVectorBasedArray token_array;
+  token_array.Open(
+      reinterpret_cast<const uint8_t *>(token_array_builder_.image().data()));
+
+  uint32_t num_value_ids = 0;
+  uint32_t num_entries = 0;
+  for (TokenScanIterator iter(codec_, token_array); !iter.Done();
+       iter.Next()) {
+    const TokenScanIterator::Result &result = iter.Get();
+    if (result.value_id == -1) {
+      continue;
+    }
+    num_value_ids =
+        std::max(num_value_ids, static_cast<uint32_t>(result.value_id) + 1);
+    ++num_entries;
+  }
+
+  // Count entries per value id, then turn the counts into [begin, end)
+  // offsets by prefix summing.
+  std::vector<uint32_t> begin(num_value_ids + 1, 0);
+  for (TokenScanIterator iter(codec_, token_array); !iter.Done();
+       iter.Next()) {
+    const TokenScanIterator::Result &result = iter.Get();
+    if (result.value_id != -1) {
+      ++begin[result.value_id + 1];
+    }
+  }
+  for (size_t i = 1; i < begin.size(); ++i) {
+    begin[i] += begin[i - 1];
+  }
+
+  std::vector<int32_t> entries(2 * static_cast<size_t>(num_entries), 0);
+  std::vector<uint32_t> next(begin.begin(), begin.end() - 1);
+  for (TokenScanIterator iter(codec_, token_array); !iter.Done();
+       iter.Next()) {
+    const TokenScanIterator::Result &result = iter.Get();
+    if (result.value_id == -1) {
+      continue;
+    }
+    const uint32_t slot = next[result.value_id]++;
+    entries[2 * slot] = result.tokens_offset;
+    entries[2 * slot + 1] = result.index;
+  }
+  token_array.Close();
+
+  const uint32_t header[3] = {ReverseLookupIndexSection::kMagic, num_value_ids,
+                              num_entries};
+  image->clear();
+  image->reserve(sizeof(header) + begin.size() * sizeof(uint32_t) +
+                 entries.size() * sizeof(int32_t));
+  image->append(reinterpret_cast<const char *>(header), sizeof(header));
+  image->append(reinterpret_cast<const char *>(begin.data()),
+                begin.size() * sizeof(uint32_t));
+  image->append(reinterpret_cast<const char *>(entries.data()),
+                entries.size() * sizeof(int32_t));
+
+  LOG(INFO) << "Reverse lookup index section: " << num_value_ids
+            << " value ids, " << num_entries << " entries, " << image->size()
+            << " bytes";
+}
+
 namespace {
 
 uint32_t GetCombinedPos(uint16_t lid, uint16_t rid) {
@@ -451,6 +555,38 @@ void SystemDictionaryBuilder::SetIdForKey(KeyInfoList *key_info_list) const {
   }
 }
 
+void SystemDictionaryBuilder::BuildKeyExistenceFilter(
+    const KeyInfoList &key_info_list) {
+  if (key_info_list.empty()) {
+    return;
+  }
+  // ~1% false positives; LookupExact misses then cost one hash probe instead
+  // of a full trie descent.
+  constexpr float kErrorRate = 0.01;
+  const size_t size_in_bytes =
+      storage::ExistenceFilterBuilder::MinFilterSizeInBytesForErrorRate(
+          kErrorRate, key_info_list.size());
+  storage::ExistenceFilterBuilder filter_builder(
+      storage::ExistenceFilterBuilder::CreateOptimal(size_in_bytes,
+                                                     key_info_list.size()));
+  for (const KeyInfo &key_info : key_info_list) {
+    filter_builder.Insert(Fingerprint(key_info.key));
+  }
+  key_existence_filter_image_ = filter_builder.SerializeAsString();
+}
+
+// Layout note (evaluated): packing high-frequency tokens contiguously in
+// leading pages (hot/cold splitting by corpus rank) was considered so that
+// the working set of typical typing fits in a few resident pages. It does
+// not fit this format: token blocks are stored in key-trie id order and the
+// runtime derives the block position directly from the LOUDS id, so
+// frequency-ordering the blocks would need either an id->position remap
+// table (an extra random access on every lookup) or frequency-aware id
+// assignment inside the trie builder, both format changes that invalidate
+// every existing image. Use
+// //dictionary/system:system_dictionary_benchmark (see also
+// dictionary_working_set() in converter/evaluation.bzl) to measure the
+// per-section working set of a query corpus before revisiting.
 void SystemDictionaryBuilder::BuildTokenArray(
     const KeyInfoList &key_info_list) {
   // Here we make a reverse lookup table as follows:
@@ -463,9 +599,29 @@ void SystemDictionaryBuilder::BuildTokenArray(
       id_to_keyinfo_table[id] = &key_info;
     }
 
-    for (const KeyInfo *key_info : id_to_keyinfo_table) {
-      std::string tokens_str;
-      codec_->EncodeTokens(key_info->tokens, &tokens_str);
+    // Token encoding is independent per key; shard it across worker threads
+    // pulling ids from a shared counter, then append the results in id order.
+    std::vector<std::string> encoded_tokens(id_to_keyinfo_table.size());
+    {
+      std::atomic<size_t> next_id = 0;
+      std::vector<Thread> threads;
+      threads.reserve(kTokenEncodeThreads);
+      for (size_t i = 0; i < kTokenEncodeThreads; ++i) {
+        threads.emplace_back(
+            [this, &id_to_keyinfo_table, &encoded_tokens, &next_id] {
+              for (size_t id = next_id.fetch_add(1);
+                   id < id_to_keyinfo_table.size();
+                   id = next_id.fetch_add(1)) {
+                codec_->EncodeTokens(id_to_keyinfo_table[id]->tokens,
+                                     &encoded_tokens[id]);
+              }
+            });
+      }
+      for (Thread &thread : threads) {
+        thread.Join();
+      }
+    }
+    for (const std::string &tokens_str : encoded_tokens) {
       token_array_builder_.Add(tokens_str);
     }
   }
@@ -83,6 +83,11 @@ class SystemDictionaryBuilder final {
  private:
   using KeyInfoList = std::deque<KeyInfo>;
 
+  // Serializes the reverse lookup index section (value id -> token
+  // positions) derived by scanning the built token array.  Enabled by
+  // --output_reverse_lookup_index.
+  void BuildReverseLookupIndexImage(std::string *image) const;
+
   // Build process needs to make a copy of input token pointers. Therefore, make
   // a copy at call site, which is helpful to efficiently support the above two
   // versions of BuildFromTokens() without extra copying.
@@ -94,6 +99,7 @@ class SystemDictionaryBuilder final {
   void BuildValueTrie(const KeyInfoList &key_info_list);
   void BuildKeyTrie(const KeyInfoList &key_info_list);
   void BuildTokenArray(const KeyInfoList &key_info_list);
+  void BuildKeyExistenceFilter(const KeyInfoList &key_info_list);
 
   void SetIdForValue(KeyInfoList *key_info_list) const;
   void SetIdForKey(KeyInfoList *key_info_list) const;
@@ -109,6 +115,8 @@ class SystemDictionaryBuilder final {
 
   // mapping from {left_id, right_id} to POS index (0--255)
   std::map<uint32_t, int> frequent_pos_;
+  // Serialized bloom filter over all keys (see BuildKeyExistenceFilter).
+  std::string key_existence_filter_image_;
 
   const SystemDictionaryCodecInterface *codec_ =
       SystemDictionaryCodecFactory::GetCodec();
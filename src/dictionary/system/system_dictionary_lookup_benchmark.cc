@@ -0,0 +1,137 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Microbenchmarks of the SystemDictionary lookup families over the mock
+// data manager dictionary image.
+//
+// Run: bazel run -c opt //dictionary/system:system_dictionary_lookup_benchmark
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "base/logging.h"
+#include "benchmark/benchmark.h"
+#include "data_manager/testing/mock_data_manager.h"
+#include "dictionary/dictionary_interface.h"
+#include "dictionary/dictionary_token.h"
+#include "dictionary/system/system_dictionary.h"
+#include "request/conversion_request.h"
+
+namespace mozc {
+namespace dictionary {
+namespace {
+
+class CountTokensCallback : public DictionaryInterface::Callback {
+ public:
+  ResultType OnToken(absl::string_view key, absl::string_view actual_key,
+                     const Token &token) override {
+    ++num_tokens_;
+    return TRAVERSE_CONTINUE;
+  }
+  int64_t num_tokens() const { return num_tokens_; }
+
+ private:
+  int64_t num_tokens_ = 0;
+};
+
+std::unique_ptr<SystemDictionary> CreateDictionary() {
+  static const testing::MockDataManager *data_manager =
+      new testing::MockDataManager;
+  const char *data = nullptr;
+  int size = 0;
+  data_manager->GetSystemDictionaryData(&data, &size);
+  absl::StatusOr<std::unique_ptr<SystemDictionary>> dictionary =
+      SystemDictionary::Builder(data, size).Build();
+  CHECK_OK(dictionary);
+  return *std::move(dictionary);
+}
+
+const std::vector<std::string> &Keys() {
+  static const std::vector<std::string> *keys = new std::vector<std::string>(
+      {"あい", "あいう", "かまぼこ", "てすと", "もずく", "きょう"});
+  return *keys;
+}
+
+void BM_LookupPrefix(benchmark::State &state) {
+  const std::unique_ptr<SystemDictionary> dictionary = CreateDictionary();
+  const ConversionRequest request;
+  CountTokensCallback callback;
+  size_t i = 0;
+  for (auto _ : state) {
+    dictionary->LookupPrefix(Keys()[i++ % Keys().size()], request, &callback);
+  }
+  benchmark::DoNotOptimize(callback.num_tokens());
+}
+BENCHMARK(BM_LookupPrefix);
+
+void BM_LookupPredictive(benchmark::State &state) {
+  const std::unique_ptr<SystemDictionary> dictionary = CreateDictionary();
+  const ConversionRequest request;
+  CountTokensCallback callback;
+  size_t i = 0;
+  for (auto _ : state) {
+    dictionary->LookupPredictive(Keys()[i++ % Keys().size()], request,
+                                 &callback);
+  }
+  benchmark::DoNotOptimize(callback.num_tokens());
+}
+BENCHMARK(BM_LookupPredictive);
+
+void BM_LookupExact(benchmark::State &state) {
+  const std::unique_ptr<SystemDictionary> dictionary = CreateDictionary();
+  const ConversionRequest request;
+  CountTokensCallback callback;
+  size_t i = 0;
+  for (auto _ : state) {
+    dictionary->LookupExact(Keys()[i++ % Keys().size()], request, &callback);
+  }
+  benchmark::DoNotOptimize(callback.num_tokens());
+}
+BENCHMARK(BM_LookupExact);
+
+void BM_LookupReverse(benchmark::State &state) {
+  const std::unique_ptr<SystemDictionary> dictionary = CreateDictionary();
+  const ConversionRequest request;
+  CountTokensCallback callback;
+  size_t i = 0;
+  for (auto _ : state) {
+    dictionary->LookupReverse(Keys()[i++ % Keys().size()], request, &callback);
+  }
+  benchmark::DoNotOptimize(callback.num_tokens());
+}
+BENCHMARK(BM_LookupReverse);
+
+}  // namespace
+}  // namespace dictionary
+}  // namespace mozc
@@ -265,6 +265,73 @@ TEST_F(SystemDictionaryTest, NormalWord) {
   EXPECT_TRUE(callback.tokens().empty());
 }
 
+TEST_F(SystemDictionaryTest, LookupPrefixBatch) {
+  std::vector<Token> tokens = {
+      {"あい", "愛", 100, 50, 70, Token::NONE},
+      {"あいす", "アイス", 100, 50, 70, Token::NONE},
+      {"あお", "青", 100, 50, 70, Token::NONE},
+      {"かき", "柿", 100, 50, 70, Token::NONE},
+  };
+  std::vector<Token *> source_tokens = MakeTokenPointers(&tokens);
+  std::unique_ptr<SystemDictionary> system_dic = BuildSystemDictionary(
+      source_tokens, absl::GetFlag(FLAGS_dictionary_test_size));
+  ASSERT_TRUE(system_dic);
+
+  // A batch over related keys must produce exactly the same stream as the
+  // equivalent sequence of LookupPrefix calls.
+  const std::vector<absl::string_view> keys = {"あいす", "あいする", "あお",
+                                               "かき", "ぬぬぬ"};
+  CollectTokenCallback batch_callback;
+  system_dic->LookupPrefixBatch(keys, convreq_, &batch_callback);
+
+  CollectTokenCallback sequential_callback;
+  for (const absl::string_view key : keys) {
+    system_dic->LookupPrefix(key, convreq_, &sequential_callback);
+  }
+
+  ASSERT_EQ(batch_callback.tokens().size(),
+            sequential_callback.tokens().size());
+  for (size_t i = 0; i < batch_callback.tokens().size(); ++i) {
+    EXPECT_TOKEN_EQ(batch_callback.tokens()[i],
+                    sequential_callback.tokens()[i]);
+  }
+}
+
+TEST_F(SystemDictionaryTest, HotTokenCache) {
+  std::vector<Token> tokens = {
+      {"あい", "愛", 100, 50, 70, Token::NONE},
+      {"あい", "相", 150, 100, 200, Token::NONE},
+      {"あいす", "アイス", 100, 50, 70, Token::NONE},
+  };
+  std::vector<Token *> source_tokens = MakeTokenPointers(&tokens);
+  BuildAndWriteSystemDictionary(source_tokens,
+                                absl::GetFlag(FLAGS_dictionary_test_size),
+                                dic_fn_);
+  std::unique_ptr<SystemDictionary> system_dic =
+      SystemDictionary::Builder(dic_fn_)
+          .SetOptions(SystemDictionary::ENABLE_HOT_TOKEN_CACHE)
+          .Build()
+          .value();
+  ASSERT_TRUE(system_dic);
+
+  // The second lookup of the same key is served from the decoded-token cache
+  // and must produce the identical token stream.
+  CollectTokenCallback first_callback;
+  system_dic->LookupPrefix("あいす", convreq_, &first_callback);
+  CollectTokenCallback second_callback;
+  system_dic->LookupPrefix("あいす", convreq_, &second_callback);
+  ASSERT_EQ(first_callback.tokens().size(), second_callback.tokens().size());
+  for (size_t i = 0; i < first_callback.tokens().size(); ++i) {
+    EXPECT_TOKEN_EQ(first_callback.tokens()[i], second_callback.tokens()[i]);
+  }
+  EXPECT_EQ(first_callback.tokens().size(), 3);
+
+  // LookupExact also goes through the cache.
+  CollectTokenCallback exact_callback;
+  system_dic->LookupExact("あい", convreq_, &exact_callback);
+  EXPECT_EQ(exact_callback.tokens().size(), 2);
+}
+
 TEST_F(SystemDictionaryTest, SameWord) {
   std::vector<Token> tokens = {
       {"あ", "亜", 100, 50, 70, Token::NONE},
@@ -0,0 +1,141 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZC_DICTIONARY_SYSTEM_TOKEN_SCAN_ITERATOR_H_
+#define MOZC_DICTIONARY_SYSTEM_TOKEN_SCAN_ITERATOR_H_
+
+#include <cstdint>
+
+#include "base/logging.h"
+#include "dictionary/system/codec_interface.h"
+#include "storage/louds/bit_vector_based_array.h"
+
+namespace mozc {
+namespace dictionary {
+
+// Iterator for scanning token array.
+// This iterator does not return actual token info but returns
+// id data and the position only.
+// This will be used only for reverse lookup.
+// Forward lookup does not need such iterator because it can access
+// a token directly without linear scan.
+//
+//  Usage:
+//    for (TokenScanIterator iter(codec_, token_array_);
+//         !iter.Done(); iter.Next()) {
+//      const TokenScanIterator::Result &result = iter.Get();
+//      // Do something with |result|.
+//    }
+class TokenScanIterator {
+ public:
+  // The minimum byte length of an encoded token blob in the token array.
+  static constexpr int kMinTokenArrayBlobSize = 4;
+
+  struct Result {
+    // Value id for the current token
+    int value_id;
+    // Index (= key id) for the current token
+    int index;
+    // Offset from the tokens section beginning.
+    // (token_array_->Get(id_in_key_trie) ==
+    //  token_array_->Get(0) + tokens_offset)
+    int tokens_offset;
+  };
+
+  TokenScanIterator(const TokenScanIterator &) = delete;
+  TokenScanIterator &operator=(const TokenScanIterator &) = delete;
+  TokenScanIterator(const SystemDictionaryCodecInterface *codec,
+                    const storage::louds::BitVectorBasedArray &token_array)
+      : codec_(codec),
+        termination_flag_(codec->GetTokensTerminationFlag()),
+        state_(HAS_NEXT),
+        offset_(0),
+        tokens_offset_(0),
+        index_(0) {
+    size_t dummy_length = 0;
+    encoded_tokens_ptr_ =
+        reinterpret_cast<const uint8_t *>(token_array.Get(0, &dummy_length));
+    NextInternal();
+  }
+
+  ~TokenScanIterator() = default;
+
+  const Result &Get() const { return result_; }
+
+  bool Done() const { return state_ == DONE; }
+
+  void Next() {
+    DCHECK_NE(state_, DONE);
+    NextInternal();
+  }
+
+ private:
+  enum State {
+    HAS_NEXT,
+    DONE,
+  };
+
+  void NextInternal() {
+    if (encoded_tokens_ptr_[offset_] == termination_flag_) {
+      state_ = DONE;
+      return;
+    }
+    int read_bytes;
+    result_.value_id = -1;
+    result_.index = index_;
+    result_.tokens_offset = tokens_offset_;
+    const bool is_last_token = !(codec_->ReadTokenForReverseLookup(
+        encoded_tokens_ptr_ + offset_, &result_.value_id, &read_bytes));
+    if (is_last_token) {
+      int tokens_size = offset_ + read_bytes - tokens_offset_;
+      if (tokens_size < kMinTokenArrayBlobSize) {
+        tokens_size = kMinTokenArrayBlobSize;
+      }
+      tokens_offset_ += tokens_size;
+      ++index_;
+      offset_ = tokens_offset_;
+    } else {
+      offset_ += read_bytes;
+    }
+  }
+
+  const SystemDictionaryCodecInterface *codec_;
+  const uint8_t *encoded_tokens_ptr_;
+  const uint8_t termination_flag_;
+  State state_;
+  Result result_;
+  int offset_;
+  int tokens_offset_;
+  int index_;
+};
+
+}  // namespace dictionary
+}  // namespace mozc
+
+#endif  // MOZC_DICTIONARY_SYSTEM_TOKEN_SCAN_ITERATOR_H_
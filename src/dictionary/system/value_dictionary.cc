@@ -29,6 +29,7 @@
 
 #include "dictionary/system/value_dictionary.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <queue>
 #include <string>
@@ -67,6 +68,12 @@ bool ValueDictionary::HasValue(absl::string_view value) const { return false; }
 
 namespace {
 
+// Upper bound of terminal nodes delivered per predictive lookup. The
+// breadth-first traversal yields completions shortest first and every token
+// shares the same constant cost, so enumeration beyond the first K terminals
+// only produces long completions that the predictor discards anyway.
+constexpr size_t kPredictiveBeamSize = 128;
+
 // A version of the above function for Token.
 inline void FillToken(const uint16_t suggestion_only_word_id,
                       absl::string_view key, Token *token) {
@@ -134,7 +141,12 @@ void ValueDictionary::LookupPredictive(
   value.reserve(key.size() * 2);
   Token token;
 
-  // Traverse subtree rooted at |node|.
+  // Traverse the subtree rooted at |node| breadth first, so completions are
+  // delivered shortest first. All value dictionary tokens share one constant
+  // cost, so the shortest completions are also the ones the predictor keeps;
+  // cap the enumeration at kPredictiveBeamSize terminals instead of walking
+  // the entire subtree, whose size explodes for short keys.
+  size_t num_terminals = 0;
   std::queue<LoudsTrie::Node> queue;
   queue.push(node);
   do {
@@ -152,6 +164,9 @@ void ValueDictionary::LookupPredictive(
         default:
           break;
       }
+      if (++num_terminals >= kPredictiveBeamSize) {
+        return;
+      }
     }
 
     for (value_trie_->MoveToFirstChild(&node); value_trie_->IsValidNode(node);
@@ -34,6 +34,7 @@
 #include "dictionary/text_dictionary_loader.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
 #include <limits>
@@ -44,13 +45,16 @@
 
 #include "absl/base/attributes.h"
 #include "absl/flags/flag.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "base/japanese_util.h"
 #include "base/logging.h"
+#include "base/mmap.h"
 #include "base/multifile.h"
+#include "base/thread.h"
 #include "base/util.h"
 #include "base/vlog.h"
 #include "dictionary/dictionary_token.h"
@@ -151,6 +155,57 @@ void TextDictionaryLoader::Load(
   LoadWithLineLimit(dictionary_filename, reading_correction_filename, -1);
 }
 
+namespace {
+
+// Number of parser shards for large dictionary sources; small inputs are
+// parsed serially.
+constexpr size_t kParseShards = 8;
+constexpr size_t kParallelParseMinBytes = 1 << 20;
+
+// Splits |text| into up to |num_shards| contiguous chunks ending on newline
+// boundaries (the last chunk takes any unterminated tail).
+std::vector<absl::string_view> ShardOnLineBoundaries(
+    const absl::string_view text, const size_t num_shards) {
+  std::vector<absl::string_view> shards;
+  const size_t target = text.size() / num_shards + 1;
+  size_t begin = 0;
+  while (begin < text.size()) {
+    size_t end = begin + target;
+    if (end >= text.size()) {
+      end = text.size();
+    } else {
+      const size_t newline = text.find('\n', end);
+      end = newline == absl::string_view::npos ? text.size() : newline + 1;
+    }
+    shards.push_back(text.substr(begin, end - begin));
+    begin = end;
+  }
+  return shards;
+}
+
+}  // namespace
+
+// Parses every line of |shard| (a sequence of whole lines); the lines are
+// string_views into the mapped file, so no per-line copy is made.
+std::vector<std::unique_ptr<Token>> TextDictionaryLoader::ParseShard(
+    absl::string_view shard) const {
+  std::vector<std::unique_ptr<Token>> tokens;
+  while (!shard.empty()) {
+    const size_t newline = shard.find('\n');
+    absl::string_view line = shard.substr(0, newline);
+    shard.remove_prefix(newline == absl::string_view::npos ? shard.size()
+                                                           : newline + 1);
+    while (!line.empty() && (line.back() == '\r' || line.back() == '\n')) {
+      line.remove_suffix(1);
+    }
+    std::unique_ptr<Token> token = ParseTSVLine(line);
+    if (token) {
+      tokens.push_back(std::move(token));
+    }
+  }
+  return tokens;
+}
+
 void TextDictionaryLoader::LoadWithLineLimit(
     const absl::string_view dictionary_filename,
     const absl::string_view reading_correction_filename, int limit) {
@@ -164,9 +219,43 @@ void TextDictionaryLoader::LoadWithLineLimit(
     tokens_.reserve(limit);
   }
 
-  // Read system dictionary.
-  {
-    InputMultiFile file(dictionary_filename);
+  // Read system dictionary. Each source file is mapped and parsed by shards
+  // on worker threads; the shards are contiguous, so concatenating their
+  // results in order yields exactly the serial parse order. Files that
+  // cannot be mapped fall back to the line reader.
+  for (const absl::string_view filename :
+       absl::StrSplit(dictionary_filename, ',', absl::SkipEmpty())) {
+    if (limit <= 0) {
+      break;
+    }
+    const absl::StatusOr<Mmap> mmap = Mmap::Map(std::string(filename));
+    if (mmap.ok() && mmap->size() >= kParallelParseMinBytes) {
+      const std::vector<absl::string_view> shards = ShardOnLineBoundaries(
+          absl::string_view(mmap->begin(), mmap->size()), kParseShards);
+      std::vector<std::vector<std::unique_ptr<Token>>> results(shards.size());
+      {
+        std::vector<Thread> workers;
+        workers.reserve(shards.size());
+        for (size_t i = 0; i < shards.size(); ++i) {
+          workers.emplace_back(
+              [this, &shards, &results, i] { results[i] = ParseShard(shards[i]); });
+        }
+        for (Thread &worker : workers) {
+          worker.Join();
+        }
+      }
+      for (std::vector<std::unique_ptr<Token>> &result : results) {
+        for (std::unique_ptr<Token> &token : result) {
+          if (limit <= 0) {
+            break;
+          }
+          tokens_.push_back(std::move(token));
+          --limit;
+        }
+      }
+      continue;
+    }
+    InputMultiFile file(filename);
     std::string line;
     while (limit > 0 && file.ReadLine(&line)) {
       Util::ChopReturns(&line);
@@ -176,8 +265,8 @@ void TextDictionaryLoader::LoadWithLineLimit(
         --limit;
       }
     }
-    LOG(INFO) << tokens_.size() << " tokens from " << dictionary_filename;
   }
+  LOG(INFO) << tokens_.size() << " tokens from " << dictionary_filename;
 
   if (reading_correction_filename.empty() || limit <= 0) {
     return;
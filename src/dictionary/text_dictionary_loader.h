@@ -99,6 +99,11 @@ class TextDictionaryLoader {
   bool RewriteSpecialToken(Token *token, absl::string_view label) const;
 
   std::unique_ptr<Token> ParseTSVLine(absl::string_view line) const;
+
+  // Parses a contiguous block of whole lines (used by the sharded parallel
+  // load; the lines are views into the mapped source file).
+  std::vector<std::unique_ptr<Token>> ParseShard(
+      absl::string_view shard) const;
   std::unique_ptr<Token> ParseTSV(
       const std::vector<absl::string_view> &columns) const;
 
@@ -40,11 +40,11 @@
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/ascii.h"
-#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
@@ -74,30 +74,32 @@ namespace mozc {
 namespace dictionary {
 namespace {
 
+// The sorted view holds pointers into the per-dictionary sections (see
+// TokensIndex), so the comparators take Token pointers.
 struct OrderByKey {
-  bool operator()(const UserPos::Token &token, absl::string_view key) const {
-    return token.key < key;
+  bool operator()(const UserPos::Token *token, absl::string_view key) const {
+    return token->key < key;
   }
 
-  bool operator()(absl::string_view key, const UserPos::Token &token) const {
-    return key < token.key;
+  bool operator()(absl::string_view key, const UserPos::Token *token) const {
+    return key < token->key;
   }
 };
 
 struct OrderByKeyPrefix {
-  bool operator()(const UserPos::Token &token, absl::string_view prefix) const {
-    return absl::string_view(token.key).substr(0, prefix.size()) < prefix;
+  bool operator()(const UserPos::Token *token, absl::string_view prefix) const {
+    return absl::string_view(token->key).substr(0, prefix.size()) < prefix;
   }
 
-  bool operator()(absl::string_view prefix, const UserPos::Token &token) const {
-    return prefix < absl::string_view(token.key).substr(0, prefix.size());
+  bool operator()(absl::string_view prefix, const UserPos::Token *token) const {
+    return prefix < absl::string_view(token->key).substr(0, prefix.size());
   }
 };
 
 struct OrderByKeyThenById {
-  bool operator()(const UserPos::Token &lhs, const UserPos::Token &rhs) const {
-    const int comp = lhs.key.compare(rhs.key);
-    return comp == 0 ? (lhs.id < rhs.id) : (comp < 0);
+  bool operator()(const UserPos::Token *lhs, const UserPos::Token *rhs) const {
+    const int comp = lhs->key.compare(rhs->key);
+    return comp == 0 ? (lhs->id < rhs->id) : (comp < 0);
   }
 };
 
@@ -131,6 +133,17 @@ class UserDictionaryFileManager {
 
 }  // namespace
 
+// Sharing note (evaluated): publishing this index in a named shared mapping
+// so that several processes of the same user attach read-only was considered
+// and rejected for this tree. mozc_server is single-instance per user
+// profile by design (the "server" ProcessMutex in MozcServer::Run), so
+// same-user server processes that could share the image do not exist; the
+// tokens are pointer-rich (several std::strings each), so a publishable
+// image would need a flat offset-based layout and view-typed lookups
+// threaded through every lookup path; and base has no portable named shared
+// mapping abstraction (Mmap is file-backed). If a multi-process deployment
+// ever becomes real, build the flat immutable token image first -- it also
+// shrinks single-process memory -- and revisit the transport afterwards.
 class UserDictionary::TokensIndex {
  public:
   TokensIndex(const UserPosInterface *user_pos,
@@ -139,20 +152,30 @@ class UserDictionary::TokensIndex {
 
   ~TokensIndex() = default;
 
-  bool empty() const { return user_pos_tokens_.empty(); }
-  size_t size() const { return user_pos_tokens_.size(); }
-
-  std::vector<UserPos::Token>::const_iterator begin() const {
-    return user_pos_tokens_.begin();
-  }
-  std::vector<UserPos::Token>::const_iterator end() const {
-    return user_pos_tokens_.end();
-  }
-
-  void Load(const user_dictionary::UserDictionaryStorage &storage) {
-    user_pos_tokens_.clear();
+  bool empty() const { return sorted_tokens_.empty(); }
+  size_t size() const { return sorted_tokens_.size(); }
+
+  // Iterates Token pointers in (key, POS id) order; the tokens live in the
+  // per-dictionary sections below.
+  std::vector<const UserPos::Token *>::const_iterator begin() const {
+    return sorted_tokens_.begin();
+  }
+  std::vector<const UserPos::Token *>::const_iterator end() const {
+    return sorted_tokens_.end();
+  }
+
+  // Loads tokens from |storage|. When |previous| is given, sections for
+  // source dictionaries whose serialized content is unchanged (keyed by
+  // dictionary id, validated by a content fingerprint) are copied from it
+  // instead of being rebuilt entry by entry. Validation, reading
+  // normalization and POS expansion dominate a rebuild, so a reload after a
+  // typical edit costs the changed dictionary plus the final merge and
+  // sort.
+  void Load(const user_dictionary::UserDictionaryStorage &storage,
+            const TokensIndex *previous) {
+    sorted_tokens_.clear();
+    sections_.clear();
     absl::flat_hash_set<uint64_t> seen;
-    std::vector<UserPos::Token> tokens;
 
     const SuppressionDictionaryLock l(suppression_dictionary_);
     suppression_dictionary_->Clear();
@@ -162,90 +185,250 @@ class UserDictionary::TokensIndex {
       if (!dic.enabled() || dic.entries_size() == 0) {
         continue;
       }
-      const bool is_android_shortcuts =
-          (dic.name() == "__auto_imported_android_shortcuts_dictionary");
-
-      for (const UserDictionaryStorage::UserDictionaryEntry &entry :
-           dic.entries()) {
-        if (!UserDictionaryUtil::IsValidEntry(*user_pos_, entry)) {
-          continue;
-        }
-
-        // We cannot call NormalizeVoiceSoundMark inside NormalizeReading,
-        // because the normalization is user-visible.
-        // http://b/2480844
-        std::string reading = japanese::NormalizeVoicedSoundMark(
-            UserDictionaryUtil::NormalizeReading(entry.key()));
-
-        DCHECK(user_dictionary::UserDictionary_PosType_IsValid(entry.pos()));
-        static_assert(user_dictionary::UserDictionary_PosType_PosType_MAX <=
-                      std::numeric_limits<char>::max());
-        const char pos_type_as_char[] = {static_cast<char>(entry.pos())};
-        const uint64_t fp =
-            Fingerprint(absl::StrCat(reading, "\t", entry.value(), "\t",
-                                     absl::string_view(pos_type_as_char, 1)));
-        if (!seen.insert(fp).second) {
-          MOZC_VLOG(1) << "Found dup item";
-          continue;
-        }
-
-        if (entry.pos() == user_dictionary::UserDictionary::SUPPRESSION_WORD) {
-          // "抑制単語"
-          suppression_dictionary_->AddEntry(std::move(reading), entry.value());
-        } else if (entry.pos() == user_dictionary::UserDictionary::NO_POS) {
-          // In theory NO_POS works without this implementation, as it is
-          // covered in the UserPos::GetTokens function. However, that function
-          // is depending on the user_pos_*.data in the dictionary and there
-          // will not be corresponding POS tag. To avoid invalid behavior, this
-          // special treatment is added here.
-          // "品詞なし"
-          const absl::string_view comment =
-              absl::StripAsciiWhitespace(entry.comment());
-          UserPos::Token token{.key = reading,
-                               .value = entry.value(),
-                               .id = 0,
-                               .attributes = UserPos::Token::SHORTCUT,
-                               .comment = std::string(comment)};
-          // NO_POS has '名詞サ変' id as in user_pos.def
-          user_pos_->GetPosIds("名詞サ変", &token.id);
-          user_pos_tokens_.push_back(std::move(token));
-        } else {
-          tokens.clear();
-          user_pos_->GetTokens(
-              reading, entry.value(),
-              UserDictionaryUtil::GetStringPosType(entry.pos()), &tokens);
-          const absl::string_view comment =
-              absl::StripAsciiWhitespace(entry.comment());
-          for (auto &token : tokens) {
-            strings::Assign(token.comment, comment);
-            if (is_android_shortcuts &&
-                token.has_attribute(UserPos::Token::SUGGESTION_ONLY)) {
-              // TODO(b/295964970): This special implementation is planned to be
-              // removed after validating the safety of NO_POS implementation.
-              token.remove_attribute(UserPos::Token::SUGGESTION_ONLY);
-              token.add_attribute(UserPos::Token::SHORTCUT);
-            }
-            user_pos_tokens_.push_back(std::move(token));
-          }
-        }
+      Section section;
+      section.dictionary_id = dic.id();
+      section.content_fingerprint = Fingerprint(dic.SerializeAsString());
+      const Section *cached =
+          previous == nullptr
+              ? nullptr
+              : previous->FindSection(section.dictionary_id,
+                                      section.content_fingerprint);
+      if (cached != nullptr) {
+        section.entries = cached->entries;
+        section.tokens = cached->tokens;
+        section.suppressions = cached->suppressions;
+      } else {
+        BuildSection(dic, &section);
       }
+      ApplySection(section, seen);
+      sections_.push_back(std::move(section));
     }
-    user_pos_tokens_.shrink_to_fit();
+    sorted_tokens_.shrink_to_fit();
 
     // Sort first by key and then by POS ID.
-    std::sort(user_pos_tokens_.begin(), user_pos_tokens_.end(),
+    std::sort(sorted_tokens_.begin(), sorted_tokens_.end(),
               OrderByKeyThenById());
 
-    MOZC_VLOG(1) << user_pos_tokens_.size() << " user dic entries loaded";
+    MOZC_VLOG(1) << sorted_tokens_.size() << " user dic entries loaded";
 
     usage_stats::UsageStats::SetInteger(
-        "UserRegisteredWord", static_cast<int>(user_pos_tokens_.size()));
+        "UserRegisteredWord", static_cast<int>(sorted_tokens_.size()));
+  }
+
+  void Load(const user_dictionary::UserDictionaryStorage &storage) {
+    Load(storage, nullptr);
   }
 
  private:
+  struct SectionEntry {
+    uint64_t fingerprint;       // dedup fingerprint of the source entry
+    uint32_t num_tokens;        // expanded tokens (0 for suppression words)
+    int32_t suppression_index;  // index into suppressions, or -1
+  };
+  // Build result of one source dictionary, reusable across reloads while
+  // that dictionary's content stays unchanged.
+  struct Section {
+    uint64_t dictionary_id;
+    uint64_t content_fingerprint;
+    std::vector<SectionEntry> entries;
+    std::vector<UserPos::Token> tokens;  // flattened per-entry expansions
+    std::vector<std::pair<std::string, std::string>> suppressions;
+  };
+
+  const Section *FindSection(const uint64_t dictionary_id,
+                             const uint64_t content_fingerprint) const {
+    for (const Section &section : sections_) {
+      if (section.dictionary_id == dictionary_id) {
+        return section.content_fingerprint == content_fingerprint ? &section
+                                                                  : nullptr;
+      }
+    }
+    return nullptr;
+  }
+
+  // Runs the per-entry validation, normalization and POS expansion for one
+  // source dictionary. Global dedup is NOT applied here (sections must not
+  // depend on other dictionaries' content to stay reusable); ApplySection
+  // replays it exactly.
+  void BuildSection(const UserDictionaryStorage::UserDictionary &dic,
+                    Section *section) {
+    const bool is_android_shortcuts =
+        (dic.name() == "__auto_imported_android_shortcuts_dictionary");
+
+    // One validated entry waiting for its tokens.  Regular entries point
+    // into `groups`; suppression and NO_POS entries are finished already.
+    struct PendingEntry {
+      SectionEntry section_entry;
+      std::string reading;       // normalized reading of regular entries
+      absl::string_view comment; // stripped, views into the entry proto
+      UserPos::Token no_pos_token;
+      bool is_no_pos = false;
+      int group = -1;
+      size_t member = 0;
+    };
+    // All regular entries sharing one POS, so that the POS's conjugation
+    // pattern is resolved only once by GetTokensBatch().
+    struct PosGroup {
+      absl::string_view pos;
+      std::vector<std::pair<absl::string_view, absl::string_view>> key_values;
+      std::vector<UserPos::Token> tokens;  // flattened batch output
+      std::vector<size_t> num_tokens;      // per member
+      std::vector<size_t> offsets;         // per member, into `tokens`
+    };
+
+    // Phase 1: validate, normalize and fingerprint the entries, grouping the
+    // regular ones by POS.  `pending` is reserved up front because the
+    // groups hold views into the stored readings.
+    std::vector<PendingEntry> pending;
+    pending.reserve(dic.entries().size());
+    std::vector<PosGroup> groups;
+    absl::flat_hash_map<absl::string_view, int> group_index;
+
+    for (const UserDictionaryStorage::UserDictionaryEntry &entry :
+         dic.entries()) {
+      if (!UserDictionaryUtil::IsValidEntry(*user_pos_, entry)) {
+        continue;
+      }
+
+      // We cannot call NormalizeVoiceSoundMark inside NormalizeReading,
+      // because the normalization is user-visible.
+      // http://b/2480844
+      std::string reading = japanese::NormalizeVoicedSoundMark(
+          UserDictionaryUtil::NormalizeReading(entry.key()));
+
+      DCHECK(user_dictionary::UserDictionary_PosType_IsValid(entry.pos()));
+      static_assert(user_dictionary::UserDictionary_PosType_PosType_MAX <=
+                    std::numeric_limits<char>::max());
+      const char pos_type_as_char[] = {static_cast<char>(entry.pos())};
+      const uint64_t fp =
+          Fingerprint(absl::StrCat(reading, "\t", entry.value(), "\t",
+                                   absl::string_view(pos_type_as_char, 1)));
+      PendingEntry &p = pending.emplace_back();
+      p.section_entry = SectionEntry{fp, 0, -1};
+
+      if (entry.pos() == user_dictionary::UserDictionary::SUPPRESSION_WORD) {
+        // "抑制単語"
+        p.section_entry.suppression_index =
+            static_cast<int32_t>(section->suppressions.size());
+        section->suppressions.emplace_back(std::move(reading),
+                                           entry.value());
+      } else if (entry.pos() == user_dictionary::UserDictionary::NO_POS) {
+        // In theory NO_POS works without this implementation, as it is
+        // covered in the UserPos::GetTokens function. However, that function
+        // is depending on the user_pos_*.data in the dictionary and there
+        // will not be corresponding POS tag. To avoid invalid behavior, this
+        // special treatment is added here.
+        // "品詞なし"
+        const absl::string_view comment =
+            absl::StripAsciiWhitespace(entry.comment());
+        p.no_pos_token = UserPos::Token{.key = reading,
+                                        .value = entry.value(),
+                                        .id = 0,
+                                        .attributes = UserPos::Token::SHORTCUT,
+                                        .comment = std::string(comment)};
+        // NO_POS has '名詞サ変' id as in user_pos.def
+        user_pos_->GetPosIds("名詞サ変", &p.no_pos_token.id);
+        p.section_entry.num_tokens = 1;
+        p.is_no_pos = true;
+      } else {
+        p.reading = std::move(reading);
+        p.comment = absl::StripAsciiWhitespace(entry.comment());
+        const absl::string_view pos =
+            UserDictionaryUtil::GetStringPosType(entry.pos());
+        const auto [iter, inserted] =
+            group_index.try_emplace(pos, static_cast<int>(groups.size()));
+        if (inserted) {
+          groups.emplace_back().pos = pos;
+        }
+        PosGroup &group = groups[iter->second];
+        p.group = iter->second;
+        p.member = group.key_values.size();
+        group.key_values.emplace_back(p.reading, entry.value());
+      }
+    }
+
+    // Phase 2: expand each POS once.  An unknown POS yields zero tokens per
+    // member, matching what per-entry GetTokens() used to produce.
+    size_t total_tokens = 0;
+    for (PosGroup &group : groups) {
+      if (!user_pos_->GetTokensBatch(group.key_values, group.pos, "",
+                                     &group.tokens, &group.num_tokens)) {
+        group.num_tokens.assign(group.key_values.size(), 0);
+      }
+      group.offsets.reserve(group.num_tokens.size());
+      size_t offset = 0;
+      for (const size_t num : group.num_tokens) {
+        group.offsets.push_back(offset);
+        offset += num;
+      }
+      total_tokens += offset;
+    }
+    for (const PendingEntry &p : pending) {
+      if (p.is_no_pos) {
+        ++total_tokens;
+      }
+    }
+
+    // Phase 3: lay the tokens out in entry order, as ApplySection consumes
+    // them positionally.
+    section->entries.reserve(section->entries.size() + pending.size());
+    section->tokens.reserve(section->tokens.size() + total_tokens);
+    for (PendingEntry &p : pending) {
+      if (p.is_no_pos) {
+        section->tokens.push_back(std::move(p.no_pos_token));
+      } else if (p.group >= 0) {
+        PosGroup &group = groups[p.group];
+        const size_t offset = group.offsets[p.member];
+        const size_t num = group.num_tokens[p.member];
+        p.section_entry.num_tokens = static_cast<uint32_t>(num);
+        for (size_t i = 0; i < num; ++i) {
+          UserPos::Token &token = group.tokens[offset + i];
+          strings::Assign(token.comment, p.comment);
+          if (is_android_shortcuts &&
+              token.has_attribute(UserPos::Token::SUGGESTION_ONLY)) {
+            // TODO(b/295964970): This special implementation is planned to be
+            // removed after validating the safety of NO_POS implementation.
+            token.remove_attribute(UserPos::Token::SUGGESTION_ONLY);
+            token.add_attribute(UserPos::Token::SHORTCUT);
+          }
+          section->tokens.push_back(std::move(token));
+        }
+      }
+      section->entries.push_back(p.section_entry);
+    }
+  }
+
+  // Replays the global dedup over a section and appends its surviving
+  // tokens and suppression words.
+  void ApplySection(const Section &section,
+                    absl::flat_hash_set<uint64_t> &seen) {
+    size_t token_position = 0;
+    for (const SectionEntry &entry : section.entries) {
+      if (!seen.insert(entry.fingerprint).second) {
+        MOZC_VLOG(1) << "Found dup item";
+        token_position += entry.num_tokens;
+        continue;
+      }
+      if (entry.suppression_index >= 0) {
+        const auto &[key, value] = section.suppressions[entry.suppression_index];
+        suppression_dictionary_->AddEntry(key, value);
+      } else {
+        // The Token storage lives in the section; its heap buffer survives
+        // the section's later move into sections_, so the pointers stay
+        // valid for the life of this index.
+        for (uint32_t i = 0; i < entry.num_tokens; ++i) {
+          sorted_tokens_.push_back(&section.tokens[token_position + i]);
+        }
+      }
+      token_position += entry.num_tokens;
+    }
+  }
+
   const UserPosInterface *user_pos_;
   SuppressionDictionary *suppression_dictionary_;
-  std::vector<UserPos::Token> user_pos_tokens_;
+  std::vector<Section> sections_;
+  // Dedup-surviving tokens in (key, POS id) order, pointing into sections_.
+  std::vector<const UserPos::Token *> sorted_tokens_;
 };
 
 class UserDictionary::UserDictionaryReloader {
@@ -361,13 +544,13 @@ bool UserDictionary::HasValue(absl::string_view value) const {
 void UserDictionary::LookupPredictive(
     absl::string_view key, const ConversionRequest &conversion_request,
     Callback *callback) const {
-  absl::ReaderMutexLock l(&mutex_);
+  const std::shared_ptr<const TokensIndex> tokens = GetTokens();
 
   if (key.empty()) {
     MOZC_VLOG(2) << "string of length zero is passed.";
     return;
   }
-  if (tokens_->empty()) {
+  if (tokens->empty()) {
     return;
   }
   if (conversion_request.config().incognito_mode()) {
@@ -376,10 +559,10 @@ void UserDictionary::LookupPredictive(
 
   // Find the starting point of iteration over dictionary contents.
   Token token;
-  for (auto [begin, end] = std::equal_range(tokens_->begin(), tokens_->end(),
+  for (auto [begin, end] = std::equal_range(tokens->begin(), tokens->end(),
                                             key, OrderByKeyPrefix());
        begin != end; ++begin) {
-    const UserPos::Token &user_pos_token = *begin;
+    const UserPos::Token &user_pos_token = **begin;
     switch (callback->OnKey(user_pos_token.key)) {
       case Callback::TRAVERSE_DONE:
         return;
@@ -401,55 +584,59 @@ void UserDictionary::LookupPredictive(
 void UserDictionary::LookupPrefix(absl::string_view key,
                                   const ConversionRequest &conversion_request,
                                   Callback *callback) const {
-  absl::ReaderMutexLock l(&mutex_);
+  const std::shared_ptr<const TokensIndex> tokens = GetTokens();
 
   if (key.empty()) {
     LOG(WARNING) << "string of length zero is passed.";
     return;
   }
-  if (tokens_->empty()) {
+  if (tokens->empty()) {
     return;
   }
   if (conversion_request.config().incognito_mode()) {
     return;
   }
 
-  // Find the starting point for iteration over dictionary contents.
-  const absl::string_view first_char = Utf8AsChars(key).front();
+  // The matched keys are exactly the prefixes of |key|, so instead of
+  // scanning everything sharing the first character, binary search each
+  // prefix length: O(|key| log n), which beats the scan on the large
+  // dictionaries of power users. Increasing prefix length is increasing
+  // lexicographic order, so the visitation order is unchanged.
   Token token;
-  for (auto it = std::lower_bound(tokens_->begin(), tokens_->end(), first_char,
-                                  OrderByKey());
-       it != tokens_->end(); ++it) {
-    const UserPos::Token &user_pos_token = *it;
-    if (user_pos_token.key > key) {
-      break;
-    }
-    if (user_pos_token.has_attribute(UserPos::Token::SUGGESTION_ONLY)) {
-      continue;
-    }
-    if (!absl::StartsWith(key, user_pos_token.key)) {
-      continue;
-    }
-    switch (callback->OnKey(user_pos_token.key)) {
-      case Callback::TRAVERSE_DONE:
-        return;
-      case Callback::TRAVERSE_NEXT_KEY:
+  const Utf8AsChars key_as_chars(key);
+  size_t prefix_length = 0;
+  for (const absl::string_view character : key_as_chars) {
+    prefix_length += character.size();
+    const absl::string_view prefix = key.substr(0, prefix_length);
+    for (auto [begin, end] = std::equal_range(tokens->begin(), tokens->end(),
+                                              prefix, OrderByKey());
+         begin != end; ++begin) {
+      const UserPos::Token &user_pos_token = **begin;
+      if (user_pos_token.has_attribute(UserPos::Token::SUGGESTION_ONLY)) {
         continue;
-      case Callback::TRAVERSE_CULL:
-        LOG(FATAL) << "UserDictionary doesn't support culling.";
-        break;
-      default:
-        break;
-    }
-    PopulateTokenFromUserPosToken(user_pos_token, PREFIX, &token);
-    switch (callback->OnToken(user_pos_token.key, user_pos_token.key, token)) {
-      case Callback::TRAVERSE_DONE:
-        return;
-      case Callback::TRAVERSE_CULL:
-        LOG(FATAL) << "UserDictionary doesn't support culling.";
-        break;
-      default:
-        break;
+      }
+      switch (callback->OnKey(user_pos_token.key)) {
+        case Callback::TRAVERSE_DONE:
+          return;
+        case Callback::TRAVERSE_NEXT_KEY:
+          continue;
+        case Callback::TRAVERSE_CULL:
+          LOG(FATAL) << "UserDictionary doesn't support culling.";
+          break;
+        default:
+          break;
+      }
+      PopulateTokenFromUserPosToken(user_pos_token, PREFIX, &token);
+      switch (
+          callback->OnToken(user_pos_token.key, user_pos_token.key, token)) {
+        case Callback::TRAVERSE_DONE:
+          return;
+        case Callback::TRAVERSE_CULL:
+          LOG(FATAL) << "UserDictionary doesn't support culling.";
+          break;
+        default:
+          break;
+      }
     }
   }
 }
@@ -457,13 +644,13 @@ void UserDictionary::LookupPrefix(absl::string_view key,
 void UserDictionary::LookupExact(absl::string_view key,
                                  const ConversionRequest &conversion_request,
                                  Callback *callback) const {
-  absl::ReaderMutexLock l(&mutex_);
-  if (key.empty() || tokens_->empty() ||
+  const std::shared_ptr<const TokensIndex> tokens = GetTokens();
+  if (key.empty() || tokens->empty() ||
       conversion_request.config().incognito_mode()) {
     return;
   }
   auto [begin, end] =
-      std::equal_range(tokens_->begin(), tokens_->end(), key, OrderByKey());
+      std::equal_range(tokens->begin(), tokens->end(), key, OrderByKey());
   if (begin == end) {
     return;
   }
@@ -473,7 +660,7 @@ void UserDictionary::LookupExact(absl::string_view key,
 
   Token token;
   for (; begin != end; ++begin) {
-    const UserPos::Token &user_pos_token = *begin;
+    const UserPos::Token &user_pos_token = **begin;
     if (user_pos_token.has_attribute(UserPos::Token::SUGGESTION_ONLY)) {
       continue;
     }
@@ -496,16 +683,16 @@ bool UserDictionary::LookupComment(absl::string_view key,
     return false;
   }
 
-  absl::ReaderMutexLock l(&mutex_);
-  if (tokens_->empty()) {
+  const std::shared_ptr<const TokensIndex> tokens = GetTokens();
+  if (tokens->empty()) {
     return false;
   }
 
   // Set the comment that was found first.
-  for (auto [begin, end] = std::equal_range(tokens_->begin(), tokens_->end(),
+  for (auto [begin, end] = std::equal_range(tokens->begin(), tokens->end(),
                                             key, OrderByKey());
        begin != end; ++begin) {
-    const UserPos::Token &token = *begin;
+    const UserPos::Token &token = **begin;
     if (token.value == value && !token.comment.empty()) {
       comment->assign(token.comment);
       return true;
@@ -551,17 +738,21 @@ void UserDictionary::WaitForReloader() { reloader_->Wait(); }
 
 void UserDictionary::Swap(std::unique_ptr<TokensIndex> new_tokens) {
   DCHECK(new_tokens);
-  absl::WriterMutexLock l(&mutex_);
-  tokens_.swap(new_tokens);
+  // Publish the new immutable snapshot; readers holding the old one keep it
+  // alive through their shared_ptr.
+  std::atomic_store_explicit(
+      &tokens_, std::shared_ptr<const TokensIndex>(std::move(new_tokens)),
+      std::memory_order_release);
+}
+
+std::shared_ptr<const UserDictionary::TokensIndex> UserDictionary::GetTokens()
+    const {
+  return std::atomic_load_explicit(&tokens_, std::memory_order_acquire);
 }
 
 bool UserDictionary::Load(
     const user_dictionary::UserDictionaryStorage &storage) {
-  size_t size = 0;
-  {
-    absl::ReaderMutexLock l(&mutex_);
-    size = tokens_->size();
-  }
+  const size_t size = GetTokens()->size();
 
   // If UserDictionary is pretty big, we first remove the
   // current dictionary to save memory usage.
@@ -571,15 +762,21 @@ bool UserDictionary::Load(
   constexpr size_t kVeryBigUserDictionarySize = 100000;
 #endif  // __ANDROID__
 
+  // Keeping the previous snapshot lets unchanged dictionaries reuse their
+  // built sections instead of rebuilding; above the size cap, dropping the
+  // old index to bound peak memory wins over the delta reuse.
+  std::shared_ptr<const TokensIndex> previous;
   if (size >= kVeryBigUserDictionarySize) {
     auto placeholder_empty_tokens =
         std::make_unique<TokensIndex>(user_pos_.get(), suppression_dictionary_);
     Swap(std::move(placeholder_empty_tokens));
+  } else {
+    previous = GetTokens();
   }
 
   auto tokens =
       std::make_unique<TokensIndex>(user_pos_.get(), suppression_dictionary_);
-  tokens->Load(storage);
+  tokens->Load(storage, previous.get());
   Swap(std::move(tokens));
   return true;
 }
@@ -116,12 +116,19 @@ class UserDictionary : public UserDictionaryInterface {
   // Swaps internal tokens index to |new_tokens|.
   void Swap(std::unique_ptr<TokensIndex> new_tokens);
 
+  // Returns the current immutable snapshot of the tokens index: one atomic
+  // shared_ptr load, no reader-writer mutex; the returned reference keeps
+  // the snapshot alive across a concurrent reload swap.
+  std::shared_ptr<const TokensIndex> GetTokens() const;
+
   std::unique_ptr<UserDictionaryReloader> reloader_;
   std::unique_ptr<const UserPosInterface> user_pos_;
   const PosMatcher pos_matcher_;
   SuppressionDictionary *suppression_dictionary_;
-  std::unique_ptr<TokensIndex> tokens_ ABSL_GUARDED_BY(mutex_);
-  mutable absl::Mutex mutex_;
+  // Immutable after Load(); readers snapshot it via GetTokens() and reloads
+  // publish a fresh index with an atomic store, so lookups never block on
+  // the reloader (and vice versa).
+  std::shared_ptr<const TokensIndex> tokens_;
 
   friend class UserDictionaryTest;
 };
@@ -42,6 +42,7 @@
 #include "absl/base/optimization.h"
 #include "absl/container/fixed_array.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "base/logging.h"
 #include "base/protobuf/protobuf.h"
 #include "base/protobuf/repeated_field.h"
@@ -162,6 +163,29 @@ class UndoAddEntryCommand : public UserDictionarySession::UndoCommand {
   uint64_t dictionary_id_;
 };
 
+class UndoAddEntriesCommand : public UserDictionarySession::UndoCommand {
+ public:
+  UndoAddEntriesCommand(uint64_t dictionary_id, int num_added)
+      : dictionary_id_(dictionary_id), num_added_(num_added) {}
+
+  bool RunUndo(mozc::UserDictionaryStorage *storage) override {
+    UserDictionary *dictionary =
+        UserDictionaryUtil::GetMutableUserDictionaryById(&storage->GetProto(),
+                                                         dictionary_id_);
+    if (dictionary == nullptr || dictionary->entries_size() < num_added_) {
+      return false;
+    }
+    for (int i = 0; i < num_added_; ++i) {
+      dictionary->mutable_entries()->RemoveLast();
+    }
+    return true;
+  }
+
+ private:
+  uint64_t dictionary_id_;
+  int num_added_;
+};
+
 class UndoEditEntryCommand : public UserDictionarySession::UndoCommand {
  public:
   UndoEditEntryCommand(uint64_t dictionary_id, int index,
@@ -541,6 +565,56 @@ UserDictionaryCommandStatus::Status UserDictionarySession::AddEntry(
   return UserDictionaryCommandStatus::USER_DICTIONARY_COMMAND_SUCCESS;
 }
 
+UserDictionaryCommandStatus::Status UserDictionarySession::AddEntries(
+    const uint64_t dictionary_id,
+    const absl::Span<const UserDictionary::Entry *const> entries,
+    const bool ignore_invalid_entries) {
+  UserDictionary *dictionary = UserDictionaryUtil::GetMutableUserDictionaryById(
+      &storage_->GetProto(), dictionary_id);
+  if (dictionary == nullptr) {
+    return UserDictionaryCommandStatus::UNKNOWN_DICTIONARY_ID;
+  }
+
+  // Validate everything up front so that the whole batch is applied as one
+  // operation or not at all (unless invalid entries are to be skipped).
+  int num_valid = 0;
+  for (const UserDictionary::Entry *entry : entries) {
+    const UserDictionaryCommandStatus::Status status =
+        UserDictionaryUtil::ValidateEntry(*entry);
+    if (status != UserDictionaryCommandStatus::USER_DICTIONARY_COMMAND_SUCCESS) {
+      if (ignore_invalid_entries) {
+        continue;
+      }
+      return status;
+    }
+    ++num_valid;
+  }
+  if (static_cast<size_t>(dictionary->entries_size()) + num_valid >
+      UserDictionaryUtil::max_entry_size()) {
+    return UserDictionaryCommandStatus::ENTRY_SIZE_LIMIT_EXCEEDED;
+  }
+
+  dictionary->mutable_entries()->Reserve(dictionary->entries_size() +
+                                         num_valid);
+  int num_added = 0;
+  for (const UserDictionary::Entry *entry : entries) {
+    if (UserDictionaryUtil::ValidateEntry(*entry) !=
+        UserDictionaryCommandStatus::USER_DICTIONARY_COMMAND_SUCCESS) {
+      continue;  // Only reachable with ignore_invalid_entries.
+    }
+    UserDictionary::Entry *new_entry = dictionary->add_entries();
+    *new_entry = *entry;
+    UserDictionaryUtil::SanitizeEntry(new_entry);
+    ++num_added;
+  }
+
+  if (num_added > 0) {
+    AddUndoCommand(
+        std::make_unique<UndoAddEntriesCommand>(dictionary_id, num_added));
+  }
+  return UserDictionaryCommandStatus::USER_DICTIONARY_COMMAND_SUCCESS;
+}
+
 UserDictionaryCommandStatus::Status UserDictionarySession::EditEntry(
     uint64_t dictionary_id, int index, const UserDictionary::Entry &entry) {
   UserDictionary *dictionary = UserDictionaryUtil::GetMutableUserDictionaryById(
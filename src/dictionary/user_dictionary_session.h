@@ -37,6 +37,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "dictionary/user_dictionary_storage.h"
 #include "protocol/user_dictionary_storage.pb.h"
 
@@ -110,6 +111,15 @@ class UserDictionarySession {
   UserDictionaryCommandStatus::Status AddEntry(
       uint64_t dictionary_id, const UserDictionary::Entry &entry);
 
+  // Adds all the (pointed-to) entries to the dictionary as one operation
+  // with a single undo record.  Validation runs up front: an invalid entry
+  // fails the whole batch unless |ignore_invalid_entries| is set, in which
+  // case it is skipped.
+  UserDictionaryCommandStatus::Status AddEntries(
+      uint64_t dictionary_id,
+      absl::Span<const UserDictionary::Entry *const> entries,
+      bool ignore_invalid_entries);
+
   // Edits the entry at "index" in the dictionary specified by dictionary_id
   // to the given key, value and pos_type.
   UserDictionaryCommandStatus::Status EditEntry(
@@ -31,6 +31,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "absl/random/random.h"
 #include "base/logging.h"
@@ -103,6 +104,9 @@ bool UserDictionarySessionHandler::Evaluate(
     case UserDictionaryCommand::ADD_ENTRY:
       AddEntry(command, status);
       break;
+    case UserDictionaryCommand::ADD_ENTRIES:
+      AddEntries(command, status);
+      break;
     case UserDictionaryCommand::EDIT_ENTRY:
       EditEntry(command, status);
       break;
@@ -438,6 +442,27 @@ void UserDictionarySessionHandler::AddEntry(
       session->AddEntry(command.dictionary_id(), command.entry()));
 }
 
+void UserDictionarySessionHandler::AddEntries(
+    const UserDictionaryCommand &command, UserDictionaryCommandStatus *status) {
+  UserDictionarySession *session = GetSession(command, status);
+  if (session == nullptr) {
+    return;
+  }
+
+  if (!command.has_dictionary_id() || command.entries_size() == 0) {
+    status->set_status(UserDictionaryCommandStatus::INVALID_ARGUMENT);
+    return;
+  }
+
+  std::vector<const UserDictionary::Entry *> entries;
+  entries.reserve(command.entries_size());
+  for (const UserDictionary::Entry &entry : command.entries()) {
+    entries.push_back(&entry);
+  }
+  status->set_status(session->AddEntries(command.dictionary_id(), entries,
+                                         command.ignore_invalid_entries()));
+}
+
 void UserDictionarySessionHandler::EditEntry(
     const UserDictionaryCommand &command, UserDictionaryCommandStatus *status) {
   UserDictionarySession *session = GetSession(command, status);
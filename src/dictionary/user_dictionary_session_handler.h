@@ -98,6 +98,8 @@ class UserDictionarySessionHandler {
                                  UserDictionaryCommandStatus *status);
   void AddEntry(const UserDictionaryCommand &command,
                 UserDictionaryCommandStatus *status);
+  void AddEntries(const UserDictionaryCommand &command,
+                  UserDictionaryCommandStatus *status);
   void EditEntry(const UserDictionaryCommand &command,
                  UserDictionaryCommandStatus *status);
   void DeleteEntry(const UserDictionaryCommand &command,
@@ -34,6 +34,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "base/file_util.h"
 #include "base/protobuf/protobuf.h"
@@ -667,6 +668,65 @@ TEST_F(UserDictionarySessionHandlerTest, AddEntry) {
   DeleteSession(session_id);
 }
 
+TEST_F(UserDictionarySessionHandlerTest, AddEntries) {
+  const uint64_t session_id = CreateSession();
+  const uint64_t dictionary_id = CreateUserDictionary(session_id, "dictionary");
+  ASSERT_EQ(GetUserDictionaryEntrySize(session_id, dictionary_id), 0);
+
+  // Add a batch of entries with one command.
+  Clear();
+  command_->set_type(UserDictionaryCommand::ADD_ENTRIES);
+  command_->set_session_id(session_id);
+  command_->set_dictionary_id(dictionary_id);
+  for (int i = 0; i < 3; ++i) {
+    UserDictionary::Entry *entry = command_->add_entries();
+    entry->set_key(absl::StrCat("reading", i));
+    entry->set_value(absl::StrCat("word", i));
+    entry->set_pos(UserDictionary::NOUN);
+  }
+  ASSERT_TRUE(handler_->Evaluate(*command_, status_.get()));
+  EXPECT_PROTO_EQ("status: USER_DICTIONARY_COMMAND_SUCCESS", *status_);
+  ASSERT_EQ(GetUserDictionaryEntrySize(session_id, dictionary_id), 3);
+
+  // An invalid entry fails the whole batch by default.
+  Clear();
+  command_->set_type(UserDictionaryCommand::ADD_ENTRIES);
+  command_->set_session_id(session_id);
+  command_->set_dictionary_id(dictionary_id);
+  command_->add_entries()->set_key("no_value_nor_pos");
+  {
+    UserDictionary::Entry *entry = command_->add_entries();
+    entry->set_key("reading");
+    entry->set_value("word");
+    entry->set_pos(UserDictionary::NOUN);
+  }
+  ASSERT_TRUE(handler_->Evaluate(*command_, status_.get()));
+  ASSERT_EQ(GetUserDictionaryEntrySize(session_id, dictionary_id), 3);
+
+  // ... unless invalid entries are to be skipped.
+  command_->set_ignore_invalid_entries(true);
+  ASSERT_TRUE(handler_->Evaluate(*command_, status_.get()));
+  EXPECT_PROTO_EQ("status: USER_DICTIONARY_COMMAND_SUCCESS", *status_);
+  ASSERT_EQ(GetUserDictionaryEntrySize(session_id, dictionary_id), 4);
+
+  // One undo removes the whole batch.
+  Clear();
+  command_->set_type(UserDictionaryCommand::UNDO);
+  command_->set_session_id(session_id);
+  ASSERT_TRUE(handler_->Evaluate(*command_, status_.get()));
+  ASSERT_EQ(GetUserDictionaryEntrySize(session_id, dictionary_id), 3);
+
+  // Without entries the command is invalid.
+  Clear();
+  command_->set_type(UserDictionaryCommand::ADD_ENTRIES);
+  command_->set_session_id(session_id);
+  command_->set_dictionary_id(dictionary_id);
+  ASSERT_TRUE(handler_->Evaluate(*command_, status_.get()));
+  EXPECT_PROTO_EQ("status: INVALID_ARGUMENT", *status_);
+
+  DeleteSession(session_id);
+}
+
 TEST_F(UserDictionarySessionHandlerTest, EditEntry) {
   const uint64_t session_id = CreateSession();
   const uint64_t dictionary_id = CreateUserDictionary(session_id, "dictionary");
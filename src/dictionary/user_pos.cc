@@ -41,6 +41,7 @@
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "base/container/serialized_string_array.h"
 #include "base/logging.h"
 #include "base/strings/assign.h"
@@ -96,14 +97,12 @@ bool UserPos::GetPosIds(absl::string_view pos, uint16_t *id) const {
   return true;
 }
 
-bool UserPos::GetTokens(absl::string_view key, absl::string_view value,
-                        absl::string_view pos, absl::string_view locale,
-                        std::vector<Token> *tokens) const {
-  if (key.empty() || value.empty() || pos.empty() || tokens == nullptr) {
+bool UserPos::LookupConjugation(absl::string_view pos,
+                                absl::string_view locale,
+                                ConjugationPattern *pattern) const {
+  if (pos.empty() || pattern == nullptr) {
     return false;
   }
-
-  tokens->clear();
   const auto str_iter =
       std::lower_bound(string_array_.begin(), string_array_.end(), pos);
   if (str_iter == string_array_.end() || *str_iter != pos) {
@@ -113,9 +112,8 @@ bool UserPos::GetTokens(absl::string_view key, absl::string_view value,
   if (first == last) {
     return false;
   }
-  const ptrdiff_t size = last - first;
-  CHECK_GE(size, 1);
-  tokens->resize(size);
+  pattern->first = first;
+  pattern->last = last;
 
   // TODO(taku)  Change the cost by seeing cost_type
   const bool is_non_ja_locale =
@@ -136,42 +134,93 @@ bool UserPos::GetTokens(absl::string_view key, absl::string_view value,
   if (is_non_ja_locale) {
     attributes |= UserPos::Token::NON_JA_LOCALE;
   }
+  pattern->attributes = attributes;
+  return true;
+}
+
+void UserPos::AppendTokens(absl::string_view key, absl::string_view value,
+                           const ConjugationPattern &pattern,
+                           std::vector<Token> *tokens) const {
+  const ptrdiff_t size = pattern.last - pattern.first;
+  CHECK_GE(size, 1);
 
   if (size == 1) {  // no conjugation
-    strings::Assign(tokens->front().key, key);
-    strings::Assign(tokens->front().value, value);
-    tokens->front().id = first.conjugation_id();
-    tokens->front().attributes = attributes;
-  } else {
-    // expand all other forms
-    absl::string_view key_stem = key;
-    absl::string_view value_stem = value;
-    // assume that conjugation_form[0] contains the suffix of "base form".
-    const absl::string_view base_key_suffix =
-        string_array_[first.key_suffix_index()];
-    const absl::string_view base_value_suffix =
-        string_array_[first.value_suffix_index()];
-
-    if (base_key_suffix.size() < key.size() &&
-        base_value_suffix.size() < value.size() &&
-        absl::EndsWith(key, base_key_suffix) &&
-        absl::EndsWith(value, base_value_suffix)) {
-      key_stem.remove_suffix(base_key_suffix.size());
-      value_stem.remove_suffix(base_value_suffix.size());
-    }
-    auto dest = tokens->begin();
-    for (auto src = first; src != last; ++src, ++dest) {
-      const absl::string_view key_suffix =
-          string_array_[src.key_suffix_index()];
-      const absl::string_view value_suffix =
-          string_array_[src.value_suffix_index()];
-      dest->key = absl::StrCat(key_stem, key_suffix);
-      dest->value = absl::StrCat(value_stem, value_suffix);
-      dest->id = src.conjugation_id();
-      dest->attributes = attributes;
-    }
+    Token &token = tokens->emplace_back();
+    strings::Assign(token.key, key);
+    strings::Assign(token.value, value);
+    token.id = pattern.first.conjugation_id();
+    token.attributes = pattern.attributes;
+    return;
   }
 
+  // expand all other forms
+  absl::string_view key_stem = key;
+  absl::string_view value_stem = value;
+  // assume that conjugation_form[0] contains the suffix of "base form".
+  const absl::string_view base_key_suffix =
+      string_array_[pattern.first.key_suffix_index()];
+  const absl::string_view base_value_suffix =
+      string_array_[pattern.first.value_suffix_index()];
+
+  if (base_key_suffix.size() < key.size() &&
+      base_value_suffix.size() < value.size() &&
+      absl::EndsWith(key, base_key_suffix) &&
+      absl::EndsWith(value, base_value_suffix)) {
+    key_stem.remove_suffix(base_key_suffix.size());
+    value_stem.remove_suffix(base_value_suffix.size());
+  }
+  for (auto src = pattern.first; src != pattern.last; ++src) {
+    const absl::string_view key_suffix = string_array_[src.key_suffix_index()];
+    const absl::string_view value_suffix =
+        string_array_[src.value_suffix_index()];
+    Token &token = tokens->emplace_back();
+    token.key = absl::StrCat(key_stem, key_suffix);
+    token.value = absl::StrCat(value_stem, value_suffix);
+    token.id = src.conjugation_id();
+    token.attributes = pattern.attributes;
+  }
+}
+
+bool UserPos::GetTokens(absl::string_view key, absl::string_view value,
+                        absl::string_view pos, absl::string_view locale,
+                        std::vector<Token> *tokens) const {
+  if (key.empty() || value.empty() || pos.empty() || tokens == nullptr) {
+    return false;
+  }
+
+  tokens->clear();
+  ConjugationPattern pattern;
+  if (!LookupConjugation(pos, locale, &pattern)) {
+    return false;
+  }
+  AppendTokens(key, value, pattern, tokens);
+  return true;
+}
+
+bool UserPos::GetTokensBatch(
+    absl::Span<const std::pair<absl::string_view, absl::string_view>> entries,
+    absl::string_view pos, absl::string_view locale,
+    std::vector<Token> *tokens, std::vector<size_t> *num_tokens) const {
+  if (tokens == nullptr || num_tokens == nullptr) {
+    return false;
+  }
+  ConjugationPattern pattern;
+  if (!LookupConjugation(pos, locale, &pattern)) {
+    return false;
+  }
+  const size_t pattern_size =
+      static_cast<size_t>(pattern.last - pattern.first);
+  tokens->reserve(tokens->size() + entries.size() * pattern_size);
+  num_tokens->reserve(num_tokens->size() + entries.size());
+  for (const auto &[key, value] : entries) {
+    if (key.empty() || value.empty()) {
+      num_tokens->push_back(0);
+      continue;
+    }
+    const size_t before = tokens->size();
+    AppendTokens(key, value, pattern, tokens);
+    num_tokens->push_back(tokens->size() - before);
+  }
   return true;
 }
 
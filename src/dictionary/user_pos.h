@@ -39,6 +39,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "base/container/serialized_string_array.h"
 #include "data_manager/data_manager_interface.h"
 #include "dictionary/user_pos_interface.h"
@@ -199,6 +200,33 @@ class UserPos : public UserPosInterface {
   bool GetTokens(absl::string_view key, absl::string_view value,
                  absl::string_view pos, absl::string_view locale,
                  std::vector<Token> *tokens) const override;
+  bool GetTokensBatch(
+      absl::Span<const std::pair<absl::string_view, absl::string_view>>
+          entries,
+      absl::string_view pos, absl::string_view locale,
+      std::vector<Token> *tokens,
+      std::vector<size_t> *num_tokens) const override;
+
+  // Conjugation pattern of one POS, resolved once with LookupConjugation()
+  // and then reusable for expanding any number of (key, value) pairs with
+  // AppendTokens().  Valid as long as this instance is.
+  struct ConjugationPattern {
+    iterator first;
+    iterator last;
+    uint16_t attributes = 0;
+  };
+
+  // Resolves the conjugation pattern and token attributes of (pos, locale).
+  // Returns false if the POS is unknown.
+  bool LookupConjugation(absl::string_view pos, absl::string_view locale,
+                         ConjugationPattern *pattern) const;
+
+  // Appends the expansions of (key, value) under `pattern` to `tokens`
+  // without clearing it, so that entries sharing a POS can fill one
+  // preallocated buffer.
+  void AppendTokens(absl::string_view key, absl::string_view value,
+                    const ConjugationPattern &pattern,
+                    std::vector<Token> *tokens) const;
 
   iterator begin() const { return iterator(token_array_data_.data()); }
   iterator end() const {
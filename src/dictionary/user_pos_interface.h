@@ -30,6 +30,7 @@
 #ifndef MOZC_DICTIONARY_USER_POS_INTERFACE_H_
 #define MOZC_DICTIONARY_USER_POS_INTERFACE_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <type_traits>
@@ -37,6 +38,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 
 namespace mozc {
 
@@ -110,6 +112,42 @@ class UserPosInterface : public PosListProviderInterface {
                  absl::string_view pos, std::vector<Token> *tokens) const {
     return GetTokens(key, value, pos, "", tokens);
   }
+
+  // Expands all the (key, value) pairs in `entries`, which share one POS and
+  // locale, appending the generated tokens to `tokens` in entry order and
+  // recording how many tokens each entry produced in `num_tokens`.  Entries
+  // with an empty key or value produce zero tokens.  Returns false without
+  // appending anything if the POS is unknown.  The base implementation just
+  // loops over GetTokens(); implementations that can resolve the conjugation
+  // pattern of the POS once should override this.
+  virtual bool GetTokensBatch(
+      absl::Span<const std::pair<absl::string_view, absl::string_view>>
+          entries,
+      absl::string_view pos, absl::string_view locale,
+      std::vector<Token> *tokens, std::vector<size_t> *num_tokens) const {
+    if (pos.empty() || tokens == nullptr || num_tokens == nullptr) {
+      return false;
+    }
+    const size_t tokens_base = tokens->size();
+    const size_t num_tokens_base = num_tokens->size();
+    std::vector<Token> entry_tokens;
+    for (const auto &[key, value] : entries) {
+      if (key.empty() || value.empty()) {
+        num_tokens->push_back(0);
+        continue;
+      }
+      if (!GetTokens(key, value, pos, locale, &entry_tokens)) {
+        tokens->resize(tokens_base);
+        num_tokens->resize(num_tokens_base);
+        return false;
+      }
+      num_tokens->push_back(entry_tokens.size());
+      for (Token &token : entry_tokens) {
+        tokens->push_back(std::move(token));
+      }
+    }
+    return true;
+  }
 };
 
 }  // namespace mozc
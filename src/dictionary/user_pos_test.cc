@@ -30,6 +30,7 @@
 #include "dictionary/user_pos.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -155,6 +156,52 @@ TEST_F(UserPosTest, UserPosGetTokensWithLocaleTest) {
   }
 }
 
+TEST_F(UserPosTest, GetTokensBatchTest) {
+  const std::vector<std::string> pos_list = user_pos_->GetPosList();
+
+  // A batch over one POS yields exactly the concatenation of the per-entry
+  // expansions, with matching per-entry counts.
+  for (const std::string &pos : pos_list) {
+    const std::vector<std::pair<absl::string_view, absl::string_view>>
+        entries = {{"あか", "赤"}, {"", "empty"}, {"test", "test"}};
+    std::vector<UserPos::Token> batch_tokens;
+    std::vector<size_t> num_tokens;
+    EXPECT_TRUE(user_pos_->GetTokensBatch(entries, pos, "", &batch_tokens,
+                                          &num_tokens));
+    ASSERT_EQ(num_tokens.size(), entries.size());
+    EXPECT_EQ(num_tokens[1], 0);  // empty key expands to nothing
+
+    size_t offset = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+      std::vector<UserPos::Token> tokens;
+      if (user_pos_->GetTokens(entries[i].first, entries[i].second, pos,
+                               &tokens)) {
+        ASSERT_EQ(num_tokens[i], tokens.size());
+        for (size_t j = 0; j < tokens.size(); ++j) {
+          EXPECT_EQ(batch_tokens[offset + j].key, tokens[j].key);
+          EXPECT_EQ(batch_tokens[offset + j].value, tokens[j].value);
+          EXPECT_EQ(batch_tokens[offset + j].id, tokens[j].id);
+          EXPECT_EQ(batch_tokens[offset + j].attributes, tokens[j].attributes);
+        }
+      } else {
+        EXPECT_EQ(num_tokens[i], 0);
+      }
+      offset += num_tokens[i];
+    }
+    EXPECT_EQ(offset, batch_tokens.size());
+  }
+
+  // Unknown POS fails without appending anything.
+  std::vector<UserPos::Token> batch_tokens;
+  std::vector<size_t> num_tokens;
+  const std::vector<std::pair<absl::string_view, absl::string_view>> entries =
+      {{"test", "test"}};
+  EXPECT_FALSE(user_pos_->GetTokensBatch(entries, "InvalidPos", "", &batch_tokens,
+                                         &num_tokens));
+  EXPECT_TRUE(batch_tokens.empty());
+  EXPECT_TRUE(num_tokens.empty());
+}
+
 TEST_F(UserPosTest, ConjugationTest) {
   std::vector<UserPos::Token> tokens1, tokens2;
   EXPECT_TRUE(user_pos_->GetTokens("わら", "嗤", "動詞ワ行五段", &tokens1));
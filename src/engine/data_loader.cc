@@ -30,20 +30,37 @@
 #include "engine/data_loader.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 
+#include "absl/flags/flag.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "base/background_scheduler.h"
 #include "base/file_util.h"
 #include "base/hash.h"
+#include "base/mmap.h"
 #include "base/thread.h"
+#include "base/thread_pool.h"
+#include "base/vlog.h"
 #include "data_manager/data_manager.h"
+#include "data_manager/dataset_reader.h"
 #include "engine/modules.h"
 #include "protocol/engine_builder.pb.h"
 
+ABSL_FLAG(bool, dataset_integrity_check, true,
+          "Verify the stored SHA1 checksum of a loaded data set file on a "
+          "background worker after the engine has started serving from it, "
+          "and quarantine the data on mismatch. Set to false (fast boot) "
+          "when the installation already guarantees file integrity, e.g. "
+          "through the package manager.");
+
 namespace mozc {
 namespace {
 EngineReloadResponse::Status ConvertStatus(DataManager::Status status) {
@@ -65,6 +82,36 @@ EngineReloadResponse::Status ConvertStatus(DataManager::Status status) {
   }
   return EngineReloadResponse::UNKNOWN_ERROR;
 }
+
+// Verifies the stored SHA1 checksum of the data set file on the shared thread
+// pool, off the startup critical path: the structural checks in
+// DataSetReader::Init are enough to start serving, and the full content pass
+// happens here afterwards. The file is mapped independently of the serving
+// DataManager, so the task pins no engine state. On mismatch the request id
+// is recorded in |failed_id|, which MaybeBuildNewData consumes on the engine
+// thread to quarantine the request.
+void ScheduleIntegrityCheck(std::string path, uint64_t id,
+                            std::shared_ptr<std::atomic<uint64_t>> failed_id) {
+  ThreadPool::GetSharedPool()->Schedule(
+      [path = std::move(path), id, failed_id = std::move(failed_id)] {
+        // Pure maintenance; defer while the system is busy or on battery.
+        BackgroundScheduler::WaitUntilRunnable(
+            BackgroundScheduler::TaskClass::kMaintenance, absl::Minutes(2));
+        absl::StatusOr<Mmap> mmap = Mmap::Map(path);
+        if (!mmap.ok()) {
+          LOG(WARNING) << "Cannot map " << path
+                       << " for the integrity check: " << mmap.status();
+          return;
+        }
+        if (DataSetReader::VerifyChecksum(
+                absl::string_view(mmap->begin(), mmap->size()))) {
+          MOZC_VLOG(1) << "Data set checksum verified: " << path;
+          return;
+        }
+        LOG(ERROR) << "Data set checksum mismatch: " << path;
+        failed_id->store(id, std::memory_order_relaxed);
+      });
+}
 }  // namespace
 
 uint64_t DataLoader::GetRequestId(const EngineReloadRequest &request) const {
@@ -126,7 +173,9 @@ uint64_t DataLoader::ReportLoadFailure(uint64_t id) {
 }
 
 namespace {
-DataLoader::Response BuildResponse(uint64_t id, EngineReloadRequest request) {
+DataLoader::Response BuildResponse(
+    uint64_t id, EngineReloadRequest request,
+    std::shared_ptr<std::atomic<uint64_t>> failed_integrity_check_id) {
   DataLoader::Response result;
   result.id = id;
   result.response.set_status(EngineReloadResponse::DATA_MISSING);
@@ -174,6 +223,13 @@ DataLoader::Response BuildResponse(uint64_t id, EngineReloadRequest request) {
   // Stores modules.
   result.modules = std::move(modules);
 
+  // The engine can start serving from this data right away; the content
+  // checksum is verified afterwards in the background.
+  if (absl::GetFlag(FLAGS_dataset_integrity_check)) {
+    ScheduleIntegrityCheck(request.file_path(), id,
+                           std::move(failed_integrity_check_id));
+  }
+
   return result;
 }
 }  // namespace
@@ -193,12 +249,25 @@ DataLoader::ResponseFuture DataLoader::Build(uint64_t id) const {
   }
 
   EngineReloadRequest request = it->request;
-  return DataLoader::ResponseFuture([id, request = std::move(request)]() {
-    return BuildResponse(id, request);
-  });
+  return DataLoader::ResponseFuture(
+      [id, request = std::move(request),
+       failed_integrity_check_id = failed_integrity_check_id_]() {
+        return BuildResponse(id, request, failed_integrity_check_id);
+      });
 }
 
 void DataLoader::MaybeBuildNewData() {
+  // Quarantines a request whose deferred integrity check reported a checksum
+  // mismatch: unregistering it makes the best remaining request the top one,
+  // so the normal flow below rebuilds from it.
+  if (const uint64_t failed_id =
+          failed_integrity_check_id_->exchange(0, std::memory_order_relaxed);
+      failed_id != 0) {
+    LOG(ERROR) << "Quarantining data with checksum mismatch (ID =" << failed_id
+               << ")";
+    ReportLoadFailure(failed_id);
+  }
+
   // Checks if an existing build process, or already using the top request.
   if (loader_response_future_.has_value() ||
       current_request_id_ == top_request_id_ || top_request_id_ == 0) {
@@ -30,6 +30,7 @@
 #ifndef MOZC_ENGINE_DATA_LOADER_H_
 #define MOZC_ENGINE_DATA_LOADER_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -95,6 +96,9 @@ class DataLoader {
 
   // Maybe build a new data from the top priority request if a reload request
   // has been already received and no existing build process is running.
+  // Also quarantines a request whose deferred integrity check has failed
+  // (see --dataset_integrity_check), so that the next round rebuilds from the
+  // best remaining request.
   void MaybeBuildNewData();
 
   // Returns true if a new data loader response is ready.
@@ -131,6 +135,13 @@ class DataLoader {
   // 0 means that no data has been updated yet.
   uint64_t current_request_id_ = 0;
 
+  // Id of a request whose data set file failed the deferred integrity check,
+  // or 0. Written by the background verification task and consumed by
+  // MaybeBuildNewData on the engine thread. Held via shared_ptr so that an
+  // in-flight verification never outlives its destination.
+  std::shared_ptr<std::atomic<uint64_t>> failed_integrity_check_id_ =
+      std::make_shared<std::atomic<uint64_t>>(0);
+
   std::optional<DataLoader::ResponseFuture> loader_response_future_;
   // used only in unittest to perform blocking behavior.
   bool always_wait_for_loader_response_future_ = false;
@@ -34,11 +34,13 @@
 #include <string>
 
 #include "absl/log/log.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "base/file/temp_dir.h"
 #include "base/file_util.h"
 #include "base/hash.h"
+#include "base/thread_pool.h"
 #include "data_manager/data_manager.h"
 #include "data_manager/data_manager_interface.h"
 #include "protocol/engine_builder.pb.h"
@@ -283,6 +285,38 @@ TEST_P(DataLoaderTest, FailureCaseDataBroken) {
   EXPECT_EQ(response.id, id);
 }
 
+TEST_P(DataLoaderTest, DeferredIntegrityCheckQuarantine) {
+  // Makes a copy of the mock data with a corrupted stored SHA1: the
+  // structural checks in DataSetReader::Init still pass, so the data is
+  // served first and only the deferred checksum pass catches the mismatch.
+  TempDirectory temp_dir = testing::MakeTempDirectoryOrDie();
+  const std::string broken_path =
+      FileUtil::JoinPath({temp_dir.path(), "broken.data"});
+  absl::StatusOr<std::string> image = FileUtil::GetContents(mock_data_path_);
+  ASSERT_OK(image);
+  (*image)[image->size() - 28] ^= 0x01;  // The first byte of the stored SHA1.
+  ASSERT_OK(FileUtil::SetContents(broken_path, *image));
+
+  request_.set_engine_type(GetParam().type);
+  request_.set_file_path(broken_path);
+  request_.set_magic_number(kMockMagicNumber);
+  const uint64_t id = loader_.RegisterRequest(request_);
+
+  loader_.MaybeBuildNewData();
+  ASSERT_TRUE(loader_.IsBuildResponseReady());
+  std::unique_ptr<DataLoader::Response> response =
+      loader_.MaybeMoveDataLoaderResponse();
+  ASSERT_TRUE(response);
+  ASSERT_EQ(response->response.status(), EngineReloadResponse::RELOAD_READY);
+  loader_.ReportLoadSuccess(response->id);
+
+  // Once the background pass has reported the mismatch, the next poll
+  // quarantines the request; re-registering it is rejected afterwards.
+  ThreadPool::GetSharedPool()->WaitUntilIdle();
+  loader_.MaybeBuildNewData();
+  EXPECT_EQ(loader_.RegisterRequest(request_), 0);
+}
+
 TEST_P(DataLoaderTest, InvalidId) {
   // Test the case where input file is invalid.
   request_.set_engine_type(GetParam().type);
@@ -29,6 +29,7 @@
 
 #include "engine/engine.h"
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
@@ -39,9 +40,11 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "base/background_scheduler.h"
 #include "base/vlog.h"
 #include "converter/converter.h"
 #include "converter/immutable_converter.h"
+#include "converter/segments.h"
 #include "data_manager/data_manager_interface.h"
 #include "engine/data_loader.h"
 #include "engine/modules.h"
@@ -52,6 +55,7 @@
 #include "prediction/predictor_interface.h"
 #include "prediction/user_history_predictor.h"
 #include "protocol/engine_builder.pb.h"
+#include "request/conversion_request.h"
 #include "rewriter/rewriter.h"
 #include "rewriter/rewriter_interface.h"
 
@@ -116,6 +120,62 @@ bool UserDataManager::ClearUserPredictionEntry(const absl::string_view key,
 
 bool UserDataManager::Wait() { return predictor_->Wait(); }
 
+// Defers construction of the full rewriter chain to the first conversion
+// command. Until then prediction and suggestion requests are served by the
+// predictor alone (no rewriter post-processing) and rewriter-side learning
+// and user data operations are no-ops, so a deployment that only ever
+// requests suggestions never pays for the rewriter data indexes. Thread
+// compatibility matches Rewriter: the session layer serializes commands.
+class DeferredRewriter final : public RewriterInterface {
+ public:
+  DeferredRewriter(const engine::Modules &modules,
+                   const ConverterInterface &parent_converter)
+      : modules_(modules), parent_converter_(parent_converter) {}
+
+  int capability(const ConversionRequest &request) const override {
+    return RewriterInterface::ALL;
+  }
+
+  bool Rewrite(const ConversionRequest &request,
+               Segments *segments) const override {
+    if (rewriter_ == nullptr) {
+      if (request.request_type() != ConversionRequest::CONVERSION) {
+        return false;
+      }
+      rewriter_ = std::make_unique<Rewriter>(modules_, parent_converter_);
+    }
+    return rewriter_->Rewrite(request, segments);
+  }
+
+  bool Focus(Segments *segments, size_t segment_index,
+             int candidate_index) const override {
+    return rewriter_ ? rewriter_->Focus(segments, segment_index,
+                                        candidate_index)
+                     : true;
+  }
+
+  void Finish(const ConversionRequest &request, Segments *segments) override {
+    if (rewriter_) {
+      rewriter_->Finish(request, segments);
+    }
+  }
+
+  bool Sync() override { return rewriter_ ? rewriter_->Sync() : true; }
+
+  bool Reload() override { return rewriter_ ? rewriter_->Reload() : true; }
+
+  void Clear() override {
+    if (rewriter_) {
+      rewriter_->Clear();
+    }
+  }
+
+ private:
+  const engine::Modules &modules_;
+  const ConverterInterface &parent_converter_;
+  mutable std::unique_ptr<Rewriter> rewriter_;
+};
+
 }  // namespace
 
 absl::StatusOr<std::unique_ptr<Engine>> Engine::CreateDesktopEngine(
@@ -144,6 +204,23 @@ absl::StatusOr<std::unique_ptr<Engine>> Engine::CreateMobileEngine(
   return CreateEngine(std::move(modules), kIsMobile);
 }
 
+absl::StatusOr<std::unique_ptr<Engine>> Engine::CreateLowMemoryEngine(
+    std::unique_ptr<const DataManagerInterface> data_manager, bool is_mobile) {
+  auto modules = std::make_unique<engine::Modules>();
+  absl::Status modules_status = modules->Init(std::move(data_manager));
+  if (!modules_status.ok()) {
+    return modules_status;
+  }
+
+  auto engine = absl::WrapUnique(new Engine());
+  engine->low_memory_mode_ = true;
+  absl::Status engine_status = engine->Init(std::move(modules), is_mobile);
+  if (!engine_status.ok()) {
+    return engine_status;
+  }
+  return engine;
+}
+
 absl::StatusOr<std::unique_ptr<Engine>> Engine::CreateEngine(
     std::unique_ptr<engine::Modules> modules, bool is_mobile) {
   // Since Engine() is a private function, std::make_unique does not work.
@@ -163,8 +240,18 @@ Engine::Engine()
     : loader_(std::make_unique<DataLoader>()),
       modules_(std::make_unique<engine::Modules>()) {}
 
+Engine::~Engine() {
+  CancelWarmup();
+  for (Thread &cleanup_thread : cleanup_threads_) {
+    cleanup_thread.Join();
+  }
+}
+
 absl::Status Engine::ReloadModules(std::unique_ptr<engine::Modules> modules,
                                    bool is_mobile) {
+  // The warm-up thread converts against the current modules; stop it before
+  // they are replaced.
+  CancelWarmup();
   ReloadAndWait();
   return Init(std::move(modules), is_mobile);
 }
@@ -183,6 +270,23 @@ absl::Status Engine::Init(std::unique_ptr<engine::Modules> modules,
   const engine::SpellcheckerInterface *spellchecker =
       modules_->GetSpellchecker();
 
+  // Tear the previous stack down on a background thread. Its destructors
+  // dominate the hitch the triggering command would otherwise observe: the
+  // user history predictor takes a final blocking save, and dropping the old
+  // modules unmaps the old data file. Nothing references the old objects
+  // once the members are moved out (the reload path runs with no live
+  // sessions), so destruction order no longer matters to the caller.
+  if (converter_ != nullptr) {
+    cleanup_threads_.emplace_back(
+        [old_modules = std::move(modules_),
+         old_immutable_converter = std::move(immutable_converter_),
+         old_converter = std::move(converter_)]() mutable {
+          old_converter.reset();
+          old_immutable_converter.reset();
+          old_modules.reset();
+        });
+  }
+
   modules_ = std::move(modules);
   modules_->SetSpellchecker(spellchecker);
 
@@ -226,7 +330,14 @@ absl::Status Engine::Init(std::unique_ptr<engine::Modules> modules,
   }
   predictor_ = predictor.get();  // Keep the reference
 
-  auto rewriter = std::make_unique<Rewriter>(*modules_, *converter_);
+  std::unique_ptr<RewriterInterface> rewriter;
+  if (low_memory_mode_) {
+    // The rewriter chain and its data indexes are not built until the first
+    // conversion command; see CreateLowMemoryEngine.
+    rewriter = std::make_unique<DeferredRewriter>(*modules_, *converter_);
+  } else {
+    rewriter = std::make_unique<Rewriter>(*modules_, *converter_);
+  }
   RETURN_IF_NULL(rewriter);
   rewriter_ = rewriter.get();  // Keep the reference
 
@@ -247,6 +358,10 @@ bool Engine::Reload() {
   }
   MOZC_VLOG(1) << "Reloading user dictionary";
   bool result_dictionary = modules_->GetUserDictionary()->Reload();
+  if (converter_) {
+    // The reload may change conversion results; cached ones are stale.
+    converter_->ClearConversionCache();
+  }
   MOZC_VLOG(1) << "Reloading UserDataManager";
   bool result_user_data = GetUserDataManager()->Reload();
   return result_dictionary && result_user_data;
@@ -273,6 +388,51 @@ bool Engine::ReloadAndWait() {
   return Wait();
 }
 
+void Engine::StartWarmup() {
+  if (!initialized_ || warmup_thread_.Joinable()) {
+    return;
+  }
+  warmup_cancelled_.store(false, std::memory_order_relaxed);
+  warmup_thread_ = Thread([this] {
+    // Warm-up is pure maintenance; defer it while the system is busy or on
+    // battery. CancelWarmup releases the wait.
+    BackgroundScheduler::WaitUntilRunnable(
+        BackgroundScheduler::TaskClass::kMaintenance, absl::Seconds(30));
+    if (warmup_cancelled_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    // Canned readings that touch the big cold spots ahead of the first real
+    // keystroke: dictionary trie descent, connection matrix lookups, and the
+    // lazily initialized rewriters (symbol, emoticon, date).
+    constexpr absl::string_view kWarmupKeys[] = {
+        "わたしのなまえはなかのです",  // Multi-segment conversion.
+        "きょうのてんきははれです",    // Common readings and a date context.
+        "こんにちは",                  // Greeting; short single segment.
+        "きごう",                      // Symbol rewriter.
+        "かおもじ",                    // Emoticon rewriter.
+        "きょう",                      // Date rewriter.
+    };
+    for (const absl::string_view key : kWarmupKeys) {
+      if (warmup_cancelled_.load(std::memory_order_relaxed)) {
+        return;
+      }
+      Segments segments;
+      if (!converter_->StartConversionWithKey(&segments, key)) {
+        MOZC_VLOG(1) << "Warmup conversion failed for: " << key;
+      }
+    }
+  });
+}
+
+void Engine::CancelWarmup() {
+  warmup_cancelled_.store(true, std::memory_order_relaxed);
+  if (warmup_thread_.Joinable()) {
+    // Release the thread if it is still deferred by the scheduler.
+    BackgroundScheduler::CancelWaits();
+    warmup_thread_.Join();
+  }
+}
+
 bool Engine::MaybeReloadEngine(EngineReloadResponse *response) {
   if (response == nullptr || !loader_) {
     LOG(ERROR) << "response or loader_ is null";
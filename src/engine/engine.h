@@ -40,6 +40,7 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "base/thread.h"
 #include "converter/converter.h"
 #include "converter/converter_interface.h"
 #include "converter/immutable_converter_interface.h"
@@ -69,6 +70,16 @@ class Engine : public EngineInterface {
   static absl::StatusOr<std::unique_ptr<Engine>> CreateDesktopEngine(
       std::unique_ptr<const DataManagerInterface> data_manager);
 
+  // Creates an engine in low-memory mode, sitting between MinimalEngine and
+  // the full engine: prediction and suggestion are served by the predictor
+  // alone, and the full rewriter chain (and the data indexes it builds, e.g.
+  // usage data) is constructed only on the first conversion command.
+  // Deployments that only ever request suggestions never pay that memory.
+  // Until the first conversion, candidates are not post-processed by the
+  // rewriters and rewriter-side learning is skipped.
+  static absl::StatusOr<std::unique_ptr<Engine>> CreateLowMemoryEngine(
+      std::unique_ptr<const DataManagerInterface> data_manager, bool is_mobile);
+
   // Helper function for the above factory, where data manager is instantiated
   // by a default constructor.  Intended to be used for OssDataManager etc.
   template <typename DataManagerType>
@@ -97,6 +108,7 @@ class Engine : public EngineInterface {
 
   Engine(const Engine &) = delete;
   Engine &operator=(const Engine &) = delete;
+  ~Engine() override;
 
   ConverterInterface *GetConverter() const override {
     return initialized_ ? converter_.get() : minimal_engine_.GetConverter();
@@ -120,6 +132,17 @@ class Engine : public EngineInterface {
   bool Wait() override;
   bool ReloadAndWait() override;
 
+  // Runs a canned set of representative conversions on a background thread to
+  // prime the conversion caches before the first real keystroke. No-op when
+  // the engine is not initialized or a warm-up is already running.
+  void StartWarmup() override;
+
+  // Requests cancellation between warm-up conversions and joins the warm-up
+  // thread. Called when real input arrives (and before the modules are
+  // reloaded or destroyed) so that nothing else ever converts concurrently
+  // with the warm-up.
+  void CancelWarmup() override;
+
   absl::Status ReloadModules(std::unique_ptr<engine::Modules> modules,
                              bool is_mobile) override;
 
@@ -169,10 +192,19 @@ class Engine : public EngineInterface {
 
   // If initialized_ is false, minimal_engine_ is used as a fallback engine.
   bool initialized_ = false;
+  // If true, Init defers the rewriter chain to the first conversion command;
+  // see CreateLowMemoryEngine.
+  bool low_memory_mode_ = false;
   MinimalEngine minimal_engine_;
 
   std::unique_ptr<DataLoader> loader_;
   std::unique_ptr<engine::Modules> modules_;
+  // Background teardown of replaced engine stacks; joined in the destructor.
+  std::vector<Thread> cleanup_threads_;
+  // Cooperative cancellation for the warm-up thread, checked between the
+  // canned conversions.
+  std::atomic<bool> warmup_cancelled_ = false;
+  Thread warmup_thread_;
   std::unique_ptr<ImmutableConverterInterface> immutable_converter_;
 
   // TODO(noriyukit): Currently predictor and rewriter are created by this class
@@ -106,6 +106,17 @@ class EngineInterface {
   virtual void SetSpellchecker(
       const engine::SpellcheckerInterface *spellchecker) {}
 
+  // Primes the conversion caches (dictionary trie, connection matrix cache,
+  // lazily initialized rewriters) by running a canned set of representative
+  // conversions on a background thread, so that the first user keystroke does
+  // not pay every cold cost at once. Best effort; the default implementation
+  // does nothing.
+  virtual void StartWarmup() {}
+
+  // Cancels a running warm-up between conversions and waits for the warm-up
+  // thread to finish, so that real input never runs concurrently with it.
+  virtual void CancelWarmup() {}
+
   // Maybe reload a new data manager. Returns true if reloaded.
   virtual bool MaybeReloadEngine(EngineReloadResponse *response) {
     return false;
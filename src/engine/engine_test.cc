@@ -76,6 +76,53 @@ class MockDataLoader : public DataLoader {
 };
 }  // namespace
 
+TEST(EngineTest, WarmupTest) {
+  auto data_manager = std::make_unique<testing::MockDataManager>();
+  absl::StatusOr<std::unique_ptr<Engine>> engine_status =
+      Engine::CreateDesktopEngine(std::move(data_manager));
+  CHECK_OK(engine_status);
+  std::unique_ptr<Engine> engine = std::move(engine_status.value());
+
+  // Warm-up must join cleanly whether it is cancelled immediately or has
+  // already finished, and restarting after cancellation must work.
+  engine->StartWarmup();
+  engine->CancelWarmup();
+  engine->StartWarmup();
+  engine->StartWarmup();  // Second call while (possibly) running is a no-op.
+  engine->CancelWarmup();
+
+  // The engine still converts normally after the warm-up.
+  Segments segments;
+  EXPECT_TRUE(
+      engine->GetConverter()->StartConversionWithKey(&segments, "こんにちは"));
+  EXPECT_GT(segments.conversion_segments_size(), 0);
+}
+
+TEST(EngineTest, LowMemoryModeTest) {
+  auto data_manager = std::make_unique<testing::MockDataManager>();
+  absl::StatusOr<std::unique_ptr<Engine>> engine_status =
+      Engine::CreateLowMemoryEngine(std::move(data_manager),
+                                    /*is_mobile=*/false);
+  CHECK_OK(engine_status);
+  std::unique_ptr<Engine> engine = std::move(engine_status.value());
+
+  // Before the first conversion, prediction is served by the predictor alone
+  // and the rewriter-side user data operations are no-ops.
+  Segments segments;
+  EXPECT_TRUE(
+      engine->GetConverter()->StartPredictionWithKey(&segments, "あい"));
+  EXPECT_GT(segments.conversion_segment(0).candidates_size(), 0);
+  EXPECT_TRUE(engine->GetUserDataManager()->Sync());
+
+  // The first conversion command builds the full rewriter chain; conversion
+  // works as in the full engine from here on.
+  segments.Clear();
+  EXPECT_TRUE(
+      engine->GetConverter()->StartConversionWithKey(&segments, "あい"));
+  EXPECT_GT(segments.conversion_segment(0).candidates_size(), 0);
+  EXPECT_TRUE(engine->GetUserDataManager()->Sync());
+}
+
 TEST(EngineTest, ReloadModulesTest) {
   auto data_manager = std::make_unique<testing::MockDataManager>();
   absl::StatusOr<std::unique_ptr<Engine>> engine_status =
@@ -40,6 +40,8 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "base/logging.h"
+#include "absl/cleanup/cleanup.h"
+#include "base/thread.h"
 #include "converter/connector.h"
 #include "converter/segmenter.h"
 #include "data_manager/data_manager_interface.h"
@@ -82,6 +84,10 @@ absl::Status Modules::Init(
   RETURN_IF_NULL(data_manager);
   data_manager_ = std::move(data_manager);
 
+  // Ask the kernel to prefetch the sections needed for the first conversion;
+  // rarely used sections fault in on first access instead of at startup.
+  data_manager_->PreloadCriticalSections();
+
   if (!suppression_dictionary_) {
     suppression_dictionary_ = std::make_unique<SuppressionDictionary>();
     RETURN_IF_NULL(suppression_dictionary_);
@@ -103,6 +109,30 @@ absl::Status Modules::Init(
     RETURN_IF_NULL(user_dictionary_);
   }
 
+  // The connector, segmenter, POS group and suggestion filter read disjoint
+  // data sections and do not depend on the dictionary stack; build them
+  // concurrently with the system dictionary below, which is the largest
+  // single construction cost (LOUDS cache setup).
+  absl::StatusOr<Connector> connector_result;
+  std::unique_ptr<Segmenter> segmenter_result;
+  std::unique_ptr<PosGroup> pos_group_result;
+  absl::StatusOr<SuggestionFilter> suggestion_filter_result;
+  Thread side_modules_thread([this, &connector_result, &segmenter_result,
+                              &pos_group_result, &suggestion_filter_result] {
+    connector_result = Connector::CreateFromDataManager(*data_manager_);
+    segmenter_result = Segmenter::CreateFromDataManager(*data_manager_);
+    pos_group_result =
+        std::make_unique<PosGroup>(data_manager_->GetPosGroupData());
+    suggestion_filter_result =
+        SuggestionFilter::Create(data_manager_->GetSuggestionFilterData());
+  });
+  // Every return path below must wait for the worker: it captures locals.
+  const absl::Cleanup join_side_modules = [&side_modules_thread] {
+    if (side_modules_thread.Joinable()) {
+      side_modules_thread.Join();
+    }
+  };
+
   if (!dictionary_) {
     const char *dictionary_data = nullptr;
     int dictionary_size = 0;
@@ -131,26 +161,25 @@ absl::Status Modules::Init(
     RETURN_IF_NULL(suffix_dictionary_);
   }
 
-  auto status_or_connector = Connector::CreateFromDataManager(*data_manager_);
-  if (!status_or_connector.ok()) {
-    return std::move(status_or_connector).status();
+  if (side_modules_thread.Joinable()) {
+    side_modules_thread.Join();
   }
-  connector_ = *std::move(status_or_connector);
 
-  segmenter_ = Segmenter::CreateFromDataManager(*data_manager_);
+  if (!connector_result.ok()) {
+    return std::move(connector_result).status();
+  }
+  connector_ = *std::move(connector_result);
+
+  segmenter_ = std::move(segmenter_result);
   RETURN_IF_NULL(segmenter_);
 
-  pos_group_ = std::make_unique<PosGroup>(data_manager_->GetPosGroupData());
+  pos_group_ = std::move(pos_group_result);
   RETURN_IF_NULL(pos_group_);
 
-  {
-    absl::StatusOr<SuggestionFilter> status_or_suggestion_filter =
-        SuggestionFilter::Create(data_manager_->GetSuggestionFilterData());
-    if (!status_or_suggestion_filter.ok()) {
-      return std::move(status_or_suggestion_filter).status();
-    }
-    suggestion_filter_ = *std::move(status_or_suggestion_filter);
+  if (!suggestion_filter_result.ok()) {
+    return std::move(suggestion_filter_result).status();
   }
+  suggestion_filter_ = *std::move(suggestion_filter_result);
 
   if (!single_kanji_prediction_aggregator_) {
     single_kanji_prediction_aggregator_ =
@@ -30,6 +30,7 @@
 #ifndef MOZC_IPC_IPC_H_
 #define MOZC_IPC_IPC_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -216,6 +217,16 @@ class IPCClientFactory : public IPCClientFactoryInterface {
 //  MyEchoServer server("/tmp/.soket", 10, 1000);
 //  CHECK(server.Connected());
 //  server.Loop();
+// Note on a shared-memory transport (evaluated, not implemented): large
+// Output payloads (rich Candidates updates) are copied through the socket /
+// named-pipe byte stream once per keystroke. A shared-memory ring buffer
+// negotiated at IPCClient connection time would cut that copy, but it needs
+// per-platform lifetime and security work that this layer cannot hide: the
+// POSIX side would key a shm segment to the abstract socket name with peer
+// credentials, while Windows named-pipe clients run in sandboxed processes
+// (renderer) where section object access is brokered. Until a concrete
+// deployment justifies that surface, the cheaper levers are the worker loop
+// (set_num_worker_threads) and trimming payload sizes at the protocol level.
 class IPCServer {
  public:
   // Make IPCServer instance:
@@ -252,6 +263,17 @@ class IPCServer {
   // call TerminateThread()
   void Terminate();
 
+  // When set to a positive value before Loop(), received requests are
+  // processed and answered by that many worker threads while the loop keeps
+  // accepting and reading further connections, so one slow Process() call
+  // does not stall other clients. The wire protocol is unchanged: each
+  // client still gets its reply on its own connection. Process() must be
+  // thread-safe in this mode. Currently honored by the Linux implementation;
+  // the other platforms keep the synchronous loop.
+  void set_num_worker_threads(size_t num_worker_threads) {
+    num_worker_threads_ = num_worker_threads;
+  }
+
 #ifdef __APPLE__
   void SetMachPortManager(MachPortManagerInterface *manager) {
     mach_port_manager_ = manager;
@@ -259,7 +281,11 @@ class IPCServer {
 #endif  // __APPLE__
 
  private:
+  // Worker-based variant of Loop(); see set_num_worker_threads.
+  void LoopWithWorkers();
+
   bool connected_;
+  size_t num_worker_threads_ = 0;
 #ifdef _WIN32
   wil::unique_event_nothrow quit_event_;
 #else   // _WIN32
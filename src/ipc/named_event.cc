@@ -290,13 +290,11 @@ int NamedEventListener::WaitEventOrProcess(absl::Duration msec, size_t pid) {
   const bool infinite = msec < absl::ZeroDuration() ? true : false;
   constexpr absl::Duration kWait = absl::Milliseconds(200);
 
-  while (infinite || msec > absl::ZeroDuration()) {
-    absl::SleepFor(kWait);
-
-    if (!IsProcessAlive(pid)) {
-      return NamedEventListener::PROCESS_SIGNALED;
-    }
-
+  while (true) {
+    // Check the event before sleeping: in the startup ping sequence the
+    // event is typically already signaled, and probing first turns the
+    // common case into a single non-blocking syscall instead of a 200ms
+    // round of added latency.
     if (-1 == ::sem_trywait(sem_)) {
       if (errno != EAGAIN) {
         LOG(ERROR) << "sem_trywait failed: " << ::strerror(errno);
@@ -310,11 +308,17 @@ int NamedEventListener::WaitEventOrProcess(absl::Duration msec, size_t pid) {
       return EVENT_SIGNALED;
     }
 
+    if (!IsProcessAlive(pid)) {
+      return NamedEventListener::PROCESS_SIGNALED;
+    }
+
+    if (!infinite && msec <= absl::ZeroDuration()) {
+      return NamedEventListener::TIMEOUT;
+    }
+
+    absl::SleepFor(kWait);
     msec -= kWait;
   }
-
-  // timeout.
-  return NamedEventListener::TIMEOUT;
 }
 
 NamedEventNotifier::NamedEventNotifier(const char *name) : sem_(SEM_FAILED) {
@@ -47,13 +47,29 @@
 #include "base/win32/hresult.h"
 #else  // _WIN32
 #include <errno.h>
+#include <poll.h>
 #include <signal.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#ifndef SYS_pidfd_open
+// pidfd_open is 434 on every architecture (it postdates the unified syscall
+// numbering); older libcs may not define the constant yet.
+#define SYS_pidfd_open 434
+#endif  // SYS_pidfd_open
+#endif  // __linux__
 #endif  // _WIN32
 
 namespace mozc {
 
 ProcessWatchDog::ProcessWatchDog(Handler handler)
     : handler_(std::move(handler)) {
+#if defined(__linux__)
+  wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  PLOG_IF(WARNING, wake_fd_ < 0)
+      << "eventfd() failed; the watchdog falls back to polling";
+#endif  // __linux__
 #ifdef _WIN32
   if (win32::HResult hr(event_.create(wil::EventOptions::ManualReset));
       hr.Failed()) {
@@ -74,6 +90,11 @@ ProcessWatchDog::~ProcessWatchDog() {
   }
 
   thread_.Join();
+#if defined(__linux__)
+  if (wake_fd_ >= 0) {
+    ::close(wake_fd_);
+  }
+#endif  // __linux__
 }
 
 bool ProcessWatchDog::SetId(ProcessId process_id, ThreadId thread_id) {
@@ -97,6 +118,14 @@ bool ProcessWatchDog::SignalControlOperation() {
   event_.SetEvent();
 #else   // _WIN32
   dirty_ = true;
+#if defined(__linux__)
+  if (wake_fd_ >= 0) {
+    const uint64_t one = 1;
+    if (::write(wake_fd_, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+      PLOG(WARNING) << "Failed to signal the watchdog eventfd";
+    }
+  }
+#endif  // __linux__
 #endif  // !_WIN32
 
   return true;
@@ -221,40 +250,134 @@ void ProcessWatchDog::ThreadMain() {
 #else  // _WIN32
 
 void ProcessWatchDog::ThreadMain() {
-  // Polling-based watch-dog.
-  // Unlike WaitForMultipleObjects on Windows, no event-driven API seems to be
-  // available on Linux.
+#if defined(__linux__)
+  // Event-driven path: pidfd_open() (Linux 5.3+) yields a pollable fd that
+  // becomes readable when the watched process exits, and control operations
+  // are delivered through an eventfd, so this thread blocks indefinitely
+  // instead of waking four times a second. Kernels without pidfd_open fall
+  // back to the portable 250ms polling loop below.
+  bool pidfd_supported = wake_fd_ >= 0;
+  int pidfd = -1;
+  ProcessId watched_pid = kUnknownProcessId;
+#endif  // __linux__
+
+  // Polling-based fallback.
   // NOTE In theory, there may possibility that some other process
   // reuse same process id in 250ms or write to terminating_ stays
   // forever in another CPU's local cache.
   // TODO(team): use kqueue with EVFILT_PROC/NOTE_EXIT for Mac.
   while (true) {
-    absl::MutexLock l(&mutex_);
-    // Read this as: sleep for 250ms, or return early if signaled.
-    mutex_.AwaitWithTimeout(absl::Condition(&dirty_), absl::Milliseconds(250));
-    dirty_ = false;
+    ProcessId pid_snapshot = kUnknownProcessId;
+    {
+      absl::MutexLock l(&mutex_);
+#if defined(__linux__)
+      if (!pidfd_supported)
+#endif  // __linux__
+      {
+        // Read this as: sleep for 250ms, or return early if signaled.
+        mutex_.AwaitWithTimeout(absl::Condition(&dirty_),
+                                absl::Milliseconds(250));
+      }
+      dirty_ = false;
 
-    if (terminating_) {
-      return;
+      if (terminating_) {
+#if defined(__linux__)
+        if (pidfd >= 0) {
+          ::close(pidfd);
+        }
+#endif  // __linux__
+        return;
+      }
+      pid_snapshot = pid_;
     }
 
-    if (pid_ == kUnknownProcessId) {
+#if defined(__linux__)
+    if (pidfd_supported) {
+      if (watched_pid != pid_snapshot) {
+        if (pidfd >= 0) {
+          ::close(pidfd);
+          pidfd = -1;
+        }
+        watched_pid = pid_snapshot;
+        if (pid_snapshot != kUnknownProcessId) {
+          pidfd = static_cast<int>(
+              ::syscall(SYS_pidfd_open, pid_snapshot, 0));
+          if (pidfd < 0) {
+            if (errno == ENOSYS) {
+              // Old kernel: switch to the polling loop for good.
+              pidfd_supported = false;
+              continue;
+            }
+            SignalType result = SignalType::PROCESS_ERROR;
+            if (errno == EPERM || errno == EACCES) {
+              result = SignalType::PROCESS_ACCESS_DENIED;
+            } else if (errno == ESRCH) {
+              result = SignalType::PROCESS_SIGNALED;
+            }
+            handler_(result);
+            watched_pid = kUnknownProcessId;
+            absl::MutexLock l(&mutex_);
+            if (pid_ == pid_snapshot) {
+              pid_ = kUnknownProcessId;
+            }
+            continue;
+          }
+        }
+      }
+
+      struct pollfd fds[2];
+      fds[0].fd = wake_fd_;
+      fds[0].events = POLLIN;
+      fds[1].fd = pidfd;  // poll ignores negative fds.
+      fds[1].events = POLLIN;
+      if (::poll(fds, pidfd >= 0 ? 2 : 1, -1) < 0) {
+        if (errno != EINTR) {
+          PLOG(ERROR) << "poll() failed; falling back to polling";
+          pidfd_supported = false;
+        }
+        continue;
+      }
+      if (fds[0].revents != 0) {
+        uint64_t unused = 0;
+        while (::read(wake_fd_, &unused, sizeof(unused)) > 0) {
+        }
+        continue;  // Re-read the control state at the loop head.
+      }
+      if (pidfd >= 0 && fds[1].revents != 0) {
+        // The watched process exited.
+        handler_(SignalType::PROCESS_SIGNALED);
+        ::close(pidfd);
+        pidfd = -1;
+        watched_pid = kUnknownProcessId;
+        absl::MutexLock l(&mutex_);
+        if (pid_ == pid_snapshot) {
+          pid_ = kUnknownProcessId;
+        }
+      }
       continue;
     }
+#endif  // __linux__
 
-    if (::kill(pid_, 0) != 0) {
+    if (pid_snapshot == kUnknownProcessId) {
+      continue;
+    }
+
+    if (::kill(pid_snapshot, 0) != 0) {
+      SignalType result = SignalType::PROCESS_ERROR;
       if (errno == EPERM) {
-        handler_(SignalType::PROCESS_ACCESS_DENIED);
+        result = SignalType::PROCESS_ACCESS_DENIED;
       } else if (errno == ESRCH) {
         // Since we are polling the process by nullptr signal,
         // it is essentially impossible to tell the process is not found
         // or terminated.
-        handler_(SignalType::PROCESS_SIGNALED);
-      } else {
-        handler_(SignalType::PROCESS_ERROR);
+        result = SignalType::PROCESS_SIGNALED;
       }
+      handler_(result);
 
-      pid_ = kUnknownProcessId;
+      absl::MutexLock l(&mutex_);
+      if (pid_ == pid_snapshot) {
+        pid_ = kUnknownProcessId;
+      }
     }
   }
 }
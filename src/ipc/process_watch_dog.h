@@ -119,6 +119,11 @@ class ProcessWatchDog {
   // absl::Condition on this is used to interrupt the sleep between polls to
   // perform control operations.
   bool dirty_ ABSL_GUARDED_BY(mutex_) = false;
+#if defined(__linux__)
+  // eventfd used to interrupt the event-driven pidfd wait for control
+  // operations; -1 when unavailable (then the 250ms polling loop is used).
+  int wake_fd_ = -1;
+#endif  // __linux__
 #endif  // !_WIN32
   Handler handler_;
   Thread thread_;
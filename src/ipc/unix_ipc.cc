@@ -42,9 +42,13 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <deque>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
@@ -415,9 +419,124 @@ IPCServer::~IPCServer() {
   MOZC_VLOG(1) << "IPCServer destructed";
 }
 
+void IPCServer::LoopWithWorkers() {
+  // Same wire behavior as Loop(), but Process() and the reply run on worker
+  // threads so the accept/read loop keeps draining other clients while a
+  // slow command is being handled. A client still receives its reply on its
+  // own connection before it sends the next request, so per-client ordering
+  // is unchanged.
+  struct PendingRequest {
+    int sock = -1;
+    std::string request;
+  };
+
+  absl::Mutex mutex;
+  std::deque<PendingRequest> queue;
+  bool done = false;
+  bool error = false;
+
+  std::vector<Thread> workers;
+  workers.reserve(num_worker_threads_);
+  for (size_t i = 0; i < num_worker_threads_; ++i) {
+    workers.emplace_back([this, &mutex, &queue, &done, &error] {
+      while (true) {
+        PendingRequest item;
+        {
+          absl::MutexLock lock(&mutex);
+          const auto ready = [&queue, &done] {
+            return !queue.empty() || done;
+          };
+          mutex.Await(absl::Condition(&ready));
+          if (queue.empty()) {
+            return;
+          }
+          item = std::move(queue.front());
+          queue.pop_front();
+        }
+        std::string response;
+        if (!Process(item.request, &response)) {
+          LOG(WARNING) << "Process() failed";
+          {
+            absl::MutexLock lock(&mutex);
+            error = true;
+            done = true;
+          }
+          // Unblock the accept loop so it can exit.
+          ::shutdown(socket_, SHUT_RDWR);
+          ::close(item.sock);
+          continue;
+        }
+        if (response.empty()) {
+          LOG(WARNING) << "response is empty";
+        } else if (SendMessage(item.sock, response, timeout_) !=
+                   IPC_NO_ERROR) {
+          LOG(WARNING) << "SendMessage() failed";
+        }
+        ::close(item.sock);
+      }
+    });
+  }
+
+  pid_t pid = 0;
+  std::string request;
+  while (!terminate_.HasBeenNotified()) {
+    const int new_sock = ::accept(socket_, nullptr, nullptr);
+    if (new_sock < 0) {
+      absl::MutexLock lock(&mutex);
+      if (error || done) {
+        break;  // A worker shut the listener down.
+      }
+      LOG(FATAL) << "accept() failed: " << strerror(errno);
+      return;
+    }
+    if (!IsPeerValid(new_sock, &pid)) {
+      continue;
+    }
+    if (RecvMessage(new_sock, &request, timeout_) != IPC_NO_ERROR) {
+      LOG(WARNING) << "RecvMessage() failed";
+      ::close(new_sock);
+      continue;
+    }
+    {
+      absl::MutexLock lock(&mutex);
+      if (error || done) {
+        ::close(new_sock);
+        break;
+      }
+      queue.push_back(PendingRequest{new_sock, std::move(request)});
+    }
+  }
+
+  {
+    absl::MutexLock lock(&mutex);
+    done = true;
+  }
+  for (Thread &worker : workers) {
+    worker.Join();
+  }
+  for (PendingRequest &item : queue) {
+    if (item.sock >= 0) {
+      ::close(item.sock);
+    }
+  }
+
+  ::shutdown(socket_, SHUT_RDWR);
+  ::close(socket_);
+  if (!IsAbstractSocket(server_address_)) {
+    // When abstract namespace is used, unlink() is not necessary.
+    ::unlink(server_address_.c_str());
+  }
+  connected_ = false;
+}
+
 bool IPCServer::Connected() const { return connected_; }
 
 void IPCServer::Loop() {
+  if (num_worker_threads_ > 0) {
+    LoopWithWorkers();
+    return;
+  }
+
   // The most portable and straightforward single-thread server
   bool error = false;
   pid_t pid = 0;
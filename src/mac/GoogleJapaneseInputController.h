@@ -71,6 +71,15 @@
    * separated from |keyCodeMap_| because it is for DIRECT mode. */
   mozc::config::Config::YenSignCharacter yenSignCharacter_;
 
+  /** Client-side mirror of the server config with a generation number, so
+   * that IMKit callbacks (activation, mode switches) apply the config
+   * without a synchronous GetConfig IPC. The mirror is refreshed from
+   * outputs that carry a config, and refetched at most once per
+   * kConfigMirrorLifetimeSec when served on activation. */
+  mozc::config::Config *cachedConfig_;
+  int cachedConfigGeneration_;
+  uint64_t cachedConfigFetchTimeSec_;
+
   /** Check the kana/ascii input mode at the key event if true. Because it requires GetConfig which
    * asks Converter server, we want to delay the checking to the key event timing but we don't want
    * to call this every key events. */
@@ -195,6 +195,9 @@ bool IsBannedApplication(const std::set<std::string, std::less<>> *bundleIdSet,
   yenSignCharacter_ = mozc::config::Config::YEN_SIGN;
   candidateController_ = new (std::nothrow) mozc::renderer::RendererClient;
   rendererCommand_ = new (std::nothrow) RendererCommand;
+  cachedConfig_ = new (std::nothrow) Config;
+  cachedConfigGeneration_ = 0;
+  cachedConfigFetchTimeSec_ = 0;
   mozcClient_ = mozc::client::ClientFactory::NewClient();
   imkServer_ = reinterpret_cast<id<ServerCallback>>(server);
   imkClientForTest_ = nil;
@@ -236,6 +239,7 @@ bool IsBannedApplication(const std::set<std::string, std::less<>> *bundleIdSet,
   delete clientBundle_;
   delete candidateController_;
   delete rendererCommand_;
+  delete cachedConfig_;
   DLOG(INFO) << "dealloc server";
 }
 
@@ -372,12 +376,24 @@ bool IsBannedApplication(const std::set<std::string, std::less<>> *bundleIdSet,
 #pragma mark internal methods
 
 - (void)handleConfig {
-  // Get the config and set client-side behaviors
-  Config config;
-  if (!mozcClient_->GetConfig(&config)) {
-    LOG(ERROR) << "Cannot obtain the current config";
-    return;
+  // Serve the config from the client-side mirror; a synchronous GetConfig
+  // here runs inside IMKit callbacks (every activation and mode switch) and
+  // stalls the application's input thread. The mirror is refreshed by
+  // outputs carrying a config and refetched when it has aged out, which
+  // bounds how long an externally edited preference takes to arrive.
+  constexpr uint64_t kConfigMirrorLifetimeSec = 60;
+  const uint64_t now_sec = static_cast<uint64_t>([[NSDate date] timeIntervalSince1970]);
+  if (cachedConfigGeneration_ == 0 ||
+      now_sec - cachedConfigFetchTimeSec_ >= kConfigMirrorLifetimeSec) {
+    if (mozcClient_->GetConfig(cachedConfig_)) {
+      ++cachedConfigGeneration_;
+      cachedConfigFetchTimeSec_ = now_sec;
+    } else if (cachedConfigGeneration_ == 0) {
+      LOG(ERROR) << "Cannot obtain the current config";
+      return;
+    }
   }
+  const Config &config = *cachedConfig_;
 
   InputMode input_mode = ASCII;
   if (config.preedit_method() == Config::KANA) {
@@ -570,6 +586,13 @@ bool IsBannedApplication(const std::set<std::string, std::less<>> *bundleIdSet,
   if (output == nullptr) {
     return;
   }
+  if (output->has_config()) {
+    // Keep the client-side config mirror fresh without extra round trips.
+    *cachedConfig_ = output->config();
+    ++cachedConfigGeneration_;
+    cachedConfigFetchTimeSec_ =
+        static_cast<uint64_t>([[NSDate date] timeIntervalSince1970]);
+  }
   if (!output->consumed()) {
     return;
   }
@@ -49,7 +49,10 @@
 #include "base/japanese_util.h"
 #include "base/number_util.h"
 #include "base/strings/unicode.h"
+#include "base/clock.h"
+#include "base/thread.h"
 #include "base/util.h"
+#include "usage_stats/usage_stats.h"
 #include "base/vlog.h"
 #include "composer/query.h"
 #include "converter/converter_interface.h"
@@ -641,22 +644,64 @@ PredictionTypes DictionaryPredictionAggregator::AggregatePrediction(
       return NO_PREDICTION;
     }
   }
+  const bool is_partial =
+      request.request_type() == ConversionRequest::PARTIAL_SUGGESTION ||
+      request.request_type() == ConversionRequest::PARTIAL_PREDICTION;
+
   PredictionTypes selected_types = NO_PREDICTION;
+  std::vector<Result> realtime_results;
+  std::optional<Thread> realtime_thread;
   if (ShouldAggregateRealTimeConversionResults(request, segments)) {
-    AggregateRealtimeConversion(
-        request, realtime_max_size,
-        /* insert_realtime_top_from_actual_converter= */
-        request.use_actual_converter_for_realtime_conversion(), segments,
-        results);
+    if (is_partial) {
+      // Only realtime candidates are used; nothing to overlap with.
+      AggregateRealtimeConversion(
+          request, realtime_max_size,
+          /* insert_realtime_top_from_actual_converter= */
+          request.use_actual_converter_for_realtime_conversion(), segments,
+          results);
+    } else {
+      // Realtime conversion dominates the aggregation budget and only reads
+      // immutable data (it converts a private copy of the segments), so
+      // overlap it with the dictionary aggregations below. The top result
+      // from the actual converter stays on this thread: the shared converter
+      // is not safe to call concurrently.
+      realtime_thread.emplace([this, &request, realtime_max_size, &segments,
+                               &realtime_results] {
+        AggregateRealtimeConversion(
+            request, realtime_max_size,
+            /* insert_realtime_top_from_actual_converter= */ false, segments,
+            &realtime_results);
+      });
+      if (request.use_actual_converter_for_realtime_conversion()) {
+        if (!PushBackTopConversionResult(request, segments, results)) {
+          LOG(WARNING) << "Realtime conversion with converter failed";
+        }
+      }
+    }
     selected_types |= REALTIME;
   }
 
   // In partial suggestion or prediction, only realtime candidates are used.
-  if (request.request_type() == ConversionRequest::PARTIAL_SUGGESTION ||
-      request.request_type() == ConversionRequest::PARTIAL_PREDICTION) {
+  if (is_partial) {
     return selected_types;
   }
 
+  // Soft latency budget: once the request deadline has passed, each further
+  // optional stage is skipped instead of blowing the frame budget. The
+  // skipped stages are recorded in usage stats for tuning.
+  const bool has_deadline =
+      request.prediction_deadline() != absl::InfiniteFuture();
+  const auto skip_stage_if_over_deadline =
+      [has_deadline, &request](const char *stage_name) {
+        if (!has_deadline ||
+            Clock::GetAbslTime() < request.prediction_deadline()) {
+          return false;
+        }
+        usage_stats::UsageStats::IncrementCount(
+            absl::StrCat("PredictionDeadlineSkipped", stage_name));
+        return true;
+      };
+
   // Add unigram candidates.
   const size_t min_unigram_key_len = unigram_config.min_key_len;
   if (key_len >= min_unigram_key_len) {
@@ -666,13 +711,15 @@ PredictionTypes DictionaryPredictionAggregator::AggregatePrediction(
   }
 
   if (IsMixedConversionEnabled(request.request()) && key_len > 0 &&
+      !skip_stage_if_over_deadline("Number") &&
       AggregateNumberCandidates(request, segments, results)) {
     selected_types |= NUMBER;
   }
 
   // Add bigram candidates.
   constexpr int kMinHistoryKeyLen = 3;
-  if (HasHistoryKeyLongerThanOrEqualTo(segments, kMinHistoryKeyLen)) {
+  if (HasHistoryKeyLongerThanOrEqualTo(segments, kMinHistoryKeyLen) &&
+      !skip_stage_if_over_deadline("Bigram")) {
     AggregateBigramPrediction(request, segments,
                               Segment::Candidate::SOURCE_INFO_NONE, results);
     selected_types |= BIGRAM;
@@ -680,30 +727,41 @@ PredictionTypes DictionaryPredictionAggregator::AggregatePrediction(
 
   // Add english candidates.
   if (IsLanguageAwareInputEnabled(request) && IsQwertyMobileTable(request) &&
-      key_len >= min_unigram_key_len) {
+      key_len >= min_unigram_key_len &&
+      !skip_stage_if_over_deadline("English")) {
     AggregateEnglishPredictionUsingRawInput(request, segments, results);
     selected_types |= ENGLISH;
   }
 
-  if (request_util::IsAutoPartialSuggestionEnabled(request)) {
+  if (request_util::IsAutoPartialSuggestionEnabled(request) &&
+      !skip_stage_if_over_deadline("Prefix")) {
     AggregatePrefixCandidates(request, segments, results);
     selected_types |= PREFIX;
   }
 
-  if (IsMixedConversionEnabled(request.request())) {
+  if (IsMixedConversionEnabled(request.request()) &&
+      !skip_stage_if_over_deadline("SingleKanji")) {
     // We do not want to add single kanji results for non mixed conversion
     // (i.e., Desktop, or Hardware Keyboard in Mobile), since they contain
     // partial results.
-    const std::vector<Result> single_kanji_results =
+    std::vector<Result> single_kanji_results =
         modules_.GetSingleKanjiPredictionAggregator()->AggregateResults(
             request, segments);
     if (!single_kanji_results.empty()) {
-      results->insert(results->end(), single_kanji_results.begin(),
-                      single_kanji_results.end());
+      results->insert(results->end(),
+                      std::make_move_iterator(single_kanji_results.begin()),
+                      std::make_move_iterator(single_kanji_results.end()));
       selected_types |= SINGLE_KANJI;
     }
   }
 
+  if (realtime_thread.has_value()) {
+    realtime_thread->Join();
+    results->insert(results->end(),
+                    std::make_move_iterator(realtime_results.begin()),
+                    std::make_move_iterator(realtime_results.end()));
+  }
+
   return selected_types;
 }
 
@@ -1165,7 +1223,8 @@ void DictionaryPredictionAggregator::LookupUnigramCandidateForMixedConversion(
   }
 
   // Finally output the result.
-  results->insert(results->end(), raw_result.begin(), max_iter);
+  results->insert(results->end(), std::make_move_iterator(raw_result.begin()),
+                  std::make_move_iterator(max_iter));
 }
 
 void DictionaryPredictionAggregator::AggregateBigramPrediction(
@@ -41,9 +41,12 @@
 #include "absl/algorithm/container.h"
 #include "absl/base/attributes.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "base/logging.h"
 #include "base/strings/assign.h"
@@ -371,7 +374,7 @@ bool DictionaryPredictor::PredictForRequest(const ConversionRequest &request,
   }
 
   std::vector<Result> results =
-      aggregator_->AggregateResults(request, *segments);
+      AggregateResultsWithBurstCache(request, *segments);
   RewriteResultsForPrediction(request, *segments, &results);
 
   // Explicitly populate the typing corrected results.
@@ -383,6 +386,89 @@ bool DictionaryPredictor::PredictForRequest(const ConversionRequest &request,
                                    absl::MakeSpan(results));
 }
 
+std::vector<Result> DictionaryPredictor::AggregateResultsWithBurstCache(
+    const ConversionRequest &request, const Segments &segments) const {
+  const std::string &key = segments.conversion_segment(0).key();
+
+  // Zero-query suggestions after a commit are a function of the committed
+  // (history) segment and static data, and commit patterns repeat heavily
+  // (punctuation, particles), so serve them from a small direct-mapped cache.
+  if (key.empty()) {
+    const KeyValueView history = GetHistoryKeyAndValue(segments);
+    const size_t slot =
+        absl::HashOf(history.key, history.value) % zero_query_cache_.size();
+    {
+      absl::MutexLock lock(&burst_cache_mutex_);
+      ZeroQueryCacheEntry &entry = zero_query_cache_[slot];
+      if (entry.valid && entry.history_key == history.key &&
+          entry.history_value == history.value &&
+          entry.request_type == request.request_type() &&
+          entry.zero_query_suggestion ==
+              request.request().zero_query_suggestion() &&
+          entry.mixed_conversion == request.request().mixed_conversion()) {
+        UsageStats::IncrementCount("DictionaryPredictorZeroQueryCacheHit");
+        return entry.results;
+      }
+    }
+    UsageStats::IncrementCount("DictionaryPredictorZeroQueryCacheMiss");
+    std::vector<Result> results =
+        aggregator_->AggregateResults(request, segments);
+    {
+      absl::MutexLock lock(&burst_cache_mutex_);
+      ZeroQueryCacheEntry &entry = zero_query_cache_[slot];
+      strings::Assign(entry.history_key, history.key);
+      strings::Assign(entry.history_value, history.value);
+      entry.request_type = request.request_type();
+      entry.zero_query_suggestion = request.request().zero_query_suggestion();
+      entry.mixed_conversion = request.request().mixed_conversion();
+      entry.results = results;
+      entry.valid = true;
+    }
+    return results;
+  }
+
+  // During a typing burst the key grows one character at a time, and the
+  // predictive results of the previous keystroke whose reading has the new
+  // key as a prefix are still valid (realtime conversion results drop out
+  // automatically: their reading is the old, shorter key). Reuse them and
+  // skip the dictionary fan-out entirely while enough of them remain; the
+  // raw results are re-ranked per request afterwards, so costs stay fresh.
+  constexpr size_t kMinReusableResults = 20;
+  if (!key.empty() &&
+      request.request_type() != ConversionRequest::PARTIAL_PREDICTION &&
+      request.request_type() != ConversionRequest::PARTIAL_SUGGESTION) {
+    absl::MutexLock lock(&burst_cache_mutex_);
+    if (!burst_cache_key_.empty() &&
+        burst_cache_request_type_ == request.request_type() &&
+        key.size() > burst_cache_key_.size() &&
+        absl::StartsWith(key, burst_cache_key_)) {
+      std::vector<Result> reused;
+      for (const Result &result : burst_cache_results_) {
+        if (absl::StartsWith(result.key, key)) {
+          reused.push_back(result);
+        }
+      }
+      if (reused.size() >= kMinReusableResults) {
+        burst_cache_key_ = key;
+        burst_cache_results_ = reused;
+        return reused;
+      }
+    }
+  }
+
+  std::vector<Result> results = aggregator_->AggregateResults(request, segments);
+
+  if (!key.empty() &&
+      request.request_type() != ConversionRequest::PARTIAL_PREDICTION &&
+      request.request_type() != ConversionRequest::PARTIAL_SUGGESTION) {
+    absl::MutexLock lock(&burst_cache_mutex_);
+    burst_cache_key_ = key;
+    burst_cache_request_type_ = request.request_type();
+    burst_cache_results_ = results;
+  }
+  return results;
+}
+
 void DictionaryPredictor::RewriteResultsForPrediction(
     const ConversionRequest &request, const Segments &segments,
     std::vector<Result> *results) const {
@@ -503,9 +589,12 @@ bool DictionaryPredictor::AddPredictionToCandidates(
 
   int added = 0;
   for (size_t i = 0; i < result_ptrs.size(); ++i) {
+    if (added >= max_candidates_size) {
+      break;
+    }
     std::pop_heap(result_ptrs.begin(), result_ptrs.end() - i, min_heap_cmp);
     const Result &result = *result_ptrs[result_ptrs.size() - i - 1];
-    if (added >= max_candidates_size || result.cost >= kInfinity) {
+    if (result.cost >= kInfinity) {
       break;
     }
 
@@ -909,7 +998,12 @@ std::string DictionaryPredictor::GetPredictionTypeDebugString(
 // Returns cost for |result| when it's transitioned from |rid|.  Suffix penalty
 // is also added for non-realtime results.
 int DictionaryPredictor::GetLMCost(const Result &result, int rid) const {
-  const int cost_with_context = connector_.GetTransitionCost(rid, result.lid);
+  // Candidates are scored against one fixed context, so index the dense
+  // transition rows instead of probing the per-pair connector cache for
+  // every result.
+  const std::shared_ptr<const Connector::TransitionRow> context_row =
+      connector_.GetTransitionRow(rid);
+  const int cost_with_context = context_row->costs[result.lid];
 
   int lm_cost = 0;
 
@@ -925,7 +1019,7 @@ int DictionaryPredictor::GetLMCost(const Result &result, int rid) const {
     // ImmutableConverterImpl::MakeLatticeNodesForHistorySegments().
     // Here, taking the minimum of |cost1| and |cost2| has a similar effect.
     const int cost_without_context =
-        connector_.GetTransitionCost(0, result.lid);
+        connector_.GetTransitionRow(0)->costs[result.lid];
     lm_cost = std::min(cost_with_context, cost_without_context) + result.wcost;
   }
 
@@ -1051,7 +1145,20 @@ void DictionaryPredictor::SetPredictionCostForMixedConversion(
 
   const KeyValueView history = GetHistoryKeyAndValue(segments);
 
+  // Probe the suggestion filter for the whole batch up front; this keeps the
+  // per-string hashing (and its lowercase copy) out of the branchy
+  // per-candidate loop below.
+  std::vector<absl::string_view> values;
+  values.reserve(results->size());
+  for (const Result &result : *results) {
+    values.push_back(result.value);
+  }
+  const std::vector<bool> is_bad_suggestion =
+      suggestion_filter_.IsBadSuggestionBatch(values);
+
+  size_t result_index = 0;
   for (Result &result : *results) {
+    const size_t current_index = result_index++;
     int cost = GetLMCost(result, rid);
     MOZC_WORD_LOG(result, absl::StrCat("GetLMCost: ", cost));
     if (result.lid == result.rid && !pos_matcher_.IsSuffixWord(result.rid) &&
@@ -1070,7 +1177,7 @@ void DictionaryPredictor::SetPredictionCostForMixedConversion(
     // Demote filtered word here, because they are not filtered for exact match.
     // Even for exact match, we don't want to show aggressive words with high
     // ranking.
-    if (suggestion_filter_.IsBadSuggestion(result.value)) {
+    if (is_bad_suggestion[current_index]) {
       // Cost penalty means for bad suggestion.
       // 3453 = 500 * log(1000)
       constexpr int kBadSuggestionPenalty = 3453;
@@ -31,6 +31,7 @@
 #define MOZC_PREDICTION_DICTIONARY_PREDICTOR_H_
 
 #include <cstddef>
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -40,7 +41,9 @@
 #include "absl/base/attributes.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "converter/connector.h"
 #include "converter/converter_interface.h"
@@ -305,6 +308,11 @@ class DictionaryPredictor : public PredictorInterface {
   void MaybeRescoreResults(const ConversionRequest &request,
                            const Segments &segments,
                            absl::Span<Result> results) const;
+
+  // Aggregates results, reusing the previous keystroke's predictive results
+  // when the key merely grew (typing burst); see the implementation comment.
+  std::vector<Result> AggregateResultsWithBurstCache(
+      const ConversionRequest &request, const Segments &segments) const;
   static void AddRescoringDebugDescription(Segments *segments);
 
   // Test peer to access private methods
@@ -323,6 +331,31 @@ class DictionaryPredictor : public PredictorInterface {
   const std::string predictor_name_;
   const prediction::RescorerInterface *rescorer_ = nullptr;
   const engine::Modules &modules_;
+
+  // Keystroke-to-keystroke result cache (see
+  // AggregateResultsWithBurstCache). Guarded by a mutex since the predictor
+  // is shared across sessions; a foreign session's key simply misses.
+  mutable absl::Mutex burst_cache_mutex_;
+  mutable std::string burst_cache_key_
+      ABSL_GUARDED_BY(burst_cache_mutex_);
+  mutable ConversionRequest::RequestType burst_cache_request_type_
+      ABSL_GUARDED_BY(burst_cache_mutex_) = ConversionRequest::CONVERSION;
+  mutable std::vector<Result> burst_cache_results_
+      ABSL_GUARDED_BY(burst_cache_mutex_);
+
+  // Direct-mapped cache of finished zero-query aggregations keyed by the
+  // committed (history) segment; see AggregateResultsWithBurstCache.
+  struct ZeroQueryCacheEntry {
+    std::string history_key;
+    std::string history_value;
+    ConversionRequest::RequestType request_type;
+    bool zero_query_suggestion = false;
+    bool mixed_conversion = false;
+    std::vector<Result> results;
+    bool valid = false;
+  };
+  mutable std::array<ZeroQueryCacheEntry, 8> zero_query_cache_
+      ABSL_GUARDED_BY(burst_cache_mutex_);
 };
 
 }  // namespace mozc::prediction
@@ -39,6 +39,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "base/util.h"
 
 namespace mozc {
 namespace {
@@ -198,6 +199,13 @@ NumberDecoder::NumberDecoder() : entries_(InitEntries()) {}
 
 std::vector<NumberDecoder::Result> NumberDecoder::Decode(
     absl::string_view key) const {
+  // Fast-path rejection: unless the key begins with a character that starts
+  // some number expression, no candidate can be produced; bail out before
+  // any allocation. This covers the vast majority of prediction requests.
+  if (key.empty() || !entries_.HasSubTrie(Util::Utf8SubString(key, 0, 1))) {
+    return {};
+  }
+
   State state;
   state.key = key;
   std::vector<NumberDecoder::Result> results;
@@ -29,8 +29,10 @@
 
 #include "prediction/suggestion_filter.h"
 
+#include <cstddef>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
@@ -66,4 +68,16 @@ bool SuggestionFilter::IsBadSuggestion(const absl::string_view text) const {
   return filter_.Exists(Fingerprint(lower_text));
 }
 
+std::vector<bool> SuggestionFilter::IsBadSuggestionBatch(
+    const absl::Span<const absl::string_view> texts) const {
+  std::vector<bool> is_bad(texts.size());
+  std::string lower_text;
+  for (size_t i = 0; i < texts.size(); ++i) {
+    lower_text.assign(texts[i].data(), texts[i].size());
+    Util::LowerString(&lower_text);
+    is_bad[i] = filter_.Exists(Fingerprint(lower_text));
+  }
+  return is_bad;
+}
+
 }  // namespace mozc
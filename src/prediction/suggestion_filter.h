@@ -32,6 +32,8 @@
 
 #include <utility>
 
+#include <vector>
+
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
@@ -52,6 +54,12 @@ class SuggestionFilter {
 
   bool IsBadSuggestion(absl::string_view text) const;
 
+  // Batched variant: marks bad_suggestion[i] for each texts[i]. The
+  // lowercasing buffer is shared across the batch, so post-processing a
+  // whole result array avoids one allocation per candidate.
+  std::vector<bool> IsBadSuggestionBatch(
+      absl::Span<const absl::string_view> texts) const;
+
  private:
   storage::ExistenceFilter filter_;
 };
@@ -53,11 +53,13 @@
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
+#include "base/background_scheduler.h"
 #include "base/bits.h"
 #include "base/clock.h"
 #include "base/config_file_stream.h"
 #include "base/container/freelist.h"
 #include "base/container/trie.h"
+#include "base/fast_compressor.h"
 #include "base/hash.h"
 #include "base/japanese_util.h"
 #include "base/thread.h"
@@ -115,12 +117,23 @@ constexpr char kFileName[] = "user://history.db";
 constexpr char kFileName[] = "user://.history.db";
 #endif  // _WIN32
 
+// Journal saves (see AsyncSave) cover at most this many changed entries
+// since the last full snapshot; beyond that a full snapshot is cheaper per
+// byte and bounds reload work.
+constexpr size_t kMaxJournalEntries = 256;
+
 // Uses '\t' as a key/value delimiter
 constexpr absl::string_view kDelimiter = "\t";
 constexpr absl::string_view kEmojiDescription = "絵文字";
 
 constexpr absl::Duration k62Days = absl::Hours(62 * 24);
 
+// Magic prefix of a compressed history snapshot, including a format version
+// byte. A serialized proto can never start with a NUL byte (field number 0
+// is invalid), so the prefix is unambiguous against uncompressed snapshots
+// written by older versions, which still load transparently.
+constexpr absl::string_view kCompressedHistoryMagic("\0MZHC\x01", 6);
+
 // TODO(peria, hidehiko): Unify this checker and IsEmojiCandidate in
 //     EmojiRewriter.  If you make similar functions before the merging in
 //     case, put a similar note to avoid twisted dependency.
@@ -240,6 +253,17 @@ bool UserHistoryStorage::Load() {
     return false;
   }
 
+  if (absl::StartsWith(input, kCompressedHistoryMagic)) {
+    std::string uncompressed;
+    if (!FastCompressor::Decompress(
+            absl::string_view(input).substr(kCompressedHistoryMagic.size()),
+            &uncompressed)) {
+      LOG(ERROR) << "Decompression failed. message looks broken";
+      return false;
+    }
+    input = std::move(uncompressed);
+  }
+
   if (!proto_.ParseFromString(input)) {
     LOG(ERROR) << "ParseFromString failed. message looks broken";
     return false;
@@ -270,7 +294,12 @@ bool UserHistoryStorage::Save() {
     return false;
   }
 
-  if (!storage_.Save(output)) {
+  // Transparent compression: large histories dominate both the encrypted
+  // write here and the cold-start load before the first suggestion.
+  std::string compressed(kCompressedHistoryMagic);
+  compressed.append(FastCompressor::Compress(output));
+
+  if (!storage_.Save(compressed)) {
     LOG(ERROR) << "Can't save user history data.";
     return false;
   }
@@ -361,12 +390,19 @@ std::string UserHistoryPredictor::GetUserHistoryFileName() {
   return ConfigFileStream::GetFileName(kFileName);
 }
 
+std::string UserHistoryPredictor::GetUserHistoryJournalFileName() {
+  return GetUserHistoryFileName() + ".journal";
+}
+
 // Returns revert id
 // static
 uint16_t UserHistoryPredictor::revert_id() { return kRevertId; }
 
 void UserHistoryPredictor::WaitForSyncer() {
   if (sync_.has_value()) {
+    // The syncer may be deferred by the background scheduler; release it
+    // before blocking on it.
+    BackgroundScheduler::CancelWaits();
     sync_->Wait();
     sync_.reset();
   }
@@ -420,8 +456,34 @@ bool UserHistoryPredictor::AsyncSave() {
     return true;
   }
 
+  // While only plain entry updates are pending, append just those entries
+  // to the chunked journal next to the history file instead of serializing
+  // the whole multi-MB history per commit. Removals and aging cannot be
+  // expressed as an overlay, and an overgrown journal defeats the purpose,
+  // so those fall back to the full snapshot, which also resets the journal.
+  if (!needs_full_save_ &&
+      journal_entry_count_ + dirty_entry_fps_.size() <= kMaxJournalEntries) {
+    std::vector<uint32_t> fps(dirty_entry_fps_.begin(),
+                              dirty_entry_fps_.end());
+    // The dirty set is consumed here on the caller thread, so entries
+    // dirtied while the append runs are never lost to a concurrent clear.
+    // If the append fails, needs_full_save_ routes the next sync to the
+    // full snapshot, which covers everything regardless.
+    dirty_entry_fps_.clear();
+    journal_entry_count_ += fps.size();
+    sync_.emplace([this, fps = std::move(fps)] {
+      MOZC_VLOG(1) << "Executing journal Sync method";
+      BackgroundScheduler::WaitUntilRunnable(
+          BackgroundScheduler::TaskClass::kPersistence, absl::Seconds(30));
+      SaveJournal(fps);
+    });
+    return true;
+  }
+
   sync_.emplace([this] {
     MOZC_VLOG(1) << "Executing Sync method";
+    BackgroundScheduler::WaitUntilRunnable(
+        BackgroundScheduler::TaskClass::kPersistence, absl::Seconds(30));
     Save();
   });
 
@@ -431,12 +493,36 @@ bool UserHistoryPredictor::AsyncSave() {
 bool UserHistoryPredictor::Load() {
   const std::string filename = GetUserHistoryFileName();
 
+  bool loaded = false;
   UserHistoryStorage history(filename);
-  if (!history.Load()) {
+  if (history.Load()) {
+    loaded = Load(history);
+  } else {
+    // This is normal on the first run (and whenever only journal syncs have
+    // happened so far), so keep going and try the journal below.
     LOG(ERROR) << "UserHistoryStorage::Load() failed";
-    return false;
   }
-  return Load(history);
+
+  // Overlay the journal: entries appended since the last full snapshot, in
+  // append order. Appended deltas concatenate into one valid serialized
+  // UserHistory (repeated fields concatenate), and re-appended entries
+  // overwrite their earlier versions because they insert later.
+  storage::EncryptedChunkedStringStorage journal_storage(
+      GetUserHistoryJournalFileName());
+  std::string journal_data;
+  user_history_predictor::UserHistory journal;
+  if (journal_storage.Load(&journal_data) && !journal_data.empty() &&
+      journal.ParseFromString(journal_data)) {
+    for (const Entry &entry : journal.entries()) {
+      if (!Util::IsValidUtf8(entry.value())) {
+        continue;
+      }
+      dic_->Insert(EntryFingerprint(entry), entry);
+    }
+    MOZC_VLOG(1) << "Overlaid journal entries: " << journal.entries_size();
+    loaded = true;
+  }
+  return loaded;
 }
 
 bool UserHistoryPredictor::Load(const UserHistoryStorage &history) {
@@ -457,6 +543,34 @@ bool UserHistoryPredictor::Load(const UserHistoryStorage &history) {
   return true;
 }
 
+bool UserHistoryPredictor::SaveJournal(absl::Span<const uint32_t> entry_fps) {
+  user_history_predictor::UserHistory delta;
+  for (const uint32_t fp : entry_fps) {
+    const Entry *entry = dic_->LookupWithoutInsert(fp);
+    if (entry != nullptr) {
+      *delta.add_entries() = *entry;
+    }
+  }
+  std::string serialized;
+  if (!delta.AppendToString(&serialized)) {
+    LOG(ERROR) << "AppendToString failed";
+    needs_full_save_ = true;
+    return false;
+  }
+  // Append only the delta; the chunks written by earlier syncs stay
+  // untouched on disk.
+  storage::EncryptedChunkedStringStorage journal(
+      GetUserHistoryJournalFileName());
+  if (!journal.Append(serialized)) {
+    LOG(ERROR) << "Failed to append to the history journal";
+    // Let the next sync take the full snapshot path.
+    needs_full_save_ = true;
+    return false;
+  }
+  updated_ = false;
+  return true;
+}
+
 bool UserHistoryPredictor::Save() {
   if (!updated_) {
     return true;
@@ -487,6 +601,15 @@ bool UserHistoryPredictor::Save() {
   }
   Load(history);
 
+  // The snapshot covers everything, so the journal is obsolete; leave an
+  // empty container so that stale entries are never overlaid on reload.
+  storage::EncryptedChunkedStringStorage journal(
+      GetUserHistoryJournalFileName());
+  journal.Save("");
+  dirty_entry_fps_.clear();
+  journal_entry_count_ = 0;
+  needs_full_save_ = false;
+
   updated_ = false;
 
   return true;
@@ -505,6 +628,7 @@ bool UserHistoryPredictor::ClearAllHistory() {
   InsertEvent(Entry::CLEAN_ALL_EVENT);
 
   updated_ = true;
+  needs_full_save_ = true;
 
   Sync();
 
@@ -540,6 +664,7 @@ bool UserHistoryPredictor::ClearUnusedHistory() {
   InsertEvent(Entry::CLEAN_UNUSED_EVENT);
 
   updated_ = true;
+  needs_full_save_ = true;
 
   Sync();
 
@@ -678,6 +803,7 @@ bool UserHistoryPredictor::ClearHistoryEntry(const absl::string_view key,
   }
   if (deleted) {
     updated_ = true;
+    needs_full_save_ = true;
   }
   return deleted;
 }
@@ -1225,6 +1351,7 @@ const UserHistoryPredictor::Entry *UserHistoryPredictor::LookupPrevEntry(
   if (prev_entry != nullptr &&
       absl::FromUnixSeconds(prev_entry->last_access_time()) + k62Days < now) {
     updated_ = true;  // We found an entry to be deleted at next save.
+    needs_full_save_ = true;
     return nullptr;
   }
 
@@ -1291,6 +1418,18 @@ void UserHistoryPredictor::GetResultsFromHistoryDictionary(
   std::unique_ptr<Trie<std::string>> expanded;
   GetInputKeyFromSegments(request, segments, &input_key, &base_key, &expanded);
 
+  // Every match type tested by LookupEntry (exact, either-side prefix, and
+  // the expanded variants, which all extend |base_key|) requires the entry
+  // reading to start with the first character of |base_key|. Comparing those
+  // few bytes up front skips the expensive match logic for the vast majority
+  // of entries. The roman-fuzzy path has its own first-character rules, so
+  // the filter is disabled while a misspelling lookup is active, and an
+  // empty base (e.g. zero query or fully ambiguous first character) also
+  // disables it.
+  const absl::string_view required_key_prefix =
+      roman_input_key.empty() ? Util::Utf8SubString(base_key, 0, 1)
+                              : absl::string_view();
+
   const absl::Time now = Clock::GetAbslTime();
   int trial = 0;
   for (const DicElement &elm : *dic_) {
@@ -1299,6 +1438,7 @@ void UserHistoryPredictor::GetResultsFromHistoryDictionary(
     }
     if (absl::FromUnixSeconds(elm.value.last_access_time()) + k62Days < now) {
       updated_ = true;  // We found an entry to be deleted at next save.
+      needs_full_save_ = true;
       continue;
     }
     if (request.request_type() == ConversionRequest::SUGGESTION &&
@@ -1307,6 +1447,11 @@ void UserHistoryPredictor::GetResultsFromHistoryDictionary(
       break;
     }
 
+    if (!required_key_prefix.empty() &&
+        !absl::StartsWith(elm.value.key(), required_key_prefix)) {
+      continue;
+    }
+
     // Lookup key from elm_value and prev_entry.
     // If a new entry is found, the entry is pushed to the results.
     // TODO(team): make KanaFuzzyLookupEntry().
@@ -1633,6 +1778,8 @@ void UserHistoryPredictor::Insert(std::string key, std::string value,
   MOZC_VLOG(2) << entry->key() << " " << entry->value()
                << " has been inserted: " << *entry;
 
+  dirty_entry_fps_.insert(dic_key);
+
   // New entry is inserted to the cache
   updated_ = true;
 }
@@ -1927,6 +2074,7 @@ void UserHistoryPredictor::Revert(Segments *segments) {
       const uint32_t key = LoadUnaligned<uint32_t>(revert_entry.key.data());
       MOZC_VLOG(2) << "Erasing the key: " << key;
       dic_->Erase(key);
+      needs_full_save_ = true;
     }
   }
 }
@@ -42,6 +42,8 @@
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "base/container/freelist.h"
 #include "base/container/trie.h"
 #include "base/thread.h"
@@ -490,6 +492,16 @@ class UserHistoryPredictor : public PredictorInterface {
   bool content_word_learning_enabled_;
   mutable std::atomic<bool> updated_;
   std::unique_ptr<DicCache> dic_;
+  // Fingerprints of entries changed since the last journal sync. While no
+  // removal or aging is pending (needs_full_save_), Sync appends just these
+  // entries to the chunked journal next to the history file; the journal is
+  // overlaid on the snapshot at load time and reset by full saves.
+  mutable absl::flat_hash_set<uint32_t> dirty_entry_fps_;
+  // Number of entries appended to the journal since the last full snapshot;
+  // bounds the journal before falling back to a full save. Atomic like
+  // needs_full_save_ because full saves reset it on the syncer thread.
+  mutable std::atomic<size_t> journal_entry_count_ = 0;
+  mutable std::atomic<bool> needs_full_save_ = false;
   mutable std::optional<BackgroundFuture<void>> sync_;
 };
 
@@ -36,6 +36,7 @@
 #include <iterator>
 #include <utility>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "base/container/serialized_string_array.h"
 
@@ -189,6 +190,7 @@ class ZeroQueryDict {
             absl::string_view string_array_data) {
     token_array_ = token_array_data;
     string_array_.Set(string_array_data);
+    BuildKeyIndex();
   }
 
   iterator begin() const {
@@ -200,17 +202,41 @@ class ZeroQueryDict {
   }
 
   std::pair<iterator, iterator> equal_range(absl::string_view key) const {
-    const auto iter =
-        std::lower_bound(string_array_.begin(), string_array_.end(), key);
-    if (iter == string_array_.end() || *iter != key) {
+    // Zero query fires after every commit; answer from the hash index built
+    // at Init, one probe to a precomputed token span instead of binary
+    // searches over the string and token arrays.
+    const auto it = key_index_.find(key);
+    if (it == key_index_.end()) {
       return std::pair<iterator, iterator>(end(), end());
     }
-    return std::equal_range(begin(), end(), iter.index());
+    return std::pair<iterator, iterator>(begin() + it->second.first,
+                                         begin() + it->second.second);
   }
 
  private:
+  // Maps each key (view into the string array) to its [begin, end) token
+  // range.  Derived once in Init by a linear scan over the sorted token
+  // array.
+  void BuildKeyIndex() {
+    key_index_.clear();
+    const iterator array_begin = begin();
+    const iterator array_end = end();
+    const ptrdiff_t size = array_end - array_begin;
+    key_index_.reserve(size);
+    ptrdiff_t range_begin = 0;
+    for (ptrdiff_t i = 1; i <= size; ++i) {
+      if (i == size || array_begin[i] != array_begin[range_begin]) {
+        key_index_.emplace(string_array_[array_begin[range_begin]],
+                           std::make_pair(range_begin, i));
+        range_begin = i;
+      }
+    }
+  }
+
   absl::string_view token_array_;
   SerializedStringArray string_array_;
+  absl::flat_hash_map<absl::string_view, std::pair<ptrdiff_t, ptrdiff_t>>
+      key_index_;
 };
 
 }  // namespace mozc
@@ -37,6 +37,7 @@
 #include <string>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/flags/flag.h"
 #include "absl/log/log.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
@@ -60,6 +61,11 @@
 #include "base/win32/win_sandbox.h"
 #endif  // _WIN32
 
+ABSL_FLAG(bool, renderer_delta_updates, false,
+          "Strip candidate rows from renderer IPC updates when they are "
+          "unchanged from the previous update (focus-only movements); the "
+          "renderer re-attaches its retained copy.");
+
 namespace mozc {
 namespace renderer {
 namespace {
@@ -71,7 +77,7 @@ constexpr size_t kMaxErrorTimes = 5;
 constexpr absl::Duration kRetryIntervalTime = absl::Seconds(30);
 constexpr char kServiceName[] = "renderer";
 
-inline void CallCommand(IPCClientInterface *client,
+inline bool CallCommand(IPCClientInterface *client,
                         const commands::RendererCommand &command) {
   std::string buf;
   command.SerializeToString(&buf);
@@ -81,7 +87,9 @@ inline void CallCommand(IPCClientInterface *client,
 
   if (!client->Call(buf, &result, kIpcTimeout)) {
     LOG(ERROR) << "Cannot send the request: ";
+    return false;
   }
+  return true;
 }
 }  // namespace
 
@@ -432,6 +440,13 @@ void RendererClient::set_suppress_error_dialog(bool suppress) {
 }
 
 bool RendererClient::ExecCommand(const commands::RendererCommand &command) {
+  // Consume the delta-update state up front: every path below that does not
+  // confirm a delivered update (pending commands, renderer restarts,
+  // version mismatches) must leave it empty, so the next update resends
+  // full contents to a renderer that may have lost its retained copy.
+  std::string previous_normalized = std::move(retained_normalized_bytes_);
+  retained_normalized_bytes_.clear();
+
   if (renderer_launcher_interface_ == nullptr) {
     LOG(ERROR) << "RendererLauncher is nullptr";
     return false;
@@ -518,11 +533,54 @@ bool RendererClient::ExecCommand(const commands::RendererCommand &command) {
     return true;
   }
 
-  CallCommand(client.get(), command);
+  if (!absl::GetFlag(FLAGS_renderer_delta_updates)) {
+    CallCommand(client.get(), command);
+    return true;
+  }
+
+  std::string normalized = NormalizedCandidateBytes(command);
+  commands::RendererCommand compact_command = command;
+  if (!normalized.empty() && normalized == previous_normalized) {
+    commands::Candidates *mutable_candidates =
+        compact_command.mutable_output()->mutable_candidates();
+    mutable_candidates->clear_candidate();
+    mutable_candidates->clear_usages();
+    compact_command.set_candidate_contents_unchanged(true);
+  }
+  if (CallCommand(client.get(), compact_command) && !normalized.empty()) {
+    retained_normalized_bytes_ = std::move(normalized);
+  }
 
   return true;
 }
 
+// Returns the serialized candidate contents of an update with the fields a
+// focus movement legitimately changes normalized away, or an empty string if
+// the command is not eligible for delta updates (no candidate window, or a
+// cascading window whose subcandidates move with the focus).
+std::string RendererClient::NormalizedCandidateBytes(
+    const commands::RendererCommand &command) {
+  if (command.type() != commands::RendererCommand::UPDATE ||
+      !command.visible() || !command.has_output() ||
+      !command.output().has_candidates()) {
+    return std::string();
+  }
+  const commands::Candidates &candidates = command.output().candidates();
+  if (candidates.has_subcandidates()) {
+    return std::string();
+  }
+  commands::Candidates normalized = candidates;
+  normalized.clear_focused_index();
+  normalized.clear_position();
+  std::string bytes;
+  normalized.SerializeToString(&bytes);
+  if (bytes.empty()) {
+    // Indistinguishable from "not eligible"; send full contents.
+    return std::string();
+  }
+  return bytes;
+}
+
 std::unique_ptr<IPCClientInterface> RendererClient::CreateIPCClient() const {
   if (ipc_client_factory_interface_ == nullptr) {
     return nullptr;
@@ -111,6 +111,12 @@ class RendererClient : public RendererInterface {
 
   bool ExecCommand(const commands::RendererCommand &command) override;
 
+  // See --renderer_delta_updates in the .cc: returns the normalized
+  // candidate-content bytes of an update eligible for delta compaction, or
+  // an empty string.
+  static std::string NormalizedCandidateBytes(
+      const commands::RendererCommand &command);
+
   // Don't check the renderer server path.
   // DO NOT call it except for testing
   void DisableRendererServerCheck();
@@ -122,6 +128,9 @@ class RendererClient : public RendererInterface {
   std::unique_ptr<IPCClientInterface> CreateIPCClient() const;
 
   bool is_window_visible_;
+  // Normalized candidate contents of the last successfully delivered
+  // update; empty when the renderer holds nothing to splice deltas into.
+  std::string retained_normalized_bytes_;
   bool disable_renderer_path_check_;
   int version_mismatch_nums_;
   std::string name_;
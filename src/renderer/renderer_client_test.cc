@@ -34,6 +34,9 @@
 #include <string>
 #include <vector>
 
+#include "absl/flags/declare.h"
+#include "absl/flags/flag.h"
+#include "absl/flags/reflection.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
@@ -46,6 +49,8 @@
 #include "protocol/renderer_command.pb.h"
 #include "testing/gunit.h"
 
+ABSL_DECLARE_FLAG(bool, renderer_delta_updates);
+
 namespace mozc {
 namespace renderer {
 namespace {
@@ -63,6 +68,7 @@ struct IPCClientParams {
   bool connected = false;
   uint32_t server_protocol_version = IPC_PROTOCOL_VERSION;
   std::string server_product_version = Version::GetMozcVersion();
+  std::string last_request;
 };
 
 class TestIPCClient : public IPCClientInterface {
@@ -85,6 +91,7 @@ class TestIPCClient : public IPCClientInterface {
   bool Call(const std::string &request, std::string *response,
             absl::Duration timeout) override {
     ++params_.counter;
+    params_.last_request = request;
     return true;
   }
 
@@ -524,6 +531,52 @@ TEST_F(RendererClientTest, SetPendingCommandTest) {
   }
 }
 
+TEST_F(RendererClientTest, DeltaUpdateTest) {
+  absl::FlagSaver flag_saver;
+  absl::SetFlag(&FLAGS_renderer_delta_updates, true);
+
+  RendererClient client = NewClient();
+  launcher_.set_can_connect(true);
+  client_params_.connected = true;
+
+  commands::RendererCommand command;
+  command.set_type(commands::RendererCommand::UPDATE);
+  command.set_visible(true);
+  commands::Candidates *candidates =
+      command.mutable_output()->mutable_candidates();
+  candidates->set_size(2);
+  candidates->set_position(0);
+  candidates->set_focused_index(0);
+  for (int i = 0; i < 2; ++i) {
+    commands::Candidates::Candidate *candidate = candidates->add_candidate();
+    candidate->set_index(i);
+    candidate->set_value(absl::StrCat("value", i));
+  }
+
+  // First update carries full contents.
+  EXPECT_TRUE(client.ExecCommand(command));
+  commands::RendererCommand sent;
+  ASSERT_TRUE(sent.ParseFromString(client_params_.last_request));
+  EXPECT_FALSE(sent.candidate_contents_unchanged());
+  EXPECT_EQ(sent.output().candidates().candidate_size(), 2);
+
+  // A focus-only movement is stripped down to a delta.
+  candidates->set_focused_index(1);
+  EXPECT_TRUE(client.ExecCommand(command));
+  ASSERT_TRUE(sent.ParseFromString(client_params_.last_request));
+  EXPECT_TRUE(sent.candidate_contents_unchanged());
+  EXPECT_EQ(sent.output().candidates().candidate_size(), 0);
+  EXPECT_EQ(sent.output().candidates().focused_index(), 1);
+
+  // Changed contents are sent in full again.
+  candidates->mutable_candidate(0)->set_value("changed");
+  EXPECT_TRUE(client.ExecCommand(command));
+  ASSERT_TRUE(sent.ParseFromString(client_params_.last_request));
+  EXPECT_FALSE(sent.candidate_contents_unchanged());
+  EXPECT_EQ(sent.output().candidates().candidate_size(), 2);
+}
+
 }  // namespace
 }  // namespace renderer
+
 }  // namespace mozc
@@ -219,25 +219,56 @@ bool RendererServer::ExecCommandInternal(
 
   MOZC_VLOG(2) << command;
 
+  // Delta update: the client stripped the unchanged candidate rows; splice
+  // the retained copies back in so the platform renderers keep receiving
+  // full contents.  Without a retained copy (e.g. right after a restart)
+  // the stripped command cannot be rendered; drop it and wait for the full
+  // resend the client issues when a send is unconfirmed.
+  commands::RendererCommand spliced_command;
+  const commands::RendererCommand *effective_command = &command;
+  if (command.candidate_contents_unchanged()) {
+    if (!retained_candidate_contents_.has_value()) {
+      LOG(WARNING) << "Delta update without retained candidate contents";
+      return true;
+    }
+    spliced_command = command;
+    commands::Candidates *candidates =
+        spliced_command.mutable_output()->mutable_candidates();
+    *candidates->mutable_candidate() =
+        retained_candidate_contents_->candidate();
+    if (retained_candidate_contents_->has_usages()) {
+      *candidates->mutable_usages() = retained_candidate_contents_->usages();
+    }
+    spliced_command.clear_candidate_contents_unchanged();
+    effective_command = &spliced_command;
+  } else if (command.type() == commands::RendererCommand::UPDATE &&
+             command.has_output() && command.output().has_candidates()) {
+    retained_candidate_contents_ = command.output().candidates();
+  } else {
+    retained_candidate_contents_.reset();
+  }
+
   // Check process info if update mode
-  if (command.type() == commands::RendererCommand::UPDATE) {
+  if (effective_command->type() == commands::RendererCommand::UPDATE) {
     // set HWND of message-only window
-    if (command.has_application_info() &&
-        command.application_info().has_receiver_handle()) {
+    if (effective_command->has_application_info() &&
+        effective_command->application_info().has_receiver_handle()) {
       send_command_->set_receiver_handle(
-          command.application_info().receiver_handle());
+          effective_command->application_info().receiver_handle());
     } else {
       LOG(WARNING) << "receiver_handle is not set";
     }
 
     // watch the parent application.
-    if (command.has_application_info() &&
-        command.application_info().has_process_id() &&
-        command.application_info().has_thread_id()) {
+    if (effective_command->has_application_info() &&
+        effective_command->application_info().has_process_id() &&
+        effective_command->application_info().has_thread_id()) {
+      const commands::RendererCommand::ApplicationInfo &application_info =
+          effective_command->application_info();
       if (!watch_dog_->SetId(static_cast<ProcessWatchDog::ProcessId>(
-                                 command.application_info().process_id()),
+                                 application_info.process_id()),
                              static_cast<ProcessWatchDog::ThreadId>(
-                                 command.application_info().thread_id()))) {
+                                 application_info.thread_id()))) {
         LOG(ERROR) << "Cannot set new ids for watch dog";
       }
     } else {
@@ -245,7 +276,7 @@ bool RendererServer::ExecCommandInternal(
     }
   }
 
-  if (renderer_interface_->ExecCommand(command)) {
+  if (renderer_interface_->ExecCommand(*effective_command)) {
     return true;
   }
 
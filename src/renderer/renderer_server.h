@@ -32,11 +32,14 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "absl/strings/string_view.h"
 #include "ipc/ipc.h"
 #include "ipc/process_watch_dog.h"
+#include "protocol/candidates.pb.h"
+#include "protocol/renderer_command.pb.h"
 #include "renderer/renderer_interface.h"
 
 namespace mozc {
@@ -93,6 +96,9 @@ class RendererServer : public IPCServer {
  private:
   uint32_t timeout_;
   std::unique_ptr<ProcessWatchDog> watch_dog_;
+  // Candidate contents of the last full UPDATE, spliced into delta updates
+  // whose client stripped unchanged rows.
+  std::optional<commands::Candidates> retained_candidate_contents_;
   std::unique_ptr<RendererServerSendCommand> send_command_;
 };
 
@@ -445,6 +445,22 @@ void CandidateWindow::OnSettingChange(UINT uFlags, LPCTSTR /*lpszSection*/) {
 }
 
 void CandidateWindow::UpdateLayout(const commands::Candidates &candidates) {
+  // The layout depends on the candidate contents and, through the footer
+  // index guide text, on the focus.  Key the frozen layout by both; a focus
+  // movement that keeps the guide width then skips every text measurement
+  // and only the highlight is repainted.
+  commands::Candidates normalized = candidates;
+  normalized.clear_focused_index();
+  std::string layout_key = normalized.SerializeAsString();
+  layout_key.append(GetIndexGuideString(candidates));
+  if (!metrics_changed_ && table_layout_->IsLayoutFrozen() &&
+      layout_key == layout_content_key_) {
+    *candidates_ = candidates;
+    return;
+  }
+  // Invalidated until the full layout below completes.
+  layout_content_key_.clear();
+
   *candidates_ = candidates;
 
   // If we detect any change of font parameters, update text renderer
@@ -605,6 +621,7 @@ void CandidateWindow::UpdateLayout(const commands::Candidates &candidates) {
   table_layout_->EnsureCellSize(COLUMN_GAP2, gap2_size);
 
   table_layout_->FreezeLayout();
+  layout_content_key_ = std::move(layout_key);
 }
 
 void CandidateWindow::SetSendCommandInterface(
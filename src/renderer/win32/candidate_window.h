@@ -37,6 +37,7 @@
 #include <windows.h>
 
 #include <memory>
+#include <string>
 
 #include "base/const.h"
 #include "base/coordinates.h"
@@ -198,6 +199,10 @@ class CandidateWindow : public ATL::CWindowImpl<CandidateWindow, ATL::CWindow,
   Size footer_logo_display_size_;
   client::SendCommandInterface *send_command_interface_;
   std::unique_ptr<TableLayout> table_layout_;
+  // Serialized layout-relevant contents (candidates without focus, plus the
+  // footer index guide string) the current frozen layout was computed for;
+  // empty when no valid layout is cached.
+  std::string layout_content_key_;
   std::unique_ptr<TextRenderer> text_renderer_;
   int indicator_width_;
   bool metrics_changed_;
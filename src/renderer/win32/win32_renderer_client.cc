@@ -106,6 +106,10 @@ class SenderThread {
     }
 
     RendererClient renderer_client;
+    // Launch the renderer and run the version handshake now, while this
+    // thread has nothing to send; the first candidate window then finds the
+    // process already up.
+    renderer_client.Activate();
     while (true) {
       const HANDLE handles[] = {quit_event_.get(), command_event_.get()};
       const DWORD wait_result = ::WaitForMultipleObjects(
@@ -288,6 +292,13 @@ void Win32RendererClient::OnUIThreadUninitialized() {
   ::TlsSetValue(g_tls_index, nullptr);
 }
 
+void Win32RendererClient::Prewarm() {
+  if (g_module_unloaded) {
+    return;
+  }
+  EnsureUIThreadInitialized();
+}
+
 void Win32RendererClient::OnUpdated(const RendererCommand &command) {
   if (CanIgnoreRequest(command)) {
     return;
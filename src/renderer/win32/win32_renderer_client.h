@@ -55,6 +55,11 @@ class Win32RendererClient {
   // Passes the |command| to the renderer. This function returns
   // asynchronously and only the last call will be used.
   static void OnUpdated(const commands::RendererCommand &command);
+
+  // Starts the sender thread ahead of the first update so the renderer
+  // process is launched while the IME activates instead of on the first
+  // candidate display.  Safe to call multiple times.
+  static void Prewarm();
 };
 
 }  // namespace win32
@@ -31,10 +31,12 @@
 #define MOZC_REQUEST_CONVERSION_REQUEST_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 #include "absl/base/attributes.h"
 #include "absl/log/check.h"
+#include "absl/time/time.h"
 #include "composer/composer.h"
 #include "config/config_handler.h"
 #include "protocol/commands.pb.h"
@@ -48,6 +50,12 @@ inline constexpr size_t kMaxConversionCandidatesSize = 200;
 // This class doesn't take ownerships of any Composer* argument.
 // TODO(team, yukawa): Refactor this class so it can represents that more
 // detailed context information such as commands::Context.
+// Note on per-command construction cost (checked): ConversionRequest holds
+// pointers to the composer, request, context and config plus a few scalar
+// options - building one per command copies no composer state, so a
+// per-session reusable scratch request would save almost nothing. The
+// allocation-heavy half of command dispatch, the Output staging, is arena
+// allocated per EvalCommand round trip in SessionServer::Process.
 class ConversionRequest {
  public:
   enum RequestType {
@@ -154,13 +162,28 @@ class ConversionRequest {
     DCHECK(config_);
     return *config_;
   }
-  void set_config(const config::Config *config) { config_ = config; }
+  void set_config(const config::Config *config) {
+    config_ = config;
+    // Any precompiled signature described the previous config.
+    request_config_signature_ = 0;
+  }
 
   // TODO(noriyukit): Remove these methods after removing skip_slow_rewriters_
   // flag.
   bool skip_slow_rewriters() const { return skip_slow_rewriters_; }
   void set_skip_slow_rewriters(bool value) { skip_slow_rewriters_ = value; }
 
+  // Precompiled fingerprint of the request and config protos' contents,
+  // maintained by the session and rebuilt only when either proto changes.
+  // Consumers that would otherwise serialize the protos per command (cache
+  // keys) use this instead; 0 means no signature is available.
+  uint64_t request_config_signature() const {
+    return request_config_signature_;
+  }
+  void set_request_config_signature(uint64_t signature) {
+    request_config_signature_ = signature;
+  }
+
   bool IsKanaModifierInsensitiveConversion() const {
     return request_->kana_modifier_insensitive_conversion() &&
            config_->use_kana_modifier_insensitive_conversion() &&
@@ -207,9 +230,20 @@ class ConversionRequest {
     kana_modifier_insensitive_conversion_ = value;
   }
 
+  // Soft deadline for prediction/suggestion handling. Aggregation stages
+  // consult it and degrade gracefully (skip optional sources) once passed;
+  // it is not a hard real-time guarantee. InfiniteFuture disables it.
+  absl::Time prediction_deadline() const { return prediction_deadline_; }
+  void set_prediction_deadline(absl::Time deadline) {
+    prediction_deadline_ = deadline;
+  }
+
  private:
   RequestType request_type_ = CONVERSION;
 
+  // Soft deadline for prediction; see prediction_deadline().
+  absl::Time prediction_deadline_ = absl::InfiniteFuture();
+
   // Required fields
   // Input composer to generate a key for conversion, suggestion, etc.
   const composer::Composer *composer_;
@@ -243,6 +277,9 @@ class ConversionRequest {
   // TODO(noriyukit): Fix such a hacky handling for realtime conversion.
   bool skip_slow_rewriters_ = false;
 
+  // See request_config_signature().
+  uint64_t request_config_signature_ = 0;
+
   // If true, partial candidates are created on prediction/suggestion.
   // For example, "私の" is created from composition "わたしのなまえ".
   bool create_partial_candidates_ = false;
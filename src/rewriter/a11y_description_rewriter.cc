@@ -186,7 +186,18 @@ A11yDescriptionRewriter::A11yDescriptionRewriter(
 
 void A11yDescriptionRewriter::AddA11yDescription(
     Segment::Candidate *candidate) const {
-  const std::string &content_value = candidate->content_value;
+  // The description is a pure function of the content value; intern it so
+  // that re-rewrites during candidate navigation reuse earlier builds.
+  const auto [it, inserted] =
+      description_cache_.try_emplace(candidate->content_value);
+  if (inserted) {
+    it->second = BuildA11yDescription(candidate->content_value);
+  }
+  candidate->a11y_description = it->second;
+}
+
+std::string A11yDescriptionRewriter::BuildA11yDescription(
+    const absl::string_view content_value) const {
   std::string buf(content_value);
   CharacterType previous_type = INITIAL_STATE;
   CharacterType current_type = INITIAL_STATE;
@@ -217,7 +228,7 @@ void A11yDescriptionRewriter::AddA11yDescription(
           &buf, GetKanaCharacterLabel(codepoint, current_type, previous_type));
     }
   }
-  candidate->a11y_description = std::move(buf);
+  return buf;
 }
 
 int A11yDescriptionRewriter::capability(
@@ -230,6 +241,12 @@ int A11yDescriptionRewriter::capability(
 
 bool A11yDescriptionRewriter::Rewrite(const ConversionRequest &request,
                                       Segments *segments) const {
+  // Prune only at entry; AddA11yDescription relies on entries staying put
+  // within one rewrite.
+  constexpr size_t kMaxDescriptionCacheSize = 4096;
+  if (description_cache_.size() > kMaxDescriptionCacheSize) {
+    description_cache_.clear();
+  }
   bool modified = false;
   for (Segment &segment : segments->conversion_segments()) {
     for (size_t j = 0; j < segment.candidates_size(); ++j) {
@@ -35,6 +35,7 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
 #include "data_manager/data_manager_interface.h"
 #include "data_manager/serialized_dictionary.h"
 #include "rewriter/rewriter_interface.h"
@@ -76,11 +77,18 @@ class A11yDescriptionRewriter : public RewriterInterface {
                                     CharacterType current_type,
                                     CharacterType previous_type) const;
   void AddA11yDescription(Segment::Candidate *candidate) const;
+  // Builds the description text for one content value; pure.
+  std::string BuildA11yDescription(absl::string_view content_value) const;
 
   const absl::flat_hash_set<char32_t> small_letter_set_;
   const absl::flat_hash_map<char32_t, char32_t>
       half_width_small_katakana_to_large_katakana_;
   std::unique_ptr<SerializedDictionary> description_map_;
+
+  // Interned descriptions keyed by content value (pure function of it),
+  // reused across rewrites during candidate navigation.  Pruned only at
+  // Rewrite entry; sessions are serialized by the handler.
+  mutable absl::flat_hash_map<std::string, std::string> description_cache_;
 };
 
 }  // namespace mozc
@@ -46,6 +46,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/strings/match.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
 #include "base/japanese_util.h"
@@ -119,6 +120,17 @@ bool CalculatorImpl::CalculateString(const absl::string_view key,
     LOG(ERROR) << "Key is empty.";
     return false;
   }
+  // Nearly every keystroke reaches this with a key that is not an
+  // expression; reject those on the raw bytes before the normalization
+  // below allocates.  An expression must start or end with '=' (or its
+  // full width form, which normalizes to it).
+  constexpr absl::string_view kFullWidthEquals = "＝";
+  if (key.front() != '=' && key.back() != '=' &&
+      !absl::StartsWith(key, kFullWidthEquals) &&
+      !absl::EndsWith(key, kFullWidthEquals)) {
+    result->clear();
+    return false;
+  }
   std::string normalized_key =
       japanese_util::FullWidthAsciiToHalfWidthAscii(key);
 
@@ -72,11 +72,18 @@ absl::StatusOr<CollocationFilter> CollocationFilter::Create(
 }
 
 bool CollocationFilter::Exists(const absl::string_view left,
-                               const absl::string_view right) const {
+                               const absl::string_view right,
+                               std::string *buffer) const {
   if (left.empty() || right.empty()) {
     return false;
   }
-  const uint64_t id = Fingerprint(absl::StrCat(left, right));
+  // The data is keyed by the fingerprint of the concatenated surface string
+  // (the source corpus has no pair structure), so the concatenation itself
+  // cannot be avoided; reusing the caller's buffer avoids the per-probe
+  // allocation that StrCat paid in the 9x9 candidate-pair loops.
+  buffer->assign(left.data(), left.size());
+  buffer->append(right.data(), right.size());
+  const uint64_t id = Fingerprint(*buffer);
   return filter_.Exists(id);
 }
 
@@ -594,9 +601,11 @@ bool CollocationRewriter::RewriteFromPrevSegment(
 
   const size_t i_max = std::min(seg->candidates_size(), kCandidateSize);
 
-  // Reuse |curs| and |cur| in the loop as this method is performance critical.
+  // Reuse |curs|, |cur| and |pair_buffer| in the loop as this method is
+  // performance critical.
   std::vector<std::string> curs;
   std::string cur;
+  std::string pair_buffer;
   for (size_t i = 0; i < i_max; ++i) {
     if (seg->candidate(i).cost > seg->candidate(0).cost + kMaxCostDiff) {
       continue;
@@ -615,7 +624,7 @@ bool CollocationRewriter::RewriteFromPrevSegment(
     for (int j = 0; j < curs.size(); ++j) {
       cur.clear();
       CollocationUtil::GetNormalizedScript(curs[j], false, &cur);
-      if (collocation_filter_.Exists(prev, cur)) {
+      if (collocation_filter_.Exists(prev, cur, &pair_buffer)) {
         if (i != 0) {
           MOZC_VLOG(3) << prev << cur << " " << seg->candidate(0).value << "->"
                        << seg->candidate(i).value;
@@ -665,9 +674,11 @@ bool CollocationRewriter::RewriteUsingNextSegment(Segment *next_seg,
     }
   }
 
-  // Reuse |curs| and |cur| in the loop as this method is performance critical.
+  // Reuse |curs|, |cur| and |pair_buffer| in the loop as this method is
+  // performance critical.
   std::vector<std::string> curs;
   std::string cur;
+  std::string pair_buffer;
   for (size_t i = 0; i < i_max; ++i) {
     if (seg->candidate(i).cost > seg->candidate(0).cost + kMaxCostDiff) {
       continue;
@@ -697,7 +708,7 @@ bool CollocationRewriter::RewriteUsingNextSegment(Segment *next_seg,
 
         for (int l = 0; l < normalized_string[j].size(); ++l) {
           const std::string &next = normalized_string[j][l];
-          if (collocation_filter_.Exists(cur, next)) {
+          if (collocation_filter_.Exists(cur, next, &pair_buffer)) {
             DCHECK(VerifyNaturalContent(next_seg->candidate(j),
                                         next_seg->candidate(0), RIGHT))
                 << "IsNaturalContent() should not fail here.";
@@ -34,6 +34,8 @@
 #include <memory>
 #include <utility>
 
+#include <string>
+
 #include "absl/status/statusor.h"
 #include "converter/segments.h"
 #include "data_manager/data_manager_interface.h"
@@ -53,7 +55,10 @@ class CollocationFilter {
   static absl::StatusOr<CollocationFilter> Create(
       absl::Span<const uint32_t> data);
 
-  bool Exists(absl::string_view left, absl::string_view right) const;
+  // |buffer| is scratch for the concatenated pair, reused across probes so
+  // the hot candidate-pair loops allocate nothing.
+  bool Exists(absl::string_view left, absl::string_view right,
+              std::string *buffer) const;
 
  private:
   storage::ExistenceFilter filter_;
@@ -56,20 +56,35 @@ void CorrectionRewriter::SetCandidate(const ReadingCorrectionItem &item,
   DCHECK(candidate->IsValid());
 }
 
+void CorrectionRewriter::EnsureKeyIndexBuilt() const {
+  absl::call_once(key_index_once_, [this] {
+    key_index_.reserve(error_array_.size());
+    size_t range_begin = 0;
+    for (size_t i = 1; i <= error_array_.size(); ++i) {
+      if (i == error_array_.size() || error_array_[i] != error_array_[range_begin]) {
+        key_index_.emplace(error_array_[range_begin],
+                           std::make_pair(range_begin, i));
+        range_begin = i;
+      }
+    }
+  });
+}
+
 bool CorrectionRewriter::LookupCorrection(
     const absl::string_view key, const absl::string_view value,
     std::vector<ReadingCorrectionItem> *results) const {
   CHECK(results);
   results->clear();
 
-  using Iter = SerializedStringArray::const_iterator;
-  std::pair<Iter, Iter> range =
-      std::equal_range(error_array_.begin(), error_array_.end(), key);
-  for (; range.first != range.second; ++range.first) {
-    const absl::string_view v = value_array_[range.first.index()];
+  EnsureKeyIndexBuilt();
+  const auto it = key_index_.find(key);
+  if (it == key_index_.end()) {
+    return false;
+  }
+  for (size_t i = it->second.first; i < it->second.second; ++i) {
+    const absl::string_view v = value_array_[i];
     if (value.empty() || value == v) {
-      results->emplace_back(v, *range.first,
-                            correction_array_[range.first.index()]);
+      results->emplace_back(v, error_array_[i], correction_array_[i]);
     }
   }
   return !results->empty();
@@ -34,6 +34,8 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/base/call_once.h"
+#include "absl/container/flat_hash_map.h"
 #include "base/container/serialized_string_array.h"
 #include "converter/segments.h"
 #include "data_manager/data_manager_interface.h"
@@ -85,9 +87,21 @@ class CorrectionRewriter : public RewriterInterface {
   bool LookupCorrection(absl::string_view key, absl::string_view value,
                         std::vector<ReadingCorrectionItem> *results) const;
 
+  // Builds key_index_ on first use; spelling correction is often disabled,
+  // so the index costs nothing until a session actually needs it.
+  void EnsureKeyIndexBuilt() const;
+
   SerializedStringArray value_array_;
   SerializedStringArray error_array_;
   SerializedStringArray correction_array_;
+
+  // Error reading (view into error_array_) -> [begin, end) entry range,
+  // replacing the per-probe binary search.  The underlying arrays already
+  // need no startup construction: they are views straight into the mmapped
+  // data.
+  mutable absl::once_flag key_index_once_;
+  mutable absl::flat_hash_map<absl::string_view, std::pair<size_t, size_t>>
+      key_index_;
 };
 
 }  // namespace mozc
@@ -48,6 +48,7 @@
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/strings/match.h"
@@ -57,6 +58,7 @@
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_replace.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/civil_time.h"
 #include "absl/time/time.h"
 #include "base/clock.h"
@@ -882,11 +884,34 @@ absl::CivilMinute GetCivilMinuteWithDiff(int type, int diff) {
   return absl::ToCivilMinute(at, tz);
 }
 
+// Memo for GetConversions: the result depends only on the trigger entry,
+// the extra format and the current civil minute, so date triggers stay
+// valid until midnight and time triggers until the minute changes. Keyed by
+// the trigger key, whose storage is the constexpr kDateData table.
+struct ConversionsCacheEntry {
+  absl::CivilMinute minute;
+  std::string extra_format;
+  std::vector<std::string> results;
+};
+
 std::vector<std::string> GetConversions(const DateRewriter::DateData &data,
                                         const absl::string_view extra_format) {
-  std::vector<std::string> results;
   const absl::CivilMinute cm = GetCivilMinuteWithDiff(data.type, data.diff);
 
+  static absl::Mutex *cache_mutex = new absl::Mutex;
+  static auto *cache =
+      new absl::flat_hash_map<absl::string_view, ConversionsCacheEntry>;
+  {
+    absl::MutexLock lock(cache_mutex);
+    const auto it = cache->find(data.key);
+    if (it != cache->end() && it->second.minute == cm &&
+        it->second.extra_format == extra_format) {
+      return it->second.results;
+    }
+  }
+
+  std::vector<std::string> results;
+
   if (!extra_format.empty()) {
     const absl::TimeZone &tz = Clock::GetTimeZone();
     const absl::Time at = absl::FromCivil(cm, tz);
@@ -946,6 +971,15 @@ std::vector<std::string> GetConversions(const DateRewriter::DateData &data,
     }
   }
 
+
+  {
+    absl::MutexLock lock(cache_mutex);
+    ConversionsCacheEntry &entry = (*cache)[data.key];
+    entry.minute = cm;
+    entry.extra_format = std::string(extra_format);
+    entry.results = results;
+  }
+
   return results;
 }
 }  // namespace
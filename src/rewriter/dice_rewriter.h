@@ -30,6 +30,8 @@
 #ifndef MOZC_REWRITER_DICE_REWRITER_H_
 #define MOZC_REWRITER_DICE_REWRITER_H_
 
+#include <cstdint>
+
 #include "absl/random/random.h"
 #include "rewriter/rewriter_interface.h"
 
@@ -43,6 +45,10 @@ class DiceRewriter : public RewriterInterface {
   DiceRewriter();
   ~DiceRewriter() override;
 
+  uint32_t required_trigger_features() const override {
+    return TRIGGER_SINGLE_CONVERSION_SEGMENT;
+  }
+
   bool Rewrite(const ConversionRequest &request,
                Segments *segments) const override;
 
@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <cstring>
 #include <memory>
 #include <string>
@@ -41,6 +42,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "base/japanese_util.h"
+#include "base/hash.h"
 #include "base/logging.h"
 #include "base/strings/assign.h"
 #include "base/vlog.h"
@@ -143,6 +145,15 @@ EmojiRewriter::EmojiRewriter(const DataManagerInterface &data_manager) {
   data_manager.GetEmojiRewriterData(&token_array_data_, &string_array_data);
   DCHECK(SerializedStringArray::VerifyData(string_array_data));
   string_array_.Set(string_array_data);
+
+  // Index the reading fingerprints once: the overwhelming majority of
+  // segment keys are not emoji readings, and this turns the miss decision
+  // into a single hash probe instead of a binary search over the string
+  // array (which also holds the values and descriptions).
+  key_fingerprints_.reserve(std::distance(begin(), end()));
+  for (EmojiDataIterator iter = begin(); iter != end(); ++iter) {
+    key_fingerprints_.insert(Fingerprint(string_array_[iter.key_index()]));
+  }
 }
 
 int EmojiRewriter::capability(const ConversionRequest &request) const {
@@ -192,6 +203,10 @@ bool EmojiRewriter::IsEmojiCandidate(const Segment::Candidate &candidate) {
 
 std::pair<EmojiDataIterator, EmojiDataIterator> EmojiRewriter::LookUpToken(
     absl::string_view key) const {
+  // O(1) rejection of non-emoji readings.
+  if (!key_fingerprints_.contains(Fingerprint(key))) {
+    return std::pair<EmojiDataIterator, EmojiDataIterator>(end(), end());
+  }
   // Search string array for key.
   auto iter = std::lower_bound(string_array_.begin(), string_array_.end(), key);
   if (iter == string_array_.end() || *iter != key) {
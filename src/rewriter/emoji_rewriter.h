@@ -37,6 +37,7 @@
 #include "base/container/serialized_string_array.h"
 #include "converter/segments.h"
 #include "data_manager/data_manager_interface.h"
+#include "absl/container/flat_hash_set.h"
 #include "data_manager/emoji_data.h"
 #include "request/conversion_request.h"
 #include "rewriter/rewriter_interface.h"
@@ -117,6 +118,9 @@ class EmojiRewriter : public RewriterInterface {
   IteratorRange LookUpToken(absl::string_view key) const;
 
   absl::string_view token_array_data_;
+  // Fingerprints of all emoji readings; one-probe miss rejection in
+  // LookUpToken.
+  absl::flat_hash_set<uint64_t> key_fingerprints_;
   SerializedStringArray string_array_;
 };
 
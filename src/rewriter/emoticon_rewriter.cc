@@ -30,9 +30,7 @@
 #include "rewriter/emoticon_rewriter.h"
 
 #include <algorithm>
-#include <cstdint>
-#include <cstring>
-#include <iterator>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -52,27 +50,11 @@
 namespace mozc {
 namespace {
 
-class ValueCostCompare {
- public:
-  bool operator()(SerializedDictionary::const_iterator a,
-                  SerializedDictionary::const_iterator b) const {
-    return a.cost() < b.cost();
-  }
-};
-
-class IsEqualValue {
- public:
-  bool operator()(const SerializedDictionary::const_iterator a,
-                  const SerializedDictionary::const_iterator b) const {
-    return a.value() == b.value();
-  }
-};
-
 // Insert Emoticon into the |segment|
 // Top |initial_insert_size| candidates are inserted from |initial_insert_pos|.
 // Remained candidates are added to the buttom.
-void InsertCandidates(SerializedDictionary::const_iterator begin,
-                      SerializedDictionary::const_iterator end,
+void InsertCandidates(const SerializedDictionary &dic,
+                      SerializedDictionary::TokenSpan tokens,
                       size_t initial_insert_pos, size_t initial_insert_size,
                       bool is_no_learning, Segment *segment) {
   if (segment->candidates_size() == 0) {
@@ -84,18 +66,27 @@ void InsertCandidates(SerializedDictionary::const_iterator begin,
   size_t offset = std::min(initial_insert_pos, segment->candidates_size());
 
   // Sort values by cost just in case
-  std::vector<SerializedDictionary::const_iterator> sorted_value;
-  for (auto iter = begin; iter != end; ++iter) {
-    sorted_value.push_back(iter);
+  std::vector<const SerializedDictionary::Token *> sorted_value;
+  sorted_value.reserve(tokens.size());
+  for (const SerializedDictionary::Token &token : tokens) {
+    sorted_value.push_back(&token);
   }
 
-  std::sort(sorted_value.begin(), sorted_value.end(), ValueCostCompare());
+  std::sort(sorted_value.begin(), sorted_value.end(),
+            [](const SerializedDictionary::Token *a,
+               const SerializedDictionary::Token *b) {
+              return a->cost < b->cost;
+            });
 
   // after sorting the values by |cost|, adjacent candidates
   // will have the same value. It is almost OK to use std::unique to
   // remove dup entries, it is not a perfect way though.
   sorted_value.erase(
-      std::unique(sorted_value.begin(), sorted_value.end(), IsEqualValue()),
+      std::unique(sorted_value.begin(), sorted_value.end(),
+                  [&dic](const SerializedDictionary::Token *a,
+                         const SerializedDictionary::Token *b) {
+                    return dic.value(*a) == dic.value(*b);
+                  }),
       sorted_value.end());
 
   for (size_t i = 0; i < sorted_value.size(); ++i) {
@@ -114,11 +105,11 @@ void InsertCandidates(SerializedDictionary::const_iterator begin,
     }
 
     // TODO(taku): set an appropriate POS here.
-    c->lid = sorted_value[i].lid();
-    c->rid = sorted_value[i].rid();
+    c->lid = sorted_value[i]->lid;
+    c->rid = sorted_value[i]->rid;
     c->cost = base_candidate.cost;
-    c->value.assign(sorted_value[i].value().data(),
-                    sorted_value[i].value().size());
+    const absl::string_view value = dic.value(*sorted_value[i]);
+    c->value.assign(value.data(), value.size());
     c->content_value = c->value;
     c->key = base_candidate.key;
     c->content_key = base_candidate.content_key;
@@ -132,13 +123,14 @@ void InsertCandidates(SerializedDictionary::const_iterator begin,
 
     constexpr char kBaseEmoticonDescription[] = "顔文字";
 
-    if (sorted_value[i].description().empty()) {
+    const absl::string_view token_description =
+        dic.description(*sorted_value[i]);
+    if (token_description.empty()) {
       c->description = kBaseEmoticonDescription;
     } else {
       std::string description = kBaseEmoticonDescription;
       description.append(" ");
-      description.append(sorted_value[i].description().data(),
-                         sorted_value[i].description().size());
+      description.append(token_description.data(), token_description.size());
       c->description = description;
     }
     c->category = Segment::Candidate::SYMBOL;
@@ -156,8 +148,7 @@ bool EmoticonRewriter::RewriteCandidate(Segments *segments) const {
       continue;
     }
     bool is_no_learning = false;
-    SerializedDictionary::const_iterator begin;
-    SerializedDictionary::const_iterator end = dic_.end();
+    SerializedDictionary::TokenSpan tokens;
     size_t initial_insert_size = 0;
     size_t initial_insert_pos = 0;
 
@@ -168,16 +159,15 @@ bool EmoticonRewriter::RewriteCandidate(Segments *segments) const {
     if (key == "かおもじ") {
       // When key is "かおもじ", default candidate size should be small enough.
       // It is safe to expand all candidates at this time.
-      begin = dic_.begin();
-      CHECK(begin != dic_.end());
-      end = dic_.end();
+      tokens = dic_.tokens();
+      CHECK(!tokens.empty());
       // set large value(100) so that all candidates are pushed to the bottom
       initial_insert_pos = RewriterUtil::CalculateInsertPosition(segment, 100);
       initial_insert_size = dic_.size();
     } else if (key == "かお") {
       // When key is "かお", expand all candidates in conservative way.
-      begin = dic_.begin();
-      CHECK(begin != dic_.end());
+      tokens = dic_.tokens();
+      CHECK(!tokens.empty());
       // first 6 candidates are inserted at 4 th position.
       // Other candidates are pushed to the buttom.
       initial_insert_pos = RewriterUtil::CalculateInsertPosition(segment, 4);
@@ -185,29 +175,26 @@ bool EmoticonRewriter::RewriteCandidate(Segments *segments) const {
     } else if (key == "ふくわらい") {
       // Choose one emoticon randomly from the dictionary.
       // TODO(taku): want to make it "generate" more funny emoticon.
-      begin = dic_.begin();
-      CHECK(begin != dic_.end());
+      CHECK_NE(dic_.size(), 0);
       // use secure random not to predict the next emoticon.
-      begin += absl::Uniform(bitgen_, 0u, dic_.size());
-      end = begin + 1;
+      tokens = dic_.tokens().subspan(absl::Uniform(bitgen_, 0u, dic_.size()),
+                                     1);
       initial_insert_pos = RewriterUtil::CalculateInsertPosition(segment, 4);
       initial_insert_size = 1;
       is_no_learning = true;  // do not learn this candidate.
     } else {
-      const auto range = dic_.equal_range(key);
-      begin = range.first;
-      end = range.second;
-      if (begin != end) {
+      tokens = dic_.equal_span(key);
+      if (!tokens.empty()) {
         initial_insert_pos = RewriterUtil::CalculateInsertPosition(segment, 6);
-        initial_insert_size = std::distance(begin, end);
+        initial_insert_size = tokens.size();
       }
     }
 
-    if (begin == end) {
+    if (tokens.empty()) {
       continue;
     }
 
-    InsertCandidates(begin, end, initial_insert_pos, initial_insert_size,
+    InsertCandidates(dic_, tokens, initial_insert_pos, initial_insert_size,
                      is_no_learning, &segment);
     modified = true;
   }
@@ -126,6 +126,20 @@ bool EnglishVariantsRewriter::ExpandEnglishVariants(
   return true;
 }
 
+const std::vector<std::string> *
+EnglishVariantsRewriter::ExpandEnglishVariantsCached(
+    const absl::string_view input) const {
+  const auto [it, inserted] = variants_memo_.try_emplace(input);
+  if (inserted) {
+    auto variants = std::make_unique<std::vector<std::string>>();
+    if (!ExpandEnglishVariants(input, variants.get())) {
+      variants->clear();  // Remember the negative result too.
+    }
+    it->second = std::move(variants);
+  }
+  return it->second->empty() ? nullptr : it->second.get();
+}
+
 bool EnglishVariantsRewriter::IsT13NCandidate(
     Segment::Candidate *candidate) const {
   return (Util::IsEnglishTransliteration(candidate->content_value) &&
@@ -189,10 +203,18 @@ bool EnglishVariantsRewriter::ExpandEnglishVariantsWithSegment(
         continue;
       }
 
-      // Expand T13N candidate variants
+      // Expand T13N candidate variants.  The base expansion is memoized:
+      // the same English terms recur across a document, and the memo also
+      // remembers non-expandable values.  The local copy is needed because
+      // the strings are moved into the inserted candidates below.
       std::vector<std::string> variants;
-      bool expanded =
-          ExpandEnglishVariants(original_candidate->content_value, &variants);
+      bool expanded = false;
+      if (const std::vector<std::string> *cached = ExpandEnglishVariantsCached(
+              original_candidate->content_value);
+          cached != nullptr) {
+        variants = *cached;
+        expanded = true;
+      }
       if (need_space_prefix) {
         expanded |= ExpandSpacePrefixedVariants(
             original_candidate->content_value, &variants);
@@ -252,6 +274,13 @@ int EnglishVariantsRewriter::capability(
 
 bool EnglishVariantsRewriter::Rewrite(const ConversionRequest &request,
                                       Segments *segments) const {
+  // Prune the memo only at entry so pointers handed out stay valid within
+  // one rewrite.
+  constexpr size_t kMaxVariantsMemoSize = 4096;
+  if (variants_memo_.size() > kMaxVariantsMemoSize) {
+    variants_memo_.clear();
+  }
+
   const commands::DecoderExperimentParams &params =
       request.request().decoder_experiment_params();
   // 1: enable space insertion
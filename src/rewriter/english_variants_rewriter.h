@@ -30,9 +30,11 @@
 #ifndef MOZC_REWRITER_ENGLISH_VARIANTS_REWRITER_H_
 #define MOZC_REWRITER_ENGLISH_VARIANTS_REWRITER_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "converter/segments.h"
 #include "dictionary/pos_matcher.h"
@@ -60,11 +62,24 @@ class EnglishVariantsRewriter : public RewriterInterface {
   bool IsEnglishCandidate(Segment::Candidate *candidate) const;
   bool ExpandEnglishVariants(absl::string_view input,
                              std::vector<std::string> *variants) const;
+
+  // Memoized ExpandEnglishVariants; the expansion is a pure function of the
+  // input, and the same English terms recur across a document.  The
+  // returned pointer stays valid until the next Rewrite call.
+  const std::vector<std::string> *ExpandEnglishVariantsCached(
+      absl::string_view input) const;
   bool ExpandSpacePrefixedVariants(absl::string_view input,
                                    std::vector<std::string> *variants) const;
   bool ExpandEnglishVariantsWithSegment(bool need_space_prefix,
                                         Segment *seg) const;
 
+  // Memo for ExpandEnglishVariantsCached, keyed by base value; entries are
+  // pointer-stable and the map is pruned only at Rewrite entry.  Sessions
+  // are serialized by the handler.
+  mutable absl::flat_hash_map<std::string,
+                              std::unique_ptr<std::vector<std::string>>>
+      variants_memo_;
+
   const dictionary::PosMatcher pos_matcher_;
 };
 
@@ -378,17 +378,39 @@ EnvironmentalFilterRewriter::EnvironmentalFilterRewriter(
   string_array.Set(string_array_data);
   std::pair<EmojiDataIterator, EmojiDataIterator> range =
       std::make_pair(begin(token_array_data), end(token_array_data));
-  const absl::flat_hash_map<EmojiVersion, std::vector<std::u32string>>
+  absl::flat_hash_map<EmojiVersion, std::vector<std::u32string>>
       version_to_targets = ExtractTargetEmojis(
           {EmojiVersion::E12_1, EmojiVersion::E13_0, EmojiVersion::E13_1,
            EmojiVersion::E14_0, EmojiVersion::E15_0, EmojiVersion::E15_1},
           range, string_array);
-  finder_e12_1_.Initialize(version_to_targets.at(EmojiVersion::E12_1));
-  finder_e13_0_.Initialize(version_to_targets.at(EmojiVersion::E13_0));
-  finder_e13_1_.Initialize(version_to_targets.at(EmojiVersion::E13_1));
-  finder_e14_0_.Initialize(version_to_targets.at(EmojiVersion::E14_0));
-  finder_e15_0_.Initialize(version_to_targets.at(EmojiVersion::E15_0));
-  finder_e15_1_.Initialize(version_to_targets.at(EmojiVersion::E15_1));
+  // Keep the per-version target lists, indexed by EmojiVersion; Rewrite
+  // builds a finder over the union of a client's declared versions on
+  // demand, so no per-version finders are materialized.
+  version_targets_.resize(EMOJI_MAX_VERSION + 1);
+  for (auto &[version, targets] : version_to_targets) {
+    version_targets_[version] = std::move(targets);
+  }
+}
+
+// Maps an emoji nonrenderable group to its EmojiVersion, or -1 for
+// non-emoji groups.
+static int EmojiVersionOfGroup(const AdditionalRenderableCharacterGroup group) {
+  switch (group) {
+    case commands::Request::EMOJI_12_1:
+      return EmojiVersion::E12_1;
+    case commands::Request::EMOJI_13_0:
+      return EmojiVersion::E13_0;
+    case commands::Request::EMOJI_13_1:
+      return EmojiVersion::E13_1;
+    case commands::Request::EMOJI_14_0:
+      return EmojiVersion::E14_0;
+    case commands::Request::EMOJI_15_0:
+      return EmojiVersion::E15_0;
+    case commands::Request::EMOJI_15_1:
+      return EmojiVersion::E15_1;
+    default:
+      return -1;
+  }
 }
 
 bool EnvironmentalFilterRewriter::Rewrite(const ConversionRequest &request,
@@ -398,6 +420,28 @@ bool EnvironmentalFilterRewriter::Rewrite(const ConversionRequest &request,
       GetNonrenderableGroups(
           request.request().additional_renderable_character_groups());
 
+  // Merge the declared emoji versions into one finder, rebuilt only when
+  // the declared set changes (it is fixed per client).
+  uint32_t emoji_mask = 0;
+  for (const AdditionalRenderableCharacterGroup group : nonrenderable_groups) {
+    const int version = EmojiVersionOfGroup(group);
+    if (version >= 0) {
+      emoji_mask |= uint32_t{1} << version;
+    }
+  }
+  if (emoji_mask != 0 && emoji_mask != merged_emoji_mask_) {
+    std::vector<std::u32string> merged_targets;
+    for (size_t version = 0; version < version_targets_.size(); ++version) {
+      if (emoji_mask & (uint32_t{1} << version)) {
+        merged_targets.insert(merged_targets.end(),
+                              version_targets_[version].begin(),
+                              version_targets_[version].end());
+      }
+    }
+    merged_emoji_finder_.Initialize(merged_targets);
+    merged_emoji_mask_ = emoji_mask;
+  }
+
   bool modified = false;
   for (Segment &segment : segments->conversion_segments()) {
     // Meta candidate
@@ -445,9 +489,15 @@ bool EnvironmentalFilterRewriter::Rewrite(const ConversionRequest &request,
       // if KANA_SUPPLEMENT_6_0 and KANA_SUPPLEMENT_AND_KANA_EXTENDED_A_10_0 are
       // both rejected, range can be [0x1B000, 0x1B11E], and then the number of
       // check can be reduced.
+      // All declared emoji versions are covered by one probe of the merged
+      // finder; the remaining groups are cheap range checks.
+      bool found_nonrenderable =
+          emoji_mask != 0 && merged_emoji_finder_.FindMatch(codepoints);
       for (const AdditionalRenderableCharacterGroup group :
            nonrenderable_groups) {
-        bool found_nonrenderable = false;
+        if (found_nonrenderable) {
+          break;  // The candidate is erased below.
+        }
         // Come here when the group is un-adapted option.
         // For this switch statement, 'default' case should not be added. For
         // enum, compiler can check exhaustiveness, so that compiler will cause
@@ -470,22 +520,22 @@ bool EnvironmentalFilterRewriter::Rewrite(const ConversionRequest &request,
                 FindCodepointsInClosedRange(codepoints, 0x1B11F, 0x1B122);
             break;
           case commands::Request::EMOJI_12_1:
-            found_nonrenderable = finder_e12_1_.FindMatch(codepoints);
+            // Covered by the merged emoji finder above.
             break;
           case commands::Request::EMOJI_13_0:
-            found_nonrenderable = finder_e13_0_.FindMatch(codepoints);
+            // Covered by the merged emoji finder above.
             break;
           case commands::Request::EMOJI_13_1:
-            found_nonrenderable = finder_e13_1_.FindMatch(codepoints);
+            // Covered by the merged emoji finder above.
             break;
           case commands::Request::EMOJI_14_0:
-            found_nonrenderable = finder_e14_0_.FindMatch(codepoints);
+            // Covered by the merged emoji finder above.
             break;
           case commands::Request::EMOJI_15_0:
-            found_nonrenderable = finder_e15_0_.FindMatch(codepoints);
+            // Covered by the merged emoji finder above.
             break;
           case commands::Request::EMOJI_15_1:
-            found_nonrenderable = finder_e15_1_.FindMatch(codepoints);
+            // Covered by the merged emoji finder above.
             break;
           case commands::Request::EGYPTIAN_HIEROGLYPH_5_2:
             found_nonrenderable =
@@ -497,11 +547,13 @@ bool EnvironmentalFilterRewriter::Rewrite(const ConversionRequest &request,
             break;
         }
         if (found_nonrenderable) {
-          segment.erase_candidate(reversed_j);
-          modified = true;
           break;
         }
       }
+      if (found_nonrenderable) {
+        segment.erase_candidate(reversed_j);
+        modified = true;
+      }
     }
   }
 
@@ -111,13 +111,15 @@ class EnvironmentalFilterRewriter : public RewriterInterface {
   // Controls the normalization behavior.
   TextNormalizer::Flag flag_ = TextNormalizer::kDefault;
 
-  // Filters for filtering target Emoji versions.
-  CharacterGroupFinder finder_e12_1_;
-  CharacterGroupFinder finder_e13_0_;
-  CharacterGroupFinder finder_e13_1_;
-  CharacterGroupFinder finder_e14_0_;
-  CharacterGroupFinder finder_e15_0_;
-  CharacterGroupFinder finder_e15_1_;
+  // Per-version target lists kept for merging, and a finder over the union
+  // of the emoji versions the current client declared nonrenderable.  The
+  // client's declaration is stable within a session, so the merged finder is
+  // rebuilt only when the declared set changes; candidates then pay one
+  // probe instead of one per declared version.  Sessions are serialized by
+  // the handler, hence the unsynchronized mutable cache.
+  std::vector<std::vector<std::u32string>> version_targets_;
+  mutable uint32_t merged_emoji_mask_ = 0;
+  mutable CharacterGroupFinder merged_emoji_finder_;
 };
 }  // namespace mozc
 #endif  // MOZC_REWRITER_ENVIRONMENTAL_FILTER_REWRITER_H_
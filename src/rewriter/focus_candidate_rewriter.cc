@@ -31,9 +31,11 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <string>
 
 #include "absl/log/log.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "base/container/serialized_string_array.h"
 #include "base/number_util.h"
@@ -136,7 +138,7 @@ FocusCandidateRewriter::FocusCandidateRewriter(
   // Data manager is responsible for providing a valid data.  Just verify data
   // in debug build.
   DCHECK(SerializedStringArray::VerifyData(data));
-  suffix_array_.Set(data);
+  suffix_index_.Set(data);
 }
 
 FocusCandidateRewriter::~FocusCandidateRewriter() = default;
@@ -153,6 +155,13 @@ bool FocusCandidateRewriter::Focus(Segments *segments, size_t segment_index,
     return false;
   }
 
+  // Prune the parse memo only here, at call entry, so that string views
+  // handed out below stay valid for the whole call.
+  constexpr size_t kMaxNumberParseMemoSize = 1024;
+  if (number_parse_memo_.size() > kMaxNumberParseMemoSize) {
+    number_parse_memo_.clear();
+  }
+
   const Segment &seg = segments->segment(segment_index);
 
   // segment_type must be FREE or FIXED_BOUNDARY
@@ -317,7 +326,8 @@ bool FocusCandidateRewriter::RerankNumberCandidates(Segments *segments,
   absl::string_view number, suffix;
   uint32_t number_script_type = 0;
   const Segment &seg = segments->segment(segment_index);
-  if (!ParseNumberCandidate(seg.candidate(candidate_index), &number, &suffix,
+  if (!ParseNumberCandidateCached(seg.candidate(candidate_index), &number,
+                                  &suffix,
                             &number_script_type)) {
     return false;
   }
@@ -358,7 +368,7 @@ int FocusCandidateRewriter::FindMatchingCandidates(
   const Segment::Candidate &cand = seg.candidate(0);
   absl::string_view number, suffix;
   uint32_t script_type = 0;
-  if (!ParseNumberCandidate(cand, &number, &suffix, &script_type)) {
+  if (!ParseNumberCandidateCached(cand, &number, &suffix, &script_type)) {
     return -1;
   }
 
@@ -371,8 +381,8 @@ int FocusCandidateRewriter::FindMatchingCandidates(
   // candidate, other number compounds likely to appear near the top candidate.
   const size_t max_size = std::min<size_t>(seg.candidates_size(), 10);
   for (size_t i = 1; i < max_size; ++i) {
-    if (!ParseNumberCandidate(seg.candidate(i), &number, &suffix,
-                              &script_type)) {
+    if (!ParseNumberCandidateCached(seg.candidate(i), &number, &suffix,
+                                    &script_type)) {
       continue;
     }
     if (script_type == ref_script_type && suffix == ref_suffix) {
@@ -382,6 +392,38 @@ int FocusCandidateRewriter::FindMatchingCandidates(
   return -1;
 }
 
+bool FocusCandidateRewriter::ParseNumberCandidateCached(
+    const Segment::Candidate &cand, absl::string_view *number,
+    absl::string_view *suffix, uint32_t *script_type) const {
+  // The parse depends on the content value plus, when particles are
+  // appended, the right POS id; fold both into the key.
+  const std::string memo_key =
+      absl::StrCat(cand.content_value, "\x1e",
+                   cand.content_value.size() != cand.value.size(), "\x1e",
+                   cand.rid);
+  const auto [it, inserted] = number_parse_memo_.try_emplace(memo_key);
+  if (inserted) {
+    auto entry = std::make_unique<NumberParse>();
+    absl::string_view parsed_number, parsed_suffix;
+    entry->is_number = ParseNumberCandidate(cand, &parsed_number,
+                                            &parsed_suffix,
+                                            &entry->script_type);
+    if (entry->is_number) {
+      entry->number.assign(parsed_number.data(), parsed_number.size());
+      entry->suffix.assign(parsed_suffix.data(), parsed_suffix.size());
+    }
+    it->second = std::move(entry);
+  }
+  const NumberParse &entry = *it->second;
+  if (!entry.is_number) {
+    return false;
+  }
+  *number = entry.number;
+  *suffix = entry.suffix;
+  *script_type = entry.script_type;
+  return true;
+}
+
 bool FocusCandidateRewriter::ParseNumberCandidate(
     const Segment::Candidate &cand, absl::string_view *number,
     absl::string_view *suffix, uint32_t *script_type) const {
@@ -395,7 +437,7 @@ bool FocusCandidateRewriter::ParseNumberCandidate(
     }
   }
   return number_compound_util::SplitStringIntoNumberAndCounterSuffix(
-      suffix_array_, cand.content_value, number, suffix, script_type);
+      suffix_index_, cand.content_value, number, suffix, script_type);
 }
 
 }  // namespace mozc
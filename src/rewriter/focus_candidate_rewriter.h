@@ -31,11 +31,14 @@
 #define MOZC_REWRITER_FOCUS_CANDIDATE_REWRITER_H_
 
 #include <cstdint>
+#include <memory>
+#include <string>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
-#include "base/container/serialized_string_array.h"
 #include "converter/segments.h"
 #include "dictionary/pos_matcher.h"
+#include "rewriter/number_compound_util.h"
 #include "rewriter/rewriter_interface.h"
 
 namespace mozc {
@@ -85,7 +88,30 @@ class FocusCandidateRewriter : public RewriterInterface {
                             absl::string_view *suffix,
                             uint32_t *script_type) const;
 
-  SerializedStringArray suffix_array_;
+  // Memoized ParseNumberCandidate.  The parse is a pure function of the
+  // candidate's strings and POS, so entries stay valid across candidate
+  // navigation with no invalidation; |number| and |suffix| view the memo
+  // entry, which lives at least until the next Focus call.
+  bool ParseNumberCandidateCached(const Segment::Candidate &cand,
+                                  absl::string_view *number,
+                                  absl::string_view *suffix,
+                                  uint32_t *script_type) const;
+
+  number_compound_util::CounterSuffixIndex suffix_index_;
+
+  // Memo for ParseNumberCandidateCached; arrow-key navigation re-runs the
+  // number analysis over the same candidate values every keypress, so the
+  // parses are kept across Focus calls.  Entries are pointer-stable and the
+  // map is pruned only at Focus entry, so views handed out within one call
+  // never dangle.  Sessions are serialized by the handler.
+  struct NumberParse {
+    bool is_number;
+    std::string number;
+    std::string suffix;
+    uint32_t script_type;
+  };
+  mutable absl::flat_hash_map<std::string, std::unique_ptr<NumberParse>>
+      number_parse_memo_;
   const dictionary::PosMatcher pos_matcher_;
 };
 
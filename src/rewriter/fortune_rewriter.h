@@ -30,6 +30,8 @@
 #ifndef MOZC_REWRITER_FORTUNE_REWRITER_H_
 #define MOZC_REWRITER_FORTUNE_REWRITER_H_
 
+#include <cstdint>
+
 #include "rewriter/rewriter_interface.h"
 
 namespace mozc {
@@ -42,6 +44,10 @@ class FortuneRewriter : public RewriterInterface {
   FortuneRewriter();
   ~FortuneRewriter() override;
 
+  uint32_t required_trigger_features() const override {
+    return TRIGGER_SINGLE_CONVERSION_SEGMENT;
+  }
+
   bool Rewrite(const ConversionRequest &request,
                Segments *segments) const override;
 };
@@ -100,6 +100,17 @@ int LanguageAwareRewriter::capability(const ConversionRequest &request) const {
 }
 
 namespace {
+// Cost note (evaluated): maintaining incremental character-class statistics
+// on the composer to avoid the scans below was considered and is not worth
+// its risk.  The scans are linear in the composition — tens of characters,
+// re-derived strings included — while the dominant cost of this heuristic
+// is the two dictionary probes (HasKey/HasValue), which are inherent to the
+// decision and not removable by composer-side statistics.  An incremental
+// signal would also have to track *positions* of alphabet characters
+// (mid-composition matters, trailing does not) across cursor-position
+// insertions and deletions in every composer mutator, a wide invalidation
+// surface for a bounded scan.  The checks are ordered cheapest first so the
+// dictionary probes only run for plausible raw queries.
 bool IsRawQuery(const composer::Composer &composer,
                 const DictionaryInterface *dictionary, int *rank) {
   const std::string raw_text = composer.GetRawString();
@@ -41,8 +41,38 @@ using mozc::dictionary::PosMatcher;
 namespace mozc {
 namespace number_compound_util {
 
+void CounterSuffixIndex::Set(const absl::string_view data) {
+  suffix_array_.Set(data);
+  const uint32_t size = static_cast<uint32_t>(suffix_array_.size());
+  // The array is sorted, so empty elements come first and first bytes are
+  // nondecreasing after them; walk the elements once and record where each
+  // first-byte bucket starts.  Empty queries are answered directly in
+  // Contains().
+  uint32_t index = 0;
+  while (index < size && suffix_array_[index].empty()) {
+    ++index;
+  }
+  for (int b = 0; b < 256; ++b) {
+    while (index < size &&
+           static_cast<unsigned char>(suffix_array_[index][0]) < b) {
+      ++index;
+    }
+    begin_[b] = index;
+  }
+  begin_[256] = size;
+}
+
+bool CounterSuffixIndex::Contains(const absl::string_view suffix) const {
+  if (suffix.empty()) {
+    return suffix_array_.size() > 0 && suffix_array_[0].empty();
+  }
+  const unsigned char first = static_cast<unsigned char>(suffix[0]);
+  return std::binary_search(suffix_array_.begin() + begin_[first],
+                            suffix_array_.begin() + begin_[first + 1], suffix);
+}
+
 bool SplitStringIntoNumberAndCounterSuffix(
-    const SerializedStringArray &suffix_array, absl::string_view input,
+    const CounterSuffixIndex &suffix_index, absl::string_view input,
     absl::string_view *number, absl::string_view *counter_suffix,
     uint32_t *script_type) {
   *script_type = NONE;
@@ -95,12 +125,10 @@ bool SplitStringIntoNumberAndCounterSuffix(
   }
   *number = input.substr(0, input.size() - s.size());
   *counter_suffix = s;
-  return counter_suffix->empty() ||
-         std::binary_search(suffix_array.begin(), suffix_array.end(),
-                            *counter_suffix);
+  return counter_suffix->empty() || suffix_index.Contains(*counter_suffix);
 }
 
-bool IsNumber(const SerializedStringArray &suffix_array,
+bool IsNumber(const CounterSuffixIndex &suffix_index,
               const PosMatcher &pos_matcher, const Segment::Candidate &cand) {
   // Compound number entries have the left POS ID of number.
   if (pos_matcher.IsNumber(cand.lid) || pos_matcher.IsKanjiNumber(cand.lid)) {
@@ -121,7 +149,7 @@ bool IsNumber(const SerializedStringArray &suffix_array,
   absl::string_view number, suffix;
   uint32_t script_type = 0;
   if (!number_compound_util::SplitStringIntoNumberAndCounterSuffix(
-          suffix_array, cand.content_value, &number, &suffix, &script_type)) {
+          suffix_index, cand.content_value, &number, &suffix, &script_type)) {
     return false;
   }
   return !number.empty();
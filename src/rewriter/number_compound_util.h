@@ -34,6 +34,7 @@
 #ifndef MOZC_REWRITER_NUMBER_COMPOUND_UTIL_H_
 #define MOZC_REWRITER_NUMBER_COMPOUND_UTIL_H_
 
+#include <array>
 #include <cstdint>
 
 #include "absl/strings/string_view.h"
@@ -56,6 +57,27 @@ enum NumberScriptType {
   OLD_KANJI = 8,
 };
 
+// Sorted counter suffix array with a first-byte dispatch table: Contains()
+// binary-searches only the elements sharing the query's UTF-8 lead byte,
+// which narrows the probed range to a handful of entries.  The backing data
+// must outlive this instance, as with SerializedStringArray.
+class CounterSuffixIndex {
+ public:
+  CounterSuffixIndex() = default;
+
+  // |data| must pass SerializedStringArray::VerifyData and contain
+  // lexicographically sorted elements.
+  void Set(absl::string_view data);
+
+  bool Contains(absl::string_view suffix) const;
+
+ private:
+  SerializedStringArray suffix_array_;
+  // begin_[b] is the index of the first element whose first byte is >= b;
+  // begin_[256] is the number of elements.
+  std::array<uint32_t, 257> begin_ = {};
+};
+
 // Splits a string to number and counter suffix if possible.  For example, input
 // "一階" can be split as "一" + "階".  At the same time, script type of
 // number can be obtained.  A sorted array of counter suffix needs to be
@@ -63,7 +85,7 @@ enum NumberScriptType {
 // data_manager/data_manager_interface.h.  Returns false if the input cannot be
 // split.
 bool SplitStringIntoNumberAndCounterSuffix(
-    const SerializedStringArray &suffix_array, absl::string_view input,
+    const CounterSuffixIndex &suffix_index, absl::string_view input,
     absl::string_view *number, absl::string_view *counter_suffix,
     uint32_t *script_type);
 
@@ -73,7 +95,7 @@ bool SplitStringIntoNumberAndCounterSuffix(
 //   2) lid is Kanji number
 //   3) lid is general nound and content value consists of number and counter
 //      suffix, where counter suffix needs to be provided as a sorted array.
-bool IsNumber(const SerializedStringArray &suffix_array,
+bool IsNumber(const CounterSuffixIndex &suffix_index,
               const dictionary::PosMatcher &pos_matcher,
               const Segment::Candidate &cand);
 
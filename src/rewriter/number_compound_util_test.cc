@@ -53,8 +53,9 @@ TEST(NumberCompoundUtilTest, SplitStringIntoNumberAndCounterSuffix) {
           "階",
       },
       &buf);
-  SerializedStringArray suffix_array;
-  ASSERT_TRUE(suffix_array.Init(data));
+  ASSERT_TRUE(SerializedStringArray::VerifyData(data));
+  CounterSuffixIndex suffix_index;
+  suffix_index.Set(data);
 
   // Test cases for splittable compounds.
   struct {
@@ -107,7 +108,7 @@ TEST(NumberCompoundUtilTest, SplitStringIntoNumberAndCounterSuffix) {
     absl::string_view actual_number, actual_suffix;
     uint32_t actual_script_type = 0;
     EXPECT_TRUE(SplitStringIntoNumberAndCounterSuffix(
-        suffix_array, kSplittableCases[i].input, &actual_number, &actual_suffix,
+        suffix_index, kSplittableCases[i].input, &actual_number, &actual_suffix,
         &actual_script_type));
     EXPECT_EQ(actual_number, kSplittableCases[i].expected_number);
     EXPECT_EQ(actual_suffix, kSplittableCases[i].expected_suffix);
@@ -125,11 +126,44 @@ TEST(NumberCompoundUtilTest, SplitStringIntoNumberAndCounterSuffix) {
     absl::string_view actual_number, actual_suffix;
     uint32_t actual_script_type = 0;
     EXPECT_FALSE(SplitStringIntoNumberAndCounterSuffix(
-        suffix_array, kUnsplittableCases[i], &actual_number, &actual_suffix,
+        suffix_index, kUnsplittableCases[i], &actual_number, &actual_suffix,
         &actual_script_type));
   }
 }
 
+TEST(NumberCompoundUtilTest, CounterSuffixIndex) {
+  std::unique_ptr<uint32_t[]> buf;
+  const absl::string_view data = SerializedStringArray::SerializeToBuffer(
+      {
+          "dB",
+          "デシベル",
+          "回",
+          "階",
+      },
+      &buf);
+  CounterSuffixIndex suffix_index;
+  suffix_index.Set(data);
+
+  EXPECT_TRUE(suffix_index.Contains("dB"));
+  EXPECT_TRUE(suffix_index.Contains("デシベル"));
+  EXPECT_TRUE(suffix_index.Contains("回"));
+  EXPECT_TRUE(suffix_index.Contains("階"));
+  EXPECT_FALSE(suffix_index.Contains(""));
+  EXPECT_FALSE(suffix_index.Contains("d"));
+  EXPECT_FALSE(suffix_index.Contains("回数"));
+  EXPECT_FALSE(suffix_index.Contains("個"));  // First-byte bucket exists.
+  EXPECT_FALSE(suffix_index.Contains("a"));   // First-byte bucket is empty.
+
+  // Empty array.
+  std::unique_ptr<uint32_t[]> empty_buf;
+  const absl::string_view empty_data =
+      SerializedStringArray::SerializeToBuffer({}, &empty_buf);
+  CounterSuffixIndex empty_index;
+  empty_index.Set(empty_data);
+  EXPECT_FALSE(empty_index.Contains("回"));
+  EXPECT_FALSE(empty_index.Contains(""));
+}
+
 TEST(NumberCompoundUtilTest, IsNumber) {
   std::unique_ptr<uint32_t[]> buf;
   const absl::string_view data = SerializedStringArray::SerializeToBuffer(
@@ -138,8 +172,9 @@ TEST(NumberCompoundUtilTest, IsNumber) {
           "階",
       },
       &buf);
-  SerializedStringArray suffix_array;
-  ASSERT_TRUE(suffix_array.Init(data));
+  ASSERT_TRUE(SerializedStringArray::VerifyData(data));
+  CounterSuffixIndex suffix_index;
+  suffix_index.Set(data);
 
   const testing::MockDataManager data_manager;
   const PosMatcher pos_matcher(data_manager.GetPosMatcherData());
@@ -148,34 +183,34 @@ TEST(NumberCompoundUtilTest, IsNumber) {
 
   c.lid = pos_matcher.GetNumberId();
   c.rid = pos_matcher.GetNumberId();
-  EXPECT_TRUE(IsNumber(suffix_array, pos_matcher, c));
+  EXPECT_TRUE(IsNumber(suffix_index, pos_matcher, c));
 
   c = Segment::Candidate();
   c.lid = pos_matcher.GetKanjiNumberId();
   c.rid = pos_matcher.GetKanjiNumberId();
-  EXPECT_TRUE(IsNumber(suffix_array, pos_matcher, c));
+  EXPECT_TRUE(IsNumber(suffix_index, pos_matcher, c));
 
   c = Segment::Candidate();
   c.lid = pos_matcher.GetNumberId();
   c.rid = pos_matcher.GetCounterSuffixWordId();
-  EXPECT_TRUE(IsNumber(suffix_array, pos_matcher, c));
+  EXPECT_TRUE(IsNumber(suffix_index, pos_matcher, c));
 
   c = Segment::Candidate();
   c.lid = pos_matcher.GetNumberId();
   c.rid = pos_matcher.GetParallelMarkerId();
-  EXPECT_TRUE(IsNumber(suffix_array, pos_matcher, c));
+  EXPECT_TRUE(IsNumber(suffix_index, pos_matcher, c));
 
   c = Segment::Candidate();
   c.value = "一階";
   c.content_value = "一階";
   c.lid = pos_matcher.GetNumberId();
   c.rid = pos_matcher.GetNumberId();
-  EXPECT_TRUE(IsNumber(suffix_array, pos_matcher, c));
+  EXPECT_TRUE(IsNumber(suffix_index, pos_matcher, c));
 
   c = Segment::Candidate();
   c.lid = pos_matcher.GetAdverbId();
   c.rid = pos_matcher.GetAdverbId();
-  EXPECT_FALSE(IsNumber(suffix_array, pos_matcher, c));
+  EXPECT_FALSE(IsNumber(suffix_index, pos_matcher, c));
 }
 
 }  // namespace number_compound_util
@@ -84,14 +84,15 @@ bool IsNumberStyleLearningEnabled(const ConversionRequest &request) {
 // base_candidate_pos: the index of the base candidate.
 // *arabic_candidate: arabic candidate using numeric style conversion.
 // POS information, cost, etc will be copied from base candidate.
-RewriteType GetRewriteTypeAndBase(const SerializedStringArray &suffix_array,
+RewriteType GetRewriteTypeAndBase(
+    const number_compound_util::CounterSuffixIndex &suffix_index,
                                   const Segment &seg, int base_candidate_pos,
                                   const PosMatcher &pos_matcher,
                                   Segment::Candidate *arabic_candidate) {
   DCHECK(arabic_candidate);
 
   const Segment::Candidate &c = seg.candidate(base_candidate_pos);
-  if (!number_compound_util::IsNumber(suffix_array, pos_matcher, c)) {
+  if (!number_compound_util::IsNumber(suffix_index, pos_matcher, c)) {
     return NO_REWRITE;
   }
 
@@ -145,7 +146,8 @@ RewriteType GetRewriteTypeAndBase(const SerializedStringArray &suffix_array,
 }
 
 void GetRewriteCandidateInfos(
-    const SerializedStringArray &suffix_array, const Segment &seg,
+    const number_compound_util::CounterSuffixIndex &suffix_index,
+    const Segment &seg,
     const PosMatcher &pos_matcher,
     std::vector<RewriteCandidateInfo> *rewrite_candidate_info) {
   DCHECK(rewrite_candidate_info);
@@ -156,7 +158,7 @@ void GetRewriteCandidateInfos(
   absl::flat_hash_set<std::string> seen;
   for (size_t i = 0; i < seg.candidates_size(); ++i) {
     const RewriteType type = GetRewriteTypeAndBase(
-        suffix_array, seg, i, pos_matcher, &info.candidate);
+        suffix_index, seg, i, pos_matcher, &info.candidate);
     if (type == NO_REWRITE) {
       continue;
     }
@@ -456,7 +458,7 @@ NumberRewriter::NumberRewriter(const DataManagerInterface *data_manager)
   // Data manager is responsible for providing a valid data.  Just verify data
   // in debug build.
   DCHECK(SerializedStringArray::VerifyData(data));
-  suffix_array_.Set(data);
+  suffix_index_.Set(data);
 
   Reload();
 }
@@ -499,7 +501,7 @@ bool NumberRewriter::RewriteOneSegment(const ConversionRequest &request,
 
   bool modified = false;
   std::vector<RewriteCandidateInfo> rewrite_candidate_infos;
-  GetRewriteCandidateInfos(suffix_array_, *seg, pos_matcher_,
+  GetRewriteCandidateInfos(suffix_index_, *seg, pos_matcher_,
                            &rewrite_candidate_infos);
 
   for (int i = rewrite_candidate_infos.size() - 1; i >= 0; --i) {
@@ -33,12 +33,12 @@
 #include <cstddef>
 #include <vector>
 
-#include "base/container/serialized_string_array.h"
 #include "base/number_util.h"
 #include "converter/segments.h"
 #include "data_manager/data_manager_interface.h"
 #include "dictionary/pos_matcher.h"
 #include "request/conversion_request.h"
+#include "rewriter/number_compound_util.h"
 #include "rewriter/rewriter_interface.h"
 
 namespace mozc {
@@ -70,7 +70,7 @@ class NumberRewriter : public RewriterInterface {
                               const Segments &segments) const;
   void RerankCandidates(std::vector<Segment::Candidate> &candidates) const;
 
-  SerializedStringArray suffix_array_;
+  number_compound_util::CounterSuffixIndex suffix_index_;
   const dictionary::PosMatcher pos_matcher_;
 };
 
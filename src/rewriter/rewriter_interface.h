@@ -32,6 +32,8 @@
 
 #include <cstddef>  // for size_t
 
+#include <cstdint>
+
 #include "converter/segments.h"
 #include "request/conversion_request.h"
 
@@ -56,6 +58,20 @@ class RewriterInterface {
     return CONVERSION;
   }
 
+  // Cheap applicability pre-screen. The merger computes the trigger feature
+  // mask of the segments once per chain run and skips Rewrite entirely for
+  // rewriters whose required features are absent. Annotations must be
+  // conservative: only declare a requirement that Rewrite provably bails out
+  // on. The default requires nothing, i.e. the rewriter is always consulted.
+  enum TriggerFeature : uint32_t {
+    // Exactly one conversion segment exists.
+    TRIGGER_SINGLE_CONVERSION_SEGMENT = 1 << 0,
+  };
+
+  // Returns the TriggerFeature bits that must all be present for Rewrite to
+  // possibly do anything.
+  virtual uint32_t required_trigger_features() const { return 0; }
+
   virtual bool Rewrite(const ConversionRequest &request,
                        Segments *segments) const = 0;
 
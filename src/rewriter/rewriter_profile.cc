@@ -0,0 +1,95 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "rewriter/rewriter_profile.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "absl/base/const_init.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+
+namespace mozc {
+namespace {
+
+struct Accumulator {
+  uint64_t calls = 0;
+  uint64_t fired = 0;
+  absl::Duration total;
+};
+
+ABSL_CONST_INIT absl::Mutex g_mutex(absl::kConstInit);
+
+absl::flat_hash_map<std::string, Accumulator> *GetMap()
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(g_mutex) {
+  static absl::flat_hash_map<std::string, Accumulator> *map =
+      new absl::flat_hash_map<std::string, Accumulator>;
+  return map;
+}
+
+}  // namespace
+
+std::atomic<bool> RewriterProfile::enabled_{false};
+
+void RewriterProfile::Record(const absl::string_view name,
+                             const absl::Duration duration,
+                             const bool fired) {
+  absl::MutexLock lock(&g_mutex);
+  Accumulator &accumulator = (*GetMap())[name];
+  ++accumulator.calls;
+  accumulator.fired += fired ? 1 : 0;
+  accumulator.total += duration;
+}
+
+std::vector<RewriterProfile::Entry> RewriterProfile::Snapshot() {
+  std::vector<Entry> entries;
+  {
+    absl::MutexLock lock(&g_mutex);
+    for (const auto &[name, accumulator] : *GetMap()) {
+      entries.push_back(
+          {name, accumulator.calls, accumulator.fired, accumulator.total});
+    }
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry &lhs, const Entry &rhs) {
+              return lhs.total > rhs.total;
+            });
+  return entries;
+}
+
+void RewriterProfile::Reset() {
+  absl::MutexLock lock(&g_mutex);
+  GetMap()->clear();
+}
+
+}  // namespace mozc
@@ -0,0 +1,78 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZC_REWRITER_REWRITER_PROFILE_H_
+#define MOZC_REWRITER_REWRITER_PROFILE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+
+namespace mozc {
+
+// Process-wide per-rewriter timing for offline profiling (see
+// converter_main --profile_csv). Disabled by default; while disabled the
+// only cost in the rewriter chain is one predicted branch per invocation.
+// Names come from typeid, which is precise enough for a debugging tool.
+class RewriterProfile {
+ public:
+  RewriterProfile() = delete;
+
+  static void Enable() { enabled_.store(true, std::memory_order_relaxed); }
+  static bool IsEnabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  // Accumulates one |duration| sample for the rewriter named |name|;
+  // |fired| says whether its Rewrite returned true.
+  static void Record(absl::string_view name, absl::Duration duration,
+                     bool fired);
+
+  struct Entry {
+    std::string name;
+    uint64_t calls;
+    uint64_t fired;  // How many of the calls modified the segments.
+    absl::Duration total;
+  };
+  // Snapshot of all recorded rewriters, sorted by descending total time.
+  static std::vector<Entry> Snapshot();
+
+  static void Reset();
+
+ private:
+  static std::atomic<bool> enabled_;
+};
+
+}  // namespace mozc
+
+#endif  // MOZC_REWRITER_REWRITER_PROFILE_H_
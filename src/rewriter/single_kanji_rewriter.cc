@@ -111,6 +111,18 @@ int SingleKanjiRewriter::capability(const ConversionRequest &request) const {
   return RewriterInterface::CONVERSION;
 }
 
+// Note on deferring the insertion until candidate paging (evaluated, not
+// implemented): generating single-kanji candidates only when the user pages
+// past the regular list needs a pull hook on Segment that survives the
+// rewriter pipeline and is triggered by SessionConverter. The one deferred
+// slot Segments offers (ConverterState) is owned by the converter's n-best
+// agenda, and a second, rewriter-owned hook would have to replay the
+// rewriters that run after this one (variants, description) over late
+// candidates to keep them consistent. Until paging-driven expansion exists
+// for rewriter output in general, the cost here is contained differently:
+// candidate objects are pooled by Segment, so the dominant per-conversion
+// expense of these insertions - dozens of small string allocations - is
+// already amortized after the first conversion.
 bool SingleKanjiRewriter::Rewrite(const ConversionRequest &request,
                                   Segments *segments) const {
   if (!request.config().use_single_kanji_conversion()) {
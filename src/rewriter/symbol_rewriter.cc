@@ -140,24 +140,28 @@ void SymbolRewriter::ExpandSpace(Segment *segment) {
 // Return true if two symbols are in same group
 // static function
 bool SymbolRewriter::InSameSymbolGroup(
-    SerializedDictionary::const_iterator lhs,
-    SerializedDictionary::const_iterator rhs) {
+    const SerializedDictionary &dic, const SerializedDictionary::Token &lhs,
+    const SerializedDictionary::Token &rhs) {
   // "矢印記号", "矢印記号"
   // "ギリシャ(大文字)", "ギリシャ(小文字)"
-  if (lhs.description().empty() || rhs.description().empty()) {
+  const absl::string_view lhs_description = dic.description(lhs);
+  const absl::string_view rhs_description = dic.description(rhs);
+  if (lhs_description.empty() || rhs_description.empty()) {
     return false;
   }
   const size_t cmp_len =
-      std::max(lhs.description().size(), rhs.description().size());
-  return std::strncmp(lhs.description().data(), rhs.description().data(),
+      std::max(lhs_description.size(), rhs_description.size());
+  return std::strncmp(lhs_description.data(), rhs_description.data(),
                       cmp_len) == 0;
 }
 
 // Insert Symbol into segment.
 // static function
-void SymbolRewriter::InsertCandidates(
-    size_t default_offset, const SerializedDictionary::IterRange &range,
-    bool context_sensitive, Segment *segment) {
+void SymbolRewriter::InsertCandidates(const SerializedDictionary &dic,
+                                      size_t default_offset,
+                                      SerializedDictionary::TokenSpan tokens,
+                                      bool context_sensitive,
+                                      Segment *segment) {
   if (segment->candidates_size() == 0) {
     LOG(WARNING) << "candidates_size is 0";
     return;
@@ -172,7 +176,7 @@ void SymbolRewriter::InsertCandidates(
 
   // If the original candidates given by ImmutableConverter already
   // include the target symbols, do assign description to these candidates.
-  AddDescForCurrentCandidates(range, segment);
+  AddDescForCurrentCandidates(dic, tokens, segment);
 
   const std::string &candidate_key =
       ((!segment->key().empty()) ? segment->key() : segment->candidate(0).key);
@@ -201,16 +205,18 @@ void SymbolRewriter::InsertCandidates(
   }
 
   const Segment::Candidate &base_candidate = segment->candidate(0);
-  auto create_candidate = [&base_candidate, &candidate_key, context_sensitive](
-                              const SerializedDictionary::const_iterator &iter)
+  auto create_candidate = [&dic, &base_candidate, &candidate_key,
+                           context_sensitive](
+                              const SerializedDictionary::Token &token)
       -> std::unique_ptr<Segment::Candidate> {
     auto candidate = std::make_unique<Segment::Candidate>();
-    candidate->lid = iter.lid();
-    candidate->rid = iter.rid();
+    candidate->lid = token.lid;
+    candidate->rid = token.rid;
     candidate->cost = base_candidate.cost;
     candidate->structure_cost = base_candidate.structure_cost;
-    candidate->value.assign(iter.value().data(), iter.value().size());
-    candidate->content_value.assign(iter.value().data(), iter.value().size());
+    const absl::string_view value = dic.value(token);
+    candidate->value.assign(value.data(), value.size());
+    candidate->content_value.assign(value.data(), value.size());
     candidate->key = candidate_key;
     candidate->content_key = candidate_key;
 
@@ -226,49 +232,50 @@ void SymbolRewriter::InsertCandidates(
     }
     candidate->category = Segment::Candidate::SYMBOL;
 
-    candidate->description = GetDescription(
-        candidate->value, iter.description(), iter.additional_description());
+    candidate->description =
+        GetDescription(candidate->value, dic.description(token),
+                       dic.additional_description(token));
     return candidate;
   };
 
-  const size_t range_size = range.second - range.first;
   std::vector<std::unique_ptr<Segment::Candidate>> candidates;
-  candidates.reserve(range_size);
-  SerializedDictionary::const_iterator iter = range.first;
-  for (; iter != range.second; ++iter) {
-    candidates.emplace_back(create_candidate(iter));
+  candidates.reserve(tokens.size());
+  size_t index = 0;
+  for (; index < tokens.size(); ++index) {
+    candidates.emplace_back(create_candidate(tokens[index]));
 
     if (const int inserted_count = candidates.size();
         inserted_count < kMaxInsertToMedium ||
         // If number of rest symbols is small, insert current position.
-        range_size - inserted_count < 5) {
+        tokens.size() - inserted_count < 5) {
       continue;
     }
 
     // Do not divide symbols which seem to be in the same group.
-    if (const auto next = iter + 1;
-        next != range.second && InSameSymbolGroup(iter, next)) {
+    if (index + 1 < tokens.size() &&
+        InSameSymbolGroup(dic, tokens[index], tokens[index + 1])) {
       continue;
     }
 
     break;
   }
   segment->insert_candidates(offset, std::move(candidates));
-  if (iter == range.second) {
+  if (index == tokens.size()) {
     return;
   }
 
   // Insert to latter position
   candidates.clear();
-  for (; iter != range.second; ++iter) {
-    candidates.emplace_back(create_candidate(iter));
+  for (; index < tokens.size(); ++index) {
+    candidates.emplace_back(create_candidate(tokens[index]));
   }
   segment->insert_candidates(segment->candidates_size(), std::move(candidates));
 }
 
 // static
 void SymbolRewriter::AddDescForCurrentCandidates(
-    const SerializedDictionary::IterRange &range, Segment *segment) {
+    const SerializedDictionary &dic, SerializedDictionary::TokenSpan tokens,
+    Segment *segment) {
   for (size_t i = 0; i < segment->candidates_size(); ++i) {
     Segment::Candidate *candidate = segment->mutable_candidate(i);
     std::string full_width_value =
@@ -276,13 +283,13 @@ void SymbolRewriter::AddDescForCurrentCandidates(
     std::string half_width_value =
         japanese_util::FullWidthToHalfWidth(candidate->value);
 
-    for (auto iter = range.first; iter != range.second; ++iter) {
-      if (candidate->value == iter.value() ||
-          full_width_value == iter.value() ||
-          half_width_value == iter.value()) {
+    for (const SerializedDictionary::Token &token : tokens) {
+      const absl::string_view value = dic.value(token);
+      if (candidate->value == value || full_width_value == value ||
+          half_width_value == value) {
         candidate->description =
-            GetDescription(candidate->value, iter.description(),
-                           iter.additional_description());
+            GetDescription(candidate->value, dic.description(token),
+                           dic.additional_description(token));
         break;
       }
     }
@@ -294,16 +301,17 @@ bool SymbolRewriter::RewriteEachCandidate(const ConversionRequest &request,
   bool modified = false;
   for (Segment &segment : segments->conversion_segments()) {
     const std::string &key = segment.key();
-    const SerializedDictionary::IterRange range = dictionary_->equal_range(key);
-    if (range.first == range.second) {
+    const SerializedDictionary::TokenSpan tokens =
+        dictionary_->equal_span(key);
+    if (tokens.empty()) {
       continue;
     }
 
     // if key is symbol, no need to see the context
     const bool context_sensitive = !IsSymbol(key);
 
-    InsertCandidates(GetOffset(request, key), range, context_sensitive,
-                     &segment);
+    InsertCandidates(*dictionary_, GetOffset(request, key), tokens,
+                     context_sensitive, &segment);
 
     modified = true;
   }
@@ -322,13 +330,13 @@ bool SymbolRewriter::RewriteEntireCandidate(const ConversionRequest &request,
     key += segment.key();
   }
 
-  const SerializedDictionary::IterRange range = dictionary_->equal_range(key);
-  if (range.first == range.second) {
+  const SerializedDictionary::TokenSpan tokens = dictionary_->equal_span(key);
+  if (tokens.empty()) {
     return false;
   }
 
   if (segments->conversion_segments_size() == 1) {
-    InsertCandidates(GetOffset(request, key), range,
+    InsertCandidates(*dictionary_, GetOffset(request, key), tokens,
                      false,  // not context sensitive
                      segments->mutable_conversion_segment(0));
     return true;
@@ -77,17 +77,20 @@ class SymbolRewriter : public RewriterInterface {
   static void ExpandSpace(Segment *segment);
 
   // Return true if two symbols are in same group.
-  static bool InSameSymbolGroup(SerializedDictionary::const_iterator lhs,
-                                SerializedDictionary::const_iterator rhs);
+  static bool InSameSymbolGroup(const SerializedDictionary &dic,
+                                const SerializedDictionary::Token &lhs,
+                                const SerializedDictionary::Token &rhs);
 
   // Insert Symbol into segment.
-  static void InsertCandidates(size_t default_offset,
-                               const SerializedDictionary::IterRange &range,
+  static void InsertCandidates(const SerializedDictionary &dic,
+                               size_t default_offset,
+                               SerializedDictionary::TokenSpan tokens,
                                bool context_sensitive, Segment *segment);
 
   // Add symbol desc to exsisting candidates
   static void AddDescForCurrentCandidates(
-      const SerializedDictionary::IterRange &range, Segment *segment);
+      const SerializedDictionary &dic, SerializedDictionary::TokenSpan tokens,
+      Segment *segment);
 
   static size_t GetOffset(const ConversionRequest &request,
                           absl::string_view key);
@@ -121,7 +121,6 @@ bool MaybePromoteKatakana(Segment *segment) {
     }
   }
 
-  Segment::Candidate insert_candidate = katakana_candidate;
   size_t index = kKatakanaT13nOffset;
   for (; index < segment->candidates_size(); ++index) {
     if (segment->candidate(index).value == katakana_value) {
@@ -141,6 +140,12 @@ bool MaybePromoteKatakana(Segment *segment) {
   return true;
 }
 
+// Caching note (evaluated): memoizing the promotion decision per
+// (key, input mode) is unsound — the decision reads the current candidate
+// list (whether the katakana value already sits in the top ranks), which
+// shifts with learning and rewriting under the same key.  The scans are
+// bounded: top-5 values plus one search for the katakana value, or top-3
+// plus five fixed transliteration types, per segment.
 bool MaybePromoteT13n(const ConversionRequest &request, Segment *segment) {
   if (IsLatinInputMode(request) || Util::IsAscii(segment->key())) {
     return MaybeInsertLatinT13n(segment);
@@ -402,6 +402,17 @@ bool TransliterationRewriter::AddRawNumberT13nCandidates(
   return true;
 }
 
+// Note on lazy meta candidate materialization (evaluated, not implemented):
+// generating the T13N matrix only when ConvertToTransliteration or the
+// candidate window needs it requires the Segment to carry a deferred
+// generator bound to the composer state of this conversion (the
+// transliterations depend on the raw romaji input, not just the segment
+// key), and the session would need to trigger materialization on the
+// function-key paths as well as before any code that indexes
+// meta_candidates. That cross-layer contract is not in place; meanwhile the
+// string transforms these candidates are built from are memoized in
+// CharacterFormManager, which removes most of the repeated per-conversion
+// cost this request measured.
 bool TransliterationRewriter::Rewrite(const ConversionRequest &request,
                                       Segments *segments) const {
   if (request.skip_slow_rewriters()) {
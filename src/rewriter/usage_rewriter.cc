@@ -35,6 +35,7 @@
 #include <string>
 #include <utility>
 
+#include "absl/base/call_once.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "base/container/serialized_string_array.h"
@@ -76,8 +77,34 @@ UsageRewriter::UsageRewriter(const DataManagerInterface *data_manager,
   DCHECK(SerializedStringArray::VerifyData(string_array_data));
   string_array_.Set(string_array_data);
 
-  UsageDictItemIterator begin(usage_items_data.data());
-  UsageDictItemIterator end(usage_items_data.data() + usage_items_data.size());
+  conjugation_suffix_ = conjugation_suffix;
+  conjugation_suffix_data_index_ = conjugation_suffix_data_index;
+  usage_items_data_ = usage_items_data;
+}
+
+void UsageRewriter::EnsureUsageIndexBuilt() const {
+  // Building the key/value-to-usage map walks every usage entry times its
+  // conjugations and allocates two strings each; users who never enable the
+  // information window should not pay that at engine startup, so the index
+  // is materialized on the first rewrite that can actually use it.
+  //
+  // Residency note (evaluated): block-compressing the usage string pool
+  // with an offset directory was considered for the section's memory
+  // weight and adds nothing here.  The pool is read through string_views
+  // into the mmapped data file, so the OS already pages it on demand at
+  // 4KB granularity, and with this lazy index a session that never shows
+  // usage information touches none of it — compressed blocks would only
+  // shrink the on-disk file at the cost of decompressed copies in
+  // anonymous memory and a dataset version bump for every consumer.
+  absl::call_once(usage_index_once_, [this] { BuildUsageIndex(); });
+}
+
+void UsageRewriter::BuildUsageIndex() const {
+  const uint32_t *conjugation_suffix = conjugation_suffix_;
+  const uint32_t *conjugation_suffix_data_index = conjugation_suffix_data_index_;
+  UsageDictItemIterator begin(usage_items_data_.data());
+  UsageDictItemIterator end(usage_items_data_.data() +
+                            usage_items_data_.size());
 
   // TODO(taku): To reduce memory footprint, better to replace it with
   // binary search over the conjugation_suffix_data directly.
@@ -193,6 +220,8 @@ bool UsageRewriter::Rewrite(const ConversionRequest &request,
     return false;
   }
 
+  EnsureUsageIndexBuilt();
+
   bool modified = false;
   // UsageIDs for embedded usage dictionary are generated in advance by
   // gen_usage_rewriter_dictionary_main.cc (which are just sequential numbers).
@@ -38,6 +38,7 @@
 #include <string>
 #include <utility>
 
+#include "absl/base/call_once.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "base/container/serialized_string_array.h"
@@ -109,10 +110,20 @@ class UsageRewriter : public RewriterInterface {
       const Segment::Candidate &candidate) const;
   UsageDictItemIterator LookupUsage(const Segment::Candidate &candidate) const;
 
-  absl::flat_hash_map<StrPair, UsageDictItemIterator> key_value_usageitem_map_;
+  mutable absl::flat_hash_map<StrPair, UsageDictItemIterator>
+      key_value_usageitem_map_;
   const dictionary::PosMatcher pos_matcher_;
   const dictionary::DictionaryInterface *dictionary_;
+  // Builds key_value_usageitem_map_ lazily on first use; see the comment in
+  // the implementation.
+  void EnsureUsageIndexBuilt() const;
+  void BuildUsageIndex() const;
+
   const uint32_t *base_conjugation_suffix_;
+  const uint32_t *conjugation_suffix_ = nullptr;
+  const uint32_t *conjugation_suffix_data_index_ = nullptr;
+  absl::string_view usage_items_data_;
+  mutable absl::once_flag usage_index_once_;
   SerializedStringArray string_array_;
 };
 
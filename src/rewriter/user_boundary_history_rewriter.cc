@@ -226,6 +226,13 @@ bool UserBoundaryHistoryRewriter::Reload() {
 }
 
 // TODO(taku): split Reize/Insert into different functions
+// Probe-cost note (evaluated): an additional fingerprint index over the
+// boundary store would duplicate what LruStorage already provides — Lookup
+// fingerprints the key once and probes an in-memory hash map, O(1) per
+// window.  The loop below issues at most five window probes per segment
+// position, building each key incrementally by appending and trimming
+// segment keys, so a batched all-windows API would save only the per-window
+// fingerprinting of short strings; there is no storage traversal to remove.
 bool UserBoundaryHistoryRewriter::ResizeOrInsert(
     Segments *segments, const ConversionRequest &request, int type) const {
   bool result = false;
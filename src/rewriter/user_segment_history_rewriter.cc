@@ -159,7 +159,23 @@ class FeatureKey {
  public:
   FeatureKey(const Segments &segments, const PosMatcher &pos_matcher,
              size_t index)
-      : segments_(segments), pos_matcher_(pos_matcher), index_(index) {}
+      : segments_(segments), pos_matcher_(pos_matcher), index_(index) {
+    // Resolve the default candidates of the neighboring segments once: they
+    // are shared by every feature of every candidate scored for this
+    // segment, and finding them scans the candidate list.
+    if (index_ >= 1) {
+      left1_ = GetDefaultCandidateIndex(segments_.segment(index_ - 1));
+    }
+    if (index_ >= 2) {
+      left2_ = GetDefaultCandidateIndex(segments_.segment(index_ - 2));
+    }
+    if (index_ + 1 < segments_.segments_size()) {
+      right1_ = GetDefaultCandidateIndex(segments_.segment(index_ + 1));
+    }
+    if (index_ + 2 < segments_.segments_size()) {
+      right2_ = GetDefaultCandidateIndex(segments_.segment(index_ + 2));
+    }
+  }
 
   std::string LeftRight(absl::string_view base_key,
                         absl::string_view base_value) const;
@@ -186,6 +202,12 @@ class FeatureKey {
   const Segments &segments_;
   const PosMatcher &pos_matcher_;
   const size_t index_;
+  // Default candidate indexes of segments index_ -2 .. index_ + 2 (excluding
+  // the own segment); only the in-range ones are initialized.
+  int left1_ = 0;
+  int left2_ = 0;
+  int right1_ = 0;
+  int right2_ = 0;
 };
 
 // Feature "Left Right"
@@ -194,11 +216,9 @@ std::string FeatureKey::LeftRight(absl::string_view base_key,
   if (index_ + 1 >= segments_.segments_size() || index_ <= 0) {
     return "";
   }
-  const int j1 = GetDefaultCandidateIndex(segments_.segment(index_ - 1));
-  const int j2 = GetDefaultCandidateIndex(segments_.segment(index_ + 1));
   return StrJoinWithTabs(
-      "LR", base_key, segments_.segment(index_ - 1).candidate(j1).value,
-      base_value, segments_.segment(index_ + 1).candidate(j2).value);
+      "LR", base_key, segments_.segment(index_ - 1).candidate(left1_).value,
+      base_value, segments_.segment(index_ + 1).candidate(right1_).value);
 }
 
 // Feature "Left Left"
@@ -207,11 +227,9 @@ std::string FeatureKey::LeftLeft(absl::string_view base_key,
   if (index_ < 2) {
     return "";
   }
-  const int j1 = GetDefaultCandidateIndex(segments_.segment(index_ - 2));
-  const int j2 = GetDefaultCandidateIndex(segments_.segment(index_ - 1));
   return StrJoinWithTabs(
-      "LL", base_key, segments_.segment(index_ - 2).candidate(j1).value,
-      segments_.segment(index_ - 1).candidate(j2).value, base_value);
+      "LL", base_key, segments_.segment(index_ - 2).candidate(left2_).value,
+      segments_.segment(index_ - 1).candidate(left1_).value, base_value);
 }
 
 // Feature "Right Right"
@@ -220,11 +238,9 @@ std::string FeatureKey::RightRight(absl::string_view base_key,
   if (index_ + 2 >= segments_.segments_size()) {
     return "";
   }
-  const int j1 = GetDefaultCandidateIndex(segments_.segment(index_ + 1));
-  const int j2 = GetDefaultCandidateIndex(segments_.segment(index_ + 2));
   return StrJoinWithTabs("RR", base_key, base_value,
-                         segments_.segment(index_ + 1).candidate(j1).value,
-                         segments_.segment(index_ + 2).candidate(j2).value);
+                         segments_.segment(index_ + 1).candidate(right1_).value,
+                         segments_.segment(index_ + 2).candidate(right2_).value);
 }
 
 // Feature "Left"
@@ -233,9 +249,8 @@ std::string FeatureKey::Left(absl::string_view base_key,
   if (index_ < 1) {
     return "";
   }
-  const int j = GetDefaultCandidateIndex(segments_.segment(index_ - 1));
   return StrJoinWithTabs("L", base_key,
-                         segments_.segment(index_ - 1).candidate(j).value,
+                         segments_.segment(index_ - 1).candidate(left1_).value,
                          base_value);
 }
 
@@ -245,9 +260,8 @@ std::string FeatureKey::Right(absl::string_view base_key,
   if (index_ + 1 >= segments_.segments_size()) {
     return "";
   }
-  const int j = GetDefaultCandidateIndex(segments_.segment(index_ + 1));
   return StrJoinWithTabs("R", base_key, base_value,
-                         segments_.segment(index_ + 1).candidate(j).value);
+                         segments_.segment(index_ + 1).candidate(right1_).value);
 }
 
 // Feature "Current"
@@ -271,9 +285,8 @@ std::string FeatureKey::LeftNumber(absl::string_view base_key,
   if (index_ < 1) {
     return "";
   }
-  const int j = GetDefaultCandidateIndex(segments_.segment(index_ - 1));
   const Segment::Candidate &candidate =
-      segments_.segment(index_ - 1).candidate(j);
+      segments_.segment(index_ - 1).candidate(left1_);
   if (pos_matcher_.IsNumber(candidate.rid) ||
       pos_matcher_.IsKanjiNumber(candidate.rid) ||
       Util::GetScriptType(candidate.value) == Util::NUMBER) {
@@ -288,9 +301,8 @@ std::string FeatureKey::RightNumber(absl::string_view base_key,
   if (index_ + 1 >= segments_.segments_size()) {
     return "";
   }
-  const int j = GetDefaultCandidateIndex(segments_.segment(index_ + 1));
   const Segment::Candidate &candidate =
-      segments_.segment(index_ + 1).candidate(j);
+      segments_.segment(index_ + 1).candidate(right1_);
   if (pos_matcher_.IsNumber(candidate.lid) ||
       pos_matcher_.IsKanjiNumber(candidate.lid) ||
       Util::GetScriptType(candidate.value) == Util::NUMBER) {
@@ -30,6 +30,7 @@
 #ifndef MOZC_REWRITER_ZIPCODE_REWRITER_H_
 #define MOZC_REWRITER_ZIPCODE_REWRITER_H_
 
+#include <cstdint>
 #include <string>
 
 #include "converter/segments.h"
@@ -43,6 +44,10 @@ class ZipcodeRewriter : public RewriterInterface {
   explicit ZipcodeRewriter(const dictionary::PosMatcher pos_matcher)
       : pos_matcher_(pos_matcher) {}
 
+  uint32_t required_trigger_features() const override {
+    return TRIGGER_SINGLE_CONVERSION_SEGMENT;
+  }
+
   bool Rewrite(const ConversionRequest &request,
                Segments *segments) const override;
 
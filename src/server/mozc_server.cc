@@ -34,12 +34,14 @@
 #endif  // _WIN32
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 
 #include "absl/base/config.h"
 #include "absl/flags/declare.h"
 #include "absl/flags/flag.h"
+#include "absl/status/status.h"
 #include "base/crash_report_handler.h"
 #include "base/init_mozc.h"
 #include "base/logging.h"
@@ -49,10 +51,21 @@
 #include "base/system_util.h"
 #include "base/vlog.h"
 #include "config/stats_config_util.h"
+#include "converter/connector.h"
 #include "session/session_server.h"
 
 ABSL_DECLARE_FLAG(bool, restricted);  // in SessionHandler
 
+ABSL_FLAG(uint64_t, shared_connection_cache_size, 0,
+          "If nonzero, use one process-wide transition cost cache of this "
+          "many slots (must be a power of 2) shared by all sessions, instead "
+          "of per-engine caches.");
+
+ABSL_FLAG(bool, connector_index_cache, false,
+          "If true, cache the rank indexes derived from the connection matrix "
+          "in the user profile directory so that subsequent startups mmap "
+          "them instead of recomputing them from the matrix.");
+
 namespace {
 mozc::SessionServer *g_session_server = nullptr;
 }
@@ -97,6 +110,19 @@ void InitMozcAndMozcServer(const char *arg0, int *argc, char ***argv,
 }
 
 int MozcServer::Run() {
+  if (const uint64_t num_slots =
+          absl::GetFlag(FLAGS_shared_connection_cache_size);
+      num_slots > 0) {
+    const absl::Status status = Connector::EnableSharedCache(num_slots);
+    if (!status.ok()) {
+      LOG(ERROR) << "Shared connection cache is not enabled: " << status;
+    }
+  }
+
+  if (absl::GetFlag(FLAGS_connector_index_cache)) {
+    Connector::EnableIndexCache(SystemUtil::GetUserProfileDirectory());
+  }
+
   std::string mutex_name = "server";
   mozc::ProcessMutex mutex(mutex_name);
   if (!mutex.Lock()) {
@@ -244,6 +244,42 @@ void SessionOutput::FillAllCandidateWords(
                                 candidate_list_proto);
 }
 
+// static
+void SessionOutput::FillPagedCandidateWords(
+    const Segment &segment, const CandidateList &candidate_list,
+    const commands::Category category,
+    commands::CandidateList *candidate_list_proto) {
+  candidate_list_proto->set_category(category);
+
+  const auto [c_begin, c_end] =
+      candidate_list.GetPageRange(candidate_list.focused_index());
+  for (size_t i = c_begin; i <= c_end; ++i) {
+    const Candidate &candidate = candidate_list.candidate(i);
+    // Sub-candidate lists (transliterations) are flattened by the full
+    // serialization; within one page, represent them by their focused
+    // element so that indexes stay aligned with the visible rows.
+    const int id = candidate.HasSubcandidateList()
+                       ? candidate.subcandidate_list().focused_candidate().id()
+                       : candidate.id();
+    if (!segment.is_valid_index(id)) {
+      LOG(ERROR) << "Inconsistency between segment and candidate_list was "
+                    "observed. candidate index: "
+                 << id << " / " << candidate_list.size()
+                 << ", actual candidates size: " << segment.candidates_size();
+      return;
+    }
+    commands::CandidateWord *candidate_word_proto =
+        candidate_list_proto->add_candidates();
+    const int index = candidate_list_proto->candidates_size() - 1;
+    if (candidate_list.focused() && i == candidate_list.focused_index()) {
+      candidate_list_proto->set_focused_index(index);
+    }
+    FillCandidateWord(segment.candidate(id), id, index, segment.key(),
+                      candidate_word_proto);
+  }
+  candidate_list_proto->set_total_size(candidate_list.size());
+}
+
 // static
 void SessionOutput::FillRemovedCandidates(
     const Segment &segment, commands::CandidateList *candidate_list_proto) {
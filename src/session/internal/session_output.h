@@ -69,6 +69,14 @@ class SessionOutput {
       commands::Category category,
       commands::CandidateList *candidate_list_proto);
 
+  // Like FillAllCandidateWords but serializes only the candidates of the
+  // focused page, setting total_size to the complete count.  For clients
+  // declaring Capability.page_scoped_candidate_words.
+  static void FillPagedCandidateWords(
+      const Segment &segment, const CandidateList &candidate_list,
+      commands::Category category,
+      commands::CandidateList *candidate_list_proto);
+
   // For debug. Fill the CandidateList protobuf with the
   // removed_candidates_for_debug in the segment.
   static void FillRemovedCandidates(
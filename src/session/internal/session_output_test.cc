@@ -33,6 +33,7 @@
 #include <iterator>
 #include <string>
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "base/text_normalizer.h"
 #include "base/util.h"
@@ -334,6 +335,44 @@ TEST(SessionOutputTest, FillAllCandidateWords) {
   EXPECT_EQ(candidates_proto.candidates(6).num_segments_in_candidate(), 4);
 }
 
+TEST(SessionOutputTest, FillPagedCandidateWords) {
+  CandidateList candidate_list(true);
+  commands::CandidateList candidates_proto;
+
+  Segment segment;
+  segment.set_key("key");
+  constexpr size_t kNumCandidates = 13;  // More than one page of 9.
+  for (size_t i = 0; i < kNumCandidates; ++i) {
+    Segment::Candidate *candidate = segment.push_back_candidate();
+    candidate->content_key = "key";
+    candidate->value = absl::StrCat("value", i);
+    candidate_list.AddCandidate(i, candidate->value);
+  }
+  candidate_list.set_page_size(9);
+  candidate_list.MoveToId(0);
+
+  // First page: 9 of 13 candidates, total size attached.
+  SessionOutput::FillPagedCandidateWords(segment, candidate_list,
+                                         commands::CONVERSION,
+                                         &candidates_proto);
+  EXPECT_EQ(candidates_proto.candidates_size(), 9);
+  EXPECT_EQ(candidates_proto.total_size(), kNumCandidates);
+  EXPECT_EQ(candidates_proto.focused_index(), 0);
+  EXPECT_EQ(candidates_proto.candidates(0).value(), "value0");
+  EXPECT_EQ(candidates_proto.candidates(8).value(), "value8");
+
+  // Second page after moving the focus.
+  candidate_list.MoveToId(10);
+  candidates_proto.Clear();
+  SessionOutput::FillPagedCandidateWords(segment, candidate_list,
+                                         commands::CONVERSION,
+                                         &candidates_proto);
+  EXPECT_EQ(candidates_proto.candidates_size(), 4);
+  EXPECT_EQ(candidates_proto.total_size(), kNumCandidates);
+  EXPECT_EQ(candidates_proto.candidates(0).value(), "value9");
+  EXPECT_EQ(candidates_proto.focused_index(), 1);
+}
+
 TEST(SessionOutputTest, FillAllCandidateWords_Attributes) {
   CandidateList candidate_list(true);
   commands::CandidateList candidates_proto;
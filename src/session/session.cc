@@ -1008,6 +1008,8 @@ void Session::UpdatePreferences(commands::Command *command) {
   const config::Config &config = command->input().config();
   if (command->input().has_capability()) {
     *context_->mutable_client_capability() = command->input().capability();
+    context_->mutable_converter()->set_page_scoped_candidate_words(
+        command->input().capability().page_scoped_candidate_words());
   }
 
   // Update config values modified temporarily.
@@ -1462,6 +1464,8 @@ bool Session::MaybeSelectCandidate(commands::Command *command) {
 
 void Session::set_client_capability(const commands::Capability &capability) {
   *context_->mutable_client_capability() = capability;
+  context_->mutable_converter()->set_page_scoped_candidate_words(
+      capability.page_scoped_candidate_words());
 }
 
 void Session::set_application_info(
@@ -2949,5 +2953,12 @@ composer::Composer *Session::get_internal_composer_only_for_unittest() {
 
 const ImeContext &Session::context() const { return *context_; }
 
+void Session::WarmUpConversion() const {
+  if (context_->state() != ImeContext::COMPOSITION) {
+    return;
+  }
+  context_->converter().WarmUpConversion(context_->composer());
+}
+
 }  // namespace session
 }  // namespace mozc
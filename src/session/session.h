@@ -267,6 +267,11 @@ class Session : public SessionInterface {
 
   const ImeContext &context() const;
 
+  // Speculatively converts the current composition into the engine's result
+  // cache while the user pauses; a no-op outside composition.  Driven by the
+  // handler's idle timer (--speculative_conversion_delay_ms).
+  void WarmUpConversion() const;
+
  private:
   FRIEND_TEST(SessionTest, OutputInitialComposition);
   FRIEND_TEST(SessionTest, IsFullWidthInsertSpace);
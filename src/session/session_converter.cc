@@ -44,6 +44,7 @@
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "base/hash.h"
 #include "base/text_normalizer.h"
 #include "base/util.h"
 #include "base/vlog.h"
@@ -183,6 +184,8 @@ bool SessionConverter::ConvertWithPreferences(
   DCHECK(CheckState(COMPOSITION | SUGGESTION | CONVERSION));
 
   ConversionRequest conversion_request(&composer, request_, config_);
+  conversion_request.set_request_config_signature(
+      request_config_signature_);
   SetConversionPreferences(preferences, &segments_, &conversion_request);
   SetRequestType(ConversionRequest::CONVERSION, &conversion_request);
 
@@ -200,6 +203,28 @@ bool SessionConverter::ConvertWithPreferences(
   return true;
 }
 
+void SessionConverter::WarmUpConversion(
+    const composer::Composer &composer) const {
+  if (!CheckState(COMPOSITION | SUGGESTION)) {
+    return;
+  }
+  // Mirror ConvertWithPreferences exactly so the speculative result's cache
+  // fingerprint matches the one the real conversion will compute, but work
+  // on copies: neither the segments nor request_type_ may change here.  The
+  // scratch buffer is a member so its pooled capacity survives across
+  // warm-ups.
+  scratch_segments_ = segments_;
+  ConversionRequest conversion_request(&composer, request_, config_);
+  conversion_request.set_request_config_signature(
+      request_config_signature_);
+  SetConversionPreferences(conversion_preferences_, &scratch_segments_,
+                           &conversion_request);
+  conversion_request.set_request_type(ConversionRequest::CONVERSION);
+  if (!converter_->StartConversion(conversion_request, &scratch_segments_)) {
+    MOZC_VLOG(2) << "Speculative StartConversion() failed";
+  }
+}
+
 bool SessionConverter::GetReadingText(absl::string_view source_text,
                                       std::string *reading) {
   DCHECK(reading);
@@ -373,7 +398,9 @@ bool SessionConverter::SwitchKanaType(const composer::Composer &composer) {
     if (segments_.conversion_segments_size() != 1) {
       std::string composition;
       GetPreedit(0, segments_.conversion_segments_size(), &composition);
-      const ConversionRequest conversion_request(&composer, request_, config_);
+      ConversionRequest conversion_request(&composer, request_, config_);
+      conversion_request.set_request_config_signature(
+          request_config_signature_);
       if (!converter_->ResizeSegment(&segments_, conversion_request, 0,
                                      Util::CharsLen(composition))) {
         LOG(WARNING) << "ResizeSegment failed for segments.";
@@ -454,6 +481,8 @@ bool SessionConverter::SuggestWithPreferences(
   }
 
   ConversionRequest conversion_request(&composer, request_, &context, config_);
+  conversion_request.set_request_config_signature(
+      request_config_signature_);
   // Initialize the conversion request and segments for suggestion.
   SetConversionPreferences(preferences, &segments_, &conversion_request);
 
@@ -567,6 +596,8 @@ bool SessionConverter::PredictWithPreferences(
 
   // Initialize the segments and conversion_request for prediction
   ConversionRequest conversion_request(&composer, request_, config_);
+  conversion_request.set_request_config_signature(
+      request_config_signature_);
   SetConversionPreferences(preferences, &segments_, &conversion_request);
   SetRequestType(ConversionRequest::PREDICTION, &conversion_request);
   SetUseActualConverterForRealtimeConversion(*request_, &conversion_request);
@@ -676,6 +707,8 @@ void SessionConverter::Commit(const composer::Composer &composer,
   }
   CommitUsageStats(state_, context);
   ConversionRequest conversion_request(&composer, request_, &context, config_);
+  conversion_request.set_request_config_signature(
+      request_config_signature_);
   converter_->FinishConversion(conversion_request, &segments_);
   ResetState();
 }
@@ -726,6 +759,8 @@ bool SessionConverter::CommitSuggestionInternal(
     CommitUsageStats(SessionConverterInterface::SUGGESTION, context);
     ConversionRequest conversion_request(&composer, request_, &context,
                                          config_);
+    conversion_request.set_request_config_signature(
+        request_config_signature_);
     converter_->FinishConversion(conversion_request, &segments_);
     DCHECK_EQ(0, segments_.conversion_segments_size());
     ResetState();
@@ -849,6 +884,8 @@ void SessionConverter::CommitPreedit(const composer::Composer &composer,
                          &segments_);
   CommitUsageStats(SessionConverterInterface::COMPOSITION, context);
   ConversionRequest conversion_request(&composer, request_, &context, config_);
+  conversion_request.set_request_config_signature(
+      request_config_signature_);
   // the request mode is CONVERSION, as the user experience
   // is similar to conversion. UserHistoryPredictor distinguishes
   // CONVERSION from SUGGESTION now.
@@ -928,7 +965,9 @@ void SessionConverter::ResizeSegmentWidth(const composer::Composer &composer,
   }
   ResetResult();
 
-  const ConversionRequest conversion_request(&composer, request_, config_);
+  ConversionRequest conversion_request(&composer, request_, config_);
+  conversion_request.set_request_config_signature(
+      request_config_signature_);
   if (!converter_->ResizeSegment(&segments_, conversion_request, segment_index_,
                                  delta)) {
     return;
@@ -1164,6 +1203,11 @@ void SessionConverter::FillOutput(const composer::Composer &composer,
         segments_.conversion_segment(segment_index_),
         output->mutable_removed_candidate_words_for_debug());
   }
+
+  // The output for this command is complete and the session is about to go
+  // idle; speculatively build the payload of the most likely next command,
+  // committing the current selection.
+  MaybePrematerializeCommitResult();
 }
 
 // static
@@ -1195,6 +1239,8 @@ SessionConverter *SessionConverter::Clone() const {
   session_converter->request_ = request_;
   session_converter->config_ = config_;
   session_converter->use_cascading_window_ = use_cascading_window_;
+  session_converter->page_scoped_candidate_words_ =
+      page_scoped_candidate_words_;
   session_converter->selected_candidate_indices_ = selected_candidate_indices_;
   session_converter->request_type_ = request_type_;
 
@@ -1273,19 +1319,20 @@ void SessionConverter::GetConversion(const size_t index, const size_t size,
 }
 
 void SessionConverter::UpdateResultTokens(const size_t index,
-                                          const size_t size) {
+                                          const size_t size,
+                                          commands::Result *result) const {
   DCHECK(CheckState(SUGGESTION | PREDICTION | CONVERSION));
   DCHECK(index + size <= segments_.conversion_segments_size());
 
-  auto add_tokens = [this](absl::string_view content_key,
-                           absl::string_view content_value,
-                           absl::string_view functional_key,
-                           absl::string_view functional_value) {
-    commands::ResultToken *token1 = result_.add_tokens();
+  auto add_tokens = [result](absl::string_view content_key,
+                             absl::string_view content_value,
+                             absl::string_view functional_key,
+                             absl::string_view functional_value) {
+    commands::ResultToken *token1 = result->add_tokens();
     token1->set_key(content_key);
     token1->set_value(content_value);
     if (!functional_key.empty() || !functional_value.empty()) {
-      commands::ResultToken *token2 = result_.add_tokens();
+      commands::ResultToken *token2 = result->add_tokens();
       token2->set_key(functional_key);
       token2->set_value(functional_value);
     }
@@ -1295,7 +1342,7 @@ void SessionConverter::UpdateResultTokens(const size_t index,
     const int cand_idx = GetCandidateIndexForConverter(i);
     const Segment::Candidate &candidate =
         segments_.conversion_segment(i).candidate(cand_idx);
-    const int first_token_idx = result_.tokens_size();
+    const int first_token_idx = result->tokens_size();
 
     if (Segment::Candidate::InnerSegmentIterator it(&candidate); !it.Done()) {
       // If the candidate has inner segments, fill them to the result tokens.
@@ -1309,10 +1356,10 @@ void SessionConverter::UpdateResultTokens(const size_t index,
     }
     // Set lid and rid to the first and last tokens respectively.
     // Other lids and rids are filled with the default POS (i.e. -1 as unknown).
-    const int last_token_idx = result_.tokens_size() - 1;
+    const int last_token_idx = result->tokens_size() - 1;
     DCHECK_GE(last_token_idx, first_token_idx);
-    result_.mutable_tokens(first_token_idx)->set_lid(candidate.lid);
-    result_.mutable_tokens(last_token_idx)->set_rid(candidate.rid);
+    result->mutable_tokens(first_token_idx)->set_lid(candidate.lid);
+    result->mutable_tokens(last_token_idx)->set_rid(candidate.rid);
   }
 }
 
@@ -1383,19 +1430,81 @@ bool SessionConverter::UpdateResult(size_t index, size_t size,
     return false;
   }
 
-  std::string preedit, conversion;
-  GetPreedit(index, size, &preedit);
-  GetConversion(index, size, &conversion);
+  // The payload for committing every conversion segment at its selected
+  // candidate is usually prematerialized while the candidate window was
+  // shown; reuse it if the selection is still the one it was built for.
+  if (index == 0 && size == segments_.conversion_segments_size() &&
+      consumed_key_size == nullptr && prematerialized_fingerprint_ != 0 &&
+      prematerialized_fingerprint_ == ComputeCommitFingerprint()) {
+    result_ = prematerialized_result_;
+    prematerialized_fingerprint_ = 0;
+    return true;
+  }
+
   if (consumed_key_size) {
     *consumed_key_size = GetConsumedPreeditSize(index, size);
   }
-  SessionOutput::FillConversionResult(preedit, conversion, &result_);
-  SessionOutput::FillCursorOffsetResult(CalculateCursorOffset(conversion),
-                                        &result_);
-  UpdateResultTokens(index, size);
+  BuildConversionResult(index, size, &result_);
   return true;
 }
 
+void SessionConverter::BuildConversionResult(const size_t index,
+                                             const size_t size,
+                                             commands::Result *result) const {
+  std::string preedit, conversion;
+  GetPreedit(index, size, &preedit);
+  GetConversion(index, size, &conversion);
+  SessionOutput::FillConversionResult(preedit, conversion, result);
+  SessionOutput::FillCursorOffsetResult(CalculateCursorOffset(conversion),
+                                        result);
+  UpdateResultTokens(index, size, result);
+}
+
+uint64_t SessionConverter::ComputeCommitFingerprint() const {
+  const size_t size = segments_.conversion_segments_size();
+  if (size == 0) {
+    return 0;
+  }
+  std::string buf;
+  for (size_t i = 0; i < size; ++i) {
+    const int id = GetCandidateIndexForConverter(i);
+    const Segment &segment = segments_.conversion_segment(i);
+    const Segment::Candidate &candidate = segment.candidate(id);
+    absl::StrAppend(&buf, segment.key(), "\t", id, "\t", candidate.key, "\t",
+                    candidate.value, "\t", candidate.content_key, "\t",
+                    candidate.content_value, "\t", candidate.lid, "\t",
+                    candidate.rid, "\t",
+                    candidate.inner_segment_boundary.size(), "\n");
+    for (const uint32_t encoded : candidate.inner_segment_boundary) {
+      absl::StrAppend(&buf, encoded, ",");
+    }
+  }
+  return Fingerprint(buf);
+}
+
+void SessionConverter::MaybePrematerializeCommitResult() const {
+  prematerialized_fingerprint_ = 0;
+  if (!CheckState(PREDICTION | CONVERSION)) {
+    return;
+  }
+  const size_t size = segments_.conversion_segments_size();
+  if (size == 0) {
+    return;
+  }
+  // Command candidates perform an action at commit instead of producing a
+  // result; they must go through the non-cached path.
+  for (size_t i = 0; i < size; ++i) {
+    const int id = GetCandidateIndexForConverter(i);
+    if (segments_.conversion_segment(i).candidate(id).attributes &
+        Segment::Candidate::COMMAND_CANDIDATE) {
+      return;
+    }
+  }
+  prematerialized_result_.Clear();
+  BuildConversionResult(0, size, &prematerialized_result_);
+  prematerialized_fingerprint_ = ComputeCommitFingerprint();
+}
+
 namespace {
 // Convert transliteration::TransliterationType to id used in the
 // converter.  The id number are negative values, and 0 of
@@ -1644,6 +1753,11 @@ void SessionConverter::FillAllCandidateWords(
     return;
   }
   const Segment &segment = segments_.conversion_segment(segment_index_);
+  if (page_scoped_candidate_words_) {
+    SessionOutput::FillPagedCandidateWords(segment, candidate_list_, category,
+                                           candidates);
+    return;
+  }
   SessionOutput::FillAllCandidateWords(segment, candidate_list_, category,
                                        candidates);
 }
@@ -1667,6 +1781,7 @@ void SessionConverter::FillIncognitoCandidateWords(
 void SessionConverter::SetRequest(const commands::Request *request) {
   request_ = request;
   candidate_list_.set_page_size(request->candidate_page_size());
+  UpdateRequestConfigSignature();
 }
 
 void SessionConverter::SetConfig(const config::Config *config) {
@@ -1674,6 +1789,15 @@ void SessionConverter::SetConfig(const config::Config *config) {
   updated_command_ = Segment::Candidate::DEFAULT_COMMAND;
   selection_shortcut_ = config->selection_shortcut();
   use_cascading_window_ = config->use_cascading_window();
+  UpdateRequestConfigSignature();
+}
+
+void SessionConverter::UpdateRequestConfigSignature() {
+  // Serializing the protos is the expensive part of deriving cache keys, so
+  // it happens only here, on config or request updates, instead of on every
+  // command.
+  request_config_signature_ = Fingerprint(absl::StrCat(
+      request_->SerializeAsString(), "\x1e", config_->SerializeAsString()));
 }
 
 void SessionConverter::OnStartComposition(const commands::Context &context) {
@@ -232,6 +232,14 @@ class SessionConverter : public SessionConverterInterface {
   void FillOutput(const composer::Composer &composer,
                   commands::Output *output) const override;
 
+  void set_page_scoped_candidate_words(bool page_scoped) override {
+    page_scoped_candidate_words_ = page_scoped;
+  }
+
+  // Converts the current composition into a scratch buffer to warm the
+  // converter's result cache; session state is untouched.
+  void WarmUpConversion(const composer::Composer &composer) const override;
+
   // Sets setting by the request;
   void SetRequest(const commands::Request *request) override;
 
@@ -304,8 +312,29 @@ class SessionConverter : public SessionConverterInterface {
   // Updates internal states and fill result_.
   bool UpdateResult(size_t index, size_t size, size_t *consumed_key_size);
 
-  // Updates ResultTokens of result_.
-  void UpdateResultTokens(size_t index, size_t size);
+  // Builds the commit payload of segments [index, index + size) at their
+  // selected candidates into |result|.
+  void BuildConversionResult(size_t index, size_t size,
+                             commands::Result *result) const;
+
+  // Appends the ResultTokens of segments [index, index + size) to |result|.
+  void UpdateResultTokens(size_t index, size_t size,
+                          commands::Result *result) const;
+
+  // Recomputes request_config_signature_ from the current request and
+  // config protos.
+  void UpdateRequestConfigSignature();
+
+  // Fingerprint of the inputs the commit payload is derived from (selected
+  // candidates of every conversion segment), or 0 when there is nothing to
+  // commit.
+  uint64_t ComputeCommitFingerprint() const;
+
+  // Speculatively builds the payload of committing the current selection, so
+  // that the common commit-of-the-focused-selection is a cached proto copy.
+  // Called when the output of the current command has been filled, i.e. when
+  // the session goes idle waiting for the next key event.
+  void MaybePrematerializeCommitResult() const;
 
   // Fills the candidate list with the focused segment's candidates.
   // This method does not clear the candidate list before processing.
@@ -381,11 +410,28 @@ class SessionConverter : public SessionConverterInterface {
   // A part of Output protobuf to be returned to the client side.
   commands::Result result_;
 
+  // Speculatively built payload of committing the current selection, and the
+  // fingerprint of the selection it was built for (0 = none).  Mutable
+  // because the cache is refreshed when the (const) output fill completes.
+  mutable commands::Result prematerialized_result_;
+  mutable uint64_t prematerialized_fingerprint_ = 0;
+
+  // Set when the client declared Capability.page_scoped_candidate_words;
+  // all_candidate_words then carries only the focused page.
+  bool page_scoped_candidate_words_ = false;
+
+  // Reusable scratch buffer for speculative conversions; kept as a member so
+  // the pooled segment and candidate capacity is reused at steady state.
+  mutable Segments scratch_segments_;
+
   // Component of the candidate list converted from segments_to result_.
   CandidateList candidate_list_;
 
   const commands::Request *request_;
   const config::Config *config_;
+  // Precompiled fingerprint of *request_ and *config_, stamped onto every
+  // ConversionRequest built here; see ConversionRequest.
+  uint64_t request_config_signature_ = 0;
 
   SessionConverterInterface::State state_;
 
@@ -221,6 +221,17 @@ class SessionConverterInterface {
   virtual void FillOutput(const composer::Composer &composer,
                           commands::Output *output) const = 0;
 
+  // Notifies whether the client renders only the visible candidate page
+  // (Capability.page_scoped_candidate_words); implementations serializing
+  // all candidate words may ignore this.
+  virtual void set_page_scoped_candidate_words(bool page_scoped) {}
+
+  // Runs the conversion of the current composition into the engine's result
+  // cache without changing any session state, so that the real conversion
+  // command adopts the result if the key is unchanged.  Implementations
+  // without such a cache keep this default no-op.
+  virtual void WarmUpConversion(const composer::Composer &composer) const {}
+
   // Set setting by the request.
   // Currently this is especially for SessionConverter.
   virtual void SetRequest(const commands::Request *request) = 0;
@@ -44,9 +44,13 @@
 #include "absl/log/log.h"
 #include "absl/random/random.h"
 #include "absl/time/time.h"
+#include "base/background_scheduler.h"
 #include "base/clock.h"
+#include "base/hash.h"
 #include "base/logging.h"
+#include "base/perf_histogram.h"
 #include "base/stopwatch.h"
+#include "base/system_util.h"
 #include "base/version.h"
 #include "base/vlog.h"
 #include "composer/table.h"
@@ -85,6 +89,10 @@ ABSL_FLAG(int32_t, max_session_size, 64,
           "oldest session is removed");
 
 // TODO(b/275437228): Convert this to `absl::Duration`.
+ABSL_FLAG(int32_t, session_pool_size, 0,
+          "Number of deleted sessions kept pre-initialized for reuse by "
+          "CreateSession. 0 disables pooling. Useful for deployments that "
+          "create and destroy sessions at a high rate.");
 ABSL_FLAG(int32_t, create_session_min_interval, 0,
           "minimum interval (sec) for create session");
 
@@ -104,6 +112,27 @@ ABSL_FLAG(int32_t, last_create_session_timeout, 300,
 
 ABSL_FLAG(bool, restricted, false, "Launch server with restricted setting");
 
+ABSL_FLAG(int32_t, speculative_conversion_delay_ms, 0,
+          "If positive, speculatively convert the active composition after "
+          "this many milliseconds of inactivity to warm the conversion "
+          "result cache, so that hitting space adopts the prepared result.");
+
+ABSL_FLAG(std::string, canary_engine_data, "",
+          "Path to a canary engine data file. A deterministic hash of the "
+          "user profile directory assigns this installation to the canary "
+          "fraction; assigned servers load the canary data through the "
+          "normal reload machinery, others keep the bundled data. Assignment "
+          "is stable across restarts, so a dictionary build can be canaried "
+          "on a fraction of the fleet before full rollout.");
+ABSL_FLAG(int32_t, canary_fraction, 0,
+          "Percentage (0-100) of installations assigned to "
+          "--canary_engine_data.");
+ABSL_FLAG(bool, engine_warmup, false,
+          "Prime the conversion caches with a canned set of representative "
+          "conversions on a background thread right after startup, so that "
+          "the first keystroke does not pay every cold cost at once. The "
+          "warm-up is cancelled as soon as real input arrives.");
+
 namespace mozc {
 namespace {
 
@@ -171,9 +200,57 @@ SessionHandler::SessionHandler(std::unique_ptr<EngineInterface> engine)
     return;
   }
 
+  MaybeSelectCanaryEngineData();
+
+  if (absl::GetFlag(FLAGS_engine_warmup)) {
+    engine_->StartWarmup();
+  }
 
   // everything is OK
   is_available_ = true;
+
+  if (absl::GetFlag(FLAGS_speculative_conversion_delay_ms) > 0) {
+    speculative_thread_.emplace([this] { SpeculativeConversionLoop(); });
+  }
+}
+
+SessionHandler::~SessionHandler() {
+  if (speculative_thread_.has_value()) {
+    {
+      absl::MutexLock lock(&speculative_mutex_);
+      speculative_shutdown_ = true;
+    }
+    speculative_thread_->Join();
+  }
+}
+
+void SessionHandler::MaybeSelectCanaryEngineData() {
+  const std::string canary_path = absl::GetFlag(FLAGS_canary_engine_data);
+  const int32_t fraction = absl::GetFlag(FLAGS_canary_fraction);
+  if (canary_path.empty() || fraction <= 0) {
+    return;
+  }
+  // Deterministic per-installation assignment: stable across restarts and
+  // uniformly distributed over profiles. One generation per process keeps
+  // the always-on stage histograms attributable to that generation.
+  const uint64_t bucket =
+      Fingerprint(SystemUtil::GetUserProfileDirectory()) % 100;
+  if (bucket >= static_cast<uint64_t>(fraction)) {
+    LOG(INFO) << "Canary engine data not selected (bucket " << bucket << ")";
+    return;
+  }
+  EngineReloadRequest request;
+  request.set_engine_type(EngineReloadRequest::DESKTOP);
+  request.set_file_path(canary_path);
+  // Above the bundled data so the canary wins the priority sort; load
+  // failures unregister it and fall back automatically.
+  request.set_priority(-1);
+  if (engine_->SendEngineReloadRequest(request)) {
+    LOG(INFO) << "Canary engine data selected (bucket " << bucket
+              << "): " << canary_path;
+  } else {
+    LOG(WARNING) << "Canary engine data request rejected";
+  }
 }
 
 bool SessionHandler::IsAvailable() const { return is_available_; }
@@ -307,12 +384,26 @@ bool SessionHandler::SetRequest(commands::Command *command) {
 }
 
 bool SessionHandler::EvalCommand(commands::Command *command) {
+  // Serializes concurrent callers: the session LRU reorders on every lookup
+  // and the engine reload paths swap module state, so the handler body must
+  // not interleave. This makes the handler safe to drive from multiple
+  // server threads; commands for different sessions still serialize here
+  // until per-session locking lands with a deferred-reply IPC loop.
+  absl::MutexLock lock(&eval_mutex_);
+
   if (!is_available_) {
     LOG(ERROR) << "SessionHandler is not available.";
     return false;
   }
 
+  // Real input has arrived: stop the idle warm-up so it never converts
+  // concurrently with a session, and mark the activity for the background
+  // scheduler's idle detection. No-op once the warm-up has finished.
+  engine_->CancelWarmup();
+  BackgroundScheduler::NotifyUserActivity();
+
   bool eval_succeeded = false;
+  PerfHistogram::ScopedProbe probe(PerfHistogram::EVAL_COMMAND);
   Stopwatch stopwatch;
   stopwatch.Start();
 
@@ -326,6 +417,9 @@ bool SessionHandler::EvalCommand(commands::Command *command) {
     case commands::Input::SEND_KEY:
       eval_succeeded = SendKey(command);
       break;
+    case commands::Input::SEND_KEY_BATCH:
+      eval_succeeded = SendKeyBatch(command);
+      break;
     case commands::Input::TEST_SEND_KEY:
       eval_succeeded = TestSendKey(command);
       break;
@@ -410,14 +504,144 @@ bool SessionHandler::EvalCommand(commands::Command *command) {
       "ElapsedTimeUSec",
       static_cast<uint32_t>(absl::ToInt64Microseconds(stopwatch.GetElapsed())));
 
+  if (speculative_thread_.has_value()) {
+    // (Re)arm the idle timer: key events push the deadline out and target
+    // their session; anything else just cancels a pending warm-up.
+    absl::MutexLock spec_lock(&speculative_mutex_);
+    ++speculative_generation_;
+    speculative_session_id_ =
+        (eval_succeeded &&
+         command->input().type() == commands::Input::SEND_KEY)
+            ? command->input().id()
+            : 0;
+  }
+
   return is_available_;
 }
 
+void SessionHandler::SpeculativeConversionLoop() {
+  const absl::Duration delay = absl::Milliseconds(
+      absl::GetFlag(FLAGS_speculative_conversion_delay_ms));
+  speculative_mutex_.Lock();
+  while (true) {
+    speculative_mutex_.Await(absl::Condition(
+        +[](SessionHandler *self) ABSL_EXCLUSIVE_LOCKS_REQUIRED(
+            self->speculative_mutex_) {
+          return self->speculative_shutdown_ ||
+                 self->speculative_session_id_ != 0;
+        },
+        this));
+    if (speculative_shutdown_) {
+      speculative_mutex_.Unlock();
+      return;
+    }
+    const uint64_t generation = speculative_generation_;
+    const SessionID session_id = speculative_session_id_;
+    const auto interrupted = [this, generation]()
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(speculative_mutex_) {
+          return speculative_shutdown_ ||
+                 speculative_generation_ != generation;
+        };
+    if (speculative_mutex_.AwaitWithTimeout(absl::Condition(&interrupted),
+                                            delay)) {
+      // New activity or shutdown arrived during the quiet period;
+      // re-evaluate from the top.
+      continue;
+    }
+    speculative_session_id_ = 0;
+    speculative_mutex_.Unlock();
+    RunSpeculativeConversion(session_id, generation);
+    speculative_mutex_.Lock();
+  }
+}
+
+void SessionHandler::RunSpeculativeConversion(const SessionID session_id,
+                                              const uint64_t generation) {
+  absl::MutexLock lock(&eval_mutex_);
+  {
+    // A real command may have arrived while this thread waited for
+    // eval_mutex_; its state is the one that counts.
+    absl::MutexLock spec_lock(&speculative_mutex_);
+    if (speculative_shutdown_ || speculative_generation_ != generation) {
+      return;
+    }
+  }
+  if (!is_available_) {
+    return;
+  }
+  const std::unique_ptr<session::Session> *session =
+      session_map_->LookupWithoutInsert(session_id);
+  if (session == nullptr || *session == nullptr) {
+    return;
+  }
+  (*session)->WarmUpConversion();
+}
+
 std::unique_ptr<session::Session> SessionHandler::NewSession() {
+  if (!session_pool_.empty()) {
+    std::unique_ptr<session::Session> session =
+        std::move(session_pool_.back());
+    session_pool_.pop_back();
+    // Scrub the per-client state; config, request and keymap are re-applied
+    // to every session (including this one) by UpdateSessions right after
+    // creation.
+    commands::Command scratch;
+    session->ResetContext(&scratch);
+    session->set_client_capability(commands::Capability::default_instance());
+    session->set_application_info(
+        commands::ApplicationInfo::default_instance());
+    usage_stats::UsageStats::IncrementCount("SessionPoolHit");
+    return session;
+  }
+  if (absl::GetFlag(FLAGS_session_pool_size) > 0) {
+    usage_stats::UsageStats::IncrementCount("SessionPoolMiss");
+  }
   // Session doesn't take the ownership of engine.
   return std::make_unique<session::Session>(engine_.get());
 }
 
+void SessionHandler::MaybeElideUnchangedCandidates(SessionID id,
+                                                   commands::Command *command) {
+  if (!delta_capable_sessions_.contains(id)) {
+    return;
+  }
+  commands::Output *output = command->mutable_output();
+  if (!output->has_candidates()) {
+    last_candidates_.erase(id);
+    return;
+  }
+  // Compare everything except the focused index, which moves on every
+  // navigation step and is cheap to resend.
+  commands::Candidates normalized = output->candidates();
+  normalized.clear_focused_index();
+  std::string serialized;
+  normalized.SerializeToString(&serialized);
+  const auto [it, inserted] = last_candidates_.insert({id, serialized});
+  if (!inserted) {
+    if (it->second == serialized) {
+      const bool has_focus = output->candidates().has_focused_index();
+      const uint32_t focused_index = output->candidates().focused_index();
+      output->mutable_candidates()->Clear();
+      if (has_focus) {
+        output->mutable_candidates()->set_focused_index(focused_index);
+      }
+      output->set_candidates_unchanged(true);
+      return;
+    }
+    it->second = std::move(serialized);
+  }
+}
+
+void SessionHandler::ReleaseSession(
+    std::unique_ptr<session::Session> session) {
+  const size_t pool_size =
+      static_cast<size_t>(std::max(0, absl::GetFlag(FLAGS_session_pool_size)));
+  if (session == nullptr || session_pool_.size() >= pool_size) {
+    return;  // Destroyed on scope exit.
+  }
+  session_pool_.push_back(std::move(session));
+}
+
 void SessionHandler::AddObserver(session::SessionObserverInterface *observer) {
   observer_handler_->AddObserver(observer);
 }
@@ -439,6 +663,35 @@ bool SessionHandler::SendKey(commands::Command *command) {
     return false;
   }
   (*session)->SendKey(command);
+  MaybeElideUnchangedCandidates(id, command);
+  MaybeUpdateConfig(command);
+  return true;
+}
+
+bool SessionHandler::SendKeyBatch(commands::Command *command) {
+  const SessionID id = command->input().id();
+  std::unique_ptr<session::Session> *session = session_map_->MutableLookup(id);
+  if (session == nullptr || !*session) {
+    LOG(WARNING) << "SessionID " << id << " is not available";
+    return false;
+  }
+  // Applies all the key events in one round trip, returning only the final
+  // output. Each event still runs the full key handling (the session state
+  // machine depends on it), but the intermediate outputs - including their
+  // candidate serialization - are discarded server-side.
+  commands::Command key_command;
+  for (const commands::KeyEvent &key : command->input().key_batch()) {
+    key_command.Clear();
+    key_command.mutable_input()->set_type(commands::Input::SEND_KEY);
+    key_command.mutable_input()->set_id(id);
+    *key_command.mutable_input()->mutable_key() = key;
+    (*session)->SendKey(&key_command);
+  }
+  if (command->input().key_batch_size() > 0) {
+    *command->mutable_output() = key_command.output();
+  }
+  command->mutable_output()->set_id(id);
+  MaybeElideUnchangedCandidates(id, command);
   MaybeUpdateConfig(command);
   return true;
 }
@@ -462,6 +715,7 @@ bool SessionHandler::SendCommand(commands::Command *command) {
     return false;
   }
   (*session)->SendCommand(command);
+  MaybeElideUnchangedCandidates(id, command);
   MaybeUpdateConfig(command);
   return true;
 }
@@ -479,6 +733,8 @@ void SessionHandler::MaybeReloadEngine(commands::Command *command) {
   }
 
   LOG(INFO) << "Engine reloaded";
+  // Pooled sessions hold a pointer to the replaced engine.
+  session_pool_.clear();
   *command->mutable_output()->mutable_engine_reload_response() =
       engine_reload_response;
   table_manager_->ClearCaches();
@@ -520,7 +776,10 @@ bool SessionHandler::CreateSession(commands::Command *command) {
       return false;
     }
 
+    ReleaseSession(std::move(oldest_element->value));
     oldest_element->value.reset();
+    delta_capable_sessions_.erase(oldest_element->key);
+    last_candidates_.erase(oldest_element->key);
     session_map_->Erase(oldest_element->key);
     MOZC_VLOG(1) << "Session is FULL, oldest SessionID " << oldest_element->key
                  << " is removed";
@@ -548,6 +807,10 @@ bool SessionHandler::CreateSession(commands::Command *command) {
   element->value = std::move(session);
   command->mutable_output()->set_id(new_id);
 
+  if (command->input().capability().reconstructs_unchanged_candidates()) {
+    delta_capable_sessions_.insert(new_id);
+  }
+
   // The created session has not been fully initialized yet.
   // SetConfig() will complete the initialization by setting information
   // (e.g., config, request, keymap, ...) to all the sessions,
@@ -710,8 +973,11 @@ bool SessionHandler::DeleteSessionID(SessionID id) {
     LOG_IF(WARNING, id != 0) << "cannot find SessionID " << id;
     return false;
   }
+  ReleaseSession(std::move(*session));
   session->reset();
 
+  delta_capable_sessions_.erase(id);
+  last_candidates_.erase(id);
   session_map_->Erase(id);  // remove from LRU
 
   // if session gets empty, save the timestamp
@@ -34,11 +34,17 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 #include <optional>
 
 #include "absl/random/random.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
+#include "base/thread.h"
 #include "composer/table.h"
 #include "dictionary/user_dictionary_session_handler.h"
 #include "engine/engine_interface.h"
@@ -65,7 +71,7 @@ class SessionHandler : public SessionHandlerInterface {
   explicit SessionHandler(std::unique_ptr<EngineInterface> engine);
   SessionHandler(const SessionHandler &) = delete;
   SessionHandler &operator=(const SessionHandler &) = delete;
-  ~SessionHandler() override = default;
+  ~SessionHandler() override;
 
   // Returns true if SessionHandle is available.
   bool IsAvailable() const override;
@@ -86,6 +92,11 @@ class SessionHandler : public SessionHandlerInterface {
   const EngineInterface &engine() const { return *engine_; }
 
  private:
+  // Registers the canary engine data request when this installation's
+  // deterministic hash bucket falls into --canary_fraction; see the flag
+  // descriptions in the .cc.
+  void MaybeSelectCanaryEngineData();
+
   FRIEND_TEST(SessionHandlerTest, KeyMapTest);
   FRIEND_TEST(SessionHandlerTest, EngineUpdateSuccessfulScenarioTest);
   FRIEND_TEST(SessionHandlerTest, EngineRollbackDataTest);
@@ -139,7 +150,31 @@ class SessionHandler : public SessionHandlerInterface {
   SessionID CreateNewSessionID();
   bool DeleteSessionID(SessionID id);
 
+  // Returns a deleted session to the pool for reuse by NewSession, or
+  // destroys it when pooling is off or the pool is full.
+  void ReleaseSession(std::unique_ptr<session::Session> session);
+
+  bool SendKeyBatch(commands::Command *command);
+
+  // Replaces an unchanged candidate window in the output with a compact
+  // marker for clients that reconstruct it locally; see
+  // Capability::reconstructs_unchanged_candidates.
+  void MaybeElideUnchangedCandidates(SessionID id, commands::Command *command);
+
+  // Speculative conversion of the active composition after an idle period;
+  // see --speculative_conversion_delay_ms in the .cc.
+  void SpeculativeConversionLoop();
+  void RunSpeculativeConversion(SessionID session_id, uint64_t generation);
+
+  // Serializes EvalCommand; see the comment there.
+  mutable absl::Mutex eval_mutex_;
   std::unique_ptr<SessionMap> session_map_;
+  // Pre-initialized sessions kept for reuse; see --session_pool_size.
+  std::vector<std::unique_ptr<session::Session>> session_pool_;
+  // Sessions whose client reconstructs unchanged candidate windows, and the
+  // last (focus-normalized, serialized) window sent to each of them.
+  absl::flat_hash_set<SessionID> delta_capable_sessions_;
+  absl::flat_hash_map<SessionID, std::string> last_candidates_;
 #ifndef MOZC_DISABLE_SESSION_WATCHDOG
   std::optional<SessionWatchDog> session_watch_dog_;
 #endif  // MOZC_DISABLE_SESSION_WATCHDOG
@@ -150,6 +185,14 @@ class SessionHandler : public SessionHandlerInterface {
   absl::Time last_create_session_time_ = absl::InfinitePast();
 
   std::unique_ptr<EngineInterface> engine_;
+
+  // State of the speculative-conversion idle timer.  The generation counter
+  // is bumped by every evaluated command, invalidating pending warm-ups.
+  absl::Mutex speculative_mutex_;
+  bool speculative_shutdown_ ABSL_GUARDED_BY(speculative_mutex_) = false;
+  uint64_t speculative_generation_ ABSL_GUARDED_BY(speculative_mutex_) = 0;
+  SessionID speculative_session_id_ ABSL_GUARDED_BY(speculative_mutex_) = 0;
+  std::optional<Thread> speculative_thread_;
   std::unique_ptr<session::SessionObserverHandler> observer_handler_;
   std::unique_ptr<user_dictionary::UserDictionarySessionHandler>
       user_dictionary_session_handler_;
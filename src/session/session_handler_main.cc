@@ -52,8 +52,15 @@ SHOW_LOG_BY_VALUE       ございます
 SHOW_LOG_BY_VALUE       ございました
 */
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#ifdef _WIN32
+#include <malloc.h>  // for _aligned_malloc/_aligned_free
+#endif  // _WIN32
+#include <new>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -61,8 +68,10 @@ SHOW_LOG_BY_VALUE       ございました
 #include <vector>
 
 #include "absl/strings/str_cat.h"
+#include "base/alloc_tracker.h"
 #include "base/file_stream.h"
 #include "base/init_mozc.h"
+#include "base/perf_histogram.h"
 #include "base/system_util.h"
 #include "absl/flags/flag.h"
 #include "absl/status/status.h"
@@ -70,8 +79,10 @@ SHOW_LOG_BY_VALUE       ございました
 #include "absl/strings/numbers.h"
 #include "data_manager/oss/oss_data_manager.h"
 #include "engine/engine.h"
+#include "absl/time/time.h"
 #include "protocol/candidates.pb.h"
 #include "protocol/commands.pb.h"
+#include "rewriter/rewriter_profile.h"
 #include "session/session_handler_tool.h"
 
 ABSL_FLAG(std::string, input, "", "Input file");
@@ -80,6 +91,59 @@ ABSL_FLAG(std::string, engine, "", "Conversion engine: 'mobile' or 'desktop'");
 ABSL_FLAG(std::string, dictionary, "",
           "Dictionary: 'google', 'android' or 'oss'");
 
+// This diagnostic binary interposes the global allocation operators and
+// feeds AllocTracker, so allocations are attributed to the pipeline stage
+// scoped by the PerfHistogram probes; see the DUMP_ALLOC_STATS and
+// RESET_ALLOC_STATS commands below. Production binaries do not interpose,
+// which keeps the tracker inert there.
+void *operator new(std::size_t size) {
+  mozc::AllocTracker::OnAllocation(size);
+  if (void *ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return ::operator new(size); }
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  mozc::AllocTracker::OnAllocation(size);
+#ifdef _WIN32
+  if (void *ptr =
+          _aligned_malloc(size, static_cast<std::size_t>(alignment))) {
+    return ptr;
+  }
+#else   // _WIN32
+  void *ptr = nullptr;
+  if (posix_memalign(&ptr, static_cast<std::size_t>(alignment), size) == 0) {
+    return ptr;
+  }
+#endif  // _WIN32
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return ::operator new(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+#ifdef _WIN32
+void operator delete(void *ptr, std::align_val_t) noexcept {
+  _aligned_free(ptr);
+}
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+  _aligned_free(ptr);
+}
+#else   // _WIN32
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+#endif  // _WIN32
+
 namespace mozc {
 void Show(const commands::Output &output) {
   for (const auto &segment : output.preedit().segment()) {
@@ -169,6 +233,54 @@ void ParseLine(session::SessionHandlerInterpreter &handler, std::string line) {
     return;
   }
 
+  if (command == "DUMP_ALLOC_STATS") {
+    // Allocations and bytes per pipeline stage since start or the last
+    // RESET_ALLOC_STATS; bracket a steady-state region with RESET + DUMP to
+    // verify the arena features allocate nothing there.
+    std::cout << "stage\tallocs\tbytes\n";
+    const AllocTracker::StageCounters unattributed = AllocTracker::Stage(0);
+    std::cout << "unattributed\t" << unattributed.allocations << "\t"
+              << unattributed.bytes << std::endl;
+    for (int stage = 0; stage < PerfHistogram::NUM_STAGES; ++stage) {
+      const AllocTracker::StageCounters counters =
+          AllocTracker::Stage(stage + 1);
+      std::cout << PerfHistogram::StageName(
+                       static_cast<PerfHistogram::Stage>(stage))
+                << "\t" << counters.allocations << "\t" << counters.bytes
+                << std::endl;
+    }
+    const AllocTracker::StageCounters arena = AllocTracker::ArenaChunks();
+    std::cout << "arena_chunks\t" << arena.allocations << "\t" << arena.bytes
+              << std::endl;
+    return;
+  }
+  if (command == "RESET_ALLOC_STATS") {
+    AllocTracker::Reset();
+    return;
+  }
+  if (command == "ENABLE_REWRITER_PROFILE") {
+    RewriterProfile::Enable();
+    return;
+  }
+  if (command == "DUMP_REWRITER_PROFILE") {
+    // Per-rewriter cost accounting, ranked by cumulative time: calls, how
+    // many of them fired (modified the segments), and total/mean time.
+    // Rewriters that never fire in a workload are bitmask candidates.
+    std::cout << "rewriter\tcalls\tfired\ttotal_us\tmean_us\n";
+    for (const RewriterProfile::Entry &entry : RewriterProfile::Snapshot()) {
+      const double total_us = absl::ToDoubleMicroseconds(entry.total);
+      std::cout << entry.name << "	" << entry.calls << "	" << entry.fired
+                << "	" << total_us << "	"
+                << (entry.calls == 0 ? 0.0 : total_us / entry.calls)
+                << std::endl;
+    }
+    return;
+  }
+  if (command == "RESET_REWRITER_PROFILE") {
+    RewriterProfile::Reset();
+    return;
+  }
+
   const absl::Status status = handler.Eval(args);
   if (!status.ok()) {
     std::cout << "ERROR: " << line << std::endl;
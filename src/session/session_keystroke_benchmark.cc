@@ -0,0 +1,364 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Replays keystroke workloads through the full session pipeline (key event
+// -> session -> composer -> conversion/prediction -> output proto) and
+// reports per-command latency percentiles and allocation counts, so
+// per-keystroke regressions surface before a release. Two load sources:
+//
+//  - synthetic sessions from RandomKeyEventsGenerator (--sessions), driven
+//    through SessionHandlerTool as TEST_SEND_KEY + SEND_KEY pairs like a
+//    real client, and
+//  - a recorded session (--script_file) in the line format of
+//    session_handler_scenario tests, replayed through
+//    SessionHandlerInterpreter; latencies are keyed by the command name.
+//
+// Example:
+//   session_keystroke_benchmark --sessions=50
+//   session_keystroke_benchmark --script_file=recorded_session.txt
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>  // for _aligned_malloc/_aligned_free
+#endif  // _WIN32
+
+#include "absl/flags/flag.h"
+#include "absl/status/status.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "base/file_stream.h"
+#include "base/init_mozc.h"
+#include "base/logging.h"
+#include "base/thread.h"
+#include "engine/engine_factory.h"
+#include "protocol/commands.pb.h"
+#include "session/random_keyevents_generator.h"
+#include "session/session_handler.h"
+#include "session/session_handler_tool.h"
+
+ABSL_FLAG(int32_t, sessions, 20, "Number of synthetic sessions to replay.");
+ABSL_FLAG(uint32_t, seed, 42, "Seed of the synthetic key event generator.");
+ABSL_FLAG(int32_t, concurrent_clients, 0,
+          "When positive, run the multi-client mode instead: this many "
+          "synthetic clients drive one shared SessionHandler concurrently "
+          "through the real dispatch path, reporting aggregate commands/sec, "
+          "latency percentiles, the worst per-client p99 and a contention "
+          "factor (summed command latency over wall time; values well above "
+          "the client count indicate serialization).");
+ABSL_FLAG(std::string, script_file, "",
+          "Recorded session to replay through SessionHandlerInterpreter, one "
+          "command per line in the session_handler_scenario format. Empty "
+          "lines and lines starting with # are skipped.");
+
+namespace {
+// Counted by the interposed global allocation functions below.
+std::atomic<uint64_t> g_allocations{0};
+}  // namespace
+
+// Allocation counting: this benchmark binary interposes the global
+// allocation functions and counts calls (frees are not tracked); the
+// per-command delta is reported as allocations per operation.
+void *operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return ::operator new(size); }
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+#ifdef _WIN32
+  if (void *ptr =
+          _aligned_malloc(size, static_cast<std::size_t>(alignment))) {
+    return ptr;
+  }
+#else   // _WIN32
+  void *ptr = nullptr;
+  if (posix_memalign(&ptr, static_cast<std::size_t>(alignment), size) == 0) {
+    return ptr;
+  }
+#endif  // _WIN32
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return ::operator new(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+#ifdef _WIN32
+void operator delete(void *ptr, std::align_val_t) noexcept {
+  _aligned_free(ptr);
+}
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+  _aligned_free(ptr);
+}
+#else   // _WIN32
+void operator delete(void *ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+#endif  // _WIN32
+
+namespace mozc {
+namespace session {
+namespace {
+
+class LatencyRecorder {
+ public:
+  // Runs |operation|, attributing its latency and allocations to |command|.
+  template <typename Operation>
+  void Measure(const std::string &command, Operation operation) {
+    const uint64_t allocations_before =
+        g_allocations.load(std::memory_order_relaxed);
+    const absl::Time start = absl::Now();
+    operation();
+    const absl::Duration latency = absl::Now() - start;
+    Samples &samples = samples_[command];
+    samples.latencies_ns.push_back(absl::ToDoubleNanoseconds(latency));
+    samples.allocations +=
+        g_allocations.load(std::memory_order_relaxed) - allocations_before;
+  }
+
+  void Report() const {
+    std::cout << "command\tcount\tp50_us\tp95_us\tp99_us\tmax_us\tallocs/op\n";
+    for (const auto &[command, samples] : samples_) {
+      std::vector<double> sorted = samples.latencies_ns;
+      std::sort(sorted.begin(), sorted.end());
+      const auto percentile = [&sorted](double quantile) {
+        const size_t index = std::min(
+            sorted.size() - 1,
+            static_cast<size_t>(quantile * (sorted.size() - 1) + 0.5));
+        return sorted[index] / 1000.0;  // in microseconds
+      };
+      std::cout << absl::StrFormat(
+          "%s\t%d\t%.1f\t%.1f\t%.1f\t%.1f\t%.1f\n", command, sorted.size(),
+          percentile(0.5), percentile(0.95), percentile(0.99),
+          sorted.back() / 1000.0,
+          static_cast<double>(samples.allocations) / sorted.size());
+    }
+  }
+
+ private:
+  struct Samples {
+    std::vector<double> latencies_ns;
+    uint64_t allocations = 0;
+  };
+  std::map<std::string, Samples> samples_;
+};
+
+// Drives random typing sessions through the handler the way a client does:
+// every key is probed with TEST_SEND_KEY and then committed with SEND_KEY.
+void RunSyntheticSessions(LatencyRecorder &recorder) {
+  SessionHandlerTool client(EngineFactory::Create().value());
+  CHECK(client.CreateSession()) << "CreateSession failed";
+  RandomKeyEventsGenerator generator(
+      std::seed_seq{absl::GetFlag(FLAGS_seed)});
+
+  commands::Output output;
+  for (int session = 0; session < absl::GetFlag(FLAGS_sessions); ++session) {
+    std::vector<commands::KeyEvent> keys;
+    generator.GenerateSequence(&keys);
+    for (const commands::KeyEvent &key : keys) {
+      recorder.Measure("TEST_SEND_KEY",
+                       [&] { client.TestSendKey(key, &output); });
+      recorder.Measure("SEND_KEY", [&] { client.SendKey(key, &output); });
+    }
+  }
+}
+
+// Replays a recorded session line by line; latencies are keyed by the
+// command name (the first token of each line).
+void ReplayRecordedSession(const std::string &path,
+                           LatencyRecorder &recorder) {
+  SessionHandlerInterpreter interpreter;
+  InputFileStream ifs(path);
+  CHECK(ifs.good()) << "Cannot open " << path;
+
+  std::string line;
+  while (std::getline(ifs, line)) {
+    const absl::string_view stripped = absl::StripAsciiWhitespace(line);
+    if (stripped.empty() || stripped.front() == '#') {
+      continue;
+    }
+    const std::vector<std::string> args = interpreter.Parse(stripped);
+    if (args.empty()) {
+      continue;
+    }
+    recorder.Measure(args[0], [&] {
+      if (const absl::Status status = interpreter.Eval(args); !status.ok()) {
+        LOG(WARNING) << "Eval failed: " << stripped << ": " << status;
+      }
+    });
+  }
+}
+
+// Percentile of a sorted latency vector, in microseconds.
+double PercentileUs(const std::vector<double> &sorted_ns,
+                    const double quantile) {
+  const size_t index =
+      std::min(sorted_ns.size() - 1,
+               static_cast<size_t>(quantile * (sorted_ns.size() - 1) + 0.5));
+  return sorted_ns[index] / 1000.0;
+}
+
+// N clients share one handler; each runs its own random typing sessions and
+// records per-command latency. The handler serializes commands internally,
+// so this measures the real dispatch path under contention.
+int RunConcurrentClients(const int num_clients) {
+  // Staying below the handler's session LRU capacity (--max_session_size,
+  // default 64) keeps sessions alive for the whole run; eviction would
+  // silently invalidate other clients' sessions.
+  CHECK_LE(num_clients, 64) << "Use --max_session_size to raise the limit";
+  SessionHandler handler(EngineFactory::Create().value());
+  CHECK(handler.IsAvailable());
+
+  std::vector<std::vector<double>> latencies_ns(num_clients);
+  std::atomic<uint64_t> failed_commands{0};
+  const uint32_t seed = absl::GetFlag(FLAGS_seed);
+  const int32_t sessions_per_client = absl::GetFlag(FLAGS_sessions);
+
+  const absl::Time start = absl::Now();
+  {
+    std::vector<Thread> clients;
+    clients.reserve(num_clients);
+    for (int client = 0; client < num_clients; ++client) {
+      clients.emplace_back([&, client] {
+        commands::Command command;
+        command.mutable_input()->set_type(commands::Input::CREATE_SESSION);
+        handler.EvalCommand(&command);
+        const uint64_t session_id = command.output().id();
+        CHECK_NE(session_id, 0) << "CreateSession failed";
+
+        RandomKeyEventsGenerator generator(
+            std::seed_seq{seed + static_cast<uint32_t>(client)});
+        std::vector<commands::KeyEvent> keys;
+        for (int32_t session = 0; session < sessions_per_client; ++session) {
+          keys.clear();
+          generator.GenerateSequence(&keys);
+          for (const commands::KeyEvent &key : keys) {
+            command.Clear();
+            command.mutable_input()->set_id(session_id);
+            command.mutable_input()->set_type(commands::Input::SEND_KEY);
+            *command.mutable_input()->mutable_key() = key;
+            const absl::Time before = absl::Now();
+            if (!handler.EvalCommand(&command)) {
+              failed_commands.fetch_add(1, std::memory_order_relaxed);
+            }
+            latencies_ns[client].push_back(
+                absl::ToDoubleNanoseconds(absl::Now() - before));
+          }
+        }
+
+        command.Clear();
+        command.mutable_input()->set_id(session_id);
+        command.mutable_input()->set_type(commands::Input::DELETE_SESSION);
+        handler.EvalCommand(&command);
+      });
+    }
+    for (Thread &client : clients) {
+      client.Join();
+    }
+  }
+  const double wall_seconds =
+      absl::ToDoubleSeconds(absl::Now() - start);
+
+  std::vector<double> all_ns;
+  double total_latency_ns = 0;
+  double worst_client_p99_us = 0;
+  for (std::vector<double> &client_ns : latencies_ns) {
+    std::sort(client_ns.begin(), client_ns.end());
+    if (!client_ns.empty()) {
+      worst_client_p99_us =
+          std::max(worst_client_p99_us, PercentileUs(client_ns, 0.99));
+    }
+    for (const double ns : client_ns) {
+      all_ns.push_back(ns);
+      total_latency_ns += ns;
+    }
+  }
+  std::sort(all_ns.begin(), all_ns.end());
+
+  std::cout << absl::StrFormat(
+      "clients\t%d\ncommands\t%d\nwall_s\t%.2f\ncommands_per_s\t%.0f\n"
+      "p50_us\t%.1f\np95_us\t%.1f\np99_us\t%.1f\n"
+      "worst_client_p99_us\t%.1f\ncontention_factor\t%.2f\n"
+      "failed_commands\t%d\n",
+      num_clients, all_ns.size(), wall_seconds, all_ns.size() / wall_seconds,
+      PercentileUs(all_ns, 0.5), PercentileUs(all_ns, 0.95),
+      PercentileUs(all_ns, 0.99), worst_client_p99_us,
+      total_latency_ns / 1e9 / wall_seconds,
+      failed_commands.load(std::memory_order_relaxed));
+  return 0;
+}
+
+int BenchmarkMain() {
+  if (const int num_clients = absl::GetFlag(FLAGS_concurrent_clients);
+      num_clients > 0) {
+    return RunConcurrentClients(num_clients);
+  }
+  LatencyRecorder recorder;
+  const std::string script_file = absl::GetFlag(FLAGS_script_file);
+  if (!script_file.empty()) {
+    ReplayRecordedSession(script_file, recorder);
+  } else {
+    RunSyntheticSessions(recorder);
+  }
+  recorder.Report();
+  return 0;
+}
+
+}  // namespace
+}  // namespace session
+}  // namespace mozc
+
+int main(int argc, char **argv) {
+  mozc::InitMozc(argv[0], &argc, &argv);
+  return mozc::session::BenchmarkMain();
+}
@@ -43,8 +43,10 @@
 #include "engine/engine_factory.h"
 #include "ipc/ipc.h"
 #include "ipc/named_event.h"
+#include "base/protobuf/arena.h"
 #include "protocol/commands.pb.h"
 #include "session/session_handler.h"
+#include "usage_stats/usage_stats.h"
 #include "session/session_usage_observer.h"
 
 namespace {
@@ -93,7 +95,12 @@ bool SessionServer::Process(absl::string_view request, std::string *response) {
     return false;  // shutdown the server if handler doesn't exist
   }
 
-  commands::Command command;
+  // Allocate the whole command tree (input, output, candidates, preedit and
+  // their many small strings) from one arena: per-keystroke proto allocation
+  // becomes a bump-pointer operation and teardown one bulk reset.
+  google::protobuf::Arena arena;
+  commands::Command &command =
+      *google::protobuf::Arena::Create<commands::Command>(&arena);
   if (!command.mutable_input()->ParseFromArray(request.data(),
                                                request.size())) {
     LOG(WARNING) << "Invalid request";
@@ -113,6 +120,10 @@ bool SessionServer::Process(absl::string_view request, std::string *response) {
     return true;
   }
 
+  // Tracks the bytes served from the arena (vs. malloc) in production.
+  usage_stats::UsageStats::IncrementCountBy(
+      "EvalCommandArenaSpaceUsed", static_cast<uint32_t>(arena.SpaceUsed()));
+
   // debug message
   MOZC_VLOG(2) << command;
 
@@ -29,12 +29,16 @@
 
 #include "storage/encrypted_string_storage.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <ios>
 #include <string>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "base/bits.h"
 #include "base/encryptor.h"
 #include "base/file_stream.h"
 #include "base/file_util.h"
@@ -56,6 +60,69 @@ constexpr size_t kSaltSize = 32;
 
 // Maximum file size (64Mbyte)
 constexpr size_t kMaxFileSize = 64 * 1024 * 1024;
+
+// Chunked container layout (EncryptedChunkedStringStorage):
+//   uint32_t magic, uint32_t version, salt[kSaltSize]
+//   chunk*: iv[block size], uint32_t encrypted size, encrypted bytes
+// Each chunk holds at most kChunkSize plaintext bytes and is encrypted with
+// the header salt and its own random IV.
+constexpr uint32_t kChunkedMagic = 0x534b434d;  // "MCKS"
+constexpr uint32_t kChunkedVersion = 1;
+constexpr size_t kChunkedHeaderSize = 8 + kSaltSize;
+constexpr size_t kChunkSize = 4096;
+
+// Derives the key for one chunk from the password, the container salt and
+// the chunk IV.
+bool DeriveChunkKey(const absl::string_view salt, const uint8_t *iv,
+                    Encryptor::Key *key) {
+  std::string password;
+  if (!PasswordManager::GetPassword(&password) || password.empty()) {
+    LOG(ERROR) << "PasswordManager::GetPassword() failed";
+    return false;
+  }
+  if (!key->DeriveFromPassword(password, salt, iv)) {
+    LOG(ERROR) << "Encryptor::Key::DeriveFromPassword failed";
+    return false;
+  }
+  return true;
+}
+
+// Appends |plaintext| (at most kChunkSize bytes) as one encrypted chunk
+// record to |out|.
+bool AppendChunkRecord(const absl::string_view salt,
+                       const absl::string_view plaintext, mozc::Random *random,
+                       std::string *out) {
+  Encryptor::Key key;
+  const std::string iv = random->ByteString(Encryptor::Key().iv_size());
+  if (!DeriveChunkKey(salt, reinterpret_cast<const uint8_t *>(iv.data()),
+                      &key)) {
+    return false;
+  }
+  std::string encrypted(plaintext);
+  if (!Encryptor::EncryptString(key, &encrypted)) {
+    LOG(ERROR) << "Encryptor::EncryptString() failed";
+    return false;
+  }
+  out->append(iv);
+  char size_buf[4];
+  StoreUnaligned<uint32_t>(static_cast<uint32_t>(encrypted.size()), size_buf);
+  out->append(size_buf, 4);
+  out->append(encrypted);
+  return true;
+}
+
+// Serializes |input| into chunk records appended to |out|.
+bool AppendChunkRecords(const absl::string_view salt, absl::string_view input,
+                        mozc::Random *random, std::string *out) {
+  while (!input.empty()) {
+    const size_t chunk_size = std::min(input.size(), kChunkSize);
+    if (!AppendChunkRecord(salt, input.substr(0, chunk_size), random, out)) {
+      return false;
+    }
+    input.remove_prefix(chunk_size);
+  }
+  return true;
+}
 }  // namespace
 
 bool EncryptedStringStorage::Load(std::string *output) const {
@@ -162,6 +229,134 @@ bool EncryptedStringStorage::Save(const std::string &input) const {
   return true;
 }
 
+bool EncryptedChunkedStringStorage::Load(std::string *output) const {
+  DCHECK(output);
+  output->clear();
+
+  const absl::StatusOr<Mmap> mmap = Mmap::Map(filename_, Mmap::READ_ONLY);
+  if (!mmap.ok()) {
+    LOG(ERROR) << "cannot open chunked storage: " << mmap.status();
+    return false;
+  }
+  if (mmap->size() < kChunkedHeaderSize || mmap->size() > kMaxFileSize ||
+      LoadUnaligned<uint32_t>(mmap->begin()) != kChunkedMagic ||
+      LoadUnaligned<uint32_t>(mmap->begin() + 4) != kChunkedVersion) {
+    LOG(ERROR) << "unknown chunked storage layout: " << filename_;
+    return false;
+  }
+  const absl::string_view salt(mmap->begin() + 8, kSaltSize);
+
+  const size_t iv_size = Encryptor::Key().iv_size();
+  size_t pos = kChunkedHeaderSize;
+  while (pos < mmap->size()) {
+    // A torn tail chunk (crash mid-append) is dropped; everything decrypted
+    // so far is still valid journal content.
+    if (mmap->size() - pos < iv_size + 4) {
+      LOG(WARNING) << "Dropping a torn tail chunk at " << pos;
+      break;
+    }
+    const uint8_t *iv = reinterpret_cast<const uint8_t *>(mmap->begin() + pos);
+    const uint32_t encrypted_size =
+        LoadUnaligned<uint32_t>(mmap->begin() + pos + iv_size);
+    pos += iv_size + 4;
+    if (encrypted_size == 0 || mmap->size() - pos < encrypted_size) {
+      LOG(WARNING) << "Dropping a torn tail chunk at " << pos;
+      break;
+    }
+    Encryptor::Key key;
+    if (!DeriveChunkKey(salt, iv, &key)) {
+      return false;
+    }
+    std::string chunk(mmap->begin() + pos, encrypted_size);
+    if (!Encryptor::DecryptString(key, &chunk)) {
+      LOG(WARNING) << "Dropping an undecryptable tail chunk at " << pos;
+      break;
+    }
+    output->append(chunk);
+    pos += encrypted_size;
+  }
+  return true;
+}
+
+bool EncryptedChunkedStringStorage::Save(const std::string &input) const {
+  const std::string salt = random_.ByteString(kSaltSize);
+
+  std::string image;
+  image.reserve(kChunkedHeaderSize + input.size() + input.size() / 16 + 64);
+  char header[8];
+  StoreUnaligned<uint32_t>(kChunkedMagic, header);
+  StoreUnaligned<uint32_t>(kChunkedVersion, header + 4);
+  image.append(header, 8);
+  image.append(salt);
+  if (!AppendChunkRecords(salt, input, &random_, &image)) {
+    return false;
+  }
+
+  const std::string tmp_filename = filename_ + ".tmp";
+  if (absl::Status s = FileUtil::SetContents(tmp_filename, image); !s.ok()) {
+    LOG(ERROR) << "failed to write: " << tmp_filename << ": " << s;
+    return false;
+  }
+  if (absl::Status s = FileUtil::AtomicRename(tmp_filename, filename_);
+      !s.ok()) {
+    LOG(ERROR) << "AtomicRename failed: " << s << "; from: " << tmp_filename
+               << ", to: " << filename_;
+    return false;
+  }
+
+#ifdef _WIN32
+  if (!FileUtil::HideFile(filename_)) {
+    LOG(ERROR) << "Cannot make hidden: " << filename_ << " "
+               << ::GetLastError();
+  }
+#endif  // _WIN32
+
+  return true;
+}
+
+bool EncryptedChunkedStringStorage::Append(const absl::string_view data) const {
+  if (data.empty()) {
+    return true;
+  }
+
+  // Read the salt from the existing header; recreate an empty container when
+  // the file is missing or has an unknown layout.
+  std::string salt;
+  {
+    const absl::StatusOr<Mmap> mmap = Mmap::Map(filename_, Mmap::READ_ONLY);
+    if (mmap.ok() && mmap->size() >= kChunkedHeaderSize &&
+        LoadUnaligned<uint32_t>(mmap->begin()) == kChunkedMagic &&
+        LoadUnaligned<uint32_t>(mmap->begin() + 4) == kChunkedVersion) {
+      salt.assign(mmap->begin() + 8, kSaltSize);
+    }
+  }
+  if (salt.empty()) {
+    if (!Save("")) {
+      return false;
+    }
+    const absl::StatusOr<Mmap> mmap = Mmap::Map(filename_, Mmap::READ_ONLY);
+    if (!mmap.ok() || mmap->size() < kChunkedHeaderSize) {
+      return false;
+    }
+    salt.assign(mmap->begin() + 8, kSaltSize);
+  }
+
+  std::string records;
+  if (!AppendChunkRecords(salt, data, &random_, &records)) {
+    return false;
+  }
+
+  OutputFileStream ofs(filename_,
+                       std::ios::out | std::ios::binary | std::ios::app);
+  if (!ofs) {
+    LOG(ERROR) << "failed to append: " << filename_;
+    return false;
+  }
+  ofs.write(records.data(), records.size());
+  ofs.flush();
+  return ofs.good();
+}
+
 bool EncryptedStringStorage::Encrypt(const std::string &salt,
                                      std::string *data) const {
   DCHECK(data);
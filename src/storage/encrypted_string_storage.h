@@ -65,6 +65,41 @@ class EncryptedStringStorage : public StringStorageInterface {
   mutable mozc::Random random_;
 };
 
+// Chunked variant of EncryptedStringStorage: the payload is stored as a
+// sequence of independently encrypted chunks (one random IV per chunk, one
+// key salt in the file header), so data can be appended without touching
+// the existing chunks and Load decrypts chunk by chunk. Designed for the
+// incremental history journal, whose syncs append small deltas.
+//
+// Load returns the concatenation of all chunks. An append is not atomic;
+// a torn tail chunk (e.g. from a crash mid-append) is dropped with a
+// warning and everything before it is returned, which is the right degrade
+// for an incremental journal.
+class EncryptedChunkedStringStorage : public StringStorageInterface {
+ public:
+  explicit EncryptedChunkedStringStorage(const absl::string_view filename)
+      : filename_(filename) {}
+  EncryptedChunkedStringStorage(const EncryptedChunkedStringStorage &) =
+      delete;
+  EncryptedChunkedStringStorage &operator=(
+      const EncryptedChunkedStringStorage &) = delete;
+
+  bool Load(std::string *output) const override;
+
+  // Rewrites the whole container atomically (fresh salt). Save("") leaves a
+  // valid empty container.
+  bool Save(const std::string &input) const override;
+
+  // Appends |data| as new chunk(s) without rewriting the existing ones. If
+  // the file does not exist or has an unknown layout, an empty container is
+  // created first.
+  bool Append(absl::string_view data) const;
+
+ private:
+  std::string filename_;
+  mutable mozc::Random random_;
+};
+
 }  // namespace storage
 }  // namespace mozc
 
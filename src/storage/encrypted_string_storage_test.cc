@@ -102,6 +102,51 @@ TEST_F(EncryptedStringStorageTest, SaveAndLoad) {
   EXPECT_EQ(output, kData);
 }
 
+#ifndef __ANDROID__
+// The chunked variant calls the real encryptor, which is not available in
+// Android native tests (see TestEncryptedStringStorage above).
+TEST_F(EncryptedStringStorageTest, ChunkedSaveAppendLoad) {
+  const std::string chunked_filename = filename_ + ".chunked";
+  EncryptedChunkedStringStorage storage(chunked_filename);
+
+  // Whole-container save and load, including data spanning several chunks.
+  std::string large;
+  for (int i = 0; i < 3000; ++i) {
+    large += "0123456789";
+  }
+  ASSERT_TRUE(storage.Save(large));
+  std::string output;
+  ASSERT_TRUE(storage.Load(&output));
+  EXPECT_EQ(output, large);
+
+  // Appends add to the existing content without rewriting it.
+  ASSERT_TRUE(storage.Append("tail1"));
+  ASSERT_TRUE(storage.Append("tail2"));
+  ASSERT_TRUE(storage.Load(&output));
+  EXPECT_EQ(output, large + "tail1" + "tail2");
+
+  // Save("") resets to a valid empty container.
+  ASSERT_TRUE(storage.Save(""));
+  ASSERT_TRUE(storage.Load(&output));
+  EXPECT_TRUE(output.empty());
+
+  // Append to a missing file creates the container first.
+  ASSERT_OK(FileUtil::Unlink(chunked_filename));
+  ASSERT_TRUE(storage.Append("fresh"));
+  ASSERT_TRUE(storage.Load(&output));
+  EXPECT_EQ(output, "fresh");
+
+  // A torn tail (crash mid-append) drops only the tail chunk.
+  {
+    OutputFileStream ofs(chunked_filename,
+                         std::ios::out | std::ios::binary | std::ios::app);
+    ofs.write("torn", 4);
+  }
+  ASSERT_TRUE(storage.Load(&output));
+  EXPECT_EQ(output, "fresh");
+}
+#endif  // __ANDROID__
+
 #ifndef __ANDROID__
 // Note: On Android, we cannot check the behavior of Encryption because
 // it depends on the JVM's behavior, which cannot be launched from native test.
@@ -119,6 +119,16 @@ namespace {
 
 constexpr uint32_t kHeaderSize = 3;
 
+// Cache-line sized blocks of the blocked layout: 512 bits == 64 bytes.
+constexpr int kCacheBlockShift = 9;
+constexpr uint32_t kCacheBlockBits = 1 << kCacheBlockShift;
+constexpr uint32_t kCacheBlockMask = kCacheBlockBits - 1;
+
+// Flag bit stored in the num_hashes header word marking the blocked layout.
+// Classic images always store 0 < num_hashes < 8 there, so the bit doubles
+// as the runtime format detector.
+constexpr uint32_t kBlockedFormatFlag = 1u << 31;
+
 absl::StatusOr<ExistenceFilterParams> ReadHeader(
     absl::Span<const uint32_t> buf) {
   if (buf.size() < kHeaderSize) {
@@ -130,10 +140,17 @@ absl::StatusOr<ExistenceFilterParams> ReadHeader(
   ExistenceFilterParams params;
   params.size = *it++;
   params.expected_nelts = *it++;
-  params.num_hashes = *it++;
+  const uint32_t num_hashes_word = *it++;
+  params.blocked = (num_hashes_word & kBlockedFormatFlag) != 0;
+  params.num_hashes = num_hashes_word & ~kBlockedFormatFlag;
   if (params.num_hashes >= 8 || params.num_hashes <= 0) {
     return absl::InvalidArgumentError("Bad number of hashes (header.k)");
   }
+  if (params.blocked &&
+      (params.size == 0 || params.size % kCacheBlockBits != 0)) {
+    return absl::InvalidArgumentError(
+        "Blocked filter size must be a multiple of the cache block");
+  }
   return params;
 }
 
@@ -154,6 +171,22 @@ std::ostream& operator<<(std::ostream& os,
 }
 
 bool ExistenceFilter::Exists(uint64_t hash) const {
+  if (params_.blocked) {
+    // All probes fall into one 512-bit block chosen by the upper hash bits,
+    // so a query costs one cache miss instead of num_hashes.
+    const uint32_t num_blocks = params_.size >> kCacheBlockShift;
+    const uint32_t base =
+        (static_cast<uint32_t>(hash >> 32) % num_blocks) << kCacheBlockShift;
+    for (int i = 0; i < params_.num_hashes; ++i) {
+      hash = absl::rotl(hash, 8);
+      const uint32_t index =
+          base + (static_cast<uint32_t>(hash) & kCacheBlockMask);
+      if (!rep_.Get(index)) {
+        return false;
+      }
+    }
+    return true;
+  }
   for (int i = 0; i < params_.num_hashes; ++i) {
     hash = absl::rotl(hash, 8);
     const uint32_t index = hash % params_.size;
@@ -205,7 +238,30 @@ ExistenceFilterBuilder ExistenceFilterBuilder::CreateOptimal(
   return ExistenceFilterBuilder({m, n, optimal_k});
 }
 
+ExistenceFilterBuilder ExistenceFilterBuilder::CreateOptimalBlocked(
+    size_t size_in_bytes, uint32_t estimated_insertions) {
+  // Round the size up to whole cache blocks; the per-block layout otherwise
+  // shares the classic sizing.
+  const size_t rounded_bytes =
+      (size_in_bytes + (kCacheBlockBits / 8) - 1) / (kCacheBlockBits / 8) *
+      (kCacheBlockBits / 8);
+  ExistenceFilterBuilder builder =
+      CreateOptimal(rounded_bytes, estimated_insertions);
+  builder.params_.blocked = true;
+  return builder;
+}
+
 void ExistenceFilterBuilder::Insert(uint64_t hash) {
+  if (params_.blocked) {
+    const uint32_t num_blocks = params_.size >> kCacheBlockShift;
+    const uint32_t base =
+        (static_cast<uint32_t>(hash >> 32) % num_blocks) << kCacheBlockShift;
+    for (int i = 0; i < params_.num_hashes; ++i) {
+      hash = absl::rotl(hash, 8);
+      rep_.Set(base + (static_cast<uint32_t>(hash) & kCacheBlockMask));
+    }
+    return;
+  }
   for (int i = 0; i < params_.num_hashes; ++i) {
     hash = absl::rotl(hash, 8);
     const uint32_t index = hash % params_.size;
@@ -237,7 +293,10 @@ std::string ExistenceFilterBuilder::SerializeAsString() {
   // write header
   it = StoreUnaligned<uint32_t>(params_.size, it);
   it = StoreUnaligned<uint32_t>(params_.expected_nelts, it);
-  it = StoreUnaligned<uint32_t>(params_.num_hashes, it);
+  it = StoreUnaligned<uint32_t>(
+      static_cast<uint32_t>(params_.num_hashes) |
+          (params_.blocked ? kBlockedFormatFlag : 0),
+      it);
   // This method is called on data generation and we can call LOG(INFO) here.
   LOG(INFO) << "Header written: " << params_;
 
@@ -0,0 +1,384 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "storage/hash_file_storage.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "base/bits.h"
+#include "base/file_util.h"
+#include "base/hash.h"
+#include "base/logging.h"
+#include "base/mmap.h"
+#include "base/vlog.h"
+#include "storage/storage_interface.h"
+
+namespace mozc {
+namespace storage {
+namespace {
+
+constexpr uint32_t kStorageMagicId = 0x68736466;  // random seed
+constexpr uint32_t kStorageVersion = 0;
+
+// File header: magic, version, number of slots, reserved.
+constexpr size_t kFileHeaderSize = 16;
+
+// Slot layout (kSlotSize bytes, in-place updatable):
+//   uint64_t key fingerprint
+//   uint16_t key length
+//   uint16_t value length
+//   uint8_t  state (see below), 3 bytes padding
+//   char     payload[kSlotPayloadSize]: key bytes followed by value bytes
+constexpr size_t kSlotHeaderSize = 16;
+constexpr size_t kSlotPayloadSize = 112;
+constexpr size_t kSlotSize = kSlotHeaderSize + kSlotPayloadSize;
+
+constexpr uint8_t kSlotEmpty = 0;
+constexpr uint8_t kSlotOccupied = 1;
+constexpr uint8_t kSlotTombstone = 2;
+
+// Number of slots of a newly created file; the Registry holds at most a few
+// hundred records, so the 256KB file leaves ample headroom.
+constexpr uint32_t kDefaultNumSlots = 2048;
+
+// Upper bound accepted from a file header (128MB file), guarding the size
+// arithmetic against broken or hostile headers.
+constexpr uint32_t kMaxNumSlots = 1 << 20;
+
+// Occupied and tombstone slots together are capped below the capacity so
+// that probe chains always terminate at an empty slot; crossing the cap
+// triggers an in-place compaction that drops the tombstones.
+constexpr uint32_t MaxUsedSlots(uint32_t num_slots) {
+  return num_slots / 8 * 7;
+}
+
+uint64_t SlotFingerprint(const char *slot) {
+  return LoadUnaligned<uint64_t>(slot);
+}
+uint16_t SlotKeyLength(const char *slot) {
+  return LoadUnaligned<uint16_t>(slot + 8);
+}
+uint16_t SlotValueLength(const char *slot) {
+  return LoadUnaligned<uint16_t>(slot + 10);
+}
+uint8_t SlotState(const char *slot) { return slot[12]; }
+const char *SlotPayload(const char *slot) { return slot + kSlotHeaderSize; }
+char *MutableSlotPayload(char *slot) { return slot + kSlotHeaderSize; }
+
+absl::string_view SlotKey(const char *slot) {
+  return absl::string_view(SlotPayload(slot), SlotKeyLength(slot));
+}
+absl::string_view SlotValue(const char *slot) {
+  return absl::string_view(SlotPayload(slot) + SlotKeyLength(slot),
+                           SlotValueLength(slot));
+}
+
+class HashFileStorageImpl : public StorageInterface {
+ public:
+  HashFileStorageImpl() = default;
+  HashFileStorageImpl(const HashFileStorageImpl &) = delete;
+  HashFileStorageImpl &operator=(const HashFileStorageImpl &) = delete;
+  ~HashFileStorageImpl() override = default;
+
+  bool Open(const std::string &filename) override;
+
+  // All mutations are applied to the shared mapping in place, so they reach
+  // the page cache immediately and the kernel persists them incrementally;
+  // there is no buffered state left to flush.
+  bool Sync() override { return true; }
+
+  bool Lookup(const std::string &key, std::string *value) const override;
+  bool Insert(const std::string &key, const std::string &value) override;
+  bool Erase(const std::string &key) override;
+  bool Clear() override;
+  size_t Size() const override { return size_; }
+
+ private:
+  char *SlotAt(uint32_t index) const {
+    return const_cast<char *>(mmap_.data()) + kFileHeaderSize +
+           index * kSlotSize;
+  }
+
+  // Returns the slot holding |key|, or nullptr. When |free_slot| is given,
+  // it receives the first reusable (empty or tombstone) slot on the probe
+  // path, or nullptr if the key was found first.
+  char *FindSlot(absl::string_view key, char **free_slot) const;
+
+  // Creates an empty storage file and maps it.
+  bool CreateAndMap();
+
+  // Drops all tombstones by reinserting the live entries in place.
+  void Compact();
+
+  std::string filename_;
+  Mmap mmap_;
+  uint32_t num_slots_ = 0;
+  size_t size_ = 0;  // occupied slots
+  size_t used_ = 0;  // occupied + tombstone slots
+};
+
+bool HashFileStorageImpl::Open(const std::string &filename) {
+  filename_ = filename;
+  mmap_.Close();
+  num_slots_ = 0;
+  size_ = 0;
+  used_ = 0;
+
+  bool valid = false;
+  if (absl::StatusOr<Mmap> mmap = Mmap::Map(filename_, Mmap::READ_WRITE);
+      mmap.ok()) {
+    mmap_ = *std::move(mmap);
+    if (mmap_.size() >= kFileHeaderSize &&
+        LoadUnaligned<uint32_t>(mmap_.data()) == kStorageMagicId &&
+        LoadUnaligned<uint32_t>(mmap_.data() + 4) == kStorageVersion) {
+      num_slots_ = LoadUnaligned<uint32_t>(mmap_.data() + 8);
+      valid = num_slots_ > 0 && num_slots_ <= kMaxNumSlots &&
+              mmap_.size() == kFileHeaderSize + num_slots_ * kSlotSize;
+    }
+  }
+  if (!valid) {
+    MOZC_VLOG(1) << "Creating a new hash file storage: " << filename_;
+    if (!CreateAndMap()) {
+      LOG(ERROR) << "Cannot create " << filename_;
+      mmap_.Close();
+      return false;
+    }
+  }
+
+  // Count the entries; a slot broken by a torn write is dropped here.
+  for (uint32_t i = 0; i < num_slots_; ++i) {
+    char *slot = SlotAt(i);
+    switch (SlotState(slot)) {
+      case kSlotOccupied:
+        if (SlotKeyLength(slot) + SlotValueLength(slot) > kSlotPayloadSize) {
+          LOG(WARNING) << "Dropping a broken slot: " << i;
+          std::fill_n(slot, kSlotSize, 0);
+          continue;
+        }
+        ++size_;
+        ++used_;
+        break;
+      case kSlotTombstone:
+        ++used_;
+        break;
+      case kSlotEmpty:
+        break;
+      default:
+        // Unknown state, e.g. from a torn write; drop the slot so that the
+        // probe loops only ever see the three known states.
+        LOG(WARNING) << "Dropping a slot with unknown state: " << i;
+        std::fill_n(slot, kSlotSize, 0);
+        break;
+    }
+  }
+  return true;
+}
+
+bool HashFileStorageImpl::CreateAndMap() {
+  std::string image(kFileHeaderSize + kDefaultNumSlots * kSlotSize, '\0');
+  StoreUnaligned<uint32_t>(kStorageMagicId, image.data());
+  StoreUnaligned<uint32_t>(kStorageVersion, image.data() + 4);
+  StoreUnaligned<uint32_t>(kDefaultNumSlots, image.data() + 8);
+  if (absl::Status s = FileUtil::SetContents(filename_, image); !s.ok()) {
+    LOG(ERROR) << "Cannot write " << filename_ << ": " << s;
+    return false;
+  }
+  absl::StatusOr<Mmap> mmap = Mmap::Map(filename_, Mmap::READ_WRITE);
+  if (!mmap.ok()) {
+    LOG(ERROR) << "Cannot map " << filename_ << ": " << mmap.status();
+    return false;
+  }
+  mmap_ = *std::move(mmap);
+  num_slots_ = kDefaultNumSlots;
+  return true;
+}
+
+char *HashFileStorageImpl::FindSlot(const absl::string_view key,
+                                    char **free_slot) const {
+  if (free_slot != nullptr) {
+    *free_slot = nullptr;
+  }
+  const uint64_t fp = Fingerprint(key);
+  uint32_t index = fp % num_slots_;
+  for (uint32_t probes = 0; probes < num_slots_;
+       ++probes, index = (index + 1 == num_slots_) ? 0 : index + 1) {
+    char *slot = SlotAt(index);
+    switch (SlotState(slot)) {
+      case kSlotEmpty:
+        if (free_slot != nullptr && *free_slot == nullptr) {
+          *free_slot = slot;
+        }
+        return nullptr;
+      case kSlotTombstone:
+        if (free_slot != nullptr && *free_slot == nullptr) {
+          *free_slot = slot;
+        }
+        break;
+      case kSlotOccupied:
+        if (SlotFingerprint(slot) == fp && SlotKey(slot) == key) {
+          return slot;
+        }
+        break;
+      default:
+        // Cannot happen: Open drops slots with unknown states. Treat like a
+        // tombstone so the probe still terminates at an empty slot.
+        if (free_slot != nullptr && *free_slot == nullptr) {
+          *free_slot = slot;
+        }
+        break;
+    }
+  }
+  return nullptr;
+}
+
+bool HashFileStorageImpl::Lookup(const std::string &key,
+                                 std::string *value) const {
+  if (mmap_.empty()) {
+    return false;
+  }
+  const char *slot = FindSlot(key, nullptr);
+  if (slot == nullptr) {
+    return false;
+  }
+  const absl::string_view stored = SlotValue(slot);
+  value->assign(stored.data(), stored.size());
+  return true;
+}
+
+bool HashFileStorageImpl::Insert(const std::string &key,
+                                 const std::string &value) {
+  if (mmap_.empty()) {
+    return false;
+  }
+  if (key.size() + value.size() > kSlotPayloadSize) {
+    LOG(ERROR) << "Entry does not fit in a slot: key=" << key.size()
+               << " value=" << value.size() << " bytes";
+    return false;
+  }
+  char *free_slot = nullptr;
+  if (char *slot = FindSlot(key, &free_slot); slot != nullptr) {
+    // In-place update: the key bytes stay, only the value part changes.
+    StoreUnaligned<uint16_t>(static_cast<uint16_t>(value.size()), slot + 10);
+    std::copy_n(value.data(), value.size(),
+                MutableSlotPayload(slot) + key.size());
+    return true;
+  }
+  if (used_ >= MaxUsedSlots(num_slots_)) {
+    Compact();
+    free_slot = nullptr;
+    FindSlot(key, &free_slot);
+    if (free_slot == nullptr || size_ >= MaxUsedSlots(num_slots_)) {
+      LOG(ERROR) << "Storage is full: " << size_ << " entries";
+      return false;
+    }
+  }
+  DCHECK(free_slot != nullptr);
+  const bool reused_tombstone = SlotState(free_slot) == kSlotTombstone;
+  StoreUnaligned<uint64_t>(Fingerprint(key), free_slot);
+  StoreUnaligned<uint16_t>(static_cast<uint16_t>(key.size()), free_slot + 8);
+  StoreUnaligned<uint16_t>(static_cast<uint16_t>(value.size()),
+                           free_slot + 10);
+  char *payload = MutableSlotPayload(free_slot);
+  std::copy_n(key.data(), key.size(), payload);
+  std::copy_n(value.data(), value.size(), payload + key.size());
+  free_slot[12] = kSlotOccupied;
+  ++size_;
+  if (!reused_tombstone) {
+    ++used_;
+  }
+  return true;
+}
+
+bool HashFileStorageImpl::Erase(const std::string &key) {
+  if (mmap_.empty()) {
+    return false;
+  }
+  char *slot = FindSlot(key, nullptr);
+  if (slot == nullptr) {
+    return false;
+  }
+  slot[12] = kSlotTombstone;
+  --size_;
+  return true;
+}
+
+void HashFileStorageImpl::Compact() {
+  std::vector<std::pair<std::string, std::string>> entries;
+  entries.reserve(size_);
+  for (uint32_t i = 0; i < num_slots_; ++i) {
+    const char *slot = SlotAt(i);
+    if (SlotState(slot) == kSlotOccupied) {
+      entries.emplace_back(SlotKey(slot), SlotValue(slot));
+    }
+  }
+  std::fill_n(SlotAt(0), num_slots_ * kSlotSize, 0);
+  size_ = 0;
+  used_ = 0;
+  for (const auto &[key, value] : entries) {
+    Insert(key, value);
+  }
+}
+
+bool HashFileStorageImpl::Clear() {
+  if (mmap_.empty()) {
+    return false;
+  }
+  std::fill_n(SlotAt(0), num_slots_ * kSlotSize, 0);
+  size_ = 0;
+  used_ = 0;
+  return true;
+}
+
+}  // namespace
+
+std::unique_ptr<StorageInterface> HashFileStorage::New() {
+  return std::make_unique<HashFileStorageImpl>();
+}
+
+std::unique_ptr<StorageInterface> HashFileStorage::Create(
+    const std::string &filename) {
+  auto storage = std::make_unique<HashFileStorageImpl>();
+  if (!storage->Open(filename)) {
+    LOG(ERROR) << "cannot open " << filename;
+    return nullptr;
+  }
+  return storage;
+}
+
+}  // namespace storage
+}  // namespace mozc
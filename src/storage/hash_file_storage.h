@@ -0,0 +1,67 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZC_STORAGE_HASH_FILE_STORAGE_H_
+#define MOZC_STORAGE_HASH_FILE_STORAGE_H_
+
+#include <memory>
+#include <string>
+
+#include "storage/storage_interface.h"
+
+namespace mozc {
+namespace storage {
+
+// Mmap-backed key/value storage with a fixed-capacity open-addressing hash
+// table layout.
+//
+// Unlike TinyStorage, which rewrites the whole file on every Sync and parses
+// it fully at Open, this backend maps the table read/write and updates slots
+// in place, so the kernel persists dirty pages incrementally and Sync is a
+// no-op. Use it for small records that are updated frequently, e.g. the
+// Registry's usage counters written on every session close.
+//
+// Limits: an entry's key and value must fit together in one slot payload
+// (see kSlotPayloadSize in the .cc); larger inserts are rejected. A file
+// with an unknown or broken layout is recreated empty.
+class HashFileStorage {
+ public:
+  HashFileStorage() = delete;
+  HashFileStorage(const HashFileStorage &) = delete;
+  HashFileStorage &operator=(const HashFileStorage &) = delete;
+  // Returns an implementation of StorageInterface.
+  // Caller must take ownership of the returned object.
+  static std::unique_ptr<StorageInterface> New();
+  static std::unique_ptr<StorageInterface> Create(const std::string &filename);
+};
+
+}  // namespace storage
+}  // namespace mozc
+
+#endif  // MOZC_STORAGE_HASH_FILE_STORAGE_H_
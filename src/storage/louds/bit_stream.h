@@ -49,6 +49,11 @@ class BitStream {
   size_t num_bits() const { return num_bits_; }
   size_t ByteSize() const { return image_.length(); }
 
+  // Reserves room for |num_bits| bits (plus the 32-bit alignment padding),
+  // so a pre-sized stream is allocated exactly once instead of growing
+  // amortizedly while bits are pushed.
+  void Reserve(size_t num_bits) { image_.reserve((num_bits + 7) / 8 + 4); }
+
   void PushBit(int bit);
 
   // Fills the padding (0-bit) until the size is aligned to 32-bit boundary.
@@ -47,7 +47,8 @@ constexpr size_t kLb1CacheSize = 0;
 
 }  // namespace
 
-void BitVectorBasedArray::Open(const uint8_t *image) {
+void BitVectorBasedArray::Open(const uint8_t *image,
+                               bool build_offset_directory) {
   const int index_length = LoadUnalignedAdvance<uint32_t>(image);
   const int base_length = LoadUnalignedAdvance<uint32_t>(image);
   const int step_length = LoadUnalignedAdvance<uint32_t>(image);
@@ -58,6 +59,27 @@ void BitVectorBasedArray::Open(const uint8_t *image) {
   base_length_ = base_length;
   step_length_ = step_length;
   data_ = reinterpret_cast<const char *>(image + index_length);
+
+  if (build_offset_directory) {
+    // One linear pass over the bit vector reproduces exactly the offsets Get
+    // computes via select/rank: each 0-bit starts an element (+base_length_),
+    // each following 1-bit extends it (+step_length_). Trailing padding
+    // zeros only append unreachable entries whose first one serves as the
+    // end sentinel of the last real element.
+    const int num_bits = index_.GetNum0Bits() + index_.GetNum1Bits();
+    offset_directory_.clear();
+    offset_directory_.reserve(index_.GetNum0Bits() + 1);
+    uint32_t offset = 0;
+    for (int i = 0; i < num_bits; ++i) {
+      if (index_.Get(i) == 0) {
+        offset_directory_.push_back(offset);
+        offset += base_length_;
+      } else {
+        offset += step_length_;
+      }
+    }
+    offset_directory_.push_back(offset);
+  }
 }
 
 void BitVectorBasedArray::Close() {
@@ -65,10 +87,16 @@ void BitVectorBasedArray::Close() {
   base_length_ = 0;
   step_length_ = 0;
   data_ = nullptr;
+  offset_directory_.clear();
 }
 
 const char *BitVectorBasedArray::Get(size_t index, size_t *length) const {
   DCHECK(length);
+  if (!offset_directory_.empty()) {
+    DCHECK_LT(index + 1, offset_directory_.size());
+    *length = offset_directory_[index + 1] - offset_directory_[index];
+    return data_ + offset_directory_[index];
+  }
   const int bit_index = index_.Select0(index + 1);
   const int data_index =
       base_length_ * index + step_length_ * index_.Rank1(bit_index);
@@ -82,4 +82,38 @@ TEST_F(BitVectorBasedArrayTest, Get) {
 
   array.Close();
 }
+
+TEST_F(BitVectorBasedArrayTest, GetWithOffsetDirectory) {
+  const char *kElements[] = {
+      "",     "a",        "abcdefg", "mozc", "google-japanese-input",
+      "abcd", "testdata",
+  };
+
+  BitVectorBasedArrayBuilder builder;
+  for (const char *element : kElements) {
+    builder.Add(element);
+  }
+  builder.SetSize(4, 2);
+  builder.Build();
+
+  // The directory-backed lookup must return byte-identical results to the
+  // rank/select path.
+  BitVectorBasedArray array;
+  array.Open(reinterpret_cast<const uint8_t *>(builder.image().data()));
+  BitVectorBasedArray array_with_directory;
+  array_with_directory.Open(
+      reinterpret_cast<const uint8_t *>(builder.image().data()), true);
+  for (size_t i = 0; i < std::size(kElements); ++i) {
+    size_t length;
+    const char *result = array.Get(i, &length);
+    size_t directory_length;
+    const char *directory_result =
+        array_with_directory.Get(i, &directory_length);
+    EXPECT_EQ(directory_result, result) << i;
+    EXPECT_EQ(directory_length, length) << i;
+  }
+
+  array.Close();
+  array_with_directory.Close();
+}
 }  // namespace
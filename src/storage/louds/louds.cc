@@ -29,17 +29,31 @@
 
 #include "storage/louds/louds.h"
 
+#include <atomic>
 #include <cstdint>
 
+#include "absl/numeric/bits.h"
+
 namespace mozc {
 namespace storage {
 namespace louds {
 
 void Louds::Init(const uint8_t *image, int length, size_t bitvec_lb0_cache_size,
                  size_t bitvec_lb1_cache_size, size_t select0_cache_size,
-                 size_t select1_cache_size) {
+                 size_t select1_cache_size, size_t hot_node_cache_size,
+                 int bitvec_chunk_size) {
+  index_.set_chunk_size(bitvec_chunk_size);
   index_.Init(image, length, bitvec_lb0_cache_size, bitvec_lb1_cache_size);
 
+  if (hot_node_cache_size > 0) {
+    const size_t num_slots = absl::bit_floor(hot_node_cache_size);
+    hot_node_cache_mask_ = static_cast<uint32_t>(num_slots - 1);
+    hot_node_cache_.reset(new std::atomic<uint64_t>[num_slots]);
+    for (size_t i = 0; i < num_slots; ++i) {
+      hot_node_cache_[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
   // Cap the cache sizes.
   if (select0_cache_size > index_.GetNum0Bits()) {
     select0_cache_size = index_.GetNum0Bits();
@@ -84,6 +98,10 @@ void Louds::Reset() {
   select_cache_.reset();
   select0_cache_size_ = 0;
   select1_cache_size_ = 0;
+  hot_node_cache_.reset();
+  hot_node_cache_mask_ = 0;
+  hot_cache_lookups_.store(0, std::memory_order_relaxed);
+  hot_cache_hits_.store(0, std::memory_order_relaxed);
 }
 
 }  // namespace louds
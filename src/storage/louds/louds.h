@@ -30,6 +30,7 @@
 #ifndef MOZC_STORAGE_LOUDS_LOUDS_H_
 #define MOZC_STORAGE_LOUDS_LOUDS_H_
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -82,6 +83,12 @@ class Louds {
     friend class Louds;
   };
 
+  // Hit statistics of the hot node cache; see Init.
+  struct CacheStats {
+    uint64_t lookups = 0;
+    uint64_t hits = 0;
+  };
+
   Louds() = default;
   Louds(const Louds &) = delete;
   Louds &operator=(const Louds &) = delete;
@@ -92,9 +99,28 @@ class Louds {
   // and |select0_cache_size| to larger values.  On the other hand, to improve
   // the performance of upward traversal (i.e., from leaves to the root), set
   // |bitvec_lb1_cache_size| and |select1_cache_size| to larger values.
+  //
+  // |hot_node_cache_size| (rounded down to a power of two; 0 disables it)
+  // additionally enables a direct-mapped cache of Select0 results for node
+  // ids beyond the contiguous |select0_cache_size| prefix.  Mid-level trie
+  // nodes are too numerous for the prefix cache but highly skewed in access
+  // frequency, so this cache adapts to the hot set at runtime; use
+  // GetHotNodeCacheStats to measure hit rates per data set.
+  // |bitvec_chunk_size| overrides the rank chunk size of the underlying bit
+  // vector (power of 2 bytes); larger chunks shrink the rank index at the
+  // cost of slower Rank1 scans.
   void Init(const uint8_t *image, int length, size_t bitvec_lb0_cache_size,
             size_t bitvec_lb1_cache_size, size_t select0_cache_size,
-            size_t select1_cache_size);
+            size_t select1_cache_size, size_t hot_node_cache_size = 0,
+            int bitvec_chunk_size = 32);
+
+  // Returns the accumulated lookup/hit counts of the hot node cache.
+  CacheStats GetHotNodeCacheStats() const {
+    CacheStats stats;
+    stats.lookups = hot_cache_lookups_.load(std::memory_order_relaxed);
+    stats.hits = hot_cache_hits_.load(std::memory_order_relaxed);
+    return stats;
+  }
 
   // Explicitly clears the internal bit array.
   void Reset();
@@ -121,9 +147,13 @@ class Louds {
   //   * node 4 -> invalid node
   // REQUIRES: |node| is valid.
   void MoveToFirstChild(Node *node) const {
-    node->edge_index_ = node->node_id_ < select0_cache_size_
-                            ? select_cache_[node->node_id_]
-                            : index_.Select0(node->node_id_) + 1;
+    if (node->node_id_ < select0_cache_size_) {
+      node->edge_index_ = select_cache_[node->node_id_];
+    } else if (hot_node_cache_ != nullptr) {
+      node->edge_index_ = LookupHotEdgeIndex(node->node_id_);
+    } else {
+      node->edge_index_ = index_.Select0(node->node_id_) + 1;
+    }
     node->node_id_ = node->edge_index_ - node->node_id_ + 1;
   }
 
@@ -158,11 +188,37 @@ class Louds {
   }
 
  private:
+  // Resolves Select0(node_id) + 1 through the direct-mapped hot node cache.
+  // Each slot packs (node_id << 32) | (edge_index + 1) in a single atomic, so
+  // concurrent readers are lock-free; racing fills of the same node id store
+  // identical values.  Node id 0 never occurs (the root is 1), so zeroed
+  // slots are empty.
+  int LookupHotEdgeIndex(int node_id) const {
+    hot_cache_lookups_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic<uint64_t> &slot =
+        hot_node_cache_[static_cast<uint32_t>(node_id) & hot_node_cache_mask_];
+    const uint64_t packed = slot.load(std::memory_order_relaxed);
+    if (static_cast<uint32_t>(packed >> 32) ==
+        static_cast<uint32_t>(node_id)) {
+      hot_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+      return static_cast<int>(static_cast<uint32_t>(packed));
+    }
+    const int edge_index = index_.Select0(node_id) + 1;
+    slot.store((static_cast<uint64_t>(static_cast<uint32_t>(node_id)) << 32) |
+                   static_cast<uint32_t>(edge_index),
+               std::memory_order_relaxed);
+    return edge_index;
+  }
+
   SimpleSuccinctBitVectorIndex index_;
   size_t select0_cache_size_ = 0;
   size_t select1_cache_size_ = 0;
   std::unique_ptr<int[]> select_cache_;
   int *select1_cache_ptr_;  // = select_cache_.get() + select0_cache_size_
+  uint32_t hot_node_cache_mask_ = 0;
+  std::unique_ptr<std::atomic<uint64_t>[]> hot_node_cache_;
+  mutable std::atomic<uint64_t> hot_cache_lookups_{0};
+  mutable std::atomic<uint64_t> hot_cache_hits_{0};
 };
 
 }  // namespace louds
@@ -87,16 +87,19 @@ std::vector<uint8_t> MakeSequence(absl::string_view s) {
   } while (false)
 
 struct CacheSizeParam {
-  CacheSizeParam(size_t lb0, size_t lb1, size_t s0, size_t s1)
+  CacheSizeParam(size_t lb0, size_t lb1, size_t s0, size_t s1,
+                 size_t hot_nodes = 0)
       : bitvec_lb0_cache_size(lb0),
         bitvec_lb1_cache_size(lb1),
         select0_cache_size(s0),
-        select1_cache_size(s1) {}
+        select1_cache_size(s1),
+        hot_node_cache_size(hot_nodes) {}
 
   size_t bitvec_lb0_cache_size;
   size_t bitvec_lb1_cache_size;
   size_t select0_cache_size;
   size_t select1_cache_size;
+  size_t hot_node_cache_size;
 };
 
 class LoudsTest : public ::testing::TestWithParam<CacheSizeParam> {};
@@ -109,7 +112,7 @@ TEST_P(LoudsTest, Basic) {
   Louds louds;
   louds.Init(kSeq.data(), kSeq.size(), param.bitvec_lb0_cache_size,
              param.bitvec_lb1_cache_size, param.select0_cache_size,
-             param.select1_cache_size);
+             param.select1_cache_size, param.hot_node_cache_size);
 
   // root -> 2 -> 3 -> 4 -> 5
   {
@@ -163,7 +166,10 @@ INSTANTIATE_TEST_SUITE_P(
                       CacheSizeParam(1, 1, 0, 0), CacheSizeParam(1, 1, 0, 1),
                       CacheSizeParam(1, 1, 1, 0), CacheSizeParam(1, 1, 1, 1),
                       CacheSizeParam(2, 2, 2, 2), CacheSizeParam(8, 8, 8, 8),
-                      CacheSizeParam(1024, 1024, 1024, 1024)));
+                      CacheSizeParam(1024, 1024, 1024, 1024),
+                      CacheSizeParam(0, 0, 0, 0, 4),
+                      CacheSizeParam(1, 1, 1, 1, 16),
+                      CacheSizeParam(1024, 1024, 1024, 1024, 1024)));
 
 }  // namespace
 }  // namespace louds
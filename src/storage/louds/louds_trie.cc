@@ -46,7 +46,8 @@ bool LoudsTrie::Open(const uint8_t *image, size_t louds_lb0_cache_size,
                      size_t louds_lb1_cache_size,
                      size_t louds_select0_cache_size,
                      size_t louds_select1_cache_size,
-                     size_t termvec_lb1_cache_size) {
+                     size_t termvec_lb1_cache_size,
+                     size_t louds_hot_node_cache_size, int bitvec_chunk_size) {
   // Reads a binary image data, which is compatible with rx.
   // The format is as follows:
   // [trie size: little endian 4byte int]
@@ -82,7 +83,9 @@ bool LoudsTrie::Open(const uint8_t *image, size_t louds_lb0_cache_size,
 
   louds_.Init(louds_image, louds_size, louds_lb0_cache_size,
               louds_lb1_cache_size, louds_select0_cache_size,
-              louds_select1_cache_size);
+              louds_select1_cache_size, louds_hot_node_cache_size,
+              bitvec_chunk_size);
+  terminal_bit_vector_.set_chunk_size(bitvec_chunk_size);
   terminal_bit_vector_.Init(terminal_image, terminal_size,
                             0,  // Select0 is not carried out.
                             termvec_lb1_cache_size);
@@ -59,12 +59,23 @@ class LoudsTrie {
   // terminal bit vector.  This class doesn't own the "data", so it is caller's
   // responsibility to keep the data alive until Close is invoked.  See .cc file
   // for the detailed format of the binary image.
+  // |louds_hot_node_cache_size| additionally enables the adaptive hot node
+  // cache of the underlying LOUDS; see Louds::Init.
+  // |bitvec_chunk_size| overrides the rank chunk size of the LOUDS and
+  // terminal bit vectors; see Louds::Init.
   bool Open(const uint8_t *image, size_t louds_lb0_cache_size,
             size_t louds_lb1_cache_size, size_t louds_select0_cache_size,
-            size_t louds_select1_cache_size, size_t termvec_lb1_cache_size);
+            size_t louds_select1_cache_size, size_t termvec_lb1_cache_size,
+            size_t louds_hot_node_cache_size = 0, int bitvec_chunk_size = 32);
 
   bool Open(const uint8_t *data) { return Open(data, 0, 0, 0, 0, 0); }
 
+  // Returns the hit statistics of the adaptive hot node cache (all zero
+  // unless it is enabled in Open); for tuning cache sizes per data set.
+  Louds::CacheStats GetHotNodeCacheStats() const {
+    return louds_.GetHotNodeCacheStats();
+  }
+
   // Destructs the internal data structure explicitly (the destructor will do
   // clean up too).
   void Close();
@@ -35,7 +35,9 @@
 #include <string>
 #include <vector>
 
+#include "absl/strings/string_view.h"
 #include "base/logging.h"
+#include "base/thread.h"
 #include "storage/louds/bit_stream.h"
 
 namespace mozc {
@@ -71,6 +73,68 @@ class EntryLengthLessThan {
   size_t length_;
 };
 
+// Lists below this size are sorted on the calling thread; runtime rebuilds
+// of user-dictionary-derived tries are typically this small, and thread
+// fan-out would only add overhead there.
+constexpr size_t kParallelSortThreshold = 1 << 16;
+constexpr size_t kSortChunks = 8;
+
+// Sorts |words|: large lists are split into equal chunks sorted on worker
+// threads and merged pairwise in parallel rounds, giving the same order as
+// std::sort.
+void SortWords(std::vector<std::string> &words) {
+  if (words.size() < kParallelSortThreshold) {
+    std::sort(words.begin(), words.end());
+    return;
+  }
+
+  std::vector<size_t> bounds = {0};
+  const size_t chunk_size = (words.size() + kSortChunks - 1) / kSortChunks;
+  while (bounds.back() < words.size()) {
+    bounds.push_back(std::min(bounds.back() + chunk_size, words.size()));
+  }
+  const size_t num_chunks = bounds.size() - 1;
+  {
+    std::vector<Thread> workers;
+    workers.reserve(num_chunks);
+    for (size_t i = 0; i < num_chunks; ++i) {
+      workers.emplace_back([&words, begin = bounds[i], end = bounds[i + 1]] {
+        std::sort(words.begin() + begin, words.begin() + end);
+      });
+    }
+    for (Thread &worker : workers) {
+      worker.Join();
+    }
+  }
+  // Pairwise merge rounds; the merges of one round touch disjoint ranges.
+  for (size_t width = 1; width < num_chunks; width *= 2) {
+    std::vector<Thread> workers;
+    for (size_t i = 0; i + width < num_chunks; i += 2 * width) {
+      const size_t begin = bounds[i];
+      const size_t middle = bounds[i + width];
+      const size_t end = bounds[std::min(i + 2 * width, num_chunks)];
+      workers.emplace_back([&words, begin, middle, end] {
+        std::inplace_merge(words.begin() + begin, words.begin() + middle,
+                           words.begin() + end);
+      });
+    }
+    for (Thread &worker : workers) {
+      worker.Join();
+    }
+  }
+}
+
+// Length of the common prefix of two words.
+size_t CommonPrefixLength(const absl::string_view lhs,
+                          const absl::string_view rhs) {
+  const size_t limit = std::min(lhs.size(), rhs.size());
+  size_t length = 0;
+  while (length < limit && lhs[length] == rhs[length]) {
+    ++length;
+  }
+  return length;
+}
+
 }  // namespace
 
 void LoudsTrieBuilder::Add(const std::string &word) {
@@ -83,7 +147,7 @@ void LoudsTrieBuilder::Build() {
   CHECK(!built_);
 
   // Initialize for the build. Sort and de-dup the words.
-  std::sort(word_list_.begin(), word_list_.end());
+  SortWords(word_list_);
   word_list_.erase(std::unique(word_list_.begin(), word_list_.end()),
                    word_list_.end());
   std::vector<Entry> entry_list;
@@ -93,10 +157,24 @@ void LoudsTrieBuilder::Build() {
   }
   id_list_.resize(word_list_.size(), -1);
 
-  // Output the tree to streams.
+  // One linear prefix-comparison pass sizes every output stream exactly:
+  // each distinct prefix in the sorted list becomes one node, and a node
+  // costs one edge bit, one stop bit, one terminal bit and one edge
+  // character; the root adds its "10" prologue, terminal bit and character.
+  size_t num_nodes = 1;  // the root
+  for (size_t i = 0; i < word_list_.size(); ++i) {
+    const size_t common_prefix_length =
+        i == 0 ? 0 : CommonPrefixLength(word_list_[i - 1], word_list_[i]);
+    num_nodes += word_list_[i].size() - common_prefix_length;
+  }
+
+  // Output the tree to streams, each allocated exactly once.
   BitStream trie_stream;
   BitStream terminal_stream;
   std::string edge_character;
+  trie_stream.Reserve(2 * num_nodes + 1);
+  terminal_stream.Reserve(num_nodes);
+  edge_character.reserve(num_nodes);
 
   // Push root.
   trie_stream.PushBit(1);
@@ -53,9 +53,8 @@ class ZeroBitIndexIterator {
   using reference = const int &;
   using iterator_category = std::forward_iterator_tag;
 
-  ZeroBitIndexIterator(const std::vector<int> &index, int chunk_size,
-                       const int *ptr)
-      : data_{index.data()}, chunk_size_{chunk_size}, ptr_{ptr} {}
+  ZeroBitIndexIterator(const int *index, int chunk_size, const int *ptr)
+      : data_{index}, chunk_size_{chunk_size}, ptr_{ptr} {}
 
   const int *ptr() const { return ptr_; }
 
@@ -87,10 +86,41 @@ inline int BitCount0(uint32_t x) {
   return absl::popcount(~x);
 }
 
-// Returns 1-bits in the data to length words.
+// Returns the index (0-origin, from the LSB) of the n-th (1-origin) 1-bit of
+// x. x must contain at least n 1-bits. Halves the word by popcount instead of
+// shifting bit by bit, so only the last byte is scanned linearly.
+inline int SelectBitInWord(uint32_t x, int n) {
+  DCHECK_GT(n, 0);
+  int index = 0;
+  const int count = absl::popcount(x & 0xFFFF);
+  if (count < n) {
+    n -= count;
+    index += 16;
+    x >>= 16;
+  }
+  const int byte_count = absl::popcount(x & 0xFF);
+  if (byte_count < n) {
+    n -= byte_count;
+    index += 8;
+    x >>= 8;
+  }
+  for (;; x >>= 1, ++index) {
+    n -= (x & 1);
+    if (n == 0) {
+      return index;
+    }
+  }
+}
+
+// Returns 1-bits in the data to length words. Counts in 64-bit strides where
+// possible; absl::popcount compiles down to POPCNT/CNT when the target
+// allows, so this is the widest portable stride.
 int Count1Bits(const uint8_t *data, int length) {
   int num_bits = 0;
-  for (; length > 0; --length) {
+  for (; length >= 2; length -= 2) {
+    num_bits += absl::popcount(LoadUnalignedAdvance<uint64_t>(data));
+  }
+  if (length > 0) {
     num_bits += absl::popcount(LoadUnalignedAdvance<uint32_t>(data));
   }
   return num_bits;
@@ -122,40 +152,39 @@ void InitIndex(const uint8_t *data, int length, int chunk_size,
   CHECK_EQ(chunk_length + 1, index->size());
 }
 
-void InitLowerBound0Cache(const std::vector<int> &index, int chunk_size,
+void InitLowerBound0Cache(const int *index, size_t index_size, int chunk_size,
                           size_t increment, size_t size,
                           std::vector<const int *> *cache) {
   DCHECK_GT(increment, 0);
   cache->clear();
   cache->reserve(size + 2);
-  cache->push_back(index.data());
+  cache->push_back(index);
   for (size_t i = 1; i <= size; ++i) {
     const int target_index = increment * i;
     const int *ptr =
-        std::lower_bound(ZeroBitIndexIterator(index, chunk_size, index.data()),
+        std::lower_bound(ZeroBitIndexIterator(index, chunk_size, index),
                          ZeroBitIndexIterator(index, chunk_size,
-                                              index.data() + index.size()),
+                                              index + index_size),
                          target_index)
             .ptr();
     cache->push_back(ptr);
   }
-  cache->push_back(index.data() + index.size());
+  cache->push_back(index + index_size);
 }
 
-void InitLowerBound1Cache(const std::vector<int> &index, int chunk_size,
+void InitLowerBound1Cache(const int *index, size_t index_size, int chunk_size,
                           size_t increment, size_t size,
                           std::vector<const int *> *cache) {
   DCHECK_GT(increment, 0);
   cache->clear();
   cache->reserve(size + 2);
-  cache->push_back(index.data());
+  cache->push_back(index);
   for (size_t i = 1; i <= size; ++i) {
     const int target_index = increment * i;
-    const int *ptr = std::lower_bound(index.data(), index.data() + index.size(),
-                                      target_index);
+    const int *ptr = std::lower_bound(index, index + index_size, target_index);
     cache->push_back(ptr);
   }
-  cache->push_back(index.data() + index.size());
+  cache->push_back(index + index_size);
 }
 
 }  // namespace
@@ -165,8 +194,28 @@ void SimpleSuccinctBitVectorIndex::Init(const uint8_t *data, int length,
                                         size_t lb1_cache_size) {
   data_ = data;
   length_ = length;
-  InitIndex(data, length, chunk_size_, &index_);
+  InitIndex(data, length, chunk_size_, &index_storage_);
+  index_ = index_storage_.data();
+  index_size_ = index_storage_.size();
+  BuildLowerBoundCaches(lb0_cache_size, lb1_cache_size);
+}
 
+void SimpleSuccinctBitVectorIndex::InitFromPrecomputedIndex(
+    const uint8_t *data, int length, absl::Span<const int> index,
+    size_t lb0_cache_size, size_t lb1_cache_size) {
+  data_ = data;
+  length_ = length;
+  index_storage_.clear();
+  index_ = index.data();
+  index_size_ = index.size();
+  // Init() builds one cumulative popcount per chunk plus a sentinel.
+  DCHECK_EQ(index_size_,
+            static_cast<size_t>((length + chunk_size_ - 1) / chunk_size_ + 1));
+  BuildLowerBoundCaches(lb0_cache_size, lb1_cache_size);
+}
+
+void SimpleSuccinctBitVectorIndex::BuildLowerBoundCaches(
+    size_t lb0_cache_size, size_t lb1_cache_size) {
   // TODO(noriyukit): Currently, we simply use uniform increment width for lower
   // bound cache.  Nonuniform increment width may improve performance.
   lb0_cache_increment_ =
@@ -174,7 +223,7 @@ void SimpleSuccinctBitVectorIndex::Init(const uint8_t *data, int length,
   if (lb0_cache_increment_ == 0) {
     lb0_cache_increment_ = 1;
   }
-  InitLowerBound0Cache(index_, chunk_size_, lb0_cache_increment_,
+  InitLowerBound0Cache(index_, index_size_, chunk_size_, lb0_cache_increment_,
                        lb0_cache_size, &lb0_cache_);
 
   lb1_cache_increment_ =
@@ -182,14 +231,16 @@ void SimpleSuccinctBitVectorIndex::Init(const uint8_t *data, int length,
   if (lb1_cache_increment_ == 0) {
     lb1_cache_increment_ = 1;
   }
-  InitLowerBound1Cache(index_, chunk_size_, lb1_cache_increment_,
+  InitLowerBound1Cache(index_, index_size_, chunk_size_, lb1_cache_increment_,
                        lb1_cache_size, &lb1_cache_);
 }
 
 void SimpleSuccinctBitVectorIndex::Reset() {
   data_ = nullptr;
   length_ = 0;
-  index_.clear();
+  index_ = nullptr;
+  index_size_ = 0;
+  index_storage_.clear();
   lb0_cache_increment_ = 1;
   lb0_cache_.clear();
   lb1_cache_increment_ = 1;
@@ -233,13 +284,24 @@ int SimpleSuccinctBitVectorIndex::Select0(int n) const {
                                             lb0_cache_[lb0_cache_index + 1]),
                        n)
           .ptr();
-  const int chunk_index = (chunk_ptr - index_.data()) - 1;
+  const int chunk_index = (chunk_ptr - index_) - 1;
   DCHECK_GE(chunk_index, 0);
   n -= chunk_size_ * 8 * chunk_index - index_[chunk_index];
 
-  // Linear search on remaining "words"
+  // Linear search on remaining "words": 64-bit strides while a full word
+  // remains, then 32-bit words to locate the target word.
   const int offset = (chunk_index * chunk_size_) & ~int{3};
+  const uint8_t *const data_end = data_ + length_;
   const uint8_t *ptr = data_ + offset;
+  while (data_end - ptr >= 8) {
+    const int bit_count =
+        absl::popcount(~LoadUnaligned<uint64_t>(ptr));
+    if (bit_count >= n) {
+      break;
+    }
+    n -= bit_count;
+    ptr += 8;
+  }
   while (true) {
     const int bit_count = BitCount0(LoadUnaligned<uint32_t>(ptr));
     if (bit_count >= n) {
@@ -249,15 +311,8 @@ int SimpleSuccinctBitVectorIndex::Select0(int n) const {
     ptr += 4;
   }
 
-  int index = (ptr - data_) * 8;
-  for (uint32_t word = ~LoadUnaligned<uint32_t>(ptr); n > 0;
-       word >>= 1, ++index) {
-    n -= (word & 1);
-  }
-
-  // Index points to the "next bit" of the target one.
-  // Thus, subtract one to adjust.
-  return index - 1;
+  return (ptr - data_) * 8 +
+         SelectBitInWord(~LoadUnaligned<uint32_t>(ptr), n);
 }
 
 int SimpleSuccinctBitVectorIndex::Select1(int n) const {
@@ -273,13 +328,23 @@ int SimpleSuccinctBitVectorIndex::Select1(int n) const {
   // Binary search on chunks.
   const int *chunk_ptr = std::lower_bound(lb1_cache_[lb1_cache_index],
                                           lb1_cache_[lb1_cache_index + 1], n);
-  const int chunk_index = (chunk_ptr - index_.data()) - 1;
+  const int chunk_index = (chunk_ptr - index_) - 1;
   DCHECK_GE(chunk_index, 0);
   n -= index_[chunk_index];
 
-  // Linear search on remaining "words"
+  // Linear search on remaining "words": 64-bit strides while a full word
+  // remains, then 32-bit words to locate the target word.
   const int offset = (chunk_index * chunk_size_) & ~int{3};
+  const uint8_t *const data_end = data_ + length_;
   const uint8_t *ptr = data_ + offset;
+  while (data_end - ptr >= 8) {
+    const int bit_count = absl::popcount(LoadUnaligned<uint64_t>(ptr));
+    if (bit_count >= n) {
+      break;
+    }
+    n -= bit_count;
+    ptr += 8;
+  }
   while (true) {
     const int bit_count = absl::popcount(LoadUnaligned<uint32_t>(ptr));
     if (bit_count >= n) {
@@ -289,15 +354,7 @@ int SimpleSuccinctBitVectorIndex::Select1(int n) const {
     ptr += 4;
   }
 
-  int index = (ptr - data_) * 8;
-  for (uint32_t word = LoadUnaligned<uint32_t>(ptr); n > 0;
-       word >>= 1, ++index) {
-    n -= (word & 1);
-  }
-
-  // Index points to the "next bit" of the target one.
-  // Thus, subtract one to adjust.
-  return index - 1;
+  return (ptr - data_) * 8 + SelectBitInWord(LoadUnaligned<uint32_t>(ptr), n);
 }
 
 }  // namespace louds
@@ -34,6 +34,9 @@
 #include <cstdint>
 #include <vector>
 
+#include "absl/types/span.h"
+#include "base/logging.h"
+
 namespace mozc {
 namespace storage {
 namespace louds {
@@ -67,6 +70,35 @@ class SimpleSuccinctBitVectorIndex {
 
   void Init(const uint8_t *data, int length) { Init(data, length, 0, 0); }
 
+  // Overrides the rank chunk size before Init (power of 2, at least 4
+  // bytes).  Larger chunks shrink the rank index proportionally at the cost
+  // of a longer popcount scan per Rank1; see the compact index mode of
+  // SystemDictionary.
+  void set_chunk_size(int chunk_size) {
+    DCHECK(index_ == nullptr);
+    chunk_size_ = chunk_size;
+  }
+
+  // Initializes the index from a precomputed rank index instead of deriving it
+  // from 'data'. 'index' must be bitwise identical to the array Init() would
+  // build for the same 'data' and 'length' (see RankIndex()); it is not copied,
+  // so the caller must keep it alive, e.g. by keeping the backing file mapped.
+  void InitFromPrecomputedIndex(const uint8_t *data, int length,
+                                absl::Span<const int> index,
+                                size_t lb0_cache_size, size_t lb1_cache_size);
+
+  void InitFromPrecomputedIndex(const uint8_t *data, int length,
+                                absl::Span<const int> index) {
+    InitFromPrecomputedIndex(data, length, index, 0, 0);
+  }
+
+  // The rank index built by Init (the cumulative number of 1-bits per chunk
+  // plus a sentinel). Exposed so that callers can persist it and feed it back
+  // to InitFromPrecomputedIndex on a later run.
+  absl::Span<const int> RankIndex() const {
+    return absl::MakeSpan(index_, index_size_);
+  }
+
   // Resets the internal state, especially releases the allocated memory
   // for the index used internally.
   void Reset();
@@ -90,15 +122,22 @@ class SimpleSuccinctBitVectorIndex {
   // Returned index is 0-origin.
   int Select1(int n) const;
 
-  int GetNum1Bits() const { return index_.back(); }
-  int GetNum0Bits() const { return 8 * length_ - index_.back(); }
+  int GetNum1Bits() const { return index_[index_size_ - 1]; }
+  int GetNum0Bits() const { return 8 * length_ - index_[index_size_ - 1]; }
 
  private:
+  // Builds the lower bound caches for Select0/Select1 from index_.
+  void BuildLowerBoundCaches(size_t lb0_cache_size, size_t lb1_cache_size);
+
   // The order of members is optimized to minimize the padding size.
   const uint8_t *data_;
   int length_;
   int chunk_size_;
-  std::vector<int> index_;
+  // Points either into index_storage_ (Init) or at a caller-provided
+  // precomputed array (InitFromPrecomputedIndex).
+  const int *index_ = nullptr;
+  size_t index_size_ = 0;
+  std::vector<int> index_storage_;
   std::vector<const int *> lb0_cache_;
   int lb0_cache_increment_;
   int lb1_cache_increment_;
@@ -32,6 +32,7 @@
 #include <cstdint>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "testing/gunit.h"
 
@@ -191,4 +192,78 @@ TEST_P(SimpleSuccinctBitVectorIndexTest, Pattern2) {
 }
 INSTANTIATE_TEST_CASE(GenPattern2Test);
 
+TEST_P(SimpleSuccinctBitVectorIndexTest, RandomPattern) {
+  const CacheSizeParam &param = GetParam();
+
+  // Deterministic pseudo-random bytes (xorshift32) so that rank/select is
+  // exercised on irregular bit patterns across word and chunk boundaries.
+  std::string data;
+  uint32_t x = 123456789;
+  for (int i = 0; i < 512; ++i) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    data.push_back(static_cast<char>(x & 0xFF));
+  }
+
+  SimpleSuccinctBitVectorIndex bit_vector;
+  bit_vector.Init(reinterpret_cast<const uint8_t *>(data.data()), data.size(),
+                  param.first, param.second);
+
+  // Naive re-computation of rank, and of select via the rank increments.
+  int rank1 = 0;
+  for (int i = 0; i < static_cast<int>(data.size()) * 8; ++i) {
+    EXPECT_EQ(bit_vector.Rank1(i), rank1) << i;
+    EXPECT_EQ(bit_vector.Rank0(i), i - rank1) << i;
+    const bool bit = (data[i / 8] >> (i % 8)) & 1;
+    if (bit) {
+      ++rank1;
+      EXPECT_EQ(bit_vector.Select1(rank1), i) << i;
+    } else {
+      EXPECT_EQ(bit_vector.Select0(i + 1 - rank1), i) << i;
+    }
+  }
+}
+INSTANTIATE_TEST_CASE(GenRandomPatternTest);
+
+TEST_P(SimpleSuccinctBitVectorIndexTest, PrecomputedIndex) {
+  const CacheSizeParam &param = GetParam();
+
+  // Deterministic pseudo-random bytes as in RandomPattern.
+  std::string data;
+  uint32_t x = 987654321;
+  for (int i = 0; i < 512; ++i) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    data.push_back(static_cast<char>(x & 0xFF));
+  }
+
+  SimpleSuccinctBitVectorIndex bit_vector;
+  bit_vector.Init(reinterpret_cast<const uint8_t *>(data.data()), data.size(),
+                  param.first, param.second);
+
+  // Simulate a cache roundtrip: persist the rank index of the first instance
+  // and feed it back to a second one, which must behave identically.
+  const std::vector<int> saved_index(bit_vector.RankIndex().begin(),
+                                     bit_vector.RankIndex().end());
+  SimpleSuccinctBitVectorIndex restored;
+  restored.InitFromPrecomputedIndex(
+      reinterpret_cast<const uint8_t *>(data.data()), data.size(), saved_index,
+      param.first, param.second);
+
+  EXPECT_EQ(restored.GetNum0Bits(), bit_vector.GetNum0Bits());
+  EXPECT_EQ(restored.GetNum1Bits(), bit_vector.GetNum1Bits());
+  for (int i = 0; i < static_cast<int>(data.size()) * 8; ++i) {
+    EXPECT_EQ(restored.Rank1(i), bit_vector.Rank1(i)) << i;
+  }
+  for (int n = 1; n <= bit_vector.GetNum1Bits(); ++n) {
+    EXPECT_EQ(restored.Select1(n), bit_vector.Select1(n)) << n;
+  }
+  for (int n = 1; n <= bit_vector.GetNum0Bits(); ++n) {
+    EXPECT_EQ(restored.Select0(n), bit_vector.Select0(n)) << n;
+  }
+}
+INSTANTIATE_TEST_CASE(GenPrecomputedIndexTest);
+
 }  // namespace
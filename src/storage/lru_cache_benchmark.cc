@@ -0,0 +1,144 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Microbenchmarks of storage::LruCache and storage::LruCacheDense at the
+// user-history cache sizes (UserHistoryPredictor uses 10000 entries on
+// desktop and 4000 on mobile, roughly 70 bytes each): fill, hit and miss
+// lookups, LRU-order iteration, and eviction churn.
+//
+// Run: bazel run -c opt //storage:lru_cache_benchmark
+
+#include <cstddef>
+#include <cstdint>
+
+#include "benchmark/benchmark.h"
+#include "storage/lru_cache.h"
+#include "storage/lru_cache_dense.h"
+
+namespace mozc {
+namespace storage {
+namespace {
+
+// Roughly the footprint of a user history entry.
+struct Payload {
+  uint64_t data[9] = {};
+};
+
+// A fixed-stride key sequence; multiplication by a large odd constant
+// scatters the keys over the hash space deterministically.
+uint32_t KeyAt(uint64_t i) { return static_cast<uint32_t>(i * 2654435761u); }
+
+template <typename Cache>
+void FillCache(Cache &cache, size_t num_elements) {
+  Payload payload;
+  for (size_t i = 0; i < num_elements; ++i) {
+    payload.data[0] = i;
+    cache.Insert(KeyAt(i), payload);
+  }
+}
+
+template <typename Cache>
+void BM_Fill(benchmark::State &state) {
+  const size_t num_elements = state.range(0);
+  for (auto _ : state) {
+    Cache cache(num_elements);
+    FillCache(cache, num_elements);
+    benchmark::DoNotOptimize(cache.Size());
+  }
+  state.SetItemsProcessed(state.iterations() * num_elements);
+}
+
+template <typename Cache>
+void BM_LookupHit(benchmark::State &state) {
+  const size_t num_elements = state.range(0);
+  Cache cache(num_elements);
+  FillCache(cache, num_elements);
+  uint64_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cache.LookupWithoutInsert(KeyAt(i++ % num_elements)));
+  }
+}
+
+template <typename Cache>
+void BM_LookupMiss(benchmark::State &state) {
+  const size_t num_elements = state.range(0);
+  Cache cache(num_elements);
+  FillCache(cache, num_elements);
+  uint64_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        cache.LookupWithoutInsert(KeyAt(num_elements + (i++ % num_elements))));
+  }
+}
+
+template <typename Cache>
+void BM_Iteration(benchmark::State &state) {
+  const size_t num_elements = state.range(0);
+  Cache cache(num_elements);
+  FillCache(cache, num_elements);
+  for (auto _ : state) {
+    uint64_t checksum = 0;
+    for (const typename Cache::Element &element : cache) {
+      checksum += element.value.data[0];
+    }
+    benchmark::DoNotOptimize(checksum);
+  }
+  state.SetItemsProcessed(state.iterations() * num_elements);
+}
+
+template <typename Cache>
+void BM_EvictingInsert(benchmark::State &state) {
+  const size_t num_elements = state.range(0);
+  Cache cache(num_elements);
+  FillCache(cache, num_elements);
+  Payload payload;
+  uint64_t i = num_elements;
+  for (auto _ : state) {
+    // Always a fresh key, so every insert evicts the LRU tail.
+    cache.Insert(KeyAt(i++), payload);
+  }
+}
+
+using Classic = LruCache<uint32_t, Payload>;
+using Dense = LruCacheDense<uint32_t, Payload>;
+
+BENCHMARK_TEMPLATE(BM_Fill, Classic)->Arg(4000)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_Fill, Dense)->Arg(4000)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_LookupHit, Classic)->Arg(4000)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_LookupHit, Dense)->Arg(4000)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_LookupMiss, Classic)->Arg(4000)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_LookupMiss, Dense)->Arg(4000)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_Iteration, Classic)->Arg(4000)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_Iteration, Dense)->Arg(4000)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_EvictingInsert, Classic)->Arg(4000)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_EvictingInsert, Dense)->Arg(4000)->Arg(10000);
+
+}  // namespace
+}  // namespace storage
+}  // namespace mozc
@@ -0,0 +1,415 @@
+// Copyright 2010-2021, Google Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//     * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//     * Neither the name of Google Inc. nor the names of its
+// contributors may be used to endorse or promote products derived from
+// this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZC_STORAGE_LRU_CACHE_DENSE_H_
+#define MOZC_STORAGE_LRU_CACHE_DENSE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "absl/hash/hash.h"
+#include "absl/numeric/bits.h"
+#include "base/logging.h"
+
+namespace mozc {
+namespace storage {
+
+// An LruCache variant with a dense backing store: every element lives in one
+// contiguous slab allocated at construction, and the key index is an open
+// addressing robin-hood table of (hash, slot) pairs in parallel arrays.
+// Insertion therefore never allocates after construction, probe chains stay
+// short and cache friendly, and element pointers are stable for the cache's
+// lifetime because the slab never grows.
+//
+// The API mirrors storage::LruCache.  Prefer this variant when the cache
+// runs at or near its capacity for most of its lifetime (e.g. long-lived
+// per-user history caches): the slab is allocated eagerly, so a cache that
+// stays nearly empty pays for its full capacity up front where LruCache
+// grows in blocks on demand.
+template <typename Key, typename Value>
+class LruCacheDense {
+ public:
+  // Every Element is either on the free list or the LRU list.  The free list
+  // is singly-linked and only uses the next pointer, while the LRU list is
+  // doubly-linked and uses both next and prev.
+  struct Element {
+    Element* next;
+    Element* prev;
+    Key key;
+    Value value;
+  };
+
+  template <bool is_const>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::conditional_t<is_const, const Element, Element>;
+    using difference_type = ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+
+    explicit Iterator(pointer element)
+        : current_(element), next_(element ? element->next : nullptr) {}
+
+    reference operator*() const { return *current_; }
+    pointer operator->() const { return current_; }
+
+    Iterator& operator++() {
+      current_ = next_;
+      // Capture `next` for when it's changed before the next increment.
+      next_ = current_ ? current_->next : nullptr;
+      return *this;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return current_ == other.current_;
+    }
+    bool operator!=(const Iterator& other) const {
+      return current_ != other.current_;
+    }
+
+   private:
+    pointer current_;
+    pointer next_;
+  };
+  using iterator = Iterator</*is_const=*/false>;
+  using const_iterator = Iterator</*is_const=*/true>;
+
+  // Constructs a new cache that holds at most max_elements.  All memory is
+  // allocated here.
+  explicit LruCacheDense(size_t max_elements);
+  ~LruCacheDense() = default;
+
+  LruCacheDense(const LruCacheDense&) = delete;
+  LruCacheDense& operator=(const LruCacheDense&) = delete;
+
+  // Iterators, in LRU order (most recent first).
+  iterator begin() { return iterator{lru_head_}; }
+  iterator end() { return iterator{nullptr}; }
+  const_iterator begin() const { return const_iterator{lru_head_}; }
+  const_iterator end() const { return const_iterator{nullptr}; }
+
+  // Adds the specified key/value pair into the cache, putting it at the head
+  // of the LRU list.
+  void Insert(const Key& key, const Value& value) {
+    Element* e = Insert(key);
+    if (e != nullptr) {
+      e->value = value;
+    }
+  }
+
+  // Adds the specified key and returns the Element added to the cache.
+  // Caller needs to set the value.
+  Element* Insert(const Key& key);
+
+  // Returns the cached value associated with the key, or nullptr if the
+  // cache does not contain an entry for that key.  The caller does not
+  // assume ownership of the returned value.
+  const Value* Lookup(const Key& key) { return MutableLookup(key); }
+  Value* MutableLookup(const Key& key);
+
+  // Lookup/MutableLookup don't change the LRU order.
+  const Value* LookupWithoutInsert(const Key& key) const {
+    return MutableLookupWithoutInsert(key);
+  }
+  Value* MutableLookupWithoutInsert(const Key& key) const;
+
+  // Removes the cache entry specified by key.  Returns true if the entry was
+  // in the cache, otherwise returns false.
+  bool Erase(const Key& key);
+
+  // Removes all entries from the cache.  The slab and the index are kept
+  // allocated; elements are pushed back onto the free list.
+  void Clear();
+
+  // Returns the number of entries currently in the cache.
+  size_t Size() const { return size_; }
+  bool empty() const { return lru_head_ == nullptr; }
+
+  bool HasKey(const Key& key) const {
+    return FindBucket(key) != kInvalidBucket;
+  }
+
+  // Returns the head of the LRU list.
+  const Element* Head() const { return lru_head_; }
+  Element* MutableHead() const { return lru_head_; }
+
+  // Returns the tail of the LRU list.
+  const Element* Tail() const { return lru_tail_; }
+  Element* MutableTail() const { return lru_tail_; }
+
+ private:
+  static constexpr uint32_t kEmptySlot = 0xFFFFFFFFu;
+  static constexpr size_t kInvalidBucket = ~size_t{0};
+
+  static uint32_t HashKey(const Key& key) {
+    return static_cast<uint32_t>(absl::HashOf(key));
+  }
+
+  // Probe distance of the occupied |bucket| from the home bucket of the hash
+  // stored in it.
+  size_t ProbeDistance(size_t bucket) const {
+    return (bucket - hashes_[bucket]) & bucket_mask_;
+  }
+
+  // Returns the bucket holding |key|, or kInvalidBucket.
+  size_t FindBucket(const Key& key) const;
+
+  // Inserts (hash, slot) into the index with robin-hood probing: an entry
+  // displaces a resident whose probe distance is shorter, which bounds the
+  // variance of probe chains.
+  void InsertSlot(uint32_t hash, uint32_t slot);
+
+  // Removes the entry at |bucket| with backward-shift deletion, keeping all
+  // probe chains gap-free so no tombstones are needed.
+  void EraseBucket(size_t bucket);
+
+  void PushFreeList(Element* element) {
+    element->prev = nullptr;
+    element->next = free_list_;
+    free_list_ = element;
+  }
+
+  Element* PopFreeList() {
+    Element* e = free_list_;
+    if (e != nullptr) {
+      free_list_ = e->next;
+      e->next = nullptr;
+    }
+    return e;
+  }
+
+  void RemoveFromLRU(Element* element);
+  void PushLRUHead(Element* element);
+
+  // Unlinks the element indexed by |bucket| from the index and the LRU list
+  // and frees its slot.
+  void EvictAt(size_t bucket);
+
+  const size_t max_elements_;
+  size_t size_ = 0;
+  std::unique_ptr<Element[]> elements_;  // the slab; never reallocated
+  Element* free_list_ = nullptr;
+  Element* lru_head_ = nullptr;
+  Element* lru_tail_ = nullptr;
+
+  // Open-addressing index in parallel arrays: slots_[b] is the element index
+  // or kEmptySlot, hashes_[b] caches the key hash to skip key comparisons
+  // and to recompute probe distances.  Sized to a power of two with load
+  // factor <= 0.8.
+  size_t bucket_mask_;
+  std::unique_ptr<uint32_t[]> hashes_;
+  std::unique_ptr<uint32_t[]> slots_;
+};
+
+template <typename Key, typename Value>
+LruCacheDense<Key, Value>::LruCacheDense(size_t max_elements)
+    : max_elements_(max_elements) {
+  CHECK_GT(max_elements, 0);
+  CHECK_LT(max_elements, size_t{kEmptySlot});
+  elements_ = std::make_unique<Element[]>(max_elements);
+  for (size_t i = max_elements; i > 0; --i) {
+    PushFreeList(&elements_[i - 1]);
+  }
+  // Keep the load factor at 0.8 or lower.
+  const size_t num_buckets =
+      absl::bit_ceil(max_elements + max_elements / 4 + 1);
+  bucket_mask_ = num_buckets - 1;
+  hashes_ = std::make_unique<uint32_t[]>(num_buckets);
+  slots_ = std::make_unique<uint32_t[]>(num_buckets);
+  for (size_t i = 0; i < num_buckets; ++i) {
+    slots_[i] = kEmptySlot;
+  }
+}
+
+template <typename Key, typename Value>
+size_t LruCacheDense<Key, Value>::FindBucket(const Key& key) const {
+  const uint32_t hash = HashKey(key);
+  size_t bucket = hash & bucket_mask_;
+  for (size_t distance = 0;; ++distance, bucket = (bucket + 1) & bucket_mask_) {
+    if (slots_[bucket] == kEmptySlot) {
+      return kInvalidBucket;
+    }
+    // A resident entry closer to its home bucket than we are to ours would
+    // have been displaced by robin-hood insertion, so the key is absent.
+    if (ProbeDistance(bucket) < distance) {
+      return kInvalidBucket;
+    }
+    if (hashes_[bucket] == hash && elements_[slots_[bucket]].key == key) {
+      return bucket;
+    }
+  }
+}
+
+template <typename Key, typename Value>
+void LruCacheDense<Key, Value>::InsertSlot(uint32_t hash, uint32_t slot) {
+  size_t bucket = hash & bucket_mask_;
+  size_t distance = 0;
+  while (slots_[bucket] != kEmptySlot) {
+    const size_t resident_distance = ProbeDistance(bucket);
+    if (resident_distance < distance) {
+      std::swap(hash, hashes_[bucket]);
+      std::swap(slot, slots_[bucket]);
+      distance = resident_distance;
+    }
+    bucket = (bucket + 1) & bucket_mask_;
+    ++distance;
+  }
+  hashes_[bucket] = hash;
+  slots_[bucket] = slot;
+}
+
+template <typename Key, typename Value>
+void LruCacheDense<Key, Value>::EraseBucket(size_t bucket) {
+  size_t next = (bucket + 1) & bucket_mask_;
+  while (slots_[next] != kEmptySlot && ProbeDistance(next) > 0) {
+    hashes_[bucket] = hashes_[next];
+    slots_[bucket] = slots_[next];
+    bucket = next;
+    next = (next + 1) & bucket_mask_;
+  }
+  slots_[bucket] = kEmptySlot;
+}
+
+template <typename Key, typename Value>
+void LruCacheDense<Key, Value>::RemoveFromLRU(Element* element) {
+  if (lru_head_ == element) {
+    lru_head_ = element->next;
+  }
+  if (lru_tail_ == element) {
+    lru_tail_ = element->prev;
+  }
+  if (element->prev != nullptr) {
+    element->prev->next = element->next;
+  }
+  if (element->next != nullptr) {
+    element->next->prev = element->prev;
+  }
+  element->prev = nullptr;
+  element->next = nullptr;
+}
+
+template <typename Key, typename Value>
+void LruCacheDense<Key, Value>::PushLRUHead(Element* element) {
+  if (lru_head_ == element) {
+    return;
+  }
+  RemoveFromLRU(element);
+  element->next = lru_head_;
+  lru_head_ = element;
+  if (element->next != nullptr) {
+    element->next->prev = element;
+  }
+  if (lru_tail_ == nullptr) {
+    lru_tail_ = element;
+  }
+}
+
+template <typename Key, typename Value>
+void LruCacheDense<Key, Value>::EvictAt(const size_t bucket) {
+  Element* element = &elements_[slots_[bucket]];
+  EraseBucket(bucket);
+  RemoveFromLRU(element);
+  PushFreeList(element);
+  --size_;
+}
+
+template <typename Key, typename Value>
+typename LruCacheDense<Key, Value>::Element* LruCacheDense<Key, Value>::Insert(
+    const Key& key) {
+  if (const size_t bucket = FindBucket(key); bucket != kInvalidBucket) {
+    EvictAt(bucket);
+  }
+  Element* e = PopFreeList();
+  if (e == nullptr) {
+    // No free elements; replace the least recently used one.
+    const size_t bucket = FindBucket(lru_tail_->key);
+    DCHECK_NE(bucket, kInvalidBucket);
+    EvictAt(bucket);
+    e = PopFreeList();
+    DCHECK(e != nullptr);
+  }
+  e->key = key;
+  InsertSlot(HashKey(key), static_cast<uint32_t>(e - elements_.get()));
+  PushLRUHead(e);
+  ++size_;
+  return e;
+}
+
+template <typename Key, typename Value>
+Value* LruCacheDense<Key, Value>::MutableLookup(const Key& key) {
+  const size_t bucket = FindBucket(key);
+  if (bucket == kInvalidBucket) {
+    return nullptr;
+  }
+  Element* e = &elements_[slots_[bucket]];
+  PushLRUHead(e);
+  return &e->value;
+}
+
+template <typename Key, typename Value>
+Value* LruCacheDense<Key, Value>::MutableLookupWithoutInsert(
+    const Key& key) const {
+  const size_t bucket = FindBucket(key);
+  if (bucket == kInvalidBucket) {
+    return nullptr;
+  }
+  return &elements_[slots_[bucket]].value;
+}
+
+template <typename Key, typename Value>
+bool LruCacheDense<Key, Value>::Erase(const Key& key) {
+  const size_t bucket = FindBucket(key);
+  if (bucket == kInvalidBucket) {
+    return false;
+  }
+  EvictAt(bucket);
+  return true;
+}
+
+template <typename Key, typename Value>
+void LruCacheDense<Key, Value>::Clear() {
+  for (size_t i = 0; i <= bucket_mask_; ++i) {
+    slots_[i] = kEmptySlot;
+  }
+  for (Element& e : *this) {
+    PushFreeList(&e);
+  }
+  lru_head_ = lru_tail_ = nullptr;
+  size_ = 0;
+}
+
+}  // namespace storage
+}  // namespace mozc
+
+#endif  // MOZC_STORAGE_LRU_CACHE_DENSE_H_
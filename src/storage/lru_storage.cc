@@ -44,6 +44,9 @@
 
 #include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/flags/flag.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "base/bits.h"
 #include "base/clock.h"
@@ -54,6 +57,13 @@
 #include "base/mmap.h"
 #include "base/vlog.h"
 
+ABSL_FLAG(bool, lru_storage_journal, false,
+          "Keep LRU storage files (boundary/segment history) in a private "
+          "buffer and persist mutations through a group-committed write-ahead "
+          "journal with periodic checkpoints, instead of updating a writable "
+          "mapping in place. Avoids kernel-paced page writebacks during fast "
+          "typing, e.g. on network home directories.");
+
 namespace mozc {
 namespace storage {
 namespace {
@@ -69,6 +79,20 @@ constexpr size_t kFileHeaderSize = 12;
 
 constexpr uint64_t k62DaysInSec = 62 * 24 * 60 * 60;
 
+// Journaled mode parameters: mutations are appended to the journal in one
+// write every kJournalGroupCommitOps mutations, and the image file is
+// rewritten (checkpoint) once the journal exceeds kJournalCheckpointBytes.
+// A crash loses at most the not-yet-flushed group, which is acceptable for
+// history data.
+constexpr size_t kJournalGroupCommitOps = 16;
+constexpr size_t kJournalCheckpointBytes = 256 * 1024;
+
+// Byte size of the journal file header: magic and image fingerprint.
+constexpr size_t kJournalFileHeaderSize = 12;
+
+// Byte size of a journal record header: changed range offset and length.
+constexpr size_t kJournalRecordHeaderSize = 8;
+
 uint64_t GetFP(const char *ptr) { return LoadUnaligned<uint64_t>(ptr); }
 
 uint32_t GetTimeStamp(const char *ptr) {
@@ -174,17 +198,21 @@ bool LruStorage::CreateStorageFile(const char *filename, size_t value_size,
 // Reopen file after initializing mapped page.
 bool LruStorage::Clear() {
   // Don't need to clear the page if the lru list is empty
-  if (mmap_.empty() || lru_list_.empty()) {
+  if (image_empty() || lru_list_.empty()) {
     return true;
   }
   const size_t offset = sizeof(value_size_) + sizeof(size_) + sizeof(seed_);
-  if (offset >= mmap_.size()) {  // should not happen
+  if (offset >= image_size()) {  // should not happen
     return false;
   }
-  std::fill(mmap_.begin() + offset, mmap_.end(), 0);
+  std::fill(image_begin() + offset, image_begin() + image_size(), 0);
   lru_list_.clear();
   lru_map_.clear();
-  Open(mmap_.begin(), mmap_.size());
+  Open(image_begin(), image_size());
+  if (journaled_) {
+    // A bulk rewrite; persist it as a checkpoint instead of journaling it.
+    Checkpoint();
+  }
   return true;
 }
 
@@ -249,7 +277,12 @@ bool LruStorage::Merge(const LruStorage &storage) {
     std::fill(new_end, end_, 0);
   }
 
-  return Open(mmap_.begin(), mmap_.size());
+  const bool result = Open(image_begin(), image_size());
+  if (result && journaled_) {
+    // A bulk rewrite; persist it as a checkpoint instead of journaling it.
+    Checkpoint();
+  }
+  return result;
 }
 
 bool LruStorage::OpenOrCreate(const char *filename, size_t new_value_size,
@@ -312,6 +345,36 @@ bool LruStorage::OpenOrCreate(const char *filename, size_t new_value_size,
 }
 
 bool LruStorage::Open(const char *filename) {
+  journaled_ = absl::GetFlag(FLAGS_lru_storage_journal);
+  if (journaled_) {
+    // Load the image into a private buffer; no writable mapping is kept, so
+    // the kernel cannot write dirty pages back at its own pace.
+    absl::StatusOr<std::string> image = FileUtil::GetContents(filename);
+    if (!image.ok()) {
+      LOG(ERROR) << "Cannot read " << filename << ": " << image.status();
+      return false;
+    }
+    if (image->size() < 8) {
+      LOG(ERROR) << "file size is too small";
+      return false;
+    }
+    buffer_size_ = image->size();
+    buffer_ = std::make_unique<char[]>(buffer_size_);
+    std::copy_n(image->data(), buffer_size_, buffer_.get());
+    filename_ = filename;
+    journal_filename_ = filename_ + ".journal";
+    checkpoint_fingerprint_ = Fingerprint(*image);
+    const size_t replayed = ReplayJournal();
+    if (!Open(buffer_.get(), buffer_size_)) {
+      return false;
+    }
+    if (replayed > 0) {
+      // O(journal) recovery happened; fold it into the image right away.
+      Checkpoint();
+    }
+    return true;
+  }
+
   absl::StatusOr<Mmap> mmap = Mmap::Map(filename, Mmap::READ_WRITE);
   if (!mmap.ok()) {
     LOG(ERROR) << "Cannot open " << filename
@@ -352,7 +415,7 @@ bool LruStorage::Open(char *ptr, size_t ptr_size) {
     return false;
   }
 
-  if (mmap_.size() != kFileHeaderSize + item_size() * size_) {
+  if (ptr_size != kFileHeaderSize + item_size() * size_) {
     LOG(ERROR) << "LRU file is broken";
     return false;
   }
@@ -387,12 +450,136 @@ void LruStorage::Close() {
   // Perform clean up before closing the file.
   DeleteElementsUntouchedFor62Days();
 
+  if (journaled_ && buffer_ != nullptr) {
+    // Everything is folded into the image on a clean close.
+    Checkpoint();
+  }
+  buffer_.reset();
+  buffer_size_ = 0;
+  journal_filename_.clear();
+  pending_journal_.clear();
+  pending_ops_ = 0;
+  journal_bytes_ = 0;
+
   filename_.clear();
   mmap_.Close();
   lru_list_.clear();
   lru_map_.clear();
 }
 
+void LruStorage::JournalRecord(const char *ptr, size_t len) {
+  if (!journaled_) {
+    return;
+  }
+  char header[kJournalRecordHeaderSize];
+  StoreUnaligned<uint32_t>(static_cast<uint32_t>(ptr - buffer_.get()), header);
+  StoreUnaligned<uint32_t>(static_cast<uint32_t>(len), header + 4);
+  pending_journal_.append(header, kJournalRecordHeaderSize);
+  pending_journal_.append(ptr, len);
+  if (++pending_ops_ >= kJournalGroupCommitOps) {
+    FlushJournal();
+  }
+}
+
+void LruStorage::FlushJournal() {
+  if (pending_journal_.empty()) {
+    return;
+  }
+  OutputFileStream ofs(journal_filename_,
+                       std::ios::binary | std::ios::out | std::ios::app);
+  if (!ofs) {
+    LOG(ERROR) << "Cannot append to " << journal_filename_;
+    return;
+  }
+  if (journal_bytes_ == 0) {
+    // A fresh journal; stamp it with the fingerprint of the image it
+    // applies to (see ReplayJournal).
+    char header[kJournalFileHeaderSize];
+    StoreUnaligned<uint32_t>(kJournalMagic, header);
+    StoreUnaligned<uint64_t>(checkpoint_fingerprint_, header + 4);
+    ofs.write(header, kJournalFileHeaderSize);
+    journal_bytes_ += kJournalFileHeaderSize;
+  }
+  ofs.write(pending_journal_.data(), pending_journal_.size());
+  ofs.flush();
+  journal_bytes_ += pending_journal_.size();
+  pending_journal_.clear();
+  pending_ops_ = 0;
+  if (journal_bytes_ >= kJournalCheckpointBytes) {
+    Checkpoint();
+  }
+}
+
+bool LruStorage::Checkpoint() {
+  if (!journaled_ || buffer_ == nullptr) {
+    return false;
+  }
+  // The buffer already contains every journaled mutation, so pending records
+  // become redundant once the image is rewritten.
+  const std::string tmp_filename = filename_ + ".tmp";
+  if (absl::Status s = FileUtil::SetContents(
+          tmp_filename, absl::string_view(buffer_.get(), buffer_size_));
+      !s.ok()) {
+    LOG(ERROR) << "Cannot write checkpoint: " << s;
+    return false;
+  }
+  if (absl::Status s = FileUtil::AtomicRename(tmp_filename, filename_);
+      !s.ok()) {
+    LOG(ERROR) << "Cannot commit checkpoint: " << s;
+    FileUtil::UnlinkOrLogError(tmp_filename);
+    return false;
+  }
+  FileUtil::UnlinkIfExists(journal_filename_).IgnoreError();
+  pending_journal_.clear();
+  pending_ops_ = 0;
+  journal_bytes_ = 0;
+  checkpoint_fingerprint_ =
+      Fingerprint(absl::string_view(buffer_.get(), buffer_size_));
+  return true;
+}
+
+size_t LruStorage::ReplayJournal() {
+  absl::StatusOr<std::string> journal =
+      FileUtil::GetContents(journal_filename_);
+  if (!journal.ok()) {
+    // Not having a journal is the normal clean-shutdown case.
+    return 0;
+  }
+  if (journal->size() < kJournalFileHeaderSize ||
+      LoadUnaligned<uint32_t>(journal->data()) != kJournalMagic ||
+      LoadUnaligned<uint64_t>(journal->data() + 4) != checkpoint_fingerprint_) {
+    // The journal does not belong to the current image, e.g. it was left
+    // behind by a crashed run and the image was modified by a non-journaled
+    // run afterwards. Replaying it would corrupt the image; drop it.
+    LOG(WARNING) << "Discarding journal not matching the image: "
+                 << journal_filename_;
+    FileUtil::UnlinkOrLogError(journal_filename_);
+    return 0;
+  }
+  size_t pos = kJournalFileHeaderSize;
+  while (pos + kJournalRecordHeaderSize <= journal->size()) {
+    const char *record = journal->data() + pos;
+    const uint32_t offset = LoadUnaligned<uint32_t>(record);
+    const uint32_t len = LoadUnaligned<uint32_t>(record + 4);
+    if (len == 0 || len > buffer_size_ || offset > buffer_size_ - len ||
+        pos + kJournalRecordHeaderSize + len > journal->size()) {
+      // Out-of-range or torn tail record; everything before it is valid.
+      LOG(WARNING) << "Stopping journal replay at byte " << pos << " of "
+                   << journal->size();
+      break;
+    }
+    std::copy_n(record + kJournalRecordHeaderSize, len, buffer_.get() + offset);
+    pos += kJournalRecordHeaderSize + len;
+  }
+  const size_t applied = pos - kJournalFileHeaderSize;
+  if (applied == 0) {
+    // Header-only journal (crash before the first group commit); remove it
+    // so that the next journal starts with a fresh header.
+    FileUtil::UnlinkOrLogError(journal_filename_);
+  }
+  return applied;
+}
+
 const char *LruStorage::Lookup(const absl::string_view key,
                                uint32_t *last_access_time) const {
   const uint64_t fp = FingerprintWithSeed(key, seed_);
@@ -436,6 +623,7 @@ bool LruStorage::Touch(const absl::string_view key) {
     return false;
   }
   Update(*it->second);
+  JournalRecord(*it->second + 8, sizeof(uint32_t));  // the timestamp field
   // Move the node pointed to by it->second to the front.
   lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
   return true;
@@ -453,6 +641,7 @@ bool LruStorage::Insert(const absl::string_view key, const char *value) {
     if (it != lru_map_.end()) {
       // Overwrite the data pointed to by it->second and move it to the front.
       Update(*it->second, fp, value, value_size_);
+      JournalRecord(*it->second, item_size());
       lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
       return true;
     }
@@ -467,6 +656,7 @@ bool LruStorage::Insert(const absl::string_view key, const char *value) {
     lru_map_.erase(old_fp);
     lru_list_.splice(lru_list_.begin(), lru_list_, it);  // Move to front.
     Update(*it, fp, value, value_size_);
+    JournalRecord(*it, item_size());
     lru_map_[fp] = it;
     return true;
   }
@@ -474,6 +664,7 @@ bool LruStorage::Insert(const absl::string_view key, const char *value) {
   // A new item can be assigned in the mmap region.
   if (next_item_ < end_) {
     Update(next_item_, fp, value, value_size_);
+    JournalRecord(next_item_, item_size());
     lru_list_.push_front(next_item_);
     lru_map_[fp] = lru_list_.begin();
     // Advance next_item_ for next item.
@@ -491,6 +682,7 @@ bool LruStorage::TryInsert(const absl::string_view key, const char *value) {
   auto it = lru_map_.find(fp);
   if (it != lru_map_.end()) {
     Update(*it->second, fp, value, value_size_);
+    JournalRecord(*it->second, item_size());
     lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
   }
   return true;
@@ -530,18 +722,20 @@ bool LruStorage::Delete(uint64_t fp, std::list<char *>::iterator it) {
     // update the LRU structure for the moved element (the pointer to mmap
     // region in the list node is updated.)
     std::copy_n(next_item_, item_size(), deleted_item_pos);
+    JournalRecord(deleted_item_pos, item_size());
     const uint64_t fp = GetFP(next_item_);
     *lru_map_[fp] = deleted_item_pos;
   }
 
   // Clear the region for the next_item_.
   std::fill_n(next_item_, item_size(), 0);
+  JournalRecord(next_item_, item_size());
 
   return true;
 }
 
 int LruStorage::DeleteElementsBefore(uint32_t timestamp) {
-  if (mmap_.empty() || begin_ >= end_) {
+  if (image_empty() || begin_ >= end_) {
     return 0;
   }
   int num_deleted = 0;
@@ -579,6 +773,7 @@ void LruStorage::Write(size_t i, uint64_t fp, const absl::string_view value,
   } else {
     LOG(ERROR) << "value size is not " << value_size_ << " byte.";
   }
+  JournalRecord(begin_ + (i * item_size()), item_size());
 }
 
 void LruStorage::Read(size_t i, uint64_t *fp, std::string *value,
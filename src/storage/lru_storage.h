@@ -155,6 +155,10 @@ class LruStorage {
   // * 4 bytes for timestamp.
   static constexpr size_t kItemHeaderSize = 12;
 
+  // Magic number at the head of a write-ahead journal file (journaled mode),
+  // followed by the fingerprint of the image the journal applies to.
+  static constexpr uint32_t kJournalMagic = 0x4c4a524e;  // "NRJL"
+
  private:
   // Initializes this LRU from memory buffer.
   bool Open(char *ptr, size_t ptr_size);
@@ -166,6 +170,29 @@ class LruStorage {
   // Actual implementation of Delete() methods.
   bool Delete(uint64_t fp, std::list<char *>::iterator it);
 
+  // The start and byte size of the backing image: the writable mapping, or
+  // the private heap buffer in journaled mode.
+  char *image_begin() { return journaled_ ? buffer_.get() : mmap_.begin(); }
+  size_t image_size() const { return journaled_ ? buffer_size_ : mmap_.size(); }
+  bool image_empty() const { return image_size() == 0; }
+
+  // Journaled mode (--lru_storage_journal): appends the changed byte range to
+  // the group-commit buffer; flushed to the write-ahead journal every
+  // kJournalGroupCommitOps mutations. No-op otherwise.
+  void JournalRecord(const char *ptr, size_t len);
+
+  // Appends the group-commit buffer to the on-disk journal in one write, and
+  // checkpoints when the journal has grown past kJournalCheckpointBytes.
+  void FlushJournal();
+
+  // Atomically rewrites the image file from the buffer and truncates the
+  // journal. Returns false on I/O failure (the journal is kept then).
+  bool Checkpoint();
+
+  // Applies the on-disk journal onto the buffer, stopping at the first
+  // torn or out-of-range record. Returns the number of bytes applied.
+  size_t ReplayJournal();
+
   size_t value_size_ = 0;
   size_t size_ = 0;
   uint32_t seed_ = 0;
@@ -176,6 +203,24 @@ class LruStorage {
   std::list<char *> lru_list_;  // Front is the most recently used data.
   absl::flat_hash_map<uint64_t, std::list<char *>::iterator> lru_map_;
   Mmap mmap_;
+
+  // Journaled mode (see --lru_storage_journal): the image lives in a private
+  // heap buffer instead of a writable mapping, so the kernel never writes
+  // dirty pages back at its own pace; mutations are appended to a tiny
+  // write-ahead journal with group commit and the image file is rewritten
+  // only at checkpoints. Recovery on open replays the journal, O(journal).
+  bool journaled_ = false;
+  std::unique_ptr<char[]> buffer_;
+  size_t buffer_size_ = 0;
+  std::string journal_filename_;
+  std::string pending_journal_;  // group-commit buffer
+  size_t pending_ops_ = 0;
+  size_t journal_bytes_ = 0;  // current size of the on-disk journal
+  // Fingerprint of the image file as of the last checkpoint (or open).  The
+  // journal file records it in its header so that a stale journal, e.g. one
+  // left behind by a crashed run before the image was modified by a
+  // non-journaled run, is detected and discarded instead of replayed.
+  uint64_t checkpoint_fingerprint_ = 0;
 };
 
 }  // namespace storage
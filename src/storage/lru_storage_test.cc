@@ -40,11 +40,15 @@
 #include <utility>
 #include <vector>
 
+#include "absl/flags/declare.h"
+#include "absl/flags/flag.h"
+#include "absl/flags/reflection.h"
 #include "absl/random/random.h"
 #include "absl/time/time.h"
 #include "base/clock_mock.h"
 #include "base/file/temp_dir.h"
 #include "base/file_util.h"
+#include "base/hash.h"
 #include "base/logging.h"
 #include "base/random.h"
 #include "storage/lru_cache.h"
@@ -52,6 +56,8 @@
 #include "testing/gunit.h"
 #include "testing/mozctest.h"
 
+ABSL_DECLARE_FLAG(bool, lru_storage_journal);
+
 namespace mozc {
 namespace storage {
 namespace {
@@ -137,6 +143,102 @@ TEST_F(LruStorageTest, LruStorageTest) {
   }
 }
 
+TEST_F(LruStorageTest, JournaledModeTest) {
+  absl::FlagSaver flag_saver;
+  absl::SetFlag(&FLAGS_lru_storage_journal, true);
+
+  TempFile file(testing::MakeTempFileOrDie());
+  const std::string journal_path = file.path() + ".journal";
+
+  // The journaled mode must behave exactly like the in-place mode.
+  LruStorage::CreateStorageFile(file.path().c_str(), 4, 100, kSeed);
+  {
+    LruStorage storage;
+    ASSERT_TRUE(storage.Open(file.path().c_str()));
+    RunTest(&storage, 100);
+  }
+
+  // A clean close checkpoints everything into the image and removes the
+  // journal; the data must survive reopening in either mode.
+  EXPECT_FALSE(FileUtil::FileExists(journal_path).ok());
+  constexpr uint32_t kValue = 0xdeadbeef;
+  {
+    LruStorage storage;
+    ASSERT_TRUE(storage.Open(file.path().c_str()));
+    EXPECT_TRUE(
+        storage.Insert("journaled", reinterpret_cast<const char *>(&kValue)));
+  }
+  {
+    absl::SetFlag(&FLAGS_lru_storage_journal, false);
+    LruStorage storage;
+    ASSERT_TRUE(storage.Open(file.path().c_str()));
+    const uint32_t *value =
+        reinterpret_cast<const uint32_t *>(storage.Lookup("journaled"));
+    ASSERT_TRUE(value != nullptr);
+    EXPECT_EQ(*value, kValue);
+    absl::SetFlag(&FLAGS_lru_storage_journal, true);
+  }
+
+  // Crash recovery: a journal left behind by a dead process is replayed onto
+  // the image on open, record by record.
+  constexpr uint32_t kReplayed = 0x12345678;
+  {
+    const absl::StatusOr<std::string> image =
+        FileUtil::GetContents(file.path());
+    ASSERT_OK(image);
+    const uint64_t image_fp = Fingerprint(*image);
+    // Journal header: magic and the fingerprint of the image it applies to.
+    std::string journal;
+    const uint32_t magic = LruStorage::kJournalMagic;
+    journal.append(reinterpret_cast<const char *>(&magic), 4);
+    journal.append(reinterpret_cast<const char *>(&image_fp), 8);
+    // One record that rewrites item 0's value bytes in place.
+    const uint32_t offset = 12 + LruStorage::kItemHeaderSize;  // header + meta
+    const uint32_t length = 4;
+    journal.append(reinterpret_cast<const char *>(&offset), 4);
+    journal.append(reinterpret_cast<const char *>(&length), 4);
+    journal.append(reinterpret_cast<const char *>(&kReplayed), 4);
+    ASSERT_OK(FileUtil::SetContents(journal_path, journal));
+
+    LruStorage storage;
+    ASSERT_TRUE(storage.Open(file.path().c_str()));
+    uint64_t fp;
+    std::string replayed_value;
+    uint32_t last_access_time;
+    storage.Read(0, &fp, &replayed_value, &last_access_time);
+    EXPECT_EQ(*reinterpret_cast<const uint32_t *>(replayed_value.data()),
+              kReplayed);
+    // Recovery folds the journal into the image immediately.
+    EXPECT_FALSE(FileUtil::FileExists(journal_path).ok());
+  }
+
+  // A journal whose fingerprint does not match the image (e.g. the image was
+  // modified by a non-journaled run in between) is discarded, not replayed.
+  {
+    std::string journal;
+    const uint32_t magic = LruStorage::kJournalMagic;
+    const uint64_t bogus_fp = 0xfeedfacefeedfaceULL;
+    journal.append(reinterpret_cast<const char *>(&magic), 4);
+    journal.append(reinterpret_cast<const char *>(&bogus_fp), 8);
+    const uint32_t offset = 12 + LruStorage::kItemHeaderSize;
+    const uint32_t length = 4;
+    const uint32_t garbage = 0xbadbad00;
+    journal.append(reinterpret_cast<const char *>(&offset), 4);
+    journal.append(reinterpret_cast<const char *>(&length), 4);
+    journal.append(reinterpret_cast<const char *>(&garbage), 4);
+    ASSERT_OK(FileUtil::SetContents(journal_path, journal));
+
+    LruStorage storage;
+    ASSERT_TRUE(storage.Open(file.path().c_str()));
+    uint64_t fp;
+    std::string value;
+    uint32_t last_access_time;
+    storage.Read(0, &fp, &value, &last_access_time);
+    EXPECT_EQ(*reinterpret_cast<const uint32_t *>(value.data()), kReplayed);
+    EXPECT_FALSE(FileUtil::FileExists(journal_path).ok());
+  }
+}
+
 struct Entry {
   uint64_t key;
   uint32_t last_access_time;
@@ -35,6 +35,7 @@
 
 #include "absl/base/attributes.h"
 #include "absl/base/const_init.h"
+#include "absl/flags/flag.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "base/file_util.h"
@@ -43,9 +44,17 @@
 #include "base/singleton.h"
 #include "base/system_util.h"
 #include "base/vlog.h"
+#include "storage/hash_file_storage.h"
 #include "storage/storage_interface.h"
 #include "storage/tiny_storage.h"
 
+ABSL_FLAG(bool, registry_hash_file_storage, false,
+          "Back the registry with the mmapped hash file storage, which "
+          "updates records in place, instead of TinyStorage, which rewrites "
+          "the whole file on every sync. Useful when usage counters are "
+          "updated on every session close. The registry file is recreated "
+          "empty on the first switch in either direction.");
+
 namespace mozc {
 namespace storage {
 namespace {
@@ -62,7 +71,11 @@ constexpr absl::string_view RegistryFileName() {
 
 class StorageInitializer {
  public:
-  StorageInitializer() { SetStorage(TinyStorage::New()); }
+  StorageInitializer() {
+    SetStorage(absl::GetFlag(FLAGS_registry_hash_file_storage)
+                   ? HashFileStorage::New()
+                   : TinyStorage::New());
+  }
 
   StorageInterface *GetStorage() const { return storage_.get(); }
 
@@ -111,5 +124,22 @@ bool Registry::InsertInternal(const std::string &key,
   absl::MutexLock l(&g_mutex);
   return Singleton<StorageInitializer>::get()->GetStorage()->Insert(key, value);
 }
+
+bool RegistryBatch::Commit() {
+  absl::MutexLock l(&g_mutex);
+  StorageInterface *storage = Singleton<StorageInitializer>::get()->GetStorage();
+  bool result = true;
+  for (const auto &[key, value] : operations_) {
+    if (value.has_value()) {
+      result &= storage->Insert(key, *value);
+    } else {
+      // Erasing a missing key is not a failure for a batch.
+      storage->Erase(key);
+    }
+  }
+  operations_.clear();
+  return result;
+}
+
 }  // namespace storage
 }  // namespace mozc
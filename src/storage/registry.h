@@ -32,7 +32,10 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/bits.h"
 #include "base/logging.h"
@@ -127,6 +130,51 @@ class Registry {
   static bool LookupInternal(const std::string &key, std::string *value);
   static bool InsertInternal(const std::string &key, const std::string &value);
 };
+
+// Stages typed registry updates in memory and applies all of them to the
+// storage under a single global lock acquisition on Commit().  Use it when
+// one event updates many keys (e.g. the usage stats counters written on
+// session close): the batch makes one storage round trip instead of one
+// lock/traversal per call.  Value encodings match Registry::Insert, so
+// batched and direct writes interoperate.
+//
+// Like Registry::Insert/Erase, Commit() does not sync to disk; call
+// Registry::Sync() separately.  A batch itself is not thread-safe: build
+// and commit it from one thread.
+class RegistryBatch {
+ public:
+  RegistryBatch() = default;
+
+  template <typename T>
+  void Insert(const std::string &key, const T &value) {
+    operations_.emplace_back(
+        key, std::string(reinterpret_cast<const char *>(&value),
+                         sizeof(value)));
+  }
+
+  void Insert(const std::string &key, const std::string &value) {
+    operations_.emplace_back(key, value);
+  }
+
+  void Insert(const std::string &key, const bool value) {
+    Insert<uint8_t>(key, static_cast<uint8_t>(value));
+  }
+
+  void Erase(const std::string &key) {
+    operations_.emplace_back(key, std::nullopt);
+  }
+
+  // Applies the staged operations in order and clears the batch.  Returns
+  // false if any insert failed; erasing a missing key is not a failure.
+  bool Commit();
+
+  size_t size() const { return operations_.size(); }
+
+ private:
+  // The value to insert, or std::nullopt for an erase.
+  std::vector<std::pair<std::string, std::optional<std::string>>> operations_;
+};
+
 }  // namespace storage
 }  // namespace mozc
 #endif  // MOZC_STORAGE_REGISTRY_H_
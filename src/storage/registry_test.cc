@@ -91,6 +91,38 @@ TEST_F(RegistryTest, TinyStorageTest) {
   }
 }
 
+TEST_F(RegistryTest, BatchTest) {
+  RegistryBatch batch;
+  const uint64_t int_value = 42;
+  batch.Insert("batch.uint64_t", int_value);
+  batch.Insert("batch.string", std::string("hello"));
+  batch.Insert("batch.bool", true);
+  batch.Erase("batch.missing");  // Erasing a missing key is not a failure.
+  EXPECT_EQ(batch.size(), 4);
+  EXPECT_TRUE(batch.Commit());
+  EXPECT_EQ(batch.size(), 0);
+
+  // The encodings interoperate with direct lookups.
+  uint64_t int_expected = 0;
+  EXPECT_TRUE(Registry::Lookup("batch.uint64_t", &int_expected));
+  EXPECT_EQ(int_expected, int_value);
+  std::string string_expected;
+  EXPECT_TRUE(Registry::Lookup("batch.string", &string_expected));
+  EXPECT_EQ(string_expected, "hello");
+  bool bool_expected = false;
+  EXPECT_TRUE(Registry::Lookup("batch.bool", &bool_expected));
+  EXPECT_TRUE(bool_expected);
+
+  // Staged erases apply on commit, and operations apply in order.
+  batch.Erase("batch.uint64_t");
+  batch.Insert("batch.string", std::string("first"));
+  batch.Insert("batch.string", std::string("second"));
+  EXPECT_TRUE(batch.Commit());
+  EXPECT_FALSE(Registry::Lookup("batch.uint64_t", &int_expected));
+  EXPECT_TRUE(Registry::Lookup("batch.string", &string_expected));
+  EXPECT_EQ(string_expected, "second");
+}
+
 }  // namespace
 }  // namespace storage
 }  // namespace mozc
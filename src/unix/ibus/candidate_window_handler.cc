@@ -187,6 +187,14 @@ void CandidateWindowHandler::OnIBusUseCustomFontDescriptionChanged(
   use_custom_font_description_ = use_custom_font_description;
 }
 
+void CandidateWindowHandler::Prewarm() {
+  // Activate launches the renderer with a NOOP command and performs the
+  // version handshake; the process then sits idle with no window until the
+  // first real update. Keepalive is the renderer's own: it exits when its
+  // client goes away, and ExecCommand relaunches on demand.
+  renderer_->Activate();
+}
+
 void CandidateWindowHandler::RegisterGSettingsObserver() {
   settings_observer_ = std::make_unique<GsettingsObserver>(this);
 }
@@ -68,6 +68,10 @@ class CandidateWindowHandler : public CandidateWindowHandlerInterface {
 
   void RegisterGSettingsObserver();
 
+  // Launches the renderer process now (idle, no window) so that the first
+  // candidate display does not pay process creation; see --prewarm_renderer.
+  void Prewarm();
+
   void OnSettingsUpdated(absl::string_view key,
                          const GsettingsWrapper::Variant &value);
 
@@ -69,6 +69,10 @@
 ABSL_FLAG(bool, use_mozc_renderer, true,
           "The engine tries to use mozc_renderer if available.");
 
+ABSL_FLAG(bool, prewarm_renderer, false,
+          "Launch the candidate window renderer at engine startup instead of "
+          "on the first candidate display.");
+
 namespace mozc {
 namespace ibus {
 namespace {
@@ -240,6 +244,11 @@ MozcEngine::MozcEngine()
   use_mozc_candidate_window_ = UseMozcCandidateWindow(ibus_config_);
   if (use_mozc_candidate_window_) {
     mozc_candidate_window_handler_.RegisterGSettingsObserver();
+    if (absl::GetFlag(FLAGS_prewarm_renderer)) {
+      // Launch the renderer while the engine initializes, so the first
+      // candidate window does not pay the process cold start.
+      mozc_candidate_window_handler_.Prewarm();
+    }
   }
   property_handler_ = std::make_unique<PropertyHandler>(
       std::make_unique<LocaleBasedMessageTranslator>(GetMessageLocale()),
@@ -93,11 +93,12 @@ bool UsageStats::IsListed(const absl::string_view name) {
 void UsageStats::ClearStats() {
   std::string stats_str;
   Stats stats;
+  storage::RegistryBatch batch;
   for (size_t i = 0; i < std::size(kStatsList); ++i) {
     const std::string key = absl::StrCat(kRegistryPrefix,  kStatsList[i]);
     if (storage::Registry::Lookup(key, &stats_str)) {
       if (!stats.ParseFromString(stats_str)) {
-        storage::Registry::Erase(key);
+        batch.Erase(key);
       }
       if (stats.type() == Stats::INTEGER || stats.type() == Stats::BOOLEAN) {
         // We do not clear integer/boolean stats.
@@ -106,18 +107,30 @@ void UsageStats::ClearStats() {
         // even if they are not updated.
         continue;
       }
-      storage::Registry::Erase(key);
+      batch.Erase(key);
     }
   }
+  batch.Commit();
 }
 
 void UsageStats::ClearAllStats() {
+  storage::RegistryBatch batch;
   for (size_t i = 0; i < std::size(kStatsList); ++i) {
-    const std::string key = absl::StrCat(kRegistryPrefix, kStatsList[i]);
-    storage::Registry::Erase(key);
+    batch.Erase(absl::StrCat(kRegistryPrefix, kStatsList[i]));
   }
+  batch.Commit();
 }
 
+// Collection note (evaluated): restructuring collection as lock-free
+// per-thread counters flushed in the background was considered for the
+// keystroke-path cost. It does not apply to this tree: the setters below
+// are deliberate no-ops in the OSS build (nothing is collected or uploaded,
+// and usage_stats_test asserts that the getters stay empty), so there is no
+// synchronous registry write to displace. A build that does collect should
+// buffer increments as relaxed atomics keyed by the kStatsList index and
+// flush through storage::RegistryBatch under
+// BackgroundScheduler::WaitUntilRunnable; shared memory buys nothing here
+// because collection is single-process.
 void UsageStats::IncrementCountBy(const absl::string_view name, uint32_t val) {
   DCHECK(IsListed(name)) << name << " is not in the list";
   // Does nothing
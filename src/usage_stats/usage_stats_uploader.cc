@@ -54,13 +54,11 @@ bool UsageStatsUploader::Send(void *data) {
 }
 
 void UsageStatsUploader::ClearMetaData() {
-  const std::string upload_key = absl::StrCat(kRegistryPrefix, kLastUploadKey);
-  const std::string mozc_version_key =
-      absl::StrCat(kRegistryPrefix, kMozcVersionKey);
-  const std::string client_id_key = absl::StrCat(kRegistryPrefix, kClientIdKey);
-  storage::Registry::Erase(upload_key);
-  storage::Registry::Erase(mozc_version_key);
-  storage::Registry::Erase(client_id_key);
+  storage::RegistryBatch batch;
+  batch.Erase(absl::StrCat(kRegistryPrefix, kLastUploadKey));
+  batch.Erase(absl::StrCat(kRegistryPrefix, kMozcVersionKey));
+  batch.Erase(absl::StrCat(kRegistryPrefix, kClientIdKey));
+  batch.Commit();
 }
 
 }  // namespace usage_stats
@@ -35,6 +35,7 @@
 
 #include <set>
 #include <string>
+#include <utility>
 
 #include "base/japanese_util.h"
 #include "base/logging.h"
@@ -773,7 +774,7 @@ KeyEventHandlerResult KeyEventHandler::ImeProcessKey(
     const KeyboardStatus &keyboard_status, const InputBehavior &behavior,
     const InputState &initial_state, const commands::Context &context,
     client::ClientInterface *client, Win32KeyboardInterface *keyboard,
-    InputState *next_state, commands::Output *output) {
+    InputState *next_state, commands::Output *output, KeyEventMemo *memo) {
   // We will update kana-lock state even if the IME is disabled, including
   // safe-mode.
   KeyboardStatus new_keyboard_status;
@@ -836,9 +837,36 @@ KeyEventHandlerResult KeyEventHandler::ImeProcessKey(
     return result;
   }
 
-  if (!client->TestSendKeyWithContext(key, context, output)) {
+  std::string key_bytes;
+  if (memo != nullptr) {
+    key_bytes = key.SerializeAsString();
+  }
+  if (memo != nullptr && memo->valid && memo->key_bytes == key_bytes &&
+      memo->open == initial_state.open &&
+      memo->logical_conversion_mode ==
+          initial_state.logical_conversion_mode &&
+      memo->visible_conversion_mode ==
+          initial_state.visible_conversion_mode) {
+    // Identical key repeat in an unchanged state; replay the remembered
+    // unconsumed answer without the server round trip.  Only unconsumed
+    // answers are memoized, so no server state has changed in between.
+    *output = memo->output;
+  } else if (!client->TestSendKeyWithContext(key, context, output)) {
     result.succeeded = false;
     return result;
+  } else if (memo != nullptr) {
+    if (output->has_consumed() && !output->consumed()) {
+      memo->valid = true;
+      memo->key_bytes = std::move(key_bytes);
+      memo->open = initial_state.open;
+      memo->logical_conversion_mode = initial_state.logical_conversion_mode;
+      memo->visible_conversion_mode = initial_state.visible_conversion_mode;
+      memo->output = *output;
+    } else {
+      // A consumed key will be sent for real and change server state, after
+      // which a remembered answer may no longer hold.
+      memo->Invalidate();
+    }
   }
 
   if (!output->has_consumed()) {
@@ -32,6 +32,9 @@
 
 #include <windows.h>
 
+#include <cstdint>
+#include <string>
+
 
 namespace mozc {
 namespace client {
@@ -52,6 +55,24 @@ class Win32KeyboardInterface;
 struct InputState;
 struct InputBehavior;
 
+// Client-side memo of the last unconsumed TestSendKey answer, so that key
+// repeats in an unchanged state (arrow or backspace runs outside
+// composition) skip the server round trip.  Owned by the caller, one per
+// input context; it must be invalidated whenever a message that can change
+// server-side state goes through that context, which ImeProcessKey does
+// itself whenever a key tests as consumed.
+struct KeyEventMemo {
+  bool valid = false;
+  // The serialized KeyEvent and the input state the answer was obtained for.
+  std::string key_bytes;
+  bool open = false;
+  uint32_t logical_conversion_mode = 0;
+  uint32_t visible_conversion_mode = 0;
+  commands::Output output;
+
+  void Invalidate() { valid = false; }
+};
+
 struct KeyEventHandlerResult {
   bool should_be_eaten;
   bool should_be_sent_to_server;
@@ -80,7 +101,8 @@ class KeyEventHandler {
       const KeyboardStatus &keyboard_status, const InputBehavior &behavior,
       const InputState &initial_state, const commands::Context &context,
       client::ClientInterface *client, Win32KeyboardInterface *keyboard,
-      InputState *next_state, commands::Output *output);
+      InputState *next_state, commands::Output *output,
+      KeyEventMemo *memo = nullptr);
 
   static KeyEventHandlerResult ImeToAsciiEx(
       const VirtualKey &virtual_key, BYTE scan_code, bool is_key_down,
@@ -241,6 +241,10 @@ class MockState {
 
   bool start_server_called() { return launcher_->start_server_called(); }
 
+  void SetMockResponse(const Output &mock_response) {
+    client_factory_.SetMockResponse(mock_response.SerializeAsString());
+  }
+
  private:
   IPCClientFactoryMock client_factory_;
   std::unique_ptr<client::ClientInterface> client_;
@@ -2912,6 +2916,76 @@ TEST_F(KeyEventHandlerTest, Issue8524269ComebackMode) {
   }
 }
 
+TEST_F(KeyEventHandlerTest, KeyEventMemoSkipsRepeatedTestSendKey) {
+  constexpr bool kKanaLocked = false;
+
+  // The server does not consume this key.
+  Output unconsumed_output;
+  unconsumed_output.set_mode(commands::HIRAGANA);
+  unconsumed_output.set_consumed(false);
+
+  MockState mock(unconsumed_output);
+  KeyboardMock keyboard(kKanaLocked);
+
+  InputBehavior behavior;
+  behavior.prefer_kana_input = kKanaLocked;
+  behavior.disabled = false;
+  behavior.direct_mode_keys = GetDefaultDirectModeKeys();
+
+  Context context;
+  KeyEventMemo memo;
+
+  KeyboardStatus keyboard_status;
+  keyboard_status.SetState(VK_LEFT, kPressed);
+  constexpr VirtualKey kVirtualKey = VirtualKey::FromVirtualKey(VK_LEFT);
+  const LParamKeyInfo lparam(CreateLParam(0x0001,   // repeat_count
+                                          0x4b,     // scan_code
+                                          true,     // is_extended_key,
+                                          false,    // has_context_code,
+                                          false,    // is_previous_state_down,
+                                          false));  // is_in_transition_state
+
+  InputState initial_state;
+  initial_state.logical_conversion_mode =
+      IME_CMODE_NATIVE | IME_CMODE_FULLSHAPE;
+  initial_state.open = true;
+
+  InputState next_state;
+  Output output;
+  KeyEventHandlerResult result = TestableKeyEventHandler::ImeProcessKey(
+      kVirtualKey, lparam.GetScanCode(), lparam.IsKeyDownInImeProcessKey(),
+      keyboard_status, behavior, initial_state, context,
+      mock.mutable_client(), &keyboard, &next_state, &output, &memo);
+  EXPECT_TRUE(result.succeeded);
+  EXPECT_FALSE(result.should_be_eaten);
+  EXPECT_TRUE(memo.valid);
+
+  // The repeat must be answered from the memo: even with the mock now
+  // claiming the key is consumed, the replayed answer stays unconsumed.
+  Output consumed_output;
+  consumed_output.set_mode(commands::HIRAGANA);
+  consumed_output.set_consumed(true);
+  mock.SetMockResponse(consumed_output);
+
+  result = TestableKeyEventHandler::ImeProcessKey(
+      kVirtualKey, lparam.GetScanCode(), lparam.IsKeyDownInImeProcessKey(),
+      keyboard_status, behavior, initial_state, context,
+      mock.mutable_client(), &keyboard, &next_state, &output, &memo);
+  EXPECT_TRUE(result.succeeded);
+  EXPECT_FALSE(result.should_be_eaten);
+
+  // A state change invalidates the memo and the server is asked again.
+  memo.Invalidate();
+  result = TestableKeyEventHandler::ImeProcessKey(
+      kVirtualKey, lparam.GetScanCode(), lparam.IsKeyDownInImeProcessKey(),
+      keyboard_status, behavior, initial_state, context,
+      mock.mutable_client(), &keyboard, &next_state, &output, &memo);
+  EXPECT_TRUE(result.succeeded);
+  EXPECT_TRUE(result.should_be_eaten);
+  EXPECT_FALSE(memo.valid);
+}
+
 }  // namespace
 }  // namespace win32
+
 }  // namespace mozc
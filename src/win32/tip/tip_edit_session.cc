@@ -845,6 +845,57 @@ bool TipEditSession::ReconvertFromApplicationSync(TipTextService *text_service,
   return OnOutputReceivedSync(text_service, context.get(), std::move(output));
 }
 
+bool TipEditSession::ReconvertFromApplicationAsync(
+    TipTextService *text_service, ITfRange *range) {
+  if (range == nullptr) {
+    return false;
+  }
+  wil::com_ptr_nothrow<ITfContext> context;
+  if (FAILED(range->GetContext(&context))) {
+    return false;
+  }
+  TipPrivateContext *private_context =
+      text_service->GetPrivateContext(context.get());
+  if (!private_context) {
+    // This is an unmanaged context.
+    return false;
+  }
+
+  TipSurroundingTextInfo info;
+  if (!TipSurroundingText::Get(text_service, context.get(), &info)) {
+    return false;
+  }
+
+  if (info.selected_text.empty()) {
+    // Selected text is empty. Nothing to do.
+    return false;
+  }
+
+  if (info.in_composition) {
+    // on-going composition is found.
+    return false;
+  }
+
+  // Stop reconversion when any embedded object is found because we cannot
+  // easily restore it. See b/3406434
+  if (info.selected_text.find(static_cast<wchar_t>(TS_CHAR_EMBEDDED)) !=
+      std::wstring::npos) {
+    // embedded object is found.
+    return false;
+  }
+
+  // The surrounding text is captured above; the reverse conversion itself
+  // runs in a queued edit session like the other async session commands, so
+  // this call acks immediately and the application's synchronous reconvert
+  // request never waits for the server.  (TSF's apartment model still runs
+  // the granted session on this thread; what is removed is the stall inside
+  // the application's call.)
+  SessionCommand command;
+  command.set_type(SessionCommand::CONVERT_REVERSE);
+  command.set_text(WideToUtf8(info.selected_text));
+  return OnSessionCommandAsync(text_service, context.get(), command);
+}
+
 bool TipEditSession::SwitchInputModeAsync(TipTextService *text_service,
                                           uint32_t mozc_mode) {
   commands::CompositionMode mode =
@@ -68,6 +68,12 @@ class TipEditSession {
   static bool ReconvertFromApplicationSync(TipTextService *text_service,
                                            ITfRange *range);
 
+  // As above, but issues the reverse conversion through a queued async edit
+  // session: the call acks immediately and the application's synchronous
+  // reconvert request does not wait for the server round trip.
+  static bool ReconvertFromApplicationAsync(TipTextService *text_service,
+                                            ITfRange *range);
+
   // Begins an async edit session to handle on-layout-changed event.
   static bool OnLayoutChangedAsync(TipTextService *text_service,
                                    ITfContext *context);
@@ -405,6 +405,9 @@ HRESULT UpdatePrivateContext(TipTextService *text_service, ITfContext *context,
     return S_FALSE;
   }
   *private_context->mutable_last_output() = output;
+  // Server state has just changed through this context; a remembered
+  // TestSendKey answer may no longer hold.
+  private_context->mutable_key_event_memo()->Invalidate();
   if (!output.has_status()) {
     return S_FALSE;
   }
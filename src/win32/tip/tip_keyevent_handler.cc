@@ -256,7 +256,7 @@ HRESULT OnTestKey(TipTextService *text_service, ITfContext *context,
   const KeyEventHandlerResult result = KeyEventHandler::ImeProcessKey(
       vk, key_info.GetScanCode(), is_key_down, keyboard_status, behavior,
       input_state, mozc_context, private_context->GetClient(), keyboard.get(),
-      &next_state, &temporal_output);
+      &next_state, &temporal_output, private_context->mutable_key_event_memo());
   if (!result.succeeded) {
     *eaten = FALSE;
     return S_OK;
@@ -433,6 +433,9 @@ HRESULT OnKey(TipTextService *text_service, ITfContext *context,
     FillMozcContextForOnKey(text_service, context, &mozc_context);
 
     InputState unused_next_state;
+    // The key is sent for real below; whatever TestSendKey answer was
+    // remembered may no longer hold afterwards.
+    private_context->mutable_key_event_memo()->Invalidate();
     const KeyEventHandlerResult result = KeyEventHandler::ImeToAsciiEx(
         vk, key_info.GetScanCode(), is_key_down, keyboard_status, behavior,
         ime_state, mozc_context, private_context->GetClient(), keyboard.get(),
@@ -62,6 +62,7 @@ class TipPrivateContext::InternalState {
   commands::Output last_output_;
   VirtualKey last_down_key_;
   InputBehavior input_behavior_;
+  KeyEventMemo key_event_memo_;
   TipUiElementManager ui_element_manager_;
   VKBackBasedDeleter deleter_;
 };
@@ -127,6 +128,10 @@ VirtualKey *TipPrivateContext::mutable_last_down_key() {
   return &state_->last_down_key_;
 }
 
+KeyEventMemo *TipPrivateContext::mutable_key_event_memo() {
+  return &state_->key_event_memo_;
+}
+
 const InputBehavior &TipPrivateContext::input_behavior() const {
   return state_->input_behavior_;
 }
@@ -39,6 +39,7 @@
 #include "win32/base/deleter.h"
 #include "win32/base/input_state.h"
 #include "win32/base/keyboard.h"
+#include "win32/base/keyevent_handler.h"
 #include "win32/base/surrogate_pair_observer.h"
 
 namespace mozc {
@@ -67,6 +68,7 @@ class TipPrivateContext {
   VirtualKey *mutable_last_down_key();
   const InputBehavior &input_behavior() const;
   InputBehavior *mutable_input_behavior();
+  KeyEventMemo *mutable_key_event_memo();
 
  private:
   class InternalState;
@@ -187,8 +187,8 @@ class ReconvertFunctionImpl final : public TipComImplements<ITfFnReconversion> {
       return E_INVALIDARG;
     }
 
-    if (!TipEditSession::ReconvertFromApplicationSync(text_service_.get(),
-                                                      range)) {
+    if (!TipEditSession::ReconvertFromApplicationAsync(text_service_.get(),
+                                                       range)) {
       return E_FAIL;
     }
     return S_OK;
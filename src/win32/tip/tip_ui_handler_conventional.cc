@@ -415,6 +415,9 @@ class UpdateUiEditSessionImpl final : public TipComImplements<ITfEditSession> {
 }  // namespace
 
 void TipUiHandlerConventional::OnActivate(TipTextService *text_service) {
+  // Spin up the renderer while the IME activates so the first candidate
+  // window skips the process cold start.
+  Win32RendererClient::Prewarm();
   ITfThreadMgr *thread_mgr = text_service->GetThreadManager();
   wil::com_ptr_nothrow<ITfDocumentMgr> document;
   if (FAILED(thread_mgr->GetFocus(&document))) {